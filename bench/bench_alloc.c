@@ -0,0 +1,79 @@
+#include "bench_alloc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static size_t alloc_count;
+static size_t alloc_bytes;
+
+#ifdef BENCH_COUNT_ALLOCATIONS
+
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t count, size_t size);
+void * __real_realloc(void * ptr, size_t size);
+char * __real_strdup(char const * s);
+char * __real_strndup(char const * s, size_t n);
+
+void *
+__wrap_malloc(size_t size)
+{
+    alloc_count++;
+    alloc_bytes += size;
+    return __real_malloc(size);
+}
+
+void *
+__wrap_calloc(size_t count, size_t size)
+{
+    alloc_count++;
+    alloc_bytes += count * size;
+    return __real_calloc(count, size);
+}
+
+void *
+__wrap_realloc(void * ptr, size_t size)
+{
+    alloc_count++;
+    alloc_bytes += size;
+    return __real_realloc(ptr, size);
+}
+
+char *
+__wrap_strdup(char const * s)
+{
+    alloc_count++;
+    alloc_bytes += strlen(s) + 1;
+    return __real_strdup(s);
+}
+
+char *
+__wrap_strndup(char const * s, size_t n)
+{
+    alloc_count++;
+    alloc_bytes += strnlen(s, n) + 1;
+    return __real_strndup(s, n);
+}
+
+#endif
+
+bool
+bench_alloc_counting(void)
+{
+#ifdef BENCH_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t
+bench_alloc_count(void)
+{
+    return alloc_count;
+}
+
+size_t
+bench_alloc_bytes(void)
+{
+    return alloc_bytes;
+}
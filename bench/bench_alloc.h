@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Counts the heap allocations made by the process. The counts are kept by
+ * wrappers around malloc(), calloc(), realloc(), strdup() and strndup(),
+ * which the linker puts in place of the C library's functions when the
+ * benchmarks are linked with --wrap (see CMakeLists.txt).
+ */
+
+// Returns false if the allocations aren't being counted on this platform.
+bool bench_alloc_counting(void);
+
+// The number of allocations, and of bytes asked for, since the program started.
+size_t bench_alloc_count(void);
+size_t bench_alloc_bytes(void);
@@ -0,0 +1,262 @@
+#include "bench_corpus.h"
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// How deep the nested corpora nest.
+#define NESTING_DEPTH 100
+
+typedef struct
+{
+    char * text;
+    size_t len;
+    size_t capacity;
+    bool failed;
+    uint32_t random;    // xorshift32 state, so the corpora don't depend on the C library's rand().
+} corpus_t;
+
+static void
+corpus_init(corpus_t * corpus, size_t size)
+{
+    *corpus = (corpus_t){ .capacity = size + 4096, .random = 2463534242u };
+    corpus->text = malloc(corpus->capacity);
+    corpus->failed = corpus->text == NULL;
+}
+
+static void
+corpus_append(corpus_t * corpus, char const * format, ...)
+{
+    while (!corpus->failed)
+    {
+        va_list args;
+        va_start(args, format);
+        int written = vsnprintf(corpus->text + corpus->len, corpus->capacity - corpus->len, format, args);
+        va_end(args);
+        if (written < 0)
+        {
+            corpus->failed = true;
+            return;
+        }
+        if ((size_t)written < corpus->capacity - corpus->len)
+        {
+            corpus->len += written;
+            return;
+        }
+        corpus->capacity = corpus->capacity * 2 + written;
+        char * text = realloc(corpus->text, corpus->capacity);
+        if (text == NULL)
+        {
+            corpus->failed = true;
+            return;
+        }
+        corpus->text = text;
+    }
+}
+
+static void
+corpus_repeat(corpus_t * corpus, char const * text, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        corpus_append(corpus, "%s", text);
+    }
+}
+
+static uint32_t
+corpus_random(corpus_t * corpus, uint32_t limit)
+{
+    uint32_t x = corpus->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    corpus->random = x;
+
+    return x % limit;
+}
+
+static char *
+corpus_finish(corpus_t * corpus, size_t * len)
+{
+    if (corpus->failed)
+    {
+        free(corpus->text);
+        return NULL;
+    }
+    *len = corpus->len;
+    return corpus->text;
+}
+
+// --- JSON ---
+
+static void
+json_record(corpus_t * corpus, int id)
+{
+    static char const * const words[] = { "alpha", "beta", "gamma", "delta \\\"quoted\\\"", "tab\\tseparated", "\\u00e9t\\u00e9" };
+
+    corpus_append(corpus, "{\"id\": %d, \"name\": \"%s %u\", \"score\": %u.%02u, \"active\": %s, \"parent\": null, "
+                  "\"tags\": [\"%s\", \"%s\"], \"size\": %d}",
+                  id, words[corpus_random(corpus, 6)], corpus_random(corpus, 100000), corpus_random(corpus, 1000),
+                  corpus_random(corpus, 100), corpus_random(corpus, 2) ? "true" : "false",
+                  words[corpus_random(corpus, 6)], words[corpus_random(corpus, 6)], -(int)corpus_random(corpus, 5000));
+}
+
+char *
+bench_corpus_json(size_t size, bench_shape_t shape, size_t * len)
+{
+    corpus_t corpus;
+    corpus_init(&corpus, size);
+
+    corpus_append(&corpus, "[\n");
+    for (int id = 0; corpus.len < size && !corpus.failed; id++)
+    {
+        corpus_append(&corpus, id > 0 ? ",\n  " : "  ");
+        if (shape == BENCH_SHAPE_NESTED)
+        {
+            // Alternately objects and arrays, a record at the bottom.
+            for (int depth = 0; depth < NESTING_DEPTH; depth++)
+            {
+                corpus_append(&corpus, depth % 2 == 0 ? "{\"child\": " : "[%d, ", depth);
+            }
+            json_record(&corpus, id);
+            for (int depth = NESTING_DEPTH - 1; depth >= 0; depth--)
+            {
+                corpus_append(&corpus, depth % 2 == 0 ? "}" : "]");
+            }
+        }
+        else
+        {
+            json_record(&corpus, id);
+        }
+    }
+    corpus_append(&corpus, "\n]\n");
+
+    return corpus_finish(&corpus, len);
+}
+
+// --- simple_calc formulas ---
+
+static void
+calc_terms(corpus_t * corpus)
+{
+    static char const * const operands[] = { "1.5", "x", "pi", "sin(x)", "pow(2, 3)", "42", "e", "sqrt(16)" };
+    static char const operators[] = "+-*/";
+
+    corpus_append(corpus, "%s", operands[corpus_random(corpus, 8)]);
+    for (int i = 0; i < 7; i++)
+    {
+        corpus_append(corpus, " %c %s", operators[corpus_random(corpus, 4)], operands[corpus_random(corpus, 8)]);
+    }
+}
+
+/*
+ * A formula is a single expression, so the corpus is built as a balanced
+ * tree of parenthesised halves. A flat chain of operators would give a CPT
+ * as deep as the formula is long.
+ */
+static void
+calc_expression(corpus_t * corpus, size_t leaves, bench_shape_t shape)
+{
+    if (leaves <= 1)
+    {
+        if (shape == BENCH_SHAPE_NESTED)
+        {
+            corpus_repeat(corpus, "(", NESTING_DEPTH);
+            calc_terms(corpus);
+            corpus_repeat(corpus, ")", NESTING_DEPTH);
+        }
+        else
+        {
+            calc_terms(corpus);
+        }
+        return;
+    }
+    corpus_append(corpus, "(");
+    calc_expression(corpus, leaves / 2, shape);
+    corpus_append(corpus, ") %c (", corpus_random(corpus, 2) ? '+' : '*');
+    calc_expression(corpus, leaves - leaves / 2, shape);
+    corpus_append(corpus, ")");
+}
+
+char *
+bench_corpus_calc(size_t size, bench_shape_t shape, size_t * len)
+{
+    corpus_t corpus;
+    corpus_init(&corpus, size);
+
+    // A leaf and its share of the parentheses take about 70 bytes, or 270 when nested.
+    size_t leaf_size = shape == BENCH_SHAPE_NESTED ? 270 : 70;
+    calc_expression(&corpus, size / leaf_size + 1, shape);
+
+    return corpus_finish(&corpus, len);
+}
+
+// --- JSON pointers ---
+
+char *
+bench_corpus_json_pointer(size_t size, bench_shape_t shape, size_t * len)
+{
+    static char const * const tokens[] = { "foo", "0", "a~1b", "m~0n", "items", "", "key with spaces", "%25" };
+
+    corpus_t corpus;
+    corpus_init(&corpus, size);
+
+    // A pointer has no nesting; the nested shape has long tokens full of escapes instead.
+    while (corpus.len < size && !corpus.failed)
+    {
+        corpus_append(&corpus, "/%s", tokens[corpus_random(&corpus, 8)]);
+        if (shape == BENCH_SHAPE_NESTED)
+        {
+            corpus_repeat(&corpus, "~0~1x", NESTING_DEPTH);
+        }
+    }
+
+    return corpus_finish(&corpus, len);
+}
+
+// --- GDL ---
+
+char *
+bench_corpus_gdl(size_t size, bench_shape_t shape, size_t * len)
+{
+    corpus_t corpus;
+    corpus_init(&corpus, size);
+
+    corpus_append(&corpus, "// Synthetic grammar\nR0 = lexeme(\"start\") | digit+ @ACTION_0;\n");
+    for (int i = 1; corpus.len < size && !corpus.failed; i++)
+    {
+        int a = i - 1;
+        int b = i / 2;
+        if (shape == BENCH_SHAPE_NESTED)
+        {
+            corpus_append(&corpus, "R%d = ", i);
+            corpus_repeat(&corpus, "(", NESTING_DEPTH);
+            corpus_append(&corpus, "R%d | 'x'", a);
+            for (int depth = 0; depth < NESTING_DEPTH; depth++)
+            {
+                corpus_append(&corpus, depth % 2 == 0 ? ") R%d?" : ")* | \"s%d\"", depth % 2 == 0 ? b : depth);
+            }
+            corpus_append(&corpus, ";\n");
+            continue;
+        }
+        switch (corpus_random(&corpus, 4))
+        {
+        case 0:
+            corpus_append(&corpus, "R%d = R%d (',' R%d)* @ACTION_%d;\n", i, a, b, i % 50);
+            break;
+        case 1:
+            corpus_append(&corpus, "R%d = lexeme(\"kw_%d\") | [a-z]+ | R%d; // keyword\n", i, i, a);
+            break;
+        case 2:
+            corpus_append(&corpus, "R%d = between(lexeme('('), R%d, lexeme(')')) | delimited(R%d, ';');\n", i, a, b);
+            break;
+        default:
+            corpus_append(&corpus, "R%d = chainl1(R%d, lexeme(oneof(\"+-\"))) | not(R%d) alpha alphanum*;\n", i, a, b);
+            break;
+        }
+    }
+
+    return corpus_finish(&corpus, len);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stddef.h>
+
+/*
+ * Synthetic inputs for the benchmarks. Each generator is deterministic, so
+ * the same size and shape give the same bytes on every run and build. The
+ * inputs are about the size asked for: most stop at the first point they can
+ * end a valid input at or after it.
+ */
+
+typedef enum
+{
+    BENCH_SHAPE_SHALLOW,    // Many small items side by side.
+    BENCH_SHAPE_NESTED,     // The same items, nested about a hundred deep.
+} bench_shape_t;
+
+// Each returns the text, to be freed with free(), and its length in *len, or NULL on error.
+char * bench_corpus_json(size_t size, bench_shape_t shape, size_t * len);
+char * bench_corpus_calc(size_t size, bench_shape_t shape, size_t * len);
+char * bench_corpus_json_pointer(size_t size, bench_shape_t shape, size_t * len);
+char * bench_corpus_gdl(size_t size, bench_shape_t shape, size_t * len);
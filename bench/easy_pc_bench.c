@@ -0,0 +1,585 @@
+#include "bench_alloc.h"
+#include "bench_corpus.h"
+
+#include "gdl_generated.h"
+#include "grammar.h"
+#include "json_grammar.h"
+#include "json_pointer.h"
+
+#include <easy_pc/easy_pc.h>
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Parses synthetic corpora of increasing size with the example grammars and
+ * the GDL grammar, and reports the throughput, allocations, peak memory and
+ * CPT size of each. Each case runs in a child process of its own, so the
+ * peak RSS is that of the case, and a case that crashes (e.g. runs out of
+ * stack) doesn't stop the others.
+ *
+ * Usage:
+ *   easy_pc_bench [--max-size=SIZE] [--min-size=SIZE] [--iterations=N]
+ *                 [--grammar=NAME] [--shape=shallow|nested] [--json=FILE]
+ *   easy_pc_bench --compare OLD.json NEW.json [--threshold=PERCENT]
+ */
+
+typedef char * (*corpus_fn)(size_t size, bench_shape_t shape, size_t * len);
+typedef epc_parser_t * (*create_parser_fn)(epc_parser_list * list);
+
+typedef struct
+{
+    char const * grammar;
+    corpus_fn corpus;
+    create_parser_fn create_parser;
+} bench_grammar_t;
+
+typedef struct
+{
+    bool ok;
+    char error[128];
+    size_t bytes;
+    double parse_seconds;       // The best of the iterations.
+    size_t allocations;         // In one parse.
+    size_t allocated_bytes;
+    long peak_rss_kb;
+    size_t cpt_nodes;
+} bench_result_t;
+
+static epc_parser_t *
+create_calc_parser(epc_parser_list * list)
+{
+    static variable_t const variables[] = { { .name = "x", .value = 2.3 } };
+    static variable_t const constants[] = { { .name = "pi", .value = M_PI }, { .name = "e", .value = M_E } };
+
+    return create_formula_grammar(list, 1, variables, 2, constants);
+}
+
+static bench_grammar_t const grammars[] = {
+    { "json", bench_corpus_json, create_json_grammar },
+    { "simple_calc", bench_corpus_calc, create_calc_parser },
+    { "json_pointer", bench_corpus_json_pointer, create_json_pointer_parser },
+    { "gdl", bench_corpus_gdl, create_gdl_generated_parser },
+};
+
+static char const * const shape_names[] = { "shallow", "nested" };
+
+static double
+now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+count_node(epc_cpt_node_t * node, void * user_data)
+{
+    (void)node;
+    (*(size_t *)user_data)++;
+}
+
+static void
+run_case(bench_grammar_t const * grammar, bench_shape_t shape, size_t size, int iterations, bench_result_t * result)
+{
+    char * input = grammar->corpus(size, shape, &result->bytes);
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t * parser = list != NULL ? grammar->create_parser(list) : NULL;
+    if (input == NULL || parser == NULL)
+    {
+        snprintf(result->error, sizeof(result->error), "failed to create the %s", input == NULL ? "corpus" : "parser");
+        free(input);
+        epc_parser_list_free(list);
+        return;
+    }
+
+    result->ok = true;
+    for (int i = 0; i < iterations && result->ok; i++)
+    {
+        size_t allocations = bench_alloc_count();
+        size_t allocated_bytes = bench_alloc_bytes();
+        double start = now_seconds();
+        epc_parse_session_t session = epc_parse_input(parser, input);
+        double elapsed = now_seconds() - start;
+
+        if (session.result.is_error)
+        {
+            epc_parser_error_t const * error = session.result.data.error;
+            snprintf(result->error, sizeof(result->error), "%s at line %zu, col %zu",
+                     error->message, error->line, error->col);
+            result->ok = false;
+        }
+        else if (i == 0)
+        {
+            result->allocations = bench_alloc_count() - allocations;
+            result->allocated_bytes = bench_alloc_bytes() - allocated_bytes;
+            epc_cpt_visitor_t visitor = { .enter_node = count_node, .user_data = &result->cpt_nodes };
+            epc_cpt_visit_nodes(session.result.data.success, &visitor);
+        }
+        if (i == 0 || elapsed < result->parse_seconds)
+        {
+            result->parse_seconds = elapsed;
+        }
+        epc_parse_session_destroy(&session);
+
+        // Don't repeat parses that take a long time.
+        if (elapsed > 10.0)
+        {
+            break;
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    result->peak_rss_kb = usage.ru_maxrss;
+
+    epc_parser_list_free(list);
+    free(input);
+}
+
+static bench_result_t
+run_case_in_child(bench_grammar_t const * grammar, bench_shape_t shape, size_t size, int iterations)
+{
+    bench_result_t result = { 0 };
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        snprintf(result.error, sizeof(result.error), "pipe() failed");
+        return result;
+    }
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(fds[0]);
+        run_case(grammar, shape, size, iterations, &result);
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        _exit(written == (ssize_t)sizeof(result) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    close(fds[1]);
+    if (pid < 0)
+    {
+        close(fds[0]);
+        snprintf(result.error, sizeof(result.error), "fork() failed");
+        return result;
+    }
+
+    ssize_t got = read(fds[0], &result, sizeof(result));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (got != (ssize_t)sizeof(result))
+    {
+        result = (bench_result_t){ 0 };
+        if (WIFSIGNALED(status))
+        {
+            snprintf(result.error, sizeof(result.error), "crashed with signal %d", WTERMSIG(status));
+        }
+        else
+        {
+            snprintf(result.error, sizeof(result.error), "exited with status %d", WEXITSTATUS(status));
+        }
+    }
+
+    return result;
+}
+
+// Parses sizes like "1024", "64K", "4M" or "1G".
+static bool
+parse_size(char const * text, size_t * size)
+{
+    char * end;
+    unsigned long long value = strtoull(text, &end, 10);
+    switch (*end)
+    {
+    case 'K': case 'k': value <<= 10; end++; break;
+    case 'M': case 'm': value <<= 20; end++; break;
+    case 'G': case 'g': value <<= 30; end++; break;
+    default: break;
+    }
+    if (end == text || *end != '\0' || value == 0)
+    {
+        return false;
+    }
+    *size = (size_t)value;
+    return true;
+}
+
+static void
+format_size(size_t size, char * text, size_t text_size)
+{
+    if (size >= (1u << 30) && size % (1u << 30) == 0)
+    {
+        snprintf(text, text_size, "%zuG", size >> 30);
+    }
+    else if (size >= (1u << 20) && size % (1u << 20) == 0)
+    {
+        snprintf(text, text_size, "%zuM", size >> 20);
+    }
+    else if (size >= (1u << 10) && size % (1u << 10) == 0)
+    {
+        snprintf(text, text_size, "%zuK", size >> 10);
+    }
+    else
+    {
+        snprintf(text, text_size, "%zu", size);
+    }
+}
+
+static void
+write_json_result(FILE * out, bool first, char const * grammar, char const * shape, size_t size,
+                  bench_result_t const * result)
+{
+    // One result per line, which is what --compare reads.
+    fprintf(out, "%s    {\"grammar\": \"%s\", \"shape\": \"%s\", \"size\": %zu, \"bytes\": %zu, \"ok\": %s",
+            first ? "" : ",\n", grammar, shape, size, result->bytes, result->ok ? "true" : "false");
+    if (result->ok)
+    {
+        fprintf(out, ", \"parse_seconds\": %.9f, \"mb_per_s\": %.3f, \"allocations\": %zu, \"allocated_bytes\": %zu, "
+                "\"allocations_per_byte\": %.6f, \"peak_rss_kb\": %ld, \"cpt_nodes\": %zu",
+                result->parse_seconds, result->bytes / result->parse_seconds / 1e6, result->allocations,
+                result->allocated_bytes, (double)result->allocations / result->bytes, result->peak_rss_kb,
+                result->cpt_nodes);
+    }
+    else
+    {
+        fprintf(out, ", \"error\": \"");
+        for (char const * c = result->error; *c != '\0'; c++)
+        {
+            fprintf(out, *c == '"' || *c == '\\' ? "\\%c" : (unsigned char)*c < ' ' ? "?" : "%c", *c);
+        }
+        fprintf(out, "\"");
+    }
+    fprintf(out, "}");
+}
+
+static int
+run_benchmarks(size_t min_size, size_t max_size, int iterations, char const * grammar_filter,
+               char const * shape_filter, char const * json_path)
+{
+    FILE * json = NULL;
+    if (json_path != NULL)
+    {
+        json = fopen(json_path, "w");
+        if (json == NULL)
+        {
+            perror(json_path);
+            return EXIT_FAILURE;
+        }
+        fprintf(json, "{\n  \"benchmark\": \"easy_pc\",\n  \"iterations\": %d,\n  \"allocations_counted\": %s,\n"
+                "  \"results\": [\n", iterations, bench_alloc_counting() ? "true" : "false");
+    }
+
+    printf("%-12s %-7s %6s %11s %10s %11s %10s %12s %12s\n", "grammar", "shape", "size", "bytes", "parse ms", "MB/s",
+           "allocs/B", "peak RSS KB", "CPT nodes");
+    bool all_ok = true;
+    bool first = true;
+    for (size_t g = 0; g < sizeof(grammars) / sizeof(grammars[0]); g++)
+    {
+        if (grammar_filter != NULL && strcmp(grammar_filter, grammars[g].grammar) != 0)
+        {
+            continue;
+        }
+        for (int shape = BENCH_SHAPE_SHALLOW; shape <= BENCH_SHAPE_NESTED; shape++)
+        {
+            if (shape_filter != NULL && strcmp(shape_filter, shape_names[shape]) != 0)
+            {
+                continue;
+            }
+            // Sizes go up by a factor of 16: 1K, 16K, 256K, 4M, 64M, 1G.
+            for (size_t size = min_size; size <= max_size; size *= 16)
+            {
+                bench_result_t result = run_case_in_child(&grammars[g], shape, size, iterations);
+                char size_text[32];
+                format_size(size, size_text, sizeof(size_text));
+                if (result.ok)
+                {
+                    printf("%-12s %-7s %6s %11zu %10.3f %11.2f %10.3f %12ld %12zu\n", grammars[g].grammar,
+                           shape_names[shape], size_text, result.bytes, result.parse_seconds * 1e3,
+                           result.bytes / result.parse_seconds / 1e6,
+                           bench_alloc_counting() ? (double)result.allocations / result.bytes : NAN,
+                           result.peak_rss_kb, result.cpt_nodes);
+                }
+                else
+                {
+                    printf("%-12s %-7s %6s  failed: %s\n", grammars[g].grammar, shape_names[shape], size_text,
+                           result.error);
+                    all_ok = false;
+                }
+                if (json != NULL)
+                {
+                    write_json_result(json, first, grammars[g].grammar, shape_names[shape], size, &result);
+                    first = false;
+                }
+            }
+        }
+    }
+
+    if (json != NULL)
+    {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+    return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// --- Comparison of two result files ---
+
+typedef struct
+{
+    char grammar[32];
+    char shape[16];
+    size_t size;
+    bool ok;
+    double mb_per_s;
+    double allocations_per_byte;
+    long peak_rss_kb;
+} saved_result_t;
+
+static char const *
+json_field(char const * line, char const * name)
+{
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s\": ", name);
+    char const * field = strstr(line, key);
+
+    return field != NULL ? field + strlen(key) : NULL;
+}
+
+static bool
+parse_saved_result(char const * line, saved_result_t * result)
+{
+    char const * grammar = json_field(line, "grammar");
+    char const * shape = json_field(line, "shape");
+    char const * size = json_field(line, "size");
+    char const * ok = json_field(line, "ok");
+    if (grammar == NULL || shape == NULL || size == NULL || ok == NULL
+        || sscanf(grammar, "\"%31[^\"]\"", result->grammar) != 1 || sscanf(shape, "\"%15[^\"]\"", result->shape) != 1
+        || sscanf(size, "%zu", &result->size) != 1)
+    {
+        return false;
+    }
+    result->ok = strncmp(ok, "true", 4) == 0;
+    if (result->ok)
+    {
+        char const * mb_per_s = json_field(line, "mb_per_s");
+        char const * allocations_per_byte = json_field(line, "allocations_per_byte");
+        char const * peak_rss_kb = json_field(line, "peak_rss_kb");
+        return mb_per_s != NULL && allocations_per_byte != NULL && peak_rss_kb != NULL
+               && sscanf(mb_per_s, "%lf", &result->mb_per_s) == 1
+               && sscanf(allocations_per_byte, "%lf", &result->allocations_per_byte) == 1
+               && sscanf(peak_rss_kb, "%ld", &result->peak_rss_kb) == 1;
+    }
+    return true;
+}
+
+static saved_result_t *
+load_results(char const * path, int * count)
+{
+    FILE * file = fopen(path, "r");
+    if (file == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    saved_result_t * results = NULL;
+    int capacity = 0;
+    char line[1024];
+    *count = 0;
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (json_field(line, "grammar") == NULL)
+        {
+            continue;
+        }
+        if (*count == capacity)
+        {
+            capacity = capacity > 0 ? capacity * 2 : 32;
+            saved_result_t * grown = realloc(results, capacity * sizeof(*grown));
+            if (grown == NULL)
+            {
+                free(results);
+                fclose(file);
+                return NULL;
+            }
+            results = grown;
+        }
+        if (!parse_saved_result(line, &results[*count]))
+        {
+            fprintf(stderr, "Error: Invalid result in %s: %s", path, line);
+            free(results);
+            fclose(file);
+            return NULL;
+        }
+        (*count)++;
+    }
+    fclose(file);
+
+    if (results == NULL)
+    {
+        fprintf(stderr, "Error: No results in %s.\n", path);
+    }
+    return results;
+}
+
+static double
+percent_change(double old_value, double new_value)
+{
+    return old_value != 0 ? (new_value - old_value) / old_value * 100 : 0;
+}
+
+/*
+ * Compares the results of two runs, e.g. of two builds, case by case. A
+ * case regresses if its throughput drops, or its allocations per byte rise,
+ * by more than the threshold.
+ */
+static int
+compare_results(char const * old_path, char const * new_path, double threshold)
+{
+    int old_count;
+    int new_count;
+    saved_result_t * old_results = load_results(old_path, &old_count);
+    saved_result_t * new_results = old_results != NULL ? load_results(new_path, &new_count) : NULL;
+    if (new_results == NULL)
+    {
+        free(old_results);
+        return EXIT_FAILURE;
+    }
+
+    printf("%-12s %-7s %11s %21s %9s %21s %9s\n", "grammar", "shape", "size", "MB/s", "change", "allocs/B", "change");
+    int regressions = 0;
+    for (int i = 0; i < new_count; i++)
+    {
+        saved_result_t const * new_result = &new_results[i];
+        saved_result_t const * old_result = NULL;
+        for (int j = 0; j < old_count && old_result == NULL; j++)
+        {
+            if (strcmp(old_results[j].grammar, new_result->grammar) == 0
+                && strcmp(old_results[j].shape, new_result->shape) == 0 && old_results[j].size == new_result->size)
+            {
+                old_result = &old_results[j];
+            }
+        }
+        if (old_result == NULL || !old_result->ok || !new_result->ok)
+        {
+            printf("%-12s %-7s %11zu  %s\n", new_result->grammar, new_result->shape, new_result->size,
+                   old_result == NULL ? "only in the new results" : !new_result->ok ? "failed in the new results"
+                                                                                    : "failed in the old results");
+            regressions += old_result != NULL && old_result->ok && !new_result->ok;
+            continue;
+        }
+
+        double speed_change = percent_change(old_result->mb_per_s, new_result->mb_per_s);
+        double alloc_change = percent_change(old_result->allocations_per_byte, new_result->allocations_per_byte);
+        bool regressed = speed_change < -threshold || alloc_change > threshold;
+        regressions += regressed;
+        printf("%-12s %-7s %11zu %10.2f -> %8.2f %+8.1f%% %10.3f -> %8.3f %+8.1f%%%s\n", new_result->grammar,
+               new_result->shape, new_result->size, old_result->mb_per_s, new_result->mb_per_s, speed_change,
+               old_result->allocations_per_byte, new_result->allocations_per_byte, alloc_change,
+               regressed ? "  REGRESSION" : "");
+    }
+    printf("%d regression%s beyond %.1f%%.\n", regressions, regressions == 1 ? "" : "s", threshold);
+
+    free(old_results);
+    free(new_results);
+    return regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void
+usage(char const * program)
+{
+    fprintf(stderr,
+            "Usage: %s [--max-size=SIZE] [--min-size=SIZE] [--iterations=N] [--grammar=NAME] "
+            "[--shape=shallow|nested] [--json=FILE]\n"
+            "       %s --compare OLD.json NEW.json [--threshold=PERCENT]\n"
+            "Sizes may end in K, M or G. Grammars: json, simple_calc, json_pointer, gdl.\n",
+            program, program);
+}
+
+int
+main(int argc, char ** argv)
+{
+    size_t min_size = 1 << 10;
+    size_t max_size = 16 << 10;
+    int iterations = 5;
+    double threshold = 5.0;
+    char const * grammar_filter = NULL;
+    char const * shape_filter = NULL;
+    char const * json_path = NULL;
+    char const * compare[2] = { NULL, NULL };
+
+    for (int i = 1; i < argc; i++)
+    {
+        char const * value = strchr(argv[i], '=');
+        value = value != NULL ? value + 1 : "";
+        bool valid = true;
+        if (strncmp(argv[i], "--max-size=", strlen("--max-size=")) == 0)
+        {
+            valid = parse_size(value, &max_size);
+        }
+        else if (strncmp(argv[i], "--min-size=", strlen("--min-size=")) == 0)
+        {
+            valid = parse_size(value, &min_size);
+        }
+        else if (strncmp(argv[i], "--iterations=", strlen("--iterations=")) == 0)
+        {
+            iterations = atoi(value);
+            valid = iterations > 0;
+        }
+        else if (strncmp(argv[i], "--threshold=", strlen("--threshold=")) == 0)
+        {
+            threshold = atof(value);
+            valid = threshold >= 0;
+        }
+        else if (strncmp(argv[i], "--grammar=", strlen("--grammar=")) == 0)
+        {
+            grammar_filter = value;
+        }
+        else if (strncmp(argv[i], "--shape=", strlen("--shape=")) == 0)
+        {
+            shape_filter = value;
+        }
+        else if (strncmp(argv[i], "--json=", strlen("--json=")) == 0)
+        {
+            json_path = value;
+        }
+        else if (strcmp(argv[i], "--compare") == 0 && i + 2 < argc)
+        {
+            compare[0] = argv[++i];
+            compare[1] = argv[++i];
+        }
+        else
+        {
+            valid = false;
+        }
+        if (!valid)
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (compare[0] != NULL)
+    {
+        return compare_results(compare[0], compare[1], threshold);
+    }
+    if (min_size > max_size)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!bench_alloc_counting())
+    {
+        printf("Allocations aren't counted on this platform.\n");
+    }
+    return run_benchmarks(min_size, max_size, iterations, grammar_filter, shape_filter, json_path);
+}
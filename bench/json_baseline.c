@@ -0,0 +1,391 @@
+#include "json_baseline.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+    char const * p;
+    bool build;         // False to only check the syntax.
+} json_reader_t;
+
+// Returned for each value when nothing is being built.
+static json_node_t recognised;
+
+static json_node_t * read_value(json_reader_t * reader);
+
+static void
+skip_whitespace(json_reader_t * reader)
+{
+    while (*reader->p == ' ' || *reader->p == '\n' || *reader->p == '\r' || *reader->p == '\t')
+    {
+        reader->p++;
+    }
+}
+
+static bool
+is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static bool
+is_hex_digit(char c)
+{
+    return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static json_node_t *
+node_alloc(json_reader_t const * reader, json_node_type_t type)
+{
+    if (!reader->build)
+    {
+        return &recognised;
+    }
+    json_node_t * node = calloc(1, sizeof(*node));
+    if (node != NULL)
+    {
+        node->type = type;
+    }
+    return node;
+}
+
+static void
+node_free(json_reader_t const * reader, json_node_t * node)
+{
+    if (reader->build)
+    {
+        json_node_free(node, NULL);
+    }
+}
+
+static bool
+list_append(json_reader_t const * reader, json_node_t * list, json_node_t * item)
+{
+    if (!reader->build)
+    {
+        return true;
+    }
+    json_list_node_t * entry = calloc(1, sizeof(*entry));
+    if (entry == NULL)
+    {
+        json_node_free(item, NULL);
+        return false;
+    }
+    entry->item = item;
+    if (list->data.list.tail != NULL)
+    {
+        list->data.list.tail->next = entry;
+    }
+    else
+    {
+        list->data.list.head = entry;
+    }
+    list->data.list.tail = entry;
+    list->data.list.count++;
+    return true;
+}
+
+// Reads a quoted string, leaving its content, escapes and all, in *content and *len.
+static bool
+read_string(json_reader_t * reader, char const * * content, size_t * len)
+{
+    if (*reader->p != '"')
+    {
+        return false;
+    }
+    char const * start = ++reader->p;
+    while (*reader->p != '"')
+    {
+        if (*reader->p == '\0')
+        {
+            return false;
+        }
+        if (*reader->p++ != '\\')
+        {
+            continue;
+        }
+        if (*reader->p == 'u')
+        {
+            for (int i = 1; i <= 4; i++)
+            {
+                if (!is_hex_digit(reader->p[i]))
+                {
+                    return false;
+                }
+            }
+            reader->p += 5;
+        }
+        else if (*reader->p != '\0' && strchr("\"\\/bfnrt", *reader->p) != NULL)
+        {
+            reader->p++;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    *content = start;
+    *len = (size_t)(reader->p - start);
+    reader->p++;
+    return true;
+}
+
+static json_node_t *
+read_string_value(json_reader_t * reader)
+{
+    char const * content;
+    size_t len;
+    if (!read_string(reader, &content, &len))
+    {
+        return NULL;
+    }
+    json_node_t * node = node_alloc(reader, JSON_NODE_STRING);
+    if (node != NULL && reader->build)
+    {
+        node->data.string = strndup(content, len);
+        if (node->data.string == NULL)
+        {
+            free(node);
+            return NULL;
+        }
+    }
+    return node;
+}
+
+static json_node_t *
+read_number(json_reader_t * reader)
+{
+    char const * start = reader->p;
+    char const * p = start;
+    if (*p == '-')
+    {
+        p++;
+    }
+    if (!is_digit(*p))
+    {
+        return NULL;
+    }
+    while (is_digit(*p))
+    {
+        p++;
+    }
+    if (*p == '.' && is_digit(p[1]))
+    {
+        for (p++; is_digit(*p); p++)
+        {
+        }
+    }
+    if (*p == 'e' || *p == 'E')
+    {
+        char const * exponent = p + 1;
+        if (*exponent == '+' || *exponent == '-')
+        {
+            exponent++;
+        }
+        if (is_digit(*exponent))
+        {
+            for (p = exponent; is_digit(*p); p++)
+            {
+            }
+        }
+    }
+    reader->p = p;
+
+    json_node_t * node = node_alloc(reader, JSON_NODE_NUMBER);
+    if (node != NULL && reader->build)
+    {
+        node->data.number = strtod(start, NULL);
+    }
+    return node;
+}
+
+static json_node_t *
+read_literal(json_reader_t * reader, char const * literal, json_node_type_t type, bool value)
+{
+    size_t const len = strlen(literal);
+    if (strncmp(reader->p, literal, len) != 0)
+    {
+        return NULL;
+    }
+    reader->p += len;
+    json_node_t * node = node_alloc(reader, type);
+    if (node != NULL && reader->build)
+    {
+        node->data.boolean = value;
+    }
+    return node;
+}
+
+static json_node_t *
+read_member(json_reader_t * reader)
+{
+    char const * key;
+    size_t key_len;
+    if (!read_string(reader, &key, &key_len))
+    {
+        return NULL;
+    }
+    skip_whitespace(reader);
+    if (*reader->p != ':')
+    {
+        return NULL;
+    }
+    reader->p++;
+    json_node_t * value = read_value(reader);
+    if (value == NULL)
+    {
+        return NULL;
+    }
+
+    json_node_t * member = node_alloc(reader, JSON_NODE_MEMBER);
+    if (member == NULL || !reader->build)
+    {
+        node_free(reader, value);
+        return member;
+    }
+    member->data.member.key = strndup(key, key_len);
+    member->data.member.value = value;
+    if (member->data.member.key == NULL)
+    {
+        json_node_free(member, NULL);
+        return NULL;
+    }
+    return member;
+}
+
+// Reads an object or an array, whose items are read by read_item.
+static json_node_t *
+read_list(json_reader_t * reader, json_node_type_t type, char close, json_node_t * (*read_item)(json_reader_t *))
+{
+    reader->p++;
+    json_node_t * list = node_alloc(reader, type);
+    if (list == NULL)
+    {
+        return NULL;
+    }
+    skip_whitespace(reader);
+    if (*reader->p != close)
+    {
+        for (;;)
+        {
+            json_node_t * item = read_item(reader);
+            if (item == NULL || !list_append(reader, list, item))
+            {
+                node_free(reader, list);
+                return NULL;
+            }
+            skip_whitespace(reader);
+            if (*reader->p != ',')
+            {
+                break;
+            }
+            reader->p++;
+            skip_whitespace(reader);
+        }
+        if (*reader->p != close)
+        {
+            node_free(reader, list);
+            return NULL;
+        }
+    }
+    reader->p++;
+    return list;
+}
+
+static json_node_t *
+read_value(json_reader_t * reader)
+{
+    skip_whitespace(reader);
+    json_node_t * value;
+    switch (*reader->p)
+    {
+    case '"':
+        value = read_string_value(reader);
+        break;
+    case '{':
+        value = read_list(reader, JSON_NODE_OBJECT, '}', read_member);
+        break;
+    case '[':
+        value = read_list(reader, JSON_NODE_ARRAY, ']', read_value);
+        break;
+    case 't':
+        value = read_literal(reader, "true", JSON_NODE_BOOLEAN, true);
+        break;
+    case 'f':
+        value = read_literal(reader, "false", JSON_NODE_BOOLEAN, false);
+        break;
+    case 'n':
+        value = read_literal(reader, "null", JSON_NODE_NULL, false);
+        break;
+    default:
+        value = read_number(reader);
+        break;
+    }
+    skip_whitespace(reader);
+    return value;
+}
+
+static json_node_t *
+read_document(char const * text, bool build)
+{
+    json_reader_t reader = { .p = text, .build = build };
+    json_node_t * value = read_value(&reader);
+    if (value != NULL && *reader.p != '\0')
+    {
+        node_free(&reader, value);
+        return NULL;
+    }
+    return value;
+}
+
+bool
+json_baseline_recognise(char const * text)
+{
+    return read_document(text, false) != NULL;
+}
+
+json_node_t *
+json_baseline_parse(char const * text)
+{
+    return read_document(text, true);
+}
+
+bool
+json_tree_equal(json_node_t const * a, json_node_t const * b)
+{
+    if (a == NULL || b == NULL || a->type != b->type)
+    {
+        return a == b;
+    }
+    switch (a->type)
+    {
+    case JSON_NODE_STRING:
+        return strcmp(a->data.string, b->data.string) == 0;
+    case JSON_NODE_NUMBER:
+        return a->data.number == b->data.number;
+    case JSON_NODE_BOOLEAN:
+        return a->data.boolean == b->data.boolean;
+    case JSON_NODE_NULL:
+        return true;
+    case JSON_NODE_MEMBER:
+        return strcmp(a->data.member.key, b->data.member.key) == 0
+               && json_tree_equal(a->data.member.value, b->data.member.value);
+    case JSON_NODE_OBJECT:
+    case JSON_NODE_ARRAY:
+    case JSON_NODE_LIST:
+    {
+        json_list_node_t const * x = a->data.list.head;
+        json_list_node_t const * y = b->data.list.head;
+        for (; x != NULL && y != NULL; x = x->next, y = y->next)
+        {
+            if (!json_tree_equal(x->item, y->item))
+            {
+                return false;
+            }
+        }
+        return x == NULL && y == NULL;
+    }
+    }
+    return false;
+}
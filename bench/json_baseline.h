@@ -0,0 +1,22 @@
+#pragma once
+
+#include "json_ast.h"
+
+#include <stdbool.h>
+
+/*
+ * A minimal hand-written recursive-descent JSON parser, as the reference the
+ * JSON parsers built with easy_pc are compared with. It builds the same tree
+ * as the JSON example's AST actions: strings keep their escape sequences, and
+ * objects and arrays are lists of members and values. Free the tree with
+ * json_node_free().
+ */
+
+// Returns true if text is one JSON value, surrounded by optional whitespace, without building anything.
+bool json_baseline_recognise(char const * text);
+
+// Returns the tree of the JSON value in text, or NULL if it isn't one or memory runs out.
+json_node_t * json_baseline_parse(char const * text);
+
+// Returns true if the two trees are the same.
+bool json_tree_equal(json_node_t const * a, json_node_t const * b);
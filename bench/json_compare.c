@@ -0,0 +1,487 @@
+#include "bench_corpus.h"
+#include "json_baseline.h"
+#include "perf_counters.h"
+
+#include "json_ast_actions.h"
+#include "json_gdl.h"
+#include "json_grammar.h"
+
+#include <easy_pc/easy_pc.h>
+#include <easy_pc/easy_pc_ast.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Parses the same JSON corpus three ways: with the combinator grammar of the
+ * JSON example, with the parser generated from bench/json.gdl, and with a
+ * minimal hand-written recursive-descent parser as the baseline. The first
+ * two parse into a CPT and build the AST from it with the example's AST
+ * actions, as epc_parse_and_build_ast() does; the baseline builds the same
+ * tree directly. Each phase is timed, and compared with the baseline's. With
+ * --perf the CPU cycles, branch misses and cache misses of each phase are
+ * counted too.
+ *
+ * The baseline's parse phase is a pass that only checks the syntax, and its
+ * AST phase the time the pass that builds the tree takes over that.
+ *
+ * Before timing anything, it checks that all three accept a few small
+ * documents with whitespace around scalars, which the corpus doesn't have.
+ *
+ * Usage:
+ *   easy_pc_json_compare [--size=SIZE] [--shape=shallow|nested] [--iterations=N] [--perf]
+ */
+
+typedef enum
+{
+    PHASE_PARSE,        // Parsing, which for easy_pc includes building the CPT.
+    PHASE_AST,
+    PHASE_FREE,
+    PHASE_COUNT,
+} phase_t;
+
+static char const * const phase_names[PHASE_COUNT] = { "parse+CPT", "AST", "free" };
+
+typedef struct
+{
+    double seconds;
+    perf_counts_t counts;
+} phase_cost_t;
+
+typedef struct
+{
+    char const * name;
+    bool ok;
+    char error[160];
+    phase_cost_t phases[PHASE_COUNT];   // The best of the iterations, phase by phase.
+} engine_result_t;
+
+typedef struct
+{
+    bool perf;
+    double start;
+} phase_timer_t;
+
+static double
+now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+phase_begin(phase_timer_t * timer)
+{
+    if (timer->perf)
+    {
+        perf_counters_start();
+    }
+    timer->start = now_seconds();
+}
+
+static phase_cost_t
+phase_end(phase_timer_t const * timer)
+{
+    phase_cost_t cost = { .seconds = now_seconds() - timer->start };
+    if (timer->perf)
+    {
+        perf_counters_stop(&cost.counts);
+    }
+    return cost;
+}
+
+static void
+keep_best(engine_result_t * result, phase_t phase, phase_cost_t const * cost, bool first)
+{
+    if (first || cost->seconds < result->phases[phase].seconds)
+    {
+        result->phases[phase] = *cost;
+    }
+}
+
+static double
+total_seconds(engine_result_t const * result)
+{
+    double total = 0;
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        total += result->phases[phase].seconds;
+    }
+    return total;
+}
+
+static uint64_t
+counts_difference(uint64_t a, uint64_t b)
+{
+    return a > b ? a - b : 0;
+}
+
+static void
+run_baseline(char const * input, int iterations, phase_timer_t * timer, engine_result_t * result)
+{
+    result->ok = true;
+    for (int i = 0; i < iterations && result->ok; i++)
+    {
+        phase_begin(timer);
+        bool recognised = json_baseline_recognise(input);
+        phase_cost_t parse = phase_end(timer);
+
+        phase_begin(timer);
+        json_node_t * tree = json_baseline_parse(input);
+        phase_cost_t build = phase_end(timer);
+
+        if (!recognised || tree == NULL)
+        {
+            snprintf(result->error, sizeof(result->error), "the baseline parser failed");
+            result->ok = false;
+            json_node_free(tree, NULL);
+            break;
+        }
+        phase_cost_t ast = {
+            .seconds = build.seconds > parse.seconds ? build.seconds - parse.seconds : 0,
+            .counts = {
+                .cycles = counts_difference(build.counts.cycles, parse.counts.cycles),
+                .branch_misses = counts_difference(build.counts.branch_misses, parse.counts.branch_misses),
+                .cache_misses = counts_difference(build.counts.cache_misses, parse.counts.cache_misses),
+            },
+        };
+
+        phase_begin(timer);
+        json_node_free(tree, NULL);
+        phase_cost_t freed = phase_end(timer);
+
+        keep_best(result, PHASE_PARSE, &parse, i == 0);
+        keep_best(result, PHASE_AST, &ast, i == 0);
+        keep_best(result, PHASE_FREE, &freed, i == 0);
+    }
+}
+
+static void
+run_easy_pc(epc_parser_t * parser, char const * input, json_node_t const * expected, int iterations,
+            phase_timer_t * timer, engine_result_t * result)
+{
+    epc_ast_hook_registry_t * registry = epc_ast_hook_registry_create(JSON_GDL_AST_ACTION_COUNT__);
+    if (registry == NULL)
+    {
+        snprintf(result->error, sizeof(result->error), "failed to create the AST hook registry");
+        return;
+    }
+    json_ast_hook_registry_init(registry);
+
+    result->ok = true;
+    for (int i = 0; i < iterations && result->ok; i++)
+    {
+        phase_begin(timer);
+        epc_parse_session_t session = epc_parse_input(parser, input);
+        phase_cost_t parse = phase_end(timer);
+
+        if (session.result.is_error)
+        {
+            epc_parser_error_t const * error = session.result.data.error;
+            snprintf(result->error, sizeof(result->error), "%s at line %zu, col %zu", error->message, error->line,
+                     error->col);
+            result->ok = false;
+            epc_parse_session_destroy(&session);
+            break;
+        }
+
+        phase_begin(timer);
+        epc_ast_result_t ast = epc_ast_build(session.result.data.success, registry, NULL);
+        phase_cost_t build = phase_end(timer);
+
+        if (ast.has_error)
+        {
+            snprintf(result->error, sizeof(result->error), "%.150s", ast.error_message);
+            result->ok = false;
+        }
+        else if (i == 0 && !json_tree_equal(ast.ast_root, expected))
+        {
+            snprintf(result->error, sizeof(result->error), "the AST differs from the baseline's");
+            result->ok = false;
+        }
+
+        phase_begin(timer);
+        json_node_free(ast.ast_root, NULL);
+        epc_parse_session_destroy(&session);
+        phase_cost_t freed = phase_end(timer);
+
+        keep_best(result, PHASE_PARSE, &parse, i == 0);
+        keep_best(result, PHASE_AST, &build, i == 0);
+        keep_best(result, PHASE_FREE, &freed, i == 0);
+    }
+
+    epc_ast_hook_registry_free(registry);
+}
+
+/*
+ * Checks every engine accepts some small documents with whitespace where the
+ * corpus has none, such as after a top-level scalar.
+ */
+static bool
+check_acceptance(epc_parser_t * combinator_parser, epc_parser_t * generated_parser)
+{
+    static char const * const documents[] = {
+        "\"a\"\n", "1\t", "[1,\n2]", " {\"k\" :\ttrue }\r\n", "\r\nnull ",
+    };
+    bool ok = true;
+
+    for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); i++)
+    {
+        char const * document = documents[i];
+        epc_parser_t * const parsers[] = { combinator_parser, generated_parser };
+        char const * const names[] = { "combinators", "generated" };
+
+        if (!json_baseline_recognise(document))
+        {
+            fprintf(stderr, "baseline rejects document %zu\n", i);
+            ok = false;
+        }
+        for (int e = 0; e < 2; e++)
+        {
+            epc_parse_session_t session = epc_parse_input(parsers[e], document);
+            if (session.result.is_error)
+            {
+                fprintf(stderr, "%s rejects document %zu: %s\n", names[e], i, session.result.data.error->message);
+                ok = false;
+            }
+            epc_parse_session_destroy(&session);
+        }
+    }
+    return ok;
+}
+
+static void
+print_ratio(double value, double baseline)
+{
+    if (baseline > 0)
+    {
+        printf(" %11.1fx", value / baseline);
+    }
+    else
+    {
+        printf(" %12s", "-");
+    }
+}
+
+static void
+print_times(engine_result_t const * results, int count, size_t bytes)
+{
+    printf("%-12s", "engine");
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        printf(" %9s ms", phase_names[phase]);
+    }
+    printf(" %9s ms %9s\n", "total", "MB/s");
+    for (int e = 0; e < count; e++)
+    {
+        printf("%-12s", results[e].name);
+        if (!results[e].ok)
+        {
+            printf(" failed: %s\n", results[e].error);
+            continue;
+        }
+        for (int phase = 0; phase < PHASE_COUNT; phase++)
+        {
+            printf(" %12.3f", results[e].phases[phase].seconds * 1e3);
+        }
+        double const total = total_seconds(&results[e]);
+        printf(" %12.3f %9.2f\n", total * 1e3, bytes / total / 1e6);
+    }
+
+    printf("\n%-12s", "vs baseline");
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        printf(" %12s", phase_names[phase]);
+    }
+    printf(" %12s\n", "total");
+    for (int e = 1; e < count; e++)
+    {
+        if (!results[e].ok || !results[0].ok)
+        {
+            continue;
+        }
+        printf("%-12s", results[e].name);
+        for (int phase = 0; phase < PHASE_COUNT; phase++)
+        {
+            print_ratio(results[e].phases[phase].seconds, results[0].phases[phase].seconds);
+        }
+        print_ratio(total_seconds(&results[e]), total_seconds(&results[0]));
+        printf("\n");
+    }
+}
+
+typedef uint64_t (*counter_fn)(perf_counts_t const * counts);
+
+static uint64_t
+cycles(perf_counts_t const * counts)
+{
+    return counts->cycles;
+}
+
+static uint64_t
+branch_misses(perf_counts_t const * counts)
+{
+    return counts->branch_misses;
+}
+
+static uint64_t
+cache_misses(perf_counts_t const * counts)
+{
+    return counts->cache_misses;
+}
+
+// Prints a counter for each phase, and its ratio to the baseline's.
+static void
+print_counter(char const * name, counter_fn counter, engine_result_t const * results, int count)
+{
+    printf("\n%-12s", name);
+    for (int phase = 0; phase < PHASE_COUNT; phase++)
+    {
+        printf(" %25s", phase_names[phase]);
+    }
+    printf("\n");
+    for (int e = 0; e < count; e++)
+    {
+        if (!results[e].ok)
+        {
+            continue;
+        }
+        printf("%-12s", results[e].name);
+        for (int phase = 0; phase < PHASE_COUNT; phase++)
+        {
+            uint64_t const value = counter(&results[e].phases[phase].counts);
+            uint64_t const baseline = counter(&results[0].phases[phase].counts);
+            printf(" %15llu", (unsigned long long)value);
+            if (e > 0 && results[0].ok && baseline > 0)
+            {
+                printf(" (%7.1fx)", (double)value / baseline);
+            }
+            else
+            {
+                printf(" %10s", "");
+            }
+        }
+        printf("\n");
+    }
+}
+
+// Parses sizes like "1024", "64K" or "4M".
+static bool
+parse_size(char const * text, size_t * size)
+{
+    char * end;
+    unsigned long long value = strtoull(text, &end, 10);
+    switch (*end)
+    {
+    case 'K': case 'k': value <<= 10; end++; break;
+    case 'M': case 'm': value <<= 20; end++; break;
+    case 'G': case 'g': value <<= 30; end++; break;
+    default: break;
+    }
+    if (end == text || *end != '\0' || value == 0)
+    {
+        return false;
+    }
+    *size = (size_t)value;
+    return true;
+}
+
+int
+main(int argc, char * argv[])
+{
+    size_t size = 16 << 10;
+    bench_shape_t shape = BENCH_SHAPE_SHALLOW;
+    int iterations = 5;
+    bool perf = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--size=", 7) == 0 && parse_size(argv[i] + 7, &size))
+        {
+        }
+        else if (strcmp(argv[i], "--shape=shallow") == 0)
+        {
+            shape = BENCH_SHAPE_SHALLOW;
+        }
+        else if (strcmp(argv[i], "--shape=nested") == 0)
+        {
+            shape = BENCH_SHAPE_NESTED;
+        }
+        else if (strncmp(argv[i], "--iterations=", 13) == 0 && (iterations = atoi(argv[i] + 13)) > 0)
+        {
+        }
+        else if (strcmp(argv[i], "--perf") == 0)
+        {
+            perf = true;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--size=SIZE] [--shape=shallow|nested] [--iterations=N] [--perf]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    char const * reason;
+    if (perf && !perf_counters_open(&reason))
+    {
+        fprintf(stderr, "Can't read the performance counters (%s); timing only.\n", reason);
+        perf = false;
+    }
+
+    size_t bytes;
+    char * input = bench_corpus_json(size, shape, &bytes);
+    epc_parser_list * combinator_list = epc_parser_list_create();
+    epc_parser_list * generated_list = epc_parser_list_create();
+    epc_parser_t * combinator_parser = combinator_list != NULL ? create_json_grammar(combinator_list) : NULL;
+    epc_parser_t * generated_parser = generated_list != NULL ? create_json_gdl_parser(generated_list) : NULL;
+    json_node_t * expected = input != NULL ? json_baseline_parse(input) : NULL;
+    int status = EXIT_FAILURE;
+    if (input == NULL || combinator_parser == NULL || generated_parser == NULL || expected == NULL)
+    {
+        fprintf(stderr, "Failed to create the %s.\n", input == NULL ? "corpus" : expected == NULL ? "baseline tree" : "parsers");
+        goto done;
+    }
+    if (!check_acceptance(combinator_parser, generated_parser))
+    {
+        goto done;
+    }
+
+    printf("JSON corpus: %s, %zu bytes, best of %d iterations\n\n", shape == BENCH_SHAPE_NESTED ? "nested" : "shallow",
+           bytes, iterations);
+
+    phase_timer_t timer = { .perf = perf };
+    engine_result_t results[] = { { .name = "baseline" }, { .name = "combinators" }, { .name = "generated" } };
+    int const count = sizeof(results) / sizeof(results[0]);
+    run_baseline(input, iterations, &timer, &results[0]);
+    run_easy_pc(combinator_parser, input, expected, iterations, &timer, &results[1]);
+    run_easy_pc(generated_parser, input, expected, iterations, &timer, &results[2]);
+
+    print_times(results, count, bytes);
+    if (perf)
+    {
+        print_counter("cycles", cycles, results, count);
+        print_counter("branch-miss", branch_misses, results, count);
+        print_counter("cache-miss", cache_misses, results, count);
+    }
+
+    status = EXIT_SUCCESS;
+    for (int e = 0; e < count; e++)
+    {
+        if (!results[e].ok)
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+
+done:
+    perf_counters_close();
+    json_node_free(expected, NULL);
+    epc_parser_list_free(generated_list);
+    epc_parser_list_free(combinator_list);
+    free(input);
+    return status;
+}
@@ -0,0 +1,116 @@
+#include "perf_counters.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define COUNTER_COUNT 3
+
+// The first counter leads the group, so the three are scheduled, and read, together.
+static int counter_fds[COUNTER_COUNT] = { -1, -1, -1 };
+
+static int
+open_counter(uint64_t config, int group_fd)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+bool
+perf_counters_open(char const * * reason)
+{
+    static uint64_t const configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES,
+    };
+
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        counter_fds[i] = open_counter(configs[i], counter_fds[0]);
+        if (counter_fds[i] < 0)
+        {
+            *reason = strerror(errno);
+            perf_counters_close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+perf_counters_start(void)
+{
+    ioctl(counter_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counter_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+bool
+perf_counters_stop(perf_counts_t * counts)
+{
+    ioctl(counter_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // With PERF_FORMAT_GROUP: the number of counters, then their values, in the order they were opened.
+    uint64_t values[1 + COUNTER_COUNT];
+    if (read(counter_fds[0], values, sizeof(values)) != (ssize_t)sizeof(values) || values[0] != COUNTER_COUNT)
+    {
+        return false;
+    }
+    counts->cycles = values[1];
+    counts->branch_misses = values[2];
+    counts->cache_misses = values[3];
+    return true;
+}
+
+void
+perf_counters_close(void)
+{
+    for (int i = COUNTER_COUNT - 1; i >= 0; i--)
+    {
+        if (counter_fds[i] >= 0)
+        {
+            close(counter_fds[i]);
+            counter_fds[i] = -1;
+        }
+    }
+}
+
+#else
+
+bool
+perf_counters_open(char const * * reason)
+{
+    *reason = "perf_event_open() is only available on Linux";
+    return false;
+}
+
+void
+perf_counters_start(void)
+{
+}
+
+bool
+perf_counters_stop(perf_counts_t * counts)
+{
+    (void)counts;
+    return false;
+}
+
+void
+perf_counters_close(void)
+{
+}
+
+#endif
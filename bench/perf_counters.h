@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Hardware performance counters for the calling thread, read with Linux's
+ * perf_event_open(). Only user-space events are counted, so they can be read
+ * without privileges when kernel.perf_event_paranoid is 2 or less.
+ */
+
+typedef struct
+{
+    uint64_t cycles;
+    uint64_t branch_misses;
+    uint64_t cache_misses;
+} perf_counts_t;
+
+// Opens the counters. Returns false, with the reason in *reason, if they can't be read here.
+bool perf_counters_open(char const * * reason);
+
+// Zeroes and starts the counters.
+void perf_counters_start(void);
+
+// Stops the counters and reads the counts since perf_counters_start().
+bool perf_counters_stop(perf_counts_t * counts);
+
+void perf_counters_close(void);
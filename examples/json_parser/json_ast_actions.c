@@ -156,12 +156,20 @@ create_number_action(
         return;
     }
 
-    const char * content = epc_cpt_node_get_semantic_content(node);
-    size_t len = epc_cpt_node_get_semantic_len(node);
-    char * endptr;
-    char * buf = strndup(content, len);
-    jnode->data.number = strtod(buf, &endptr);
-    free(buf);
+    if (node->value_type == EPC_CPT_VALUE_DOUBLE)
+    {
+        /* The double parser has already converted the number. */
+        jnode->data.number = node->value.double_value;
+    }
+    else
+    {
+        const char * content = epc_cpt_node_get_semantic_content(node);
+        size_t len = epc_cpt_node_get_semantic_len(node);
+        char * endptr;
+        char * buf = strndup(content, len);
+        jnode->data.number = strtod(buf, &endptr);
+        free(buf);
+    }
 
     epc_ast_push(ctx, jnode);
 }
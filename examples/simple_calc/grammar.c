@@ -84,7 +84,6 @@ create_formula_grammar(
 {
     // Forward declarations for recursion
     epc_parser_t * expr_fwd   = epc_parser_allocate_l(list, "expr");
-    epc_parser_t * term_fwd   = epc_parser_allocate_l(list, "term");
     epc_parser_t * factor_fwd = epc_parser_allocate_l(list, "factor");
 
     // Literals
@@ -194,13 +193,12 @@ create_formula_grammar(
         );
     epc_parser_duplicate(factor_fwd, factor_def);
 
-    // term = factor (mul_div factor)*
-    epc_parser_t * term_def = epc_chainl1_l(list, "term", factor_def, mul_div);
-    epc_parser_set_ast_action(term_def, AST_ACTION_BUILD_BINARY_EXPRESSION);
-    epc_parser_duplicate(term_fwd, term_def);
-
-    // expr = term (add_sub term)*
-    epc_parser_t * expr_def = epc_chainl1_l(list, "expr", term_def, add_sub);
+    // expr = factor ((add_sub | mul_div) factor)*, with mul_div binding more tightly
+    epc_operator_t const operators[] = {
+        { EPC_OPERATOR_INFIX_LEFT, 1, add_sub },
+        { EPC_OPERATOR_INFIX_LEFT, 2, mul_div },
+    };
+    epc_parser_t * expr_def = epc_operator_table_l(list, "expr", factor_def, operators, 2);
     epc_parser_set_ast_action(expr_def, AST_ACTION_BUILD_BINARY_EXPRESSION);
     epc_parser_duplicate(expr_fwd, expr_def);
 
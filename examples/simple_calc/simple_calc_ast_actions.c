@@ -147,13 +147,21 @@ create_number_from_content_action(
         epc_ast_builder_set_error(ctx, "Failed to allocate AST number node");
         return;
     }
-    char num_str_buf[node->len + 1];
-    strncpy(num_str_buf,
-            epc_cpt_node_get_semantic_content(node),
-            epc_cpt_node_get_semantic_len(node)
-    );
-    num_str_buf[node->len] = '\0';
-    num_node->data.number.value = strtod(num_str_buf, NULL);
+    if (node->value_type == EPC_CPT_VALUE_DOUBLE)
+    {
+        /* The double parser has already converted the number. */
+        num_node->data.number.value = node->value.double_value;
+    }
+    else
+    {
+        char num_str_buf[node->len + 1];
+        strncpy(num_str_buf,
+                epc_cpt_node_get_semantic_content(node),
+                epc_cpt_node_get_semantic_len(node)
+        );
+        num_str_buf[node->len] = '\0';
+        num_node->data.number.value = strtod(num_str_buf, NULL);
+    }
     epc_ast_push(ctx, num_node);
 }
 
@@ -0,0 +1,19 @@
+#include "fuzz_parse.h"
+#include "gdl_parser.h"
+
+/* Fuzzes the hand-written GDL parser the compiler uses. */
+
+int
+LLVMFuzzerTestOneInput(uint8_t const * data, size_t size)
+{
+    static epc_parser_list * list;
+    static epc_parser_t * parser;
+    if (parser == NULL)
+    {
+        list = epc_parser_list_create();
+        parser = create_gdl_parser(list);
+    }
+
+    fuzz_parse("gdl", parser, data, size);
+    return 0;
+}
@@ -0,0 +1,19 @@
+#include "fuzz_parse.h"
+#include "json_grammar.h"
+
+/* Fuzzes the JSON example's combinator grammar. */
+
+int
+LLVMFuzzerTestOneInput(uint8_t const * data, size_t size)
+{
+    static epc_parser_list * list;
+    static epc_parser_t * parser;
+    if (parser == NULL)
+    {
+        list = epc_parser_list_create();
+        parser = create_json_grammar(list);
+    }
+
+    fuzz_parse("json", parser, data, size);
+    return 0;
+}
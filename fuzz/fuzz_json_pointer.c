@@ -0,0 +1,19 @@
+#include "fuzz_parse.h"
+#include "json_pointer.h"
+
+/* Fuzzes the JSON pointer parser generated from the example's GDL. */
+
+int
+LLVMFuzzerTestOneInput(uint8_t const * data, size_t size)
+{
+    static epc_parser_list * list;
+    static epc_parser_t * parser;
+    if (parser == NULL)
+    {
+        list = epc_parser_list_create();
+        parser = create_json_pointer_parser(list);
+    }
+
+    fuzz_parse("json_pointer", parser, data, size);
+    return 0;
+}
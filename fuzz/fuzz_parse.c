@@ -0,0 +1,82 @@
+#include "fuzz_parse.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_SLOW_MIN_BYTES 32
+
+static double worst_ns_per_byte;
+
+static uint64_t
+now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static size_t
+slow_min_bytes(void)
+{
+    static size_t min_bytes;
+    static bool read;
+    if (!read)
+    {
+        char const * text = getenv("EPC_FUZZ_SLOW_MIN_BYTES");
+        min_bytes = text != NULL ? strtoul(text, NULL, 10) : DEFAULT_SLOW_MIN_BYTES;
+        read = true;
+    }
+    return min_bytes;
+}
+
+static void
+save_slow_input(char const * target, uint8_t const * data, size_t size, double ns_per_byte)
+{
+    char const * dir = getenv("EPC_FUZZ_SLOW_DIR");
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/slow-%s-%.0f-%zu", dir != NULL ? dir : ".", target, ns_per_byte, size);
+
+    FILE * file = fopen(path, "wb");
+    if (file == NULL || fwrite(data, 1, size, file) != size)
+    {
+        perror(path);
+    }
+    else
+    {
+        fprintf(stderr, "Slowest %s input so far: %.0f ns per byte, %zu bytes, saved as %s\n", target, ns_per_byte,
+                size, path);
+    }
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+}
+
+void
+fuzz_parse(char const * target, epc_parser_t * parser, uint8_t const * data, size_t size)
+{
+    char * input = malloc(size + 1);
+    if (input == NULL)
+    {
+        return;
+    }
+    memcpy(input, data, size);
+    input[size] = '\0';
+
+    uint64_t const start = now_ns();
+    epc_parse_session_t session = epc_parse_input(parser, input);
+    epc_parse_session_destroy(&session);
+    uint64_t const elapsed = now_ns() - start;
+
+    free(input);
+
+    double const ns_per_byte = (double)elapsed / (size > 0 ? size : 1);
+    if (size >= slow_min_bytes() && ns_per_byte > worst_ns_per_byte)
+    {
+        worst_ns_per_byte = ns_per_byte;
+        save_slow_input(target, data, size, ns_per_byte);
+    }
+}
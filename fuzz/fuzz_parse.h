@@ -0,0 +1,23 @@
+#pragma once
+
+#include <easy_pc/easy_pc.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Shared by the fuzz targets. fuzz_parse() parses one input the fuzzer made
+ * and times it. Crashes, leaks and timeouts are recorded by libFuzzer itself.
+ * fuzz_parse() also keeps the slowest inputs by time per byte, because a
+ * parse that is slow for its size points at super-linear behaviour, e.g.
+ * backtracking in epc_or or the aggregation of errors.
+ *
+ * Whenever an input is slower per byte than all the inputs before it, it is
+ * saved as slow-<target>-<ns per byte>-<bytes> in the directory named by the
+ * EPC_FUZZ_SLOW_DIR environment variable, or the current directory. Inputs
+ * shorter than EPC_FUZZ_SLOW_MIN_BYTES (default 32) aren't considered, as a
+ * parse's fixed costs dominate their time.
+ */
+
+// Parses size bytes of data, as a NUL-terminated string, with parser.
+void fuzz_parse(char const * target, epc_parser_t * parser, uint8_t const * data, size_t size);
@@ -0,0 +1,111 @@
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/*
+ * A main() for the fuzz targets when the compiler has no libFuzzer: runs the
+ * target once on each file named on the command line, and on each file in
+ * each directory named. Used to replay a corpus, e.g. of saved slow inputs.
+ */
+
+int LLVMFuzzerTestOneInput(uint8_t const * data, size_t size);
+
+static int
+replay_file(char const * path)
+{
+    FILE * file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    size_t capacity = 4096;
+    size_t size = 0;
+    uint8_t * data = malloc(capacity);
+    size_t got;
+    while (data != NULL && (got = fread(data + size, 1, capacity - size, file)) > 0)
+    {
+        size += got;
+        if (size == capacity)
+        {
+            capacity *= 2;
+            uint8_t * bigger = realloc(data, capacity);
+            if (bigger == NULL)
+            {
+                free(data);
+            }
+            data = bigger;
+        }
+    }
+    fclose(file);
+    if (data == NULL)
+    {
+        fprintf(stderr, "%s: out of memory\n", path);
+        return -1;
+    }
+
+    LLVMFuzzerTestOneInput(data, size);
+    free(data);
+    return 0;
+}
+
+static int
+replay_path(char const * path)
+{
+    struct stat info;
+    if (stat(path, &info) != 0)
+    {
+        perror(path);
+        return -1;
+    }
+    if (!S_ISDIR(info.st_mode))
+    {
+        return replay_file(path);
+    }
+
+    DIR * dir = opendir(path);
+    if (dir == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    int status = 0;
+    struct dirent * entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        char child[4096];
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        if (replay_path(child) != 0)
+        {
+            status = -1;
+        }
+    }
+    closedir(dir);
+    return status;
+}
+
+int
+main(int argc, char * argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s FILE|DIRECTORY...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    int status = EXIT_SUCCESS;
+    for (int i = 1; i < argc; i++)
+    {
+        if (replay_path(argv[i]) != 0)
+        {
+            status = EXIT_FAILURE;
+        }
+    }
+    return status;
+}
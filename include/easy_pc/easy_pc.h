@@ -3,6 +3,7 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdio.h>
 
 // For symbol visibility control
 #if defined _WIN32 || defined __CYGWIN__
@@ -47,6 +48,20 @@ typedef struct epc_cpt_node_t epc_cpt_node_t;
 typedef struct epc_parser_ctx_t epc_parser_ctx_t;
 typedef struct epc_parser_list epc_parser_list;
 
+/**
+ * @brief Identifies why a parse failed.
+ */
+typedef enum
+{
+    EPC_PARSE_ERROR_SYNTAX,       /**< @brief The input doesn't match the grammar, or the parse failed otherwise. */
+    EPC_PARSE_ERROR_NODE_LIMIT,   /**< @brief The parse needed more CPT nodes than `epc_parse_limits_t::max_cpt_nodes`. */
+    EPC_PARSE_ERROR_MEMORY_LIMIT, /**< @brief The parse needed more bytes than `epc_parse_limits_t::max_cpt_bytes`. */
+    EPC_PARSE_ERROR_DEPTH_LIMIT,  /**< @brief Parser calls nested deeper than `epc_parse_limits_t::max_depth`. */
+    EPC_PARSE_ERROR_STEP_LIMIT,   /**< @brief The parse made more parser calls than `epc_parse_limits_t::max_parser_calls`. */
+    EPC_PARSE_ERROR_TIME_LIMIT,   /**< @brief The parse took longer than `epc_parse_limits_t::max_milliseconds`. */
+    EPC_PARSE_ERROR_CANCELLED,    /**< @brief The `epc_progress_t` callback cancelled the parse. */
+} epc_parse_error_kind_t;
+
 // Error Handling struct
 /**
  * @brief Represents a detailed parsing error.
@@ -63,6 +78,7 @@ typedef struct epc_parser_error_t
     size_t col;                  /**< @brief The column number in the input where the error occurred (0-indexed, calculated later). */
     const char * expected;       /**< @brief A string describing what the parser expected at the error position. */
     const char * found;          /**< @brief A string describing what the parser actually found at the error position. */
+    epc_parse_error_kind_t kind; /**< @brief Why the parse failed: a syntax error, or a limit reached. */
 } epc_parser_error_t;
 
 // Structure to hold AST-related metadata for each parser
@@ -81,6 +97,16 @@ typedef struct
                       */
 } epc_ast_semantic_action_t;
 
+/**
+ * @brief Identifies the type of converted value, if any, held by a CPT node.
+ */
+typedef enum
+{
+    EPC_CPT_VALUE_NONE,   /**< @brief The node holds no converted value. */
+    EPC_CPT_VALUE_INT,    /**< @brief `value.int_value` holds the value of an "integer" node. */
+    EPC_CPT_VALUE_DOUBLE, /**< @brief `value.double_value` holds the value of a "double" node. */
+} epc_cpt_value_type_t;
+
 // The Parse Tree Node
 /**
  * @brief Represents a node in the Concrete Parse Tree (CPT).
@@ -102,6 +128,13 @@ struct epc_cpt_node_t
     epc_cpt_node_t ** children;           /**< @brief An array of pointers to child `pt_node_t`s, representing sub-matches. */
     int children_count;                   /**< @brief The number of children in the `children` array. */
     epc_ast_semantic_action_t ast_config; /** @brief A copy of the ast action assigned to the associated parser that created the node. */
+    int alternative_index;                /**< @brief For "or" and "keywords" nodes, the index of the alternative that matched. */
+    epc_cpt_value_type_t value_type;      /**< @brief The type of the converted value in `value`, if any. */
+    union
+    {
+        long long int_value;              /**< @brief The value matched by an `epc_int` parser. */
+        double double_value;              /**< @brief The value matched by an `epc_double` parser. */
+    } value;                              /**< @brief The numeric value of the matched text, converted while parsing so AST builders needn't convert it again. */
 };
 
 // The Result of a Parse Attempt
@@ -309,6 +342,8 @@ static inline epc_parser_t * epc_alphanum_l(epc_parser_list * list, char const *
 
 /**
  * @brief Creates a parser that matches an integer number (e.g., "123", "-45") and adds it to the list.
+ *
+ * The converted value is stored in the CPT node's `value.int_value`.
  * @param name The name of the parser for debugging/CPT.
  * @return A new `parser_t` instance, or NULL on error.
  */
@@ -329,6 +364,9 @@ static inline epc_parser_t * epc_int_l(epc_parser_list * list, char const * name
 
 /**
  * @brief Creates a parser that matches a floating-point number (e.g., "3.14", "-.5", "1e-3") and adds it to the list.
+ *
+ * Matching doesn't depend on the current locale. The converted value is stored in
+ * the CPT node's `value.double_value`.
  * @param name The name of the parser for debugging/CPT.
  * @return A new `parser_t` instance, or NULL on error.
  */
@@ -413,6 +451,40 @@ static inline epc_parser_t * epc_succeed_l(epc_parser_list * list, char const *
     return epc_parser_list_add(list, epc_succeed(name));
 }
 
+/**
+ * @brief Creates a parser that commits the enclosing `epc_or` to the alternative being tried.
+ *
+ * This parser consumes no input and always succeeds. Once it has matched
+ * inside an alternative of the nearest enclosing `epc_or`, a later failure in
+ * that alternative fails the `epc_or` with that error, rather than trying the
+ * remaining alternatives. e.g. in `epc_or(2, epc_and(3, kw_if, cut, cond), other)`,
+ * input starting with `if` is never reparsed as `other`.
+ * Outside of any `epc_or` it has no effect. Nor does it commit an `epc_or`
+ * from within an `epc_optional`, `epc_many`, `epc_skip`, `epc_lookahead` or
+ * `epc_not`, or from within a rule completed with `epc_parser_duplicate()`,
+ * as those may be backtracked over by what uses them. Only the first match of
+ * an `epc_plus`, and the first item of an `epc_delimited`, can commit; the
+ * delimiters and operators of `epc_delimited`, `epc_chainl1` and `epc_chainr1`
+ * never do.
+ * @param name The name of the parser for debugging/CPT.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+EASY_PC_API epc_parser_t * epc_cut(char const * name);
+
+/**
+ * @brief Creates a parser that commits the enclosing `epc_or` to the alternative being tried and adds it to the list.
+ *        This is a convenience wrapper for `epc_cut()` that automatically adds the created
+ *        parser to the provided `epc_parser_list`.
+ *
+ * @param list The parser list to add to.
+ * @param name The name of the parser for debugging/CPT.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+static inline epc_parser_t * epc_cut_l(epc_parser_list * list, char const * name)
+{
+    return epc_parser_list_add(list, epc_cut(name));
+}
+
 /**
  * @brief Creates a parser that matches a single hexadecimal digit (0-9, a-f, A-F) and adds it to the list.
  * @param name The name of the parser for debugging/CPT.
@@ -812,6 +884,66 @@ static inline epc_parser_t * epc_chainr1_l(epc_parser_list * list, char const *
     return epc_parser_list_add(list, epc_chainr1(name, item, op));
 }
 
+/**
+ * @brief Identifies how an operator in an operator table combines with its operands.
+ */
+typedef enum
+{
+    EPC_OPERATOR_PREFIX,      /**< @brief Unary operator before its operand, e.g. -x. */
+    EPC_OPERATOR_POSTFIX,     /**< @brief Unary operator after its operand, e.g. x!. */
+    EPC_OPERATOR_INFIX_LEFT,  /**< @brief Left-associative binary operator, e.g. 1 - 2 - 3 is (1 - 2) - 3. */
+    EPC_OPERATOR_INFIX_RIGHT, /**< @brief Right-associative binary operator, e.g. 1 ^ 2 ^ 3 is 1 ^ (2 ^ 3). */
+} epc_operator_kind_t;
+
+/**
+ * @brief Describes one operator of an operator table.
+ */
+typedef struct
+{
+    epc_operator_kind_t kind; /**< @brief How the operator combines with its operands. */
+    int precedence;           /**< @brief Higher values bind more tightly. */
+    epc_parser_t * op;        /**< @brief The parser that matches the operator. */
+} epc_operator_t;
+
+/**
+ * @brief Creates a parser for expressions built from `operand` and a table of operators.
+ *
+ * This replaces a stack of `epc_chainl1`/`epc_chainr1` parsers, one per
+ * precedence level, with a single precedence climbing loop, so an operand is
+ * parsed once whatever the number of levels.
+ * Each operator applied produces a node tagged "prefix_expression" (children:
+ * operator, operand), "postfix_expression" (operand, operator) or
+ * "infix_expression" (left, operator, right), with `alternative_index` set
+ * to the operator's index in `operators`. These nodes carry this parser's name
+ * and AST action. An operand with no operators applied is returned as-is.
+ * @param name The name of the parser for debugging/CPT.
+ * @param operand The parser for the operands.
+ * @param operators The operators. The table is copied.
+ *                  Operators are tried in table order, so list longer operators
+ *                  before any operator of the same kind that is a prefix of them.
+ * @param count The number of entries in `operators`.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+EASY_PC_API epc_parser_t * epc_operator_table(
+    char const * name, epc_parser_t * operand, epc_operator_t const * operators, int count);
+
+/**
+ * @brief Creates a parser for expressions built from `operand` and a table of operators and adds it to the list.
+ *        This is a convenience wrapper for `epc_operator_table()` that automatically adds the created
+ *        parser to the provided `epc_parser_list`.
+ * @param list The parser list to add to.
+ * @param name The name of the parser for debugging/CPT.
+ * @param operand The parser for the operands.
+ * @param operators The operators. The table is copied.
+ * @param count The number of entries in `operators`.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+static inline epc_parser_t * epc_operator_table_l(
+    epc_parser_list * list, char const * name, epc_parser_t * operand, epc_operator_t const * operators, int count)
+{
+    return epc_parser_list_add(list, epc_operator_table(name, operand, operators, count));
+}
+
 /**
  * @brief Creates a parser that tries to match one of several alternative parsers.
  *
@@ -841,6 +973,132 @@ EASY_PC_API epc_parser_t * epc_or(char const * name, int count, ...);
  */
 EASY_PC_API epc_parser_t * epc_or_l(epc_parser_list * list, char const * name, int count, ...);
 
+/**
+ * @brief The set of input bytes a parser can start matching at.
+ *
+ * Byte `c` is a member if bit `c % 8` of `bits[c / 8]` is set. Byte 0 stands
+ * for the end of the input.
+ */
+typedef struct
+{
+    unsigned char bits[256 / 8]; /**< @brief One bit per byte value. */
+} epc_first_set_t;
+
+/**
+ * @brief Creates a parser that tries to match one of several alternative parsers,
+ *        skipping those that can't match the next input byte.
+ *
+ * Behaves like `epc_or`, but alternative `i` is only tried if the byte at the
+ * current position is in `first[i]`. Grammar analysis (e.g. `gdl_compiler`)
+ * can compute these sets so that alternatives are pruned without being called.
+ * Each set must include every byte the alternative can start a match with, and
+ * be full if the alternative can match without consuming input; otherwise
+ * inputs the alternative would have matched are rejected.
+ *
+ * @param name The name of the parser for debugging/CPT.
+ * @param first An array of `count` sets, one per alternative. The array is copied.
+ * @param count The number of alternative parsers.
+ * @param ... A variable argument list of `parser_t*` pointers, one for each alternative.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+EASY_PC_API epc_parser_t * epc_or_first(char const * name, epc_first_set_t const * first, int count, ...);
+
+/**
+ * @brief Creates a parser that tries to match one of several alternative parsers,
+ *        skipping those that can't match the next input byte.
+ *        This is a convenience wrapper for `epc_or_first()` that automatically adds the created
+ *        parser to the provided `epc_parser_list`.
+ *
+ * @param list The parser list to add to.
+ * @param name The name of the parser for debugging/CPT.
+ * @param first An array of `count` sets, one per alternative. The array is copied.
+ * @param count The number of alternative parsers.
+ * @param ... A variable argument list of `parser_t*` pointers, one for each alternative.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+EASY_PC_API epc_parser_t * epc_or_first_l(
+    epc_parser_list * list, char const * name, epc_first_set_t const * first, int count, ...);
+
+/**
+ * @brief Creates a parser that matches the longest of a set of keyword strings.
+ *
+ * The keywords are compiled into a trie when the parser is created, so a match
+ * is found in a single pass over the input regardless of how many keywords there
+ * are. This is a faster alternative to an `epc_or` of many `epc_string` parsers.
+ * Unlike `epc_or`, the longest matching keyword wins, not the first one listed.
+ * On success the CPT node has tag "keywords" and its `alternative_index` holds the
+ * index (into `keywords`) of the keyword that matched.
+ *
+ * @param name The name of the parser for debugging/CPT.
+ * @param keywords An array of `count` keyword strings. The strings are copied.
+ * @param count The number of keywords.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+EASY_PC_API epc_parser_t * epc_keywords(char const * name, char const * const * keywords, int count);
+
+/**
+ * @brief Creates a parser that matches the longest of a set of keyword strings.
+ *        This is a convenience wrapper for `epc_keywords()` that automatically adds the created
+ *        parser to the provided `epc_parser_list`.
+ *
+ * @param list The parser list to add to.
+ * @param name The name of the parser for debugging/CPT.
+ * @param keywords An array of `count` keyword strings. The strings are copied.
+ * @param count The number of keywords.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+static inline epc_parser_t * epc_keywords_l(epc_parser_list * list, char const * name, char const * const * keywords, int count)
+{
+    return epc_parser_list_add(list, epc_keywords(name, keywords, count));
+}
+
+/**
+ * @brief A table-driven deterministic finite automaton, as used by `epc_dfa()`.
+ *
+ * Input bytes are first mapped to classes of bytes the automaton doesn't
+ * distinguish between, and the next state is then looked up by state and
+ * class. State 0 is the dead state, from which nothing can match. Several
+ * automata may share the same tables with different start states, as in the
+ * code emitted by the GDL compiler for token rules.
+ */
+typedef struct
+{
+    unsigned char const * classes;      /**< @brief The class of each of the 256 byte values. */
+    unsigned short const * transitions; /**< @brief The next state for each state and class, indexed by `state * class_count + class`. */
+    unsigned char const * accepting;    /**< @brief Non-zero for the states in which a match may end. */
+    int class_count;                    /**< @brief The number of byte classes. */
+    int start;                          /**< @brief The state to start in. */
+} epc_dfa_t;
+
+/**
+ * @brief Creates a parser that matches the longest input accepted by a DFA.
+ *
+ * The automaton is run over the input until it reaches the dead state or the
+ * end of the input, and the parser matches up to the last accepting state
+ * seen. This matches a regular token in a single pass, producing one CPT node
+ * (tag "dfa", no children) rather than a node per character.
+ *
+ * @param name The name of the parser for debugging/CPT. It is reported as expected when nothing matches.
+ * @param dfa The automaton. It isn't copied, so it must outlive the parser.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+EASY_PC_API epc_parser_t * epc_dfa(char const * name, epc_dfa_t const * dfa);
+
+/**
+ * @brief Creates a parser that matches the longest input accepted by a DFA.
+ *        This is a convenience wrapper for `epc_dfa()` that automatically adds the created
+ *        parser to the provided `epc_parser_list`.
+ *
+ * @param list The parser list to add to.
+ * @param name The name of the parser for debugging/CPT. It is reported as expected when nothing matches.
+ * @param dfa The automaton. It isn't copied, so it must outlive the parser.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+static inline epc_parser_t * epc_dfa_l(epc_parser_list * list, char const * name, epc_dfa_t const * dfa)
+{
+    return epc_parser_list_add(list, epc_dfa(name, dfa));
+}
+
 /**
  * @brief Creates a parser that matches a sequence of parsers in order.
  *
@@ -1028,6 +1286,16 @@ static inline epc_parser_t * epc_parser_allocate_l(epc_parser_list * list, char
  * useful for forward declarations where a placeholder parser needs to be
  * filled in later with the definition of another parser.
  *
+ * Rules completed this way may be directly or indirectly left-recursive
+ * (e.g. `expr = expr '+' term | term`). When the rule calls itself at the same
+ * input position, the recursive call fails at first; the match found without
+ * it is then used as a seed, and the rule is re-evaluated with the recursive
+ * call returning the seed for as long as the match keeps getting longer.
+ * Only the rules that can call themselves without consuming input are
+ * tracked this way; they are found when the last rule of a cycle is
+ * completed. Matches aren't memoized, so a left-recursive rule that callers
+ * backtrack over is grown again each time it is retried.
+ *
  * @param dst A pointer to the destination `parser_t` to be filled.
  * @param src A pointer to the source `parser_t` whose contents will be copied.
  */
@@ -1063,6 +1331,254 @@ EASY_PC_API void epc_parser_set_ast_action(epc_parser_t * p, int action_type);
 EASY_PC_API epc_parse_session_t
 epc_parse_input(epc_parser_t * top_parser, const char * input);
 
+/**
+ * @brief Counts how often each alternative of each `epc_or` parser is tried
+ * and how often it matches, over any number of parses.
+ *
+ * Alternatives skipped because they can't start with the next byte (see
+ * `epc_or_first()`) aren't counted as tried. The counts are written out by
+ * parser name with `epc_alternative_profile_write()`, for
+ * `gdl_compiler --profile` to try the alternatives of rules that match most
+ * often first.
+ */
+typedef struct epc_alternative_profile_t epc_alternative_profile_t;
+
+/**
+ * @brief Records the parsers entered and exited during parses, for viewing on
+ * a timeline with `epc_trace_write_chrome_json()`.
+ *
+ * Each thread records into a ring buffer of its own, so a trace may be shared
+ * by parses on several threads; once a buffer is full the oldest events are
+ * overwritten.
+ */
+typedef struct epc_trace_t epc_trace_t;
+
+/**
+ * @brief Options for `epc_trace_create()`. Zero-initialize for the defaults.
+ */
+typedef struct
+{
+    size_t buffer_events;          /**< @brief The number of events each thread keeps, or 0 for 65536. */
+    unsigned sample_every;         /**< @brief Trace one in this many parser calls, or 0 or 1 to trace them all. */
+    char const * const * rules;    /**< @brief Trace only the parsers with these names, or NULL to trace all parsers. */
+    size_t rule_count;             /**< @brief The number of names in `rules`. */
+} epc_trace_config_t;
+
+/**
+ * @brief Counts how often parsers are entered at each offset of the input of
+ * a parse, to find where a grammar backtracks.
+ *
+ * Each parse given the map starts it afresh. Besides a count per input byte,
+ * the map keeps a count per parser and offset, so it takes memory in
+ * proportion to the number of different parsers tried at each offset.
+ */
+typedef struct epc_backtrack_map_t epc_backtrack_map_t;
+
+/**
+ * @brief Limits on the resources a parse may use. Zero means no limit.
+ *
+ * A parse that reaches a limit stops, and fails with an error whose `kind`
+ * identifies the limit. The counts are those of `epc_parse_session_stats()`.
+ * The depth limit guards against stack overflow on deeply nested input; the
+ * call and time limits against grammars that backtrack exponentially.
+ */
+typedef struct
+{
+    size_t max_cpt_nodes;      /**< @brief The most CPT nodes the parse may allocate, including those discarded. */
+    size_t max_cpt_bytes;      /**< @brief The most bytes the parse may allocate for CPT nodes and their child arrays. */
+    size_t max_depth;          /**< @brief The deepest parser calls may nest. */
+    size_t max_parser_calls;   /**< @brief The most parser calls the parse may make. */
+    unsigned max_milliseconds; /**< @brief The longest the parse may take, checked every 1024 parser calls. */
+} epc_parse_limits_t;
+
+/**
+ * @brief How far a parse has got, as passed to an `epc_progress_cb`.
+ */
+typedef struct
+{
+    size_t offset;       /**< @brief The furthest offset into the input any parser has been called at. */
+    size_t input_length; /**< @brief The length of the input. */
+    size_t parser_calls; /**< @brief The number of parser calls made so far. */
+} epc_progress_info_t;
+
+/**
+ * @brief Called as a parse progresses.
+ *
+ * @param info How far the parse has got.
+ * @param user_data The `epc_progress_t::user_data`.
+ * @return true to continue the parse, false to cancel it.
+ */
+typedef bool (*epc_progress_cb)(epc_progress_info_t const * info, void * user_data);
+
+/**
+ * @brief A callback to report the progress of a parse and to cancel it.
+ *
+ * A cancelled parse unwinds at once, freeing the CPT built so far, and fails
+ * with an error of kind `EPC_PARSE_ERROR_CANCELLED`.
+ */
+typedef struct
+{
+    epc_progress_cb callback; /**< @brief The callback, or NULL for none. */
+    void * user_data;         /**< @brief Passed to the callback. */
+    size_t every_bytes;       /**< @brief Call back each time the parse gets this many bytes further into the input, or 0. */
+    size_t every_calls;       /**< @brief Call back after each this many parser calls, or 0. */
+} epc_progress_t;
+
+/**
+ * @brief Options for `epc_parse_input_with_options()`. Zero-initialize for the defaults.
+ */
+typedef struct
+{
+    epc_alternative_profile_t * alternative_profile; /**< @brief Where to count the alternatives tried, or NULL. */
+    epc_trace_t * trace;                             /**< @brief Where to record the parsers entered and exited, or NULL. */
+    epc_backtrack_map_t * backtrack_map;             /**< @brief Where to count the parsers entered at each offset, or NULL. */
+    epc_parse_limits_t limits;                       /**< @brief Limits on the resources the parse may use. */
+    epc_progress_t progress;                         /**< @brief A callback to report progress and to cancel the parse. */
+} epc_parse_options_t;
+
+/**
+ * @brief Like `epc_parse_input()`, with options.
+ *
+ * @param top_parser The starting parser for the grammar (e.g., the root rule).
+ * @param input The string to be parsed.
+ * @param options The options, or NULL for the defaults.
+ * @return The parse session, to be destroyed with `epc_parse_session_destroy()`.
+ */
+EASY_PC_API epc_parse_session_t
+epc_parse_input_with_options(epc_parser_t * top_parser, const char * input, epc_parse_options_t const * options);
+
+/**
+ * @brief Creates an empty alternative profile.
+ *
+ * @return The profile, to be freed with `epc_alternative_profile_free()`, or NULL on error.
+ */
+EASY_PC_API epc_alternative_profile_t * epc_alternative_profile_create(void);
+
+/**
+ * @brief Writes the counts of a profile as text, one line per `epc_or` parser, sorted by name.
+ *
+ * Each line holds the parser's name, its number of alternatives, and then
+ * how often each alternative was tried and how often it matched. The
+ * counts of parsers with the same name and number of alternatives, such as
+ * the copies made for a forward-referenced rule, are added together.
+ *
+ * @param profile The profile.
+ * @param out Where to write the counts.
+ * @return true on success, false on error.
+ */
+EASY_PC_API bool epc_alternative_profile_write(epc_alternative_profile_t const * profile, FILE * out);
+
+/**
+ * @brief Frees an alternative profile.
+ *
+ * @param profile The profile. May be NULL.
+ */
+EASY_PC_API void epc_alternative_profile_free(epc_alternative_profile_t * profile);
+
+/**
+ * @brief Creates a trace.
+ *
+ * Pass it to parses in `epc_parse_options_t::trace`. Parses without it record
+ * nothing, so tracing is switched on and off parse by parse.
+ *
+ * @param config The options, or NULL for the defaults.
+ * @return The trace, to be freed with `epc_trace_free()`, or NULL on error.
+ */
+EASY_PC_API epc_trace_t * epc_trace_create(epc_trace_config_t const * config);
+
+/**
+ * @brief Writes the events recorded in a trace as Chrome Trace Event JSON.
+ *
+ * The file can be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ * Each traced parser call is a slice named after the parser, on a track for
+ * the thread that made it, with the input offset, the length matched and
+ * whether it succeeded. Calls whose start has been overwritten in the ring
+ * buffer are left out. The events refer to the parsers' names, so the
+ * parsers must not be freed before the trace is written.
+ *
+ * @param trace The trace.
+ * @param out Where to write the JSON.
+ * @return true on success, false on error.
+ */
+EASY_PC_API bool epc_trace_write_chrome_json(epc_trace_t const * trace, FILE * out);
+
+/**
+ * @brief Frees a trace. No parse may still be using it.
+ *
+ * @param trace The trace. May be NULL.
+ */
+EASY_PC_API void epc_trace_free(epc_trace_t * trace);
+
+/**
+ * @brief Creates a backtrack map, to be passed to a parse in
+ * `epc_parse_options_t::backtrack_map`.
+ *
+ * @return The map, to be freed with `epc_backtrack_map_free()`, or NULL on error.
+ */
+EASY_PC_API epc_backtrack_map_t * epc_backtrack_map_create(void);
+
+/**
+ * @brief Writes a report of where the last parse given the map entered parsers most.
+ *
+ * The report has a histogram of the number of offsets entered 1, 2-3, 4-7...
+ * times, followed by the `top_n` offsets entered most often, each with its
+ * line and column and the parsers entered there most often, by name. A
+ * parser entered many times at one offset is retried there by the parsers
+ * above it, typically by the alternatives of an `epc_or` or by an
+ * `epc_optional` or `epc_many` inside one; those are the places that gain
+ * from restructuring or memoization.
+ *
+ * @param map The map.
+ * @param top_n The number of offsets to list.
+ * @param out Where to write the report.
+ * @return true on success, false on error.
+ */
+EASY_PC_API bool epc_backtrack_map_write(epc_backtrack_map_t const * map, size_t top_n, FILE * out);
+
+/**
+ * @brief Returns the number of times parsers were entered at an offset of
+ * the input of the last parse given the map.
+ *
+ * @param map The map.
+ * @param offset The offset, in bytes, from the start of the input.
+ * @return The count, or 0 if the offset is beyond the end of the input.
+ */
+EASY_PC_API size_t epc_backtrack_map_count(epc_backtrack_map_t const * map, size_t offset);
+
+/**
+ * @brief Frees a backtrack map.
+ *
+ * @param map The map. May be NULL.
+ */
+EASY_PC_API void epc_backtrack_map_free(epc_backtrack_map_t * map);
+
+/**
+ * @brief Writes a table of the time spent in each parser.
+ *
+ * Only available when the library is built with the `WITH_PARSER_PROFILING`
+ * CMake option, which counts every parser call made by every thread: the
+ * calls, successes, failures and bytes matched, and the time spent in the
+ * parser including (inclusive) and excluding (exclusive) the parsers it
+ * called. The time is in CPU timestamp counter ticks where there is one, or
+ * nanoseconds otherwise, as the table's header says. The parsers are grouped
+ * by name, hottest (by exclusive time) first.
+ *
+ * The counts of threads that have exited are kept. May be called while other
+ * threads are parsing, whose calls still in progress aren't counted yet.
+ *
+ * @param out Where to write the table.
+ * @return true on success, false on error or if profiling isn't built in.
+ */
+EASY_PC_API bool epc_profile_report(FILE * out);
+
+/**
+ * @brief Clears the counters reported by `epc_profile_report()`, and frees
+ * those kept for threads that have exited.
+ *
+ * Calls other threads are making as it runs may be counted in part.
+ */
+EASY_PC_API void epc_profile_reset(void);
+
 /**
  * @brief Destroys an `easy_pc_parse_session_t` and frees all associated resources.
  *
@@ -1074,6 +1590,33 @@ epc_parse_input(epc_parser_t * top_parser, const char * input);
  */
 EASY_PC_API void epc_parse_session_destroy(epc_parse_session_t * session);
 
+/**
+ * @brief Counts of the work and memory a parse took.
+ *
+ * Allocations are those of CPT nodes, their child arrays and errors; other
+ * bookkeeping done while parsing isn't counted. A reallocation counts as an
+ * allocation.
+ */
+typedef struct
+{
+    size_t cpt_nodes;        /**< @brief The number of CPT nodes allocated, including those discarded when backtracking. */
+    size_t cpt_bytes;        /**< @brief The bytes allocated for CPT nodes and their child arrays. */
+    size_t allocations;      /**< @brief The number of allocations made. */
+    size_t peak_allocations; /**< @brief The highest number of those allocations alive at once. */
+    size_t errors_created;   /**< @brief The number of error objects allocated, including copies. */
+    size_t errors_copied;    /**< @brief The number of error objects copied, to keep track of the furthest error. */
+    size_t max_depth;        /**< @brief The deepest nesting of parser calls reached. */
+    size_t parser_calls;     /**< @brief The number of parser calls made. */
+} epc_parse_stats_t;
+
+/**
+ * @brief Returns the counts of the work and memory a parse took.
+ *
+ * @param session The parse session.
+ * @return The counts, or all zero if the session has no parse context.
+ */
+EASY_PC_API epc_parse_stats_t epc_parse_session_stats(epc_parse_session_t const * session);
+
 /**
  * @brief Retrieves the semantically relevant content from a CPT node.
  *
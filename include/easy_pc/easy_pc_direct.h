@@ -0,0 +1,176 @@
+#pragma once
+
+#include <easy_pc/easy_pc.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Support for parsers written directly in C, such as those emitted by
+ * `gdl_compiler --backend=direct`. A direct parser is an ordinary C function
+ * that matches input and builds CPT nodes itself, rather than a graph of
+ * `epc_parser_t` combinators that is interpreted at parse time. These
+ * functions give such code access to the pieces of the library that
+ * combinators use internally, so the CPT and errors it produces can't be told
+ * apart from those of the equivalent combinators.
+ */
+
+/**
+ * @brief The signature of a function implementing a direct parser.
+ *
+ * @param ctx The parse context, to be passed on to the other `epc_direct_*` functions.
+ * @param input The input to parse.
+ * @param user_data The `user_data` given to `epc_direct()`.
+ * @return A successful result holding the CPT node for the match, or an error result.
+ */
+typedef epc_parse_result_t (*epc_direct_parse_fn)(epc_parser_ctx_t * ctx, const char * input, void * user_data);
+
+/**
+ * @brief Creates a parser that calls a C function to do the parsing.
+ *
+ * This lets a direct parser be used wherever an `epc_parser_t` is expected,
+ * e.g. as the top parser passed to `epc_parse_input()`, or as the child of a
+ * combinator. The parser adds no CPT node of its own.
+ * @param name The name of the parser, used when it is reported as expected in an error.
+ * @param parse_fn The function that does the parsing.
+ * @param user_data Passed to `parse_fn` on each call.
+ * @param free_user_data If non-NULL, called with `user_data` when the parser is freed.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+EASY_PC_API epc_parser_t * epc_direct(
+    char const * name, epc_direct_parse_fn parse_fn, void * user_data, void (*free_user_data)(void * user_data));
+
+/**
+ * @brief Creates a parser that calls a C function to do the parsing and adds it to the list.
+ *        This is a convenience wrapper for `epc_direct()` that automatically adds the created
+ *        parser to the provided `epc_parser_list`.
+ *
+ * @param list The parser list to add to.
+ * @param name The name of the parser, used when it is reported as expected in an error.
+ * @param parse_fn The function that does the parsing.
+ * @param user_data Passed to `parse_fn` on each call.
+ * @param free_user_data If non-NULL, called with `user_data` when the parser is freed.
+ * @return A new `parser_t` instance, or NULL on error.
+ */
+static inline epc_parser_t * epc_direct_l(
+    epc_parser_list * list,
+    char const * name,
+    epc_direct_parse_fn parse_fn,
+    void * user_data,
+    void (*free_user_data)(void * user_data))
+{
+    return epc_parser_list_add(list, epc_direct(name, parse_fn, user_data, free_user_data));
+}
+
+/**
+ * @brief Runs a parser from within a direct parser.
+ *
+ * @param parser The parser to run.
+ * @param ctx The parse context passed to the direct parser.
+ * @param input The input to parse.
+ * @return The parser's result. It must eventually be released with `epc_direct_result_cleanup()`
+ *         unless it is handed on to the caller.
+ */
+EASY_PC_API epc_parse_result_t epc_direct_parse(epc_parser_t * parser, epc_parser_ctx_t * ctx, const char * input);
+
+/**
+ * @brief Allocates a CPT node.
+ *
+ * The node has no children, no semantic action and zero length, with
+ * `content` pointing at `input`.
+ * @param tag The node's tag, e.g. "and". Must outlive the node.
+ * @param name The node's name, normally the name of the rule that matched. Must outlive the node.
+ * @param input The start of the node's content.
+ * @return The new node, or NULL on error.
+ */
+EASY_PC_API epc_cpt_node_t * epc_direct_node_alloc(char const * tag, char const * name, const char * input);
+
+/**
+ * @brief Appends a child to a CPT node, taking ownership of it.
+ *
+ * @param parent The node to add the child to.
+ * @param child The child node.
+ * @return true on success. On failure `child` is left to the caller to free.
+ */
+EASY_PC_API bool epc_direct_node_add_child(epc_cpt_node_t * parent, epc_cpt_node_t * child);
+
+/**
+ * @brief Frees a CPT node and all of its children.
+ *
+ * @param node The node to free. May be NULL.
+ */
+EASY_PC_API void epc_direct_node_free(epc_cpt_node_t * node);
+
+/**
+ * @brief Releases the node or error held by a parse result.
+ *
+ * @param result The result to release. It is left zeroed.
+ */
+EASY_PC_API void epc_direct_result_cleanup(epc_parse_result_t * result);
+
+/**
+ * @brief Creates an error result, recording it as the furthest error if appropriate.
+ *
+ * This is what the library's own parsers do when they fail to match.
+ * @param ctx The parse context.
+ * @param input The position of the error.
+ * @param message A description of the error.
+ * @param expected What was expected at `input`.
+ * @param found What was found at `input`.
+ * @return The error result.
+ */
+EASY_PC_API epc_parse_result_t epc_direct_error(
+    epc_parser_ctx_t * ctx, const char * input, const char * message, const char * expected, const char * found);
+
+/**
+ * @brief Takes a copy of the context's furthest error.
+ *
+ * Combinators that backtrack, such as `epc_optional`, save the furthest error
+ * before trying their child so they can put it back if the child's failure
+ * shouldn't be reported.
+ * @param ctx The parse context.
+ * @return The copy, which may be NULL. Pass it to `epc_direct_furthest_error_restore()` or
+ *         `epc_direct_furthest_error_discard()`.
+ */
+EASY_PC_API epc_parser_error_t * epc_direct_furthest_error_save(epc_parser_ctx_t * ctx);
+
+/**
+ * @brief Replaces the context's furthest error with one saved earlier.
+ *
+ * @param ctx The parse context.
+ * @param saved The saved error. The context takes ownership of it and `*saved` is set to NULL.
+ */
+EASY_PC_API void epc_direct_furthest_error_restore(epc_parser_ctx_t * ctx, epc_parser_error_t * * saved);
+
+/**
+ * @brief Frees a saved furthest error that is no longer needed.
+ *
+ * @param saved The saved error. May be NULL.
+ */
+EASY_PC_API void epc_direct_furthest_error_discard(epc_parser_error_t * saved);
+
+/**
+ * @brief Scans an integer the way the `int` parser does.
+ *
+ * @param input The input to scan.
+ * @param value Receives the integer's value. Values that don't fit saturate.
+ * @return The integer's length, or 0 if there is no integer at `input`.
+ */
+EASY_PC_API size_t epc_direct_scan_int(const char * input, long long * value);
+
+/**
+ * @brief Scans a number the way the `double` parser does.
+ *
+ * @param input The input to scan.
+ * @param value Receives the number's value.
+ * @return The number's length, or 0 if there is no number at `input`.
+ */
+EASY_PC_API size_t epc_direct_scan_double(const char * input, double * value);
+
+#ifdef __cplusplus
+}
+#endif
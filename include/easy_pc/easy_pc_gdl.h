@@ -0,0 +1,84 @@
+#pragma once
+
+#include <easy_pc/easy_pc_grammar.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Grammars built from GDL text at run time, with no code generation step.
+ *
+ * These functions are in the easy_pc_gdl library, which contains the GDL
+ * front end of gdl_compiler. The GDL text is parsed, checked and analysed as
+ * gdl_compiler would, and the parsers the default backend would generate are
+ * built in memory, so the CPT and errors are the same as with the generated
+ * code. The semantic actions are bound by name with
+ * `epc_grammar_ast_hook_registry_create()`.
+ */
+
+/**
+ * @brief Builds the parsers of a grammar written in GDL.
+ *
+ * @param gdl_text The grammar.
+ * @param error_message Where to put the reason if the grammar can't be built. May be NULL.
+ * @param error_size The size of `error_message`.
+ * @return The grammar, to be freed with `epc_grammar_free()`, or NULL if the grammar is invalid or on error.
+ */
+EASY_PC_API epc_grammar_t * epc_grammar_from_gdl(char const * gdl_text, char * error_message, size_t error_size);
+
+/**
+ * @brief A cache of grammars built from GDL text, keyed by a hash of the text.
+ *
+ * Building a grammar from GDL means parsing and analysing it. The cache keeps
+ * the result as a grammar blob, from which an identical grammar is built
+ * again in a fraction of the time, so a process that reloads its grammars
+ * only pays for the ones that have changed.
+ */
+typedef struct epc_grammar_cache_t epc_grammar_cache_t;
+
+/**
+ * @brief Creates a grammar cache.
+ *
+ * @param max_entries The number of grammars to keep. When the cache is full
+ *        the grammar used least recently is dropped.
+ * @return The cache, to be freed with `epc_grammar_cache_free()`, or NULL on error.
+ */
+EASY_PC_API epc_grammar_cache_t * epc_grammar_cache_create(int max_entries);
+
+/**
+ * @brief Builds the parsers of a grammar written in GDL, using the cache.
+ *
+ * Works like `epc_grammar_from_gdl()`. Each call returns a new grammar that
+ * belongs to the caller, so grammars from the cache can be used and freed
+ * independently, even after the cache has been freed.
+ *
+ * @param cache The cache.
+ * @param gdl_text The grammar.
+ * @param error_message Where to put the reason if the grammar can't be built. May be NULL.
+ * @param error_size The size of `error_message`.
+ * @return The grammar, to be freed with `epc_grammar_free()`, or NULL if the grammar is invalid or on error.
+ */
+EASY_PC_API epc_grammar_t * epc_grammar_cache_load(
+    epc_grammar_cache_t * cache, char const * gdl_text, char * error_message, size_t error_size);
+
+/**
+ * @brief Returns the number of grammars in a cache.
+ *
+ * @param cache The cache.
+ * @return The number of grammars.
+ */
+EASY_PC_API int epc_grammar_cache_count(epc_grammar_cache_t const * cache);
+
+/**
+ * @brief Frees a grammar cache. Grammars loaded from it are not affected.
+ *
+ * @param cache The cache. May be NULL.
+ */
+EASY_PC_API void epc_grammar_cache_free(epc_grammar_cache_t * cache);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <easy_pc/easy_pc.h>
+#include <easy_pc/easy_pc_ast.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Grammars loaded at run time rather than compiled into the program.
+ *
+ * `gdl_compiler --backend=blob` writes a grammar as a blob: a compact binary
+ * description of the parsers the default backend's generated code would
+ * build. `epc_grammar_load_blob()` builds those parsers from it, so a grammar
+ * can be shipped and changed as data, with no C code to compile. The parsers
+ * behave exactly like the generated ones, so the CPT and errors are the same.
+ */
+
+/**
+ * @brief A grammar loaded at run time. It owns its parsers.
+ */
+typedef struct epc_grammar_t epc_grammar_t;
+
+/**
+ * @brief Builds the parsers of a grammar blob written by `gdl_compiler --backend=blob`.
+ *
+ * The blob is checked before it is used, so a blob that is truncated, corrupt
+ * or written for another version of the format is rejected rather than
+ * trusted. Nothing in the grammar refers to the blob once it is loaded, so
+ * it may be freed or unmapped straight away.
+ *
+ * @param blob The blob, e.g. as read from the file or mapped with `mmap()`. It needn't be aligned.
+ * @param size The size of the blob in bytes.
+ * @return The grammar, to be freed with `epc_grammar_free()`, or NULL if the blob is invalid or on error.
+ */
+EASY_PC_API epc_grammar_t * epc_grammar_load_blob(void const * blob, size_t size);
+
+/**
+ * @brief Returns the parser for the grammar's start rule, to pass to `epc_parse_input()`.
+ *
+ * @param grammar The grammar.
+ * @return The parser. It belongs to the grammar, so it must not be freed.
+ */
+EASY_PC_API epc_parser_t * epc_grammar_parser(epc_grammar_t const * grammar);
+
+/**
+ * @brief Returns the number of semantic actions the grammar uses.
+ *
+ * The actions are numbered from 0 in the order they appear in the grammar,
+ * as in the `_actions.h` header the compiler writes alongside the blob. This
+ * is the number of callbacks to give `epc_ast_hook_registry_create()`.
+ *
+ * @param grammar The grammar.
+ * @return The number of semantic actions.
+ */
+EASY_PC_API int epc_grammar_action_count(epc_grammar_t const * grammar);
+
+/**
+ * @brief Returns the name of a semantic action, as written in the grammar.
+ *
+ * This lets the AST callbacks be registered by name when the grammar is
+ * only known at run time.
+ *
+ * @param grammar The grammar.
+ * @param action The number of the action.
+ * @return The name, or NULL if there is no such action.
+ */
+EASY_PC_API char const * epc_grammar_action_name(epc_grammar_t const * grammar, int action);
+
+/**
+ * @brief Binds a semantic action of a grammar, by name, to an AST callback.
+ */
+typedef struct
+{
+    char const * name;          /**< @brief The name of the action, as written in the grammar. */
+    epc_ast_action_cb action;   /**< @brief The callback to build the AST node with. */
+} epc_grammar_action_binding_t;
+
+/**
+ * @brief Creates the AST hook registry for a grammar, with its callbacks bound by name.
+ *
+ * Bindings for actions the grammar doesn't use are ignored, and actions
+ * without a binding are left unset, so one table of bindings can serve every
+ * version of a grammar that is reloaded at run time.
+ *
+ * @param grammar The grammar.
+ * @param bindings The callbacks, with the names of their actions.
+ * @param binding_count The number of bindings.
+ * @return The registry, to be freed with `epc_ast_hook_registry_free()`, or NULL on error.
+ */
+EASY_PC_API epc_ast_hook_registry_t * epc_grammar_ast_hook_registry_create(
+    epc_grammar_t const * grammar, epc_grammar_action_binding_t const * bindings, int binding_count);
+
+/**
+ * @brief Frees a grammar and all its parsers.
+ *
+ * @param grammar The grammar. May be NULL.
+ */
+EASY_PC_API void epc_grammar_free(epc_grammar_t * grammar);
+
+/*
+ * The blob format. Only the compiler and the loader need this.
+ *
+ * Every field is a 32 bit little-endian word, so a blob works on any host and
+ * at any address. Strings are referred to by their offset in the string pool,
+ * where each is NUL terminated, or by EPC_GRAMMAR_BLOB_NONE for none.
+ *
+ * The blob starts with the header words below. The parser records follow,
+ * one per parser, each being: its op (an epc_grammar_blob_op_t), its name,
+ * its semantic action (or EPC_GRAMMAR_BLOB_NONE), the number of operands and
+ * the operands. A record can only use the parsers of the records before it;
+ * forward references are made with EPC_GRAMMAR_OP_FORWARD and completed with
+ * EPC_GRAMMAR_OP_DEFINE, as with epc_parser_allocate() and
+ * epc_parser_duplicate().
+ *
+ * The token DFA, if any, is its state count and class count, followed by the
+ * 256 byte classes, the transitions (one word per state and class) and one
+ * accepting word per state. All the token parsers share it.
+ */
+
+#define EPC_GRAMMAR_BLOB_MAGIC 0x47435045u /* "EPCG" */
+#define EPC_GRAMMAR_BLOB_VERSION 1u
+#define EPC_GRAMMAR_BLOB_NONE 0xffffffffu
+
+typedef enum
+{
+    EPC_GRAMMAR_BLOB_HEADER_MAGIC,
+    EPC_GRAMMAR_BLOB_HEADER_VERSION,
+    EPC_GRAMMAR_BLOB_HEADER_SIZE,           /* The size of the blob in bytes. */
+    EPC_GRAMMAR_BLOB_HEADER_START,          /* The index of the start rule's parser. */
+    EPC_GRAMMAR_BLOB_HEADER_PARSER_COUNT,
+    EPC_GRAMMAR_BLOB_HEADER_PARSERS,        /* The offset of the parser records. */
+    EPC_GRAMMAR_BLOB_HEADER_STRINGS,        /* The offset of the string pool. */
+    EPC_GRAMMAR_BLOB_HEADER_STRINGS_SIZE,
+    EPC_GRAMMAR_BLOB_HEADER_ACTION_COUNT,
+    EPC_GRAMMAR_BLOB_HEADER_ACTIONS,        /* The offset of the action names, one string per action. */
+    EPC_GRAMMAR_BLOB_HEADER_DFA,            /* The offset of the token DFA, or EPC_GRAMMAR_BLOB_NONE. */
+    EPC_GRAMMAR_BLOB_HEADER_WORDS
+} epc_grammar_blob_header_t;
+
+/* The constructor each parser record stands for, and its operands. */
+typedef enum
+{
+    EPC_GRAMMAR_OP_FORWARD,         /* No operands. */
+    EPC_GRAMMAR_OP_DEFINE,          /* The forward reference and its definition. */
+    EPC_GRAMMAR_OP_STRING,          /* The string. */
+    EPC_GRAMMAR_OP_CHAR,            /* The character. */
+    EPC_GRAMMAR_OP_CHAR_RANGE,      /* The first and last characters. */
+    EPC_GRAMMAR_OP_ONE_OF,          /* The string of characters. */
+    EPC_GRAMMAR_OP_NONE_OF,         /* The string of characters. */
+    EPC_GRAMMAR_OP_FAIL,            /* The message. */
+    EPC_GRAMMAR_OP_EOI,             /* No operands, as for all the terminals up to EPC_GRAMMAR_OP_DOUBLE. */
+    EPC_GRAMMAR_OP_DIGIT,
+    EPC_GRAMMAR_OP_ALPHA,
+    EPC_GRAMMAR_OP_ALPHANUM,
+    EPC_GRAMMAR_OP_SPACE,
+    EPC_GRAMMAR_OP_ANY_CHAR,
+    EPC_GRAMMAR_OP_SUCCEED,
+    EPC_GRAMMAR_OP_CUT,
+    EPC_GRAMMAR_OP_HEX_DIGIT,
+    EPC_GRAMMAR_OP_INT,
+    EPC_GRAMMAR_OP_DOUBLE,
+    EPC_GRAMMAR_OP_AND,             /* The parsers. */
+    EPC_GRAMMAR_OP_OR,              /* The parsers. */
+    EPC_GRAMMAR_OP_OR_FIRST,        /* The parsers, then the 8 words of the epc_first_set_t of each. */
+    EPC_GRAMMAR_OP_KEYWORDS,        /* The keyword strings. */
+    EPC_GRAMMAR_OP_MANY,            /* The parser, as for all the combinators up to EPC_GRAMMAR_OP_LEXEME. */
+    EPC_GRAMMAR_OP_PLUS,
+    EPC_GRAMMAR_OP_OPTIONAL,
+    EPC_GRAMMAR_OP_NOT,
+    EPC_GRAMMAR_OP_LOOKAHEAD,
+    EPC_GRAMMAR_OP_SKIP,
+    EPC_GRAMMAR_OP_PASSTHRU,
+    EPC_GRAMMAR_OP_LEXEME,
+    EPC_GRAMMAR_OP_BETWEEN,         /* The open, content and close parsers. */
+    EPC_GRAMMAR_OP_DELIMITED,       /* The item and delimiter parsers. */
+    EPC_GRAMMAR_OP_CHAINL1,         /* The item and operator parsers. */
+    EPC_GRAMMAR_OP_CHAINR1,         /* The item and operator parsers. */
+    EPC_GRAMMAR_OP_DFA,             /* The token's start state in the token DFA. */
+    EPC_GRAMMAR_OP_REPEAT,          /* The parser and the number of times to match it, for epc_count(). */
+    EPC_GRAMMAR_OP_COUNT
+} epc_grammar_blob_op_t;
+
+#ifdef __cplusplus
+}
+#endif
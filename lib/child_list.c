@@ -13,7 +13,12 @@ child_list_init(child_list_t * list, size_t initial_capacity)
     list->count = 0;
     list->capacity = initial_capacity > 0 ? initial_capacity : 4; // Default initial capacity
     list->children = calloc(list->capacity, sizeof(epc_cpt_node_t *));
-    return list->children != NULL;
+    if (list->children == NULL)
+    {
+        return false;
+    }
+    epc_stats_allocated(list->capacity * sizeof(epc_cpt_node_t *), true, true);
+    return true;
 }
 
 // Appends a child node to the list. Resizes if necessary.
@@ -36,6 +41,7 @@ child_list_append(child_list_t * list, epc_cpt_node_t * child)
             // Allocation failed, do not add child. The list remains in its current state.
             return false;
         }
+        epc_stats_allocated((new_capacity - list->capacity) * sizeof(*new_children), list->capacity == 0, true);
         list->children = new_children;
         list->capacity = new_capacity;
     }
@@ -58,6 +64,10 @@ child_list_release(child_list_t * list)
     {
         epc_node_free(list->children[i]);
     }
+    if (list->children != NULL)
+    {
+        epc_stats_freed(1);
+    }
     free(list->children);
     list->children = NULL;
     list->count = 0;
@@ -1,9 +1,24 @@
 #include "easy_pc_private.h"
 #include "parsers.h"
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
+
+/* A CPT node together with the library's bookkeeping for it, which isn't part of the public struct. */
+typedef struct
+{
+    epc_cpt_node_t node;
+    int shared_count; /* The number of additional owners of the node. Left-recursive rules share nodes while growing a match. */
+} cpt_node_block_t;
+
+static cpt_node_block_t *
+cpt_node_block(epc_cpt_node_t * node)
+{
+    return (cpt_node_block_t *)((char *)node - offsetof(cpt_node_block_t, node));
+}
 
 // --- CPT Visitor ---
 static void
@@ -41,9 +56,211 @@ epc_cpt_visit_nodes(epc_cpt_node_t * root, epc_cpt_visitor_t * visitor)
 
 // --- Top-Level API ---
 
+static uint64_t
+monotonic_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/* The context of the parse running on this thread, for the counts in its stats. */
+static _Thread_local epc_parser_ctx_t * active_ctx;
+
+EASY_PC_HIDDEN
+void
+epc_stats_allocated(size_t bytes, bool new_block, bool cpt)
+{
+    epc_parser_ctx_t * ctx = active_ctx;
+    if (ctx == NULL)
+    {
+        return;
+    }
+    ctx->stats.allocations++;
+    if (cpt)
+    {
+        ctx->stats.cpt_bytes += bytes;
+    }
+    if (new_block && ++ctx->live_allocations > ctx->stats.peak_allocations)
+    {
+        ctx->stats.peak_allocations = ctx->live_allocations;
+    }
+}
+
+EASY_PC_HIDDEN
+void
+epc_stats_node_allocated(void)
+{
+    epc_stats_allocated(sizeof(cpt_node_block_t), true, true);
+    if (active_ctx != NULL)
+    {
+        active_ctx->stats.cpt_nodes++;
+    }
+}
+
+EASY_PC_HIDDEN
+void
+epc_stats_error_allocated(void)
+{
+    /* The error and its three strings. */
+    for (int i = 0; i < 4; i++)
+    {
+        epc_stats_allocated(0, true, false);
+    }
+    if (active_ctx != NULL)
+    {
+        active_ctx->stats.errors_created++;
+    }
+}
+
+EASY_PC_HIDDEN
+void
+epc_stats_error_copied(void)
+{
+    if (active_ctx != NULL)
+    {
+        active_ctx->stats.errors_copied++;
+    }
+}
+
+/* Calls the progress callback if the parse has got far enough since it last did. Returns false to cancel. */
+static bool
+progress_report(epc_parser_ctx_t * ctx, const char * input)
+{
+    epc_progress_t const * progress = &ctx->progress;
+    epc_progress_info_t * info = &ctx->progress_info;
+    size_t offset = (size_t)(input - ctx->input_start);
+    if (offset > info->offset)
+    {
+        info->offset = offset;
+    }
+
+    bool bytes_due = progress->every_bytes != 0 && info->offset >= ctx->next_progress_offset;
+    bool calls_due = progress->every_calls != 0 && ctx->stats.parser_calls >= ctx->next_progress_calls;
+    if (!bytes_due && !calls_due)
+    {
+        return true;
+    }
+    if (bytes_due)
+    {
+        ctx->next_progress_offset = info->offset + progress->every_bytes;
+    }
+    if (calls_due)
+    {
+        ctx->next_progress_calls = ctx->stats.parser_calls + progress->every_calls;
+    }
+    info->parser_calls = ctx->stats.parser_calls;
+
+    return progress->callback(info, progress->user_data);
+}
+
+EASY_PC_HIDDEN
+bool
+epc_parse_limit_reached(epc_parser_ctx_t * ctx, const char * input)
+{
+    if (ctx->limit_reached != EPC_PARSE_ERROR_SYNTAX)
+    {
+        return true;
+    }
+
+    epc_parse_limits_t const * limits = &ctx->limits;
+    epc_parse_stats_t const * stats = &ctx->stats;
+    if (limits->max_depth != 0 && ctx->depth > limits->max_depth)
+    {
+        ctx->limit_reached = EPC_PARSE_ERROR_DEPTH_LIMIT;
+    }
+    else if (limits->max_parser_calls != 0 && stats->parser_calls > limits->max_parser_calls)
+    {
+        ctx->limit_reached = EPC_PARSE_ERROR_STEP_LIMIT;
+    }
+    else if (limits->max_cpt_nodes != 0 && stats->cpt_nodes > limits->max_cpt_nodes)
+    {
+        ctx->limit_reached = EPC_PARSE_ERROR_NODE_LIMIT;
+    }
+    else if (limits->max_cpt_bytes != 0 && stats->cpt_bytes > limits->max_cpt_bytes)
+    {
+        ctx->limit_reached = EPC_PARSE_ERROR_MEMORY_LIMIT;
+    }
+    else if (limits->max_milliseconds != 0 && stats->parser_calls % 1024 == 0 && monotonic_ns() > ctx->deadline_ns)
+    {
+        ctx->limit_reached = EPC_PARSE_ERROR_TIME_LIMIT;
+    }
+    else if (ctx->progress.callback != NULL && !progress_report(ctx, input))
+    {
+        ctx->limit_reached = EPC_PARSE_ERROR_CANCELLED;
+    }
+    else
+    {
+        return false;
+    }
+    ctx->limit_position = input;
+
+    return true;
+}
+
+/* The error for a parse stopped by a limit or cancelled. */
+static epc_parse_result_t
+parse_limit_error_result(epc_parser_ctx_t * ctx)
+{
+    epc_parse_limits_t const * limits = &ctx->limits;
+    char const * message = "Parse limit reached";
+    char expected[64];
+    char const * found = "more";
+
+    switch (ctx->limit_reached)
+    {
+    case EPC_PARSE_ERROR_NODE_LIMIT:
+        snprintf(expected, sizeof(expected), "at most %zu CPT nodes", limits->max_cpt_nodes);
+        break;
+    case EPC_PARSE_ERROR_MEMORY_LIMIT:
+        snprintf(expected, sizeof(expected), "at most %zu bytes of CPT nodes", limits->max_cpt_bytes);
+        break;
+    case EPC_PARSE_ERROR_DEPTH_LIMIT:
+        snprintf(expected, sizeof(expected), "nesting at most %zu deep", limits->max_depth);
+        found = "deeper nesting";
+        break;
+    case EPC_PARSE_ERROR_STEP_LIMIT:
+        snprintf(expected, sizeof(expected), "at most %zu parser calls", limits->max_parser_calls);
+        break;
+    case EPC_PARSE_ERROR_CANCELLED:
+        message = "Parse cancelled";
+        snprintf(expected, sizeof(expected), "the parse to continue");
+        found = "cancellation";
+        break;
+    case EPC_PARSE_ERROR_TIME_LIMIT:
+    default:
+        snprintf(expected, sizeof(expected), "at most %u ms", limits->max_milliseconds);
+        found = "a longer parse";
+        break;
+    }
+
+    epc_parse_result_t result = {
+        .is_error = true,
+        .data.error = epc_parser_error_alloc(ctx, ctx->limit_position, message, expected, found),
+    };
+    if (result.data.error != NULL)
+    {
+        result.data.error->kind = ctx->limit_reached;
+    }
+    return result;
+}
+
+EASY_PC_HIDDEN
+void
+epc_stats_freed(size_t blocks)
+{
+    epc_parser_ctx_t * ctx = active_ctx;
+    if (ctx == NULL)
+    {
+        return;
+    }
+    /* The blocks may have been counted by another parse, e.g. a nested one. */
+    ctx->live_allocations -= blocks < ctx->live_allocations ? blocks : ctx->live_allocations;
+}
+
 // Internal parser_ctx_t creation (for parse results)
 static epc_parser_ctx_t *
-internal_create_parse_ctx(const char * input_start)
+internal_create_parse_ctx(const char * input_start, epc_parse_options_t const * options)
 {
     epc_parser_ctx_t * ctx = calloc(1, sizeof(*ctx));
     if (!ctx)
@@ -52,6 +269,32 @@ internal_create_parse_ctx(const char * input_start)
     }
 
     ctx->input_start = input_start;
+    if (options != NULL)
+    {
+        ctx->alternative_profile = options->alternative_profile;
+        ctx->trace = options->trace;
+        ctx->backtrack_map = options->backtrack_map;
+        ctx->limits = options->limits;
+        ctx->progress = options->progress;
+        ctx->has_checks = ctx->limits.max_cpt_nodes != 0 || ctx->limits.max_cpt_bytes != 0
+                          || ctx->limits.max_depth != 0 || ctx->limits.max_parser_calls != 0
+                          || ctx->limits.max_milliseconds != 0 || ctx->progress.callback != NULL;
+        if (ctx->progress.callback != NULL)
+        {
+            ctx->progress_info.input_length = input_start != NULL ? strlen(input_start) : 0;
+            ctx->next_progress_offset = ctx->progress.every_bytes;
+            ctx->next_progress_calls = ctx->progress.every_calls;
+        }
+        if (ctx->limits.max_milliseconds != 0)
+        {
+            ctx->deadline_ns = monotonic_ns() + (uint64_t)ctx->limits.max_milliseconds * 1000000u;
+        }
+        if (ctx->backtrack_map != NULL && !epc_backtrack_map_begin(ctx->backtrack_map, input_start))
+        {
+            free(ctx);
+            return NULL;
+        }
+    }
 
     return ctx;
 }
@@ -71,10 +314,16 @@ internal_destroy_parse_ctx(epc_parser_ctx_t * ctx)
 
 EASY_PC_API epc_parse_session_t
 epc_parse_input(epc_parser_t * top_parser, const char * input_string)
+{
+    return epc_parse_input_with_options(top_parser, input_string, NULL);
+}
+
+EASY_PC_API epc_parse_session_t
+epc_parse_input_with_options(epc_parser_t * top_parser, const char * input_string, epc_parse_options_t const * options)
 {
     epc_parse_session_t session_result = { 0 };
 
-    epc_parser_ctx_t * ctx = internal_create_parse_ctx(input_string);
+    epc_parser_ctx_t * ctx = internal_create_parse_ctx(input_string, options);
     if (!ctx)
     {
         session_result.result = epc_unparsed_error_result(
@@ -101,7 +350,19 @@ epc_parse_input(epc_parser_t * top_parser, const char * input_string)
         return session_result;
     }
 
-    session_result.result = top_parser->parse_fn(top_parser, ctx, input_string);
+    epc_parser_ctx_t * outer_ctx = active_ctx;
+    active_ctx = ctx;
+
+    session_result.result = epc_parser_parse(top_parser, ctx, input_string);
+
+    if (ctx->limit_reached != EPC_PARSE_ERROR_SYNTAX)
+    {
+        // The parse was stopped, so whatever it returned is beside the point.
+        epc_parser_result_cleanup(&session_result.result);
+        session_result.result = parse_limit_error_result(ctx);
+        active_ctx = outer_ctx;
+        return session_result;
+    }
 
     // After parsing, if an error occurred, check if the tracked "furthest_error"
     // is more informative than the one that caused the final failure.
@@ -127,10 +388,21 @@ epc_parse_input(epc_parser_t * top_parser, const char * input_string)
             epc_parser_error_free(furthest_error);
         }
     }
+    active_ctx = outer_ctx;
 
     return session_result;
 }
 
+EASY_PC_API epc_parse_stats_t
+epc_parse_session_stats(epc_parse_session_t const * session)
+{
+    if (session == NULL || session->internal_parse_ctx == NULL)
+    {
+        return (epc_parse_stats_t){ 0 };
+    }
+    return session->internal_parse_ctx->stats;
+}
+
 EASY_PC_API void
     epc_parse_session_destroy(epc_parse_session_t * session)
 {
@@ -148,12 +420,33 @@ EASY_PC_API void
     }
 }
 
+EASY_PC_HIDDEN
+epc_cpt_node_t *
+epc_node_calloc(void)
+{
+    cpt_node_block_t * block = calloc(1, sizeof(*block));
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    epc_stats_node_allocated();
+
+    return &block->node;
+}
+
+EASY_PC_HIDDEN
+void
+epc_node_share(epc_cpt_node_t * node)
+{
+    cpt_node_block(node)->shared_count++;
+}
+
 ATTR_NONNULL(1, 2)
 EASY_PC_HIDDEN
 epc_cpt_node_t *
 epc_node_alloc(epc_parser_t * parser, char const * tag)
 {
-    epc_cpt_node_t * node = calloc(1, sizeof(*node));
+    epc_cpt_node_t * node = epc_node_calloc();
     if (node == NULL)
     {
         return NULL;
@@ -174,6 +467,13 @@ epc_node_free(epc_cpt_node_t * node)
     {
         return;
     }
+    cpt_node_block_t * block = cpt_node_block(node);
+    if (block->shared_count > 0)
+    {
+        /* Another owner still refers to this node. */
+        block->shared_count--;
+        return;
+    }
     if (node->children != NULL)
     {
         for (int i = 0; i < node->children_count; i++)
@@ -181,8 +481,22 @@ epc_node_free(epc_cpt_node_t * node)
             epc_node_free(node->children[i]);
         }
         free(node->children);
+        epc_stats_freed(1);
+    }
+    free(block);
+    epc_stats_freed(1);
+}
+
+EASY_PC_HIDDEN
+epc_cpt_node_t **
+epc_children_alloc(size_t count)
+{
+    epc_cpt_node_t ** children = calloc(count, sizeof(*children));
+    if (children != NULL)
+    {
+        epc_stats_allocated(count * sizeof(*children), true, true);
     }
-    free(node);
+    return children;
 }
 
 EASY_PC_API epc_parser_list *
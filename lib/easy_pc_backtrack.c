@@ -0,0 +1,418 @@
+#include "easy_pc_private.h"
+#include "parser_map.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The number of parsers listed for each hot offset. */
+#define RULES_PER_OFFSET 5
+
+/* How often parsers with one name were entered at one offset. */
+typedef struct
+{
+    size_t offset;
+    size_t name_index;
+    size_t count;                   /* 0 if the slot is free. */
+} offset_count_t;
+
+struct epc_backtrack_map_t
+{
+    size_t input_len;
+    size_t * counts;                /* input_len + 1 counts, one per offset. */
+    size_t * line_starts;           /* The offset each line starts at. */
+    size_t line_count;
+
+    parser_map_t parsers;           /* The index of each parser's name in names. */
+    char ** names;                  /* Distinct names, so they outlive the parsers. */
+    size_t name_count;
+
+    offset_count_t * pairs;         /* Open-addressed by offset and name. */
+    size_t pairs_capacity;          /* A power of two. */
+    size_t pairs_used;
+
+    bool failed;                    /* Ran out of memory recording; the per-parser counts are incomplete. */
+};
+
+static size_t
+mix_hash(uintptr_t a, uintptr_t b)
+{
+    uint64_t key = (uint64_t)a * 0x9e3779b97f4a7c15u ^ (uint64_t)b;
+    key ^= key >> 29;
+    key *= 0xbf58476d1ce4e5b9u;
+    return (size_t)(key ^ (key >> 32));
+}
+
+EASY_PC_API epc_backtrack_map_t *
+epc_backtrack_map_create(void)
+{
+    return calloc(1, sizeof(epc_backtrack_map_t));
+}
+
+static void
+backtrack_map_clear(epc_backtrack_map_t * map)
+{
+    free(map->counts);
+    free(map->line_starts);
+    parser_map_release(&map->parsers);
+    for (size_t i = 0; i < map->name_count; i++)
+    {
+        free(map->names[i]);
+    }
+    free(map->names);
+    free(map->pairs);
+    *map = (epc_backtrack_map_t){ 0 };
+}
+
+EASY_PC_API void
+epc_backtrack_map_free(epc_backtrack_map_t * map)
+{
+    if (map == NULL)
+    {
+        return;
+    }
+    backtrack_map_clear(map);
+    free(map);
+}
+
+EASY_PC_HIDDEN bool
+epc_backtrack_map_begin(epc_backtrack_map_t * map, const char * input)
+{
+    backtrack_map_clear(map);
+
+    map->input_len = input != NULL ? strlen(input) : 0;
+    map->counts = calloc(map->input_len + 1, sizeof(*map->counts));
+    map->line_count = 1;
+    for (size_t i = 0; i < map->input_len; i++)
+    {
+        map->line_count += input[i] == '\n';
+    }
+    map->line_starts = malloc(map->line_count * sizeof(*map->line_starts));
+    if (map->counts == NULL || map->line_starts == NULL)
+    {
+        backtrack_map_clear(map);
+        return false;
+    }
+    size_t line = 0;
+    map->line_starts[line++] = 0;
+    for (size_t i = 0; i < map->input_len; i++)
+    {
+        if (input[i] == '\n')
+        {
+            map->line_starts[line++] = i + 1;
+        }
+    }
+
+    return true;
+}
+
+static offset_count_t *
+pair_slot(offset_count_t * pairs, size_t capacity, size_t offset, size_t name_index)
+{
+    size_t i = mix_hash(offset, name_index) & (capacity - 1);
+    while (pairs[i].count != 0 && (pairs[i].offset != offset || pairs[i].name_index != name_index))
+    {
+        i = (i + 1) & (capacity - 1);
+    }
+    return &pairs[i];
+}
+
+static bool
+pairs_grow(epc_backtrack_map_t * map)
+{
+    size_t capacity = map->pairs_capacity == 0 ? 1024 : map->pairs_capacity * 2;
+    offset_count_t * pairs = calloc(capacity, sizeof(*pairs));
+    if (pairs == NULL)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < map->pairs_capacity; i++)
+    {
+        offset_count_t const * pair = &map->pairs[i];
+        if (pair->count != 0)
+        {
+            *pair_slot(pairs, capacity, pair->offset, pair->name_index) = *pair;
+        }
+    }
+    free(map->pairs);
+    map->pairs = pairs;
+    map->pairs_capacity = capacity;
+    return true;
+}
+
+/* Returns the index of the parser's name in map->names, adding it if need be, or -1 on error. */
+static ptrdiff_t
+name_index_get(epc_backtrack_map_t * map, epc_parser_t const * parser)
+{
+    size_t name_index;
+    if (parser_map_find(&map->parsers, parser, &name_index))
+    {
+        return (ptrdiff_t)name_index;
+    }
+
+    char const * name = parser->name != NULL ? parser->name : "";
+    name_index = 0;
+    while (name_index < map->name_count && strcmp(map->names[name_index], name) != 0)
+    {
+        name_index++;
+    }
+    if (name_index == map->name_count)
+    {
+        char ** names = realloc(map->names, (map->name_count + 1) * sizeof(*names));
+        if (names == NULL)
+        {
+            return -1;
+        }
+        map->names = names;
+        map->names[name_index] = strdup(name);
+        if (map->names[name_index] == NULL)
+        {
+            return -1;
+        }
+        map->name_count++;
+    }
+    if (!parser_map_add(&map->parsers, parser, name_index))
+    {
+        return -1;
+    }
+
+    return (ptrdiff_t)name_index;
+}
+
+EASY_PC_HIDDEN void
+epc_backtrack_map_record(epc_backtrack_map_t * map, epc_parser_t const * parser, size_t offset)
+{
+    if (offset > map->input_len)
+    {
+        return;
+    }
+    map->counts[offset]++;
+    if (map->failed)
+    {
+        return;
+    }
+
+    ptrdiff_t name_index = name_index_get(map, parser);
+    if (name_index < 0 || ((map->pairs_used + 1) * 2 > map->pairs_capacity && !pairs_grow(map)))
+    {
+        map->failed = true;
+        return;
+    }
+    offset_count_t * pair = pair_slot(map->pairs, map->pairs_capacity, offset, (size_t)name_index);
+    if (pair->count == 0)
+    {
+        *pair = (offset_count_t){ .offset = offset, .name_index = (size_t)name_index };
+        map->pairs_used++;
+    }
+    pair->count++;
+}
+
+EASY_PC_API size_t
+epc_backtrack_map_count(epc_backtrack_map_t const * map, size_t offset)
+{
+    if (map->counts == NULL || offset > map->input_len)
+    {
+        return 0;
+    }
+    return map->counts[offset];
+}
+
+/* Sorts by count, highest first, then by offset, lowest first. */
+static int
+compare_offsets_by_count(void const * a, void const * b)
+{
+    offset_count_t const * left = a;
+    offset_count_t const * right = b;
+
+    if (left->count != right->count)
+    {
+        return left->count < right->count ? 1 : -1;
+    }
+    return left->offset < right->offset ? -1 : left->offset > right->offset;
+}
+
+static int
+compare_offsets(void const * a, void const * b)
+{
+    size_t left = *(size_t const *)a;
+    size_t right = *(size_t const *)b;
+
+    return left < right ? -1 : left > right;
+}
+
+/* Sorts by count, highest first, then by name, in the order first entered. */
+static int
+compare_pairs_by_count(void const * a, void const * b)
+{
+    offset_count_t const * left = a;
+    offset_count_t const * right = b;
+
+    if (left->count != right->count)
+    {
+        return left->count < right->count ? 1 : -1;
+    }
+    return left->name_index < right->name_index ? -1 : left->name_index > right->name_index;
+}
+
+static bool
+write_hot_offset(epc_backtrack_map_t const * map, size_t offset, offset_count_t * rules, size_t rule_count, FILE * out)
+{
+    /* The line is the last one starting at or before the offset. */
+    size_t low = 0;
+    size_t high = map->line_count;
+    while (high - low > 1)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (map->line_starts[middle] <= offset)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    bool success = fprintf(out, "%10zu %12zu %8zu:%-6zu ", offset, map->counts[offset], low + 1,
+                           offset - map->line_starts[low] + 1) >= 0;
+    qsort(rules, rule_count, sizeof(*rules), compare_pairs_by_count);
+    for (size_t i = 0; i < rule_count && i < RULES_PER_OFFSET && success; i++)
+    {
+        char const * name = map->names[rules[i].name_index];
+        success = fprintf(out, " %s (%zu)", name[0] != '\0' ? name : "-", rules[i].count) >= 0;
+    }
+    if (success && rule_count > RULES_PER_OFFSET)
+    {
+        success = fprintf(out, " ...") >= 0;
+    }
+    return success && fputc('\n', out) != EOF;
+}
+
+EASY_PC_API bool
+epc_backtrack_map_write(epc_backtrack_map_t const * map, size_t top_n, FILE * out)
+{
+    size_t total = 0;
+    size_t offsets_entered = 0;
+    size_t buckets[64] = { 0 };
+    size_t bucket_count = 0;
+    for (size_t offset = 0; map->counts != NULL && offset <= map->input_len; offset++)
+    {
+        size_t count = map->counts[offset];
+        if (count == 0)
+        {
+            continue;
+        }
+        total += count;
+        offsets_entered++;
+        size_t bucket = 0;
+        while (count >> (bucket + 1) != 0)
+        {
+            bucket++;
+        }
+        buckets[bucket]++;
+        if (bucket + 1 > bucket_count)
+        {
+            bucket_count = bucket + 1;
+        }
+    }
+
+    bool success = fprintf(out, "Parsers entered %zu times at %zu of %zu offsets, %.2f per byte of input.\n", total,
+                           offsets_entered, map->input_len + (map->counts != NULL),
+                           map->input_len > 0 ? (double)total / map->input_len : 0.0) >= 0;
+    if (success && map->failed)
+    {
+        success = fprintf(out, "Out of memory: the parsers listed are incomplete.\n") >= 0;
+    }
+    success = success && fprintf(out, "\n%-16s %10s\n", "entered", "offsets") >= 0;
+    for (size_t bucket = 0; bucket < bucket_count && success; bucket++)
+    {
+        if (buckets[bucket] == 0)
+        {
+            continue;
+        }
+        char range[48];
+        size_t low = (size_t)1 << bucket;
+        size_t high = (low << 1) - 1;
+        if (low == high)
+        {
+            snprintf(range, sizeof(range), "%zu", low);
+        }
+        else
+        {
+            snprintf(range, sizeof(range), "%zu-%zu", low, high);
+        }
+        success = fprintf(out, "%-16s %10zu\n", range, buckets[bucket]) >= 0;
+    }
+    if (!success || top_n == 0 || offsets_entered == 0)
+    {
+        return success;
+    }
+
+    /* The hottest offsets, then the counts of the parsers entered at them. */
+    offset_count_t * hot = malloc(offsets_entered * sizeof(*hot));
+    if (hot == NULL)
+    {
+        return false;
+    }
+    size_t hot_count = 0;
+    for (size_t offset = 0; offset <= map->input_len; offset++)
+    {
+        if (map->counts[offset] != 0)
+        {
+            hot[hot_count++] = (offset_count_t){ .offset = offset, .count = map->counts[offset] };
+        }
+    }
+    qsort(hot, hot_count, sizeof(*hot), compare_offsets_by_count);
+    if (hot_count > top_n)
+    {
+        hot_count = top_n;
+    }
+    size_t * by_offset = malloc(hot_count * sizeof(*by_offset));
+    size_t * rule_counts = calloc(hot_count, sizeof(*rule_counts));
+    offset_count_t ** rules = calloc(hot_count, sizeof(*rules));
+    success = by_offset != NULL && rule_counts != NULL && rules != NULL;
+    if (success)
+    {
+        for (size_t i = 0; i < hot_count; i++)
+        {
+            by_offset[i] = hot[i].offset;
+        }
+        qsort(by_offset, hot_count, sizeof(*by_offset), compare_offsets);
+        for (size_t i = 0; i < hot_count && success; i++)
+        {
+            rules[i] = malloc(map->name_count * sizeof(*rules[i]) + 1);
+            success = rules[i] != NULL;
+        }
+    }
+    for (size_t i = 0; i < map->pairs_capacity && success; i++)
+    {
+        offset_count_t const * pair = &map->pairs[i];
+        size_t const * found = pair->count != 0
+                                   ? bsearch(&pair->offset, by_offset, hot_count, sizeof(*by_offset), compare_offsets)
+                                   : NULL;
+        if (found != NULL)
+        {
+            size_t index = (size_t)(found - by_offset);
+            rules[index][rule_counts[index]++] = *pair;
+        }
+    }
+
+    success = success && fprintf(out, "\n%10s %12s %15s  parsers entered most\n", "offset", "entered", "line:col") >= 0;
+    for (size_t i = 0; i < hot_count && success; i++)
+    {
+        size_t const * found = bsearch(&hot[i].offset, by_offset, hot_count, sizeof(*by_offset), compare_offsets);
+        size_t index = (size_t)(found - by_offset);
+        success = write_hot_offset(map, hot[i].offset, rules[index], rule_counts[index], out);
+    }
+
+    for (size_t i = 0; rules != NULL && i < hot_count; i++)
+    {
+        free(rules[i]);
+    }
+    free(rules);
+    free(rule_counts);
+    free(by_offset);
+    free(hot);
+
+    return success;
+}
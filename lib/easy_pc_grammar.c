@@ -0,0 +1,722 @@
+#include "easy_pc_private.h"
+
+#include <easy_pc/easy_pc_grammar.h>
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct epc_grammar_t
+{
+    epc_parser_list * parsers;
+    epc_parser_t * start;
+    char * * action_names;
+    int action_count;
+    /* The token DFA, shared by all the token parsers. */
+    unsigned char dfa_classes[256];
+    unsigned short * dfa_transitions;
+    unsigned char * dfa_accepting;
+    int dfa_state_count;
+    int dfa_class_count;
+    epc_dfa_t * dfas;               /* One for each token parser. */
+    int dfa_count;
+};
+
+typedef struct
+{
+    unsigned char const * bytes;
+    size_t size;
+    char const * strings;
+    uint32_t strings_size;
+} blob_t;
+
+/* A parser record, as read from the blob. */
+typedef struct
+{
+    uint32_t op;
+    uint32_t name;
+    uint32_t action;
+    uint32_t operand_count;
+    size_t operands;                /* The offset of the operands. */
+} blob_record_t;
+
+static bool
+blob_word(blob_t const * blob, size_t offset, uint32_t * word)
+{
+    if (offset > blob->size || blob->size - offset < 4)
+    {
+        return false;
+    }
+    unsigned char const * p = blob->bytes + offset;
+    *word = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+    return true;
+}
+
+/* Looks up a string reference. EPC_GRAMMAR_BLOB_NONE gives NULL. */
+static bool
+blob_string(blob_t const * blob, uint32_t reference, char const * * string)
+{
+    if (reference == EPC_GRAMMAR_BLOB_NONE)
+    {
+        *string = NULL;
+        return true;
+    }
+    if (reference >= blob->strings_size || memchr(blob->strings + reference, '\0', blob->strings_size - reference) == NULL)
+    {
+        return false;
+    }
+    *string = blob->strings + reference;
+    return true;
+}
+
+/* Reads the record at *offset, and moves *offset on to the next one. */
+static bool
+blob_record(blob_t const * blob, size_t * offset, blob_record_t * record)
+{
+    if (!blob_word(blob, *offset, &record->op)
+        || !blob_word(blob, *offset + 4, &record->name)
+        || !blob_word(blob, *offset + 8, &record->action)
+        || !blob_word(blob, *offset + 12, &record->operand_count))
+    {
+        return false;
+    }
+    record->operands = *offset + 16;
+    if (record->op >= EPC_GRAMMAR_OP_COUNT || record->operand_count > (blob->size - record->operands) / 4)
+    {
+        return false;
+    }
+    *offset = record->operands + (size_t)record->operand_count * 4;
+    return true;
+}
+
+static bool
+grammar_load_dfa(epc_grammar_t * grammar, blob_t const * blob, uint32_t offset)
+{
+    uint32_t state_count;
+    uint32_t class_count;
+
+    if (!blob_word(blob, offset, &state_count) || !blob_word(blob, (size_t)offset + 4, &class_count)
+        || state_count < 1 || state_count > 65535 || class_count < 1 || class_count > 256)
+    {
+        return false;
+    }
+
+    size_t word = (size_t)offset + 8;
+    for (int c = 0; c < 256; c++, word += 4)
+    {
+        uint32_t value;
+        if (!blob_word(blob, word, &value) || value >= class_count)
+        {
+            return false;
+        }
+        grammar->dfa_classes[c] = (unsigned char)value;
+    }
+
+    size_t transition_count = (size_t)state_count * class_count;
+    grammar->dfa_transitions = malloc(transition_count * sizeof(*grammar->dfa_transitions));
+    grammar->dfa_accepting = malloc(state_count);
+    if (grammar->dfa_transitions == NULL || grammar->dfa_accepting == NULL)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < transition_count; i++, word += 4)
+    {
+        uint32_t value;
+        if (!blob_word(blob, word, &value) || value >= state_count)
+        {
+            return false;
+        }
+        grammar->dfa_transitions[i] = (unsigned short)value;
+    }
+    for (uint32_t s = 0; s < state_count; s++, word += 4)
+    {
+        uint32_t value;
+        if (!blob_word(blob, word, &value))
+        {
+            return false;
+        }
+        grammar->dfa_accepting[s] = value != 0;
+    }
+    grammar->dfa_state_count = (int)state_count;
+    grammar->dfa_class_count = (int)class_count;
+
+    return true;
+}
+
+static bool
+grammar_load_actions(epc_grammar_t * grammar, blob_t const * blob, uint32_t count, uint32_t offset)
+{
+    if (count == 0)
+    {
+        return true;
+    }
+    if (count > (blob->size / 4))
+    {
+        return false;
+    }
+    grammar->action_names = calloc(count, sizeof(*grammar->action_names));
+    if (grammar->action_names == NULL)
+    {
+        return false;
+    }
+    grammar->action_count = (int)count;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t reference;
+        char const * name;
+        if (!blob_word(blob, (size_t)offset + i * 4, &reference) || !blob_string(blob, reference, &name) || name == NULL)
+        {
+            return false;
+        }
+        grammar->action_names[i] = strdup(name);
+        if (grammar->action_names[i] == NULL)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+typedef struct
+{
+    epc_grammar_t * grammar;
+    blob_t const * blob;
+    epc_parser_t * * slots;         /* The parser of each record. */
+    uint32_t * ops;                 /* The op of each record. Defined forward references become EPC_GRAMMAR_OP_DEFINE. */
+    uint32_t index;                 /* The record being loaded. */
+} loader_t;
+
+static bool
+loader_operand(loader_t const * loader, blob_record_t const * record, uint32_t i, uint32_t * value)
+{
+    return i < record->operand_count && blob_word(loader->blob, record->operands + (size_t)i * 4, value);
+}
+
+/* Operands refer to the parsers of earlier records. */
+static epc_parser_t *
+loader_parser_operand(loader_t const * loader, blob_record_t const * record, uint32_t i)
+{
+    uint32_t value;
+    if (!loader_operand(loader, record, i, &value) || value >= loader->index)
+    {
+        return NULL;
+    }
+    return loader->slots[value];
+}
+
+static char const *
+loader_string_operand(loader_t const * loader, blob_record_t const * record, uint32_t i)
+{
+    uint32_t value;
+    char const * string;
+    if (!loader_operand(loader, record, i, &value) || !blob_string(loader->blob, value, &string))
+    {
+        return NULL;
+    }
+    return string;
+}
+
+static bool
+loader_char_operand(loader_t const * loader, blob_record_t const * record, uint32_t i, char * c)
+{
+    uint32_t value;
+    if (!loader_operand(loader, record, i, &value) || value > 0xff)
+    {
+        return false;
+    }
+    *c = (char)value;
+    return true;
+}
+
+static epc_parser_t *
+loader_list(loader_t const * loader, blob_record_t const * record, char const * name)
+{
+    bool with_first = record->op == EPC_GRAMMAR_OP_OR_FIRST;
+    uint32_t words_per_parser = with_first ? 1 + sizeof(epc_first_set_t) / 4 : 1;
+    if (record->operand_count == 0 || record->operand_count % words_per_parser != 0)
+    {
+        return NULL;
+    }
+    int count = (int)(record->operand_count / words_per_parser);
+
+    epc_parser_t * p = NULL;
+    epc_parser_t * * parsers = calloc(count, sizeof(*parsers));
+    epc_first_set_t * first = with_first ? calloc(count, sizeof(*first)) : NULL;
+    if (parsers == NULL || (with_first && first == NULL))
+    {
+        goto done;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        parsers[i] = loader_parser_operand(loader, record, (uint32_t)i);
+        if (parsers[i] == NULL)
+        {
+            goto done;
+        }
+    }
+    for (int i = 0; with_first && i < count; i++)
+    {
+        for (uint32_t w = 0; w < sizeof(epc_first_set_t) / 4; w++)
+        {
+            uint32_t bits;
+            if (!loader_operand(loader, record, (uint32_t)count + (uint32_t)i * (sizeof(epc_first_set_t) / 4) + w, &bits))
+            {
+                goto done;
+            }
+            for (int b = 0; b < 4; b++)
+            {
+                first[i].bits[w * 4 + b] = (unsigned char)(bits >> (b * 8));
+            }
+        }
+    }
+
+    switch (record->op)
+    {
+    case EPC_GRAMMAR_OP_AND:
+        p = epc_and_a(name, count, parsers);
+        break;
+    case EPC_GRAMMAR_OP_OR:
+        p = epc_or_a(name, count, parsers);
+        break;
+    default:
+        p = epc_or_first_a(name, first, count, parsers);
+        break;
+    }
+    p = epc_parser_list_add(loader->grammar->parsers, p);
+
+done:
+    free(parsers);
+    free(first);
+    return p;
+}
+
+static epc_parser_t *
+loader_keywords(loader_t const * loader, blob_record_t const * record, char const * name)
+{
+    if (record->operand_count == 0)
+    {
+        return NULL;
+    }
+    int count = (int)record->operand_count;
+    char const * * keywords = calloc(count, sizeof(*keywords));
+    if (keywords == NULL)
+    {
+        return NULL;
+    }
+    epc_parser_t * p = NULL;
+    int i;
+    for (i = 0; i < count; i++)
+    {
+        keywords[i] = loader_string_operand(loader, record, (uint32_t)i);
+        if (keywords[i] == NULL)
+        {
+            break;
+        }
+    }
+    if (i == count)
+    {
+        p = epc_keywords_l(loader->grammar->parsers, name, keywords, count);
+    }
+    free(keywords);
+    return p;
+}
+
+static epc_parser_t *
+loader_dfa(loader_t const * loader, blob_record_t const * record, char const * name)
+{
+    epc_grammar_t * grammar = loader->grammar;
+    uint32_t start;
+    if (grammar->dfa_transitions == NULL || !loader_operand(loader, record, 0, &start)
+        || start >= (uint32_t)grammar->dfa_state_count)
+    {
+        return NULL;
+    }
+    epc_dfa_t * dfa = &grammar->dfas[grammar->dfa_count++];
+    *dfa = (epc_dfa_t){
+        .classes = grammar->dfa_classes,
+        .transitions = grammar->dfa_transitions,
+        .accepting = grammar->dfa_accepting,
+        .class_count = grammar->dfa_class_count,
+        .start = (int)start,
+    };
+    return epc_dfa_l(grammar->parsers, name, dfa);
+}
+
+/* Builds the parser for a record, as the generated code would have. */
+static epc_parser_t *
+loader_parser(loader_t * loader, blob_record_t const * record)
+{
+    epc_parser_list * list = loader->grammar->parsers;
+    char const * name;
+    char a;
+    char b;
+
+    if (!blob_string(loader->blob, record->name, &name))
+    {
+        return NULL;
+    }
+
+    switch ((epc_grammar_blob_op_t)record->op)
+    {
+    case EPC_GRAMMAR_OP_FORWARD:
+        return name != NULL ? epc_parser_allocate_l(list, name) : NULL;
+
+    case EPC_GRAMMAR_OP_DEFINE:
+    {
+        uint32_t forward;
+        uint32_t definition;
+        if (!loader_operand(loader, record, 0, &forward) || !loader_operand(loader, record, 1, &definition)
+            || forward >= loader->index || definition >= loader->index
+            || loader->ops[forward] != EPC_GRAMMAR_OP_FORWARD || loader->ops[definition] == EPC_GRAMMAR_OP_FORWARD)
+        {
+            return NULL;
+        }
+        epc_parser_duplicate(loader->slots[forward], loader->slots[definition]);
+        loader->ops[forward] = EPC_GRAMMAR_OP_DEFINE;
+        return loader->slots[forward];
+    }
+
+    case EPC_GRAMMAR_OP_STRING:
+    {
+        char const * s = loader_string_operand(loader, record, 0);
+        return s != NULL ? epc_string_l(list, name, s) : NULL;
+    }
+
+    case EPC_GRAMMAR_OP_CHAR:
+        return loader_char_operand(loader, record, 0, &a) ? epc_char_l(list, name, a) : NULL;
+
+    case EPC_GRAMMAR_OP_CHAR_RANGE:
+        return loader_char_operand(loader, record, 0, &a) && loader_char_operand(loader, record, 1, &b)
+            ? epc_char_range_l(list, name, a, b)
+            : NULL;
+
+    case EPC_GRAMMAR_OP_ONE_OF:
+    {
+        char const * s = loader_string_operand(loader, record, 0);
+        return s != NULL ? epc_one_of_l(list, name, s) : NULL;
+    }
+
+    case EPC_GRAMMAR_OP_NONE_OF:
+    {
+        char const * s = loader_string_operand(loader, record, 0);
+        return s != NULL ? epc_none_of_l(list, name, s) : NULL;
+    }
+
+    case EPC_GRAMMAR_OP_FAIL:
+    {
+        char const * message = loader_string_operand(loader, record, 0);
+        return message != NULL ? epc_fail_l(list, name, message) : NULL;
+    }
+
+    case EPC_GRAMMAR_OP_EOI:
+        return epc_eoi_l(list, name);
+    case EPC_GRAMMAR_OP_DIGIT:
+        return epc_digit_l(list, name);
+    case EPC_GRAMMAR_OP_ALPHA:
+        return epc_alpha_l(list, name);
+    case EPC_GRAMMAR_OP_ALPHANUM:
+        return epc_alphanum_l(list, name);
+    case EPC_GRAMMAR_OP_SPACE:
+        return epc_space_l(list, name);
+    case EPC_GRAMMAR_OP_ANY_CHAR:
+        return epc_any_char_l(list, name);
+    case EPC_GRAMMAR_OP_SUCCEED:
+        return epc_succeed_l(list, name);
+    case EPC_GRAMMAR_OP_CUT:
+        return epc_cut_l(list, name);
+    case EPC_GRAMMAR_OP_HEX_DIGIT:
+        return epc_hex_digit_l(list, name);
+    case EPC_GRAMMAR_OP_INT:
+        return epc_int_l(list, name);
+    case EPC_GRAMMAR_OP_DOUBLE:
+        return epc_double_l(list, name);
+
+    case EPC_GRAMMAR_OP_AND:
+    case EPC_GRAMMAR_OP_OR:
+    case EPC_GRAMMAR_OP_OR_FIRST:
+        return loader_list(loader, record, name);
+
+    case EPC_GRAMMAR_OP_KEYWORDS:
+        return loader_keywords(loader, record, name);
+
+    case EPC_GRAMMAR_OP_MANY:
+    case EPC_GRAMMAR_OP_PLUS:
+    case EPC_GRAMMAR_OP_OPTIONAL:
+    case EPC_GRAMMAR_OP_NOT:
+    case EPC_GRAMMAR_OP_LOOKAHEAD:
+    case EPC_GRAMMAR_OP_SKIP:
+    case EPC_GRAMMAR_OP_PASSTHRU:
+    case EPC_GRAMMAR_OP_LEXEME:
+    {
+        epc_parser_t * child = loader_parser_operand(loader, record, 0);
+        if (child == NULL)
+        {
+            return NULL;
+        }
+        switch (record->op)
+        {
+        case EPC_GRAMMAR_OP_MANY:
+            return epc_many_l(list, name, child);
+        case EPC_GRAMMAR_OP_PLUS:
+            return epc_plus_l(list, name, child);
+        case EPC_GRAMMAR_OP_OPTIONAL:
+            return epc_optional_l(list, name, child);
+        case EPC_GRAMMAR_OP_NOT:
+            return epc_not_l(list, name, child);
+        case EPC_GRAMMAR_OP_LOOKAHEAD:
+            return epc_lookahead_l(list, name, child);
+        case EPC_GRAMMAR_OP_SKIP:
+            return epc_skip_l(list, name, child);
+        case EPC_GRAMMAR_OP_PASSTHRU:
+            return epc_passthru_l(list, name, child);
+        default:
+            return epc_lexeme_l(list, name, child);
+        }
+    }
+
+    case EPC_GRAMMAR_OP_BETWEEN:
+    {
+        epc_parser_t * open = loader_parser_operand(loader, record, 0);
+        epc_parser_t * content = loader_parser_operand(loader, record, 1);
+        epc_parser_t * close = loader_parser_operand(loader, record, 2);
+        return open != NULL && content != NULL && close != NULL ? epc_between_l(list, name, open, content, close) : NULL;
+    }
+
+    case EPC_GRAMMAR_OP_DELIMITED:
+    case EPC_GRAMMAR_OP_CHAINL1:
+    case EPC_GRAMMAR_OP_CHAINR1:
+    {
+        epc_parser_t * item = loader_parser_operand(loader, record, 0);
+        epc_parser_t * other = loader_parser_operand(loader, record, 1);
+        if (item == NULL || other == NULL)
+        {
+            return NULL;
+        }
+        if (record->op == EPC_GRAMMAR_OP_DELIMITED)
+        {
+            return epc_delimited_l(list, name, item, other);
+        }
+        return record->op == EPC_GRAMMAR_OP_CHAINL1 ? epc_chainl1_l(list, name, item, other) : epc_chainr1_l(list, name, item, other);
+    }
+
+    case EPC_GRAMMAR_OP_DFA:
+        return loader_dfa(loader, record, name);
+
+    case EPC_GRAMMAR_OP_REPEAT:
+    {
+        epc_parser_t * child = loader_parser_operand(loader, record, 0);
+        uint32_t count;
+        if (child == NULL || !loader_operand(loader, record, 1, &count) || count > INT_MAX)
+        {
+            return NULL;
+        }
+        return epc_count_l(list, name, (int)count, child);
+    }
+
+    case EPC_GRAMMAR_OP_COUNT:
+        break;
+    }
+
+    return NULL;
+}
+
+static bool
+grammar_load_parsers(epc_grammar_t * grammar, blob_t const * blob, uint32_t count, uint32_t offset, uint32_t start)
+{
+    if (count == 0 || count > blob->size / 16 || start >= count)
+    {
+        return false;
+    }
+
+    /* Check the records hang together, and count the token parsers, before building anything. */
+    size_t next = offset;
+    int dfa_count = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        blob_record_t record;
+        if (!blob_record(blob, &next, &record))
+        {
+            return false;
+        }
+        if (record.op == EPC_GRAMMAR_OP_DFA)
+        {
+            dfa_count++;
+        }
+    }
+    if (dfa_count > 0)
+    {
+        grammar->dfas = calloc(dfa_count, sizeof(*grammar->dfas));
+        if (grammar->dfas == NULL)
+        {
+            return false;
+        }
+    }
+
+    loader_t loader = {
+        .grammar = grammar,
+        .blob = blob,
+        .slots = calloc(count, sizeof(*loader.slots)),
+        .ops = calloc(count, sizeof(*loader.ops)),
+    };
+    bool success = loader.slots != NULL && loader.ops != NULL;
+
+    next = offset;
+    for (loader.index = 0; success && loader.index < count; loader.index++)
+    {
+        blob_record_t record;
+        blob_record(blob, &next, &record);
+        epc_parser_t * p = loader_parser(&loader, &record);
+        if (p == NULL || (record.action != EPC_GRAMMAR_BLOB_NONE && record.action >= (uint32_t)grammar->action_count))
+        {
+            success = false;
+            break;
+        }
+        if (record.action != EPC_GRAMMAR_BLOB_NONE)
+        {
+            epc_parser_set_ast_action(p, (int)record.action);
+        }
+        loader.slots[loader.index] = p;
+        loader.ops[loader.index] = record.op;
+    }
+    /* A forward reference that is never defined would have no parse function. */
+    for (uint32_t i = 0; success && i < count; i++)
+    {
+        success = loader.ops[i] != EPC_GRAMMAR_OP_FORWARD;
+    }
+    if (success)
+    {
+        grammar->start = loader.slots[start];
+    }
+
+    free(loader.slots);
+    free(loader.ops);
+    return success;
+}
+
+epc_grammar_t *
+epc_grammar_load_blob(void const * blob_data, size_t size)
+{
+    blob_t blob = { .bytes = blob_data, .size = size };
+    uint32_t header[EPC_GRAMMAR_BLOB_HEADER_WORDS];
+
+    if (blob_data == NULL)
+    {
+        return NULL;
+    }
+    for (int i = 0; i < EPC_GRAMMAR_BLOB_HEADER_WORDS; i++)
+    {
+        if (!blob_word(&blob, (size_t)i * 4, &header[i]))
+        {
+            return NULL;
+        }
+    }
+    if (header[EPC_GRAMMAR_BLOB_HEADER_MAGIC] != EPC_GRAMMAR_BLOB_MAGIC
+        || header[EPC_GRAMMAR_BLOB_HEADER_VERSION] != EPC_GRAMMAR_BLOB_VERSION
+        || header[EPC_GRAMMAR_BLOB_HEADER_SIZE] > size)
+    {
+        return NULL;
+    }
+    /* Anything after the blob, such as padding from the file system, isn't part of it. */
+    blob.size = header[EPC_GRAMMAR_BLOB_HEADER_SIZE];
+
+    uint32_t strings = header[EPC_GRAMMAR_BLOB_HEADER_STRINGS];
+    uint32_t strings_size = header[EPC_GRAMMAR_BLOB_HEADER_STRINGS_SIZE];
+    if (strings > blob.size || strings_size > blob.size - strings)
+    {
+        return NULL;
+    }
+    blob.strings = (char const *)blob.bytes + strings;
+    blob.strings_size = strings_size;
+
+    epc_grammar_t * grammar = calloc(1, sizeof(*grammar));
+    if (grammar == NULL)
+    {
+        return NULL;
+    }
+    grammar->parsers = epc_parser_list_create();
+    if (grammar->parsers == NULL
+        || !grammar_load_actions(grammar, &blob, header[EPC_GRAMMAR_BLOB_HEADER_ACTION_COUNT], header[EPC_GRAMMAR_BLOB_HEADER_ACTIONS])
+        || (header[EPC_GRAMMAR_BLOB_HEADER_DFA] != EPC_GRAMMAR_BLOB_NONE
+            && !grammar_load_dfa(grammar, &blob, header[EPC_GRAMMAR_BLOB_HEADER_DFA]))
+        || !grammar_load_parsers(
+            grammar,
+            &blob,
+            header[EPC_GRAMMAR_BLOB_HEADER_PARSER_COUNT],
+            header[EPC_GRAMMAR_BLOB_HEADER_PARSERS],
+            header[EPC_GRAMMAR_BLOB_HEADER_START]))
+    {
+        epc_grammar_free(grammar);
+        return NULL;
+    }
+
+    return grammar;
+}
+
+epc_parser_t *
+epc_grammar_parser(epc_grammar_t const * grammar)
+{
+    return grammar != NULL ? grammar->start : NULL;
+}
+
+int
+epc_grammar_action_count(epc_grammar_t const * grammar)
+{
+    return grammar != NULL ? grammar->action_count : 0;
+}
+
+char const *
+epc_grammar_action_name(epc_grammar_t const * grammar, int action)
+{
+    if (grammar == NULL || action < 0 || action >= grammar->action_count)
+    {
+        return NULL;
+    }
+    return grammar->action_names[action];
+}
+
+epc_ast_hook_registry_t *
+epc_grammar_ast_hook_registry_create(
+    epc_grammar_t const * grammar, epc_grammar_action_binding_t const * bindings, int binding_count)
+{
+    if (grammar == NULL || (bindings == NULL && binding_count > 0))
+    {
+        return NULL;
+    }
+    epc_ast_hook_registry_t * registry = epc_ast_hook_registry_create(grammar->action_count);
+    if (registry == NULL)
+    {
+        return NULL;
+    }
+    for (int i = 0; i < binding_count; i++)
+    {
+        for (int action = 0; action < grammar->action_count; action++)
+        {
+            if (bindings[i].name != NULL && strcmp(bindings[i].name, grammar->action_names[action]) == 0)
+            {
+                epc_ast_hook_registry_set_action(registry, action, bindings[i].action);
+                break;
+            }
+        }
+    }
+    return registry;
+}
+
+void
+epc_grammar_free(epc_grammar_t * grammar)
+{
+    if (grammar == NULL)
+    {
+        return;
+    }
+    epc_parser_list_free(grammar->parsers);
+    for (int i = 0; i < grammar->action_count; i++)
+    {
+        free(grammar->action_names[i]);
+    }
+    free(grammar->action_names);
+    free(grammar->dfa_transitions);
+    free(grammar->dfa_accepting);
+    free(grammar->dfas);
+    free(grammar);
+}
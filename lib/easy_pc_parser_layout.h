@@ -0,0 +1,216 @@
+#pragma once
+
+#include <easy_pc/easy_pc.h>
+#include <easy_pc/easy_pc_direct.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * The layout of `epc_parser_t`, for code that defines parsers as statically
+ * initialized data rather than building them at run time, such as the code
+ * emitted by `gdl_compiler --backend=static`. Each parser is initialized with
+ * the parse function and data that the matching `epc_xxx()` constructor would
+ * have given it, so it behaves exactly like the parser the constructor
+ * returns.
+ *
+ * Parsers defined this way don't belong to the library. They must not be
+ * passed to `epc_parser_free()`, `epc_parser_duplicate()` or
+ * `epc_parser_set_ast_action()`, nor added to an `epc_parser_list`. The
+ * library never writes to a parser while parsing, so they may be `const`.
+ *
+ * This header is internal to the library and isn't installed. Code generated
+ * with `--backend=static` includes it, so it must be built against the
+ * easy_pc sources it was generated for, as the layout may change with them.
+ */
+
+// Structure to hold a list of parsers (e.g., for combinators like p_or)
+typedef struct epc_parser_list_data_t
+{
+    epc_parser_t ** parsers;
+    int count;
+    epc_first_set_t const * first; // For epc_or_first(), one set per parser. Otherwise NULL.
+} epc_parser_list_data_t;
+
+typedef struct
+{
+    char start;
+    char end;
+} epc_char_range_data_t;
+
+typedef struct
+{
+    int count;
+    epc_parser_t * parser;
+} epc_count_data_t;
+
+typedef struct
+{
+    epc_parser_t * open;
+    epc_parser_t * parser;
+    epc_parser_t * close;
+} epc_between_data_t;
+
+typedef struct
+{
+    epc_parser_t * item;
+    epc_parser_t * delimiter;
+} epc_delimited_data_t;
+
+typedef struct
+{
+    epc_parser_t * parser;
+    bool consume_comments;
+} epc_lexeme_data_t;
+
+/*
+ * Trie used by epc_keywords(). Nodes are stored in a flat array, with node 0
+ * being the root. Each node's children form a singly-linked sibling list,
+ * sorted by character so a lookup can stop early.
+ */
+typedef struct
+{
+    int first_child;    /* Index of the first child node, or -1. */
+    int next_sibling;   /* Index of the next sibling node, or -1. */
+    int keyword_index;  /* Index of the keyword ending at this node, or -1. */
+    unsigned char c;
+} epc_keyword_trie_node_t;
+
+typedef struct
+{
+    char * * keywords;
+    int count;
+    epc_keyword_trie_node_t * nodes;
+    int node_count;
+    int node_capacity;
+    char * expected;    /* The keywords joined with " or ", for error reporting. */
+} epc_keywords_data_t;
+
+// Defined by the library. Operator tables are only built at run time, by epc_operator_table().
+typedef struct epc_operator_table_data_t epc_operator_table_data_t;
+
+typedef struct
+{
+    epc_direct_parse_fn parse_fn;
+    void * user_data;
+    void (*free_user_data)(void * user_data); /* NULL if the parser doesn't own user_data. */
+} epc_direct_data_t;
+
+// Static parsers store these values, so new types are only ever added at the end.
+typedef enum epc_parser_data_type_t
+{
+    EPC_PARSER_DATA_TYPE_OTHER,
+    EPC_PARSER_DATA_TYPE_STRING,
+    EPC_PARSER_DATA_TYPE_PARSER_LIST,
+    EPC_PARSER_DATA_TYPE_CHAR_RANGE,
+    EPC_PARSER_DATA_TYPE_COUNT,
+    EPC_PARSER_DATA_TYPE_BETWEEN,
+    EPC_PARSER_DATA_TYPE_DELIMITED,
+    EPC_PARSER_DATA_TYPE_LEXEME,
+    EPC_PARSER_DATA_TYPE_KEYWORDS,
+    EPC_PARSER_DATA_TYPE_OPERATOR_TABLE,
+    EPC_PARSER_DATA_TYPE_DIRECT,
+    EPC_PARSER_DATA_TYPE_DFA,
+} epc_parser_data_type_t;
+
+typedef struct epc_parser_data_t
+{
+    epc_parser_data_type_t data_type;
+    union
+    {
+        void * other;
+        char const * string;
+        epc_parser_list_data_t * parser_list;
+        epc_char_range_data_t range;
+        epc_count_data_t count;
+        epc_between_data_t between;
+        epc_delimited_data_t delimited;
+        epc_lexeme_data_t lexeme;
+        epc_keywords_data_t * keywords;
+        epc_dfa_t const * dfa; /* Not owned by the parser. */
+        epc_operator_table_data_t * operator_table;
+        epc_direct_data_t direct;
+    };
+} epc_parser_data_t;
+
+struct epc_parser_t
+{
+    epc_parse_result_t (*parse_fn)(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+    /*
+     * For rules completed with epc_parser_duplicate(), parse_fn is
+     * epc_rule_parse_fn or epc_left_recursive_rule_parse_fn, and this is the
+     * parse function of the rule's definition.
+     */
+    epc_parse_result_t (*rule_parse_fn)(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+
+    // Parser-specific data
+    epc_parser_data_t data;
+
+    const char * name;   /* Must be freed when parser is destroyed. */
+    const char * expected_value;
+
+    epc_ast_semantic_action_t ast_config;
+
+    uint64_t id;        /* Set when created at run time; 0 for statically initialized parsers. */
+};
+
+/*
+ * The parse functions that `gdl_compiler --backend=static` references, and no
+ * others. `epc_xxx_parse_fn` is the parse function of the parser returned by
+ * `epc_xxx()`, and expects the same data in `epc_parser_t.data`.
+ */
+EASY_PC_API epc_parse_result_t epc_char_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_string_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_eoi_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_digit_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_int_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_space_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_alpha_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_alphanum_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_double_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_or_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_keywords_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_dfa_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_and_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_skip_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_plus_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_passthru_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_char_range_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_any_char_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_none_of_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_many_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_count_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_between_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_delimited_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_optional_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_lookahead_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_not_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_fail_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_succeed_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_cut_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_hex_digit_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_one_of_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_lexeme_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_chainl1_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+EASY_PC_API epc_parse_result_t epc_chainr1_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+
+/*
+ * The parse function of a rule completed with `epc_parser_duplicate()`.
+ * It keeps cuts within the rule, then calls `epc_parser_t.rule_parse_fn`,
+ * which must be set to the parse function of the rule's definition.
+ */
+EASY_PC_API epc_parse_result_t epc_rule_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+
+/*
+ * The parse function of such a rule that may call itself without consuming
+ * input, directly or through other rules. It also handles left recursion.
+ */
+EASY_PC_API epc_parse_result_t epc_left_recursive_rule_parse_fn(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,8 +2,11 @@
 
 #include <easy_pc/easy_pc.h>
 #include <easy_pc/easy_pc_ast.h> // Include the new AST header
+#include <easy_pc/easy_pc_direct.h>
+#include "easy_pc_parser_layout.h"
 
 #include <stdarg.h>
+#include <stdint.h>
 
 // Internal types for AST builder stack management
 typedef enum
@@ -29,12 +32,67 @@ struct epc_ast_builder_ctx_t
     char error_message[512];
 };
 
+/*
+ * Tracks a forward-referenced rule that is being evaluated at a given input
+ * position, so a left-recursive call back into the same rule at the same
+ * position can be detected and answered from the current seed.
+ * Entries live on the C stack of the rule's parse function.
+ */
+typedef struct left_recursion_entry_t
+{
+    epc_parser_t * rule;
+    const char * input;
+    epc_parse_result_t seed;    /* The longest result found so far. Starts out as a failure. */
+    bool left_recursion_detected;
+    struct left_recursion_entry_t * next;
+} left_recursion_entry_t;
+
+/*
+ * The alternative currently being tried by the innermost epc_or.
+ * A successful epc_cut marks it as committed, so the epc_or won't try the
+ * remaining alternatives, and hands the saved furthest error back to the
+ * context straight away instead of holding it until the epc_or finishes.
+ */
+typedef struct alternative_scope_t
+{
+    bool committed;
+    epc_parser_error_t * saved_furthest_error;
+} alternative_scope_t;
+
 // The Parsing Context (for a single parse operation and its results)
 // This will be internally managed by epc_parse_input
 struct epc_parser_ctx_t
 {
     const char * input_start;
+    /* Where calculate_line_and_column() stopped counting, and what it had counted. */
+    const char * line_scan_position;
+    size_t line_scan_line;
+    const char * line_scan_line_start;
     epc_parser_error_t * furthest_error;
+    left_recursion_entry_t * left_recursion_stack; /* Innermost rule first. */
+    alternative_scope_t * alternative_scope; /* NULL outside of any epc_or. */
+    epc_alternative_profile_t * alternative_profile; /* NULL unless profiling. */
+    epc_trace_t * trace; /* NULL unless tracing. */
+    epc_backtrack_map_t * backtrack_map; /* NULL unless mapping backtracking. */
+    epc_parse_stats_t stats;
+    size_t live_allocations; /* Of those counted in stats. */
+    size_t depth; /* Of parser calls. */
+    bool has_checks; /* Of limits or progress, on each parser call. */
+    epc_parse_limits_t limits;
+    uint64_t deadline_ns; /* On CLOCK_MONOTONIC, if limits.max_milliseconds is set. */
+    epc_parse_error_kind_t limit_reached; /* EPC_PARSE_ERROR_SYNTAX until a limit is reached. */
+    const char * limit_position; /* Where the limit was reached. */
+    epc_progress_t progress;
+    epc_progress_info_t progress_info; /* As last reported. */
+    size_t next_progress_offset;
+    size_t next_progress_calls;
+};
+
+struct epc_operator_table_data_t
+{
+    epc_parser_t * operand;
+    epc_operator_t * operators;
+    int count;
 };
 
 // Structure for user-managed parser list
@@ -45,85 +103,6 @@ struct epc_parser_list
     size_t capacity;
 };
 
-// Structure to hold a list of parsers (e.g., for combinators like p_or)
-typedef struct parser_list_t
-{
-    epc_parser_t ** parsers;
-    int count;
-} parser_list_t;
-
-typedef struct
-{
-    char start;
-    char end;
-} char_range_data_t;
-
-typedef struct
-{
-    int count;
-    epc_parser_t * parser;
-} count_data_t;
-
-typedef struct
-{
-    epc_parser_t * open;
-    epc_parser_t * parser;
-    epc_parser_t * close;
-} between_data_t;
-
-typedef struct
-{
-    epc_parser_t * item;
-    epc_parser_t * delimiter;
-} delimited_data_t;
-
-typedef struct
-{
-    epc_parser_t * parser;
-    bool consume_comments;
-} lexeme_data_t;
-
-typedef enum parser_data_type_t
-{
-    PARSER_DATA_TYPE_OTHER,
-    PARSER_DATA_TYPE_STRING,
-    PARSER_DATA_TYPE_PARSER_LIST,
-    PARSER_DATA_TYPE_CHAR_RANGE,
-    PARSER_DATA_TYPE_COUNT,
-    PARSER_DATA_TYPE_BETWEEN,
-    PARSER_DATA_TYPE_DELIMITED,
-    PARSER_DATA_TYPE_LEXEME,
-} parser_data_type_t;
-
-typedef struct parser_data_type_st
-{
-    parser_data_type_t data_type;
-    union
-    {
-        void * other;
-        char const * string;
-        parser_list_t * parser_list;
-        char_range_data_t range;
-        count_data_t count;
-        between_data_t between;
-        delimited_data_t delimited;
-        lexeme_data_t lexeme;
-    };
-} parser_data_type_st;
-
-struct epc_parser_t
-{
-    epc_parse_result_t (*parse_fn)(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
-
-    // Parser-specific data
-    parser_data_type_st data;
-
-    const char * name;   /* Must be freed when parser is destroyed. */
-    const char * expected_value;
-
-    epc_ast_semantic_action_t ast_config;
-};
-
 struct epc_ast_hook_registry_t
 {
     epc_ast_action_cb * callbacks;     /**< @brief Array of semantic action callbacks, indexed by action value. */
@@ -144,6 +123,16 @@ epc_unparsed_error_result(
 void
 epc_parser_result_cleanup(epc_parse_result_t * result);
 
+/* Allocates a zeroed node, along with the library's private bookkeeping for it. */
+EASY_PC_HIDDEN
+epc_cpt_node_t *
+epc_node_calloc(void);
+
+/* Adds an owner to the node, so it is only freed once every owner has freed it. */
+EASY_PC_HIDDEN
+void
+epc_node_share(epc_cpt_node_t * node);
+
 ATTR_NONNULL(1, 2)
 EASY_PC_HIDDEN
 epc_cpt_node_t *
@@ -157,6 +146,16 @@ EASY_PC_HIDDEN
 void
 epc_parser_error_free(epc_parser_error_t * error);
 
+EASY_PC_HIDDEN
+epc_parser_error_t *
+epc_parser_error_alloc(
+    epc_parser_ctx_t * ctx,
+    const char * input_position,
+    const char * message,
+    const char * expected,
+    const char * found
+);
+
 EASY_PC_HIDDEN
 epc_parser_error_t *
 parser_furthest_error_copy(epc_parser_ctx_t * ctx);
@@ -164,3 +163,120 @@ parser_furthest_error_copy(epc_parser_ctx_t * ctx);
 void
 epc_parser_free(epc_parser_t * parser);
 
+/*
+ * Count allocations against the parse running on this thread, if any. Nodes
+ * are allocated without a parse context to hand, so the one running is kept
+ * per thread. new_block is false for a reallocation; cpt is true for a node
+ * or child array.
+ */
+EASY_PC_HIDDEN
+void
+epc_stats_allocated(size_t bytes, bool new_block, bool cpt);
+
+/* Counts a CPT node allocated for the running parse, and its allocation. */
+EASY_PC_HIDDEN
+void
+epc_stats_node_allocated(void);
+
+/* Counts an error object created for the running parse, and its allocations. */
+EASY_PC_HIDDEN
+void
+epc_stats_error_allocated(void);
+
+/* Counts an error object copied for the running parse. */
+EASY_PC_HIDDEN
+void
+epc_stats_error_copied(void);
+
+EASY_PC_HIDDEN
+void
+epc_stats_freed(size_t blocks);
+
+/*
+ * Checks the limits of a parse calling a parser at the given input, and
+ * reports its progress. Returns true if a limit has been reached or the parse
+ * has been cancelled, after which every parser call fails at once.
+ */
+EASY_PC_HIDDEN
+bool
+epc_parse_limit_reached(epc_parser_ctx_t * ctx, const char * input);
+
+/* Allocates a zeroed child array for a CPT node. */
+EASY_PC_HIDDEN
+epc_cpt_node_t **
+epc_children_alloc(size_t count);
+
+/* Runs a parser, as parsers run their children. */
+EASY_PC_HIDDEN
+epc_parse_result_t
+epc_parser_parse(epc_parser_t * parser, epc_parser_ctx_t * ctx, const char * input);
+
+#if WITH_PARSER_PROFILING
+/* What epc_profile_exit() needs to know about a parser call. */
+typedef struct
+{
+    uint64_t start;
+    uint64_t outer_child_ticks;
+} epc_profile_frame_t;
+
+/* Called around each parser call to count it in the calling thread's counters. */
+EASY_PC_HIDDEN
+void
+epc_profile_enter(epc_profile_frame_t * frame);
+
+EASY_PC_HIDDEN
+void
+epc_profile_exit(epc_parser_t const * parser, epc_profile_frame_t const * frame, epc_parse_result_t const * result);
+#endif
+
+/* Records entering a parser, if it is to be traced. Returns true if so. */
+EASY_PC_HIDDEN
+bool
+epc_trace_enter(epc_trace_t * trace, epc_parser_t const * parser, epc_parser_ctx_t const * ctx, const char * input);
+
+/* Records leaving a parser that epc_trace_enter() traced. */
+EASY_PC_HIDDEN
+void
+epc_trace_exit(epc_trace_t * trace, epc_parser_t const * parser, epc_parser_ctx_t const * ctx, const char * input,
+               epc_parse_result_t const * result);
+
+/* Clears a backtrack map for a parse of the given input. Returns false on error. */
+EASY_PC_HIDDEN
+bool
+epc_backtrack_map_begin(epc_backtrack_map_t * map, const char * input);
+
+/* Counts a parser entered at an offset of the input. */
+EASY_PC_HIDDEN
+void
+epc_backtrack_map_record(epc_backtrack_map_t * map, epc_parser_t const * parser, size_t offset);
+
+/* How often each alternative of an epc_or has been tried and has matched. */
+typedef struct
+{
+    unsigned long long * tried;
+    unsigned long long * matched;
+} epc_alternative_counts_t;
+
+/*
+ * Returns the counts for the alternatives of an epc_or, adding them to the
+ * profile the first time, or NULL on error.
+ */
+EASY_PC_HIDDEN
+epc_alternative_counts_t *
+epc_alternative_profile_counts(epc_alternative_profile_t * profile, epc_parser_t const * or_parser, int count);
+
+/*
+ * Like epc_and(), epc_or() and epc_or_first(), but given an array of parsers,
+ * for callers that only know how many there are at run time.
+ */
+EASY_PC_HIDDEN
+epc_parser_t *
+epc_and_a(char const * name, int count, epc_parser_t * const * parsers);
+
+EASY_PC_HIDDEN
+epc_parser_t *
+epc_or_a(char const * name, int count, epc_parser_t * const * parsers);
+
+EASY_PC_HIDDEN
+epc_parser_t *
+epc_or_first_a(char const * name, epc_first_set_t const * first, int count, epc_parser_t * const * parsers);
@@ -0,0 +1,573 @@
+#include "easy_pc_private.h"
+#include "parser_map.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The counts of one epc_or parser. */
+typedef struct
+{
+    char * name;
+    int count;
+    epc_alternative_counts_t counts;
+} alternative_profile_entry_t;
+
+struct epc_alternative_profile_t
+{
+    alternative_profile_entry_t ** entries; /* Allocated one by one, so the counts handed out stay put. */
+    size_t used;
+    size_t capacity;
+    parser_map_t parsers;           /* The index of each epc_or's entry. */
+};
+
+static void
+alternative_profile_entry_free(alternative_profile_entry_t * entry)
+{
+    if (entry == NULL)
+    {
+        return;
+    }
+    free(entry->name);
+    free(entry->counts.tried);
+    free(entry->counts.matched);
+    free(entry);
+}
+
+EASY_PC_API epc_alternative_profile_t *
+epc_alternative_profile_create(void)
+{
+    return calloc(1, sizeof(epc_alternative_profile_t));
+}
+
+EASY_PC_HIDDEN
+epc_alternative_counts_t *
+epc_alternative_profile_counts(epc_alternative_profile_t * profile, epc_parser_t const * or_parser, int count)
+{
+    size_t index;
+    if (parser_map_find(&profile->parsers, or_parser, &index))
+    {
+        return &profile->entries[index]->counts;
+    }
+
+    if (profile->used == profile->capacity)
+    {
+        size_t capacity = profile->capacity == 0 ? 64 : profile->capacity * 2;
+        alternative_profile_entry_t ** entries = realloc(profile->entries, capacity * sizeof(*entries));
+        if (entries == NULL)
+        {
+            return NULL;
+        }
+        profile->entries = entries;
+        profile->capacity = capacity;
+    }
+
+    alternative_profile_entry_t * entry = calloc(1, sizeof(*entry));
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+    *entry = (alternative_profile_entry_t){
+        .name = strdup(or_parser->name != NULL ? or_parser->name : ""),
+        .count = count,
+        .counts.tried = calloc(count, sizeof(*entry->counts.tried)),
+        .counts.matched = calloc(count, sizeof(*entry->counts.matched)),
+    };
+    if (entry->name == NULL || entry->counts.tried == NULL || entry->counts.matched == NULL
+        || !parser_map_add(&profile->parsers, or_parser, profile->used))
+    {
+        alternative_profile_entry_free(entry);
+        return NULL;
+    }
+    profile->entries[profile->used++] = entry;
+
+    return &entry->counts;
+}
+
+static int
+compare_entries(void const * a, void const * b)
+{
+    alternative_profile_entry_t const * entry_a = *(alternative_profile_entry_t const * const *)a;
+    alternative_profile_entry_t const * entry_b = *(alternative_profile_entry_t const * const *)b;
+    int cmp = strcmp(entry_a->name, entry_b->name);
+
+    return cmp != 0 ? cmp : entry_a->count - entry_b->count;
+}
+
+EASY_PC_API bool
+epc_alternative_profile_write(epc_alternative_profile_t const * profile, FILE * out)
+{
+    if (profile == NULL || out == NULL)
+    {
+        return false;
+    }
+
+    alternative_profile_entry_t const * * sorted = malloc((profile->used + 1) * sizeof(*sorted));
+    if (sorted == NULL)
+    {
+        return false;
+    }
+    size_t n = profile->used;
+    for (size_t i = 0; i < n; i++)
+    {
+        sorted[i] = profile->entries[i];
+    }
+    qsort(sorted, n, sizeof(*sorted), compare_entries);
+
+    bool success = true;
+    for (size_t first = 0; first < n && success; )
+    {
+        // Entries with the same name and number of alternatives are written as one.
+        size_t last = first + 1;
+        while (last < n && compare_entries(&sorted[first], &sorted[last]) == 0)
+        {
+            last++;
+        }
+
+        alternative_profile_entry_t const * entry = sorted[first];
+        success = fprintf(out, "%s %d", entry->name[0] != '\0' ? entry->name : "-", entry->count) >= 0;
+        for (int alternative = 0; alternative < entry->count && success; alternative++)
+        {
+            unsigned long long tried = 0;
+            unsigned long long matched = 0;
+            for (size_t i = first; i < last; i++)
+            {
+                tried += sorted[i]->counts.tried[alternative];
+                matched += sorted[i]->counts.matched[alternative];
+            }
+            success = fprintf(out, " %llu %llu", tried, matched) >= 0;
+        }
+        success = success && fputc('\n', out) != EOF;
+        first = last;
+    }
+    free(sorted);
+
+    return success;
+}
+
+EASY_PC_API void
+epc_alternative_profile_free(epc_alternative_profile_t * profile)
+{
+    if (profile == NULL)
+    {
+        return;
+    }
+    for (size_t i = 0; i < profile->used; i++)
+    {
+        alternative_profile_entry_free(profile->entries[i]);
+    }
+    free(profile->entries);
+    parser_map_release(&profile->parsers);
+    free(profile);
+}
+
+/* --- Per-parser counters (WITH_PARSER_PROFILING) --- */
+
+#if WITH_PARSER_PROFILING
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#if defined __x86_64__ || defined __i386__
+#include <x86intrin.h>
+#define PROFILE_TIME_UNIT "ticks"
+#else
+#define PROFILE_TIME_UNIT "ns"
+#endif
+
+/*
+ * The counters of one parser, as seen by one thread. Only that thread
+ * writes them, so it adds with a plain load and store, but they are atomic
+ * so epc_profile_report() can read them while it parses.
+ */
+typedef struct
+{
+    char * name;
+    _Atomic unsigned long long calls;
+    _Atomic unsigned long long successes;
+    _Atomic unsigned long long failures;
+    _Atomic unsigned long long bytes;
+    _Atomic unsigned long long inclusive;
+    _Atomic unsigned long long exclusive;
+} parser_counters_t;
+
+/* A line of the report: the counters of the parsers sharing a name. */
+typedef struct
+{
+    char * name;
+    unsigned long long calls;
+    unsigned long long successes;
+    unsigned long long failures;
+    unsigned long long bytes;
+    unsigned long long inclusive;
+    unsigned long long exclusive;
+} profile_row_t;
+
+/*
+ * Each thread counts in a table of its own, so counting takes no locks.
+ * The tables are listed in all_tables. The list, and the entries of every
+ * table, only change with tables_lock held.
+ */
+typedef struct parser_counters_table_t
+{
+    parser_counters_t * entries;
+    size_t used;
+    size_t capacity;
+    parser_map_t parsers;           /* The index of each parser's counters in entries. */
+    struct parser_counters_table_t * next;
+} parser_counters_table_t;
+
+static pthread_mutex_t tables_lock = PTHREAD_MUTEX_INITIALIZER;
+static parser_counters_table_t * all_tables;
+/* The counters of the threads that have exited, by name. */
+static profile_row_t * retired_rows;
+static size_t retired_row_count;
+
+static pthread_once_t table_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t table_key;
+static bool table_key_created;
+
+static _Thread_local parser_counters_table_t * thread_table;
+/* The time spent in the parsers called by the current parser so far. */
+static _Thread_local uint64_t child_ticks;
+
+static inline uint64_t
+profile_ticks(void)
+{
+#if defined __x86_64__ || defined __i386__
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static inline void
+counter_add(_Atomic unsigned long long * counter, unsigned long long n)
+{
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + n, memory_order_relaxed);
+}
+
+static profile_row_t
+counters_row(parser_counters_t * entry)
+{
+    return (profile_row_t){
+        .name = entry->name,
+        .calls = atomic_load_explicit(&entry->calls, memory_order_relaxed),
+        .successes = atomic_load_explicit(&entry->successes, memory_order_relaxed),
+        .failures = atomic_load_explicit(&entry->failures, memory_order_relaxed),
+        .bytes = atomic_load_explicit(&entry->bytes, memory_order_relaxed),
+        .inclusive = atomic_load_explicit(&entry->inclusive, memory_order_relaxed),
+        .exclusive = atomic_load_explicit(&entry->exclusive, memory_order_relaxed),
+    };
+}
+
+static int
+compare_rows_by_name(void const * a, void const * b)
+{
+    profile_row_t const * left = a;
+    profile_row_t const * right = b;
+
+    return strcmp(left->name, right->name);
+}
+
+static int
+compare_rows_by_exclusive(void const * a, void const * b)
+{
+    profile_row_t const * left = a;
+    profile_row_t const * right = b;
+
+    if (left->exclusive != right->exclusive)
+    {
+        return left->exclusive < right->exclusive ? 1 : -1;
+    }
+    return strcmp(left->name, right->name);
+}
+
+/*
+ * Sorts rows by name and adds up the rows sharing a name, dropping those
+ * never called. Returns the number of rows left. If the rows own their
+ * names, the names of the rows dropped are freed.
+ */
+static size_t
+rows_merge(profile_row_t * rows, size_t count, bool own_names)
+{
+    qsort(rows, count, sizeof(*rows), compare_rows_by_name);
+    size_t merged = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        profile_row_t const * row = &rows[i];
+        if (row->calls != 0 && (merged == 0 || strcmp(rows[merged - 1].name, row->name) != 0))
+        {
+            rows[merged++] = *row;
+            continue;
+        }
+        if (row->calls != 0)
+        {
+            profile_row_t * into = &rows[merged - 1];
+            into->calls += row->calls;
+            into->successes += row->successes;
+            into->failures += row->failures;
+            into->bytes += row->bytes;
+            into->inclusive += row->inclusive;
+            into->exclusive += row->exclusive;
+        }
+        if (own_names)
+        {
+            free(row->name);
+        }
+    }
+    return merged;
+}
+
+static void
+counters_table_free(parser_counters_table_t * table)
+{
+    for (size_t i = 0; i < table->used; i++)
+    {
+        free(table->entries[i].name);
+    }
+    free(table->entries);
+    parser_map_release(&table->parsers);
+    free(table);
+}
+
+/* Called as a thread exits, to keep its counts in retired_rows and free its table. */
+static void
+counters_table_retire(void * data)
+{
+    parser_counters_table_t * table = data;
+
+    pthread_mutex_lock(&tables_lock);
+    parser_counters_table_t ** link = &all_tables;
+    while (*link != table)
+    {
+        link = &(*link)->next;
+    }
+    *link = table->next;
+
+    profile_row_t * rows = realloc(retired_rows, (retired_row_count + table->used + 1) * sizeof(*rows));
+    if (rows != NULL)
+    {
+        // The names move to the rows; the table's entries are then dropped without them.
+        for (size_t i = 0; i < table->used; i++)
+        {
+            rows[retired_row_count + i] = counters_row(&table->entries[i]);
+            table->entries[i].name = NULL;
+        }
+        retired_rows = rows;
+        retired_row_count = rows_merge(rows, retired_row_count + table->used, true);
+    }
+    pthread_mutex_unlock(&tables_lock);
+
+    counters_table_free(table);
+    thread_table = NULL;
+}
+
+static void
+table_key_create(void)
+{
+    table_key_created = pthread_key_create(&table_key, counters_table_retire) == 0;
+}
+
+static parser_counters_table_t *
+counters_table_get(void)
+{
+    if (thread_table == NULL)
+    {
+        pthread_once(&table_key_once, table_key_create);
+        parser_counters_table_t * table = calloc(1, sizeof(*table));
+        if (table == NULL || !table_key_created || pthread_setspecific(table_key, table) != 0)
+        {
+            free(table);
+            return NULL;
+        }
+        pthread_mutex_lock(&tables_lock);
+        table->next = all_tables;
+        all_tables = table;
+        pthread_mutex_unlock(&tables_lock);
+        thread_table = table;
+    }
+    return thread_table;
+}
+
+/* Adds a parser to the calling thread's table. */
+static parser_counters_t *
+counters_add(parser_counters_table_t * table, epc_parser_t const * parser)
+{
+    char * name = strdup(parser->name != NULL ? parser->name : "");
+    if (name == NULL)
+    {
+        return NULL;
+    }
+
+    parser_counters_t * entry = NULL;
+    pthread_mutex_lock(&tables_lock);
+    if (table->used == table->capacity)
+    {
+        size_t capacity = table->capacity == 0 ? 64 : table->capacity * 2;
+        parser_counters_t * entries = realloc(table->entries, capacity * sizeof(*entries));
+        if (entries != NULL)
+        {
+            table->entries = entries;
+            table->capacity = capacity;
+        }
+    }
+    if (table->used < table->capacity && parser_map_add(&table->parsers, parser, table->used))
+    {
+        entry = &table->entries[table->used++];
+        *entry = (parser_counters_t){ .name = name };
+    }
+    pthread_mutex_unlock(&tables_lock);
+
+    if (entry == NULL)
+    {
+        free(name);
+    }
+    return entry;
+}
+
+static parser_counters_t *
+counters_get(epc_parser_t const * parser)
+{
+    parser_counters_table_t * table = counters_table_get();
+    if (table == NULL)
+    {
+        return NULL;
+    }
+    size_t index;
+    if (parser_map_find(&table->parsers, parser, &index))
+    {
+        return &table->entries[index];
+    }
+    return counters_add(table, parser);
+}
+
+EASY_PC_HIDDEN void
+epc_profile_enter(epc_profile_frame_t * frame)
+{
+    frame->outer_child_ticks = child_ticks;
+    child_ticks = 0;
+    frame->start = profile_ticks();
+}
+
+EASY_PC_HIDDEN void
+epc_profile_exit(epc_parser_t const * parser, epc_profile_frame_t const * frame, epc_parse_result_t const * result)
+{
+    uint64_t elapsed = profile_ticks() - frame->start;
+    uint64_t children = child_ticks;
+    child_ticks = frame->outer_child_ticks + elapsed;
+
+    parser_counters_t * entry = counters_get(parser);
+    if (entry == NULL)
+    {
+        return;
+    }
+    counter_add(&entry->calls, 1);
+    if (result->is_error)
+    {
+        counter_add(&entry->failures, 1);
+    }
+    else
+    {
+        counter_add(&entry->successes, 1);
+        counter_add(&entry->bytes, result->data.success != NULL ? result->data.success->len : 0);
+    }
+    counter_add(&entry->inclusive, elapsed);
+    counter_add(&entry->exclusive, elapsed > children ? elapsed - children : 0);
+}
+
+EASY_PC_API bool
+epc_profile_report(FILE * out)
+{
+    pthread_mutex_lock(&tables_lock);
+
+    size_t count = retired_row_count;
+    for (parser_counters_table_t * table = all_tables; table != NULL; table = table->next)
+    {
+        count += table->used;
+    }
+    profile_row_t * rows = malloc((count + 1) * sizeof(*rows));
+    if (rows == NULL)
+    {
+        pthread_mutex_unlock(&tables_lock);
+        return false;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < retired_row_count; i++)
+    {
+        rows[n++] = retired_rows[i];
+    }
+    for (parser_counters_table_t * table = all_tables; table != NULL; table = table->next)
+    {
+        for (size_t i = 0; i < table->used; i++)
+        {
+            rows[n++] = counters_row(&table->entries[i]);
+        }
+    }
+
+    /* Merge the counters of parsers sharing a name, across all threads. */
+    size_t row_count = rows_merge(rows, n, false);
+    qsort(rows, row_count, sizeof(*rows), compare_rows_by_exclusive);
+
+    bool success = fprintf(out, "%-32s %12s %12s %12s %12s %18s %18s\n", "parser", "calls", "successes", "failures",
+                           "bytes", "inclusive (" PROFILE_TIME_UNIT ")", "exclusive (" PROFILE_TIME_UNIT ")") >= 0;
+    for (size_t i = 0; i < row_count && success; i++)
+    {
+        profile_row_t const * row = &rows[i];
+        success = fprintf(out, "%-32s %12llu %12llu %12llu %12llu %18llu %18llu\n",
+                          row->name[0] != '\0' ? row->name : "-", row->calls, row->successes, row->failures,
+                          row->bytes, row->inclusive, row->exclusive) >= 0;
+    }
+    /* The names belong to the tables, so they are only freed with the lock held. */
+    pthread_mutex_unlock(&tables_lock);
+    free(rows);
+
+    return success;
+}
+
+EASY_PC_API void
+epc_profile_reset(void)
+{
+    pthread_mutex_lock(&tables_lock);
+    for (size_t i = 0; i < retired_row_count; i++)
+    {
+        free(retired_rows[i].name);
+    }
+    free(retired_rows);
+    retired_rows = NULL;
+    retired_row_count = 0;
+
+    /* The tables of running threads are still in use, so only their counters are cleared. */
+    for (parser_counters_table_t * table = all_tables; table != NULL; table = table->next)
+    {
+        for (size_t i = 0; i < table->used; i++)
+        {
+            parser_counters_t * entry = &table->entries[i];
+            atomic_store_explicit(&entry->calls, 0, memory_order_relaxed);
+            atomic_store_explicit(&entry->successes, 0, memory_order_relaxed);
+            atomic_store_explicit(&entry->failures, 0, memory_order_relaxed);
+            atomic_store_explicit(&entry->bytes, 0, memory_order_relaxed);
+            atomic_store_explicit(&entry->inclusive, 0, memory_order_relaxed);
+            atomic_store_explicit(&entry->exclusive, 0, memory_order_relaxed);
+        }
+    }
+    pthread_mutex_unlock(&tables_lock);
+}
+
+#else
+
+EASY_PC_API bool
+epc_profile_report(FILE * out)
+{
+    (void)out;
+    return false;
+}
+
+EASY_PC_API void
+epc_profile_reset(void)
+{
+}
+
+#endif
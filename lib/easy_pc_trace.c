@@ -0,0 +1,346 @@
+#include "easy_pc_private.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_BUFFER_EVENTS 65536
+
+typedef enum
+{
+    TRACE_EVENT_ENTER,
+    TRACE_EVENT_SUCCESS,
+    TRACE_EVENT_FAIL,
+    TRACE_EVENT_UNFINISHED,     /* Only written, for calls still running at the end of the trace. */
+} trace_event_kind_t;
+
+typedef struct
+{
+    uint64_t time_ns;
+    char const * name;
+    size_t offset;
+    size_t len;         /* Only set for TRACE_EVENT_SUCCESS. */
+    trace_event_kind_t kind;
+} trace_event_t;
+
+/* The events of one thread. Only that thread writes to it. */
+typedef struct trace_buffer_t
+{
+    void const * owner;             /* Identifies the thread. */
+    int thread_index;
+    trace_event_t * events;         /* A ring of trace->buffer_events events. */
+    uint64_t written;               /* The number of events ever written. */
+    unsigned calls_to_skip;         /* Before the next sampled call. */
+    struct trace_buffer_t * next;
+} trace_buffer_t;
+
+struct epc_trace_t
+{
+    uint64_t id;                    /* Unique, so a thread's cached buffer can't outlive its trace. */
+    uint64_t start_ns;
+    size_t buffer_events;
+    unsigned sample_every;
+    char ** rules;
+    size_t rule_count;
+    _Atomic(trace_buffer_t *) buffers;
+    atomic_int thread_count;
+};
+
+static atomic_uint_fast64_t next_trace_id = 1;
+
+/* The buffer this thread last traced into, and the trace it belongs to. */
+static _Thread_local uint64_t cached_trace_id;
+static _Thread_local trace_buffer_t * cached_buffer;
+static _Thread_local char thread_marker;
+
+static uint64_t
+trace_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+EASY_PC_API epc_trace_t *
+epc_trace_create(epc_trace_config_t const * config)
+{
+    epc_trace_config_t const defaults = { 0 };
+    if (config == NULL)
+    {
+        config = &defaults;
+    }
+
+    epc_trace_t * trace = calloc(1, sizeof(*trace));
+    if (trace == NULL)
+    {
+        return NULL;
+    }
+    trace->id = atomic_fetch_add(&next_trace_id, 1);
+    trace->start_ns = trace_now_ns();
+    trace->buffer_events = config->buffer_events != 0 ? config->buffer_events : DEFAULT_BUFFER_EVENTS;
+    trace->sample_every = config->sample_every > 1 ? config->sample_every : 1;
+    atomic_init(&trace->buffers, NULL);
+    atomic_init(&trace->thread_count, 0);
+
+    if (config->rules != NULL && config->rule_count > 0)
+    {
+        trace->rules = calloc(config->rule_count, sizeof(*trace->rules));
+        if (trace->rules == NULL)
+        {
+            epc_trace_free(trace);
+            return NULL;
+        }
+        trace->rule_count = config->rule_count;
+        for (size_t i = 0; i < config->rule_count; i++)
+        {
+            trace->rules[i] = strdup(config->rules[i] != NULL ? config->rules[i] : "");
+            if (trace->rules[i] == NULL)
+            {
+                epc_trace_free(trace);
+                return NULL;
+            }
+        }
+    }
+
+    return trace;
+}
+
+EASY_PC_API void
+epc_trace_free(epc_trace_t * trace)
+{
+    if (trace == NULL)
+    {
+        return;
+    }
+    trace_buffer_t * buffer = atomic_load(&trace->buffers);
+    while (buffer != NULL)
+    {
+        trace_buffer_t * next = buffer->next;
+        free(buffer->events);
+        free(buffer);
+        buffer = next;
+    }
+    for (size_t i = 0; i < trace->rule_count; i++)
+    {
+        free(trace->rules[i]);
+    }
+    free(trace->rules);
+    free(trace);
+}
+
+static trace_buffer_t *
+trace_buffer_get(epc_trace_t * trace)
+{
+    if (cached_trace_id == trace->id)
+    {
+        return cached_buffer;
+    }
+
+    trace_buffer_t * buffer = atomic_load(&trace->buffers);
+    while (buffer != NULL && buffer->owner != &thread_marker)
+    {
+        buffer = buffer->next;
+    }
+    if (buffer == NULL)
+    {
+        buffer = calloc(1, sizeof(*buffer));
+        if (buffer == NULL)
+        {
+            return NULL;
+        }
+        buffer->events = malloc(trace->buffer_events * sizeof(*buffer->events));
+        if (buffer->events == NULL)
+        {
+            free(buffer);
+            return NULL;
+        }
+        buffer->owner = &thread_marker;
+        buffer->thread_index = atomic_fetch_add(&trace->thread_count, 1) + 1;
+        buffer->next = atomic_load(&trace->buffers);
+        while (!atomic_compare_exchange_weak(&trace->buffers, &buffer->next, buffer))
+        {
+        }
+    }
+    cached_trace_id = trace->id;
+    cached_buffer = buffer;
+
+    return buffer;
+}
+
+static void
+trace_record(trace_buffer_t * buffer, size_t capacity, trace_event_t const * event)
+{
+    buffer->events[buffer->written % capacity] = *event;
+    buffer->written++;
+}
+
+static bool
+trace_rule_wanted(epc_trace_t const * trace, char const * name)
+{
+    if (trace->rules == NULL)
+    {
+        return true;
+    }
+    for (size_t i = 0; i < trace->rule_count; i++)
+    {
+        if (strcmp(trace->rules[i], name != NULL ? name : "") == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+EASY_PC_HIDDEN bool
+epc_trace_enter(epc_trace_t * trace, epc_parser_t const * parser, epc_parser_ctx_t const * ctx, const char * input)
+{
+    if (!trace_rule_wanted(trace, parser->name))
+    {
+        return false;
+    }
+    trace_buffer_t * buffer = trace_buffer_get(trace);
+    if (buffer == NULL)
+    {
+        return false;
+    }
+    if (buffer->calls_to_skip > 0)
+    {
+        buffer->calls_to_skip--;
+        return false;
+    }
+    buffer->calls_to_skip = trace->sample_every - 1;
+
+    trace_event_t const event = {
+        .time_ns = trace_now_ns(),
+        .name = parser->name,
+        .offset = (size_t)(input - ctx->input_start),
+        .kind = TRACE_EVENT_ENTER,
+    };
+    trace_record(buffer, trace->buffer_events, &event);
+
+    return true;
+}
+
+EASY_PC_HIDDEN void
+epc_trace_exit(epc_trace_t * trace, epc_parser_t const * parser, epc_parser_ctx_t const * ctx, const char * input,
+               epc_parse_result_t const * result)
+{
+    trace_buffer_t * buffer = trace_buffer_get(trace);
+    if (buffer == NULL)
+    {
+        return;
+    }
+    bool const success = !result->is_error && result->data.success != NULL;
+    trace_event_t const event = {
+        .time_ns = trace_now_ns(),
+        .name = parser->name,
+        .offset = (size_t)(input - ctx->input_start),
+        .len = success ? result->data.success->len : 0,
+        .kind = success ? TRACE_EVENT_SUCCESS : TRACE_EVENT_FAIL,
+    };
+    trace_record(buffer, trace->buffer_events, &event);
+}
+
+static bool
+write_json_string(FILE * out, char const * text)
+{
+    bool success = fputc('"', out) != EOF;
+    for (unsigned char const * c = (unsigned char const *)text; *c != '\0' && success; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            success = fprintf(out, "\\%c", *c) >= 0;
+        }
+        else if (*c < 0x20)
+        {
+            success = fprintf(out, "\\u%04x", *c) >= 0;
+        }
+        else
+        {
+            success = fputc(*c, out) != EOF;
+        }
+    }
+    return success && fputc('"', out) != EOF;
+}
+
+static bool
+write_trace_event(FILE * out, bool * first, epc_trace_t const * trace, trace_buffer_t const * buffer,
+                  trace_event_t const * event, char phase)
+{
+    uint64_t const ns = event->time_ns - trace->start_ns;
+    bool success = fprintf(out, "%s\n{\"name\":", *first ? "" : ",") >= 0;
+    *first = false;
+    success = success && write_json_string(out, event->name != NULL && event->name[0] != '\0' ? event->name : "-");
+    success = success
+              && fprintf(out, ",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":%d", phase,
+                         (unsigned long long)(ns / 1000), (unsigned)(ns % 1000), buffer->thread_index)
+                     >= 0;
+    switch (event->kind)
+    {
+    case TRACE_EVENT_ENTER:
+        success = success && fprintf(out, ",\"args\":{\"offset\":%zu}}", event->offset) >= 0;
+        break;
+    case TRACE_EVENT_SUCCESS:
+        success = success && fprintf(out, ",\"args\":{\"result\":\"success\",\"length\":%zu}}", event->len) >= 0;
+        break;
+    case TRACE_EVENT_FAIL:
+        success = success && fprintf(out, ",\"args\":{\"result\":\"fail\"}}") >= 0;
+        break;
+    case TRACE_EVENT_UNFINISHED:
+        success = success && fprintf(out, ",\"args\":{\"result\":\"unfinished\"}}") >= 0;
+        break;
+    }
+    return success;
+}
+
+EASY_PC_API bool
+epc_trace_write_chrome_json(epc_trace_t const * trace, FILE * out)
+{
+    bool success = fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") >= 0;
+    bool first = true;
+
+    for (trace_buffer_t const * buffer = atomic_load(&((epc_trace_t *)trace)->buffers); buffer != NULL && success;
+         buffer = buffer->next)
+    {
+        size_t const capacity = trace->buffer_events;
+        uint64_t const oldest = buffer->written > capacity ? buffer->written - capacity : 0;
+        /* The calls entered, and not yet exited, as of each event. */
+        trace_event_t const ** open = malloc(capacity * sizeof(*open));
+        size_t depth = 0;
+        if (open == NULL)
+        {
+            return false;
+        }
+        for (uint64_t i = oldest; i < buffer->written && success; i++)
+        {
+            trace_event_t const * event = &buffer->events[i % capacity];
+            if (event->kind == TRACE_EVENT_ENTER)
+            {
+                open[depth++] = event;
+                success = write_trace_event(out, &first, trace, buffer, event, 'B');
+            }
+            else if (depth > 0)
+            {
+                depth--;
+                success = write_trace_event(out, &first, trace, buffer, event, 'E');
+            }
+        }
+        /* Close the calls still running when the trace was written. */
+        if (buffer->written > 0)
+        {
+            trace_event_t const * last = &buffer->events[(buffer->written - 1) % capacity];
+            while (depth > 0 && success)
+            {
+                trace_event_t event = *open[--depth];
+                event.time_ns = last->time_ns;
+                event.kind = TRACE_EVENT_UNFINISHED;
+                success = write_trace_event(out, &first, trace, buffer, &event, 'E');
+            }
+        }
+        free(open);
+    }
+
+    return success && fprintf(out, "\n]}\n") >= 0;
+}
@@ -0,0 +1,352 @@
+#include "left_recursion.h"
+#include "parser_map.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef enum
+{
+    NULLABLE_UNKNOWN,
+    NULLABLE_IN_PROGRESS,
+    NULLABLE_NO,
+    NULLABLE_YES,
+} nullable_t;
+
+// A parser in the graph of left corners: the parsers each one may call at the position it was called at.
+typedef struct
+{
+    epc_parser_t * parser;
+    size_t order;               /* When the search reached the parser, from 1. 0 until then. */
+    size_t low;                 /* The lowest order reachable from the parser, for Tarjan's algorithm. */
+    size_t stack_next;          /* The node below this one on the stack, plus 1. */
+    bool on_stack;
+    bool calls_itself;
+    nullable_t nullable;
+} graph_node_t;
+
+typedef struct
+{
+    parser_map_t map;           /* Parser to node index. */
+    graph_node_t * nodes;
+    size_t count;
+    size_t capacity;
+    size_t stack_top;           /* The top node on the stack, plus 1. 0 if the stack is empty. */
+    size_t next_order;
+    bool failed;                /* Out of memory. */
+} graph_t;
+
+typedef epc_parse_result_t (*parse_fn_t)(epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input);
+
+static bool
+is_rule(epc_parser_t const * parser)
+{
+    return parser->parse_fn == epc_rule_parse_fn || parser->parse_fn == epc_left_recursive_rule_parse_fn;
+}
+
+// The parse function that tells what kind of parser this is. A rule is the kind of its definition.
+static parse_fn_t
+parser_kind(epc_parser_t const * parser)
+{
+    return is_rule(parser) ? parser->rule_parse_fn : parser->parse_fn;
+}
+
+static bool
+graph_node(graph_t * graph, epc_parser_t * parser, size_t * index)
+{
+    if (parser_map_find(&graph->map, parser, index))
+    {
+        return true;
+    }
+    if (graph->count == graph->capacity)
+    {
+        size_t capacity = graph->capacity == 0 ? 64 : graph->capacity * 2;
+        graph_node_t * nodes = realloc(graph->nodes, capacity * sizeof(*nodes));
+        if (nodes == NULL)
+        {
+            return false;
+        }
+        graph->nodes = nodes;
+        graph->capacity = capacity;
+    }
+    if (!parser_map_add(&graph->map, parser, graph->count))
+    {
+        return false;
+    }
+    graph->nodes[graph->count] = (graph_node_t){ .parser = parser };
+    *index = graph->count++;
+    return true;
+}
+
+// Returns the number of children the parser may call. Sets *sequence if each is only called after the one before it.
+static int
+parser_child_count(epc_parser_t const * parser, bool * sequence)
+{
+    parse_fn_t kind = parser_kind(parser);
+    epc_parser_data_t const * data = &parser->data;
+
+    *sequence = false;
+    switch (data->data_type)
+    {
+        case EPC_PARSER_DATA_TYPE_PARSER_LIST:
+            *sequence = kind == epc_and_parse_fn;
+            return data->parser_list != NULL ? data->parser_list->count : 0;
+
+        case EPC_PARSER_DATA_TYPE_BETWEEN:
+            *sequence = true;
+            return 3;
+
+        case EPC_PARSER_DATA_TYPE_DELIMITED:
+            /* epc_delimited(), epc_chainl1() and epc_chainr1() all start with an item. */
+            *sequence = true;
+            return 2;
+
+        case EPC_PARSER_DATA_TYPE_COUNT:
+        case EPC_PARSER_DATA_TYPE_LEXEME:
+            return 1;
+
+        case EPC_PARSER_DATA_TYPE_OPERATOR_TABLE:
+            return data->operator_table != NULL ? 1 : 0;
+
+        case EPC_PARSER_DATA_TYPE_OTHER:
+            return kind == epc_many_parse_fn || kind == epc_plus_parse_fn || kind == epc_optional_parse_fn
+                    || kind == epc_lookahead_parse_fn || kind == epc_not_parse_fn || kind == epc_skip_parse_fn
+                    || kind == epc_passthru_parse_fn
+                ? 1
+                : 0;
+
+        default:
+            return 0;
+    }
+}
+
+// Returns the parser's i-th child, which may be NULL.
+static epc_parser_t *
+parser_child(epc_parser_t const * parser, int i)
+{
+    epc_parser_data_t const * data = &parser->data;
+
+    switch (data->data_type)
+    {
+        case EPC_PARSER_DATA_TYPE_PARSER_LIST:
+            return data->parser_list->parsers[i];
+        case EPC_PARSER_DATA_TYPE_BETWEEN:
+            return i == 0 ? data->between.open : i == 1 ? data->between.parser : data->between.close;
+        case EPC_PARSER_DATA_TYPE_DELIMITED:
+            return i == 0 ? data->delimited.item : data->delimited.delimiter;
+        case EPC_PARSER_DATA_TYPE_COUNT:
+            return data->count.parser;
+        case EPC_PARSER_DATA_TYPE_LEXEME:
+            return data->lexeme.parser;
+        case EPC_PARSER_DATA_TYPE_OPERATOR_TABLE:
+            return data->operator_table->operand;
+        default:
+            return data->other;
+    }
+}
+
+// Whether the parser may match the empty string. Only "no" is certain.
+static bool
+parser_is_nullable(graph_t * graph, epc_parser_t * parser)
+{
+    size_t index;
+    if (!graph_node(graph, parser, &index))
+    {
+        graph->failed = true;
+        return true;
+    }
+    switch (graph->nodes[index].nullable)
+    {
+        case NULLABLE_NO:
+            return false;
+        case NULLABLE_UNKNOWN:
+            break;
+        default:
+            return true;
+    }
+    graph->nodes[index].nullable = NULLABLE_IN_PROGRESS;
+
+    parse_fn_t kind = parser_kind(parser);
+    epc_parser_data_t const * data = &parser->data;
+    bool nullable = true;
+    bool sequence;
+    int child_count = parser_child_count(parser, &sequence);
+
+    if (kind == epc_char_parse_fn || kind == epc_digit_parse_fn || kind == epc_int_parse_fn
+        || kind == epc_space_parse_fn || kind == epc_alpha_parse_fn || kind == epc_alphanum_parse_fn
+        || kind == epc_double_parse_fn || kind == epc_char_range_parse_fn || kind == epc_any_char_parse_fn
+        || kind == epc_none_of_parse_fn || kind == epc_hex_digit_parse_fn || kind == epc_one_of_parse_fn
+        || kind == epc_fail_parse_fn)
+    {
+        nullable = false;
+    }
+    else if (kind == epc_string_parse_fn)
+    {
+        nullable = data->string == NULL || data->string[0] == '\0';
+    }
+    else if (kind == epc_keywords_parse_fn)
+    {
+        nullable = data->keywords == NULL;
+        for (int i = 0; !nullable && i < data->keywords->count; i++)
+        {
+            nullable = data->keywords->keywords[i][0] == '\0';
+        }
+    }
+    else if (kind == epc_dfa_parse_fn)
+    {
+        nullable = data->dfa == NULL || data->dfa->accepting[data->dfa->start] != 0;
+    }
+    else if (kind == epc_and_parse_fn || kind == epc_between_parse_fn)
+    {
+        for (int i = 0; nullable && i < child_count; i++)
+        {
+            epc_parser_t * child = parser_child(parser, i);
+            nullable = child == NULL || parser_is_nullable(graph, child);
+        }
+    }
+    else if (kind == epc_or_parse_fn)
+    {
+        nullable = false;
+        for (int i = 0; !nullable && i < child_count; i++)
+        {
+            epc_parser_t * child = parser_child(parser, i);
+            nullable = child == NULL || parser_is_nullable(graph, child);
+        }
+    }
+    else if (kind == epc_count_parse_fn)
+    {
+        nullable = data->count.count <= 0 || data->count.parser == NULL || parser_is_nullable(graph, data->count.parser);
+    }
+    else if (kind == epc_plus_parse_fn || kind == epc_passthru_parse_fn || kind == epc_lexeme_parse_fn
+             || kind == epc_delimited_parse_fn || kind == epc_chainl1_parse_fn || kind == epc_chainr1_parse_fn
+             || data->data_type == EPC_PARSER_DATA_TYPE_OPERATOR_TABLE)
+    {
+        /* These match what their first child matches, at least. */
+        epc_parser_t * first = child_count > 0 ? parser_child(parser, 0) : NULL;
+        nullable = first == NULL || parser_is_nullable(graph, first);
+    }
+
+    /* The node array may have moved. */
+    graph->nodes[index].nullable = nullable ? NULLABLE_YES : NULLABLE_NO;
+    return nullable;
+}
+
+// Returns the parser's i-th left corner through *corner, which may be NULL.
+// Returns false once there are no more.
+static bool
+parser_left_corner(graph_t * graph, epc_parser_t const * parser, int i, epc_parser_t ** corner)
+{
+    bool sequence;
+
+    if (i >= parser_child_count(parser, &sequence))
+    {
+        return false;
+    }
+    if (sequence && i > 0)
+    {
+        /* The previous corners were checked already; this one is only called if the one before may match nothing. */
+        epc_parser_t * before = parser_child(parser, i - 1);
+        if (before != NULL && !parser_is_nullable(graph, before))
+        {
+            return false;
+        }
+    }
+    *corner = parser_child(parser, i);
+    return true;
+}
+
+static void
+mark_rule(epc_parser_t * parser)
+{
+    /* Statically initialized rules were given their parse function when generated. */
+    if (is_rule(parser) && parser->id != 0)
+    {
+        parser->parse_fn = epc_left_recursive_rule_parse_fn;
+    }
+}
+
+// Tarjan's algorithm. A component with a cycle is a set of rules that may call each other without consuming input.
+static void
+graph_search(graph_t * graph, size_t v)
+{
+    graph->nodes[v].order = graph->nodes[v].low = ++graph->next_order;
+    graph->nodes[v].on_stack = true;
+    graph->nodes[v].stack_next = graph->stack_top;
+    graph->stack_top = v + 1;
+
+    epc_parser_t * corner;
+    for (int i = 0; parser_left_corner(graph, graph->nodes[v].parser, i, &corner); i++)
+    {
+        size_t w;
+        if (corner == NULL)
+        {
+            continue;
+        }
+        if (graph->failed || !graph_node(graph, corner, &w))
+        {
+            graph->failed = true;
+            return;
+        }
+        if (w == v)
+        {
+            graph->nodes[v].calls_itself = true;
+        }
+        if (graph->nodes[w].order == 0)
+        {
+            graph_search(graph, w);
+            if (graph->failed)
+            {
+                return;
+            }
+            if (graph->nodes[w].low < graph->nodes[v].low)
+            {
+                graph->nodes[v].low = graph->nodes[w].low;
+            }
+        }
+        else if (graph->nodes[w].on_stack && graph->nodes[w].order < graph->nodes[v].low)
+        {
+            graph->nodes[v].low = graph->nodes[w].order;
+        }
+    }
+
+    if (graph->nodes[v].low != graph->nodes[v].order)
+    {
+        return;
+    }
+    bool cyclic = graph->nodes[v].calls_itself || graph->stack_top != v + 1;
+    size_t w;
+    do
+    {
+        w = graph->stack_top - 1;
+        graph->stack_top = graph->nodes[w].stack_next;
+        graph->nodes[w].on_stack = false;
+        if (cyclic)
+        {
+            mark_rule(graph->nodes[w].parser);
+        }
+    } while (w != v);
+}
+
+EASY_PC_HIDDEN
+void
+left_recursion_mark_rules(epc_parser_t * rule)
+{
+    graph_t graph = { 0 };
+    size_t start;
+
+    if (graph_node(&graph, rule, &start))
+    {
+        graph_search(&graph, start);
+    }
+    else
+    {
+        graph.failed = true;
+    }
+    if (graph.failed)
+    {
+        /* Every cycle found now goes through the rule, so guarding it is enough. */
+        mark_rule(rule);
+    }
+
+    free(graph.nodes);
+    parser_map_release(&graph.map);
+}
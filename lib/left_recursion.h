@@ -0,0 +1,15 @@
+#pragma once
+
+#include "easy_pc_private.h"
+
+// Finds the rules that can call themselves at the same input position, i.e.
+// without consuming input first, directly or through other rules, among those
+// reachable from a rule just completed with epc_parser_duplicate(). Their
+// parse function is switched to epc_left_recursive_rule_parse_fn.
+//
+// Each cycle of rules is found once its last rule is completed. Rules that
+// are still forward declarations are treated as matching nothing, and parsers
+// made with epc_direct() as calling no other parsers.
+EASY_PC_HIDDEN
+void
+left_recursion_mark_rules(epc_parser_t * rule);
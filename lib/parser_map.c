@@ -0,0 +1,100 @@
+#include "parser_map.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+static atomic_uint_fast64_t last_id;
+
+EASY_PC_HIDDEN
+uint64_t
+parser_map_next_id(void)
+{
+    return (uint64_t)atomic_fetch_add(&last_id, 1) + 1;
+}
+
+// Ids are odd and addresses even, as a parser is at least pointer aligned.
+static uint64_t
+parser_key(epc_parser_t const * parser)
+{
+    return parser->id != 0 ? parser->id << 1 | 1 : (uint64_t)(uintptr_t)parser;
+}
+
+static size_t
+key_hash(uint64_t key)
+{
+    key ^= key >> 29;
+    key *= 0xbf58476d1ce4e5b9u;
+    return (size_t)(key ^ (key >> 32));
+}
+
+static parser_map_slot_t *
+map_slot(parser_map_slot_t * slots, size_t capacity, uint64_t key)
+{
+    size_t i = key_hash(key) & (capacity - 1);
+    while (slots[i].key != 0 && slots[i].key != key)
+    {
+        i = (i + 1) & (capacity - 1);
+    }
+    return &slots[i];
+}
+
+static bool
+map_grow(parser_map_t * map)
+{
+    size_t capacity = map->capacity == 0 ? 64 : map->capacity * 2;
+    parser_map_slot_t * slots = calloc(capacity, sizeof(*slots));
+    if (slots == NULL)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < map->capacity; i++)
+    {
+        if (map->slots[i].key != 0)
+        {
+            *map_slot(slots, capacity, map->slots[i].key) = map->slots[i];
+        }
+    }
+    free(map->slots);
+    map->slots = slots;
+    map->capacity = capacity;
+    return true;
+}
+
+EASY_PC_HIDDEN
+bool
+parser_map_find(parser_map_t const * map, epc_parser_t const * parser, size_t * index)
+{
+    if (map->capacity == 0)
+    {
+        return false;
+    }
+    parser_map_slot_t const * slot = map_slot(map->slots, map->capacity, parser_key(parser));
+    if (slot->key == 0)
+    {
+        return false;
+    }
+    *index = slot->index;
+    return true;
+}
+
+EASY_PC_HIDDEN
+bool
+parser_map_add(parser_map_t * map, epc_parser_t const * parser, size_t index)
+{
+    if ((map->count + 1) * 2 > map->capacity && !map_grow(map))
+    {
+        return false;
+    }
+    uint64_t key = parser_key(parser);
+    *map_slot(map->slots, map->capacity, key) = (parser_map_slot_t){ .key = key, .index = index };
+    map->count++;
+    return true;
+}
+
+EASY_PC_HIDDEN
+void
+parser_map_release(parser_map_t * map)
+{
+    free(map->slots);
+    *map = (parser_map_t){ 0 };
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "easy_pc_private.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct parser_map_slot_t
+{
+    uint64_t key;                   /* 0 if the slot is free. */
+    size_t index;
+} parser_map_slot_t;
+
+// Maps parsers to indexes into an array the owner keeps, e.g. of counters.
+// Parsers are told apart by the id they were given when created, so a parser
+// allocated where a freed one was isn't mistaken for it. Parsers without an id
+// are statically initialized, and never freed, so their address is used.
+typedef struct parser_map_t
+{
+    parser_map_slot_t * slots;      /* Open-addressed, and at most half full. */
+    size_t capacity;                /* 0 or a power of two. */
+    size_t count;
+} parser_map_t;
+
+// Returns a new parser id. Never 0, and never the same twice.
+EASY_PC_HIDDEN
+uint64_t
+parser_map_next_id(void);
+
+// Finds a parser's index. Returns false if the parser isn't in the map.
+EASY_PC_HIDDEN
+bool
+parser_map_find(parser_map_t const * map, epc_parser_t const * parser, size_t * index);
+
+// Adds a parser that isn't in the map. Returns false on allocation failure.
+EASY_PC_HIDDEN
+bool
+parser_map_add(parser_map_t * map, epc_parser_t const * parser, size_t index);
+
+// Frees the slots, leaving an empty map.
+EASY_PC_HIDDEN
+void
+parser_map_release(parser_map_t * map);
@@ -1,8 +1,12 @@
 #include "parsers.h"
 #include "easy_pc_private.h"
 #include "child_list.h"
+#include "left_recursion.h"
+#include "parser_map.h"
 
 #include <ctype.h>    // For isdigit
+#include <limits.h>
+#include <locale.h>   // For localeconv
 #include <stdarg.h> // For va_list, va_start, va_arg, va_end
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,18 +17,19 @@
 // --- Internal Helper Functions ---
 // --- Parser List free. ---
 static void
-parser_list_free(parser_list_t *list)
+parser_list_free(epc_parser_list_data_t *list)
 {
     if (list == NULL)
     {
         return;
     }
     free(list->parsers);
+    free((void *)list->first);
     free(list);
 }
 
 // --- Parser List Creation ---
-static parser_list_t *
+static epc_parser_list_data_t *
 parser_list_create_v(int count, va_list parsers)
 {
     if (count <= 0)
@@ -32,7 +37,7 @@ parser_list_create_v(int count, va_list parsers)
         return NULL;
     }
 
-    parser_list_t * list = calloc(1, sizeof(*list));
+    epc_parser_list_data_t * list = calloc(1, sizeof(*list));
     if (list == NULL)
     {
         return NULL;
@@ -54,6 +59,228 @@ parser_list_create_v(int count, va_list parsers)
     return list;
 }
 
+static epc_parser_list_data_t *
+parser_list_create_a(int count, epc_parser_t * const * parsers)
+{
+    if (count <= 0)
+    {
+        return NULL;
+    }
+
+    epc_parser_list_data_t * list = calloc(1, sizeof(*list));
+    if (list == NULL)
+    {
+        return NULL;
+    }
+
+    list->parsers = calloc(count, sizeof(*list->parsers));
+    if (list->parsers == NULL)
+    {
+        free(list);
+        return NULL;
+    }
+    memcpy(list->parsers, parsers, count * sizeof(*list->parsers));
+    list->count = count;
+
+    return list;
+}
+
+// --- Keyword trie ---
+static void
+keywords_data_free(epc_keywords_data_t * data)
+{
+    if (data == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < data->count; i++)
+    {
+        free(data->keywords[i]);
+    }
+    free(data->keywords);
+    free(data->nodes);
+    free(data->expected);
+    free(data);
+}
+
+static int
+keyword_trie_node_add(epc_keywords_data_t * data, unsigned char c)
+{
+    if (data->node_count == data->node_capacity)
+    {
+        int new_capacity = data->node_capacity * 2;
+        epc_keyword_trie_node_t * new_nodes = realloc(data->nodes, new_capacity * sizeof(*new_nodes));
+        if (new_nodes == NULL)
+        {
+            return -1;
+        }
+        data->nodes = new_nodes;
+        data->node_capacity = new_capacity;
+    }
+
+    int index = data->node_count++;
+    epc_keyword_trie_node_t * node = &data->nodes[index];
+
+    node->first_child = -1;
+    node->next_sibling = -1;
+    node->keyword_index = -1;
+    node->c = c;
+
+    return index;
+}
+
+static bool
+keyword_trie_insert(epc_keywords_data_t * data, char const * keyword, int keyword_index)
+{
+    int current = 0;
+
+    for (unsigned char const * k = (unsigned char const *)keyword; *k != '\0'; k++)
+    {
+        /* Find the child for this character, keeping the sibling list sorted. */
+        int prev = -1;
+        int child = data->nodes[current].first_child;
+        while (child >= 0 && data->nodes[child].c < *k)
+        {
+            prev = child;
+            child = data->nodes[child].next_sibling;
+        }
+        if (child < 0 || data->nodes[child].c != *k)
+        {
+            int new_child = keyword_trie_node_add(data, *k);
+            if (new_child < 0)
+            {
+                return false;
+            }
+            data->nodes[new_child].next_sibling = child;
+            if (prev < 0)
+            {
+                data->nodes[current].first_child = new_child;
+            }
+            else
+            {
+                data->nodes[prev].next_sibling = new_child;
+            }
+            child = new_child;
+        }
+        current = child;
+    }
+
+    /* If the same keyword is listed more than once the first one wins, as it would with epc_or. */
+    if (data->nodes[current].keyword_index < 0)
+    {
+        data->nodes[current].keyword_index = keyword_index;
+    }
+
+    return true;
+}
+
+static epc_keywords_data_t *
+keywords_data_create(char const * const * keywords, int count)
+{
+    if (keywords == NULL || count <= 0)
+    {
+        return NULL;
+    }
+
+    epc_keywords_data_t * data = calloc(1, sizeof(*data));
+    if (data == NULL)
+    {
+        return NULL;
+    }
+
+    data->keywords = calloc(count, sizeof(*data->keywords));
+    data->node_capacity = 16;
+    data->nodes = calloc(data->node_capacity, sizeof(*data->nodes));
+    if (data->keywords == NULL || data->nodes == NULL)
+    {
+        keywords_data_free(data);
+        return NULL;
+    }
+
+    size_t expected_len = 0;
+    for (int i = 0; i < count; i++)
+    {
+        data->keywords[i] = strdup(keywords[i] != NULL ? keywords[i] : "");
+        if (data->keywords[i] == NULL)
+        {
+            keywords_data_free(data);
+            return NULL;
+        }
+        data->count++;
+        expected_len += strlen(data->keywords[i]) + strlen(" or ");
+    }
+
+    /* The root node. */
+    if (keyword_trie_node_add(data, '\0') != 0)
+    {
+        keywords_data_free(data);
+        return NULL;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (!keyword_trie_insert(data, data->keywords[i], i))
+        {
+            keywords_data_free(data);
+            return NULL;
+        }
+    }
+
+    data->expected = malloc(expected_len + 1);
+    if (data->expected == NULL)
+    {
+        keywords_data_free(data);
+        return NULL;
+    }
+    data->expected[0] = '\0';
+    for (int i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            strcat(data->expected, " or ");
+        }
+        strcat(data->expected, data->keywords[i]);
+    }
+
+    return data;
+}
+
+static void
+operator_table_data_free(epc_operator_table_data_t * data)
+{
+    if (data == NULL)
+    {
+        return;
+    }
+    free(data->operators);
+    free(data);
+}
+
+static epc_operator_table_data_t *
+operator_table_data_create(epc_parser_t * operand, epc_operator_t const * operators, int count)
+{
+    if (operators == NULL || count <= 0)
+    {
+        return NULL;
+    }
+
+    epc_operator_table_data_t * data = calloc(1, sizeof(*data));
+    if (data == NULL)
+    {
+        return NULL;
+    }
+    data->operators = calloc(count, sizeof(*data->operators));
+    if (data->operators == NULL)
+    {
+        operator_table_data_free(data);
+        return NULL;
+    }
+    memcpy(data->operators, operators, count * sizeof(*data->operators));
+    data->count = count;
+    data->operand = operand;
+
+    return data;
+}
+
 static void
 string_set(char const * * const dst, char const * src)
 {
@@ -69,30 +296,49 @@ string_set(char const * * const dst, char const * src)
 }
 
 static void
-parser_data_free(parser_data_type_st * data)
+parser_data_free(epc_parser_data_t * data)
 {
     switch (data->data_type)
     {
-        case PARSER_DATA_TYPE_OTHER:
-        case PARSER_DATA_TYPE_CHAR_RANGE:
-        case PARSER_DATA_TYPE_COUNT:
-        case PARSER_DATA_TYPE_BETWEEN:
-        case PARSER_DATA_TYPE_DELIMITED:
-        case PARSER_DATA_TYPE_LEXEME:
+        case EPC_PARSER_DATA_TYPE_OTHER:
+        case EPC_PARSER_DATA_TYPE_CHAR_RANGE:
+        case EPC_PARSER_DATA_TYPE_COUNT:
+        case EPC_PARSER_DATA_TYPE_BETWEEN:
+        case EPC_PARSER_DATA_TYPE_DELIMITED:
+        case EPC_PARSER_DATA_TYPE_LEXEME:
+        case EPC_PARSER_DATA_TYPE_DFA:
             /* Nothing to do. */
             break;
 
-        case PARSER_DATA_TYPE_STRING:
+        case EPC_PARSER_DATA_TYPE_STRING:
             free((char *)data->string);
             data->string = NULL;
             break;
 
-        case PARSER_DATA_TYPE_PARSER_LIST:
+        case EPC_PARSER_DATA_TYPE_PARSER_LIST:
             parser_list_free(data->parser_list);
             data->parser_list = NULL;
             break;
+
+        case EPC_PARSER_DATA_TYPE_KEYWORDS:
+            keywords_data_free(data->keywords);
+            data->keywords = NULL;
+            break;
+
+        case EPC_PARSER_DATA_TYPE_OPERATOR_TABLE:
+            operator_table_data_free(data->operator_table);
+            data->operator_table = NULL;
+            break;
+
+        case EPC_PARSER_DATA_TYPE_DIRECT:
+            if (data->direct.free_user_data != NULL)
+            {
+                data->direct.free_user_data(data->direct.user_data);
+            }
+            data->direct.user_data = NULL;
+            break;
     }
-    data->data_type = PARSER_DATA_TYPE_OTHER;
+    data->data_type = EPC_PARSER_DATA_TYPE_OTHER;
 }
 
 void
@@ -133,6 +379,7 @@ epc_parser_allocate(char const * name)
         return NULL;
     }
     string_set(&p->name, name);
+    p->id = parser_map_next_id();
 
     return p;
 }
@@ -145,6 +392,7 @@ epc_parser_error_free(epc_parser_error_t * error)
     {
         return;
     }
+    epc_stats_freed(1 + (error->message != NULL) + (error->expected != NULL) + (error->found != NULL));
     free((char *)error->message);
     free((char *)error->expected);
     free((char *)error->found);
@@ -157,7 +405,7 @@ typedef struct line_col_calc_result_t
 } line_column_calc_result_t;
 
 static line_column_calc_result_t
-calculate_line_and_column(char const * start, char const * current)
+calculate_line_and_column(epc_parser_ctx_t * ctx, char const * start, char const * current)
 {
     line_column_calc_result_t res = {0};
     if (start == NULL || current == NULL)
@@ -165,15 +413,35 @@ calculate_line_and_column(char const * start, char const * current)
         return res;
     }
 
-    char const * nl;
+    /*
+     * Errors are mostly built further on than the last, so carry on counting
+     * from where the last scan stopped instead of from the start of the input.
+     */
+    char const * p = start;
     char const * line_start = start;
-    for (nl = strchr(start, '\n'); nl != NULL && nl <= current; nl = strchr(nl + 1, '\n'))
+    if (ctx != NULL && ctx->line_scan_position != NULL && ctx->line_scan_position <= current + 1)
     {
-        res.line++;
-        line_start = nl;
+        p = ctx->line_scan_position;
+        res.line = ctx->line_scan_line;
+        line_start = ctx->line_scan_line_start;
+    }
+    for (; p <= current; p++)
+    {
+        if (*p == '\n')
+        {
+            res.line++;
+            line_start = p;
+        }
     }
     res.col = current - line_start;
 
+    if (ctx != NULL)
+    {
+        ctx->line_scan_position = p;
+        ctx->line_scan_line = res.line;
+        ctx->line_scan_line_start = line_start;
+    }
+
     return res;
 }
 
@@ -196,13 +464,14 @@ epc_parser_error_alloc(
         ctx != NULL ? ctx->input_start : input_position;
 
     error->input_position = input_position;
-    line_column_calc_result_t res = calculate_line_and_column(input_start, input_position);
+    line_column_calc_result_t res = calculate_line_and_column(ctx, input_start, input_position);
     error->line = res.line;
     error->col = res.col;
 
     error->message = strdup(message != NULL ? message : "");
     error->expected = strdup(expected != NULL ? expected : "");
     error->found = strdup(found != NULL ? found : "");
+    epc_stats_error_allocated();
 
     return error;
 }
@@ -250,13 +519,21 @@ parser_furthest_error_restore(epc_parser_ctx_t * ctx, epc_parser_error_t * * rep
 }
 
 static epc_parser_error_t *
-parser_error_copy(epc_parser_ctx_t * ctx, epc_parser_error_t *e)
+parser_error_copy(epc_parser_error_t *e)
 {
     if (e == NULL)
     {
         return NULL;
     }
-    return epc_parser_error_alloc(ctx, e->input_position, e->message, e->expected, e->found);
+    epc_stats_error_copied();
+    epc_parser_error_t * copy = epc_parser_error_alloc(NULL, e->input_position, e->message, e->expected, e->found);
+    if (copy != NULL)
+    {
+        copy->kind = e->kind;
+        copy->line = e->line;
+        copy->col = e->col;
+    }
+    return copy;
 }
 
 static void
@@ -269,7 +546,7 @@ update_furthest_error(epc_parser_ctx_t * ctx, epc_parser_error_t * new_error)
     if (ctx->furthest_error == NULL
         || (new_error->input_position >= ctx->furthest_error->input_position))
     {
-        epc_parser_error_t * e_copy = parser_error_copy(ctx, new_error);
+        epc_parser_error_t * e_copy = parser_error_copy(new_error);
         parser_furthest_error_restore(ctx, &e_copy);
     }
 }
@@ -305,7 +582,7 @@ EASY_PC_HIDDEN
 epc_parser_error_t*
 parser_furthest_error_copy(epc_parser_ctx_t * ctx)
 {
-    return parser_error_copy(ctx, ctx->furthest_error);
+    return parser_error_copy(ctx->furthest_error);
 }
 
 static char const *
@@ -335,6 +612,21 @@ parser_get_expected_str(epc_parser_ctx_t * ctx, epc_parser_t * p)
 
 #define WITH_PARSE_DEBUG 0
 
+/* The failure of every parser call once a limit has been reached or the parse cancelled. */
+static epc_parse_result_t
+parse_limit_result(epc_parser_ctx_t * ctx, const char * input)
+{
+    epc_parse_result_t result = {
+        .is_error = true,
+        .data.error = epc_parser_error_alloc(ctx, input, "Parse stopped", "", ""),
+    };
+    if (result.data.error != NULL)
+    {
+        result.data.error->kind = ctx->limit_reached;
+    }
+    return result;
+}
+
 // Parser helper function
 static epc_parse_result_t
 parse(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
@@ -342,9 +634,49 @@ parse(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 #if WITH_PARSE_DEBUG
     fprintf(stderr, "parsing: name: %s. input: `%s`\n", self->name, input);
 #endif
+    if (ctx != NULL)
+    {
+        ctx->stats.parser_calls++;
+        if (++ctx->depth > ctx->stats.max_depth)
+        {
+            ctx->stats.max_depth = ctx->depth;
+        }
+        if (ctx->has_checks && epc_parse_limit_reached(ctx, input))
+        {
+            /* Unwind at once; the session reports the limit. */
+            ctx->depth--;
+            return parse_limit_result(ctx, input);
+        }
+    }
+#if WITH_PARSER_PROFILING
+    epc_profile_frame_t frame;
+    epc_profile_enter(&frame);
+#endif
+    bool const traced = ctx != NULL && ctx->trace != NULL && epc_trace_enter(ctx->trace, self, ctx, input);
+    if (ctx != NULL && ctx->backtrack_map != NULL)
+    {
+        epc_backtrack_map_record(ctx->backtrack_map, self, (size_t)(input - ctx->input_start));
+    }
 
     epc_parse_result_t result = self->parse_fn(self, ctx, input);
+    if (ctx != NULL && ctx->has_checks && epc_parse_limit_reached(ctx, input))
+    {
+        /* The nodes of this parser may have gone over a limit. */
+        epc_parser_result_cleanup(&result);
+        result = parse_limit_result(ctx, input);
+    }
 
+    if (traced)
+    {
+        epc_trace_exit(ctx->trace, self, ctx, input, &result);
+    }
+    if (ctx != NULL)
+    {
+        ctx->depth--;
+    }
+#if WITH_PARSER_PROFILING
+    epc_profile_exit(self, &frame, &result);
+#endif
 #if WITH_PARSE_DEBUG
     if (result.is_error)
     {
@@ -359,11 +691,34 @@ parse(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
     return result;
 }
 
+/*
+ * Parses outside of any enclosing epc_or. Used where the caller recovers from
+ * the parser failing, so a cut within it can't commit an alternative the
+ * caller may yet backtrack out of.
+ */
+static epc_parse_result_t
+parse_uncommitted(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    alternative_scope_t * outer_scope = ctx->alternative_scope;
+    ctx->alternative_scope = NULL;
+    epc_parse_result_t result = parse(self, ctx, input);
+    ctx->alternative_scope = outer_scope;
+
+    return result;
+}
+
+EASY_PC_HIDDEN
+epc_parse_result_t
+epc_parser_parse(epc_parser_t * parser, epc_parser_ctx_t * ctx, const char * input)
+{
+    return parse(parser, ctx, input);
+}
+
 
 // --- Terminal Parser Implementations ---
 
-static epc_parse_result_t
-pchar_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_char_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     char const * expected_str = self->data.string;
     char expected_char = expected_str[0];
@@ -406,7 +761,7 @@ epc_char(char const * name, char c)
     {
         return NULL;
     }
-    p->parse_fn = pchar_parse_fn;
+    p->parse_fn = epc_char_parse_fn;
 
     char buf[2] = { c, '\0'};
     char * data = strdup(buf);
@@ -415,15 +770,15 @@ epc_char(char const * name, char c)
         free(p);
         return NULL;
     }
-    p->data.data_type = PARSER_DATA_TYPE_STRING;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_STRING;
     p->data.string = data;
     p->expected_value = p->data.string;
 
     return p;
 }
 
-static epc_parse_result_t
-pstring_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_string_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     const char * expected_str = self->data.string;
     size_t expected_len = strlen(expected_str);
@@ -457,7 +812,12 @@ pstring_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char
     snprintf(found_buffer, sizeof(found_buffer), "%.*s", (int)sizeof(found_buffer) - 1, input);
     char const * error_msg;
 
-    size_t actual_len = strlen(input);
+    /* Only as far as the expected string; the rest of the input may be long. */
+    size_t actual_len = 1;
+    while (actual_len < expected_len && input[actual_len] != '\0')
+    {
+        actual_len++;
+    }
 
     if (actual_len < expected_len)
     {
@@ -479,22 +839,22 @@ epc_string(char const * name, const char * s)
     {
         return NULL;
     }
-    p->parse_fn = pstring_parse_fn;
+    p->parse_fn = epc_string_parse_fn;
     char *data = strdup(s);
     if (data == NULL)
     {
         free(p);
         return NULL;
     }
-    p->data.data_type = PARSER_DATA_TYPE_STRING;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_STRING;
     p->data.string = data;
     p->expected_value = p->data.string;
 
     return p;
 }
 
-static epc_parse_result_t
-peoi_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_eoi_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     if (input == NULL)
     {
@@ -530,12 +890,12 @@ epc_eoi(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = peoi_parse_fn;
+    p->parse_fn = epc_eoi_parse_fn;
     return p;
 }
 
-static epc_parse_result_t
-pdigit_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_digit_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     if (input == NULL)
     {
@@ -574,27 +934,251 @@ epc_digit(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = pdigit_parse_fn;
+    p->parse_fn = epc_digit_parse_fn;
     p->expected_value = "digit";
 
     return p;
 }
 
-static epc_parse_result_t
-pint_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+// --- Number scanners ---
+/*
+ * Hand-written scanners for the int and double terminals. Unlike strtoll() and
+ * strtod() they don't skip leading whitespace, don't depend on the current
+ * locale, and produce the converted value in the same pass that determines
+ * the length of the match.
+ */
+static inline bool
+is_ascii_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/*
+ * Scans an optional '-' followed by one or more decimal digits.
+ * Returns the length of the match, or 0 if there is no integer at `input`.
+ * Values that don't fit in a long long saturate, as strtoll() does.
+ */
+static size_t
+scan_int(char const * input, long long * value)
+{
+    char const * p = input;
+    bool negative = false;
+
+    if (*p == '-')
+    {
+        negative = true;
+        p++;
+    }
+    if (!is_ascii_digit(*p))
+    {
+        return 0;
+    }
+
+    unsigned long long const limit =
+        negative ? (unsigned long long)LLONG_MAX + 1 : (unsigned long long)LLONG_MAX;
+    unsigned long long magnitude = 0;
+    bool overflow = false;
+
+    for (; is_ascii_digit(*p); p++)
+    {
+        unsigned digit = (unsigned)(*p - '0');
+
+        if (overflow || magnitude > (limit - digit) / 10)
+        {
+            overflow = true;
+            continue;
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+
+    if (overflow)
+    {
+        *value = negative ? LLONG_MIN : LLONG_MAX;
+    }
+    else if (negative)
+    {
+        *value = magnitude == (unsigned long long)LLONG_MAX + 1 ? LLONG_MIN : -(long long)magnitude;
+    }
+    else
+    {
+        *value = (long long)magnitude;
+    }
+
+    return p - input;
+}
+
+/* Powers of ten that are exactly representable as a double. */
+static double const exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+#define MAX_EXACT_POWER_OF_TEN ((int)(sizeof(exact_powers_of_ten) / sizeof(exact_powers_of_ten[0])) - 1)
+#define MAX_EXACT_MANTISSA (1ULL << 53)
+#define MAX_SIGNIFICANT_DIGITS 19
+
+/*
+ * Converts an already validated number using strtod(). Used only when the
+ * fast path can't produce a correctly rounded result. The text is copied so
+ * the decimal point can be adjusted to suit the current locale.
+ */
+static double
+convert_double_slow(char const * input, size_t len)
+{
+    char local_buf[64];
+    char * buf = len < sizeof(local_buf) ? local_buf : malloc(len + 1);
+    if (buf == NULL)
+    {
+        return 0.0;
+    }
+    memcpy(buf, input, len);
+    buf[len] = '\0';
+
+    char const decimal_point = localeconv()->decimal_point[0];
+    if (decimal_point != '.')
+    {
+        char * dot = strchr(buf, '.');
+        if (dot != NULL)
+        {
+            *dot = decimal_point;
+        }
+    }
+
+    double value = strtod(buf, NULL);
+    if (buf != local_buf)
+    {
+        free(buf);
+    }
+
+    return value;
+}
+
+/*
+ * Scans [+-]? digits* ('.' digits*)? ([eE] [+-]? digits+)? with at least one
+ * mantissa digit. The exponent is only consumed if it contains a digit.
+ * Returns the length of the match, or 0 if there is no number at `input`.
+ */
+static size_t
+scan_double(char const * input, double * value)
+{
+    char const * p = input;
+    bool negative = false;
+
+    if (*p == '+' || *p == '-')
+    {
+        negative = *p == '-';
+        p++;
+    }
+
+    unsigned long long mantissa = 0;
+    int significant_digits = 0;
+    int decimal_exponent = 0;
+    bool truncated = false;
+    size_t mantissa_digits = 0;
+
+    for (; is_ascii_digit(*p); p++, mantissa_digits++)
+    {
+        if (significant_digits < MAX_SIGNIFICANT_DIGITS)
+        {
+            mantissa = mantissa * 10 + (unsigned)(*p - '0');
+            significant_digits += mantissa != 0;
+        }
+        else
+        {
+            truncated |= *p != '0';
+            decimal_exponent++;
+        }
+    }
+    if (*p == '.')
+    {
+        p++;
+        for (; is_ascii_digit(*p); p++, mantissa_digits++)
+        {
+            if (significant_digits < MAX_SIGNIFICANT_DIGITS)
+            {
+                mantissa = mantissa * 10 + (unsigned)(*p - '0');
+                significant_digits += mantissa != 0;
+                decimal_exponent--;
+            }
+            else
+            {
+                truncated |= *p != '0';
+            }
+        }
+    }
+    if (mantissa_digits == 0)
+    {
+        return 0;
+    }
+
+    if (*p == 'e' || *p == 'E')
+    {
+        char const * e = p + 1;
+        bool negative_exponent = false;
+
+        if (*e == '+' || *e == '-')
+        {
+            negative_exponent = *e == '-';
+            e++;
+        }
+        if (is_ascii_digit(*e))
+        {
+            int exponent = 0;
+            for (; is_ascii_digit(*e); e++)
+            {
+                if (exponent < 100000)
+                {
+                    exponent = exponent * 10 + (*e - '0');
+                }
+            }
+            decimal_exponent += negative_exponent ? -exponent : exponent;
+            p = e;
+        }
+    }
+
+    size_t len = p - input;
+
+    if (mantissa == 0)
+    {
+        *value = negative ? -0.0 : 0.0;
+    }
+    else if (!truncated
+             && mantissa <= MAX_EXACT_MANTISSA
+             && decimal_exponent >= -MAX_EXACT_POWER_OF_TEN
+             && decimal_exponent <= MAX_EXACT_POWER_OF_TEN)
+    {
+        /* Both operands are exact, so a single operation rounds correctly. */
+        double d = (double)mantissa;
+        if (decimal_exponent < 0)
+        {
+            d /= exact_powers_of_ten[-decimal_exponent];
+        }
+        else
+        {
+            d *= exact_powers_of_ten[decimal_exponent];
+        }
+        *value = negative ? -d : d;
+    }
+    else
+    {
+        *value = convert_double_slow(input, len);
+    }
+
+    return len;
+}
+
+epc_parse_result_t
+epc_int_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     if (input == NULL)
     {
         return epc_parser_error_result(ctx, input, "Input is NULL", "integer", "NULL");
     }
 
-    char * endptr;
-    (void)strtoll(input, &endptr, 10); // Base 10
+    long long value;
+    size_t parsed_len = scan_int(input, &value);
 
-    size_t parsed_len = endptr - input;
-
-    // A valid integer must parse at least one digit
-    if (parsed_len > 0 && (isdigit(*input) || (*input == '-' && parsed_len > 1 && isdigit(input[1]))))
+    if (parsed_len > 0)
     {
         epc_cpt_node_t * node = epc_node_alloc(self, "integer");
         if (node == NULL)
@@ -604,6 +1188,8 @@ pint_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * i
 
         node->content = input;
         node->len = parsed_len;
+        node->value_type = EPC_CPT_VALUE_INT;
+        node->value.int_value = value;
 
         return epc_parser_success_result(node);
     }
@@ -611,7 +1197,7 @@ pint_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * i
     char found_str_buf[32] = ""; // Initialize to empty string
     if (*input)
     {
-        snprintf(found_str_buf, sizeof(found_str_buf), "%.*s", (int)parsed_len > 30 ? 30 : (int)parsed_len, input);
+        snprintf(found_str_buf, sizeof(found_str_buf), "%.*s", 1, input);
     }
     else
     {
@@ -629,13 +1215,13 @@ epc_int(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = pint_parse_fn;
+    p->parse_fn = epc_int_parse_fn;
 
     return p;
 }
 
-static epc_parse_result_t
-pspace_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_space_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     if (input == NULL)
     {
@@ -675,14 +1261,14 @@ epc_space(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = pspace_parse_fn;
+    p->parse_fn = epc_space_parse_fn;
     p->expected_value = "whitespace";
 
     return p;
 }
 
-static epc_parse_result_t
-palpha_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_alpha_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     if (input == NULL)
     {
@@ -722,14 +1308,14 @@ epc_alpha(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = palpha_parse_fn;
+    p->parse_fn = epc_alpha_parse_fn;
     p->expected_value = "alpha";
 
     return p;
 }
 
-static epc_parse_result_t
-palphanum_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_alphanum_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     if (input == NULL)
     {
@@ -767,104 +1353,25 @@ epc_alphanum(char const * name)
     epc_parser_t * p = epc_parser_allocate(name != NULL ? name : "alphanum");
     if (p == NULL)
     {
-        return NULL;
-    }
-    p->parse_fn = palphanum_parse_fn;
-
-    return p;
-}
-
-static epc_parse_result_t
-pdouble_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
-{
-    if (input == NULL)
-    {
-        return epc_parser_error_result(ctx, input, "Input is NULL", "double", "NULL");
-    }
-
-    // Use strtod to parse the double
-    char * endptr;
-    (void)strtod(input, &endptr); // Perform a dry run to determine length
-
-    // Check if strtod actually parsed a number
-    // It should parse at least one digit or a sign followed by a digit/decimal point.
-    // Also, it should not be just a sign or a decimal point without numbers.
-    size_t parsed_len = endptr - input;
-
-    // A valid double must have parsed at least one character, and that character
-    // must not be the original input character if no actual number was parsed (e.g. "abc").
-    // Also, check for cases like "." or "+." or "-."
-    int is_valid_double = 0;
-    if (parsed_len > 0)
-    {
-        // Check for presence of digit or a decimal point followed by digit
-        const char * current = input;
-        int has_digit = 0;
-
-        // Skip leading sign if present
-        if (*current == '+' || *current == '-')
-        {
-            current++;
-        }
-
-        while (current < endptr && isdigit(*current))
-        {
-            has_digit = 1;
-            current++;
-        }
-        if (current < endptr && *current == '.')
-        {
-            current++;
-            while (current < endptr && isdigit(*current))
-            {
-                has_digit = 1;
-                current++;
-            }
-        }
-        if (current < endptr && (*current == 'e' || *current == 'E'))
-        {
-            current++;
-            if (*current == '+' || *current == '-')
-            {
-                current++;
-            }
-            while (current < endptr && isdigit(*current))
-            {
-                has_digit = 1;
-                current++;
-            }
-        }
+        return NULL;
+    }
+    p->parse_fn = epc_alphanum_parse_fn;
 
-        // A valid double must contain at least one digit
-        if (has_digit)
-        {
-            is_valid_double = 1;
-        }
-        else if (parsed_len == 1 && (input[0] == '.' || input[0] == '+' || input[0] == '-'))
-        {
-            // Cases like ".", "+", "-" are not valid doubles on their own
-            is_valid_double = 0;
-        }
-        else if (parsed_len == 2 && ((input[0] == '+' || input[0] == '-') && input[1] == '.'))
-        {
-            // Cases like "+." or "-."
-            is_valid_double = 0;
-        }
+    return p;
+}
 
-        // Final check to ensure strtod actually consumed numeric characters, not just a sign or decimal point
-        // If endptr is the same as input, no number was parsed.
-        // Also, if the only thing parsed was a '.', then it's not a valid number.
-        if (endptr == input
-            || (*input == '.' && parsed_len == 1)
-            || (parsed_len == 1 && (*input == '+' || input[0] == '-'))
-        )
-        {
-            is_valid_double = 0;
-        }
+epc_parse_result_t
+epc_double_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    if (input == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "Input is NULL", "double", "NULL");
     }
 
+    double value;
+    size_t parsed_len = scan_double(input, &value);
 
-    if (is_valid_double)
+    if (parsed_len > 0)
     {
         epc_cpt_node_t * node = epc_node_alloc(self, "double");
         if (node == NULL)
@@ -874,23 +1381,21 @@ pdouble_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char
 
         node->content = input;
         node->len = parsed_len;
+        node->value_type = EPC_CPT_VALUE_DOUBLE;
+        node->value.double_value = value;
 
         return epc_parser_success_result(node);
     }
 
     // else Mismatch or invalid double format
     char found_str_buf[32] = ""; // Buffer to hold a snippet of what was found
-    snprintf(found_str_buf, sizeof(found_str_buf), "%.*s", (int)parsed_len > 30 ? 30 : (int)parsed_len, input);
-    if (parsed_len == 0) // If nothing was parsed, indicate what was at the current position
+    if (*input)
     {
-        if (*input)
-        {
-            snprintf(found_str_buf, sizeof(found_str_buf), "%.*s", 1, input);
-        }
-        else
-        {
-            strcpy(found_str_buf, "EOF");
-        }
+        snprintf(found_str_buf, sizeof(found_str_buf), "%.*s", 1, input);
+    }
+    else
+    {
+        strcpy(found_str_buf, "EOF");
     }
 
     return epc_parser_error_result(ctx, input, "Expected a double", "double", found_str_buf);
@@ -904,61 +1409,99 @@ epc_double(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = pdouble_parse_fn;
+    p->parse_fn = epc_double_parse_fn;
     p->expected_value = "double";
 
     return p;
 }
 
-static epc_parse_result_t
-por_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+static bool
+first_set_contains(epc_first_set_t const * set, unsigned char c)
 {
-    epc_parser_error_t * original_furthest_error = NULL;
-    parser_list_t * alternatives = self->data.parser_list;
+    return (set->bits[c / 8] & (1u << (c % 8))) != 0;
+}
+
+epc_parse_result_t
+epc_or_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    epc_parser_list_data_t * alternatives = self->data.parser_list;
 
     if (alternatives == NULL || alternatives->count == 0)
     {
         return epc_parser_error_result(ctx, input, "No alternatives provided to 'or' parser", self->name, "N/A");
     }
 
-    original_furthest_error = parser_furthest_error_copy(ctx);
+    alternative_scope_t scope = {
+        .committed = false,
+        .saved_furthest_error = parser_furthest_error_copy(ctx),
+    };
+    alternative_scope_t * outer_scope = ctx->alternative_scope;
+    epc_alternative_counts_t * counts = NULL;
+    if (ctx->alternative_profile != NULL)
+    {
+        counts = epc_alternative_profile_counts(ctx->alternative_profile, self, alternatives->count);
+    }
 
     for (int i = 0; i < alternatives->count; ++i)
     {
         epc_parser_t * current_parser = alternatives->parsers[i];
+        if (alternatives->first != NULL && !first_set_contains(&alternatives->first[i], (unsigned char)*input))
+        {
+            continue;
+        }
         if (current_parser)
         {
+            if (counts != NULL)
+            {
+                counts->tried[i]++;
+            }
+            ctx->alternative_scope = &scope;
             epc_parse_result_t child_result = parse(current_parser, ctx, input);
+            ctx->alternative_scope = outer_scope;
+
             if (!child_result.is_error)
             {
+                if (counts != NULL)
+                {
+                    counts->matched[i]++;
+                }
                 // Return the child's success, but mark the CPT node with this 'or' parser
                 epc_cpt_node_t * or_node = epc_node_alloc(self, "or");
                 if (or_node == NULL)
                 {
                     epc_parser_result_cleanup(&child_result);
-                    epc_parser_error_free(original_furthest_error);
+                    epc_parser_error_free(scope.saved_furthest_error);
 
                     return epc_parser_error_result(ctx, input, "Memory allocation error", self->name, "N/A");
                 }
 
                 or_node->content = child_result.data.success->content;
                 or_node->len = child_result.data.success->len;
-                or_node->children = calloc(1, sizeof(*or_node->children));
+                or_node->children = epc_children_alloc(1);
                 if (or_node->children == NULL)
                 {
                     epc_parser_result_cleanup(&child_result);
-                    epc_parser_error_free(original_furthest_error);
+                    epc_parser_error_free(scope.saved_furthest_error);
 
                     return epc_parser_error_result(ctx, input, "Memory allocation error", self->name, "N/A");
                 }
 
                 or_node->children[0] = child_result.data.success;
                 or_node->children_count = 1;
+                or_node->alternative_index = i;
 
-                parser_furthest_error_restore(ctx, &original_furthest_error);
+                if (!scope.committed)
+                {
+                    parser_furthest_error_restore(ctx, &scope.saved_furthest_error);
+                }
 
                 return epc_parser_success_result(or_node);
             }
+            else if (scope.committed)
+            {
+                /* A cut was passed, so this alternative's error is the 'or' parser's error. */
+                return child_result;
+            }
             else
             {
                 epc_parser_result_cleanup(&child_result);
@@ -967,7 +1510,7 @@ por_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * in
     }
 
     /* No alternatives matched if we get here. */
-    epc_parser_error_free(original_furthest_error);
+    epc_parser_error_free(scope.saved_furthest_error);
 
     size_t estimated_len = 0;
     for (int i = 0; i < alternatives->count; ++i)
@@ -1016,29 +1559,80 @@ por_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * in
         expected_str = self->name;
     }
 
+    char found_buffer[FOUND_BUFFER_SIZE];
+    snprintf(found_buffer, sizeof(found_buffer), "%.*s", (int)sizeof(found_buffer) - 1, (input && *input) ? input : "EOF");
     epc_parse_result_t result = epc_parser_error_result(
-        ctx, input, "No alternative matched", expected_str, (input && *input) ? input : "EOF" );
+        ctx, input, "No alternative matched", expected_str, found_buffer);
     free(aggregated_expected_str);
 
     return result;
 }
 
+// Creates an epc_or, which takes ownership of the list of alternatives.
 static epc_parser_t *
-vepc_or(char const * name, int count, va_list args)
+or_parser_create(char const * name, epc_parser_list_data_t * alternatives)
 {
     epc_parser_t * p = epc_parser_allocate(name != NULL ? name : "or_parser");
     if (p == NULL)
     {
+        parser_list_free(alternatives);
         return NULL;
     }
-    p->data.parser_list = parser_list_create_v(count, args);
-    p->data.data_type = PARSER_DATA_TYPE_PARSER_LIST;
+    p->data.parser_list = alternatives;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST;
+
+    p->parse_fn = epc_or_parse_fn;
+
+    return p;
+}
+
+static epc_parser_t *
+or_first_parser_create(char const * name, epc_first_set_t const * first, int count, epc_parser_list_data_t * alternatives)
+{
+    epc_parser_t * p = or_parser_create(name, alternatives);
+    if (p == NULL || first == NULL || p->data.parser_list == NULL)
+    {
+        return p;
+    }
 
-    p->parse_fn = por_parse_fn;
+    epc_first_set_t * copy = malloc(count * sizeof(*copy));
+    if (copy == NULL)
+    {
+        epc_parser_free(p);
+        return NULL;
+    }
+    memcpy(copy, first, count * sizeof(*copy));
+    p->data.parser_list->first = copy;
 
     return p;
 }
 
+static epc_parser_t *
+vepc_or(char const * name, int count, va_list args)
+{
+    return or_parser_create(name, parser_list_create_v(count, args));
+}
+
+static epc_parser_t *
+vepc_or_first(char const * name, epc_first_set_t const * first, int count, va_list args)
+{
+    return or_first_parser_create(name, first, count, parser_list_create_v(count, args));
+}
+
+EASY_PC_HIDDEN
+epc_parser_t *
+epc_or_a(char const * name, int count, epc_parser_t * const * parsers)
+{
+    return or_parser_create(name, parser_list_create_a(count, parsers));
+}
+
+EASY_PC_HIDDEN
+epc_parser_t *
+epc_or_first_a(char const * name, epc_first_set_t const * first, int count, epc_parser_t * const * parsers)
+{
+    return or_first_parser_create(name, first, count, parser_list_create_a(count, parsers));
+}
+
 epc_parser_t *
 epc_or(char const * name, int count, ...)
 {
@@ -1064,10 +1658,204 @@ epc_or_l(epc_parser_list * list, char const * name, int count, ...)
     return p;
 }
 
-static epc_parse_result_t
-pand_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parser_t *
+epc_or_first(char const * name, epc_first_set_t const * first, int count, ...)
+{
+    va_list args;
+
+    va_start(args, count);
+    epc_parser_t * p = vepc_or_first(name, first, count, args);
+    va_end(args);
+
+    return p;
+}
+
+epc_parser_t *
+epc_or_first_l(epc_parser_list * list, char const * name, epc_first_set_t const * first, int count, ...)
+{
+    va_list args;
+
+    va_start(args, count);
+    epc_parser_t * p = vepc_or_first(name, first, count, args);
+    va_end(args);
+
+    epc_parser_list_add(list, p);
+    return p;
+}
+
+epc_parse_result_t
+epc_keywords_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    epc_keywords_data_t * data = self->data.keywords;
+
+    if (data == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "No keywords provided to 'keywords' parser", self->name, "N/A");
+    }
+
+    if (input == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "Input is NULL", data->expected, "NULL");
+    }
+
+    /* Walk the trie, remembering the longest keyword seen so far. */
+    epc_keyword_trie_node_t const * nodes = data->nodes;
+    int matched_index = nodes[0].keyword_index;
+    size_t matched_len = 0;
+    int current = 0;
+
+    for (size_t i = 0; input[i] != '\0'; i++)
+    {
+        unsigned char c = (unsigned char)input[i];
+        int child = nodes[current].first_child;
+
+        while (child >= 0 && nodes[child].c < c)
+        {
+            child = nodes[child].next_sibling;
+        }
+        if (child < 0 || nodes[child].c != c)
+        {
+            break;
+        }
+        current = child;
+        if (nodes[current].keyword_index >= 0)
+        {
+            matched_index = nodes[current].keyword_index;
+            matched_len = i + 1;
+        }
+    }
+
+    if (matched_index >= 0)
+    {
+        epc_cpt_node_t * node = epc_node_alloc(self, "keywords");
+        if (node == NULL)
+        {
+            return epc_parser_error_result(ctx, input, "Memory allocation error", self->name, "N/A");
+        }
+
+        node->content = input;
+        node->len = matched_len;
+        node->alternative_index = matched_index;
+
+        return epc_parser_success_result(node);
+    }
+
+    if (input[0] == '\0')
+    {
+        return epc_parser_error_result(ctx, input, "Unexpected end of input", data->expected, "EOF");
+    }
+
+    char found_buffer[FOUND_BUFFER_SIZE];
+    snprintf(found_buffer, sizeof(found_buffer), "%.*s", (int)sizeof(found_buffer) - 1, input);
+
+    return epc_parser_error_result(ctx, input, "No keyword matched", data->expected, found_buffer);
+}
+
+epc_parser_t *
+epc_keywords(char const * name, char const * const * keywords, int count)
+{
+    epc_keywords_data_t * data = keywords_data_create(keywords, count);
+    if (data == NULL)
+    {
+        return NULL;
+    }
+
+    epc_parser_t * p = epc_parser_allocate(name != NULL ? name : "keywords_parser");
+    if (p == NULL)
+    {
+        keywords_data_free(data);
+        return NULL;
+    }
+    p->parse_fn = epc_keywords_parse_fn;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_KEYWORDS;
+    p->data.keywords = data;
+
+    return p;
+}
+
+epc_parse_result_t
+epc_dfa_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    epc_dfa_t const * dfa = self->data.dfa;
+
+    if (dfa == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "No automaton provided to 'dfa' parser", self->name, "N/A");
+    }
+
+    if (input == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "Input is NULL", self->name, "NULL");
+    }
+
+    /* Run the automaton, remembering the last accepting state seen. */
+    unsigned state = (unsigned)dfa->start;
+    bool matched = dfa->accepting[state] != 0;
+    size_t matched_len = 0;
+
+    for (size_t i = 0; input[i] != '\0'; i++)
+    {
+        state = dfa->transitions[state * (unsigned)dfa->class_count + dfa->classes[(unsigned char)input[i]]];
+        if (state == 0)
+        {
+            break;
+        }
+        if (dfa->accepting[state])
+        {
+            matched = true;
+            matched_len = i + 1;
+        }
+    }
+
+    if (matched)
+    {
+        epc_cpt_node_t * node = epc_node_alloc(self, "dfa");
+        if (node == NULL)
+        {
+            return epc_parser_error_result(ctx, input, "Memory allocation error", self->name, "N/A");
+        }
+
+        node->content = input;
+        node->len = matched_len;
+
+        return epc_parser_success_result(node);
+    }
+
+    if (input[0] == '\0')
+    {
+        return epc_parser_error_result(ctx, input, "Unexpected end of input", self->name, "EOF");
+    }
+
+    char found_buffer[FOUND_BUFFER_SIZE];
+    snprintf(found_buffer, sizeof(found_buffer), "%.*s", (int)sizeof(found_buffer) - 1, input);
+
+    return epc_parser_error_result(ctx, input, "Unexpected input", self->name, found_buffer);
+}
+
+epc_parser_t *
+epc_dfa(char const * name, epc_dfa_t const * dfa)
+{
+    if (dfa == NULL)
+    {
+        return NULL;
+    }
+
+    epc_parser_t * p = epc_parser_allocate(name != NULL ? name : "dfa_parser");
+    if (p == NULL)
+    {
+        return NULL;
+    }
+    p->parse_fn = epc_dfa_parse_fn;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_DFA;
+    p->data.dfa = dfa;
+
+    return p;
+}
+
+epc_parse_result_t
+epc_and_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
-    parser_list_t * sequence = self->data.parser_list;
+    epc_parser_list_data_t * sequence = self->data.parser_list;
 
     if (sequence == NULL || sequence->count == 0)
     {
@@ -1075,7 +1863,7 @@ pand_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * i
     }
 
     const char * current_input = input;
-    epc_cpt_node_t ** children_nodes = calloc(sequence->count, sizeof(*children_nodes));
+    epc_cpt_node_t ** children_nodes = epc_children_alloc(sequence->count);
 
     if (children_nodes == NULL)
     {
@@ -1116,6 +1904,7 @@ pand_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * i
             epc_node_free(children_nodes[i]);
         }
         free(children_nodes);
+        epc_stats_freed(1);
     }
 
     if (null_child_result.is_error)
@@ -1147,22 +1936,37 @@ pand_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * i
     return epc_parser_success_result(parent_node);
 }
 
+// Creates an epc_and, which takes ownership of the list of parsers.
 static epc_parser_t *
-vepc_and(char const * name, int count, va_list args)
+and_parser_create(char const * name, epc_parser_list_data_t * parsers)
 {
     epc_parser_t * p = epc_parser_allocate(name != NULL ? name : "and_parser");
     if (p == NULL)
     {
+        parser_list_free(parsers);
         return NULL;
     }
-    p->data.parser_list = parser_list_create_v(count, args);
-    p->data.data_type = PARSER_DATA_TYPE_PARSER_LIST;
+    p->data.parser_list = parsers;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST;
 
-    p->parse_fn = pand_parse_fn;
+    p->parse_fn = epc_and_parse_fn;
 
     return p;
 }
 
+static epc_parser_t *
+vepc_and(char const * name, int count, va_list args)
+{
+    return and_parser_create(name, parser_list_create_v(count, args));
+}
+
+EASY_PC_HIDDEN
+epc_parser_t *
+epc_and_a(char const * name, int count, epc_parser_t * const * parsers)
+{
+    return and_parser_create(name, parser_list_create_a(count, parsers));
+}
+
 epc_parser_t *
 epc_and(char const * name, int count, ...)
 {
@@ -1188,8 +1992,8 @@ epc_and_l(epc_parser_list * list, char const * name, int count, ...)
     return p;
 }
 
-static epc_parse_result_t
-pskip_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_skip_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_parser_t * parser_to_skip = (epc_parser_t *)self->data.other;
     if (parser_to_skip == NULL)
@@ -1203,7 +2007,7 @@ pskip_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char *
     while (1)
     {
         epc_parser_error_t * original_furthest_error = parser_furthest_error_copy(ctx);
-        epc_parse_result_t child_result = parse(parser_to_skip, ctx, current_input);
+        epc_parse_result_t child_result = parse_uncommitted(parser_to_skip, ctx, current_input);
         if (child_result.is_error)
         {
             parser_furthest_error_restore(ctx, &original_furthest_error);
@@ -1247,14 +2051,14 @@ epc_skip(char const * name, epc_parser_t * parser_to_skip)
     {
         return NULL;
     }
-    p->parse_fn = pskip_parse_fn;
+    p->parse_fn = epc_skip_parse_fn;
     p->data.other = parser_to_skip;
 
     return p;
 }
 
-static epc_parse_result_t
-pplus_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_plus_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_parser_t * parser_to_repeat = (epc_parser_t *)self->data.other;
     if (parser_to_repeat == NULL)
@@ -1289,7 +2093,7 @@ pplus_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char *
     while (!infinite_recursion_detected)
     {
         char const * loop_start_input = current_input;
-        epc_parse_result_t child_result = parse(parser_to_repeat, ctx, current_input);
+        epc_parse_result_t child_result = parse_uncommitted(parser_to_repeat, ctx, current_input);
         if (!child_result.is_error)
         {
             if (!child_list_append(&children, child_result.data.success))
@@ -1341,14 +2145,14 @@ epc_plus(char const * name, epc_parser_t * parser_to_repeat)
     {
         return NULL;
     }
-    p->parse_fn = pplus_parse_fn;
+    p->parse_fn = epc_plus_parse_fn;
     p->data.other = parser_to_repeat;
 
     return p;
 }
 
-static epc_parse_result_t
-ppassthru_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_passthru_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_parser_t * child_parser = (epc_parser_t *)self->data.other;
     if (child_parser == NULL)
@@ -1367,16 +2171,16 @@ epc_passthru(char const * name, epc_parser_t * child_parser)
     {
         return NULL;
     }
-    p->parse_fn = ppassthru_parse_fn;
+    p->parse_fn = epc_passthru_parse_fn;
     p->data.other = child_parser;
 
     return p;
 }
 
-static epc_parse_result_t
-pchar_range_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_char_range_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
-    char_range_data_t * range = &self->data.range;
+    epc_char_range_data_t * range = &self->data.range;
 
     char expected_str[32]; // e.g., "character in range [a-z]"
     snprintf(expected_str, sizeof(expected_str), "character in range [%c-%c]", range->start, range->end);
@@ -1417,17 +2221,17 @@ epc_char_range(char const * name, char char_start, char char_end)
     {
         return NULL;
     }
-    p->parse_fn = pchar_range_parse_fn;
+    p->parse_fn = epc_char_range_parse_fn;
 
-    p->data.data_type = PARSER_DATA_TYPE_CHAR_RANGE;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_CHAR_RANGE;
     p->data.range.start = char_start;
     p->data.range.end = char_end;
 
     return p;
 }
 
-static epc_parse_result_t
-pany_char_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_any_char_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     if (input == NULL)
     {
@@ -1457,12 +2261,12 @@ epc_any_char(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = pany_char_parse_fn;
+    p->parse_fn = epc_any_char_parse_fn;
     return p;
 }
 
-static epc_parse_result_t
-pnone_of_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_none_of_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     const char * chars_to_avoid = self->data.string;
 
@@ -1503,21 +2307,21 @@ epc_none_of(char const * name, const char * chars_to_avoid)
     {
         return NULL;
     }
-    p->parse_fn = pnone_of_parse_fn;
+    p->parse_fn = epc_none_of_parse_fn;
     char * duplicated_chars = strdup(chars_to_avoid);
     if (duplicated_chars == NULL)
     {
         free(p);
         return NULL;
     }
-    p->data.data_type = PARSER_DATA_TYPE_STRING;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_STRING;
     p->data.string = duplicated_chars;
 
     return p;
 }
 
-static epc_parse_result_t
-pmany_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_many_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_parser_t * parser_to_repeat = (epc_parser_t *)self->data.other;
 
@@ -1539,7 +2343,7 @@ pmany_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char *
     while (!infinite_recursion_detected) // Loop as long as child parser matches
     {
         char const * loop_start_input = current_input;
-        epc_parse_result_t child_result = parse(parser_to_repeat, ctx, current_input);
+        epc_parse_result_t child_result = parse_uncommitted(parser_to_repeat, ctx, current_input);
         if (child_result.is_error)
         {
             /*
@@ -1593,16 +2397,16 @@ epc_many(char const * name, epc_parser_t * p_to_repeat)
     {
         return NULL;
     }
-    p->parse_fn = pmany_parse_fn;
+    p->parse_fn = epc_many_parse_fn;
     p->data.other = p_to_repeat;
 
     return p;
 }
 
-static epc_parse_result_t
-pcount_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_count_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
-    count_data_t * count_data = &self->data.count;
+    epc_count_data_t * count_data = &self->data.count;
     epc_parser_t * parser_to_repeat = count_data->parser;
     int num_to_match = count_data->count;
 
@@ -1638,6 +2442,7 @@ pcount_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char *
         if (child_result.is_error)
         {
             // Child parser failed to match required number of times
+            child_list_release(&children);
             return child_result; // Propagate the error
         }
         if (!child_list_append(&children, child_result.data.success))
@@ -1670,19 +2475,19 @@ epc_count(char const * name, int num, epc_parser_t * p_to_repeat)
     {
         return NULL;
     }
-    p->parse_fn = pcount_parse_fn;
+    p->parse_fn = epc_count_parse_fn;
 
-    p->data.data_type = PARSER_DATA_TYPE_COUNT;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_COUNT;
     p->data.count.count = num;
     p->data.count.parser = p_to_repeat;
     return p;
 }
 
-static epc_parse_result_t
-pbetween_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_between_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_parser_error_t * original_furthest_error = NULL;
-    between_data_t * between_data = &self->data.between;
+    epc_between_data_t * between_data = &self->data.between;
     epc_parser_t * p_open = between_data->open;
     epc_parser_t * p_wrapped = between_data->parser;
     epc_parser_t * p_close = between_data->close;
@@ -1739,7 +2544,7 @@ pbetween_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char
         return epc_parser_error_result(ctx, input, "Memory allocation failure for p_between parent node", self->name, "N/A");
     }
 
-    parent_node->children = calloc(1, sizeof(*parent_node->children));
+    parent_node->children = epc_children_alloc(1);
     if (parent_node->children == NULL)
     {
         epc_parser_result_cleanup(&wrapped_result);
@@ -1768,9 +2573,9 @@ epc_between(char const * name, epc_parser_t * p_open, epc_parser_t * p_wrapped,
     {
         return NULL;
     }
-    p->parse_fn = pbetween_parse_fn;
+    p->parse_fn = epc_between_parse_fn;
 
-    p->data.data_type = PARSER_DATA_TYPE_BETWEEN;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_BETWEEN;
     p->data.between.open = p_open;
     p->data.between.parser = p_wrapped;
     p->data.between.close = p_close;
@@ -1778,10 +2583,10 @@ epc_between(char const * name, epc_parser_t * p_open, epc_parser_t * p_wrapped,
     return p;
 }
 
-static epc_parse_result_t
-pdelimited_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_delimited_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
-    delimited_data_t * delimited_data = &self->data.delimited;
+    epc_delimited_data_t * delimited_data = &self->data.delimited;
     epc_parser_t * item_parser = delimited_data->item;
     epc_parser_t * delimiter_parser = delimited_data->delimiter;
 
@@ -1824,7 +2629,7 @@ pdelimited_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const ch
         if (delimiter_parser != NULL)
         {
             epc_parser_error_t * original_furthest_error = parser_furthest_error_copy(ctx);
-            epc_parse_result_t delim_result = parse(delimiter_parser, ctx, current_input);
+            epc_parse_result_t delim_result = parse_uncommitted(delimiter_parser, ctx, current_input);
 
             if (delim_result.is_error)
             {
@@ -1838,7 +2643,8 @@ pdelimited_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const ch
             epc_parser_result_cleanup(&delim_result);
         }
         epc_parser_error_t * original_furthest_error = parser_furthest_error_copy(ctx);
-        epc_parse_result_t item_result = parse(item_parser, ctx, current_input);
+        // Only the first item can commit an enclosing alternative, as with epc_plus().
+        epc_parse_result_t item_result = parse_uncommitted(item_parser, ctx, current_input);
         if (item_result.is_error)
         {
             if (delimiter_parser != NULL)
@@ -1907,17 +2713,17 @@ epc_delimited(char const * name, epc_parser_t * item_parser, epc_parser_t * deli
     {
         return NULL;
     }
-    p->parse_fn = pdelimited_parse_fn;
+    p->parse_fn = epc_delimited_parse_fn;
 
-    p->data.data_type = PARSER_DATA_TYPE_DELIMITED;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_DELIMITED;
     p->data.delimited.item = item_parser;
     p->data.delimited.delimiter = delimiter_parser;
 
     return p;
 }
 
-static epc_parse_result_t
-poptional_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_optional_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_parser_error_t * original_furthest_error = NULL;
     epc_parser_t * child_parser = (epc_parser_t *)self->data.other;
@@ -1928,7 +2734,7 @@ poptional_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const cha
     }
 
     original_furthest_error = parser_furthest_error_copy(ctx); // Save before child parse
-    epc_parse_result_t child_result = parse(child_parser, ctx, input);
+    epc_parse_result_t child_result = parse_uncommitted(child_parser, ctx, input);
 
     if (!child_result.is_error)
     {
@@ -1940,7 +2746,7 @@ poptional_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const cha
             epc_parser_error_free(original_furthest_error);
             return epc_parser_error_result(ctx, input, "Memory allocation failure for optional parent node", self->name, "N/A");
         }
-        parent_node->children = calloc(1, sizeof(*parent_node->children));
+        parent_node->children = epc_children_alloc(1);
         if (parent_node->children == NULL)
         {
             epc_parser_result_cleanup(&child_result);
@@ -1981,13 +2787,13 @@ epc_optional(char const * name, epc_parser_t * p_to_make_optional)
     {
         return NULL;
     }
-    p->parse_fn = poptional_parse_fn;
+    p->parse_fn = epc_optional_parse_fn;
     p->data.other = p_to_make_optional;
     return p;
 }
 
-static epc_parse_result_t
-plookahead_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_lookahead_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_parser_t * child_parser = self->data.other;
 
@@ -1997,7 +2803,7 @@ plookahead_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const ch
     }
 
     epc_parser_error_t * original_furthest_error = parser_furthest_error_copy(ctx);
-    epc_parse_result_t child_result = parse(child_parser, ctx, input);
+    epc_parse_result_t child_result = parse_uncommitted(child_parser, ctx, input);
 
     parser_furthest_error_restore(ctx, &original_furthest_error);
 
@@ -2031,13 +2837,13 @@ epc_lookahead(char const * name, epc_parser_t * p_to_lookahead)
     {
         return NULL;
     }
-    p->parse_fn = plookahead_parse_fn;
+    p->parse_fn = epc_lookahead_parse_fn;
     p->data.other = p_to_lookahead;
     return p;
 }
 
-static epc_parse_result_t
-pnot_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_not_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_parser_t * child_parser = (epc_parser_t *)self->data.other;
 
@@ -2047,7 +2853,7 @@ pnot_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * i
     }
 
     epc_parser_error_t * original_furthest_error = parser_furthest_error_copy(ctx); // Save before child parse
-    epc_parse_result_t child_result = parse(child_parser, ctx, input);
+    epc_parse_result_t child_result = parse_uncommitted(child_parser, ctx, input);
 
     parser_furthest_error_restore(ctx, &original_furthest_error);
 
@@ -2073,8 +2879,11 @@ pnot_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * i
     char expected_str[64];
     snprintf(expected_str, sizeof(expected_str), "not %s", parser_get_expected_str(ctx, child_parser));
 
+    char found_buffer[FOUND_BUFFER_SIZE];
+    snprintf(found_buffer, sizeof(found_buffer), "%.*s", (int)sizeof(found_buffer) - 1, child_result.data.success->content);
+
     epc_parse_result_t result =
-        epc_parser_error_result(ctx, input, "Parser unexpectedly matched", expected_str, child_result.data.success->content);
+        epc_parser_error_result(ctx, input, "Parser unexpectedly matched", expected_str, found_buffer);
     epc_parser_result_cleanup(&child_result);
     return result;
 }
@@ -2087,17 +2896,19 @@ epc_not(char const * name, epc_parser_t * p_to_not_match)
     {
         return NULL;
     }
-    p->parse_fn = pnot_parse_fn;
+    p->parse_fn = epc_not_parse_fn;
     p->data.other = p_to_not_match;
     return p;
 }
 
-static epc_parse_result_t
-pfail_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_fail_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     const char * failure_message = self->data.string;
+    char found_buffer[FOUND_BUFFER_SIZE];
+    snprintf(found_buffer, sizeof(found_buffer), "%.*s", (int)sizeof(found_buffer) - 1, (input && *input) ? input : "EOF");
 
-    return epc_parser_error_result(ctx, input, failure_message, self->name ? self->name : "fail_parser", (input && *input) ? input : "EOF");
+    return epc_parser_error_result(ctx, input, failure_message, self->name ? self->name : "fail_parser", found_buffer);
 }
 
 EASY_PC_API epc_parser_t *
@@ -2108,20 +2919,20 @@ epc_fail(char const * name, const char * message)
     {
         return NULL;
     }
-    p->parse_fn = pfail_parse_fn;
+    p->parse_fn = epc_fail_parse_fn;
     char * duplicated_message = strdup(message);
     if (duplicated_message == NULL)
     {
         free(p);
         return NULL;
     }
-    p->data.data_type = PARSER_DATA_TYPE_STRING;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_STRING;
     p->data.string = duplicated_message;
     return p;
 }
 
-static epc_parse_result_t
-psucceed_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_succeed_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     epc_cpt_node_t * node = epc_node_alloc(self, "succeed");
     if (node == NULL)
@@ -2143,13 +2954,53 @@ epc_succeed(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = psucceed_parse_fn;
+    p->parse_fn = epc_succeed_parse_fn;
 
     return p;
 }
 
-static epc_parse_result_t
-phex_digit_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_cut_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    alternative_scope_t * scope = ctx->alternative_scope;
+
+    if (scope != NULL && !scope->committed)
+    {
+        /*
+         * The enclosing 'or' won't backtrack into its other alternatives now,
+         * so the errors they left behind can be dropped.
+         */
+        scope->committed = true;
+        parser_furthest_error_restore(ctx, &scope->saved_furthest_error);
+    }
+
+    epc_cpt_node_t * node = epc_node_alloc(self, "cut");
+    if (node == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "Memory allocation failure for cut node", self->name, "N/A");
+    }
+
+    node->content = input;
+    node->len = 0;
+
+    return epc_parser_success_result(node);
+}
+
+EASY_PC_API epc_parser_t *
+epc_cut(char const * name)
+{
+    epc_parser_t * p = epc_parser_allocate(name != NULL ? name : "cut_parser");
+    if (p == NULL)
+    {
+        return NULL;
+    }
+    p->parse_fn = epc_cut_parse_fn;
+
+    return p;
+}
+
+epc_parse_result_t
+epc_hex_digit_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     if (input == NULL)
     {
@@ -2188,14 +3039,14 @@ epc_hex_digit(char const * name)
     {
         return NULL;
     }
-    p->parse_fn = phex_digit_parse_fn;
+    p->parse_fn = epc_hex_digit_parse_fn;
     p->expected_value = "hex_digit";
 
     return p;
 }
 
-static epc_parse_result_t
-pone_of_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_one_of_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
     const char * chars_to_match = self->data.string;
 
@@ -2236,14 +3087,14 @@ epc_one_of(char const * name, const char * chars_to_match)
     {
         return NULL;
     }
-    p->parse_fn = pone_of_parse_fn;
+    p->parse_fn = epc_one_of_parse_fn;
     char * duplicated_chars = strdup(chars_to_match);
     if (duplicated_chars == NULL)
     {
         free(p);
         return NULL;
     }
-    p->data.data_type = PARSER_DATA_TYPE_STRING;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_STRING;
     p->data.string = duplicated_chars;
 
     return p;
@@ -2288,10 +3139,10 @@ consume_whitespace(const char *input, bool consume_comments)
     return len;
 }
 
-static epc_parse_result_t
-plexeme_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_lexeme_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
-    lexeme_data_t * data = &self->data.lexeme;
+    epc_lexeme_data_t * data = &self->data.lexeme;
     epc_parser_t * child_parser = data->parser;
     bool consume_comments = data->consume_comments;
 
@@ -2330,7 +3181,7 @@ plexeme_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char
         return epc_parser_error_result(ctx, lexeme_start_input, "Memory allocation failure for lexeme parent node", self->name, "N/A");
     }
 
-    parent_node->children = calloc(1, sizeof(*parent_node->children));
+    parent_node->children = epc_children_alloc(1);
     if (parent_node->children == NULL)
     {
         epc_parser_result_cleanup(&item_result);
@@ -2361,18 +3212,18 @@ epc_lexeme(char const * name, epc_parser_t * p)
     {
         return NULL;
     }
-    lex->parse_fn = plexeme_parse_fn;
-    lex->data.data_type = PARSER_DATA_TYPE_LEXEME;
+    lex->parse_fn = epc_lexeme_parse_fn;
+    lex->data.data_type = EPC_PARSER_DATA_TYPE_LEXEME;
     lex->data.lexeme.parser = p;
     lex->data.lexeme.consume_comments = true;
 
     return lex;
 }
 
-static epc_parse_result_t
-pchainl1_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_chainl1_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
-    delimited_data_t * chain_data = &self->data.delimited;
+    epc_delimited_data_t * chain_data = &self->data.delimited;
     epc_parser_t * item_parser = chain_data->item;
     epc_parser_t * op_parser = chain_data->delimiter;
 
@@ -2398,7 +3249,7 @@ pchainl1_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char
     while (1)
     {
         epc_parser_error_t * loop_furthest_error = parser_furthest_error_copy(ctx); // Save for loop iteration
-        epc_parse_result_t op_result = parse(op_parser, ctx, current_input);
+        epc_parse_result_t op_result = parse_uncommitted(op_parser, ctx, current_input);
         if (op_result.is_error)
         {
             epc_parser_result_cleanup(&op_result);
@@ -2429,7 +3280,7 @@ pchainl1_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char
             return epc_parser_error_result(ctx, input, "Memory allocation failure for chainl1 node", self->name, "N/A");
         }
 
-        new_parent_node->children = calloc(3, sizeof(*new_parent_node->children));
+        new_parent_node->children = epc_children_alloc(3);
         if (new_parent_node->children == NULL)
         {
             epc_parser_result_cleanup(&op_result);
@@ -2467,8 +3318,8 @@ epc_chainl1(char const * name, epc_parser_t * item_parser, epc_parser_t * op_par
     {
         return NULL;
     }
-    p->parse_fn = pchainl1_parse_fn;
-    p->data.data_type = PARSER_DATA_TYPE_DELIMITED; // Reusing this for item/op
+    p->parse_fn = epc_chainl1_parse_fn;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_DELIMITED; // Reusing this for item/op
     p->data.delimited.item = item_parser;
     p->data.delimited.delimiter = op_parser;
 
@@ -2480,10 +3331,10 @@ typedef struct {
     epc_cpt_node_t *item_node;
 } op_item_pair_t;
 
-static epc_parse_result_t
-pchainr1_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+epc_parse_result_t
+epc_chainr1_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
 {
-    delimited_data_t * chain_data = &self->data.delimited;
+    epc_delimited_data_t * chain_data = &self->data.delimited;
     epc_parser_t * item_parser = chain_data->item;
     epc_parser_t * op_parser = chain_data->delimiter;
 
@@ -2519,7 +3370,7 @@ pchainr1_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char
     while (1)
     {
         epc_parser_error_t * loop_furthest_error = parser_furthest_error_copy(ctx); // Save for loop iteration
-        epc_parse_result_t op_result = parse(op_parser, ctx, current_input);
+        epc_parse_result_t op_result = parse_uncommitted(op_parser, ctx, current_input);
         if (op_result.is_error)
         {
             epc_parser_result_cleanup(&op_result);
@@ -2604,7 +3455,7 @@ pchainr1_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char
             }
             epc_cpt_node_t * operator_node = pairs[i].op_node;
 
-            new_parent_node->children = calloc(3, sizeof(*new_parent_node->children));
+            new_parent_node->children = epc_children_alloc(3);
             if (new_parent_node->children == NULL) {
                 epc_node_free(current_right_operand);
                 epc_node_free(left_operand_node);
@@ -2653,19 +3504,338 @@ epc_chainr1(char const * name, epc_parser_t * item_parser, epc_parser_t * op_par
     {
         return NULL;
     }
-    p->parse_fn = pchainr1_parse_fn;
-    p->data.data_type = PARSER_DATA_TYPE_DELIMITED; // Reusing for item/op
+    p->parse_fn = epc_chainr1_parse_fn;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_DELIMITED; // Reusing for item/op
     p->data.delimited.item = item_parser;
     p->data.delimited.delimiter = op_parser;
 
     return p;
 }
 
+/*
+ * Tries the prefix operators, or the other operators, that bind at least as
+ * tightly as min_precedence, in table order.
+ * Returns the node of the first one to match, or NULL, in which case any
+ * errors recorded while trying them are discarded.
+ */
+static epc_cpt_node_t *
+operator_table_match_operator(
+    epc_operator_table_data_t const * data,
+    epc_parser_ctx_t * ctx,
+    const char * input,
+    bool prefix,
+    int min_precedence,
+    int * matched_index
+)
+{
+    epc_parser_error_t * original_furthest_error = parser_furthest_error_copy(ctx);
+
+    for (int i = 0; i < data->count; i++)
+    {
+        epc_operator_t const * operator = &data->operators[i];
+
+        if ((operator->kind == EPC_OPERATOR_PREFIX) != prefix
+            || operator->precedence < min_precedence
+            || operator->op == NULL)
+        {
+            continue;
+        }
+
+        epc_parse_result_t op_result = parse(operator->op, ctx, input);
+        if (!op_result.is_error)
+        {
+            epc_parser_error_free(original_furthest_error);
+            *matched_index = i;
+            return op_result.data.success;
+        }
+        epc_parser_result_cleanup(&op_result);
+    }
+
+    parser_furthest_error_restore(ctx, &original_furthest_error);
+
+    return NULL;
+}
+
+static epc_parse_result_t
+operator_table_combine(
+    epc_parser_t * self,
+    epc_parser_ctx_t * ctx,
+    char const * tag,
+    int operator_index,
+    epc_cpt_node_t * * children,
+    int count
+)
+{
+    epc_cpt_node_t * node = epc_node_alloc(self, tag);
+    if (node != NULL)
+    {
+        node->children = epc_children_alloc(count);
+    }
+    if (node == NULL || node->children == NULL)
+    {
+        char const * input = children[0]->content;
+
+        epc_node_free(node);
+        for (int i = 0; i < count; i++)
+        {
+            epc_node_free(children[i]);
+        }
+        return epc_parser_error_result(ctx, input, "Memory allocation failure for operator table node", self->name, "N/A");
+    }
+
+    memcpy(node->children, children, count * sizeof(*children));
+    node->children_count = count;
+    node->content = children[0]->content;
+    node->len = (children[count - 1]->content + children[count - 1]->len) - node->content;
+    node->alternative_index = operator_index;
+
+    return epc_parser_success_result(node);
+}
+
+/*
+ * Parses an expression in which every operator applied after the first
+ * operand binds at least as tightly as min_precedence.
+ */
+static epc_parse_result_t
+operator_table_parse_expression(
+    epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input, int min_precedence)
+{
+    epc_operator_table_data_t const * data = self->data.operator_table;
+    epc_parse_result_t left_result;
+    int operator_index;
+
+    epc_cpt_node_t * prefix_node = operator_table_match_operator(
+        data, ctx, input, true, INT_MIN, &operator_index);
+    if (prefix_node != NULL)
+    {
+        int precedence = data->operators[operator_index].precedence;
+        epc_parse_result_t operand_result =
+            operator_table_parse_expression(self, ctx, input + prefix_node->len, precedence);
+        if (operand_result.is_error)
+        {
+            epc_node_free(prefix_node);
+            return operand_result;
+        }
+        epc_cpt_node_t * children[] = { prefix_node, operand_result.data.success };
+        left_result = operator_table_combine(self, ctx, "prefix_expression", operator_index, children, 2);
+    }
+    else
+    {
+        left_result = parse(data->operand, ctx, input);
+    }
+
+    while (!left_result.is_error)
+    {
+        epc_cpt_node_t * left = left_result.data.success;
+        const char * current_input = left->content + left->len;
+
+        epc_cpt_node_t * op_node = operator_table_match_operator(
+            data, ctx, current_input, false, min_precedence, &operator_index);
+        if (op_node == NULL)
+        {
+            break;
+        }
+
+        epc_operator_t const * operator = &data->operators[operator_index];
+        if (operator->kind == EPC_OPERATOR_POSTFIX)
+        {
+            epc_cpt_node_t * children[] = { left, op_node };
+            left_result = operator_table_combine(self, ctx, "postfix_expression", operator_index, children, 2);
+            continue;
+        }
+
+        /* Operators of the same precedence only nest to the right if right-associative. */
+        int right_min_precedence =
+            operator->kind == EPC_OPERATOR_INFIX_LEFT ? operator->precedence + 1 : operator->precedence;
+        epc_parse_result_t right_result =
+            operator_table_parse_expression(self, ctx, current_input + op_node->len, right_min_precedence);
+        if (right_result.is_error)
+        {
+            epc_node_free(op_node);
+            epc_node_free(left);
+            return right_result;
+        }
+
+        epc_cpt_node_t * children[] = { left, op_node, right_result.data.success };
+        left_result = operator_table_combine(self, ctx, "infix_expression", operator_index, children, 3);
+    }
+
+    return left_result;
+}
+
+static epc_parse_result_t
+epc_operator_table_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    epc_operator_table_data_t const * data = self->data.operator_table;
+
+    if (data == NULL || data->operand == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "epc_operator_table received NULL operand parser", self->name, "NULL");
+    }
+
+    return operator_table_parse_expression(self, ctx, input, INT_MIN);
+}
+
+EASY_PC_API epc_parser_t *
+epc_operator_table(char const * name, epc_parser_t * operand, epc_operator_t const * operators, int count)
+{
+    epc_operator_table_data_t * data = operator_table_data_create(operand, operators, count);
+    if (data == NULL)
+    {
+        return NULL;
+    }
+
+    epc_parser_t * p = epc_parser_allocate(name != NULL ? name : "operator_table_parser");
+    if (p == NULL)
+    {
+        operator_table_data_free(data);
+        return NULL;
+    }
+    p->parse_fn = epc_operator_table_parse_fn;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_OPERATOR_TABLE;
+    p->data.operator_table = data;
+
+    return p;
+}
+
+// --- Direct parser support ---
+
+// Not epc_direct_parse_fn, which is the type of the function it calls.
+static epc_parse_result_t
+epc_direct_parser_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    epc_direct_data_t * data = &self->data.direct;
+
+    if (data->parse_fn == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "epc_direct received NULL parse function", self->name, "NULL");
+    }
+
+    return data->parse_fn(ctx, input, data->user_data);
+}
+
+EASY_PC_API epc_parser_t *
+epc_direct(char const * name, epc_direct_parse_fn parse_fn, void * user_data, void (*free_user_data)(void * user_data))
+{
+    epc_parser_t * p = epc_parser_allocate(name != NULL ? name : "direct_parser");
+    if (p == NULL)
+    {
+        return NULL;
+    }
+    p->parse_fn = epc_direct_parser_parse_fn;
+    p->data.data_type = EPC_PARSER_DATA_TYPE_DIRECT;
+    p->data.direct.parse_fn = parse_fn;
+    p->data.direct.user_data = user_data;
+    p->data.direct.free_user_data = free_user_data;
+
+    return p;
+}
+
+EASY_PC_API epc_parse_result_t
+epc_direct_parse(epc_parser_t * parser, epc_parser_ctx_t * ctx, const char * input)
+{
+    if (parser == NULL)
+    {
+        return epc_parser_error_result(ctx, input, "epc_direct_parse received NULL parser", "parser", "NULL");
+    }
+
+    return parse(parser, ctx, input);
+}
+
+EASY_PC_API epc_cpt_node_t *
+epc_direct_node_alloc(char const * tag, char const * name, const char * input)
+{
+    epc_cpt_node_t * node = epc_node_calloc();
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    node->tag = tag;
+    node->name = name;
+    node->content = input != NULL ? input : "";
+
+    return node;
+}
+
+EASY_PC_API bool
+epc_direct_node_add_child(epc_cpt_node_t * parent, epc_cpt_node_t * child)
+{
+    int count = parent->children_count;
+
+    /*
+     * The capacity isn't stored, so grow the array whenever the count reaches
+     * a power of two, starting from 4.
+     */
+    if (count == 0 || (count >= 4 && (count & (count - 1)) == 0))
+    {
+        size_t new_capacity = count == 0 ? 4 : (size_t)count * 2;
+        epc_cpt_node_t ** children = realloc(parent->children, new_capacity * sizeof(*children));
+        if (children == NULL)
+        {
+            return false;
+        }
+        epc_stats_allocated((new_capacity - count) * sizeof(*children), count == 0, true);
+        parent->children = children;
+    }
+    parent->children[parent->children_count++] = child;
+
+    return true;
+}
+
+EASY_PC_API void
+epc_direct_node_free(epc_cpt_node_t * node)
+{
+    epc_node_free(node);
+}
+
+EASY_PC_API void
+epc_direct_result_cleanup(epc_parse_result_t * result)
+{
+    epc_parser_result_cleanup(result);
+}
+
+EASY_PC_API epc_parse_result_t
+epc_direct_error(
+    epc_parser_ctx_t * ctx, const char * input, const char * message, const char * expected, const char * found)
+{
+    return epc_parser_error_result(ctx, input, message, expected, found);
+}
+
+EASY_PC_API epc_parser_error_t *
+epc_direct_furthest_error_save(epc_parser_ctx_t * ctx)
+{
+    return parser_furthest_error_copy(ctx);
+}
+
+EASY_PC_API void
+epc_direct_furthest_error_restore(epc_parser_ctx_t * ctx, epc_parser_error_t * * saved)
+{
+    parser_furthest_error_restore(ctx, saved);
+}
+
+EASY_PC_API void
+epc_direct_furthest_error_discard(epc_parser_error_t * saved)
+{
+    epc_parser_error_free(saved);
+}
+
+EASY_PC_API size_t
+epc_direct_scan_int(const char * input, long long * value)
+{
+    return scan_int(input, value);
+}
+
+EASY_PC_API size_t
+epc_direct_scan_double(const char * input, double * value)
+{
+    return scan_double(input, value);
+}
 
-static parser_list_t *
-parser_list_duplicate(parser_list_t * src)
+
+static epc_parser_list_data_t *
+parser_list_duplicate(epc_parser_list_data_t * src)
 {
-    parser_list_t * l;
+    epc_parser_list_data_t * l;
     if (src == NULL)
     {
         return NULL;
@@ -2686,36 +3856,159 @@ parser_list_duplicate(parser_list_t * src)
         l->parsers[i] = src->parsers[i];
     }
     l->count = src->count;
+    if (src->first != NULL)
+    {
+        epc_first_set_t * first = malloc(src->count * sizeof(*first));
+        if (first == NULL)
+        {
+            free(l->parsers);
+            free(l);
+            return NULL;
+        }
+        memcpy(first, src->first, src->count * sizeof(*first));
+        l->first = first;
+    }
     return l;
 }
 
+static epc_parse_result_t
+left_recursion_failure_result(epc_parser_ctx_t * ctx, epc_parser_t * rule, const char * input)
+{
+    /*
+     * Not recorded as the furthest error; it only means the seed hasn't been
+     * found yet, and the rule's other alternatives will report real errors.
+     */
+    epc_parse_result_t result = {
+        .is_error = true,
+        .data.error = epc_parser_error_alloc(ctx, input, "Left recursion without progress", rule->name, "N/A"),
+    };
+    return result;
+}
+
+static epc_parse_result_t
+left_recursion_seed_result(left_recursion_entry_t * entry, epc_parser_ctx_t * ctx)
+{
+    if (entry->seed.is_error)
+    {
+        return left_recursion_failure_result(ctx, entry->rule, entry->input);
+    }
+    /* The caller shares the seed node rather than getting a copy of it. */
+    epc_node_share(entry->seed.data.success);
+    return entry->seed;
+}
+
+epc_parse_result_t
+epc_rule_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    /* A cut commits alternatives within the rule, never those of the rule's callers. */
+    alternative_scope_t * outer_scope = ctx->alternative_scope;
+    ctx->alternative_scope = NULL;
+
+    epc_parse_result_t result = self->rule_parse_fn(self, ctx, input);
+
+    ctx->alternative_scope = outer_scope;
+
+    return result;
+}
+
+epc_parse_result_t
+epc_left_recursive_rule_parse_fn(struct epc_parser_t * self, epc_parser_ctx_t * ctx, const char * input)
+{
+    /* Nested calls are never at an earlier position, so stop at the first entry before this one. */
+    for (left_recursion_entry_t * e = ctx->left_recursion_stack; e != NULL && e->input >= input; e = e->next)
+    {
+        if (e->rule == self && e->input == input)
+        {
+            e->left_recursion_detected = true;
+            return left_recursion_seed_result(e, ctx);
+        }
+    }
+
+    left_recursion_entry_t entry = {
+        .rule = self,
+        .input = input,
+        .seed = { .is_error = true },
+        .next = ctx->left_recursion_stack,
+    };
+    ctx->left_recursion_stack = &entry;
+    /* A cut commits alternatives within the rule, never those of the rule's callers. */
+    alternative_scope_t * outer_scope = ctx->alternative_scope;
+    ctx->alternative_scope = NULL;
+
+    epc_parse_result_t result = self->rule_parse_fn(self, ctx, input);
+
+    if (entry.left_recursion_detected && !result.is_error)
+    {
+        /* Grow the seed until re-evaluating the rule no longer produces a longer match. */
+        entry.seed = result;
+        while (1)
+        {
+            epc_parse_result_t grown = self->rule_parse_fn(self, ctx, input);
+            if (grown.is_error || grown.data.success->len <= entry.seed.data.success->len)
+            {
+                epc_parser_result_cleanup(&grown);
+                break;
+            }
+            epc_parser_result_cleanup(&entry.seed);
+            entry.seed = grown;
+        }
+        result = entry.seed;
+    }
+
+    ctx->alternative_scope = outer_scope;
+    ctx->left_recursion_stack = entry.next;
+
+    return result;
+}
+
 void
 epc_parser_duplicate(epc_parser_t * const dst, epc_parser_t const * const src)
 {
-    dst->parse_fn = src->parse_fn;
+    bool const src_is_rule = src->parse_fn == epc_rule_parse_fn || src->parse_fn == epc_left_recursive_rule_parse_fn;
+    dst->rule_parse_fn = src_is_rule ? src->rule_parse_fn : src->parse_fn;
+    dst->parse_fn = epc_rule_parse_fn;
     dst->ast_config = src->ast_config;
     string_set(&dst->name, src->name);
+    /* It is a new parser now, not the one it stood in for. */
+    dst->id = parser_map_next_id();
 
     parser_data_free(&dst->data);
     dst->data.data_type = src->data.data_type;
     switch (src->data.data_type)
     {
-        case PARSER_DATA_TYPE_OTHER:
-        case PARSER_DATA_TYPE_CHAR_RANGE:
-        case PARSER_DATA_TYPE_COUNT:
-        case PARSER_DATA_TYPE_BETWEEN:
-        case PARSER_DATA_TYPE_DELIMITED:
-        case PARSER_DATA_TYPE_LEXEME:
+        case EPC_PARSER_DATA_TYPE_OTHER:
+        case EPC_PARSER_DATA_TYPE_CHAR_RANGE:
+        case EPC_PARSER_DATA_TYPE_COUNT:
+        case EPC_PARSER_DATA_TYPE_BETWEEN:
+        case EPC_PARSER_DATA_TYPE_DELIMITED:
+        case EPC_PARSER_DATA_TYPE_LEXEME:
+        case EPC_PARSER_DATA_TYPE_DFA:
             dst->data = src->data;
             break;
 
-        case PARSER_DATA_TYPE_STRING:
+        case EPC_PARSER_DATA_TYPE_STRING:
             dst->data.string = strdup(src->data.string);
             break;
 
-        case PARSER_DATA_TYPE_PARSER_LIST:
+        case EPC_PARSER_DATA_TYPE_PARSER_LIST:
             dst->data.parser_list = parser_list_duplicate(src->data.parser_list);
             break;
+
+        case EPC_PARSER_DATA_TYPE_KEYWORDS:
+            dst->data.keywords = keywords_data_create(
+                (char const * const *)src->data.keywords->keywords, src->data.keywords->count);
+            break;
+
+        case EPC_PARSER_DATA_TYPE_OPERATOR_TABLE:
+            dst->data.operator_table = operator_table_data_create(
+                src->data.operator_table->operand, src->data.operator_table->operators, src->data.operator_table->count);
+            break;
+
+        case EPC_PARSER_DATA_TYPE_DIRECT:
+            /* The user data still belongs to src. */
+            dst->data.direct = src->data.direct;
+            dst->data.direct.free_user_data = NULL;
+            break;
     }
 
     if (src->expected_value == src->data.string)
@@ -2726,6 +4019,8 @@ epc_parser_duplicate(epc_parser_t * const dst, epc_parser_t const * const src)
     {
         dst->expected_value = src->expected_value;
     }
+
+    left_recursion_mark_rules(dst);
 }
 
 void
@@ -0,0 +1,106 @@
+#include "CppUTest/TestHarness.h"
+
+#include "alloc_counter.h"
+
+extern "C" {
+    #include "easy_pc/easy_pc.h"
+    #include "json_grammar.h"
+}
+
+#include <string>
+
+/*
+ * Allocation budgets for canonical parses. Each budget is the number of heap
+ * blocks the parse allocates today, so a change that makes the parsers
+ * allocate more fails here; when a change makes them allocate less, lower the
+ * budget to match.
+ */
+
+// Parsing "[1,2,3]" with the JSON example's grammar.
+#define JSON_SMALL_ARRAY_BLOCKS 295
+// A failing parse of a 1 KB JSON array with a bad last element.
+#define JSON_INVALID_1KB_BLOCKS 14519
+// A 1 KB run of 'a's parsed by many(char('a')).
+#define MANY_CHARS_1KB_BLOCKS 1043
+// A single string terminal.
+#define STRING_TERMINAL_BLOCKS 2
+
+TEST_GROUP(Allocation)
+{
+    epc_parser_list * list;
+
+    void setup() override
+    {
+        list = epc_parser_list_create();
+    }
+
+    void teardown() override
+    {
+        epc_parser_list_free(list);
+    }
+
+    // Parses input, checks the blocks allocated are within budget, and that destroying the session frees them all.
+    alloc_counts_t check_parse(epc_parser_t * parser, char const * input, bool expect_success, size_t budget)
+    {
+        alloc_counts_t const start = alloc_counts();
+        epc_parse_session_t session = epc_parse_input(parser, input);
+        alloc_counts_t const parsed = alloc_counts_since(start);
+
+        CHECK_EQUAL(expect_success, !session.result.is_error);
+        epc_parse_session_destroy(&session);
+        alloc_counts_t const destroyed = alloc_counts_since(start);
+
+        CHECK_TRUE(parsed.allocations > 0);
+        CHECK_TRUE(parsed.allocations <= budget);
+        LONGS_EQUAL(destroyed.allocations, destroyed.frees);
+        return parsed;
+    }
+};
+
+TEST(Allocation, JsonSmallArrayStaysWithinBudget)
+{
+    epc_parser_t * json = create_json_grammar(list);
+
+    check_parse(json, "[1,2,3]", true, JSON_SMALL_ARRAY_BLOCKS);
+}
+
+TEST(Allocation, FailingJsonParseOf1KBStaysWithinBudget)
+{
+    epc_parser_t * json = create_json_grammar(list);
+    std::string input = "[";
+    while (input.size() < 1020)
+    {
+        input += "12, ";
+    }
+    input += "x]";
+
+    check_parse(json, input.c_str(), false, JSON_INVALID_1KB_BLOCKS);
+}
+
+TEST(Allocation, ManyCharsOf1KBStaysWithinBudget)
+{
+    epc_parser_t * many = epc_many_l(list, "as", epc_char_l(list, "a", 'a'));
+    std::string const input(1024, 'a');
+
+    check_parse(many, input.c_str(), true, MANY_CHARS_1KB_BLOCKS);
+}
+
+TEST(Allocation, StringTerminalStaysWithinBudget)
+{
+    epc_parser_t * hello = epc_string_l(list, "hello", "hello");
+
+    check_parse(hello, "hello", true, STRING_TERMINAL_BLOCKS);
+}
+
+TEST(Allocation, CountsEveryBlockTheLibraryAllocatesAndFrees)
+{
+    alloc_counts_t const start = alloc_counts();
+    epc_parser_list * other = epc_parser_list_create();
+    epc_string_l(other, "name", "text");
+    alloc_counts_t const created = alloc_counts_since(start);
+    epc_parser_list_free(other);
+    alloc_counts_t const freed = alloc_counts_since(start);
+
+    CHECK_TRUE(created.allocations >= 3);
+    LONGS_EQUAL(freed.allocations, freed.frees);
+}
@@ -1,9 +1,12 @@
 #include "CppUTest/TestHarness.h"
 
 #include "easy_pc/easy_pc.h"
+#include "easy_pc/easy_pc_direct.h"
+#include "easy_pc_parser_layout.h"
 
 #include <stdio.h>
 #include <string.h>
+#include <thread>
 
 TEST_GROUP(CombinatorParsersNew)
 {
@@ -623,3 +626,866 @@ TEST(CombinatorParsersNew, ChainR1_FailsNullChildParser)
     epc_parsers_free(2, p_num, p_chain);
     epc_parse_session_destroy(&session);
 }
+
+// --- epc_keywords tests ---
+TEST(CombinatorParsersNew, Keywords_MatchesKeywordAndRecordsIndex)
+{
+    char const * keywords[] = { "if", "else", "while", "return" };
+    epc_parser_t* p_kw = epc_keywords(NULL, keywords, 4);
+    epc_parse_session_t session = epc_parse_input(p_kw, "while (x)");
+    check_success(session, "keywords", "while", 5, 0);
+    LONGS_EQUAL(2, session.result.data.success->alternative_index);
+    epc_parsers_free(1, p_kw);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Keywords_PrefersLongestMatch)
+{
+    char const * keywords[] = { "in", "int", "integer" };
+    epc_parser_t* p_kw = epc_keywords(NULL, keywords, 3);
+    epc_parse_session_t session = epc_parse_input(p_kw, "intx");
+    check_success(session, "keywords", "int", 3, 0);
+    LONGS_EQUAL(1, session.result.data.success->alternative_index);
+    epc_parsers_free(1, p_kw);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Keywords_FallsBackToShorterKeyword)
+{
+    char const * keywords[] = { "integer", "in" };
+    epc_parser_t* p_kw = epc_keywords(NULL, keywords, 2);
+    epc_parse_session_t session = epc_parse_input(p_kw, "inte");
+    check_success(session, "keywords", "in", 2, 0);
+    LONGS_EQUAL(1, session.result.data.success->alternative_index);
+    epc_parsers_free(1, p_kw);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Keywords_DuplicateKeywordUsesFirstIndex)
+{
+    char const * keywords[] = { "a", "b", "a" };
+    epc_parser_t* p_kw = epc_keywords(NULL, keywords, 3);
+    epc_parse_session_t session = epc_parse_input(p_kw, "a");
+    check_success(session, "keywords", "a", 1, 0);
+    LONGS_EQUAL(0, session.result.data.success->alternative_index);
+    epc_parsers_free(1, p_kw);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Keywords_FailsNoMatch)
+{
+    char const * keywords[] = { "true", "false" };
+    epc_parser_t* p_kw = epc_keywords(NULL, keywords, 2);
+    epc_parse_session_t session = epc_parse_input(p_kw, "tru");
+    check_failure(session, "No keyword matched");
+    STRCMP_EQUAL("true or false", session.result.data.error->expected);
+    epc_parsers_free(1, p_kw);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Keywords_FailsEmptyInput)
+{
+    char const * keywords[] = { "true", "false" };
+    epc_parser_t* p_kw = epc_keywords(NULL, keywords, 2);
+    epc_parse_session_t session = epc_parse_input(p_kw, "");
+    check_failure(session, "Unexpected end of input");
+    epc_parsers_free(1, p_kw);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Keywords_WorksThroughForwardReference)
+{
+    char const * keywords[] = { "null", "true" };
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_fwd = epc_parser_allocate_l(list, "literal");
+    epc_parser_t* p_kw = epc_keywords_l(list, "literal", keywords, 2);
+    epc_parser_duplicate(p_fwd, p_kw);
+    epc_parse_session_t session = epc_parse_input(p_fwd, "true");
+    check_success(session, "keywords", "true", 4, 0);
+    LONGS_EQUAL(1, session.result.data.success->alternative_index);
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+// --- epc_dfa tests ---
+// digit+ ('.' digit+)?, with byte classes 0 (anything else), 1 (digit) and 2 ('.').
+static unsigned char number_dfa_classes[256];
+static unsigned short const number_dfa_transitions[] = {
+    0, 0, 0, // Dead.
+    0, 2, 0, // Start.
+    0, 2, 3, // Integer part.
+    0, 4, 0, // After the '.'.
+    0, 4, 0, // Fraction.
+};
+static unsigned char const number_dfa_accepting[] = { 0, 0, 1, 0, 1 };
+
+static epc_dfa_t const *
+number_dfa(void)
+{
+    static epc_dfa_t const dfa = {
+        number_dfa_classes, number_dfa_transitions, number_dfa_accepting, 3, 1
+    };
+
+    memset(number_dfa_classes, 0, sizeof(number_dfa_classes));
+    memset(&number_dfa_classes['0'], 1, 10);
+    number_dfa_classes['.'] = 2;
+    return &dfa;
+}
+
+TEST(CombinatorParsersNew, Dfa_MatchesLongestAcceptedInput)
+{
+    epc_parser_t* p_number = epc_dfa("number", number_dfa());
+    epc_parse_session_t session = epc_parse_input(p_number, "12.5x");
+    check_success(session, "dfa", "12.5", 4, 0);
+    STRCMP_EQUAL("number", session.result.data.success->name);
+    epc_parse_session_destroy(&session);
+
+    // The automaton gets as far as the '.', but the match ends at the last accepting state.
+    session = epc_parse_input(p_number, "12.x");
+    check_success(session, "dfa", "12", 2, 0);
+    epc_parsers_free(1, p_number);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Dfa_FailsWhenNothingIsAccepted)
+{
+    epc_parser_t* p_number = epc_dfa("number", number_dfa());
+    epc_parse_session_t session = epc_parse_input(p_number, ".5");
+    check_failure(session, "Unexpected input");
+    STRCMP_EQUAL("number", session.result.data.error->expected);
+    epc_parse_session_destroy(&session);
+
+    session = epc_parse_input(p_number, "");
+    check_failure(session, "Unexpected end of input");
+    epc_parsers_free(1, p_number);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Dfa_WorksWithinLexeme)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_number = epc_lexeme_l(list, "number", epc_dfa_l(list, "number", number_dfa()));
+    epc_parser_t* p_sum = epc_and_l(list, "sum", 3, p_number, epc_char_l(list, NULL, '+'), p_number);
+    epc_parse_session_t session = epc_parse_input(p_sum, " 1.5 + 20 ");
+    check_success(session, "and", " 1.5 + 20 ", 10, 3);
+    check_cpt_node(session.result.data.success->children[2]->children[0], "dfa", "20", 2, 0);
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, Or_RecordsMatchedAlternativeIndex)
+{
+    epc_parser_t* p_a = epc_char(NULL, 'a');
+    epc_parser_t* p_b = epc_char(NULL, 'b');
+    epc_parser_t* p_or = epc_or(NULL, 2, p_a, p_b);
+    epc_parse_session_t session = epc_parse_input(p_or, "b");
+    check_success(session, "or", "b", 1, 1);
+    LONGS_EQUAL(1, session.result.data.success->alternative_index);
+    epc_parsers_free(3, p_a, p_b, p_or);
+    epc_parse_session_destroy(&session);
+}
+
+static void
+first_set_add(epc_first_set_t * set, unsigned char c)
+{
+    set->bits[c / 8] |= (unsigned char)(1u << (c % 8));
+}
+
+TEST(CombinatorParsersNew, OrFirst_OnlyTriesAlternativesThatCanStartHere)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_first_set_t first[2] = {};
+    /* The first set deliberately leaves out 'b', so the first alternative is never tried on "b". */
+    first_set_add(&first[0], 'a');
+    first_set_add(&first[1], 'b');
+    epc_parser_t* p_or = epc_or_first_l(
+        list, "or", first, 2, epc_any_char_l(list, NULL), epc_char_l(list, NULL, 'b'));
+
+    epc_parse_session_t session = epc_parse_input(p_or, "b");
+    check_success(session, "or", "b", 1, 1);
+    LONGS_EQUAL(1, session.result.data.success->alternative_index);
+    epc_parse_session_destroy(&session);
+
+    session = epc_parse_input(p_or, "c");
+    CHECK_TRUE(session.result.is_error);
+    STRCMP_EQUAL("any_char or b", session.result.data.error->expected);
+    epc_parse_session_destroy(&session);
+
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, OrFirst_KeepsSetsThroughForwardReference)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_first_set_t first[2] = {};
+    first_set_add(&first[0], '\0');
+    first_set_add(&first[1], 'x');
+    epc_parser_t* p_fwd = epc_parser_allocate_l(list, "fwd");
+    epc_parser_t* p_or = epc_or_first_l(list, "or", first, 2, epc_eoi_l(list, NULL), epc_char_l(list, NULL, 'x'));
+    epc_parser_duplicate(p_fwd, p_or);
+
+    epc_parse_session_t session = epc_parse_input(p_fwd, "");
+    check_success(session, "or", "", 0, 1);
+    LONGS_EQUAL(0, session.result.data.success->alternative_index);
+    epc_parse_session_destroy(&session);
+
+    session = epc_parse_input(p_fwd, "x");
+    check_success(session, "or", "x", 1, 1);
+    LONGS_EQUAL(1, session.result.data.success->alternative_index);
+    epc_parse_session_destroy(&session);
+
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, Or_ProfileCountsAlternativesTriedAndMatched)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_fwd = epc_parser_allocate_l(list, "ab");
+    epc_parser_t* p_or = epc_or_l(list, "ab", 2, epc_char_l(list, NULL, 'a'), epc_char_l(list, NULL, 'b'));
+    epc_parser_duplicate(p_fwd, p_or);
+    epc_parser_t* p_items = epc_many_l(list, "items", p_fwd);
+    epc_alternative_profile_t * profile = epc_alternative_profile_create();
+    epc_parse_options_t options = { .alternative_profile = profile };
+
+    // The 'or' is tried at each of the 3 characters and at the end of the input.
+    epc_parse_session_t session = epc_parse_input_with_options(p_items, "abb", &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+    // The copy made for the forward reference is counted with the original.
+    session = epc_parse_input_with_options(p_or, "a", &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+    // Parses without the profile aren't counted.
+    session = epc_parse_input(p_or, "b");
+    epc_parse_session_destroy(&session);
+
+    char text[64] = {};
+    FILE * out = fmemopen(text, sizeof(text), "w");
+    CHECK_TRUE(epc_alternative_profile_write(profile, out));
+    fclose(out);
+    STRCMP_EQUAL("ab 2 5 2 3 2\n", text);
+
+    epc_alternative_profile_free(profile);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, Or_ProfileTellsAParserFromAnotherAtTheSameAddress)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_fwd = epc_parser_allocate_l(list, "rule");
+    epc_alternative_profile_t * profile = epc_alternative_profile_create();
+    epc_parse_options_t options = { .alternative_profile = profile };
+
+    epc_parser_duplicate(p_fwd, epc_or_l(list, "first", 2, epc_char_l(list, NULL, 'a'), epc_char_l(list, NULL, 'b')));
+    epc_parse_session_t session = epc_parse_input_with_options(p_fwd, "b", &options);
+    epc_parse_session_destroy(&session);
+    // Completing the rule again makes it a new parser, as if one had been allocated where it was.
+    epc_parser_duplicate(p_fwd, epc_or_l(list, "second", 3,
+                                         epc_char_l(list, NULL, 'a'), epc_char_l(list, NULL, 'b'), epc_char_l(list, NULL, 'c')));
+    session = epc_parse_input_with_options(p_fwd, "c", &options);
+    epc_parse_session_destroy(&session);
+
+    char text[64] = {};
+    FILE * out = fmemopen(text, sizeof(text), "w");
+    CHECK_TRUE(epc_alternative_profile_write(profile, out));
+    fclose(out);
+    STRCMP_EQUAL("first 2 1 0 1 1\nsecond 3 1 0 1 0 1 1\n", text);
+
+    epc_alternative_profile_free(profile);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, ProfileReportCountsParserCalls)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_items = epc_many_l(list, "profiled_items", epc_char_l(list, "profiled_a", 'a'));
+
+    epc_profile_reset();
+    epc_parse_session_t session = epc_parse_input(p_items, "aab");
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+
+    char text[1024] = {};
+    FILE * out = fmemopen(text, sizeof(text), "w");
+    bool reported = epc_profile_report(out);
+    fclose(out);
+    if (reported)
+    {
+        // 'a' is tried at each character, and matches twice.
+        unsigned long long calls, successes, failures, bytes;
+        char const * row = strstr(text, "\nprofiled_a ");
+        CHECK_TRUE(row != NULL);
+        CHECK_EQUAL(4, sscanf(row, " profiled_a %llu %llu %llu %llu", &calls, &successes, &failures, &bytes));
+        CHECK_EQUAL(3, calls);
+        CHECK_EQUAL(2, successes);
+        CHECK_EQUAL(1, failures);
+        CHECK_EQUAL(2, bytes);
+        // The start rule is counted too.
+        row = strstr(text, "\nprofiled_items ");
+        CHECK_TRUE(row != NULL);
+        CHECK_EQUAL(4, sscanf(row, " profiled_items %llu %llu %llu %llu", &calls, &successes, &failures, &bytes));
+        CHECK_EQUAL(1, calls);
+        CHECK_EQUAL(1, successes);
+        CHECK_EQUAL(0, failures);
+        CHECK_EQUAL(2, bytes);
+    }
+    else
+    {
+        // Without WITH_PARSER_PROFILING, nothing is written.
+        STRCMP_EQUAL("", text);
+    }
+
+    epc_profile_reset();
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, ProfileReportKeepsTheCountsOfThreadsThatExited)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_items = epc_many_l(list, "threaded_items", epc_char_l(list, "threaded_a", 'a'));
+
+    epc_profile_reset();
+    auto parse = [p_items]()
+    {
+        epc_parse_session_t session = epc_parse_input(p_items, "aab");
+        epc_parse_session_destroy(&session);
+    };
+    std::thread first(parse);
+    std::thread second(parse);
+    first.join();
+    second.join();
+    parse();
+
+    char text[1024] = {};
+    FILE * out = fmemopen(text, sizeof(text), "w");
+    bool reported = epc_profile_report(out);
+    fclose(out);
+    if (reported)
+    {
+        // The times are labelled with their unit.
+        CHECK_TRUE(strstr(text, "inclusive (") != NULL);
+        unsigned long long calls, successes, failures, bytes;
+        char const * row = strstr(text, "\nthreaded_a ");
+        CHECK_TRUE(row != NULL);
+        CHECK_EQUAL(4, sscanf(row, " threaded_a %llu %llu %llu %llu", &calls, &successes, &failures, &bytes));
+        CHECK_EQUAL(9, calls);
+        CHECK_EQUAL(6, successes);
+        CHECK_EQUAL(3, failures);
+        CHECK_EQUAL(6, bytes);
+    }
+
+    // Clears the counts of the threads that exited too.
+    epc_profile_reset();
+    memset(text, 0, sizeof(text));
+    out = fmemopen(text, sizeof(text), "w");
+    epc_profile_report(out);
+    fclose(out);
+    CHECK_TRUE(strstr(text, "threaded_a") == NULL);
+    epc_parser_list_free(list);
+}
+
+static size_t
+count_occurrences(char const * text, char const * pattern)
+{
+    size_t count = 0;
+    for (char const * p = strstr(text, pattern); p != NULL; p = strstr(p + 1, pattern))
+    {
+        count++;
+    }
+    return count;
+}
+
+TEST(CombinatorParsersNew, Trace_RecordsParserCallsAsChromeTraceEvents)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_items = epc_many_l(list, "items", epc_char_l(list, "a\"char", 'a'));
+    epc_trace_t * trace = epc_trace_create(NULL);
+    epc_parse_options_t options = { .trace = trace };
+
+    epc_parse_session_t session = epc_parse_input_with_options(p_items, "aab", &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+
+    char text[4096] = {};
+    FILE * out = fmemopen(text, sizeof(text), "w");
+    CHECK_TRUE(epc_trace_write_chrome_json(trace, out));
+    fclose(out);
+
+    // The rule and each of the three tries of 'a', entered and exited.
+    STRCMP_CONTAINS("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", text);
+    CHECK_EQUAL(4, count_occurrences(text, "\"ph\":\"B\""));
+    CHECK_EQUAL(4, count_occurrences(text, "\"ph\":\"E\""));
+    CHECK_EQUAL(2, count_occurrences(text, "{\"name\":\"items\""));
+    CHECK_EQUAL(6, count_occurrences(text, "{\"name\":\"a\\\"char\""));
+    CHECK_EQUAL(2, count_occurrences(text, "\"result\":\"success\",\"length\":1}"));
+    STRCMP_CONTAINS("\"result\":\"success\",\"length\":2}", text);
+    CHECK_EQUAL(1, count_occurrences(text, "\"result\":\"fail\""));
+    STRCMP_CONTAINS("\"args\":{\"offset\":2}}", text);
+
+    epc_trace_free(trace);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, Trace_SamplesAndFiltersByRuleName)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_items = epc_many_l(list, "items", epc_char_l(list, "a", 'a'));
+    char const * rules[] = { "a" };
+    epc_trace_config_t config = { .buffer_events = 4, .sample_every = 2, .rules = rules, .rule_count = 1 };
+    epc_trace_t * trace = epc_trace_create(&config);
+    epc_parse_options_t options = { .trace = trace };
+
+    // 'a' is tried 7 times; the 1st, 3rd, 5th and 7th tries are sampled,
+    // and the last 4 events kept are those of the 5th and 7th.
+    epc_parse_session_t session = epc_parse_input_with_options(p_items, "aaaaaa", &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+
+    char text[4096] = {};
+    FILE * out = fmemopen(text, sizeof(text), "w");
+    CHECK_TRUE(epc_trace_write_chrome_json(trace, out));
+    fclose(out);
+
+    CHECK_EQUAL(0, count_occurrences(text, "\"items\""));
+    CHECK_EQUAL(2, count_occurrences(text, "\"ph\":\"B\""));
+    STRCMP_CONTAINS("\"args\":{\"offset\":4}}", text);
+    STRCMP_CONTAINS("\"args\":{\"offset\":6}}", text);
+    CHECK_EQUAL(1, count_occurrences(text, "\"result\":\"fail\""));
+
+    epc_trace_free(trace);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, BacktrackMap_CountsParsersEnteredAtEachOffset)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_a = epc_char_l(list, "a", 'a');
+    epc_parser_t* p_or = epc_or_l(list, "either", 2,
+                                  epc_and_l(list, "ab", 2, p_a, epc_char_l(list, "b", 'b')),
+                                  epc_and_l(list, "ac", 2, p_a, epc_char_l(list, "c", 'c')));
+    epc_backtrack_map_t * map = epc_backtrack_map_create();
+    epc_parse_options_t options = { .backtrack_map = map };
+
+    epc_parse_session_t session = epc_parse_input_with_options(p_or, "ac", &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+
+    // "either", "ab", "a", "ac" and "a" again at offset 0; "b" and "c" at offset 1.
+    CHECK_EQUAL(5, epc_backtrack_map_count(map, 0));
+    CHECK_EQUAL(2, epc_backtrack_map_count(map, 1));
+    CHECK_EQUAL(0, epc_backtrack_map_count(map, 2));
+    CHECK_EQUAL(0, epc_backtrack_map_count(map, 3));
+
+    char text[1024] = {};
+    FILE * out = fmemopen(text, sizeof(text), "w");
+    CHECK_TRUE(epc_backtrack_map_write(map, 1, out));
+    fclose(out);
+    STRCMP_CONTAINS("Parsers entered 7 times at 2 of 3 offsets, 3.50 per byte of input.\n", text);
+    STRCMP_CONTAINS("\n2-3                       1\n4-7                       1\n", text);
+    STRCMP_CONTAINS("         0            5        1:1       a (2) either (1) ab (1) ac (1)\n", text);
+    CHECK_TRUE(strstr(text, "1:2") == NULL);
+
+    // A new parse starts the map afresh.
+    session = epc_parse_input_with_options(p_a, "a", &options);
+    epc_parse_session_destroy(&session);
+    CHECK_EQUAL(1, epc_backtrack_map_count(map, 0));
+    CHECK_EQUAL(0, epc_backtrack_map_count(map, 1));
+
+    epc_backtrack_map_free(map);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, SessionStats_CountNodesErrorsAndDepth)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_a = epc_char_l(list, "a", 'a');
+    epc_parser_t* p_or = epc_or_l(list, "either", 2,
+                                  epc_and_l(list, "ab", 2, p_a, epc_char_l(list, "b", 'b')),
+                                  epc_and_l(list, "ac", 2, p_a, epc_char_l(list, "c", 'c')));
+
+    epc_parse_session_t session = epc_parse_input(p_or, "ac");
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_stats_t stats = epc_parse_session_stats(&session);
+
+    // 'a' twice, 'c', "ac" and "either"; the first 'a' is discarded when "ab" fails.
+    CHECK_EQUAL(5, stats.cpt_nodes);
+    CHECK_TRUE(stats.cpt_bytes >= 5 * sizeof(epc_cpt_node_t) + 3 * sizeof(epc_cpt_node_t *));
+    // "either", "ac" and 'c'.
+    CHECK_EQUAL(3, stats.max_depth);
+    // 'b' failing, and the copy kept as the furthest error.
+    CHECK_TRUE(stats.errors_created >= 2);
+    CHECK_TRUE(stats.errors_copied >= 1);
+    CHECK_TRUE(stats.errors_copied < stats.errors_created);
+    CHECK_TRUE(stats.peak_allocations > 0);
+    CHECK_TRUE(stats.peak_allocations < stats.allocations);
+    epc_parse_session_destroy(&session);
+
+    // Sessions without a context have no counts.
+    epc_parse_session_t empty = {};
+    CHECK_EQUAL(0, epc_parse_session_stats(&empty).allocations);
+
+    epc_parser_list_free(list);
+}
+
+// --- left recursion through forward references ---
+TEST(CombinatorParsersNew, LeftRecursion_DirectGrowsLeftAssociative)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_expr = epc_parser_allocate_l(list, "expr");
+    epc_parser_t* p_digit = epc_digit_l(list, "digit");
+    epc_parser_t* p_sum = epc_and_l(list, "sum", 3, p_expr, epc_char_l(list, "plus", '+'), p_digit);
+    epc_parser_t* p_expr_def = epc_or_l(list, "expr", 2, p_sum, p_digit);
+    epc_parser_duplicate(p_expr, p_expr_def);
+
+    epc_parse_session_t session = epc_parse_input(p_expr, "1+2+3");
+    check_success(session, "or", "1+2+3", 5, 1);
+
+    /* ((1+2)+3): the left operand of the outer sum is the inner expression. */
+    epc_cpt_node_t * outer_sum = session.result.data.success->children[0];
+    check_cpt_node(outer_sum, "and", "1+2+3", 5, 3);
+    check_cpt_node(outer_sum->children[0], "or", "1+2", 3, 1);
+    check_cpt_node(outer_sum->children[0]->children[0]->children[0], "or", "1", 1, 1);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, LeftRecursion_IndirectThroughAnotherRule)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_a = epc_parser_allocate_l(list, "a");
+    epc_parser_t* p_b = epc_parser_allocate_l(list, "b");
+    epc_parser_t* p_a_def = epc_or_l(
+        list, "a", 2, epc_and_l(list, NULL, 2, p_b, epc_char_l(list, NULL, 'x')), epc_char_l(list, NULL, 'y'));
+    epc_parser_t* p_b_def = epc_or_l(list, "b", 1, p_a);
+    epc_parser_duplicate(p_a, p_a_def);
+    epc_parser_duplicate(p_b, p_b_def);
+
+    // The cycle is only complete once b is, and both rules take part in it.
+    CHECK(p_a->parse_fn == epc_left_recursive_rule_parse_fn);
+    CHECK(p_b->parse_fn == epc_left_recursive_rule_parse_fn);
+
+    epc_parse_session_t session = epc_parse_input(p_a, "yxxz");
+    check_success(session, "or", "yxx", 3, 1);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, LeftRecursion_OnlyLeftRecursiveRulesAreTracked)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_expr = epc_parser_allocate_l(list, "expr");
+    epc_parser_t* p_group = epc_parser_allocate_l(list, "group");
+    epc_parser_t* p_signed = epc_parser_allocate_l(list, "signed");
+    epc_parser_t* p_digit = epc_digit_l(list, "digit");
+
+    // Called only after '(' has been consumed, so not left-recursive.
+    epc_parser_duplicate(p_group, epc_or_l(list, "group", 2,
+        epc_and_l(list, NULL, 3, epc_char_l(list, NULL, '('), p_group, epc_char_l(list, NULL, ')')), p_expr));
+    epc_parser_duplicate(p_expr, epc_or_l(list, "expr", 2,
+        epc_and_l(list, NULL, 3, p_expr, epc_char_l(list, NULL, '+'), p_digit), p_digit));
+    // The optional sign may match nothing, so the rule may call itself without consuming input.
+    epc_parser_duplicate(p_signed, epc_or_l(list, "signed", 2,
+        epc_and_l(list, NULL, 3, epc_optional_l(list, NULL, epc_char_l(list, NULL, '-')), p_signed, p_digit), p_digit));
+
+    CHECK(p_group->parse_fn == epc_rule_parse_fn);
+    CHECK(p_expr->parse_fn == epc_left_recursive_rule_parse_fn);
+    CHECK(p_signed->parse_fn == epc_left_recursive_rule_parse_fn);
+
+    epc_parse_session_t session = epc_parse_input(p_group, "((1+2+3))");
+    check_success(session, "or", "((1+2+3))", 9, 1);
+    epc_parse_session_destroy(&session);
+
+    session = epc_parse_input(p_signed, "123");
+    check_success(session, "or", "123", 3, 1);
+    epc_parse_session_destroy(&session);
+
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, LeftRecursion_FailsWithoutSeed)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_expr = epc_parser_allocate_l(list, "expr");
+    epc_parser_t* p_digit = epc_digit_l(list, "digit");
+    epc_parser_t* p_sum = epc_and_l(list, "sum", 3, p_expr, epc_char_l(list, "plus", '+'), p_digit);
+    epc_parser_t* p_expr_def = epc_or_l(list, "expr", 2, p_sum, p_digit);
+    epc_parser_duplicate(p_expr, p_expr_def);
+
+    epc_parse_session_t session = epc_parse_input(p_expr, "+1");
+    CHECK_TRUE(session.result.is_error);
+    /* The internal left recursion failure is never reported to the caller. */
+    CHECK_TRUE(strstr(session.result.data.error->message, "Left recursion") == NULL);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+// --- p_cut tests ---
+TEST(CombinatorParsersNew, Cut_SucceedsConsumingNothing)
+{
+    epc_parser_t* p_cut = epc_cut(NULL);
+    epc_parse_session_t session = epc_parse_input(p_cut, "abc");
+    check_success(session, "cut", "", 0, 0);
+    epc_parsers_free(1, p_cut);
+    epc_parse_session_destroy(&session);
+}
+
+TEST(CombinatorParsersNew, Cut_StopsOrTryingLaterAlternatives)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_committed = epc_and_l(
+        list, "committed", 3, epc_char_l(list, "a", 'a'), epc_cut_l(list, "cut"), epc_char_l(list, "b", 'b'));
+    epc_parser_t* p_fallback = epc_string_l(list, "fallback", "ac");
+    epc_parser_t* p_or = epc_or_l(list, "or", 2, p_committed, p_fallback);
+
+    epc_parse_session_t session = epc_parse_input(p_or, "ac");
+    check_failure(session, "Unexpected character");
+    STRCMP_EQUAL("b", session.result.data.error->expected);
+    LONGS_EQUAL(1, session.result.data.error->col);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, Cut_BacktracksIfNotReached)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_committed = epc_and_l(
+        list, "committed", 3, epc_char_l(list, "a", 'a'), epc_cut_l(list, "cut"), epc_char_l(list, "b", 'b'));
+    epc_parser_t* p_fallback = epc_string_l(list, "fallback", "xy");
+    epc_parser_t* p_or = epc_or_l(list, "or", 2, p_committed, p_fallback);
+
+    epc_parse_session_t session = epc_parse_input(p_or, "xy");
+    check_success(session, "or", "xy", 2, 1);
+    LONGS_EQUAL(1, session.result.data.success->alternative_index);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, Cut_OnlyCommitsInnermostOr)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t* p_committed = epc_and_l(
+        list, "committed", 3, epc_char_l(list, "a", 'a'), epc_cut_l(list, "cut"), epc_char_l(list, "b", 'b'));
+    epc_parser_t* p_inner = epc_or_l(list, "inner", 2, p_committed, epc_string_l(list, "ac", "ac"));
+    epc_parser_t* p_outer = epc_or_l(list, "outer", 2, p_inner, epc_string_l(list, "ad", "ad"));
+
+    epc_parse_session_t session = epc_parse_input(p_outer, "ad");
+    check_success(session, "or", "ad", 2, 1);
+    LONGS_EQUAL(1, session.result.data.success->alternative_index);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+// --- p_operator_table tests ---
+TEST(CombinatorParsersNew, OperatorTable_OperandOnlyIsReturnedAsIs)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_operator_t operators[] = {
+        { EPC_OPERATOR_INFIX_LEFT, 1, epc_char_l(list, "plus", '+') },
+    };
+    epc_parser_t* p_expr = epc_operator_table_l(list, "expr", epc_digit_l(list, "digit"), operators, 1);
+
+    epc_parse_session_t session = epc_parse_input(p_expr, "7");
+    check_success(session, "digit", "7", 1, 0);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, OperatorTable_InfixPrecedenceAndLeftAssociativity)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_operator_t operators[] = {
+        { EPC_OPERATOR_INFIX_LEFT, 1, epc_char_l(list, "plus", '+') },
+        { EPC_OPERATOR_INFIX_LEFT, 1, epc_char_l(list, "minus", '-') },
+        { EPC_OPERATOR_INFIX_LEFT, 2, epc_char_l(list, "times", '*') },
+    };
+    epc_parser_t* p_expr = epc_operator_table_l(list, "expr", epc_digit_l(list, "digit"), operators, 3);
+
+    /* ((1 + (2 * 3)) - 4) */
+    epc_parse_session_t session = epc_parse_input(p_expr, "1+2*3-4");
+    check_success(session, "infix_expression", "1+2*3-4", 7, 3);
+    epc_cpt_node_t * root = session.result.data.success;
+    LONGS_EQUAL(1, root->alternative_index);
+    check_cpt_node(root->children[2], "digit", "4", 1, 0);
+
+    epc_cpt_node_t * sum = root->children[0];
+    check_cpt_node(sum, "infix_expression", "1+2*3", 5, 3);
+    LONGS_EQUAL(0, sum->alternative_index);
+    check_cpt_node(sum->children[2], "infix_expression", "2*3", 3, 3);
+    LONGS_EQUAL(2, sum->children[2]->alternative_index);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, OperatorTable_RightAssociativity)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_operator_t operators[] = {
+        { EPC_OPERATOR_INFIX_RIGHT, 3, epc_char_l(list, "power", '^') },
+    };
+    epc_parser_t* p_expr = epc_operator_table_l(list, "expr", epc_digit_l(list, "digit"), operators, 1);
+
+    /* (2 ^ (3 ^ 4)) */
+    epc_parse_session_t session = epc_parse_input(p_expr, "2^3^4");
+    check_success(session, "infix_expression", "2^3^4", 5, 3);
+    epc_cpt_node_t * root = session.result.data.success;
+    check_cpt_node(root->children[0], "digit", "2", 1, 0);
+    check_cpt_node(root->children[2], "infix_expression", "3^4", 3, 3);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, OperatorTable_PrefixAndPostfix)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_operator_t operators[] = {
+        { EPC_OPERATOR_INFIX_LEFT, 1, epc_char_l(list, "plus", '+') },
+        { EPC_OPERATOR_PREFIX, 3, epc_char_l(list, "negate", '-') },
+        { EPC_OPERATOR_POSTFIX, 4, epc_char_l(list, "factorial", '!') },
+    };
+    epc_parser_t* p_expr = epc_operator_table_l(list, "expr", epc_digit_l(list, "digit"), operators, 3);
+
+    /* ((-(1!)) + 2) */
+    epc_parse_session_t session = epc_parse_input(p_expr, "-1!+2");
+    check_success(session, "infix_expression", "-1!+2", 5, 3);
+    epc_cpt_node_t * negation = session.result.data.success->children[0];
+    check_cpt_node(negation, "prefix_expression", "-1!", 3, 2);
+    LONGS_EQUAL(1, negation->alternative_index);
+    check_cpt_node(negation->children[1], "postfix_expression", "1!", 2, 2);
+    LONGS_EQUAL(2, negation->children[1]->alternative_index);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, OperatorTable_FailsOnMissingRightOperand)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_operator_t operators[] = {
+        { EPC_OPERATOR_INFIX_LEFT, 1, epc_char_l(list, "plus", '+') },
+    };
+    epc_parser_t* p_expr = epc_operator_table_l(list, "expr", epc_digit_l(list, "digit"), operators, 1);
+
+    epc_parse_session_t session = epc_parse_input(p_expr, "1+x");
+    CHECK_TRUE(session.result.is_error);
+    LONGS_EQUAL(2, session.result.data.error->col);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+/* Matches a run of 'a's, wrapping the matched 'b' children of an optional child parser. */
+static epc_parse_result_t
+direct_as_then_child(epc_parser_ctx_t * ctx, const char * input, void * user_data)
+{
+    epc_parser_t * child = (epc_parser_t *)user_data;
+    size_t len = 0;
+
+    while (input[len] == 'a')
+    {
+        len++;
+    }
+    if (len == 0)
+    {
+        return epc_direct_error(ctx, input, "Unexpected character", "a", input[0] != '\0' ? input : "EOF");
+    }
+
+    epc_cpt_node_t * node = epc_direct_node_alloc("as", "direct", input);
+    epc_parse_result_t child_result = epc_direct_parse(child, ctx, input + len);
+    if (child_result.is_error)
+    {
+        epc_direct_result_cleanup(&child_result);
+    }
+    else
+    {
+        CHECK_TRUE(epc_direct_node_add_child(node, child_result.data.success));
+        len += child_result.data.success->len;
+    }
+    node->len = len;
+
+    epc_parse_result_t result = { .is_error = false, .data = { .success = node } };
+    return result;
+}
+
+TEST(CombinatorParsersNew, Direct_BuildsNodesAndRunsChildParser)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t * p_direct = epc_direct_l(list, "as", direct_as_then_child, epc_char_l(list, "b", 'b'), NULL);
+    epc_parser_t * p_seq = epc_and_l(list, "seq", 2, p_direct, epc_eoi_l(list, "eoi"));
+
+    epc_parse_session_t session = epc_parse_input(p_seq, "aab");
+    check_success(session, "and", "aab", 3, 2);
+    epc_cpt_node_t * direct_node = session.result.data.success->children[0];
+    check_cpt_node(direct_node, "as", "aab", 3, 1);
+    check_cpt_node(direct_node->children[0], "char", "b", 1, 0);
+    epc_parse_session_destroy(&session);
+
+    session = epc_parse_input(p_seq, "aa");
+    check_success(session, "and", "aa", 2, 2);
+    check_cpt_node(session.result.data.success->children[0], "as", "aa", 2, 0);
+    epc_parse_session_destroy(&session);
+
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, Direct_ErrorIsReportedAsFurthestError)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t * p_direct = epc_direct_l(list, "as", direct_as_then_child, epc_char_l(list, "b", 'b'), NULL);
+    epc_parser_t * p_or = epc_or_l(list, "or", 2, epc_and_l(list, "seq", 2, epc_char_l(list, "x", 'x'), p_direct), epc_char_l(list, "y", 'y'));
+
+    epc_parse_session_t session = epc_parse_input(p_or, "xc");
+    CHECK_TRUE(session.result.is_error);
+    STRCMP_EQUAL("Unexpected character", session.result.data.error->message);
+    STRCMP_EQUAL("a", session.result.data.error->expected);
+    LONGS_EQUAL(1, session.result.data.error->col);
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(list);
+}
+
+TEST(CombinatorParsersNew, Static_ParsersBehaveLikeConstructedOnes)
+{
+    // Laid out as gdl_compiler --backend=static would, though on the stack rather than as static data.
+    epc_parser_t p_a = {};
+    p_a.parse_fn = epc_char_parse_fn;
+    p_a.data.data_type = EPC_PARSER_DATA_TYPE_STRING;
+    p_a.data.string = "a";
+    p_a.name = "a";
+    p_a.expected_value = p_a.data.string;
+
+    epc_parser_t p_b = p_a;
+    p_b.data.string = "b";
+    p_b.name = "b";
+    p_b.expected_value = p_b.data.string;
+
+    epc_parser_t * children[] = { &p_a, &p_b };
+    epc_parser_list_data_t list = { children, 2 };
+    epc_parser_t p_seq = {};
+    p_seq.parse_fn = epc_rule_parse_fn;
+    p_seq.rule_parse_fn = epc_and_parse_fn;
+    p_seq.data.data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST;
+    p_seq.data.parser_list = &list;
+    p_seq.name = "seq";
+    p_seq.ast_config.assigned = true;
+    p_seq.ast_config.action = 3;
+
+    epc_parse_session_t session = epc_parse_input(&p_seq, "abc");
+    check_success(session, "and", "ab", 2, 2);
+    STRCMP_EQUAL("seq", session.result.data.success->name);
+    LONGS_EQUAL(3, session.result.data.success->ast_config.action);
+    epc_parse_session_destroy(&session);
+
+    session = epc_parse_input(&p_seq, "ac");
+    CHECK_TRUE(session.result.is_error);
+    STRCMP_EQUAL("b", session.result.data.error->expected);
+    epc_parse_session_destroy(&session);
+}
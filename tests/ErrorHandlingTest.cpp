@@ -280,3 +280,195 @@ TEST(ErrorHandling, FurthestErrorTracking)
 
     destroy_transient_parse_ctx(parse_ctx);
 }
+
+// --- Resource limits ---
+
+// expr = '(' expr ')' | 'x', on as many '(' as given.
+static epc_parser_t *
+create_nesting_grammar(epc_parser_list * list)
+{
+    epc_parser_t * p_expr = epc_parser_allocate_l(list, "expr");
+    epc_parser_t * p_nested = epc_and_l(list, "nested", 3, epc_char_l(list, "open", '('), p_expr, epc_char_l(list, "close", ')'));
+    epc_parser_duplicate(p_expr, epc_or_l(list, "expr", 2, p_nested, epc_char_l(list, "x", 'x')));
+    return p_expr;
+}
+
+TEST(ErrorHandling, LimitsStopTooDeepNesting)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t * p_expr = create_nesting_grammar(list);
+    epc_parse_options_t options = {};
+    options.limits.max_depth = 20;
+
+    // Each level of nesting takes three parser calls: expr, nested and open.
+    epc_parse_session_t session = epc_parse_input_with_options(p_expr, "((((((x))))))", &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+
+    session = epc_parse_input_with_options(p_expr, "((((((((((x))))))))))", &options);
+    CHECK_TRUE(session.result.is_error);
+    CHECK_EQUAL(EPC_PARSE_ERROR_DEPTH_LIMIT, session.result.data.error->kind);
+    STRCMP_EQUAL("Parse limit reached", session.result.data.error->message);
+    STRCMP_EQUAL("nesting at most 20 deep", session.result.data.error->expected);
+    CHECK_TRUE(epc_parse_session_stats(&session).max_depth <= 21);
+    epc_parse_session_destroy(&session);
+
+    // Ordinary failures are syntax errors.
+    session = epc_parse_input_with_options(p_expr, "((y))", &options);
+    CHECK_TRUE(session.result.is_error);
+    CHECK_EQUAL(EPC_PARSE_ERROR_SYNTAX, session.result.data.error->kind);
+    epc_parse_session_destroy(&session);
+
+    epc_parser_list_free(list);
+}
+
+TEST(ErrorHandling, LimitsStopTooManyNodesBytesOrCalls)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t * p_expr = create_nesting_grammar(list);
+    char const * input = "((((((((((x))))))))))";
+
+    epc_parse_session_t session = epc_parse_input(p_expr, input);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_stats_t unlimited = epc_parse_session_stats(&session);
+    epc_parse_session_destroy(&session);
+
+    epc_parse_options_t options = {};
+    options.limits.max_cpt_nodes = unlimited.cpt_nodes - 1;
+    session = epc_parse_input_with_options(p_expr, input, &options);
+    CHECK_TRUE(session.result.is_error);
+    CHECK_EQUAL(EPC_PARSE_ERROR_NODE_LIMIT, session.result.data.error->kind);
+    epc_parse_session_destroy(&session);
+
+    options = {};
+    options.limits.max_cpt_bytes = unlimited.cpt_bytes / 2;
+    session = epc_parse_input_with_options(p_expr, input, &options);
+    CHECK_TRUE(session.result.is_error);
+    CHECK_EQUAL(EPC_PARSE_ERROR_MEMORY_LIMIT, session.result.data.error->kind);
+    epc_parse_session_destroy(&session);
+
+    options = {};
+    options.limits.max_parser_calls = unlimited.parser_calls - 1;
+    session = epc_parse_input_with_options(p_expr, input, &options);
+    CHECK_TRUE(session.result.is_error);
+    CHECK_EQUAL(EPC_PARSE_ERROR_STEP_LIMIT, session.result.data.error->kind);
+    STRCMP_CONTAINS("parser calls", session.result.data.error->expected);
+    epc_parse_session_destroy(&session);
+
+    // At the limits, the parse succeeds.
+    options.limits.max_cpt_nodes = unlimited.cpt_nodes;
+    options.limits.max_cpt_bytes = unlimited.cpt_bytes;
+    options.limits.max_parser_calls = unlimited.parser_calls;
+    options.limits.max_depth = unlimited.max_depth;
+    session = epc_parse_input_with_options(p_expr, input, &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+
+    epc_parser_list_free(list);
+}
+
+TEST(ErrorHandling, LimitsStopExponentialBacktrackingInTime)
+{
+    // Each level tries the same inner expression three times before failing
+    // on the missing ')', so the parse would take 3^40 steps.
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t * p_expr = epc_parser_allocate_l(list, "expr");
+    epc_parser_t * p_term = epc_or_l(list, "term", 2,
+                                     epc_and_l(list, "group", 3, epc_char_l(list, "open", '('), p_expr, epc_char_l(list, "close", ')')),
+                                     epc_char_l(list, "x", 'x'));
+    epc_parser_duplicate(p_expr, epc_or_l(list, "expr", 3,
+                                          epc_and_l(list, "sum", 3, p_term, epc_char_l(list, "plus", '+'), p_expr),
+                                          epc_and_l(list, "difference", 3, p_term, epc_char_l(list, "minus", '-'), p_expr),
+                                          p_term));
+    char input[64] = {};
+    memset(input, '(', 40);
+    input[40] = 'x';
+    epc_parse_options_t options = {};
+    options.limits.max_milliseconds = 20;
+
+    epc_parse_session_t session = epc_parse_input_with_options(p_expr, input, &options);
+    CHECK_TRUE(session.result.is_error);
+    CHECK_EQUAL(EPC_PARSE_ERROR_TIME_LIMIT, session.result.data.error->kind);
+    epc_parse_session_destroy(&session);
+
+    epc_parser_list_free(list);
+}
+
+// --- Progress and cancellation ---
+
+typedef struct
+{
+    int calls;
+    size_t last_offset;
+    size_t input_length;
+    size_t cancel_at;   // Cancels once this far into the input, if not 0.
+} progress_record_t;
+
+static bool
+record_progress(epc_progress_info_t const * info, void * user_data)
+{
+    progress_record_t * record = (progress_record_t *)user_data;
+    record->calls++;
+    CHECK_TRUE(info->offset >= record->last_offset);
+    record->last_offset = info->offset;
+    record->input_length = info->input_length;
+    return record->cancel_at == 0 || info->offset < record->cancel_at;
+}
+
+TEST(ErrorHandling, ProgressReportedEveryNBytes)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t * p_as = epc_many_l(list, "as", epc_char_l(list, "a", 'a'));
+    char input[101] = {};
+    memset(input, 'a', 100);
+    progress_record_t record = {};
+    epc_parse_options_t options = {};
+    options.progress.callback = record_progress;
+    options.progress.user_data = &record;
+    options.progress.every_bytes = 10;
+
+    epc_parse_session_t session = epc_parse_input_with_options(p_as, input, &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+
+    // At offsets 10, 20... 100.
+    CHECK_EQUAL(10, record.calls);
+    CHECK_EQUAL(100, record.last_offset);
+    CHECK_EQUAL(100, record.input_length);
+
+    // Every 50 parser calls: 'many' and 101 tries of 'a'.
+    record = {};
+    options.progress.every_bytes = 0;
+    options.progress.every_calls = 50;
+    session = epc_parse_input_with_options(p_as, input, &options);
+    CHECK_FALSE(session.result.is_error);
+    epc_parse_session_destroy(&session);
+    CHECK_EQUAL(2, record.calls);
+
+    epc_parser_list_free(list);
+}
+
+TEST(ErrorHandling, ProgressCallbackCancelsParse)
+{
+    epc_parser_list * list = epc_parser_list_create();
+    epc_parser_t * p_as = epc_many_l(list, "as", epc_char_l(list, "a", 'a'));
+    char input[101] = {};
+    memset(input, 'a', 100);
+    progress_record_t record = {};
+    record.cancel_at = 50;
+    epc_parse_options_t options = {};
+    options.progress.callback = record_progress;
+    options.progress.user_data = &record;
+    options.progress.every_bytes = 10;
+
+    epc_parse_session_t session = epc_parse_input_with_options(p_as, input, &options);
+    CHECK_TRUE(session.result.is_error);
+    CHECK_EQUAL(EPC_PARSE_ERROR_CANCELLED, session.result.data.error->kind);
+    STRCMP_EQUAL("Parse cancelled", session.result.data.error->message);
+    STRCMP_EQUAL(input + 50, session.result.data.error->input_position);
+    // The parse stopped at the first report at or past offset 50.
+    CHECK_EQUAL(5, record.calls);
+    epc_parse_session_destroy(&session);
+
+    epc_parser_list_free(list);
+}
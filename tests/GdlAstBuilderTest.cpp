@@ -87,6 +87,38 @@ TEST(GdlAstBuilderTest, RuleDefinitionWithCharRange)
     LONGS_EQUAL('z', char_range_node->data.char_range.end_char);
 }
 
+TEST(GdlAstBuilderTest, EscapedCharactersAreDecoded)
+{
+    const char *gdl_input = "MyEscapeRule = '\\n' '\\t' '\\\\' [\\t-\\r];";
+    session = epc_parse_input(gdl_grammar, gdl_input);
+
+    CHECK_FALSE(session.result.is_error);
+    ast_build_result = epc_ast_build(session.result.data.success, ast_registry, NULL);
+
+    CHECK_FALSE(ast_build_result.has_error);
+    gdl_ast_node_t *program_node = (gdl_ast_node_t *)ast_build_result.ast_root;
+    gdl_ast_node_t *rule_def_node = program_node->data.program.rules.head->item;
+    gdl_ast_node_t *alternative_node = rule_def_node->data.rule_def.definition;
+    gdl_ast_node_t *sequence_node = alternative_node->data.alternative.alternatives.head->item;
+    CHECK(sequence_node->data.sequence.elements.count == 4);
+
+    gdl_ast_list_node_t *element = sequence_node->data.sequence.elements.head;
+    char const expected_literals[] = { '\n', '\t', '\\' };
+    for (size_t i = 0; i < sizeof(expected_literals); i++)
+    {
+        gdl_ast_node_t *terminal_node = element->item;
+        LONGS_EQUAL(GDL_AST_NODE_TYPE_TERMINAL, terminal_node->type);
+        LONGS_EQUAL(GDL_AST_NODE_TYPE_CHAR_LITERAL, terminal_node->data.terminal.expression->type);
+        LONGS_EQUAL(expected_literals[i], terminal_node->data.terminal.expression->data.char_literal.value);
+        element = element->next;
+    }
+
+    gdl_ast_node_t *char_range_node = element->item;
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_CHAR_RANGE, char_range_node->type);
+    LONGS_EQUAL('\t', char_range_node->data.char_range.start_char);
+    LONGS_EQUAL('\r', char_range_node->data.char_range.end_char);
+}
+
 TEST(GdlAstBuilderTest, RuleDefinitionWithSemanticAction)
 {
     const char *gdl_input = "MyActionRule = 'a' @my_action;";
@@ -224,6 +256,33 @@ TEST(GdlAstBuilderTest, RuleDefinitionWithAlternative)
     LONGS_EQUAL('b', terminal_node->data.terminal.expression->data.char_literal.value);
 }
 
+TEST(GdlAstBuilderTest, RuleDefinitionWithCut)
+{
+    const char *gdl_input = "MyCutRule = 'a' ~ 'b' | 'c';";
+    session = epc_parse_input(gdl_grammar, gdl_input);
+
+    CHECK_FALSE(session.result.is_error);
+    ast_build_result = epc_ast_build(session.result.data.success, ast_registry, NULL);
+
+    CHECK_FALSE(ast_build_result.has_error);
+    CHECK(ast_build_result.ast_root != NULL);
+
+    gdl_ast_node_t *program_node = (gdl_ast_node_t *)ast_build_result.ast_root;
+    gdl_ast_node_t *rule_def_node = program_node->data.program.rules.head->item;
+    gdl_ast_node_t *definition_node = rule_def_node->data.rule_def.definition;
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_ALTERNATIVE, definition_node->type);
+    CHECK(definition_node->data.alternative.alternatives.count == 2);
+
+    gdl_ast_node_t *first_sequence = definition_node->data.alternative.alternatives.head->item;
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_SEQUENCE, first_sequence->type);
+    CHECK(first_sequence->data.sequence.elements.count == 3);
+
+    gdl_ast_node_t * cut_terminal = first_sequence->data.sequence.elements.head->next->item;
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_TERMINAL, cut_terminal->type);
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_KEYWORD, cut_terminal->data.terminal.expression->type);
+    STRCMP_EQUAL("~", cut_terminal->data.terminal.expression->data.keyword.name);
+}
+
 TEST(GdlAstBuilderTest, RuleDefinitionWithRepetition)
 {
     const char *gdl_input = "MyStarRule = 'a'*;";
@@ -386,3 +445,29 @@ TEST(GdlAstBuilderTest, RuleDefinitionWithOptionalAbsent)
 }
 #endif
 
+
+TEST(GdlAstBuilderTest, TokenRuleDefinition)
+{
+    // 'token' is only a keyword when it's followed by the rule name.
+    const char *gdl_input = "token Number = digit+;\ntoken = \"token\";\ntokens = Number | token;";
+    session = epc_parse_input(gdl_grammar, gdl_input);
+
+    CHECK_FALSE(session.result.is_error);
+    ast_build_result = epc_ast_build(session.result.data.success, ast_registry, NULL);
+
+    CHECK_FALSE(ast_build_result.has_error);
+    gdl_ast_node_t *program_node = (gdl_ast_node_t *)ast_build_result.ast_root;
+    CHECK(program_node->data.program.rules.count == 3);
+
+    gdl_ast_list_node_t *rule_list_node = program_node->data.program.rules.head;
+    STRCMP_EQUAL("Number", rule_list_node->item->data.rule_def.name);
+    CHECK_TRUE(rule_list_node->item->data.rule_def.is_token);
+    rule_list_node = rule_list_node->next;
+    STRCMP_EQUAL("token", rule_list_node->item->data.rule_def.name);
+    CHECK_FALSE(rule_list_node->item->data.rule_def.is_token);
+    rule_list_node = rule_list_node->next;
+    STRCMP_EQUAL("tokens", rule_list_node->item->data.rule_def.name);
+    CHECK_FALSE(rule_list_node->item->data.rule_def.is_token);
+
+    gdl_ast_node_free(program_node, NULL);
+}
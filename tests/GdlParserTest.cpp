@@ -86,10 +86,12 @@ TEST(GdlParserTest, ParseSimpleIdentifierRule) {
     // Get RuleDefinition node
     epc_cpt_node_t* rule_def_node = many_rule_defs_node->children[0];
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
-    CHECK_EQUAL(5, rule_def_node->children_count); // Identifier, EqualsChar, DefinitionExpression, OptionalSemanticAction, SemicolonChar
+    CHECK_EQUAL(5, rule_def_node->children_count); // RuleName, EqualsChar, DefinitionExpression, OptionalSemanticAction, SemicolonChar
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -188,8 +190,10 @@ TEST(GdlParserTest, ParseSimpleStringLiteralRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyStringRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -254,8 +258,10 @@ TEST(GdlParserTest, ParseSimpleCharLiteralRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyCharRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -320,8 +326,10 @@ TEST(GdlParserTest, ParseSimpleCharRangeRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyRangeRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -384,8 +392,10 @@ TEST(GdlParserTest, ParseSimpleSequenceRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MySeqRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -475,8 +485,10 @@ TEST(GdlParserTest, ParseSimpleChoiceRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyChoiceRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -590,8 +602,10 @@ TEST(GdlParserTest, ParseSimpleOptionalRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyOptionalRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -695,8 +709,10 @@ TEST(GdlParserTest, ParseSimplePlusRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyPlusRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -798,8 +814,10 @@ TEST(GdlParserTest, ParseSimpleStarRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyStarRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -901,8 +919,10 @@ TEST(GdlParserTest, ParseOneofCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyOneofRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1004,8 +1024,10 @@ TEST(GdlParserTest, ParseNoneofCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyNoneofRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1108,8 +1130,10 @@ TEST(GdlParserTest, ParseCountCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyCountRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1248,8 +1272,10 @@ TEST(GdlParserTest, ParseBetweenCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyBetweenRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1395,8 +1421,10 @@ TEST(GdlParserTest, ParseDelimitedCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyDelimitedRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1527,8 +1555,10 @@ TEST(GdlParserTest, ParseLookaheadCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyLookaheadRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1652,8 +1682,10 @@ TEST(GdlParserTest, ParseNotCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyNotRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1777,8 +1809,10 @@ TEST(GdlParserTest, ParseLexemeCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyLexemeRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1902,8 +1936,10 @@ TEST(GdlParserTest, ParseSkipCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MySkipRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -2027,8 +2063,10 @@ TEST(GdlParserTest, ParseChainl1CallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyChainl1Rule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -2158,8 +2196,10 @@ TEST(GdlParserTest, ParseChainr1CallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyChainr1Rule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -2289,8 +2329,10 @@ TEST(GdlParserTest, ParsePassthruCallRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyPassthruRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -2413,8 +2455,10 @@ TEST(GdlParserTest, ParseSemanticActionRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier (MyRule)
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier (MyRule)
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -2483,8 +2527,10 @@ TEST(GdlParserTest, ParseNumberLiteralRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyNumberRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -2554,8 +2600,10 @@ TEST(GdlParserTest, ParseParenthesizedExpressionRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyParenthesizedRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -2670,8 +2718,10 @@ TEST(GdlParserTest, ParseDoubleKeywordRule) {
     STRCMP_EQUAL("RuleDefinition", rule_def_node->name);
     CHECK_EQUAL(5, rule_def_node->children_count);
 
-    // Check Identifier
-    epc_cpt_node_t* identifier_node = rule_def_node->children[0];
+    // Check RuleName, which holds just the Identifier, as this isn't a token rule
+    epc_cpt_node_t* rule_name_node = rule_def_node->children[0];
+    STRCMP_EQUAL("RuleName", rule_name_node->name);
+    epc_cpt_node_t* identifier_node = rule_name_node->children[0];
     STRCMP_EQUAL("Identifier", identifier_node->name);
     STRNCMP_EQUAL("MyDoubleRule", epc_cpt_node_get_semantic_content(identifier_node), epc_cpt_node_get_semantic_len(identifier_node));
 
@@ -1,15 +1,26 @@
 #include "CppUTest/TestHarness.h"
 #include "easy_pc/easy_pc.h"
+#include "easy_pc/easy_pc_grammar.h"
+#include "easy_pc/easy_pc_gdl.h"
 
 extern "C" {
 #include "gdl_parser.h"
+#include "gdl_generated.h"
 #include "gdl_compiler_ast_actions.h"
 #include "gdl_code_generator.h"
+#include "gdl_code_generator_common.h"
+#include "gdl_optimizer.h"
+#include "gdl_profile.h"
+#include "gdl_grammar_analysis.h"
+#include "gdl_token_dfa.h"
 }
 
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h> // For system()
+#include <sys/stat.h>
+
+#include <vector>
 
 TEST_GROUP(GeneratedParserTest)
 {
@@ -44,8 +55,9 @@ TEST_GROUP(GeneratedParserTest)
         epc_parse_session_destroy(&session);
         epc_parser_list_free(parser_list);
         epc_ast_hook_registry_free(ast_registry);
-        // Clean up generated files
-        // system("rm -f simple_test_language.h simple_test_language.c simple_test_language_actions.h");
+        // Clean up the files the tests generate: simple_test_language, simple_direct_test_language,
+        // optimized_test_language, sharded_test_language_shard_1.c and the like.
+        system("rm -f *_test_language.c *_test_language.h *_test_language_*.c *_test_language_*.h *_test_language.epcg");
     }
 };
 
@@ -95,3 +107,790 @@ TEST(GeneratedParserTest, GeneratesFilesWithFwdRefSuccessfully)
     CHECK_TRUE(gdl_generate_c_code((gdl_ast_node_t *)ast_build_result.ast_root, base_name, output_dir));
 }
 
+
+TEST(GeneratedParserTest, DeclaresSelfReferencingRulesAhead)
+{
+    const char *gdl_input =
+        "Expr = Expr '+' digit | digit;\n"
+        "Program = Expr eoi;\n";
+    char text[4096];
+
+    generate_ast(gdl_input);
+    CHECK_TRUE(gdl_generate_c_code((gdl_ast_node_t *)ast_build_result.ast_root, "self_ref_test_language", "."));
+
+    FILE * source = fopen("self_ref_test_language.c", "r");
+    CHECK(source != NULL);
+    text[fread(text, 1, sizeof(text) - 1, source)] = '\0';
+    fclose(source);
+    CHECK(strstr(text, "epc_parser_t * Expr = epc_parser_allocate_l(list, \"Expr\");") != NULL);
+    CHECK(strstr(text, "epc_parser_duplicate(Expr, Expr_def);") != NULL);
+}
+
+TEST(GeneratedParserTest, GeneratesDirectFilesSuccessfully)
+{
+    const char *output_dir = ".";
+    const char *base_name = "simple_direct_test_language";
+    const char *gdl_input =
+        "Greeting = \"hello\";\n"
+        "World = \"world\";\n"
+        "CharX = 'x';\n"
+        "SeqGreeting = Greeting World SeqChar;\n"
+        "SeqChar = CharX ('y' | 'z')+ [a-c]? ~ digit*;\n"
+        "Keyword = \"if\" | \"else\";\n"
+        "List = delimited(int, ',');\n"
+        "Triple = count(3, digit);\n"
+        "Group = between('(', double, ')');\n"
+        "SimpleRule = SeqGreeting | SeqChar | Keyword | List | Triple | Group;\n"
+        "Program = SimpleRule eoi @EPC_AST_SEMANTIC_ACTION_PROGRAM_RULE;\n";
+
+    generate_ast(gdl_input);
+
+    CHECK_TRUE(gdl_generate_direct_c_code((gdl_ast_node_t *)ast_build_result.ast_root, base_name, output_dir));
+}
+
+TEST(GeneratedParserTest, GeneratesStaticFilesSuccessfully)
+{
+    const char *output_dir = ".";
+    const char *base_name = "simple_static_test_language";
+    const char *gdl_input =
+        "Greeting = \"hello\";\n"
+        "Expr = Expr '+' digit | digit;\n"
+        "Keyword = \"if\" | \"else\";\n"
+        "List = delimited(int, ',');\n"
+        "Alias = Keyword @KEYWORD;\n"
+        "SimpleRule = Greeting | Expr | Alias | List | Word;\n"
+        "Word = lexeme(alpha+) | count(2, '_');\n"
+        "Program = SimpleRule eoi @EPC_AST_SEMANTIC_ACTION_PROGRAM_RULE;\n";
+
+    generate_ast(gdl_input);
+
+    CHECK_TRUE(gdl_generate_static_c_code((gdl_ast_node_t *)ast_build_result.ast_root, base_name, output_dir));
+
+    // Only the left-recursive rule grows its match from a seed.
+    char text[16384];
+    FILE * source = fopen("simple_static_test_language.c", "r");
+    CHECK(source != NULL);
+    text[fread(text, 1, sizeof(text) - 1, source)] = '\0';
+    fclose(source);
+    CHECK(strstr(text, "static const epc_parser_t Expr = {\n    .parse_fn = epc_left_recursive_rule_parse_fn,") != NULL);
+    CHECK(strstr(text, "static const epc_parser_t Word = {\n    .parse_fn = epc_rule_parse_fn,") != NULL);
+}
+
+static ino_t
+file_inode(char const * path)
+{
+    struct stat st;
+    return stat(path, &st) == 0 ? st.st_ino : 0;
+}
+
+TEST(GeneratedParserTest, GeneratesShardedFilesOnlyWhenChanged)
+{
+    const char *gdl_input =
+        "token Number = lexeme(digit+);\n"
+        "Value = Number | between(lexeme('('), Sum, lexeme(')'));\n"
+        "Sum = chainl1(Value, lexeme('+')) @SUM;\n"
+        "Program = Sum eoi @PROGRAM;\n";
+    char text[4096];
+
+    system("rm -f sharded_test_language*");
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+    CHECK_TRUE(gdl_generate_sharded_c_code(program, "sharded_test_language", ".", 2));
+
+    // Sum is referenced before it is defined, from the other shard.
+    FILE * shard = fopen("sharded_test_language_shard_1.c", "r");
+    CHECK(shard != NULL);
+    text[fread(text, 1, sizeof(text) - 1, shard)] = '\0';
+    fclose(shard);
+    CHECK(strstr(text, "between_l(list, NULL, epc_lexeme_l(list, NULL, epc_char_l(list, NULL, '(')), rules[2]") != NULL);
+    CHECK(strstr(text, "epc_dfa_l(list, \"Number\", token_dfas[0])") != NULL);
+    CHECK(fopen("sharded_test_language_shard_3.c", "r") == NULL);
+
+    // The same grammar again leaves the files alone, but a change is written out.
+    ino_t shard_1 = file_inode("sharded_test_language_shard_1.c");
+    ino_t shard_2 = file_inode("sharded_test_language_shard_2.c");
+    CHECK(shard_1 != 0 && shard_2 != 0);
+    CHECK_TRUE(gdl_generate_sharded_c_code(program, "sharded_test_language", ".", 2));
+    LONGS_EQUAL(shard_1, file_inode("sharded_test_language_shard_1.c"));
+    LONGS_EQUAL(shard_2, file_inode("sharded_test_language_shard_2.c"));
+    gdl_ast_node_t * program_rule = program->data.program.rules.tail->item;
+    gdl_ast_node_free(program_rule->data.rule_def.semantic_action, NULL);
+    program_rule->data.rule_def.semantic_action = NULL;
+    CHECK_TRUE(gdl_generate_sharded_c_code(program, "sharded_test_language", ".", 2));
+    LONGS_EQUAL(shard_1, file_inode("sharded_test_language_shard_1.c"));
+    CHECK(shard_2 != file_inode("sharded_test_language_shard_2.c"));
+
+    gdl_ast_node_free(program, NULL);
+}
+
+TEST(GeneratedParserTest, DirectBackendRejectsLeftRecursion)
+{
+    const char *output_dir = ".";
+    const char *base_name = "left_recursive_direct_test_language";
+    const char *gdl_input =
+        "Expr = Expr '+' digit | digit;\n"
+        "Program = Expr eoi;\n";
+
+    generate_ast(gdl_input);
+
+    CHECK_FALSE(gdl_generate_direct_c_code((gdl_ast_node_t *)ast_build_result.ast_root, base_name, output_dir));
+}
+
+TEST(GeneratedParserTest, OptimizerRemovesUnusedAndInlinesRules)
+{
+    const char *gdl_input =
+        "Unused = \"never\";\n"
+        "UnusedWithAction = digit @NUMBER;\n"
+        "Sign = '-';\n"
+        "Number = Sign? digit+ @NUMBER;\n"
+        "Expr = Number | '(' Expr ')';\n"
+        "Program = Expr eoi;\n";
+    gdl_optimizer_stats_t stats;
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+
+    CHECK_TRUE(gdl_optimize(program, &stats));
+
+    // Unused and Sign are gone. Rules with actions and recursive rules are kept.
+    LONGS_EQUAL(1, stats.rules_removed);
+    LONGS_EQUAL(1, stats.rules_inlined);
+    LONGS_EQUAL(4, program->data.program.rules.count);
+    gdl_ast_list_node_t * rule = program->data.program.rules.head;
+    STRCMP_EQUAL("UnusedWithAction", rule->item->data.rule_def.name);
+    rule = rule->next;
+    STRCMP_EQUAL("Number", rule->item->data.rule_def.name);
+    rule = rule->next;
+    STRCMP_EQUAL("Expr", rule->item->data.rule_def.name);
+    rule = rule->next;
+    STRCMP_EQUAL("Program", rule->item->data.rule_def.name);
+
+    gdl_ast_node_free(program, NULL);
+}
+
+TEST(GeneratedParserTest, OptimizerMergesLiteralsAndCharacters)
+{
+    const char *gdl_input =
+        "Program = ('+' | ('-' | alpha)) ('<' | \"*\" | oneof(\"/%\")) '=' ('>' \"\\\\\" digit) eoi;\n";
+    gdl_optimizer_stats_t stats;
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+
+    CHECK_TRUE(gdl_optimize(program, &stats));
+
+    LONGS_EQUAL(2, stats.nodes_flattened);
+    LONGS_EQUAL(2, stats.literals_merged);
+    LONGS_EQUAL(1, stats.char_sets_created);
+
+    gdl_ast_node_t * sequence = program->data.program.rules.head->item->data.rule_def.definition;
+    while (sequence->type != GDL_AST_NODE_TYPE_SEQUENCE)
+    {
+        sequence = sequence->data.alternative.alternatives.head->item;
+    }
+    LONGS_EQUAL(5, sequence->data.sequence.elements.count);
+    gdl_ast_list_node_t * element = sequence->data.sequence.elements.head;
+    gdl_ast_node_t * sign = element->item;
+    while (sign->type == GDL_AST_NODE_TYPE_TERMINAL)
+    {
+        sign = sign->data.terminal.expression;
+    }
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_ALTERNATIVE, sign->type);
+    LONGS_EQUAL(3, sign->data.alternative.alternatives.count);
+    element = element->next;
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_COMBINATOR_ONEOF, element->item->type);
+    STRCMP_EQUAL("<*/%", element->item->data.none_or_one_of_call.args);
+    element = element->next;
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_STRING_LITERAL, element->item->type);
+    STRCMP_EQUAL("=>\\\\", element->item->data.string_literal.value);
+
+    CHECK_TRUE(gdl_generate_c_code(program, "optimized_test_language", "."));
+
+    gdl_ast_node_free(program, NULL);
+}
+
+TEST(GeneratedParserTest, OnlyOptimizerMakesKeywordSets)
+{
+    const char *gdl_input =
+        "Word = \"if\" | \"else\" @WORD;\n"
+        "Program = (\"in\" | \"int\") (\"let\" | \"var\") Word eoi;\n";
+    gdl_optimizer_stats_t stats;
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+    gdl_ast_node_t * word = program->data.program.rules.head->item->data.rule_def.definition;
+    gdl_ast_node_t * sequence = program->data.program.rules.tail->item->data.rule_def.definition;
+    while (sequence->type != GDL_AST_NODE_TYPE_SEQUENCE)
+    {
+        sequence = sequence->data.alternative.alternatives.head->item;
+    }
+    gdl_ast_node_t * prefixed = sequence->data.sequence.elements.head->item;
+    gdl_ast_node_t * declaration = sequence->data.sequence.elements.head->next->item;
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_ALTERNATIVE, word->type);
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_ALTERNATIVE, prefixed->type);
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_ALTERNATIVE, declaration->type);
+
+    // Without the optimizer, alternations stay as epc_or, so the CPT keeps its shape.
+    CHECK_TRUE(alternative_can_be_keyword_set(declaration));
+    CHECK_FALSE(alternative_is_keyword_set(declaration));
+
+    CHECK_TRUE(gdl_optimize(program, &stats));
+
+    // "in" is a prefix of "int", and Word's alternation is what its action sees, so only one changes.
+    LONGS_EQUAL(1, stats.keyword_sets_created);
+    CHECK_TRUE(alternative_is_keyword_set(declaration));
+    CHECK_FALSE(alternative_is_keyword_set(prefixed));
+    CHECK_FALSE(alternative_is_keyword_set(word));
+
+    gdl_ast_node_free(program, NULL);
+}
+
+TEST(GeneratedParserTest, AnalysisReportsFollowSetsAndBacktracking)
+{
+    const char *gdl_input =
+        "Sign = oneof(\"+-\");\n"
+        "Number = Sign? digit+;\n"
+        "Word = \"let\" | \"if\" | alpha+;\n"
+        "Spaces = (space?)*;\n"
+        "Item = Number | Word | '(' Items ')';\n"
+        "Items = delimited(Item, ',');\n"
+        "Program = Items Spaces eoi;\n";
+    gdl_grammar_analysis_t analysis;
+    gdl_grammar_report_stats_t stats;
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+    CHECK_TRUE(gdl_grammar_analyze(program, &analysis));
+
+    gdl_rule_analysis_t * number = gdl_grammar_analysis_find_rule(&analysis, "Number");
+    CHECK_FALSE(number->nullable);
+    CHECK_TRUE(gdl_char_set_contains(&number->first, '+'));
+    CHECK_TRUE(gdl_char_set_contains(&number->first, '7'));
+    // Items is followed by ')', its delimiter, or the spaces and end of the input.
+    CHECK_TRUE(gdl_char_set_contains(&number->follow, ')'));
+    CHECK_TRUE(gdl_char_set_contains(&number->follow, ','));
+    CHECK_TRUE(gdl_char_set_contains(&number->follow, ' '));
+    CHECK_TRUE(gdl_char_set_contains(&number->follow, '\0'));
+    CHECK_FALSE(gdl_char_set_contains(&number->follow, 'a'));
+    gdl_rule_analysis_t * sign = gdl_grammar_analysis_find_rule(&analysis, "Sign");
+    CHECK_TRUE(gdl_char_set_contains(&sign->follow, '0'));
+    CHECK_FALSE(gdl_char_set_contains(&sign->follow, '\0'));
+
+    FILE * report = tmpfile();
+    CHECK(report != NULL);
+    gdl_grammar_write_report(&analysis, report, &stats);
+    fclose(report);
+
+    // "let" and "if" both start like alpha+. Item's alternatives start differently.
+    LONGS_EQUAL(2, stats.alternations);
+    LONGS_EQUAL(1, stats.ll1_alternations);
+    LONGS_EQUAL(1, stats.nullable_repetitions);
+
+    gdl_grammar_analysis_free(&analysis);
+    gdl_ast_node_free(program, NULL);
+}
+
+TEST(GeneratedParserTest, TokenRulesShareAMinimizedDfa)
+{
+    const char *gdl_input =
+        "token Number = lexeme(digit+ ('.' digit+)?);\n"
+        "token Word = lexeme(\"if\" | alpha+);\n"
+        "Program = (Number | Word)+ eoi;\n";
+    gdl_token_dfa_t dfa;
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+    gdl_ast_node_t * number_rule = program->data.program.rules.head->item;
+    gdl_ast_node_t * number_definition = number_rule->data.rule_def.definition;
+    CHECK_TRUE(number_rule->data.rule_def.is_token);
+    CHECK_FALSE(program->data.program.rules.tail->item->data.rule_def.is_token);
+
+    CHECK_TRUE(gdl_token_dfa_build(program, &dfa));
+    LONGS_EQUAL(2, dfa.token_count);
+    POINTERS_EQUAL(number_rule, dfa.tokens[0].rule);
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_TOKEN_DFA, (*dfa.tokens[0].slot)->type);
+    LONGS_EQUAL(GDL_AST_NODE_TYPE_TOKEN_DFA, (*dfa.tokens[1].slot)->type);
+    // digits, '.', letters and everything else.
+    LONGS_EQUAL(4, dfa.class_count);
+
+    epc_dfa_t number = {dfa.classes, dfa.transitions, dfa.accepting, dfa.class_count, dfa.tokens[0].start};
+    epc_dfa_t word = {dfa.classes, dfa.transitions, dfa.accepting, dfa.class_count, dfa.tokens[1].start};
+    epc_parser_t * p_number = epc_dfa("Number", &number);
+    epc_parser_t * p_word = epc_dfa("Word", &word);
+
+    epc_parse_session_t token_session = epc_parse_input(p_number, "12.5x");
+    CHECK_FALSE(token_session.result.is_error);
+    LONGS_EQUAL(4, token_session.result.data.success->len);
+    epc_parse_session_destroy(&token_session);
+    token_session = epc_parse_input(p_number, "x");
+    CHECK_TRUE(token_session.result.is_error);
+    epc_parse_session_destroy(&token_session);
+    // The longest match wins over the first alternative.
+    token_session = epc_parse_input(p_word, "iffy");
+    CHECK_FALSE(token_session.result.is_error);
+    LONGS_EQUAL(4, token_session.result.data.success->len);
+    epc_parse_session_destroy(&token_session);
+    epc_parsers_free(2, p_number, p_word);
+
+    gdl_token_dfa_free(&dfa);
+    POINTERS_EQUAL(number_definition, number_rule->data.rule_def.definition);
+    CHECK(number_definition->type != GDL_AST_NODE_TYPE_TOKEN_DFA);
+
+    CHECK_TRUE(gdl_generate_c_code(program, "token_test_language", "."));
+    CHECK_TRUE(gdl_generate_static_c_code(program, "token_static_test_language", "."));
+    CHECK_TRUE(gdl_generate_direct_c_code(program, "token_direct_test_language", "."));
+
+    gdl_ast_node_free(program, NULL);
+}
+
+TEST(GeneratedParserTest, TokenRuleMustBeRegular)
+{
+    const char *gdl_input =
+        "token Nested = '(' Nested? ')';\n"
+        "Program = Nested eoi;\n";
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+    CHECK_FALSE(gdl_generate_c_code(program, "token_test_language", "."));
+    CHECK_FALSE(gdl_generate_direct_c_code(program, "token_direct_test_language", "."));
+
+    gdl_ast_node_free(program, NULL);
+}
+
+TEST(GeneratedParserTest, GrammarBlobBuildsTheSameParsers)
+{
+    const char *gdl_input =
+        "token Number = lexeme(digit+);\n"
+        "Op = lexeme(\"+\" | \"-\");\n"
+        "Sum = chainl1(Term, Op) @SUM;\n"
+        "Term = Number | lexeme('(') Sum lexeme(')') @TERM;\n"
+        "Program = Sum eoi @PROGRAM;\n";
+    unsigned char * blob;
+    size_t size;
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+    CHECK_TRUE(gdl_build_grammar_blob(program, &blob, &size));
+    CHECK_TRUE(gdl_generate_grammar_blob(program, "blob_test_language", "."));
+    gdl_ast_node_free(program, NULL);
+
+    epc_grammar_t * grammar = epc_grammar_load_blob(blob, size);
+    CHECK(grammar != NULL);
+    // Nothing refers to the blob once it has been loaded.
+    memset(blob, 0, size);
+    LONGS_EQUAL(3, epc_grammar_action_count(grammar));
+    STRCMP_EQUAL("SUM", epc_grammar_action_name(grammar, 0));
+    STRCMP_EQUAL("PROGRAM", epc_grammar_action_name(grammar, 2));
+    POINTERS_EQUAL(NULL, epc_grammar_action_name(grammar, 3));
+
+    epc_parse_session_t blob_session = epc_parse_input(epc_grammar_parser(grammar), "1 + (20 - 3)");
+    CHECK_FALSE(blob_session.result.is_error);
+    epc_cpt_node_t * root = blob_session.result.data.success;
+    STRCMP_EQUAL("Program", root->name);
+    LONGS_EQUAL(2, root->ast_config.action);
+    STRCMP_EQUAL("Sum", root->children[0]->name);
+    LONGS_EQUAL(0, root->children[0]->ast_config.action);
+    epc_parse_session_destroy(&blob_session);
+
+    blob_session = epc_parse_input(epc_grammar_parser(grammar), "1 + (20 -");
+    CHECK_TRUE(blob_session.result.is_error);
+    epc_parse_session_destroy(&blob_session);
+    epc_grammar_free(grammar);
+    free(blob);
+}
+
+TEST(GeneratedParserTest, GrammarBlobIsCheckedBeforeUse)
+{
+    const char *gdl_input =
+        "Word = alpha+ @WORD;\n"
+        "Program = Word (',' Word)* eoi;\n";
+    unsigned char * blob;
+    size_t size;
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+    CHECK_TRUE(gdl_build_grammar_blob(program, &blob, &size));
+    gdl_ast_node_free(program, NULL);
+
+    epc_grammar_t * grammar = epc_grammar_load_blob(blob, size);
+    CHECK(grammar != NULL);
+    epc_grammar_free(grammar);
+
+    // Truncated, anywhere.
+    for (size_t truncated = 0; truncated < size; truncated++)
+    {
+        POINTERS_EQUAL(NULL, epc_grammar_load_blob(blob, truncated));
+    }
+    // Another version of the format.
+    blob[EPC_GRAMMAR_BLOB_HEADER_VERSION * 4] = EPC_GRAMMAR_BLOB_VERSION + 1;
+    POINTERS_EQUAL(NULL, epc_grammar_load_blob(blob, size));
+    blob[EPC_GRAMMAR_BLOB_HEADER_VERSION * 4] = EPC_GRAMMAR_BLOB_VERSION;
+    // A parser that refers to itself rather than to an earlier parser.
+    size_t parsers = blob[EPC_GRAMMAR_BLOB_HEADER_PARSERS * 4] | blob[EPC_GRAMMAR_BLOB_HEADER_PARSERS * 4 + 1] << 8;
+    size_t first_operand = parsers + 4 * 4;
+    LONGS_EQUAL(EPC_GRAMMAR_OP_ALPHA, blob[parsers]);
+    blob[parsers] = EPC_GRAMMAR_OP_PLUS;
+    blob[first_operand] = 0;
+    POINTERS_EQUAL(NULL, epc_grammar_load_blob(blob, size));
+
+    free(blob);
+}
+
+// Lays out a blob with a string pool holding just "R", then the given parser records, which end the blob.
+static std::vector<unsigned char>
+make_grammar_blob(std::vector<uint32_t> const & records, uint32_t parser_count, uint32_t start)
+{
+    uint32_t const strings = EPC_GRAMMAR_BLOB_HEADER_WORDS * 4;
+    uint32_t const parsers = strings + 4;
+    uint32_t const size = parsers + (uint32_t)records.size() * 4;
+    std::vector<uint32_t> words(EPC_GRAMMAR_BLOB_HEADER_WORDS);
+
+    words[EPC_GRAMMAR_BLOB_HEADER_MAGIC] = EPC_GRAMMAR_BLOB_MAGIC;
+    words[EPC_GRAMMAR_BLOB_HEADER_VERSION] = EPC_GRAMMAR_BLOB_VERSION;
+    words[EPC_GRAMMAR_BLOB_HEADER_SIZE] = size;
+    words[EPC_GRAMMAR_BLOB_HEADER_START] = start;
+    words[EPC_GRAMMAR_BLOB_HEADER_PARSER_COUNT] = parser_count;
+    words[EPC_GRAMMAR_BLOB_HEADER_PARSERS] = parsers;
+    words[EPC_GRAMMAR_BLOB_HEADER_STRINGS] = strings;
+    words[EPC_GRAMMAR_BLOB_HEADER_STRINGS_SIZE] = 4;
+    words[EPC_GRAMMAR_BLOB_HEADER_ACTION_COUNT] = 0;
+    words[EPC_GRAMMAR_BLOB_HEADER_ACTIONS] = EPC_GRAMMAR_BLOB_NONE;
+    words[EPC_GRAMMAR_BLOB_HEADER_DFA] = EPC_GRAMMAR_BLOB_NONE;
+    words.push_back('R');
+    words.insert(words.end(), records.begin(), records.end());
+
+    std::vector<unsigned char> blob;
+    for (uint32_t word : words)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            blob.push_back((unsigned char)(word >> shift));
+        }
+    }
+    return blob;
+}
+
+TEST(GeneratedParserTest, MalformedGrammarBlobsAreRejected)
+{
+    uint32_t const none = EPC_GRAMMAR_BLOB_NONE;
+    // R = 'x'; Start = R*; with R referred to before it is defined.
+    std::vector<uint32_t> const records = {
+        EPC_GRAMMAR_OP_FORWARD, 0, none, 0,
+        EPC_GRAMMAR_OP_MANY, none, none, 1, 0,
+        EPC_GRAMMAR_OP_CHAR, none, none, 1, 'x',
+        EPC_GRAMMAR_OP_DEFINE, none, none, 2, 0, 2,
+    };
+
+    std::vector<unsigned char> blob = make_grammar_blob(records, 4, 1);
+    epc_grammar_t * grammar = epc_grammar_load_blob(blob.data(), blob.size());
+    CHECK(grammar != NULL);
+    epc_parse_session_t session = epc_parse_input(epc_grammar_parser(grammar), "xx");
+    CHECK_FALSE(session.result.is_error);
+    LONGS_EQUAL(2, session.result.data.success->len);
+    epc_parse_session_destroy(&session);
+    epc_grammar_free(grammar);
+
+    // R is never defined.
+    std::vector<uint32_t> undefined(records.begin(), records.begin() + 9);
+    blob = make_grammar_blob(undefined, 2, 1);
+    POINTERS_EQUAL(NULL, epc_grammar_load_blob(blob.data(), blob.size()));
+
+    // The last record has fewer operands than it says.
+    std::vector<uint32_t> truncated(records.begin(), records.end() - 1);
+    blob = make_grammar_blob(truncated, 4, 1);
+    POINTERS_EQUAL(NULL, epc_grammar_load_blob(blob.data(), blob.size()));
+
+    // More records than there are.
+    blob = make_grammar_blob(records, 5, 1);
+    POINTERS_EQUAL(NULL, epc_grammar_load_blob(blob.data(), blob.size()));
+
+    // Each of these makes one word of the records out of range.
+    struct
+    {
+        size_t word;
+        uint32_t value;
+    } const out_of_range[] = {
+        { 0, EPC_GRAMMAR_OP_COUNT },        // An unknown op.
+        { 1, 4 },                           // A name past the end of the strings.
+        { 8, 3 },                           // MANY of a later record.
+        { 8, 4 },                           // MANY of a record that doesn't exist.
+        { 13, 0x100 },                      // A character that doesn't fit in a char.
+        { 18, 4 },                          // DEFINE of a record that doesn't exist.
+        { 18, 2 },                          // DEFINE of a record that isn't a forward reference.
+        { 19, 3 },                          // DEFINE with itself as the definition.
+    };
+    for (auto const & change : out_of_range)
+    {
+        std::vector<uint32_t> changed = records;
+        changed[change.word] = change.value;
+        blob = make_grammar_blob(changed, 4, 1);
+        POINTERS_EQUAL(NULL, epc_grammar_load_blob(blob.data(), blob.size()));
+    }
+
+    // A start rule that doesn't exist.
+    blob = make_grammar_blob(records, 4, 4);
+    POINTERS_EQUAL(NULL, epc_grammar_load_blob(blob.data(), blob.size()));
+}
+
+TEST(GeneratedParserTest, SelfHostedGdlParserMatchesHandWritten)
+{
+    const char *gdl_input =
+        "// Most of GDL\n"
+        "token Number = lexeme(digit+) @NUMBER;\n"
+        "Name = lexeme((alpha | '_') (alphanum | [_-_])*);\n"
+        "Text = lexeme('\"' noneof(\"\\\"\\\\\")* \"\\\"\");\n"
+        "List = between(lexeme('['), delimited(Value, lexeme(',')), lexeme(']')) @LIST;\n"
+        "Sum = chainl1(Value, lexeme(oneof(\"+-\"))) | chainr1(Value, lexeme('^')) @SUM;\n"
+        "Value = Number | Text | List | not(Number) lookahead(Name) ~ Name | fail(\"no value\");\n"
+        "Pair = Value skip(space?) passthru(Value)+;\n"
+        "Program = Sum Pair? eoi @PROGRAM;\n";
+    unsigned char * hand_written_blob;
+    size_t hand_written_size;
+    unsigned char * generated_blob;
+    size_t generated_size;
+
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+    CHECK_TRUE(gdl_build_grammar_blob(program, &hand_written_blob, &hand_written_size));
+    gdl_ast_node_free(program, NULL);
+    epc_parse_session_destroy(&session);
+
+    // The same grammar, read by the parser generated from gdl.gdl, gives the same AST, and so the same blob.
+    epc_parser_list * generated_list = epc_parser_list_create();
+    epc_parse_session_t generated_session = epc_parse_input(create_gdl_generated_parser(generated_list), gdl_input);
+    CHECK_FALSE(generated_session.result.is_error);
+    epc_ast_result_t generated_ast = epc_ast_build(generated_session.result.data.success, ast_registry, NULL);
+    CHECK_FALSE(generated_ast.has_error);
+    CHECK_TRUE(gdl_build_grammar_blob((gdl_ast_node_t *)generated_ast.ast_root, &generated_blob, &generated_size));
+    gdl_ast_node_free(generated_ast.ast_root, NULL);
+
+    LONGS_EQUAL(hand_written_size, generated_size);
+    LONGS_EQUAL(0, memcmp(hand_written_blob, generated_blob, generated_size));
+
+    epc_parse_session_destroy(&generated_session);
+    generated_session = epc_parse_input(create_gdl_generated_parser(generated_list), "Rule = 'a' @ACTION");
+    CHECK_TRUE(generated_session.result.is_error);
+    epc_parse_session_destroy(&generated_session);
+    epc_parser_list_free(generated_list);
+    free(hand_written_blob);
+    free(generated_blob);
+}
+
+static void
+blob_number_action(epc_ast_builder_ctx_t * ctx, epc_cpt_node_t * node, void * * children, int count, void * user_data)
+{
+    (void)children;
+    (void)count;
+    (void)user_data;
+    long * value = (long *)malloc(sizeof(*value));
+    *value = strtol(node->content, NULL, 10);
+    epc_ast_push(ctx, value);
+}
+
+static void
+blob_sum_action(epc_ast_builder_ctx_t * ctx, epc_cpt_node_t * node, void * * children, int count, void * user_data)
+{
+    (void)node;
+    (void)user_data;
+    long * sum = (long *)calloc(1, sizeof(*sum));
+    for (int i = 0; i < count; i++)
+    {
+        *sum += *(long *)children[i];
+        free(children[i]);
+    }
+    epc_ast_push(ctx, sum);
+}
+
+TEST(GeneratedParserTest, GrammarFromGdlBindsActionsByName)
+{
+    const char *gdl_input =
+        "Number = lexeme(digit+) @NUMBER;\n"
+        "Sum = chainl1(Number, lexeme('+')) @SUM;\n"
+        "Program = Sum eoi;\n";
+    epc_grammar_action_binding_t const bindings[] = {
+        { "SUM", blob_sum_action },
+        { "NOT_IN_THE_GRAMMAR", blob_sum_action },
+        { "NUMBER", blob_number_action },
+    };
+    char error[256];
+
+    epc_grammar_t * grammar = epc_grammar_from_gdl(gdl_input, error, sizeof(error));
+    CHECK(grammar != NULL);
+    LONGS_EQUAL(2, epc_grammar_action_count(grammar));
+    epc_ast_hook_registry_t * registry = epc_grammar_ast_hook_registry_create(grammar, bindings, 3);
+    CHECK(registry != NULL);
+
+    epc_parse_session_t gdl_session = epc_parse_input(epc_grammar_parser(grammar), "1 + 20 + 300");
+    CHECK_FALSE(gdl_session.result.is_error);
+    epc_ast_result_t sum = epc_ast_build(gdl_session.result.data.success, registry, NULL);
+    CHECK_FALSE(sum.has_error);
+    LONGS_EQUAL(321, *(long *)sum.ast_root);
+    free(sum.ast_root);
+
+    epc_parse_session_destroy(&gdl_session);
+    epc_ast_hook_registry_free(registry);
+    epc_grammar_free(grammar);
+
+    POINTERS_EQUAL(NULL, epc_grammar_from_gdl("Program = Missing eoi;\n", error, sizeof(error)));
+    POINTERS_EQUAL(NULL, epc_grammar_from_gdl("Program = ;", error, sizeof(error)));
+    CHECK(strlen(error) > 0);
+}
+
+TEST(GeneratedParserTest, GrammarBlobSupportsCount)
+{
+    char error[256];
+    epc_grammar_t * grammar = epc_grammar_from_gdl("Program = count(3, digit) eoi;\n", error, sizeof(error));
+    CHECK(grammar != NULL);
+
+    epc_parse_session_t gdl_session = epc_parse_input(epc_grammar_parser(grammar), "123");
+    CHECK_FALSE(gdl_session.result.is_error);
+    LONGS_EQUAL(3, gdl_session.result.data.success->children[0]->children_count);
+    epc_parse_session_destroy(&gdl_session);
+
+    gdl_session = epc_parse_input(epc_grammar_parser(grammar), "12");
+    CHECK_TRUE(gdl_session.result.is_error);
+    epc_parse_session_destroy(&gdl_session);
+    epc_grammar_free(grammar);
+
+    POINTERS_EQUAL(NULL, epc_grammar_from_gdl("Program = count(3000000000, digit) eoi;\n", error, sizeof(error)));
+}
+
+TEST(GeneratedParserTest, CutOnlyCommitsTheAlternativeItIsIn)
+{
+    struct
+    {
+        const char * gdl_input;
+        const char * input;
+        bool accepted;
+    } const cases[] = {
+        { "S = \"a\" ~ \"b\" | \"ac\";\n", "ac", false },
+        // Failing inside not() is what not() is for.
+        { "S = not(\"a\" ~ \"b\") \"ac\" | \"ad\";\n", "ad", true },
+        // A cut in a rule doesn't commit the alternatives of the rules using it.
+        { "A = \"x\" ~ \"y\";\nS = A | \"xz\";\n", "xz", true },
+        // Nor does one an optional or repetition backtracks out of.
+        { "S = (\"a\" (\"b\" ~ \"c\")?) \"d\" | \"abd\";\n", "abd", true },
+        { "S = (\"a\" (\"b\" ~ \"c\")*) \"d\" | \"abd\";\n", "abd", true },
+        { "S = (\"a\" lookahead(\"b\" ~ \"c\")) | \"ab\";\n", "ab", true },
+        // A delimiter or operator that fails ends the list, so it doesn't commit anything either.
+        { "S = delimited('a', (',' ~ 'x')) \"!\" | \"a,y\";\n", "a,y", true },
+        { "S = chainl1('a', ('+' ~ 'x')) \"!\" | \"a+y\";\n", "a+y", true },
+        { "S = chainr1('a', ('+' ~ 'x')) \"!\" | \"a+y\";\n", "a+y", true },
+        // But a list that fails on its first item fails as a whole.
+        { "S = delimited(('a' ~ 'b'), ',') | \"ac\";\n", "ac", false },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        char error[256];
+        epc_grammar_t * grammar = epc_grammar_from_gdl(cases[i].gdl_input, error, sizeof(error));
+        CHECK_TEXT(grammar != NULL, error);
+        epc_parse_session_t session = epc_parse_input(epc_grammar_parser(grammar), cases[i].input);
+        CHECK_TEXT(cases[i].accepted == !session.result.is_error, cases[i].gdl_input);
+        epc_parse_session_destroy(&session);
+        epc_grammar_free(grammar);
+    }
+}
+
+TEST(GeneratedParserTest, GrammarCacheReusesGrammarsWithTheSameText)
+{
+    const char *words = "Program = alpha+ eoi;\n";
+    const char *numbers = "Program = digit+ eoi;\n";
+    const char *lists = "Program = alpha+ (',' alpha+)* eoi;\n";
+    epc_grammar_cache_t * cache = epc_grammar_cache_create(2);
+
+    epc_grammar_t * first = epc_grammar_cache_load(cache, words, NULL, 0);
+    epc_grammar_t * second = epc_grammar_cache_load(cache, words, NULL, 0);
+    CHECK(first != NULL);
+    CHECK(second != NULL);
+    // Each load gives the caller a grammar of its own.
+    CHECK(epc_grammar_parser(first) != epc_grammar_parser(second));
+    LONGS_EQUAL(1, epc_grammar_cache_count(cache));
+    epc_grammar_free(first);
+
+    epc_grammar_t * number_grammar = epc_grammar_cache_load(cache, numbers, NULL, 0);
+    LONGS_EQUAL(2, epc_grammar_cache_count(cache));
+    epc_grammar_t * list_grammar = epc_grammar_cache_load(cache, lists, NULL, 0);
+    LONGS_EQUAL(2, epc_grammar_cache_count(cache));
+    // Invalid grammars aren't cached.
+    POINTERS_EQUAL(NULL, epc_grammar_cache_load(cache, "Program = ;", NULL, 0));
+    LONGS_EQUAL(2, epc_grammar_cache_count(cache));
+    epc_grammar_cache_free(cache);
+
+    epc_parse_session_t cache_session = epc_parse_input(epc_grammar_parser(second), "abc");
+    CHECK_FALSE(cache_session.result.is_error);
+    epc_parse_session_destroy(&cache_session);
+    cache_session = epc_parse_input(epc_grammar_parser(number_grammar), "abc");
+    CHECK_TRUE(cache_session.result.is_error);
+    epc_parse_session_destroy(&cache_session);
+    cache_session = epc_parse_input(epc_grammar_parser(list_grammar), "a,b");
+    CHECK_FALSE(cache_session.result.is_error);
+    epc_parse_session_destroy(&cache_session);
+
+    epc_grammar_free(second);
+    epc_grammar_free(number_grammar);
+    epc_grammar_free(list_grammar);
+}
+
+TEST(GeneratedParserTest, ProfileReordersDisjointAlternatives)
+{
+    const char *gdl_input =
+        "Word = alpha+;\n"
+        "Digits = digit+;\n"
+        "Item = '(' | Word | Digits;\n"
+        "Overlap = \"ab\" | alpha;\n"
+        "Program = (Item ';' Overlap ';')+ eoi;\n";
+
+    epc_grammar_t * grammar = epc_grammar_from_gdl(gdl_input, NULL, 0);
+    CHECK(grammar != NULL);
+    epc_alternative_profile_t * profile = epc_alternative_profile_create();
+    epc_parse_options_t options = { .alternative_profile = profile };
+    epc_parse_session_t profile_session =
+        epc_parse_input_with_options(epc_grammar_parser(grammar), "abc;ab;12;x;7;q;", &options);
+    CHECK_FALSE(profile_session.result.is_error);
+    epc_parse_session_destroy(&profile_session);
+    FILE * out = fopen("alternative_profile.txt", "w");
+    CHECK(out != NULL);
+    fprintf(out, "# Written by the test\n");
+    CHECK_TRUE(epc_alternative_profile_write(profile, out));
+    fclose(out);
+    epc_alternative_profile_free(profile);
+    epc_grammar_free(grammar);
+
+    gdl_profile_t loaded;
+    CHECK_TRUE(gdl_profile_load("alternative_profile.txt", &loaded));
+    generate_ast(gdl_input);
+    gdl_ast_node_t * program = (gdl_ast_node_t *)ast_build_result.ast_root;
+
+    // Only Item is changed, as "ab" and alpha can match the same input.
+    LONGS_EQUAL(1, gdl_profile_reorder_alternatives(program, &loaded));
+    gdl_profile_free(&loaded);
+
+    gdl_ast_list_node_t * rule = program->data.program.rules.head->next->next;
+    STRCMP_EQUAL("Item", rule->item->data.rule_def.name);
+    gdl_ast_list_node_t * alternative = rule->item->data.rule_def.definition->data.alternative.alternatives.head;
+    char const * expected_items[] = { "Digits", "Word" };
+    for (int i = 0; i < 2; i++, alternative = alternative->next)
+    {
+        gdl_ast_node_t * ref = alternative->item;
+        while (ref->type != GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+        {
+            ref = ref->type == GDL_AST_NODE_TYPE_TERMINAL ? ref->data.terminal.expression
+                                                          : ref->data.sequence.elements.head->item;
+        }
+        STRCMP_EQUAL(expected_items[i], ref->data.identifier_ref.name);
+    }
+    POINTERS_EQUAL(NULL, alternative->next);
+    POINTERS_EQUAL(alternative, rule->item->data.rule_def.definition->data.alternative.alternatives.tail);
+
+    rule = rule->next;
+    gdl_ast_node_t * first_overlap = rule->item->data.rule_def.definition->data.alternative.alternatives.head->item;
+    while (first_overlap->type != GDL_AST_NODE_TYPE_STRING_LITERAL)
+    {
+        first_overlap = first_overlap->type == GDL_AST_NODE_TYPE_TERMINAL ? first_overlap->data.terminal.expression
+                                                                          : first_overlap->data.sequence.elements.head->item;
+    }
+    STRCMP_EQUAL("ab", first_overlap->data.string_literal.value);
+
+    gdl_ast_node_free(program, NULL);
+}
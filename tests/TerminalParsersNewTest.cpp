@@ -2,8 +2,11 @@
 
 #include "easy_pc/easy_pc.h"
 
+#include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <string>
 
 TEST_GROUP(TerminalParsersNew)
 {
@@ -199,6 +202,101 @@ TEST(TerminalParsersNew, Int_FailsOnJustNegativeSign)
     check_failure(session, "Expected an integer");
 }
 
+TEST(TerminalParsersNew, Int_StoresConvertedValue)
+{
+    epc_parser_t* p = epc_int(NULL);
+    epc_parse_session_t session = epc_parse_input(p, "-6789xyz");
+    CHECK_FALSE(session.result.is_error);
+    LONGS_EQUAL(EPC_CPT_VALUE_INT, session.result.data.success->value_type);
+    CHECK_TRUE(session.result.data.success->value.int_value == -6789);
+    epc_parse_session_destroy(&session);
+    epc_parsers_free(1, p);
+}
+
+TEST(TerminalParsersNew, Int_SaturatesOnOverflow)
+{
+    epc_parser_t* p = epc_int(NULL);
+    epc_parse_session_t session = epc_parse_input(p, "99999999999999999999999");
+    CHECK_FALSE(session.result.is_error);
+    LONGS_EQUAL(23, session.result.data.success->len);
+    CHECK_TRUE(session.result.data.success->value.int_value == LLONG_MAX);
+    epc_parse_session_destroy(&session);
+
+    session = epc_parse_input(p, "-9223372036854775808");
+    CHECK_FALSE(session.result.is_error);
+    CHECK_TRUE(session.result.data.success->value.int_value == LLONG_MIN);
+    epc_parse_session_destroy(&session);
+    epc_parsers_free(1, p);
+}
+
+TEST(TerminalParsersNew, Int_FailsOnLeadingPlusOrWhitespace)
+{
+    epc_parser_t* p = epc_int(NULL);
+    epc_parse_session_t session = epc_parse_input(p, "+5");
+    check_failure(session, "Expected an integer");
+    session = epc_parse_input(p, " 5");
+    check_failure(session, "Expected an integer");
+    epc_parsers_free(1, p);
+}
+
+// --- p_double value tests ---
+static void
+check_double_value(char const * input, size_t expected_len)
+{
+    epc_parser_t* p = epc_double(NULL);
+    epc_parse_session_t session = epc_parse_input(p, input);
+    CHECK_FALSE(session.result.is_error);
+    LONGS_EQUAL(expected_len, session.result.data.success->len);
+    LONGS_EQUAL(EPC_CPT_VALUE_DOUBLE, session.result.data.success->value_type);
+
+    /* The stored value must be identical to what strtod() gives for the matched text. */
+    std::string matched(input, expected_len);
+    double expected = strtod(matched.c_str(), NULL);
+    CHECK_TRUE(memcmp(&expected, &session.result.data.success->value.double_value, sizeof(expected)) == 0);
+
+    epc_parse_session_destroy(&session);
+    epc_parsers_free(1, p);
+}
+
+TEST(TerminalParsersNew, Double_StoresConvertedValue)
+{
+    check_double_value("123.45xyz", 6);
+    check_double_value("-0.5", 4);
+    check_double_value(".25", 3);
+    check_double_value("7.", 2);
+    check_double_value("1e-3", 4);
+    check_double_value("-1E+22", 6);
+    check_double_value("0.000123", 8);
+    check_double_value("-0", 2);
+}
+
+TEST(TerminalParsersNew, Double_StoresCorrectlyRoundedValueOutsideFastPath)
+{
+    check_double_value("3.14159265358979323846264338327950288", 37);
+    check_double_value("1e300", 5);
+    check_double_value("2.2250738585072014e-308", 23);
+    check_double_value("9007199254740993", 16);
+    check_double_value("1e400", 5);
+}
+
+TEST(TerminalParsersNew, Double_ExponentWithoutDigitsIsNotConsumed)
+{
+    check_double_value("12e", 2);
+    check_double_value("12e+x", 2);
+}
+
+TEST(TerminalParsersNew, Double_DoesNotAcceptHexOrSpecialValues)
+{
+    check_double_value("0x10", 1);
+
+    epc_parser_t* p = epc_double(NULL);
+    epc_parse_session_t session = epc_parse_input(p, "inf");
+    check_failure(session, "Expected a double");
+    session = epc_parse_input(p, " 1.5");
+    check_failure(session, "Expected a double");
+    epc_parsers_free(1, p);
+}
+
 // --- p_alpha tests ---
 TEST(TerminalParsersNew, Alpha_MatchesLowercase)
 {
@@ -0,0 +1,106 @@
+#include "alloc_counter.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static alloc_counts_t counts;
+
+void * __real_malloc(size_t size);
+void * __real_calloc(size_t count, size_t size);
+void * __real_realloc(void * ptr, size_t size);
+void __real_free(void * ptr);
+char * __real_strdup(char const * s);
+char * __real_strndup(char const * s, size_t n);
+
+void *
+__wrap_malloc(size_t size)
+{
+    void * ptr = __real_malloc(size);
+    if (ptr != NULL)
+    {
+        counts.allocations++;
+        counts.bytes += size;
+    }
+    return ptr;
+}
+
+void *
+__wrap_calloc(size_t count, size_t size)
+{
+    void * ptr = __real_calloc(count, size);
+    if (ptr != NULL)
+    {
+        counts.allocations++;
+        counts.bytes += count * size;
+    }
+    return ptr;
+}
+
+void *
+__wrap_realloc(void * ptr, size_t size)
+{
+    void * new_ptr = __real_realloc(ptr, size);
+    // Growing a block counts as freeing the old one and allocating a new one.
+    if (new_ptr != NULL || size == 0)
+    {
+        counts.frees += ptr != NULL;
+    }
+    if (new_ptr != NULL)
+    {
+        counts.allocations++;
+        counts.bytes += size;
+    }
+    return new_ptr;
+}
+
+void
+__wrap_free(void * ptr)
+{
+    if (ptr != NULL)
+    {
+        counts.frees++;
+    }
+    __real_free(ptr);
+}
+
+char *
+__wrap_strdup(char const * s)
+{
+    char * copy = __real_strdup(s);
+    if (copy != NULL)
+    {
+        counts.allocations++;
+        counts.bytes += strlen(s) + 1;
+    }
+    return copy;
+}
+
+char *
+__wrap_strndup(char const * s, size_t n)
+{
+    char * copy = __real_strndup(s, n);
+    if (copy != NULL)
+    {
+        counts.allocations++;
+        counts.bytes += strnlen(s, n) + 1;
+    }
+    return copy;
+}
+
+alloc_counts_t
+alloc_counts(void)
+{
+    return counts;
+}
+
+alloc_counts_t
+alloc_counts_since(alloc_counts_t start)
+{
+    alloc_counts_t const now = counts;
+
+    return (alloc_counts_t){
+        .allocations = now.allocations - start.allocations,
+        .frees = now.frees - start.frees,
+        .bytes = now.bytes - start.bytes,
+    };
+}
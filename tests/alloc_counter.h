@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Counts the heap allocations made by the test program. The counts are kept
+ * by wrappers around malloc(), calloc(), realloc(), free(), strdup() and
+ * strndup(), which the linker puts in place of the C library's functions
+ * because the test is linked with --wrap (see CMakeLists.txt). Allocations
+ * the C library makes internally, e.g. in asprintf(), aren't seen.
+ */
+
+typedef struct
+{
+    size_t allocations;     // Blocks allocated, including by realloc().
+    size_t frees;           // Blocks freed, including by realloc().
+    size_t bytes;           // Bytes asked for.
+} alloc_counts_t;
+
+// The counts since the program started.
+alloc_counts_t alloc_counts(void);
+
+// The counts since `start`, as returned earlier by alloc_counts().
+alloc_counts_t alloc_counts_since(alloc_counts_t start);
+
+#ifdef __cplusplus
+}
+#endif
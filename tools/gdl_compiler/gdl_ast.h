@@ -1,48 +1,20 @@
 #pragma once
 
 #include <easy_pc/easy_pc.h> // This includes the definition of EPC_AST_ACTION_USER_DEFINED
+#include <stdbool.h>
 #include <stddef.h>
 
+#include "gdl_generated_actions.h"
+
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-// Define GDL-specific AST semantic actions
-typedef enum epc_ast_user_defined_action_gdl
-{
-    GDL_AST_ACTION_CREATE_PROGRAM,
-    GDL_AST_ACTION_CREATE_RULE_DEFINITION,
-    GDL_AST_ACTION_CREATE_IDENTIFIER_REF,
-    GDL_AST_ACTION_CREATE_STRING_LITERAL,
-    GDL_AST_ACTION_CREATE_CHAR_LITERAL,
-    GDL_AST_ACTION_CREATE_NUMBER_LITERAL,
-    GDL_AST_ACTION_CREATE_CHAR_RANGE,
-    GDL_AST_ACTION_CREATE_REPETITION_OPERATOR,
-    GDL_AST_ACTION_CREATE_SEMANTIC_ACTION,
-    GDL_AST_ACTION_CREATE_OPTIONAL_SEMANTIC_ACTION,
-    GDL_AST_ACTION_CREATE_ONEOF_CALL,
-    GDL_AST_ACTION_CREATE_NONEOF_CALL,
-    GDL_AST_ACTION_CREATE_COUNT_CALL,
-    GDL_AST_ACTION_CREATE_BETWEEN_CALL,
-    GDL_AST_ACTION_CREATE_DELIMITED_CALL,
-    GDL_AST_ACTION_CREATE_LOOKAHEAD_CALL,
-    GDL_AST_ACTION_CREATE_NOT_CALL,
-    GDL_AST_ACTION_CREATE_LEXEME_CALL,
-    GDL_AST_ACTION_CREATE_SKIP_CALL,
-    GDL_AST_ACTION_CREATE_CHAINL1_CALL,
-    GDL_AST_ACTION_CREATE_CHAINR1_CALL,
-    GDL_AST_ACTION_CREATE_PASSTHRU_CALL,
-    GDL_AST_ACTION_CREATE_SEQUENCE,
-    GDL_AST_ACTION_CREATE_ALTERNATIVE,
-    GDL_AST_ACTION_CREATE_OPTIONAL,
-    GDL_AST_ACTION_CREATE_EXPRESSION_FACTOR,
-    GDL_AST_ACTION_CREATE_RAW_CHAR_LITERAL,
-    GDL_AST_ACTION_CREATE_KEYWORD,
-    GDL_AST_ACTION_CREATE_TERMINAL,
-    GDL_AST_ACTION_CREATE_FAIL_CALL,
-    GDL_AST_ACTION_MAX,
-} epc_ast_user_defined_action_gdl;
+// GDL-specific AST semantic actions. They are declared by gdl.gdl, which the
+// GDL parser is generated from, so the numbering is always the parser's.
+typedef gdl_generated_semantic_action_t epc_ast_user_defined_action_gdl;
+#define GDL_AST_ACTION_MAX GDL_GENERATED_AST_ACTION_COUNT__
 
 // GDL AST Node Types
 typedef enum
@@ -80,6 +52,8 @@ typedef enum
     GDL_AST_NODE_TYPE_ALTERNATIVE,
     GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION,
     GDL_AST_NODE_TYPE_ARGUMENT_LIST,
+    // Only present while code is being generated. See gdl_token_dfa.h.
+    GDL_AST_NODE_TYPE_TOKEN_DFA,
 } gdl_ast_node_type_t;
 
 // Forward declaration for gdl_ast_node_t
@@ -110,6 +84,7 @@ typedef struct
     char const * name;
     gdl_ast_node_t * definition;
     gdl_ast_node_t * semantic_action; // Optional
+    bool is_token;                    // Declared with the 'token' keyword.
 } gdl_ast_rule_definition_t;
 
 typedef struct
@@ -207,6 +182,7 @@ typedef struct
 typedef struct
 {
     gdl_ast_list_t alternatives; // List of gdl_ast_node_t
+    bool as_keywords;            // Set by gdl_optimize() to have the backends emit it as epc_keywords().
 } gdl_ast_alternative_t;
 
 typedef struct
@@ -219,6 +195,13 @@ typedef struct
     char value;
 } gdl_ast_raw_char_literal_t;
 
+typedef struct
+{
+    gdl_ast_node_t * expression; // The part of the token rule matched by the DFA.
+    char const * rule_name;      // Not owned; the token rule's name.
+    int start;                   // The token's start state in the DFA.
+} gdl_ast_token_dfa_t;
+
 // Main GDL AST Node structure
 struct gdl_ast_node_t
 {
@@ -249,6 +232,7 @@ struct gdl_ast_node_t
         gdl_ast_alternative_t alternative;
         gdl_ast_optional_expression_t optional;
         gdl_ast_list_t argument_list;
+        gdl_ast_token_dfa_t token_dfa;
     } data;
 };
 
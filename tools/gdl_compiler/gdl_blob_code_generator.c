@@ -0,0 +1,733 @@
+#include "gdl_code_generator.h"
+#include "gdl_code_generator_common.h"
+#include "gdl_grammar_analysis.h"
+#include "gdl_token_dfa.h"
+
+#include <easy_pc/easy_pc_grammar.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The blob backend describes the parser graph the default backend builds as
+ * data: a parser record for each constructor the generated code would call,
+ * children first, which epc_grammar_load_blob() calls in turn. See
+ * easy_pc_grammar.h for the format.
+ */
+
+typedef struct
+{
+    uint32_t * words;
+    size_t count;
+    size_t capacity;
+} blob_words_t;
+
+typedef struct
+{
+    gdl_grammar_analysis_t analysis;
+    gdl_rule_objects_t objects;
+    gdl_token_dfa_t token_dfa;
+    int * rule_parser;              // Indexed like analysis.rules. The parser of each rule object, or -1 if not built yet.
+    blob_words_t records;
+    size_t * record_offsets;        // The offset in records of each parser's record.
+    int parser_count;
+    char * strings;                 // The string pool.
+    size_t strings_size;
+    size_t strings_capacity;
+    char const * * action_names;    // In the order the actions header numbers them.
+    int action_count;
+    bool has_error;
+} blob_generator_t;
+
+static bool
+blob_words_add(blob_generator_t * gen, blob_words_t * words, uint32_t value)
+{
+    if (words->count == words->capacity)
+    {
+        size_t capacity = words->capacity == 0 ? 256 : words->capacity * 2;
+        uint32_t * grown = realloc(words->words, capacity * sizeof(*grown));
+        if (grown == NULL)
+        {
+            gen->has_error = true;
+            return false;
+        }
+        words->words = grown;
+        words->capacity = capacity;
+    }
+    words->words[words->count++] = value;
+    return true;
+}
+
+// Returns the offset of the string in the pool, adding it if it isn't there already.
+static uint32_t
+blob_string(blob_generator_t * gen, char const * string)
+{
+    if (string == NULL)
+    {
+        return EPC_GRAMMAR_BLOB_NONE;
+    }
+    size_t len = strlen(string) + 1;
+    for (size_t offset = 0; offset < gen->strings_size; offset += strlen(gen->strings + offset) + 1)
+    {
+        if (memcmp(gen->strings + offset, string, len) == 0)
+        {
+            return (uint32_t)offset;
+        }
+    }
+    if (gen->strings_size + len > gen->strings_capacity)
+    {
+        size_t capacity = gen->strings_capacity == 0 ? 1024 : gen->strings_capacity;
+        while (gen->strings_size + len > capacity)
+        {
+            capacity *= 2;
+        }
+        char * grown = realloc(gen->strings, capacity);
+        if (grown == NULL)
+        {
+            gen->has_error = true;
+            return EPC_GRAMMAR_BLOB_NONE;
+        }
+        gen->strings = grown;
+        gen->strings_capacity = capacity;
+    }
+    memcpy(gen->strings + gen->strings_size, string, len);
+    gen->strings_size += len;
+    return (uint32_t)(gen->strings_size - len);
+}
+
+// Adds the string, as written in the grammar, with its escape sequences replaced, as the C compiler would.
+static uint32_t
+blob_unescaped_string(blob_generator_t * gen, char const * text)
+{
+    char * value = c_string_unescape(text);
+    if (value == NULL)
+    {
+        gen->has_error = true;
+        return EPC_GRAMMAR_BLOB_NONE;
+    }
+    uint32_t offset = blob_string(gen, value);
+    free(value);
+    return offset;
+}
+
+// Adds a parser record and returns the parser's index, or -1 on error.
+static int
+blob_emit(blob_generator_t * gen, epc_grammar_blob_op_t op, char const * name, uint32_t const * operands, int operand_count)
+{
+    if (gen->has_error)
+    {
+        return -1;
+    }
+    size_t * offsets = realloc(gen->record_offsets, (gen->parser_count + 1) * sizeof(*offsets));
+    if (offsets == NULL)
+    {
+        gen->has_error = true;
+        return -1;
+    }
+    gen->record_offsets = offsets;
+    gen->record_offsets[gen->parser_count] = gen->records.count;
+
+    uint32_t name_offset = blob_string(gen, name);
+    blob_words_add(gen, &gen->records, op);
+    blob_words_add(gen, &gen->records, name_offset);
+    blob_words_add(gen, &gen->records, EPC_GRAMMAR_BLOB_NONE);
+    blob_words_add(gen, &gen->records, (uint32_t)operand_count);
+    for (int i = 0; i < operand_count; i++)
+    {
+        blob_words_add(gen, &gen->records, operands[i]);
+    }
+    if (gen->has_error)
+    {
+        return -1;
+    }
+    return gen->parser_count++;
+}
+
+static int
+blob_emit_expression(blob_generator_t * gen, gdl_ast_node_t * node, char const * expression_name);
+
+// Emits a parser whose operands are the parsers of the child expressions.
+static int
+blob_emit_children(
+    blob_generator_t * gen, epc_grammar_blob_op_t op, char const * name, gdl_ast_node_t * const * children, int count)
+{
+    uint32_t operands[3];
+    for (int i = 0; i < count; i++)
+    {
+        int child = blob_emit_expression(gen, children[i], NULL);
+        if (child < 0)
+        {
+            return -1;
+        }
+        operands[i] = (uint32_t)child;
+    }
+    return blob_emit(gen, op, name, operands, count);
+}
+
+static int
+blob_emit_unary(blob_generator_t * gen, epc_grammar_blob_op_t op, char const * name, gdl_ast_node_t * child)
+{
+    return blob_emit_children(gen, op, name, &child, 1);
+}
+
+static int
+blob_emit_binary(blob_generator_t * gen, epc_grammar_blob_op_t op, char const * name, gdl_ast_node_t * a, gdl_ast_node_t * b)
+{
+    gdl_ast_node_t * children[] = { a, b };
+    return blob_emit_children(gen, op, name, children, 2);
+}
+
+// Emits an epc_and or epc_or. first is the predict set of each child for an epc_or_first, or NULL.
+static int
+blob_emit_list(
+    blob_generator_t * gen, epc_grammar_blob_op_t op, char const * name, gdl_ast_list_t * list, gdl_char_set_t const * first)
+{
+    size_t words_per_child = first != NULL ? 1 + sizeof(first->bits) / 4 : 1;
+    uint32_t * operands = calloc(list->count * words_per_child, sizeof(*operands));
+    if (operands == NULL)
+    {
+        gen->has_error = true;
+        return -1;
+    }
+
+    int result = -1;
+    int count = 0;
+    for (gdl_ast_list_node_t * item = list->head; item != NULL; item = item->next, count++)
+    {
+        int child = blob_emit_expression(gen, item->item, NULL);
+        if (child < 0)
+        {
+            goto done;
+        }
+        operands[count] = (uint32_t)child;
+    }
+    for (int i = 0; first != NULL && i < count; i++)
+    {
+        uint32_t * words = &operands[count + i * (sizeof(first->bits) / 4)];
+        for (size_t b = 0; b < sizeof(first->bits); b++)
+        {
+            words[b / 4] |= (uint32_t)first[i].bits[b] << (b % 4 * 8);
+        }
+    }
+    result = blob_emit(gen, op, name, operands, (int)(count * words_per_child));
+
+done:
+    free(operands);
+    return result;
+}
+
+static int
+blob_emit_keyword(blob_generator_t * gen, char const * keyword_name)
+{
+    // The default backend names these parsers after the keyword.
+    static struct
+    {
+        char const * keyword;
+        epc_grammar_blob_op_t op;
+        char const * name;
+    } const keywords[] = {
+        { "eoi", EPC_GRAMMAR_OP_EOI, "eoi" },
+        { "digit", EPC_GRAMMAR_OP_DIGIT, "digit" },
+        { "alpha", EPC_GRAMMAR_OP_ALPHA, "alpha" },
+        { "alphanum", EPC_GRAMMAR_OP_ALPHANUM, "alphanum" },
+        { "space", EPC_GRAMMAR_OP_SPACE, "space" },
+        { "any_char", EPC_GRAMMAR_OP_ANY_CHAR, "any_char" },
+        { "succeed", EPC_GRAMMAR_OP_SUCCEED, "succeed" },
+        { "~", EPC_GRAMMAR_OP_CUT, "cut" },
+        { "hex_digit", EPC_GRAMMAR_OP_HEX_DIGIT, "hex_digit" },
+        { "int", EPC_GRAMMAR_OP_INT, "int" },
+        { "double", EPC_GRAMMAR_OP_DOUBLE, "double" },
+    };
+
+    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++)
+    {
+        if (strcmp(keyword_name, keywords[i].keyword) == 0)
+        {
+            return blob_emit(gen, keywords[i].op, keywords[i].name, NULL, 0);
+        }
+    }
+
+    fprintf(stderr, "Error: Unsupported GDL keyword '%s' for code generation.\n", keyword_name);
+    gen->has_error = true;
+    return -1;
+}
+
+static int
+blob_emit_keywords(blob_generator_t * gen, char const * name, gdl_ast_list_t * alternatives)
+{
+    uint32_t * operands = calloc(alternatives->count, sizeof(*operands));
+    if (operands == NULL)
+    {
+        gen->has_error = true;
+        return -1;
+    }
+    int count = 0;
+    for (gdl_ast_list_node_t * item = alternatives->head; item != NULL; item = item->next)
+    {
+        operands[count++] = blob_unescaped_string(gen, alternative_string_literal_value(item->item));
+    }
+    int result = blob_emit(gen, EPC_GRAMMAR_OP_KEYWORDS, name, operands, count);
+    free(operands);
+    return result;
+}
+
+static int
+blob_emit_token(blob_generator_t * gen, gdl_ast_node_t * node, char const * expression_name)
+{
+    for (int t = 0; t < gen->token_dfa.token_count; t++)
+    {
+        if (strcmp(gen->token_dfa.tokens[t].rule->data.rule_def.name, node->data.token_dfa.rule_name) == 0)
+        {
+            char * rule_name = to_pascal_case(node->data.token_dfa.rule_name);
+            if (rule_name == NULL)
+            {
+                gen->has_error = true;
+                return -1;
+            }
+            uint32_t start = (uint32_t)gen->token_dfa.tokens[t].start;
+            int result = blob_emit(gen, EPC_GRAMMAR_OP_DFA, expression_name != NULL ? expression_name : rule_name, &start, 1);
+            free(rule_name);
+            return result;
+        }
+    }
+    gen->has_error = true;
+    return -1;
+}
+
+/*
+ * Emits the records for an expression, children first, and returns the index
+ * of the expression's parser. expression_name is the name the default backend
+ * gives the parser, or NULL if it leaves it to the constructor.
+ */
+static int
+blob_emit_expression(blob_generator_t * gen, gdl_ast_node_t * node, char const * expression_name)
+{
+    node = unwrap_expression(node);
+    if (node == NULL)
+    {
+        gen->has_error = true;
+        return -1;
+    }
+
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
+    {
+        int index = gdl_rule_objects_rule_index(&gen->objects, node->data.identifier_ref.name);
+        if (index < 0)
+        {
+            gen->has_error = true;
+            return -1;
+        }
+        return gen->rule_parser[gen->objects.rule_object[index]];
+    }
+
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+    {
+        uint32_t value = blob_unescaped_string(gen, node->data.string_literal.value);
+        return blob_emit(gen, EPC_GRAMMAR_OP_STRING, expression_name, &value, 1);
+    }
+
+    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
+    {
+        uint32_t value = (unsigned char)node->data.char_literal.value;
+        return blob_emit(gen, EPC_GRAMMAR_OP_CHAR, expression_name, &value, 1);
+    }
+
+    case GDL_AST_NODE_TYPE_CHAR_RANGE:
+    {
+        uint32_t range[] = {
+            (unsigned char)node->data.char_range.start_char,
+            (unsigned char)node->data.char_range.end_char,
+        };
+        return blob_emit(gen, EPC_GRAMMAR_OP_CHAR_RANGE, expression_name, range, 2);
+    }
+
+    case GDL_AST_NODE_TYPE_KEYWORD:
+        return blob_emit_keyword(gen, node->data.keyword.name);
+
+    case GDL_AST_NODE_TYPE_FAIL_CALL:
+    {
+        uint32_t message = blob_unescaped_string(gen, node->data.string_literal.value);
+        // The default backend passes the name as a string even when there isn't one.
+        return blob_emit(gen, EPC_GRAMMAR_OP_FAIL, expression_name != NULL ? expression_name : "NULL", &message, 1);
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
+    {
+        if (node->data.none_or_one_of_call.args == NULL)
+        {
+            gen->has_error = true;
+            return -1;
+        }
+        uint32_t chars = blob_unescaped_string(gen, node->data.none_or_one_of_call.args);
+        epc_grammar_blob_op_t op = node->type == GDL_AST_NODE_TYPE_COMBINATOR_NONEOF ? EPC_GRAMMAR_OP_NONE_OF : EPC_GRAMMAR_OP_ONE_OF;
+        return blob_emit(gen, op, expression_name, &chars, 1);
+    }
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        if (node->data.sequence.elements.count == 0)
+        {
+            return blob_emit(gen, EPC_GRAMMAR_OP_SUCCEED, "empty_seq", NULL, 0);
+        }
+        return blob_emit_list(gen, EPC_GRAMMAR_OP_AND, expression_name, &node->data.sequence.elements, NULL);
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+    {
+        if (node->data.alternative.alternatives.count == 0)
+        {
+            uint32_t message = blob_string(gen, "empty_alt");
+            return blob_emit(gen, EPC_GRAMMAR_OP_FAIL, "empty_alt", &message, 1);
+        }
+        if (alternative_is_keyword_set(node))
+        {
+            return blob_emit_keywords(gen, expression_name, &node->data.alternative.alternatives);
+        }
+        gdl_char_set_t * first = alternative_predict_sets(&gen->analysis, node);
+        int result = blob_emit_list(
+            gen,
+            first != NULL ? EPC_GRAMMAR_OP_OR_FIRST : EPC_GRAMMAR_OP_OR,
+            expression_name,
+            &node->data.alternative.alternatives,
+            first);
+        free(first);
+        return result;
+    }
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+    {
+        gdl_ast_node_t * child = node->data.repetition_expr.expression;
+        switch (node->data.repetition_expr.repetition->data.repetition_op.operator_char)
+        {
+        case '*':
+            return blob_emit_unary(gen, EPC_GRAMMAR_OP_MANY, expression_name, child);
+        case '+':
+            return blob_emit_unary(gen, EPC_GRAMMAR_OP_PLUS, expression_name, child);
+        case '?':
+            return blob_emit_unary(gen, EPC_GRAMMAR_OP_OPTIONAL, expression_name, child);
+        default:
+            fprintf(stderr, "Error: Unknown repetition operator '%c'.\n",
+                    node->data.repetition_expr.repetition->data.repetition_op.operator_char);
+            gen->has_error = true;
+            return -1;
+        }
+    }
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        return blob_emit_unary(gen, EPC_GRAMMAR_OP_OPTIONAL, expression_name, node->data.optional.expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+        return blob_emit_unary(gen, EPC_GRAMMAR_OP_NOT, expression_name, node->data.unary_combinator_call.expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+        return blob_emit_unary(gen, EPC_GRAMMAR_OP_LOOKAHEAD, expression_name, node->data.unary_combinator_call.expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+        return blob_emit_unary(gen, EPC_GRAMMAR_OP_SKIP, expression_name, node->data.unary_combinator_call.expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        return blob_emit_unary(gen, EPC_GRAMMAR_OP_PASSTHRU, expression_name, node->data.unary_combinator_call.expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+        return blob_emit_unary(gen, EPC_GRAMMAR_OP_LEXEME, expression_name, node->data.unary_combinator_call.expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+    {
+        int child = blob_emit_expression(gen, node->data.count_call.expression, NULL);
+        if (child < 0)
+        {
+            return -1;
+        }
+        uint32_t operands[] = { (uint32_t)child, (uint32_t)node->data.count_call.count_node->data.number_literal.value };
+        return blob_emit(gen, EPC_GRAMMAR_OP_REPEAT, expression_name, operands, 2);
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+    {
+        gdl_ast_node_t * children[] = {
+            node->data.between_call.open_expr,
+            node->data.between_call.content_expr,
+            node->data.between_call.close_expr,
+        };
+        return blob_emit_children(gen, EPC_GRAMMAR_OP_BETWEEN, expression_name, children, 3);
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        return blob_emit_binary(
+            gen, EPC_GRAMMAR_OP_DELIMITED, expression_name,
+            node->data.delimited_call.item_expr, node->data.delimited_call.delimiter_expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        return blob_emit_binary(
+            gen,
+            node->type == GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1 ? EPC_GRAMMAR_OP_CHAINL1 : EPC_GRAMMAR_OP_CHAINR1,
+            expression_name,
+            node->data.chain_combinator_call.item_expr,
+            node->data.chain_combinator_call.op_expr);
+
+    case GDL_AST_NODE_TYPE_TOKEN_DFA:
+        return blob_emit_token(gen, node, expression_name);
+
+    default:
+        fprintf(stderr, "Error: Unsupported AST node type for code generation: %d\n", node->type);
+        gen->has_error = true;
+        return -1;
+    }
+}
+
+static uint32_t
+blob_action_index(blob_generator_t * gen, char const * action_name)
+{
+    for (int i = 0; i < gen->action_count; i++)
+    {
+        if (strcmp(gen->action_names[i], action_name) == 0)
+        {
+            return (uint32_t)i;
+        }
+    }
+    return EPC_GRAMMAR_BLOB_NONE;
+}
+
+// Numbers the actions as gdl_generate_semantic_actions_header() does: in the order they first appear.
+static bool
+blob_collect_actions(blob_generator_t * gen)
+{
+    gen->action_names = calloc(gen->analysis.count, sizeof(*gen->action_names));
+    if (gen->action_names == NULL)
+    {
+        return false;
+    }
+    for (int i = 0; i < gen->analysis.count; i++)
+    {
+        gdl_ast_node_t * semantic_action = gen->analysis.rules[i].rule_def->data.rule_def.semantic_action;
+        char const * action_name = semantic_action != NULL ? semantic_action->data.semantic_action.action_name : NULL;
+        if (action_name != NULL && *action_name != '\0' && blob_action_index(gen, action_name) == EPC_GRAMMAR_BLOB_NONE)
+        {
+            gen->action_names[gen->action_count++] = action_name;
+        }
+    }
+    return true;
+}
+
+static bool
+blob_generate_rule(blob_generator_t * gen, int index)
+{
+    gdl_rule_analysis_t * rule = &gen->analysis.rules[index];
+    char * rule_name = to_pascal_case(rule->name);
+    if (rule_name == NULL)
+    {
+        return false;
+    }
+
+    int definition = blob_emit_expression(gen, rule->rule_def->data.rule_def.definition, rule_name);
+    free(rule_name);
+    if (definition < 0 || gen->has_error)
+    {
+        return false;
+    }
+    if (gen->objects.rule_actions[index] != NULL)
+    {
+        gen->records.words[gen->record_offsets[definition] + 2] = blob_action_index(gen, gen->objects.rule_actions[index]);
+    }
+    if (gen->objects.rule_wrapped[index])
+    {
+        uint32_t operands[] = { (uint32_t)gen->rule_parser[index], (uint32_t)definition };
+        return blob_emit(gen, EPC_GRAMMAR_OP_DEFINE, NULL, operands, 2) >= 0;
+    }
+    gen->rule_parser[index] = definition;
+    return true;
+}
+
+static bool
+blob_build_records(blob_generator_t * gen)
+{
+    gen->rule_parser = malloc(gen->analysis.count * sizeof(*gen->rule_parser));
+    if (gen->rule_parser == NULL || !blob_collect_actions(gen))
+    {
+        perror("Failed to allocate blob generator");
+        return false;
+    }
+
+    // Rules used before they are defined start out as forward references, as in the default backend.
+    for (int i = 0; i < gen->analysis.count; i++)
+    {
+        gen->rule_parser[i] = -1;
+        if (gen->objects.rule_reachable[i] && gen->objects.rule_wrapped[i])
+        {
+            gen->rule_parser[i] = blob_emit(gen, EPC_GRAMMAR_OP_FORWARD, gen->analysis.rules[i].name, NULL, 0);
+        }
+    }
+    for (int i = 0; i < gen->analysis.count; i++)
+    {
+        if (gen->objects.rule_reachable[i] && !blob_generate_rule(gen, i))
+        {
+            fprintf(stderr, "Error: Failed to generate rule '%s'.\n", gen->analysis.rules[i].name);
+            return false;
+        }
+    }
+    return !gen->has_error;
+}
+
+static bool
+blob_assemble(blob_generator_t * gen, unsigned char * * blob, size_t * size)
+{
+    blob_words_t words = { 0 };
+    bool has_dfa = gen->token_dfa.token_count > 0;
+
+    for (int i = 0; i < EPC_GRAMMAR_BLOB_HEADER_WORDS; i++)
+    {
+        blob_words_add(gen, &words, 0);
+    }
+
+    uint32_t actions = (uint32_t)(words.count * 4);
+    for (int i = 0; i < gen->action_count; i++)
+    {
+        blob_words_add(gen, &words, blob_string(gen, gen->action_names[i]));
+    }
+
+    uint32_t dfa = EPC_GRAMMAR_BLOB_NONE;
+    if (has_dfa)
+    {
+        gdl_token_dfa_t const * token_dfa = &gen->token_dfa;
+        dfa = (uint32_t)(words.count * 4);
+        blob_words_add(gen, &words, (uint32_t)token_dfa->state_count);
+        blob_words_add(gen, &words, (uint32_t)token_dfa->class_count);
+        for (int c = 0; c < 256; c++)
+        {
+            blob_words_add(gen, &words, token_dfa->classes[c]);
+        }
+        for (int i = 0; i < token_dfa->state_count * token_dfa->class_count; i++)
+        {
+            blob_words_add(gen, &words, token_dfa->transitions[i]);
+        }
+        for (int s = 0; s < token_dfa->state_count; s++)
+        {
+            blob_words_add(gen, &words, token_dfa->accepting[s]);
+        }
+    }
+
+    uint32_t parsers = (uint32_t)(words.count * 4);
+    for (size_t i = 0; i < gen->records.count; i++)
+    {
+        blob_words_add(gen, &words, gen->records.words[i]);
+    }
+    if (gen->has_error)
+    {
+        free(words.words);
+        return false;
+    }
+
+    uint32_t strings = (uint32_t)(words.count * 4);
+    *size = strings + gen->strings_size;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_MAGIC] = EPC_GRAMMAR_BLOB_MAGIC;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_VERSION] = EPC_GRAMMAR_BLOB_VERSION;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_SIZE] = (uint32_t)*size;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_START] = (uint32_t)gen->rule_parser[gen->objects.start_object];
+    words.words[EPC_GRAMMAR_BLOB_HEADER_PARSER_COUNT] = (uint32_t)gen->parser_count;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_PARSERS] = parsers;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_STRINGS] = strings;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_STRINGS_SIZE] = (uint32_t)gen->strings_size;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_ACTION_COUNT] = (uint32_t)gen->action_count;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_ACTIONS] = actions;
+    words.words[EPC_GRAMMAR_BLOB_HEADER_DFA] = dfa;
+
+    *blob = malloc(*size > 0 ? *size : 1);
+    if (*blob == NULL)
+    {
+        free(words.words);
+        return false;
+    }
+    // Little-endian, whatever the host.
+    for (size_t i = 0; i < words.count; i++)
+    {
+        for (int b = 0; b < 4; b++)
+        {
+            (*blob)[i * 4 + b] = (unsigned char)(words.words[i] >> (b * 8));
+        }
+    }
+    memcpy(*blob + strings, gen->strings, gen->strings_size);
+    free(words.words);
+
+    return true;
+}
+
+bool
+gdl_build_grammar_blob(gdl_ast_node_t * ast_root, unsigned char * * blob, size_t * size)
+{
+    if (ast_root == NULL || ast_root->type != GDL_AST_NODE_TYPE_PROGRAM || blob == NULL || size == NULL)
+    {
+        fprintf(stderr, "Error: Invalid arguments or AST root type to gdl_build_grammar_blob.\n");
+        return false;
+    }
+
+    blob_generator_t gen = { 0 };
+    bool success = false;
+
+    *blob = NULL;
+    *size = 0;
+
+    // Token rules are matched by a DFA, so their definitions aren't generated as parsers.
+    if (!gdl_token_dfa_build(ast_root, &gen.token_dfa))
+    {
+        gdl_token_dfa_free(&gen.token_dfa);
+        return false;
+    }
+    if (gdl_grammar_analyze(ast_root, &gen.analysis))
+    {
+        if (gdl_rule_objects_init(&gen.objects, &gen.analysis))
+        {
+            success = blob_build_records(&gen) && blob_assemble(&gen, blob, size);
+            gdl_rule_objects_free(&gen.objects);
+        }
+        gdl_grammar_analysis_free(&gen.analysis);
+    }
+    gdl_token_dfa_free(&gen.token_dfa);
+
+    free(gen.rule_parser);
+    free(gen.records.words);
+    free(gen.record_offsets);
+    free(gen.strings);
+    free(gen.action_names);
+
+    return success;
+}
+
+bool
+gdl_generate_grammar_blob(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir)
+{
+    if (base_name == NULL || output_dir == NULL)
+    {
+        fprintf(stderr, "Error: Invalid arguments to gdl_generate_grammar_blob.\n");
+        return false;
+    }
+
+    fprintf(stdout, "Generating grammar blob for '%s' in '%s'...\n", base_name, output_dir);
+
+    unsigned char * blob;
+    size_t size;
+    if (!gdl_build_grammar_blob(ast_root, &blob, &size))
+    {
+        return false;
+    }
+
+    bool success = gdl_generate_semantic_actions_header(ast_root, base_name, output_dir);
+    if (success)
+    {
+        char blob_filename[512];
+        snprintf(blob_filename, sizeof(blob_filename), "%s.epcg", base_name);
+        gdl_output_file_t output;
+        success = gdl_output_file_open(&output, output_dir, blob_filename);
+        if (success)
+        {
+            fwrite(blob, 1, size, output.stream);
+            success = gdl_output_file_close(&output, true);
+        }
+    }
+    free(blob);
+
+    return success;
+}
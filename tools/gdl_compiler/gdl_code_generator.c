@@ -1,4 +1,7 @@
 #include "gdl_code_generator.h"
+#include "gdl_code_generator_common.h"
+#include "gdl_token_dfa.h"
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -9,6 +12,8 @@ typedef struct gdl_rule_info_t
 {
     char * name; // Name of the rule
     bool needs_forward_declaration; // True if it needs epc_parser_allocate_l
+    int index; // The position of the rule in the program, and its entry in the rule table when sharded
+    int shard; // The translation unit defining the rule, when sharded
     gdl_ast_node_t * ast_node; // Pointer to the actual rule definition AST node
     struct gdl_rule_info_t * next; // For linked list
 } gdl_rule_info_t;
@@ -18,6 +23,10 @@ typedef struct
 {
     gdl_rule_info_t * head;
     gdl_rule_info_t * tail;
+    gdl_grammar_analysis_t analysis; // For the FIRST sets of alternatives.
+    int shard_count; // More than 1 if the rules are split across translation units.
+    int current_shard; // The shard being generated.
+    gdl_token_dfa_t const * token_dfa; // For the indexes of the token DFAs, which shards find in a table.
 } gdl_rule_list_t;
 
 typedef struct semantic_action_node
@@ -30,7 +39,7 @@ typedef struct semantic_action_node
 // --- Helper Functions for C Code Generation ---
 
 // Function to convert a string to PascalCase (for rule names in C)
-static char *
+char *
 to_pascal_case(const char * str)
 {
     if (str == NULL || *str == '\0')
@@ -75,7 +84,7 @@ to_pascal_case(const char * str)
 }
 
 // Function to convert a string to uppercase with underscores, handling existing underscores gracefully
-static char *
+char *
 to_upper_case(const char * str)
 {
     if (str == NULL || *str == '\0')
@@ -101,6 +110,236 @@ to_upper_case(const char * str)
 }
 
 
+// --- String helpers ---
+
+char *
+str_printf(char const * format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int len = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (len < 0)
+    {
+        return NULL;
+    }
+
+    char * str = malloc((size_t)len + 1);
+    if (str == NULL)
+    {
+        perror("Failed to allocate string");
+        return NULL;
+    }
+    va_start(args, format);
+    vsnprintf(str, (size_t)len + 1, format, args);
+    va_end(args);
+
+    return str;
+}
+
+// Returns a C character constant for c, e.g. 'a' or '\x0a'.
+char *
+c_char_constant(unsigned char c)
+{
+    if (c == '\'' || c == '\\')
+    {
+        return str_printf("'\\%c'", c);
+    }
+    if (c >= 0x20 && c < 0x7f)
+    {
+        return str_printf("'%c'", c);
+    }
+    return str_printf("'\\x%02x'", c);
+}
+
+// Returns a C string literal holding just c.
+char *
+c_string_literal_of_char(unsigned char c)
+{
+    if (c == '"' || c == '\\')
+    {
+        return str_printf("\"\\%c\"", c);
+    }
+    if (c >= 0x20 && c < 0x7f)
+    {
+        return str_printf("\"%c\"", c);
+    }
+    return str_printf("\"\\%03o\"", c);
+}
+
+static int
+hex_value(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+char *
+c_string_unescape(char const * text)
+{
+    char * result = malloc(strlen(text) + 1);
+    if (result == NULL)
+    {
+        return NULL;
+    }
+
+    size_t len = 0;
+    for (char const * p = text; *p != '\0'; p++)
+    {
+        if (*p != '\\' || p[1] == '\0')
+        {
+            result[len++] = *p;
+            continue;
+        }
+        p++;
+        switch (*p)
+        {
+        case 'a': result[len++] = '\a'; break;
+        case 'b': result[len++] = '\b'; break;
+        case 'f': result[len++] = '\f'; break;
+        case 'n': result[len++] = '\n'; break;
+        case 'r': result[len++] = '\r'; break;
+        case 't': result[len++] = '\t'; break;
+        case 'v': result[len++] = '\v'; break;
+        case 'x':
+        {
+            unsigned value = 0;
+            while (hex_value(p[1]) >= 0)
+            {
+                value = value * 16 + hex_value(*++p);
+            }
+            result[len++] = (char)value;
+            break;
+        }
+        default:
+            if (*p >= '0' && *p <= '7')
+            {
+                unsigned value = *p - '0';
+                for (int digits = 1; digits < 3 && p[1] >= '0' && p[1] <= '7'; digits++)
+                {
+                    value = value * 8 + (*++p - '0');
+                }
+                result[len++] = (char)value;
+            }
+            else
+            {
+                result[len++] = *p;
+            }
+            break;
+        }
+    }
+    /* As with strdup() in the library, an embedded NUL ends the string. */
+    result[len] = '\0';
+
+    return result;
+}
+
+char *
+c_string_escape(char const * text)
+{
+    // Each byte takes at most four characters, as an octal escape.
+    char * result = malloc(strlen(text) * 4 + 1);
+    if (result == NULL)
+    {
+        return NULL;
+    }
+
+    size_t len = 0;
+    for (unsigned char const * p = (unsigned char const *)text; *p != '\0'; p++)
+    {
+        if (*p == '"' || *p == '\\')
+        {
+            result[len++] = '\\';
+            result[len++] = (char)*p;
+        }
+        else if (*p >= 0x20 && *p < 0x7f)
+        {
+            result[len++] = (char)*p;
+        }
+        else
+        {
+            // Always three digits, so a following digit can't be taken as part of the escape.
+            len += sprintf(&result[len], "\\%03o", *p);
+        }
+    }
+    result[len] = '\0';
+
+    return result;
+}
+
+gdl_ast_node_t *
+unwrap_expression(gdl_ast_node_t * node)
+{
+    while (node != NULL)
+    {
+        if (node->type == GDL_AST_NODE_TYPE_TERMINAL)
+        {
+            node = node->data.terminal.expression;
+        }
+        else if (node->type == GDL_AST_NODE_TYPE_SEQUENCE && node->data.sequence.elements.count == 1)
+        {
+            node = node->data.sequence.elements.head->item;
+        }
+        else if (node->type == GDL_AST_NODE_TYPE_ALTERNATIVE && node->data.alternative.alternatives.count == 1)
+        {
+            node = node->data.alternative.alternatives.head->item;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return node;
+}
+
+
+gdl_char_set_t *
+alternative_predict_sets(gdl_grammar_analysis_t const * analysis, gdl_ast_node_t * alternative_node)
+{
+    gdl_char_set_t * sets = calloc(alternative_node->data.alternative.alternatives.count, sizeof(*sets));
+    if (sets == NULL)
+    {
+        return NULL;
+    }
+
+    bool can_skip = false;
+    int i = 0;
+    for (gdl_ast_list_node_t * a = alternative_node->data.alternative.alternatives.head; a != NULL; a = a->next, i++)
+    {
+        gdl_expression_predict(analysis, a->item, &sets[i]);
+        can_skip |= !gdl_char_set_is_full(&sets[i]);
+    }
+    if (!can_skip)
+    {
+        free(sets);
+        return NULL;
+    }
+    return sets;
+}
+
+void
+write_first_set_initializer(FILE * out, gdl_char_set_t const * set)
+{
+    fprintf(out, "{ {");
+    for (size_t i = 0; i < sizeof(set->bits); i++)
+    {
+        fprintf(out, "%s0x%02x", i > 0 ? ", " : " ", set->bits[i]);
+    }
+    fprintf(out, " } }");
+}
+
 // Forward declarations for rule generation
 static bool generate_rule_definition_code(FILE * source_file, gdl_ast_node_t * rule_node, int indent_level, const gdl_rule_list_t * rule_list);
 
@@ -149,18 +388,106 @@ free_semantic_action_names(semantic_action_node_t * head)
     }
 }
 
+bool
+gdl_output_file_open(gdl_output_file_t * output, char const * output_dir, char const * file_name)
+{
+    *output = (gdl_output_file_t){ 0 };
+    output->path = str_printf("%s/%s", output_dir, file_name);
+    if (output->path == NULL || (output->stream = open_memstream(&output->text, &output->size)) == NULL)
+    {
+        perror("Failed to open output file");
+        free(output->path);
+        output->path = NULL;
+        return false;
+    }
+    return true;
+}
+
+// Returns true if the file at path holds exactly size bytes of text.
 static bool
+file_has_contents(char const * path, char const * text, size_t size)
+{
+    FILE * file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool same = true;
+    size_t offset = 0;
+    char buffer[4096];
+    size_t count;
+    while (same && (count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        same = count <= size - offset && memcmp(buffer, text + offset, count) == 0;
+        offset += count;
+    }
+    same = same && !ferror(file) && offset == size;
+    fclose(file);
+
+    return same;
+}
+
+bool
+gdl_output_file_close(gdl_output_file_t * output, bool keep)
+{
+    bool success = fclose(output->stream) == 0;
+    output->stream = NULL;
+
+    if (success && keep)
+    {
+        if (file_has_contents(output->path, output->text, output->size))
+        {
+            fprintf(stdout, "Unchanged: %s\n", output->path);
+        }
+        else
+        {
+            // Write a temporary file and rename it, so nothing ever reads a partly written output.
+            char * temporary_path = str_printf("%s.tmp", output->path);
+            FILE * file = temporary_path != NULL ? fopen(temporary_path, "wb") : NULL;
+            if (file == NULL)
+            {
+                perror("Failed to open output file for writing");
+                success = false;
+            }
+            else
+            {
+                success = fwrite(output->text, 1, output->size, file) == output->size;
+                success = fclose(file) == 0 && success;
+                success = success && rename(temporary_path, output->path) == 0;
+                if (success)
+                {
+                    fprintf(stdout, "Generated: %s\n", output->path);
+                }
+                else
+                {
+                    fprintf(stderr, "Error: Failed to write '%s'.\n", output->path);
+                    remove(temporary_path);
+                }
+            }
+            free(temporary_path);
+        }
+    }
+
+    free(output->text);
+    free(output->path);
+    *output = (gdl_output_file_t){ 0 };
+
+    return success;
+}
+
+bool
 gdl_generate_semantic_actions_header(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir)
 {
-    char actions_header_filepath[512];
-    snprintf(actions_header_filepath, sizeof(actions_header_filepath), "%s/%s_actions.h", output_dir, base_name);
+    char actions_header_filename[512];
+    snprintf(actions_header_filename, sizeof(actions_header_filename), "%s_actions.h", base_name);
 
-    FILE * actions_header_file = fopen(actions_header_filepath, "w");
-    if (actions_header_file == NULL)
+    gdl_output_file_t output;
+    if (!gdl_output_file_open(&output, output_dir, actions_header_filename))
     {
-        perror("Failed to open actions header file for writing");
         return false;
     }
+    FILE * actions_header_file = output.stream;
 
     fprintf(actions_header_file, "// Generated semantic actions header for %s\n", base_name);
     fprintf(actions_header_file, "#pragma once\n\n");
@@ -217,11 +544,30 @@ gdl_generate_semantic_actions_header(gdl_ast_node_t * ast_root, const char * bas
 
 
     fprintf(actions_header_file, "} %s_semantic_action_t;\n", base_name);
-    fclose(actions_header_file);
-    fprintf(stdout, "Generated: %s\n", actions_header_filepath);
 
     free_semantic_action_names(action_names_head); // Free the collected names
-    return true;
+    return gdl_output_file_close(&output, true);
+}
+
+bool
+gdl_generate_parser_header(const char * base_name, const char * output_dir)
+{
+    char header_filename[512];
+    snprintf(header_filename, sizeof(header_filename), "%s.h", base_name);
+
+    gdl_output_file_t output;
+    if (!gdl_output_file_open(&output, output_dir, header_filename))
+    {
+        return false;
+    }
+    FILE * header_file = output.stream;
+    fprintf(header_file, "// Generated header for %s\n", base_name);
+    fprintf(header_file, "#pragma once\n\n");
+    fprintf(header_file, "#include <easy_pc/easy_pc.h>\n");
+    fprintf(header_file, "#include \"%s_actions.h\"\n\n", base_name); // Include actions header
+    fprintf(header_file, "epc_parser_t * create_%s_parser(epc_parser_list * list);\n", base_name);
+
+    return gdl_output_file_close(&output, true);
 }
 
 static bool
@@ -233,6 +579,140 @@ generate_expression_code(
     const char * expression_name
     );
 
+// --- Keyword alternation detection ---
+
+// Returns the string value if the node is a (possibly wrapped) string literal, else NULL.
+char const *
+alternative_string_literal_value(gdl_ast_node_t * node)
+{
+    while (node != NULL)
+    {
+        if (node->type == GDL_AST_NODE_TYPE_TERMINAL)
+        {
+            node = node->data.terminal.expression;
+        }
+        else if (node->type == GDL_AST_NODE_TYPE_SEQUENCE && node->data.sequence.elements.count == 1)
+        {
+            node = node->data.sequence.elements.head->item;
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (node == NULL || node->type != GDL_AST_NODE_TYPE_STRING_LITERAL)
+    {
+        return NULL;
+    }
+    return node->data.string_literal.value;
+}
+
+/*
+ * An alternation can be emitted as epc_keywords() if every alternative is a
+ * string literal, and the longest-match semantics of epc_keywords() give the
+ * same result as trying the alternatives in order. That is the case unless an
+ * earlier alternative is a proper prefix of a later one.
+ */
+bool
+alternative_can_be_keyword_set(gdl_ast_node_t * alternative_node)
+{
+    gdl_ast_list_t * alternatives = &alternative_node->data.alternative.alternatives;
+
+    if (alternatives->count < 2)
+    {
+        return false;
+    }
+
+    for (gdl_ast_list_node_t * a = alternatives->head; a != NULL; a = a->next)
+    {
+        char const * earlier = alternative_string_literal_value(a->item);
+        if (earlier == NULL)
+        {
+            return false;
+        }
+        for (gdl_ast_list_node_t * b = a->next; b != NULL; b = b->next)
+        {
+            char const * later = alternative_string_literal_value(b->item);
+            if (later == NULL)
+            {
+                return false;
+            }
+            size_t earlier_len = strlen(earlier);
+            if (earlier_len < strlen(later) && strncmp(earlier, later, earlier_len) == 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * epc_keywords() makes a single leaf CPT node where epc_or() makes a node with
+ * the matching string as its child, so an alternation is only emitted as one
+ * when gdl_optimize() has chosen to. It is checked again, as reordering the
+ * alternatives by a profile can make a later alternative a prefix of an earlier one.
+ */
+bool
+alternative_is_keyword_set(gdl_ast_node_t * alternative_node)
+{
+    return alternative_node->data.alternative.as_keywords && alternative_can_be_keyword_set(alternative_node);
+}
+
+bool
+expression_has_unscoped_cut(gdl_ast_node_t * node)
+{
+    if (node == NULL)
+    {
+        return false;
+    }
+
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_KEYWORD:
+        return strcmp(node->data.keyword.name, "~") == 0;
+    case GDL_AST_NODE_TYPE_TERMINAL:
+        return expression_has_unscoped_cut(node->data.terminal.expression);
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        for (gdl_ast_list_node_t * element = node->data.sequence.elements.head; element != NULL; element = element->next)
+        {
+            if (expression_has_unscoped_cut(element->item))
+            {
+                return true;
+            }
+        }
+        return false;
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+        // A cut in an alternation of two or more commits that alternation.
+        return node->data.alternative.alternatives.count == 1
+            && expression_has_unscoped_cut(node->data.alternative.alternatives.head->item);
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+        // Only the first match of a '+' can't be backtracked over.
+        return node->data.repetition_expr.repetition->data.repetition_op.operator_char == '+'
+            && expression_has_unscoped_cut(node->data.repetition_expr.expression);
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+        return expression_has_unscoped_cut(node->data.count_call.expression);
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+        return expression_has_unscoped_cut(node->data.between_call.open_expr)
+            || expression_has_unscoped_cut(node->data.between_call.content_expr)
+            || expression_has_unscoped_cut(node->data.between_call.close_expr);
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        // Only the first item can't be backtracked over; the delimiters and later items are parsed outside of any alternation.
+        return expression_has_unscoped_cut(node->data.delimited_call.item_expr);
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        // A failing operator ends the chain, so it is parsed outside of any alternation.
+        return expression_has_unscoped_cut(node->data.chain_combinator_call.item_expr);
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        return expression_has_unscoped_cut(node->data.unary_combinator_call.expr);
+    default:
+        // Optional, many, skip, lookahead and not parse their expressions outside of any alternation.
+        return false;
+    }
+}
+
 // --- Rule List Management (for dependency analysis) ---
 
 static void
@@ -240,6 +720,10 @@ gdl_rule_list_init(gdl_rule_list_t * list)
 {
     list->head = NULL;
     list->tail = NULL;
+    list->analysis = (gdl_grammar_analysis_t){ 0 };
+    list->shard_count = 1;
+    list->current_shard = 0;
+    list->token_dfa = NULL;
 }
 
 static void
@@ -263,6 +747,7 @@ gdl_rule_list_add(gdl_rule_list_t * list, const char * rule_name, gdl_ast_node_t
     }
     else
     {
+        new_node->index = list->tail->index + 1;
         list->tail->next = new_node;
         list->tail = new_node;
     }
@@ -296,6 +781,7 @@ gdl_rule_list_free(gdl_rule_list_t * list)
     }
     list->head = NULL;
     list->tail = NULL;
+    gdl_grammar_analysis_free(&list->analysis);
 }
 
 
@@ -313,7 +799,12 @@ traverse_expression_for_references(gdl_ast_node_t * expression_node, const gdl_r
     case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
     {
         gdl_rule_info_t * referenced_rule = gdl_rule_list_find(all_rules, expression_node->data.identifier_ref.name);
-        if (referenced_rule != NULL && referenced_rule != current_rule_info)
+        if (referenced_rule != NULL && referenced_rule == current_rule_info)
+        {
+            // A rule that refers to itself is used before its variable is set, too.
+            referenced_rule->needs_forward_declaration = true;
+        }
+        else if (referenced_rule != NULL)
         {
             // Check if the referenced rule appears later in the list than the current rule
             gdl_rule_info_t * temp_current = all_rules->head;
@@ -344,116 +835,421 @@ traverse_expression_for_references(gdl_ast_node_t * expression_node, const gdl_r
         }
         break;
     }
-    case GDL_AST_NODE_TYPE_SEQUENCE:
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+    {
+        gdl_ast_list_node_t * current = expression_node->data.sequence.elements.head;
+        while (current != NULL)
+        {
+            traverse_expression_for_references(current->item, current_rule_info, all_rules);
+            current = current->next;
+        }
+        break;
+    }
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+    {
+        gdl_ast_list_node_t * current = expression_node->data.alternative.alternatives.head;
+        while (current != NULL)
+        {
+            traverse_expression_for_references(current->item, current_rule_info, all_rules);
+            current = current->next;
+        }
+        break;
+    }
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+    {
+        traverse_expression_for_references(expression_node->data.repetition_expr.expression, current_rule_info, all_rules);
+        break;
+    }
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+    {
+        traverse_expression_for_references(expression_node->data.optional.expr, current_rule_info, all_rules);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_TERMINAL:
+    {
+        // Terminals wrap other expressions (string, char, keyword, identifier_ref)
+        traverse_expression_for_references(expression_node->data.terminal.expression, current_rule_info, all_rules);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+        traverse_expression_for_references(expression_node->data.count_call.expression, current_rule_info, all_rules);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+        traverse_expression_for_references(expression_node->data.between_call.open_expr, current_rule_info, all_rules);
+        traverse_expression_for_references(expression_node->data.between_call.content_expr, current_rule_info, all_rules);
+        traverse_expression_for_references(expression_node->data.between_call.close_expr, current_rule_info, all_rules);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        traverse_expression_for_references(expression_node->data.delimited_call.item_expr, current_rule_info, all_rules);
+        traverse_expression_for_references(expression_node->data.delimited_call.delimiter_expr, current_rule_info, all_rules);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        traverse_expression_for_references(expression_node->data.unary_combinator_call.expr, current_rule_info, all_rules);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        traverse_expression_for_references(expression_node->data.chain_combinator_call.item_expr, current_rule_info, all_rules);
+        traverse_expression_for_references(expression_node->data.chain_combinator_call.op_expr, current_rule_info, all_rules);
+        break;
+
+        // Add other composite types here
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
+    case GDL_AST_NODE_TYPE_NUMBER_LITERAL:
+    case GDL_AST_NODE_TYPE_CHAR_RANGE:
+    case GDL_AST_NODE_TYPE_REPETITION_OPERATOR:
+    case GDL_AST_NODE_TYPE_SEMANTIC_ACTION: // action name, not a rule reference
+    case GDL_AST_NODE_TYPE_RAW_CHAR_LITERAL:
+    case GDL_AST_NODE_TYPE_KEYWORD: // GDL keywords like 'eoi', 'digit' are not rule references
+    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
+    case GDL_AST_NODE_TYPE_FAIL_CALL:
+    case GDL_AST_NODE_TYPE_PROGRAM: // Should not happen here
+    case GDL_AST_NODE_TYPE_RULE_DEFINITION: // Should not happen here
+    case GDL_AST_NODE_TYPE_ARGUMENT_LIST: // Should be handled by FUNCTION_CALL
+    case GDL_AST_NODE_TYPE_TOKEN_DFA: // The rules a token uses are part of its DFA
+    case GDL_AST_NODE_TYPE_PLACEHOLDER:
+        // These nodes do not contain further rule references in this context
+        break;
+    }
+}
+
+
+static bool
+gdl_analyze_rule_dependencies(gdl_ast_node_t * ast_root, gdl_rule_list_t * rule_list)
+{
+    if (ast_root == NULL || ast_root->type != GDL_AST_NODE_TYPE_PROGRAM || rule_list == NULL)
+    {
+        fprintf(stderr, "Error: Invalid arguments to gdl_analyze_rule_dependencies.\n");
+        return false;
+    }
+
+    gdl_rule_list_init(rule_list);
+
+    // Pass 1: Collect all rule names and their AST nodes
+    gdl_ast_list_node_t * current_ast_rule = ast_root->data.program.rules.head;
+    while (current_ast_rule != NULL)
+    {
+        gdl_ast_node_t * rule_def_node = current_ast_rule->item;
+        if (rule_def_node->type == GDL_AST_NODE_TYPE_RULE_DEFINITION)
+        {
+            gdl_rule_list_add(rule_list, rule_def_node->data.rule_def.name, rule_def_node);
+        }
+        current_ast_rule = current_ast_rule->next;
+    }
+
+    if (!gdl_grammar_analyze(ast_root, &rule_list->analysis))
+    {
+        gdl_rule_list_free(rule_list);
+        return false;
+    }
+
+    // Pass 2: Analyze dependencies and mark rules needing forward declarations
+    gdl_rule_info_t * current_rule_info = rule_list->head;
+    while (current_rule_info != NULL)
+    {
+        gdl_ast_node_t * rule_def_node = current_rule_info->ast_node;
+        traverse_expression_for_references(rule_def_node->data.rule_def.definition, current_rule_info, rule_list);
+        if (expression_has_unscoped_cut(rule_def_node->data.rule_def.definition))
+        {
+            // Completing the rule with epc_parser_duplicate() keeps its cuts from committing its callers' alternatives.
+            current_rule_info->needs_forward_declaration = true;
+        }
+        current_rule_info = current_rule_info->next;
+    }
+
+    return true;
+}
+
+// --- Main Code Generation Logic ---
+
+static void
+write_source_includes(FILE * source_file, const char * base_name)
+{
+    fprintf(source_file, "#include \"%s.h\"\n", base_name);
+    fprintf(source_file, "#include \"%s_actions.h\"\n", base_name); // Include actions header
+    fprintf(source_file, "#include <easy_pc/easy_pc.h>\n");
+    fprintf(source_file, "#include <stddef.h>\n"); // For NULL, size_t, etc.
+    fprintf(source_file, "#include <stdio.h>\n"); // For debugging, if needed
+}
+
+static void
+write_list_check(FILE * source_file, const char * base_name)
+{
+    fprintf(source_file, "    if (list == NULL)\n");
+    fprintf(source_file, "    {\n");
+    fprintf(source_file, "        fprintf(stderr, \"Error: Parser list is NULL in create_%s_parser.\\n\");\n", base_name);
+    fprintf(source_file, "        return NULL;\n");
+    fprintf(source_file, "    }\n\n");
+}
+
+// Writes <base_name>.c, holding the whole grammar.
+static bool
+generate_source(const char * base_name, const char * output_dir, gdl_rule_list_t * rule_dependencies, gdl_token_dfa_t const * token_dfa)
+{
+    char source_filename[512];
+    snprintf(source_filename, sizeof(source_filename), "%s.c", base_name);
+
+    gdl_output_file_t output;
+    if (!gdl_output_file_open(&output, output_dir, source_filename))
+    {
+        return false;
+    }
+    FILE * source_file = output.stream;
+
+    bool success = true;
+    fprintf(source_file, "// Generated source for %s\n", base_name);
+    write_source_includes(source_file, base_name);
+    fprintf(source_file, "\n");
+
+    gdl_token_dfa_write_tables(source_file, token_dfa, NULL);
+
+    fprintf(source_file, "epc_parser_t * create_%s_parser(epc_parser_list * list)\n", base_name);
+    fprintf(source_file, "{\n");
+
+    // Validate list argument
+    write_list_check(source_file, base_name);
+
+    // Iterate through rules to generate declarations and forward declarations
+    gdl_rule_info_t * current_rule_info = rule_dependencies->head;
+    if (current_rule_info != NULL)
+    {
+        fprintf(source_file, "    // Forward references:\n");
+    }
+    while (current_rule_info != NULL)
+    {
+        // Only allocate if a forward declaration is needed
+        if (current_rule_info->needs_forward_declaration)
+        {
+            char * pascal_rule_name = to_pascal_case(current_rule_info->name);
+            fprintf(source_file, "    epc_parser_t * %s = epc_parser_allocate_l(list, \"%s\");\n", pascal_rule_name, current_rule_info->name);
+            free(pascal_rule_name);
+        }
+        current_rule_info = current_rule_info->next;
+    }
+    fprintf(source_file, "\n");
+
+    // Now, iterate again to define each rule
+    current_rule_info = rule_dependencies->head;
+    while (current_rule_info != NULL)
+    {
+        gdl_ast_node_t * rule_def = current_rule_info->ast_node;
+        if (!generate_rule_definition_code(source_file, rule_def, 1, rule_dependencies))
+        {
+            success = false;
+            break;
+        }
+        fprintf(source_file, "\n");
+        current_rule_info = current_rule_info->next;
+    }
+
+    // Return the Program rule parser
+    char * pascal_program_name = to_pascal_case(rule_dependencies->tail->name);
+    fprintf(source_file, "    return %s;\n", pascal_program_name);
+    free(pascal_program_name);
+
+    fprintf(source_file, "}\n");
+
+    return gdl_output_file_close(&output, success) && success;
+}
+
+// Writes <base_name>_shards.h, which declares the function defining the rules of each shard.
+static bool
+generate_shards_header(const char * base_name, const char * output_dir, int shard_count)
+{
+    char header_filename[512];
+    snprintf(header_filename, sizeof(header_filename), "%s_shards.h", base_name);
+
+    gdl_output_file_t output;
+    if (!gdl_output_file_open(&output, output_dir, header_filename))
+    {
+        return false;
+    }
+    FILE * header_file = output.stream;
+
+    fprintf(header_file, "// Generated header for the shards of %s\n", base_name);
+    fprintf(header_file, "#pragma once\n\n");
+    fprintf(header_file, "#include <easy_pc/easy_pc.h>\n\n");
+    fprintf(header_file, "// Each shard defines its rules, and finds the rules of the other shards in rules[], indexed in\n");
+    fprintf(header_file, "// definition order. Rules that are referenced before they are defined are allocated up front.\n");
+    for (int shard = 1; shard <= shard_count; shard++)
     {
-        gdl_ast_list_node_t * current = expression_node->data.sequence.elements.head;
-        while (current != NULL)
-        {
-            traverse_expression_for_references(current->item, current_rule_info, all_rules);
-            current = current->next;
-        }
-        break;
+        fprintf(header_file,
+                "void create_%s_parser_shard_%d(epc_parser_list * list, epc_parser_t * * rules, epc_dfa_t const * const * token_dfas);\n",
+                base_name, shard);
     }
-    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+
+    return gdl_output_file_close(&output, true);
+}
+
+// Writes <base_name>_shard_<n>.c, defining the rules of one shard.
+static bool
+generate_shard_source(const char * base_name, const char * output_dir, gdl_rule_list_t * rule_dependencies, int shard)
+{
+    char source_filename[512];
+    snprintf(source_filename, sizeof(source_filename), "%s_shard_%d.c", base_name, shard + 1);
+
+    gdl_output_file_t output;
+    if (!gdl_output_file_open(&output, output_dir, source_filename))
     {
-        gdl_ast_list_node_t * current = expression_node->data.alternative.alternatives.head;
-        while (current != NULL)
-        {
-            traverse_expression_for_references(current->item, current_rule_info, all_rules);
-            current = current->next;
-        }
-        break;
+        return false;
     }
-    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+    FILE * source_file = output.stream;
+
+    bool success = true;
+    rule_dependencies->current_shard = shard;
+    fprintf(source_file, "// Generated source for %s, shard %d of %d\n", base_name, shard + 1, rule_dependencies->shard_count);
+    fprintf(source_file, "#include \"%s_shards.h\"\n", base_name);
+    fprintf(source_file, "#include \"%s_actions.h\"\n", base_name);
+    fprintf(source_file, "#include <easy_pc/easy_pc.h>\n");
+    fprintf(source_file, "#include <stddef.h>\n");
+    fprintf(source_file, "\n");
+
+    fprintf(source_file,
+            "void create_%s_parser_shard_%d(epc_parser_list * list, epc_parser_t * * rules, epc_dfa_t const * const * token_dfas)\n",
+            base_name, shard + 1);
+    fprintf(source_file, "{\n");
+    fprintf(source_file, "    (void)token_dfas; // Not every shard has token rules.\n\n");
+
+    bool has_forward_references = false;
+    for (gdl_rule_info_t * rule_info = rule_dependencies->head; rule_info != NULL; rule_info = rule_info->next)
     {
-        traverse_expression_for_references(expression_node->data.repetition_expr.expression, current_rule_info, all_rules);
-        break;
+        if (rule_info->shard == shard && rule_info->needs_forward_declaration)
+        {
+            char * pascal_rule_name = to_pascal_case(rule_info->name);
+            if (!has_forward_references)
+            {
+                fprintf(source_file, "    // Forward references:\n");
+                has_forward_references = true;
+            }
+            fprintf(source_file, "    epc_parser_t * %s = rules[%d];\n", pascal_rule_name, rule_info->index);
+            free(pascal_rule_name);
+        }
     }
-    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+    if (has_forward_references)
     {
-        traverse_expression_for_references(expression_node->data.optional.expr, current_rule_info, all_rules);
-        break;
+        fprintf(source_file, "\n");
     }
 
-    case GDL_AST_NODE_TYPE_TERMINAL:
+    bool first_rule = true;
+    for (gdl_rule_info_t * rule_info = rule_dependencies->head; rule_info != NULL && success; rule_info = rule_info->next)
     {
-        // Terminals wrap other expressions (string, char, keyword, identifier_ref)
-        traverse_expression_for_references(expression_node->data.terminal.expression, current_rule_info, all_rules);
-        break;
+        if (rule_info->shard != shard)
+        {
+            continue;
+        }
+        if (!first_rule)
+        {
+            fprintf(source_file, "\n");
+        }
+        first_rule = false;
+        if (!generate_rule_definition_code(source_file, rule_info->ast_node, 1, rule_dependencies))
+        {
+            success = false;
+            break;
+        }
+        if (!rule_info->needs_forward_declaration)
+        {
+            char * pascal_rule_name = to_pascal_case(rule_info->name);
+            fprintf(source_file, "    rules[%d] = %s;\n", rule_info->index, pascal_rule_name);
+            free(pascal_rule_name);
+        }
     }
 
-        // Add other composite types here
-    case GDL_AST_NODE_TYPE_STRING_LITERAL:
-    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
-    case GDL_AST_NODE_TYPE_NUMBER_LITERAL:
-    case GDL_AST_NODE_TYPE_CHAR_RANGE:
-    case GDL_AST_NODE_TYPE_REPETITION_OPERATOR:
-    case GDL_AST_NODE_TYPE_SEMANTIC_ACTION: // action name, not a rule reference
-    case GDL_AST_NODE_TYPE_RAW_CHAR_LITERAL:
-    case GDL_AST_NODE_TYPE_KEYWORD: // GDL keywords like 'eoi', 'digit' are not rule references
-    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
-    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
-    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
-    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
-    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
-    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
-    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
-    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
-    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
-    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
-    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
-    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
-    case GDL_AST_NODE_TYPE_FAIL_CALL:
-    case GDL_AST_NODE_TYPE_PROGRAM: // Should not happen here
-    case GDL_AST_NODE_TYPE_RULE_DEFINITION: // Should not happen here
-    case GDL_AST_NODE_TYPE_ARGUMENT_LIST: // Should be handled by FUNCTION_CALL
-    case GDL_AST_NODE_TYPE_PLACEHOLDER:
-        // These nodes do not contain further rule references in this context
-        break;
-    }
-}
+    fprintf(source_file, "}\n");
 
+    return gdl_output_file_close(&output, success) && success;
+}
 
+// Writes <base_name>.c, which creates the rule table and has each shard define its rules.
 static bool
-gdl_analyze_rule_dependencies(gdl_ast_node_t * ast_root, gdl_rule_list_t * rule_list)
+generate_sharded_source(const char * base_name, const char * output_dir, gdl_rule_list_t * rule_dependencies, gdl_token_dfa_t const * token_dfa)
 {
-    if (ast_root == NULL || ast_root->type != GDL_AST_NODE_TYPE_PROGRAM || rule_list == NULL)
+    char source_filename[512];
+    snprintf(source_filename, sizeof(source_filename), "%s.c", base_name);
+
+    gdl_output_file_t output;
+    if (!gdl_output_file_open(&output, output_dir, source_filename))
     {
-        fprintf(stderr, "Error: Invalid arguments to gdl_analyze_rule_dependencies.\n");
         return false;
     }
+    FILE * source_file = output.stream;
 
-    gdl_rule_list_init(rule_list);
+    fprintf(source_file, "// Generated source for %s\n", base_name);
+    write_source_includes(source_file, base_name);
+    fprintf(source_file, "#include \"%s_shards.h\"\n", base_name);
+    fprintf(source_file, "#include <stdlib.h>\n");
+    fprintf(source_file, "\n");
 
-    // Pass 1: Collect all rule names and their AST nodes
-    gdl_ast_list_node_t * current_ast_rule = ast_root->data.program.rules.head;
-    while (current_ast_rule != NULL)
+    gdl_token_dfa_write_tables(source_file, token_dfa, NULL);
+    if (token_dfa->token_count > 0)
     {
-        gdl_ast_node_t * rule_def_node = current_ast_rule->item;
-        if (rule_def_node->type == GDL_AST_NODE_TYPE_RULE_DEFINITION)
+        fprintf(source_file, "static epc_dfa_t const * const token_dfas[] = {\n");
+        for (int t = 0; t < token_dfa->token_count; t++)
         {
-            gdl_rule_list_add(rule_list, rule_def_node->data.rule_def.name, rule_def_node);
+            char * object_name = gdl_token_dfa_object_name(token_dfa->tokens[t].rule->data.rule_def.name);
+            fprintf(source_file, "    &%s,\n", object_name != NULL ? object_name : "token_dfa");
+            free(object_name);
         }
-        current_ast_rule = current_ast_rule->next;
+        fprintf(source_file, "};\n\n");
     }
 
-    // Pass 2: Analyze dependencies and mark rules needing forward declarations
-    gdl_rule_info_t * current_rule_info = rule_list->head;
-    while (current_rule_info != NULL)
+    fprintf(source_file, "epc_parser_t * create_%s_parser(epc_parser_list * list)\n", base_name);
+    fprintf(source_file, "{\n");
+    write_list_check(source_file, base_name);
+
+    fprintf(source_file, "    // The rules, in definition order, where the shards find each other's rules.\n");
+    fprintf(source_file, "    epc_parser_t * * rules = calloc(%d, sizeof(*rules));\n", rule_dependencies->tail->index + 1);
+    fprintf(source_file, "    if (rules == NULL)\n");
+    fprintf(source_file, "    {\n");
+    fprintf(source_file, "        return NULL;\n");
+    fprintf(source_file, "    }\n\n");
+
+    fprintf(source_file, "    // Forward references:\n");
+    for (gdl_rule_info_t * rule_info = rule_dependencies->head; rule_info != NULL; rule_info = rule_info->next)
     {
-        gdl_ast_node_t * rule_def_node = current_rule_info->ast_node;
-        traverse_expression_for_references(rule_def_node->data.rule_def.definition, current_rule_info, rule_list);
-        current_rule_info = current_rule_info->next;
+        if (rule_info->needs_forward_declaration)
+        {
+            fprintf(source_file, "    rules[%d] = epc_parser_allocate_l(list, \"%s\");\n", rule_info->index, rule_info->name);
+        }
     }
+    fprintf(source_file, "\n");
 
-    return true;
-}
+    for (int shard = 1; shard <= rule_dependencies->shard_count; shard++)
+    {
+        fprintf(source_file, "    create_%s_parser_shard_%d(list, rules, %s);\n",
+                base_name, shard, token_dfa->token_count > 0 ? "token_dfas" : "NULL");
+    }
+    fprintf(source_file, "\n");
 
-// --- Main Code Generation Logic ---
+    // Return the Program rule parser
+    fprintf(source_file, "    epc_parser_t * parser = rules[%d];\n", rule_dependencies->tail->index);
+    fprintf(source_file, "    free(rules);\n\n");
+    fprintf(source_file, "    return parser;\n");
+    fprintf(source_file, "}\n");
+
+    return gdl_output_file_close(&output, true);
+}
 
 bool gdl_generate_c_code(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir)
 {
-    if (ast_root == NULL || ast_root->type != GDL_AST_NODE_TYPE_PROGRAM || base_name == NULL || output_dir == NULL)
+    return gdl_generate_sharded_c_code(ast_root, base_name, output_dir, 1);
+}
+
+bool
+gdl_generate_sharded_c_code(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir, int shard_count)
+{
+    if (ast_root == NULL || ast_root->type != GDL_AST_NODE_TYPE_PROGRAM || base_name == NULL || output_dir == NULL || shard_count < 1)
     {
         fprintf(stderr, "Error: Invalid arguments or AST root type to gdl_generate_c_code.\n");
         return false;
@@ -463,19 +1259,30 @@ bool gdl_generate_c_code(gdl_ast_node_t * ast_root, const char * base_name, cons
 
     bool success = true;
     gdl_rule_list_t rule_dependencies;
+    gdl_token_dfa_t token_dfa;
+
+    // Token rules are matched by a DFA, so their definitions aren't generated as parsers
+    if (!gdl_token_dfa_build(ast_root, &token_dfa))
+    {
+        gdl_token_dfa_free(&token_dfa);
+        return false;
+    }
 
     // Analyze rule dependencies to determine forward declarations
     if (!gdl_analyze_rule_dependencies(ast_root, &rule_dependencies))
     {
+        gdl_token_dfa_free(&token_dfa);
         return false;
     }
 
-    // --- File Paths ---
-    char header_filepath[512];
-    char source_filepath[512];
-
-    snprintf(header_filepath, sizeof(header_filepath), "%s/%s.h", output_dir, base_name);
-    snprintf(source_filepath, sizeof(source_filepath), "%s/%s.c", output_dir, base_name);
+    // Split the rules, in order, into shards of about the same number of rules.
+    int rule_count = rule_dependencies.tail->index + 1;
+    rule_dependencies.shard_count = shard_count < rule_count ? shard_count : rule_count;
+    rule_dependencies.token_dfa = &token_dfa;
+    for (gdl_rule_info_t * rule_info = rule_dependencies.head; rule_info != NULL; rule_info = rule_info->next)
+    {
+        rule_info->shard = (int)((long long)rule_info->index * rule_dependencies.shard_count / rule_count);
+    }
 
     // --- Generate Semantic Actions Header (placeholder for now) ---
     // This function will now be implemented.
@@ -484,90 +1291,27 @@ bool gdl_generate_c_code(gdl_ast_node_t * ast_root, const char * base_name, cons
         success = false;
     }
 
-
-    // --- Generate Parser Header ---
-    FILE * header_file = fopen(header_filepath, "w");
-    if (header_file == NULL)
-    {
-        perror("Failed to open header file for writing");
-        return false;
-    }
-    fprintf(header_file, "// Generated header for %s\n", base_name);
-    fprintf(header_file, "#pragma once\n\n");
-    fprintf(header_file, "#include <easy_pc/easy_pc.h>\n");
-    fprintf(header_file, "#include \"%s_actions.h\"\n\n", base_name); // Include actions header
-    fprintf(header_file, "epc_parser_t * create_%s_parser(epc_parser_list * list);\n", base_name);
-    fclose(header_file);
-    fprintf(stdout, "Generated: %s\n", header_filepath);
-
-    // --- Generate Parser Source ---
-    FILE * source_file = fopen(source_filepath, "w");
-    if (source_file == NULL)
-    {
-        perror("Failed to open source file for writing");
-        return false;
-    }
-    fprintf(source_file, "// Generated source for %s\n", base_name);
-    fprintf(source_file, "#include \"%s.h\"\n", base_name);
-    fprintf(source_file, "#include \"%s_actions.h\"\n", base_name); // Include actions header
-    fprintf(source_file, "#include <easy_pc/easy_pc.h>\n");
-    fprintf(source_file, "#include <stddef.h>\n"); // For NULL, size_t, etc.
-    fprintf(source_file, "#include <stdio.h>\n"); // For debugging, if needed
-    fprintf(source_file, "\n");
-
-    fprintf(source_file, "epc_parser_t * create_%s_parser(epc_parser_list * list)\n", base_name);
-    fprintf(source_file, "{\n");
-
-    // Validate list argument
-    fprintf(source_file, "    if (list == NULL)\n");
-    fprintf(source_file, "    {\n");
-    fprintf(source_file, "        fprintf(stderr, \"Error: Parser list is NULL in create_%s_parser.\\n\");\n", base_name);
-    fprintf(source_file, "        return NULL;\n");
-    fprintf(source_file, "    }\n\n");
-
-    // Iterate through rules to generate declarations and forward declarations
-    gdl_rule_info_t * current_rule_info = rule_dependencies.head;
-    if (current_rule_info != NULL)
+    // --- Generate Parser Header and Source ---
+    if (!gdl_generate_parser_header(base_name, output_dir))
     {
-        fprintf(source_file, "    // Forward references:\n");
+        success = false;
     }
-    while (current_rule_info != NULL)
+    else if (rule_dependencies.shard_count == 1)
     {
-        // Only allocate if a forward declaration is needed
-        if (current_rule_info->needs_forward_declaration)
-        {
-            char * pascal_rule_name = to_pascal_case(current_rule_info->name);
-            fprintf(source_file, "    epc_parser_t * %s = epc_parser_allocate_l(list, \"%s\");\n", pascal_rule_name, current_rule_info->name);
-            free(pascal_rule_name);
-        }
-        current_rule_info = current_rule_info->next;
+        success = generate_source(base_name, output_dir, &rule_dependencies, &token_dfa) && success;
     }
-    fprintf(source_file, "\n");
-
-    // Now, iterate again to define each rule
-    current_rule_info = rule_dependencies.head;
-    while (current_rule_info != NULL)
+    else
     {
-        gdl_ast_node_t * rule_def = current_rule_info->ast_node;
-        if (!generate_rule_definition_code(source_file, rule_def, 1, &rule_dependencies))
+        success = generate_shards_header(base_name, output_dir, rule_dependencies.shard_count) && success;
+        for (int shard = 0; shard < rule_dependencies.shard_count && success; shard++)
         {
-            success = false;
-            break;
+            success = generate_shard_source(base_name, output_dir, &rule_dependencies, shard);
         }
-        fprintf(source_file, "\n");
-        current_rule_info = current_rule_info->next;
+        success = success && generate_sharded_source(base_name, output_dir, &rule_dependencies, &token_dfa);
     }
 
-    // Return the Program rule parser
-    char * pascal_program_name = to_pascal_case(ast_root->data.program.rules.tail->item->data.rule_def.name);
-    fprintf(source_file, "    return %s;\n", pascal_program_name);
-    free(pascal_program_name);
-
-    fprintf(source_file, "}\n");
-    fclose(source_file);
-    fprintf(stdout, "Generated: %s\n", source_filepath);
-
     gdl_rule_list_free(&rule_dependencies);
+    gdl_token_dfa_free(&token_dfa);
     return success;
 }
 
@@ -679,12 +1423,28 @@ generate_expression_code(
         break;
 
     case GDL_AST_NODE_TYPE_CHAR_LITERAL:
-        fprintf(source_file, "epc_char_l(list, %s%s%s, '%c')", q, expr_name, q, expression_node->data.char_literal.value);
+    {
+        char * c = c_char_constant((unsigned char)expression_node->data.char_literal.value);
+        if (c == NULL)
+        {
+            return false;
+        }
+        fprintf(source_file, "epc_char_l(list, %s%s%s, %s)", q, expr_name, q, c);
+        free(c);
         break;
+    }
 
     case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
     {
         // This is now purely a reference to another rule
+        gdl_rule_info_t const * referenced_rule =
+            rule_list->shard_count > 1 ? gdl_rule_list_find((gdl_rule_list_t *)rule_list, expression_node->data.identifier_ref.name) : NULL;
+        if (referenced_rule != NULL && referenced_rule->shard != rule_list->current_shard)
+        {
+            // Defined in another shard.
+            fprintf(source_file, "rules[%d]", referenced_rule->index);
+            break;
+        }
         char * pascal_ref_name = to_pascal_case(expression_node->data.identifier_ref.name);
         fprintf(source_file, "%s", pascal_ref_name);
         free(pascal_ref_name);
@@ -723,6 +1483,10 @@ generate_expression_code(
         {
             fprintf(source_file, "epc_succeed_l(list, \"%s\")", keyword_name);
         }
+        else if (strcmp(keyword_name, "~") == 0)
+        {
+            fprintf(source_file, "epc_cut_l(list, \"cut\")");
+        }
         else if (strcmp(keyword_name, "hex_digit") == 0)
         {
             fprintf(source_file, "epc_hex_digit_l(list, \"%s\")", keyword_name);
@@ -807,10 +1571,38 @@ generate_expression_code(
                 return false;
             }
         }
+        else if (alternative_is_keyword_set(expression_node))
+        {
+            // All alternatives are strings, so match them in one pass with a keyword trie
+            fprintf(source_file, "epc_keywords_l(list, %s%s%s, (char const * const[]){", q, expr_name, q);
+            gdl_ast_list_node_t * current_alt = expression_node->data.alternative.alternatives.head;
+            while (current_alt != NULL)
+            {
+                fprintf(source_file, "\"%s\"%s", alternative_string_literal_value(current_alt->item), current_alt->next != NULL ? ", " : "");
+                current_alt = current_alt->next;
+            }
+            fprintf(source_file, "}, %d)", expression_node->data.alternative.alternatives.count);
+        }
         else
         {
-            // Generate epc_or_l for multiple alternatives
-            fprintf(source_file, "epc_or_l(list, %s%s%s, %d", q, expr_name, q, expression_node->data.alternative.alternatives.count);
+            gdl_char_set_t * first = alternative_predict_sets(&rule_list->analysis, expression_node);
+            if (first != NULL)
+            {
+                // Let the parser skip the alternatives that can't start with the next byte
+                fprintf(source_file, "epc_or_first_l(list, %s%s%s, (epc_first_set_t const[]){", q, expr_name, q);
+                for (int i = 0; i < expression_node->data.alternative.alternatives.count; i++)
+                {
+                    fprintf(source_file, "%s", i > 0 ? ", " : "");
+                    write_first_set_initializer(source_file, &first[i]);
+                }
+                fprintf(source_file, "}, %d", expression_node->data.alternative.alternatives.count);
+                free(first);
+            }
+            else
+            {
+                // Generate epc_or_l for multiple alternatives
+                fprintf(source_file, "epc_or_l(list, %s%s%s, %d", q, expr_name, q, expression_node->data.alternative.alternatives.count);
+            }
             gdl_ast_list_node_t * current_alt = expression_node->data.alternative.alternatives.head;
             while (current_alt != NULL)
             {
@@ -873,6 +1665,16 @@ generate_expression_code(
         fprintf(source_file, "%lld", expression_node->data.number_literal.value);
         break;
 
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+        fprintf(source_file, "epc_count_l(list, %s%s%s, %lld, ", q, expr_name, q,
+                expression_node->data.count_call.count_node->data.number_literal.value);
+        if (!generate_expression_code(source_file, expression_node->data.count_call.expression, indent_level + 1, rule_list, NULL))
+        {
+            return false;
+        }
+        fprintf(source_file, ")");
+        break;
+
     case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN: // GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN
         fprintf(source_file, "epc_between_l(list, %s%s%s, ", q, expr_name, q);
         if (!generate_expression_code(source_file, expression_node->data.between_call.open_expr, indent_level + 1, rule_list, NULL))
@@ -971,11 +1773,22 @@ generate_expression_code(
         break;
 
     case GDL_AST_NODE_TYPE_CHAR_RANGE:
-        fprintf(source_file, "epc_char_range_l(list, %s%s%s, '%c', '%c')",
-                q, expr_name, q,
-                expression_node->data.char_range.start_char,
-                expression_node->data.char_range.end_char);
+    {
+        char * start = c_char_constant((unsigned char)expression_node->data.char_range.start_char);
+        char * end = c_char_constant((unsigned char)expression_node->data.char_range.end_char);
+        bool const ok = start != NULL && end != NULL;
+        if (ok)
+        {
+            fprintf(source_file, "epc_char_range_l(list, %s%s%s, %s, %s)", q, expr_name, q, start, end);
+        }
+        free(start);
+        free(end);
+        if (!ok)
+        {
+            return false;
+        }
         break;
+    }
 
     case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
         fprintf(source_file, "epc_lexeme_l(list, %s%s%s, ", q, expr_name, q);
@@ -1007,6 +1820,37 @@ generate_expression_code(
         break;
     }
 
+    case GDL_AST_NODE_TYPE_TOKEN_DFA:
+    {
+        // The DFA is named after its rule even when wrapped in a lexeme, as the name is what errors expect.
+        char * object_name = gdl_token_dfa_object_name(expression_node->data.token_dfa.rule_name);
+        char * pascal_rule_name = to_pascal_case(expression_node->data.token_dfa.rule_name);
+        if (object_name == NULL || pascal_rule_name == NULL)
+        {
+            free(object_name);
+            free(pascal_rule_name);
+            return false;
+        }
+        if (rule_list->shard_count > 1)
+        {
+            // The DFAs are in the main source file.
+            int t = 0;
+            while (t < rule_list->token_dfa->token_count
+                   && strcmp(rule_list->token_dfa->tokens[t].rule->data.rule_def.name, expression_node->data.token_dfa.rule_name) != 0)
+            {
+                t++;
+            }
+            fprintf(source_file, "epc_dfa_l(list, \"%s\", token_dfas[%d])", expression_name != NULL ? expression_name : pascal_rule_name, t);
+        }
+        else
+        {
+            fprintf(source_file, "epc_dfa_l(list, \"%s\", &%s)", expression_name != NULL ? expression_name : pascal_rule_name, object_name);
+        }
+        free(object_name);
+        free(pascal_rule_name);
+        break;
+    }
+
         // Handle other AST node types as needed
     default:
         fprintf(stderr, "Error: Unsupported AST node type for code generation: %d\n", expression_node->type);
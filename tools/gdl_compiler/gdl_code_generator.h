@@ -3,6 +3,7 @@
 #include "gdl_ast.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 
 // Function to generate C code from the GDL AST
 // ast_root: The root of the GDL AST
@@ -11,3 +12,30 @@
 // Returns true on success, false on failure.
 bool gdl_generate_c_code(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir);
 
+// Like gdl_generate_c_code(), but with the rules split, in order, across
+// shard_count source files (<base_name>_shard_<n>.c), so a very large grammar
+// doesn't make one huge function for the C compiler. The shards find each
+// other's rules through a table made by create_<base_name>_parser() in
+// <base_name>.c. The parser is the same. A shard_count of 1 is the same as
+// gdl_generate_c_code().
+bool gdl_generate_sharded_c_code(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir, int shard_count);
+
+
+// Like gdl_generate_c_code(), but the generated parser is a set of C functions
+// that match the input directly rather than a graph of easy_pc combinators.
+// Left-recursive grammars aren't supported.
+bool gdl_generate_direct_c_code(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir);
+
+// Like gdl_generate_c_code(), but the generated parser is statically
+// initialized const data, so creating it allocates nothing and it is never
+// freed.
+bool gdl_generate_static_c_code(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir);
+
+// Writes the grammar as a blob (<base_name>.epcg) for epc_grammar_load_blob()
+// to build the default backend's parsers from at run time, and the actions
+// header to go with it.
+bool gdl_generate_grammar_blob(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir);
+
+// Builds the blob that gdl_generate_grammar_blob() writes, in memory. On
+// success *blob is newly allocated, to be freed by the caller.
+bool gdl_build_grammar_blob(gdl_ast_node_t * ast_root, unsigned char * * blob, size_t * size);
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "gdl_ast.h"
+#include "gdl_grammar_analysis.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Helpers shared by the code generator backends.
+
+// Returns a newly allocated PascalCase copy of str, used for the C names of rules.
+char * to_pascal_case(const char * str);
+
+// Returns a newly allocated upper case copy of str, used for semantic action names.
+char * to_upper_case(const char * str);
+
+// Returns a newly allocated string formatted as by printf(), or NULL on error.
+char * str_printf(char const * format, ...);
+
+// Returns a newly allocated C character constant for c, e.g. 'a' or '\x0a'.
+char * c_char_constant(unsigned char c);
+
+// Returns a newly allocated C string literal holding just c.
+char * c_string_literal_of_char(unsigned char c);
+
+/*
+ * Returns a newly allocated copy of text, the value of a string literal as
+ * written in the grammar, with its C escape sequences replaced by the bytes
+ * they stand for. Anything after an escaped NUL is dropped, as the library
+ * would do.
+ */
+char * c_string_unescape(char const * text);
+
+// Returns a newly allocated copy of text, escaped to be the value of a string literal.
+char * c_string_escape(char const * text);
+
+// Skips the terminal wrappers and single element sequences and alternatives that the generators promote.
+gdl_ast_node_t * unwrap_expression(gdl_ast_node_t * node);
+
+// Returns the string value if the node is a (possibly wrapped) string literal, else NULL.
+char const * alternative_string_literal_value(gdl_ast_node_t * node);
+
+// Returns true if the alternation can be matched as a set of keywords.
+bool alternative_can_be_keyword_set(gdl_ast_node_t * alternative_node);
+
+// Returns true if the alternation is to be emitted as a set of keywords, as gdl_optimize() marks them.
+bool alternative_is_keyword_set(gdl_ast_node_t * alternative_node);
+
+/*
+ * Returns true if the expression has a cut that isn't within an alternation
+ * of its own, which would commit an alternation of whatever uses it. Rules
+ * with one are completed with epc_parser_duplicate(), as epc_rule_parse_fn()
+ * keeps the cut within the rule.
+ */
+bool expression_has_unscoped_cut(gdl_ast_node_t * node);
+
+/*
+ * Returns a newly allocated array with the predict set (see
+ * gdl_expression_predict()) of each alternative, for epc_or_first(). Returns
+ * NULL if no alternative could be skipped, or on error, in which case a plain
+ * epc_or() does the same job.
+ */
+gdl_char_set_t * alternative_predict_sets(gdl_grammar_analysis_t const * analysis, gdl_ast_node_t * alternative_node);
+
+// Writes the set as the initializer of an epc_first_set_t.
+void write_first_set_initializer(FILE * out, gdl_char_set_t const * set);
+
+/*
+ * A generated file. It is written to memory, and only replaces the file on
+ * disk if its contents have changed, so that build tools don't rebuild
+ * whatever depends on an output that came out the same.
+ */
+typedef struct
+{
+    char * path;
+    char * text;
+    size_t size;
+    FILE * stream;      // Where to write the contents.
+} gdl_output_file_t;
+
+// Starts output_dir/file_name. Returns false, having reported why, on error.
+bool gdl_output_file_open(gdl_output_file_t * output, char const * output_dir, char const * file_name);
+
+// Finishes the file, writing it out if keep is true and it has changed. Returns false, having reported why, on error.
+bool gdl_output_file_close(gdl_output_file_t * output, bool keep);
+
+// Writes <base_name>_actions.h, with an enum value for each semantic action used in the grammar.
+bool gdl_generate_semantic_actions_header(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir);
+
+// Writes <base_name>.h, which declares create_<base_name>_parser().
+bool gdl_generate_parser_header(const char * base_name, const char * output_dir);
+
+/*
+ * The parser objects the default backend builds for the rules, for the
+ * backends that build the same parser graph another way. The arrays are
+ * indexed like analysis->rules.
+ *
+ * Rules referenced from themselves or from an earlier rule are the ones the
+ * default backend completes with epc_parser_duplicate(), so they handle left
+ * recursion.
+ */
+typedef struct
+{
+    gdl_grammar_analysis_t const * analysis;
+    int * rule_object;              // The rule whose object the rule resolves to.
+    bool * rule_wrapped;            // True if the object is completed with epc_parser_duplicate().
+    bool * rule_reachable;          // True if the start rule uses the object.
+    char const * * rule_actions;    // The semantic action of each object, or NULL.
+    int start_object;               // The object of the start rule, the last rule.
+    bool has_error;
+} gdl_rule_objects_t;
+
+// Works out the objects of the rules. Returns false, having reported why, on error.
+bool gdl_rule_objects_init(gdl_rule_objects_t * objects, gdl_grammar_analysis_t const * analysis);
+
+void gdl_rule_objects_free(gdl_rule_objects_t * objects);
+
+// Returns the index of the named rule, or reports the reference and returns -1 if there is no such rule.
+int gdl_rule_objects_rule_index(gdl_rule_objects_t * objects, char const * name);
@@ -5,6 +5,7 @@
 #include "easy_pc_private.h" // For epc_ast_builder_set_error
 
 #include <assert.h>
+#include <limits.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -209,6 +210,10 @@ gdl_ast_node_free(void * node_ptr, void * user_data)
         gdl_ast_list_free_recursive(&node->data.argument_list, user_data);
         break;
 
+    case GDL_AST_NODE_TYPE_TOKEN_DFA:
+        gdl_ast_node_free(node->data.token_dfa.expression, user_data);
+        break;
+
         /* The following nod types have no dynamic data to free. */
     case GDL_AST_NODE_TYPE_NUMBER_LITERAL: // No dynamic data to free
     case GDL_AST_NODE_TYPE_CHAR_LITERAL:   // No dynamic data to free
@@ -534,6 +539,23 @@ handle_create_number_literal(
     epc_ast_push(ctx, ast_node);
 }
 
+// Returns the character an escape sequence, a backslash followed by c, stands for.
+static char
+unescape_char(char c)
+{
+    switch (c)
+    {
+    case 'n':
+        return '\n';
+    case 't':
+        return '\t';
+    case 'r':
+        return '\r';
+    default:
+        return c;
+    }
+}
+
 static void
 handle_create_char_literal(
     epc_ast_builder_ctx_t * ctx,
@@ -569,9 +591,14 @@ handle_create_char_literal(
     {
         // Assuming char literal might includes quotes, so extract the char in between
         size_t len = epc_cpt_node_get_semantic_len(node);
-        if (len >= 3 && epc_cpt_node_get_semantic_content(node)[0] == '\'' && epc_cpt_node_get_semantic_content(node)[len - 1] == '\'')
+        char const * content = epc_cpt_node_get_semantic_content(node);
+        if (len == 4 && content[0] == '\'' && content[1] == '\\' && content[3] == '\'')
         {
-            ast_node->data.char_literal.value = epc_cpt_node_get_semantic_content(node)[1];
+            ast_node->data.char_literal.value = unescape_char(content[2]);
+        }
+        else if (len >= 3 && content[0] == '\'' && content[len - 1] == '\'')
+        {
+            ast_node->data.char_literal.value = content[1];
         }
         else if (len >= 1)
         {
@@ -666,7 +693,15 @@ handle_create_raw_char_literal(
     gdl_ast_node_t * ast_node = gdl_ast_node_alloc(ctx, GDL_AST_NODE_TYPE_RAW_CHAR_LITERAL);
     if (ast_node)
     {
-        ast_node->data.raw_char_literal.value = epc_cpt_node_get_semantic_content(node)[0];
+        char const * content = epc_cpt_node_get_semantic_content(node);
+        if (epc_cpt_node_get_semantic_len(node) == 2 && content[0] == '\\')
+        {
+            ast_node->data.raw_char_literal.value = unescape_char(content[1]);
+        }
+        else
+        {
+            ast_node->data.raw_char_literal.value = content[0];
+        }
     }
     epc_ast_push(ctx, ast_node);
 }
@@ -744,15 +779,34 @@ handle_create_rule_definition(
 #endif
 
     (void)node;
-    if (count < 2 || count > 3)
+    if (count < 2 || count > 4)
     {
-        epc_ast_builder_set_error(ctx, "Rule definition expects 2 or 3 children (identifier, definition, optional_semantic_action), got %d", count);
+        epc_ast_builder_set_error(ctx, "Rule definition expects 2 to 4 children (optional token keyword, identifier, definition, optional_semantic_action), got %d", count);
         for (int i = 0; i < count; ++i) {
             gdl_ast_node_free(children[i], user_data);
         }
         return;
     }
 
+    // A leading keyword node can only be the 'token' marker.
+    bool is_token = false;
+    gdl_ast_node_t * first_child = (gdl_ast_node_t *)children[0];
+    if (first_child->type == GDL_AST_NODE_TYPE_KEYWORD)
+    {
+        is_token = true;
+        gdl_ast_node_free(first_child, user_data);
+        children++;
+        count--;
+        if (count < 2)
+        {
+            epc_ast_builder_set_error(ctx, "Token rule definition is missing its name or definition.");
+            for (int i = 0; i < count; ++i) {
+                gdl_ast_node_free(children[i], user_data);
+            }
+            return;
+        }
+    }
+
     gdl_ast_node_t * identifier_ref_node = (gdl_ast_node_t *)children[0];
     gdl_ast_node_t * definition_node = (gdl_ast_node_t *)children[1];
     gdl_ast_node_t * semantic_action_node = NULL;
@@ -778,6 +832,7 @@ handle_create_rule_definition(
         identifier_ref_node->data.identifier_ref.name = NULL; // Prevent double free
         rule_def_node->data.rule_def.definition = definition_node;
         rule_def_node->data.rule_def.semantic_action = semantic_action_node;
+        rule_def_node->data.rule_def.is_token = is_token;
     }
     gdl_ast_node_free(identifier_ref_node, user_data); // Free wrapper node (IdentifierRef node)
     epc_ast_push(ctx, rule_def_node);
@@ -972,6 +1027,13 @@ handle_create_count_call(
         gdl_ast_node_free(expr_node, user_data);
         return;
     }
+    if (count_val_node->data.number_literal.value > INT_MAX)
+    {
+        epc_ast_builder_set_error(ctx, "Count call's count is larger than %d.", INT_MAX);
+        gdl_ast_node_free(count_val_node, user_data);
+        gdl_ast_node_free(expr_node, user_data);
+        return;
+    }
 
     gdl_ast_node_t * result_node = gdl_ast_node_alloc(ctx, GDL_AST_NODE_TYPE_COMBINATOR_COUNT);
     if (result_node)
@@ -0,0 +1,2553 @@
+#include "gdl_code_generator.h"
+#include "gdl_code_generator_common.h"
+#include "gdl_grammar_analysis.h"
+#include "gdl_token_dfa.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The direct backend emits a static C function for each rule, and for each
+ * expression within a rule, that matches the input itself and builds the
+ * same CPT nodes (tags, names, children and semantic actions) as the
+ * equivalent easy_pc combinators would. Where the FIRST set of an
+ * alternative, repetition or optional expression is known, the byte at the
+ * current position is checked before trying it.
+ * int, double, between(), delimited(), chainl1() and chainr1() are less
+ * common and have more involved semantics, so they are left to the library:
+ * the generated code runs them as ordinary parsers, with their operands
+ * wrapped in epc_direct() parsers that call back into the generated code.
+ */
+
+// The most single bytes or ranges tested inline before a lookup table is used instead.
+#define MAX_INLINE_RANGES 4
+// The most case labels emitted for a switch on the next byte.
+#define MAX_SWITCH_LABELS 64
+
+typedef struct direct_entry_t
+{
+    char * function_name;
+    struct direct_entry_t * next;
+} direct_entry_t;
+
+typedef struct
+{
+    FILE * source;
+    char const * base_name;
+    gdl_grammar_analysis_t analysis;
+    bool * rule_reachable;          // Indexed like analysis.rules.
+    char const * * rule_actions;    // Indexed like analysis.rules.
+    char * rule_name;               // PascalCase name of the rule being generated.
+    char const * rule_function;     // The name of the function that parses that rule.
+    int function_count;             // For naming the functions of the rule being generated.
+    int table_count;
+    int fallback_count;
+    FILE * fallbacks;               // Statements creating the fallback parsers.
+    char * fallbacks_text;
+    size_t fallbacks_size;
+    direct_entry_t * entries;       // Functions that have an epc_direct() entry point.
+    gdl_token_dfa_t token_dfa;
+    bool has_error;
+} direct_generator_t;
+
+static char *
+direct_emit_expression(
+    direct_generator_t * gen,
+    gdl_ast_node_t * node,
+    char const * name,
+    char const * action,
+    char const * function_name);
+
+// --- Names and expected strings ---
+
+// The name the equivalent combinator would be given if created with a NULL name.
+static char const *
+default_parser_name(gdl_ast_node_t * node)
+{
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+        return "string_parser";
+    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
+        return "char_parser";
+    case GDL_AST_NODE_TYPE_CHAR_RANGE:
+        return "char_range";
+    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
+        return "one_of_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
+        return "none_of";
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        return "and_parser";
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+        return alternative_is_keyword_set(node) ? "keywords_parser" : "or_parser";
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+        switch (node->data.repetition_expr.repetition->data.repetition_op.operator_char)
+        {
+        case '*':
+            return "many_parser";
+        case '+':
+            return "plus_parser";
+        default:
+            return "optional_parser";
+        }
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        return "optional_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+        return "lookahead_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+        return "not_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+        return "skip_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        return "passthru_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+        return "lexeme_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+        return "count_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+        return "between_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        return "delimited_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+        return "chainl1_parser";
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        return "chainr1_parser";
+    case GDL_AST_NODE_TYPE_TOKEN_DFA:
+        return "dfa_parser";
+    default:
+        return "direct_parser";
+    }
+}
+
+/*
+ * Returns a C string literal describing what the expression expects, as the
+ * equivalent combinator would report it when an 'or' it is in fails.
+ */
+static char *
+direct_expected_literal(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, int depth)
+{
+    node = unwrap_expression(node);
+    if (node == NULL)
+    {
+        return strdup("\"\"");
+    }
+
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
+        return c_string_literal_of_char((unsigned char)node->data.char_literal.value);
+
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+        return str_printf("\"%s\"", node->data.string_literal.value);
+
+    case GDL_AST_NODE_TYPE_KEYWORD:
+    {
+        char const * keyword_name = node->data.keyword.name;
+        if (strcmp(keyword_name, "space") == 0)
+        {
+            return strdup("\"whitespace\"");
+        }
+        if (strcmp(keyword_name, "~") == 0)
+        {
+            return strdup("\"cut\"");
+        }
+        return str_printf("\"%s\"", keyword_name);
+    }
+
+    case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
+    {
+        gdl_rule_analysis_t * rule = gdl_grammar_analysis_find_rule(&gen->analysis, node->data.identifier_ref.name);
+        char * pascal_name = to_pascal_case(node->data.identifier_ref.name);
+        char * expected;
+        if (rule == NULL || depth > 16)
+        {
+            expected = str_printf("\"%s\"", pascal_name);
+        }
+        else
+        {
+            expected = direct_expected_literal(gen, rule->rule_def->data.rule_def.definition, pascal_name, depth + 1);
+        }
+        free(pascal_name);
+        return expected;
+    }
+
+    case GDL_AST_NODE_TYPE_FAIL_CALL:
+        return str_printf("\"%s\"", name != NULL ? name : "NULL");
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        if (node->data.sequence.elements.count == 0)
+        {
+            return strdup("\"empty_seq\"");
+        }
+        return str_printf("\"%s\"", name != NULL ? name : default_parser_name(node));
+
+    default:
+        return str_printf("\"%s\"", name != NULL ? name : default_parser_name(node));
+    }
+}
+
+static char *
+direct_name_literal(gdl_ast_node_t * node, char const * name)
+{
+    return str_printf("\"%s\"", name != NULL ? name : default_parser_name(node));
+}
+
+// --- Byte tests ---
+
+/*
+ * Returns a condition testing whether the unsigned char variable var is in the
+ * set. Sets with many ranges are tested with a lookup table, which is written
+ * to the source straight away, so this must be called before the function
+ * that uses the condition is started.
+ */
+static char *
+direct_char_set_condition(direct_generator_t * gen, gdl_char_set_t const * set, char const * var)
+{
+    int range_starts[MAX_INLINE_RANGES];
+    int range_ends[MAX_INLINE_RANGES];
+    int range_count = 0;
+    bool too_many_ranges = false;
+
+    for (int c = 0; c < 256 && !too_many_ranges; c++)
+    {
+        if (!gdl_char_set_contains(set, (unsigned char)c))
+        {
+            continue;
+        }
+        int end = c;
+        while (end + 1 < 256 && gdl_char_set_contains(set, (unsigned char)(end + 1)))
+        {
+            end++;
+        }
+        if (range_count == MAX_INLINE_RANGES)
+        {
+            too_many_ranges = true;
+            break;
+        }
+        range_starts[range_count] = c;
+        range_ends[range_count] = end;
+        range_count++;
+        c = end;
+    }
+
+    if (range_count == 0)
+    {
+        return strdup("false");
+    }
+
+    if (too_many_ranges)
+    {
+        int table = ++gen->table_count;
+        fprintf(gen->source, "static unsigned char const direct_char_set_%d[32] = {", table);
+        for (int i = 0; i < 32; i++)
+        {
+            fprintf(gen->source, "%s0x%02x", i == 0 ? "" : ", ", set->bits[i]);
+        }
+        fprintf(gen->source, "};\n\n");
+        return str_printf("(direct_char_set_%d[%s >> 3] & (1u << (%s & 7))) != 0", table, var, var);
+    }
+
+    size_t size = 1;
+    char * condition = calloc(1, size);
+    for (int i = 0; i < range_count && condition != NULL; i++)
+    {
+        char * term;
+        if (range_starts[i] == range_ends[i])
+        {
+            term = str_printf("%s%s == 0x%02x", i == 0 ? "" : " || ", var, range_starts[i]);
+        }
+        else if (range_ends[i] == 0xff)
+        {
+            term = str_printf("%s%s >= 0x%02x", i == 0 ? "" : " || ", var, range_starts[i]);
+        }
+        else if (range_starts[i] == 0)
+        {
+            term = str_printf("%s%s <= 0x%02x", i == 0 ? "" : " || ", var, range_ends[i]);
+        }
+        else
+        {
+            term = str_printf("%s(%s >= 0x%02x && %s <= 0x%02x)",
+                              i == 0 ? "" : " || ", var, range_starts[i], var, range_ends[i]);
+        }
+        if (term == NULL)
+        {
+            free(condition);
+            return NULL;
+        }
+        size += strlen(term);
+        char * grown = realloc(condition, size);
+        if (grown != NULL)
+        {
+            strcat(grown, term);
+        }
+        else
+        {
+            free(condition);
+        }
+        condition = grown;
+        free(term);
+    }
+    return condition;
+}
+
+/*
+ * Returns the condition under which the expression might match, or NULL if it
+ * must always be tried.
+ */
+static char *
+direct_guard_condition(direct_generator_t * gen, gdl_ast_node_t * node, char const * var)
+{
+    gdl_char_set_t first;
+    gdl_char_set_clear(&first);
+
+    if (gdl_expression_first(&gen->analysis, node, &first) || gdl_char_set_is_full(&first))
+    {
+        return NULL;
+    }
+    return direct_char_set_condition(gen, &first, var);
+}
+
+// Returns a condition comparing the input with the bytes of a literal that contains no escape sequences.
+static char *
+direct_bytes_condition(char const * bytes, size_t len)
+{
+    size_t size = 1;
+    char * condition = calloc(1, size);
+
+    for (size_t i = 0; i < len && condition != NULL; i++)
+    {
+        char * constant = c_char_constant((unsigned char)bytes[i]);
+        char * term = str_printf("%sinput[%zu] == %s", i == 0 ? "" : " && ", i, constant);
+        free(constant);
+        if (term == NULL)
+        {
+            free(condition);
+            return NULL;
+        }
+        size += strlen(term);
+        char * grown = realloc(condition, size);
+        if (grown != NULL)
+        {
+            strcat(grown, term);
+        }
+        else
+        {
+            free(condition);
+        }
+        condition = grown;
+        free(term);
+    }
+    return condition;
+}
+
+// --- Function helpers ---
+
+static char *
+direct_new_function_name(direct_generator_t * gen, char const * function_name)
+{
+    if (function_name != NULL)
+    {
+        return strdup(function_name);
+    }
+    return str_printf("parse_%s_%d", gen->rule_name, ++gen->function_count);
+}
+
+static void
+direct_function_begin(direct_generator_t * gen, char const * function_name, bool uses_state, bool uses_cut)
+{
+    fprintf(gen->source, "static epc_parse_result_t\n");
+    fprintf(gen->source, "%s(direct_state_t * state, epc_parser_ctx_t * ctx, const char * input, direct_cut_t * cut)\n", function_name);
+    fprintf(gen->source, "{\n");
+    if (!uses_state)
+    {
+        fprintf(gen->source, "    (void)state;\n");
+    }
+    if (!uses_cut)
+    {
+        fprintf(gen->source, "    (void)cut;\n");
+    }
+    else if (gen->rule_function != NULL && strcmp(function_name, gen->rule_function) == 0)
+    {
+        // A cut commits alternatives within the rule, never those of the rule's callers.
+        fprintf(gen->source, "    cut = NULL;\n");
+    }
+}
+
+static void
+direct_function_end(direct_generator_t * gen)
+{
+    fprintf(gen->source, "}\n\n");
+}
+
+/*
+ * Returns the name of a function that calls target_function, applying a
+ * semantic action to the node it returns. Rules defined as just a reference
+ * to another rule, or a passthru(), need this so that they still get a
+ * function of their own.
+ */
+static char *
+direct_forward(direct_generator_t * gen, char const * target_function, char const * action, char const * function_name)
+{
+    if (function_name == NULL || (strcmp(target_function, function_name) == 0 && action == NULL))
+    {
+        return strdup(target_function);
+    }
+
+    direct_function_begin(gen, function_name, true, true);
+    fprintf(gen->source, "    epc_parse_result_t result = %s(state, ctx, input, cut);\n", target_function);
+    if (action != NULL)
+    {
+        fprintf(gen->source, "    if (!result.is_error)\n");
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        direct_set_action(result.data.success, %s);\n", action);
+        fprintf(gen->source, "    }\n");
+    }
+    fprintf(gen->source, "    return result;\n");
+    direct_function_end(gen);
+
+    return strdup(function_name);
+}
+
+// Emits the entry point used to run a generated function as an epc_direct() parser, if not done already.
+static char *
+direct_entry_name(direct_generator_t * gen, char const * function_name)
+{
+    for (direct_entry_t * entry = gen->entries; entry != NULL; entry = entry->next)
+    {
+        if (strcmp(entry->function_name, function_name) == 0)
+        {
+            return str_printf("direct_entry_%s", function_name);
+        }
+    }
+
+    direct_entry_t * entry = calloc(1, sizeof(*entry));
+    if (entry == NULL)
+    {
+        perror("Failed to allocate direct_entry_t");
+        return NULL;
+    }
+    entry->function_name = strdup(function_name);
+    entry->next = gen->entries;
+    gen->entries = entry;
+
+    fprintf(gen->source, "static epc_parse_result_t\n");
+    fprintf(gen->source, "direct_entry_%s(epc_parser_ctx_t * ctx, const char * input, void * user_data)\n", function_name);
+    fprintf(gen->source, "{\n");
+    fprintf(gen->source, "    direct_state_t state = { .grammar = user_data };\n");
+    fprintf(gen->source, "    return direct_finish(&state, ctx, %s(&state, ctx, input, NULL));\n", function_name);
+    fprintf(gen->source, "}\n\n");
+
+    return str_printf("direct_entry_%s", function_name);
+}
+
+/*
+ * Returns a C expression creating an epc_direct() parser that runs the given
+ * operand of a fallback combinator.
+ */
+static char *
+direct_fallback_operand(direct_generator_t * gen, gdl_ast_node_t * operand)
+{
+    if (operand == NULL)
+    {
+        return strdup("NULL");
+    }
+
+    char * function = direct_emit_expression(gen, operand, NULL, NULL, NULL);
+    if (function == NULL)
+    {
+        return NULL;
+    }
+    char * entry = direct_entry_name(gen, function);
+    char * expected = direct_expected_literal(gen, operand, NULL, 0);
+    char * parser = NULL;
+    if (entry != NULL && expected != NULL)
+    {
+        parser = str_printf("epc_direct_l(list, %s, %s, g, NULL)", expected, entry);
+    }
+    free(function);
+    free(entry);
+    free(expected);
+
+    return parser;
+}
+
+/*
+ * Records a statement creating a fallback parser in create_<name>_parser()
+ * and emits the function that runs it.
+ */
+static char *
+direct_fallback(direct_generator_t * gen, char const * parser_expression, char const * action, char const * function_name)
+{
+    int index = gen->fallback_count++;
+
+    fprintf(gen->fallbacks, "    g->fallback[%d] = %s;\n", index, parser_expression);
+    if (action != NULL)
+    {
+        fprintf(gen->fallbacks, "    epc_parser_set_ast_action(g->fallback[%d], %s);\n", index, action);
+    }
+
+    char * name = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, name, true, false);
+    fprintf(gen->source, "    return epc_direct_parse(state->grammar->fallback[%d], ctx, input);\n", index);
+    direct_function_end(gen);
+
+    return name;
+}
+
+// --- Expressions ---
+
+static char *
+direct_emit_char_test(
+    direct_generator_t * gen,
+    char const * function_name,
+    char const * mismatch_condition,
+    char const * mismatch_message,
+    char const * expected,
+    char const * tag,
+    char const * name,
+    char const * action)
+{
+    char * fn = direct_new_function_name(gen, function_name);
+
+    direct_function_begin(gen, fn, true, false);
+    fprintf(gen->source, "    if (%s)\n", mismatch_condition);
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        return direct_mismatch(state, input, \"%s\", %s);\n", mismatch_message, expected);
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    return direct_leaf(ctx, \"%s\", %s, %s, input, 1);\n", tag, name, action);
+    direct_function_end(gen);
+
+    return fn;
+}
+
+static char *
+direct_emit_leaf(
+    direct_generator_t * gen,
+    char const * function_name,
+    char const * tag,
+    char const * name,
+    char const * action)
+{
+    char * fn = direct_new_function_name(gen, function_name);
+
+    direct_function_begin(gen, fn, false, false);
+    fprintf(gen->source, "    return direct_leaf(ctx, \"%s\", %s, %s, input, 0);\n", tag, name, action);
+    direct_function_end(gen);
+
+    return fn;
+}
+
+// Numbers are scanned as epc_int() and epc_double() do, and reported the same way when missing.
+static char *
+direct_emit_number(
+    direct_generator_t * gen,
+    char const * function_name,
+    char const * c_type,
+    char const * scanner,
+    char const * tag,
+    char const * description,
+    char const * value_kind,
+    char const * name,
+    char const * action)
+{
+    char * fn = direct_new_function_name(gen, function_name);
+
+    direct_function_begin(gen, fn, true, false);
+    fprintf(gen->source, "    %s value;\n", c_type);
+    fprintf(gen->source, "    size_t const len = epc_direct_scan_%s(input, &value);\n\n", scanner);
+    fprintf(gen->source, "    if (len == 0)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        bool const at_end = input[0] == '\\0';\n");
+    fprintf(gen->source, "        return direct_fail(state, input, \"Expected %s\", \"%s\", at_end ? \"EOF\" : input, at_end ? SIZE_MAX : 1);\n", description, tag);
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    epc_parse_result_t result = direct_leaf(ctx, \"%s\", %s, %s, input, len);\n", tag, name, action);
+    fprintf(gen->source, "    if (!result.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        result.data.success->value_type = EPC_CPT_VALUE_%s;\n", value_kind);
+    fprintf(gen->source, "        result.data.success->value.%s_value = value;\n", scanner);
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    return result;\n");
+    direct_function_end(gen);
+
+    return fn;
+}
+
+static char *
+direct_emit_keyword(direct_generator_t * gen, gdl_ast_node_t * node, char const * action, char const * function_name)
+{
+    char const * keyword_name = node->data.keyword.name;
+    char * name = str_printf("\"%s\"", strcmp(keyword_name, "~") == 0 ? "cut" : keyword_name);
+    char const * action_value = action != NULL ? action : "-1";
+    char * fn = NULL;
+
+    static struct
+    {
+        char const * keyword;
+        char const * test;
+        char const * expected;
+    } const char_classes[] = {
+        { "digit", "isdigit", "digit" },
+        { "alpha", "isalpha", "alpha" },
+        { "alphanum", "isalnum", "alphanum" },
+        { "space", "isspace", "whitespace" },
+        { "hex_digit", "isxdigit", "hex_digit" },
+    };
+
+    for (size_t i = 0; i < sizeof(char_classes) / sizeof(char_classes[0]); i++)
+    {
+        if (strcmp(keyword_name, char_classes[i].keyword) == 0)
+        {
+            char * condition = str_printf("!%s((unsigned char)input[0])", char_classes[i].test);
+            char * expected = str_printf("\"%s\"", char_classes[i].expected);
+            fn = direct_emit_char_test(gen, function_name, condition, "Unexpected character", expected, keyword_name, name, action_value);
+            free(condition);
+            free(expected);
+            free(name);
+            return fn;
+        }
+    }
+
+    if (strcmp(keyword_name, "any_char") == 0)
+    {
+        fn = direct_emit_char_test(gen, function_name, "input[0] == '\\0'", "Unexpected character", "\"any character\"", "any_char", name, action_value);
+    }
+    else if (strcmp(keyword_name, "eoi") == 0)
+    {
+        fn = direct_new_function_name(gen, function_name);
+        direct_function_begin(gen, fn, true, false);
+        fprintf(gen->source, "    if (input[0] != '\\0')\n");
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        return direct_fail(state, input, \"End of input not found\", \"<end of input>\", input, DIRECT_FOUND_SIZE - 1);\n");
+        fprintf(gen->source, "    }\n");
+        fprintf(gen->source, "    return direct_leaf(ctx, \"eio\", %s, %s, input, 0);\n", name, action_value);
+        direct_function_end(gen);
+    }
+    else if (strcmp(keyword_name, "succeed") == 0)
+    {
+        fn = direct_emit_leaf(gen, function_name, "succeed", name, action_value);
+    }
+    else if (strcmp(keyword_name, "~") == 0)
+    {
+        fn = direct_new_function_name(gen, function_name);
+        direct_function_begin(gen, fn, true, true);
+        fprintf(gen->source, "    if (cut != NULL && !cut->committed)\n");
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        cut->committed = true;\n");
+        fprintf(gen->source, "        direct_restore(state, ctx, &cut->saved);\n");
+        fprintf(gen->source, "    }\n");
+        fprintf(gen->source, "    return direct_leaf(ctx, \"cut\", %s, %s, input, 0);\n", name, action_value);
+        direct_function_end(gen);
+    }
+    else if (strcmp(keyword_name, "int") == 0)
+    {
+        fn = direct_emit_number(gen, function_name, "long long", "int", "integer", "an integer", "INT", name, action_value);
+    }
+    else if (strcmp(keyword_name, "double") == 0)
+    {
+        fn = direct_emit_number(gen, function_name, "double", "double", "double", "a double", "DOUBLE", name, action_value);
+    }
+    else
+    {
+        fprintf(stderr, "Error: Unsupported GDL keyword '%s' for code generation.\n", keyword_name);
+    }
+
+    free(name);
+    return fn;
+}
+
+static char *
+direct_emit_string(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, char const * action, char const * function_name)
+{
+    char const * value = node->data.string_literal.value;
+    char * fn = direct_new_function_name(gen, function_name);
+
+    direct_function_begin(gen, fn, true, false);
+    fprintf(gen->source, "    static char const literal[] = \"%s\";\n\n", value);
+    if (strchr(value, '\\') == NULL && strlen(value) > 0 && strlen(value) <= 8)
+    {
+        // Compare the bytes inline. A mismatch on the terminating NUL stops the comparison early.
+        char * condition = direct_bytes_condition(value, strlen(value));
+        fprintf(gen->source, "    if (!(%s))\n", condition);
+        free(condition);
+    }
+    else
+    {
+        fprintf(gen->source, "    if (input[0] == '\\0' || strncmp(input, literal, sizeof(literal) - 1) != 0)\n");
+    }
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        return direct_string_mismatch(state, input, literal, sizeof(literal) - 1);\n");
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    return direct_leaf(ctx, \"string\", %s, %s, input, sizeof(literal) - 1);\n", name, action);
+    direct_function_end(gen);
+
+    return fn;
+}
+
+/*
+ * An alternation of string literals is matched like epc_keywords(): the
+ * longest literal matching the input wins. The candidates are picked by a
+ * switch on the first byte, longest first.
+ */
+static char *
+direct_emit_keyword_set(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, char const * action, char const * function_name)
+{
+    gdl_ast_list_t * alternatives = &node->data.alternative.alternatives;
+    bool has_escapes = false;
+    int empty_index = -1;
+    int index = 0;
+
+    for (gdl_ast_list_node_t * a = alternatives->head; a != NULL; a = a->next, index++)
+    {
+        char const * value = alternative_string_literal_value(a->item);
+        has_escapes |= strchr(value, '\\') != NULL;
+        if (value[0] == '\0')
+        {
+            empty_index = index;
+        }
+    }
+
+    char * fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, false);
+    if (has_escapes)
+    {
+        fprintf(gen->source, "    static char const * const keywords[] = {");
+        for (gdl_ast_list_node_t * a = alternatives->head; a != NULL; a = a->next)
+        {
+            fprintf(gen->source, "\"%s\"%s", alternative_string_literal_value(a->item), a->next != NULL ? ", " : "");
+        }
+        fprintf(gen->source, "};\n");
+    }
+    fprintf(gen->source, "    int matched_index = %d;\n", empty_index);
+    fprintf(gen->source, "    size_t matched_len = 0;\n\n");
+
+    if (has_escapes)
+    {
+        fprintf(gen->source, "    for (int i = 0; i < %d; i++)\n", alternatives->count);
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        size_t len = strlen(keywords[i]);\n");
+        fprintf(gen->source, "        if (len > matched_len && strncmp(input, keywords[i], len) == 0)\n");
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            matched_index = i;\n");
+        fprintf(gen->source, "            matched_len = len;\n");
+        fprintf(gen->source, "        }\n");
+        fprintf(gen->source, "    }\n");
+    }
+    else
+    {
+        fprintf(gen->source, "    switch ((unsigned char)input[0])\n");
+        fprintf(gen->source, "    {\n");
+        bool done[256] = { false };
+        for (gdl_ast_list_node_t * a = alternatives->head; a != NULL; a = a->next)
+        {
+            unsigned char first_byte = (unsigned char)alternative_string_literal_value(a->item)[0];
+            if (first_byte == '\0' || done[first_byte])
+            {
+                continue;
+            }
+            done[first_byte] = true;
+            fprintf(gen->source, "    case 0x%02x:\n", first_byte);
+
+            // Longest first, so the first match is the longest one.
+            size_t max_len = 0;
+            for (gdl_ast_list_node_t * b = alternatives->head; b != NULL; b = b->next)
+            {
+                size_t len = strlen(alternative_string_literal_value(b->item));
+                max_len = len > max_len ? len : max_len;
+            }
+            for (size_t len = max_len; len > 0; len--)
+            {
+                int candidate_index = 0;
+                for (gdl_ast_list_node_t * b = alternatives->head; b != NULL; b = b->next, candidate_index++)
+                {
+                    char const * value = alternative_string_literal_value(b->item);
+                    if ((unsigned char)value[0] != first_byte || strlen(value) != len)
+                    {
+                        continue;
+                    }
+                    char * condition = direct_bytes_condition(value, len);
+                    fprintf(gen->source, "        if (%s)\n", condition);
+                    fprintf(gen->source, "        {\n");
+                    fprintf(gen->source, "            matched_index = %d;\n", candidate_index);
+                    fprintf(gen->source, "            matched_len = %zu;\n", len);
+                    fprintf(gen->source, "            break;\n");
+                    fprintf(gen->source, "        }\n");
+                    free(condition);
+                }
+            }
+            fprintf(gen->source, "        break;\n");
+        }
+        fprintf(gen->source, "    default:\n");
+        fprintf(gen->source, "        break;\n");
+        fprintf(gen->source, "    }\n");
+    }
+
+    // Same as epc_keywords()'s expected string.
+    fprintf(gen->source, "\n    if (matched_index < 0)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        static char const expected[] = \"");
+    for (gdl_ast_list_node_t * a = alternatives->head; a != NULL; a = a->next)
+    {
+        fprintf(gen->source, "%s%s", alternative_string_literal_value(a->item), a->next != NULL ? " or " : "");
+    }
+    fprintf(gen->source, "\";\n\n");
+    fprintf(gen->source, "        if (input[0] == '\\0')\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            return direct_fail(state, input, \"Unexpected end of input\", expected, \"EOF\", SIZE_MAX);\n");
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        return direct_fail(state, input, \"No keyword matched\", expected, input, DIRECT_FOUND_SIZE - 1);\n");
+    fprintf(gen->source, "    }\n\n");
+    fprintf(gen->source, "    epc_parse_result_t result = direct_leaf(ctx, \"keywords\", %s, %s, input, matched_len);\n", name, action);
+    fprintf(gen->source, "    if (!result.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        result.data.success->alternative_index = matched_index;\n");
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    return result;\n");
+    direct_function_end(gen);
+
+    return fn;
+}
+
+static char *
+direct_emit_sequence(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, char const * action, char const * function_name)
+{
+    int count = node->data.sequence.elements.count;
+    char * * children = calloc(count, sizeof(*children));
+    char * fn = NULL;
+
+    if (children == NULL)
+    {
+        return NULL;
+    }
+
+    int i = 0;
+    for (gdl_ast_list_node_t * e = node->data.sequence.elements.head; e != NULL; e = e->next, i++)
+    {
+        children[i] = direct_emit_expression(gen, e->item, NULL, NULL, NULL);
+        if (children[i] == NULL)
+        {
+            goto done;
+        }
+    }
+
+    fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, true);
+    fprintf(gen->source, "    epc_cpt_node_t * node = direct_node(\"and\", %s, %s, input);\n", name, action);
+    fprintf(gen->source, "    if (node == NULL || (node->children = calloc(%d, sizeof(*node->children))) == NULL)\n", count);
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        epc_direct_node_free(node);\n");
+    fprintf(gen->source, "        return direct_out_of_memory(ctx, input, %s);\n", name);
+    fprintf(gen->source, "    }\n\n");
+    fprintf(gen->source, "    const char * current = input;\n");
+    fprintf(gen->source, "    epc_parse_result_t result;\n");
+    for (i = 0; i < count; i++)
+    {
+        fprintf(gen->source, "\n    result = %s(state, ctx, current, cut);\n", children[i]);
+        fprintf(gen->source, "    if (result.is_error)\n");
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        epc_direct_node_free(node);\n");
+        fprintf(gen->source, "        return result;\n");
+        fprintf(gen->source, "    }\n");
+        fprintf(gen->source, "    node->children[node->children_count++] = result.data.success;\n");
+        fprintf(gen->source, "    current += result.data.success->len;\n");
+    }
+    fprintf(gen->source, "\n    node->len = (size_t)(current - input);\n");
+    fprintf(gen->source, "    return direct_success(node);\n");
+    direct_function_end(gen);
+
+done:
+    for (i = 0; i < count; i++)
+    {
+        free(children[i]);
+    }
+    free(children);
+    return fn;
+}
+
+static void
+direct_emit_alternative_attempt(direct_generator_t * gen, char const * indent, char const * child, int index, char const * name, char const * action)
+{
+    fprintf(gen->source, "%sresult = %s(state, ctx, input, &scope);\n", indent, child);
+    fprintf(gen->source, "%sif (!result.is_error)\n", indent);
+    fprintf(gen->source, "%s{\n", indent);
+    fprintf(gen->source, "%s    return direct_alternative_success(state, ctx, %s, %s, input, &scope, &result, %d);\n", indent, name, action, index);
+    fprintf(gen->source, "%s}\n", indent);
+    fprintf(gen->source, "%sif (scope.committed)\n", indent);
+    fprintf(gen->source, "%s{\n", indent);
+    fprintf(gen->source, "%s    return result;\n", indent);
+    fprintf(gen->source, "%s}\n", indent);
+    fprintf(gen->source, "%sepc_direct_result_cleanup(&result);\n", indent);
+}
+
+/*
+ * An alternative whose FIRST set doesn't include the next byte would only fail
+ * at the current position, which the 'or' error replaces anyway, so it is
+ * skipped. When every alternative has a FIRST set and they don't overlap, a
+ * switch on the next byte picks the only alternative that can match.
+ */
+static char *
+direct_emit_alternative(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, char const * action, char const * function_name)
+{
+    int count = node->data.alternative.alternatives.count;
+    char * * children = calloc(count, sizeof(*children));
+    char * * guards = calloc(count, sizeof(*guards));
+    gdl_char_set_t * firsts = calloc(count, sizeof(*firsts));
+    char * expected = NULL;
+    char * fn = NULL;
+
+    if (children == NULL || guards == NULL || firsts == NULL)
+    {
+        goto done;
+    }
+
+    bool use_switch = true;
+    int label_count = 0;
+    int i = 0;
+    for (gdl_ast_list_node_t * a = node->data.alternative.alternatives.head; a != NULL; a = a->next, i++)
+    {
+        children[i] = direct_emit_expression(gen, a->item, NULL, NULL, NULL);
+        if (children[i] == NULL)
+        {
+            goto done;
+        }
+
+        gdl_char_set_clear(&firsts[i]);
+        if (gdl_expression_first(&gen->analysis, a->item, &firsts[i]) || gdl_char_set_is_full(&firsts[i]))
+        {
+            use_switch = false;
+            continue;
+        }
+        for (int j = 0; j < i && use_switch; j++)
+        {
+            use_switch = !gdl_char_set_intersects(&firsts[i], &firsts[j]);
+        }
+        label_count += gdl_char_set_count(&firsts[i]);
+    }
+    use_switch = use_switch && label_count <= MAX_SWITCH_LABELS;
+
+    // The 'or' parser's expected string names each of its alternatives.
+    size_t expected_size = 1;
+    expected = calloc(1, expected_size);
+    i = 0;
+    for (gdl_ast_list_node_t * a = node->data.alternative.alternatives.head; a != NULL && expected != NULL; a = a->next, i++)
+    {
+        char * alternative_expected = direct_expected_literal(gen, a->item, NULL, 0);
+        char * term = str_printf("%s%s", i == 0 ? "" : " \" or \" ", alternative_expected);
+        free(alternative_expected);
+        if (term == NULL)
+        {
+            free(expected);
+            expected = NULL;
+            goto done;
+        }
+        expected_size += strlen(term);
+        char * grown = realloc(expected, expected_size);
+        if (grown != NULL)
+        {
+            strcat(grown, term);
+        }
+        else
+        {
+            free(expected);
+        }
+        expected = grown;
+        free(term);
+    }
+    if (expected == NULL)
+    {
+        goto done;
+    }
+
+    if (!use_switch)
+    {
+        i = 0;
+        for (gdl_ast_list_node_t * a = node->data.alternative.alternatives.head; a != NULL; a = a->next, i++)
+        {
+            guards[i] = direct_guard_condition(gen, a->item, "c");
+        }
+    }
+
+    fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, false);
+    fprintf(gen->source, "    direct_cut_t scope = { .committed = false, .saved = direct_save(state, ctx) };\n");
+    fprintf(gen->source, "    unsigned char const c = (unsigned char)input[0];\n");
+    fprintf(gen->source, "    epc_parse_result_t result;\n\n");
+
+    if (use_switch)
+    {
+        fprintf(gen->source, "    switch (c)\n");
+        fprintf(gen->source, "    {\n");
+        for (i = 0; i < count; i++)
+        {
+            for (int byte = 0; byte < 256; byte++)
+            {
+                if (gdl_char_set_contains(&firsts[i], (unsigned char)byte))
+                {
+                    fprintf(gen->source, "    case 0x%02x:\n", byte);
+                }
+            }
+            direct_emit_alternative_attempt(gen, "        ", children[i], i, name, action);
+            fprintf(gen->source, "        break;\n");
+        }
+        fprintf(gen->source, "    default:\n");
+        fprintf(gen->source, "        break;\n");
+        fprintf(gen->source, "    }\n");
+    }
+    else
+    {
+        for (i = 0; i < count; i++)
+        {
+            if (guards[i] != NULL)
+            {
+                fprintf(gen->source, "    if (%s)\n", guards[i]);
+                fprintf(gen->source, "    {\n");
+                direct_emit_alternative_attempt(gen, "        ", children[i], i, name, action);
+                fprintf(gen->source, "    }\n");
+            }
+            else
+            {
+                fprintf(gen->source, "    {\n");
+                direct_emit_alternative_attempt(gen, "        ", children[i], i, name, action);
+                fprintf(gen->source, "    }\n");
+            }
+        }
+    }
+
+    fprintf(gen->source, "\n    direct_discard(&scope.saved);\n");
+    fprintf(gen->source, "    return direct_fail(state, input, \"No alternative matched\", %s, c != 0 ? input : \"EOF\", DIRECT_FOUND_SIZE - 1);\n", expected);
+    direct_function_end(gen);
+
+done:
+    for (i = 0; i < count && children != NULL; i++)
+    {
+        free(children[i]);
+        free(guards != NULL ? guards[i] : NULL);
+    }
+    free(children);
+    free(guards);
+    free(firsts);
+    free(expected);
+    return fn;
+}
+
+static char *
+direct_emit_repetition(
+    direct_generator_t * gen,
+    gdl_ast_node_t * node,
+    gdl_ast_node_t * child_node,
+    bool at_least_one,
+    char const * tag,
+    char const * name,
+    char const * action,
+    char const * function_name)
+{
+    char * child = direct_emit_expression(gen, child_node, NULL, NULL, NULL);
+    if (child == NULL)
+    {
+        return NULL;
+    }
+    char * guard = direct_guard_condition(gen, child_node, "(unsigned char)current[0]");
+
+    (void)node;
+    char * fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, at_least_one);
+    fprintf(gen->source, "    epc_cpt_node_t * node = direct_node(\"%s\", %s, %s, input);\n", tag, name, action);
+    fprintf(gen->source, "    if (node == NULL)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        return direct_out_of_memory(ctx, input, %s);\n", name);
+    fprintf(gen->source, "    }\n\n");
+    fprintf(gen->source, "    const char * current = input;\n");
+    fprintf(gen->source, "    for (;;)\n");
+    fprintf(gen->source, "    {\n");
+    if (guard != NULL)
+    {
+        if (at_least_one)
+        {
+            // The first repetition's error is needed if there isn't a match.
+            fprintf(gen->source, "        if (node->children_count > 0 && !(%s))\n", guard);
+        }
+        else
+        {
+            fprintf(gen->source, "        if (!(%s))\n", guard);
+        }
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            break;\n");
+        fprintf(gen->source, "        }\n");
+    }
+    // Failed repetitions are backtracked over, so only the first of a plus can commit an alternative.
+    fprintf(gen->source, "        epc_parse_result_t result = %s(state, ctx, current, %s);\n", child, at_least_one ? "node->children_count == 0 ? cut : NULL" : "NULL");
+    fprintf(gen->source, "        if (result.is_error)\n");
+    fprintf(gen->source, "        {\n");
+    if (at_least_one)
+    {
+        fprintf(gen->source, "            if (node->children_count == 0)\n");
+        fprintf(gen->source, "            {\n");
+        fprintf(gen->source, "                epc_direct_node_free(node);\n");
+        fprintf(gen->source, "                return result;\n");
+        fprintf(gen->source, "            }\n");
+    }
+    fprintf(gen->source, "            epc_direct_result_cleanup(&result);\n");
+    fprintf(gen->source, "            break;\n");
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        if (!epc_direct_node_add_child(node, result.data.success))\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            epc_direct_result_cleanup(&result);\n");
+    fprintf(gen->source, "            epc_direct_node_free(node);\n");
+    fprintf(gen->source, "            return direct_out_of_memory(ctx, current, %s);\n", name);
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        if (result.data.success->len == 0)\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            epc_direct_node_free(node);\n");
+    fprintf(gen->source, "            return direct_fail(state, current, \"Infinite recursion detected\", \"Progress\", \"No progress\", SIZE_MAX);\n");
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        current += result.data.success->len;\n");
+    fprintf(gen->source, "    }\n\n");
+    fprintf(gen->source, "    node->len = (size_t)(current - input);\n");
+    fprintf(gen->source, "    return direct_success(node);\n");
+    direct_function_end(gen);
+
+    free(child);
+    free(guard);
+    return fn;
+}
+
+/*
+ * As with epc_between(), only the content is kept, and the errors of a
+ * between that matches aren't reported.
+ */
+static char *
+direct_emit_between(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, char const * action, char const * function_name)
+{
+    char * open = direct_emit_expression(gen, node->data.between_call.open_expr, NULL, NULL, NULL);
+    char * content = open != NULL ? direct_emit_expression(gen, node->data.between_call.content_expr, NULL, NULL, NULL) : NULL;
+    char * close = content != NULL ? direct_emit_expression(gen, node->data.between_call.close_expr, NULL, NULL, NULL) : NULL;
+    char * fn = NULL;
+
+    if (close == NULL)
+    {
+        goto done;
+    }
+
+    fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, true);
+    fprintf(gen->source, "    direct_saved_t saved = direct_save(state, ctx);\n");
+    fprintf(gen->source, "    epc_parse_result_t result = %s(state, ctx, input, cut);\n", open);
+    fprintf(gen->source, "    if (result.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        direct_discard(&saved);\n");
+    fprintf(gen->source, "        return result;\n");
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    const char * current = input + result.data.success->len;\n");
+    fprintf(gen->source, "    epc_direct_result_cleanup(&result);\n\n");
+    fprintf(gen->source, "    epc_parse_result_t content = %s(state, ctx, current, cut);\n", content);
+    fprintf(gen->source, "    if (content.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        direct_discard(&saved);\n");
+    fprintf(gen->source, "        return content;\n");
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    current += content.data.success->len;\n\n");
+    fprintf(gen->source, "    result = %s(state, ctx, current, cut);\n", close);
+    fprintf(gen->source, "    if (result.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        epc_direct_result_cleanup(&content);\n");
+    fprintf(gen->source, "        direct_discard(&saved);\n");
+    fprintf(gen->source, "        return result;\n");
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    current += result.data.success->len;\n");
+    fprintf(gen->source, "    epc_direct_result_cleanup(&result);\n\n");
+    fprintf(gen->source, "    epc_cpt_node_t * node = direct_node(\"between\", %s, %s, input);\n", name, action);
+    fprintf(gen->source, "    if (node == NULL || !epc_direct_node_add_child(node, content.data.success))\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        epc_direct_node_free(node);\n");
+    fprintf(gen->source, "        epc_direct_result_cleanup(&content);\n");
+    fprintf(gen->source, "        direct_discard(&saved);\n");
+    fprintf(gen->source, "        return direct_out_of_memory(ctx, input, %s);\n", name);
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    direct_restore(state, ctx, &saved);\n");
+    fprintf(gen->source, "    node->len = (size_t)(current - input);\n");
+    fprintf(gen->source, "    return direct_success(node);\n");
+    direct_function_end(gen);
+
+done:
+    free(open);
+    free(content);
+    free(close);
+    return fn;
+}
+
+/*
+ * As with epc_delimited(), only the first item is parsed within the enclosing
+ * alternative; a cut in a delimiter, or in a later item, commits nothing.
+ */
+static char *
+direct_emit_delimited(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, char const * action, char const * function_name)
+{
+    gdl_ast_node_t * item_node = node->data.delimited_call.item_expr;
+    gdl_ast_node_t * delimiter_node = node->data.delimited_call.delimiter_expr;
+    char * item = direct_emit_expression(gen, item_node, NULL, NULL, NULL);
+    char * delimiter = delimiter_node != NULL ? direct_emit_expression(gen, delimiter_node, NULL, NULL, NULL) : NULL;
+    char * guard = delimiter != NULL ? direct_guard_condition(gen, delimiter_node, "(unsigned char)current[0]") : NULL;
+    char * expected = direct_expected_literal(gen, item_node, NULL, 0);
+    char * fn = NULL;
+
+    if (item == NULL || (delimiter_node != NULL && delimiter == NULL) || expected == NULL)
+    {
+        goto done;
+    }
+
+    fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, true);
+    fprintf(gen->source, "    epc_parse_result_t result = %s(state, ctx, input, cut);\n", item);
+    fprintf(gen->source, "    if (result.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        return result;\n");
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    epc_cpt_node_t * node = direct_node(\"delimited\", %s, %s, input);\n", name, action);
+    fprintf(gen->source, "    if (node == NULL || !epc_direct_node_add_child(node, result.data.success))\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        epc_direct_node_free(node);\n");
+    fprintf(gen->source, "        epc_direct_result_cleanup(&result);\n");
+    fprintf(gen->source, "        return direct_out_of_memory(ctx, input, %s);\n", name);
+    fprintf(gen->source, "    }\n\n");
+    fprintf(gen->source, "    const char * current = input + result.data.success->len;\n");
+    fprintf(gen->source, "    for (;;)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        const char * loop_start = current;\n");
+    if (delimiter != NULL)
+    {
+        if (guard != NULL)
+        {
+            fprintf(gen->source, "        if (!(%s))\n", guard);
+            fprintf(gen->source, "        {\n");
+            fprintf(gen->source, "            break;\n");
+            fprintf(gen->source, "        }\n");
+        }
+        fprintf(gen->source, "        direct_saved_t delimiter_saved = direct_save(state, ctx);\n");
+        fprintf(gen->source, "        result = %s(state, ctx, current, NULL);\n", delimiter);
+        fprintf(gen->source, "        if (result.is_error)\n");
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            direct_restore(state, ctx, &delimiter_saved);\n");
+        fprintf(gen->source, "            epc_direct_result_cleanup(&result);\n");
+        fprintf(gen->source, "            break;\n");
+        fprintf(gen->source, "        }\n");
+        fprintf(gen->source, "        direct_discard(&delimiter_saved);\n");
+        fprintf(gen->source, "        current += result.data.success->len;\n");
+        fprintf(gen->source, "        epc_direct_result_cleanup(&result);\n\n");
+    }
+    fprintf(gen->source, "        direct_saved_t item_saved = direct_save(state, ctx);\n");
+    fprintf(gen->source, "        result = %s(state, ctx, current, NULL);\n", item);
+    fprintf(gen->source, "        direct_restore(state, ctx, &item_saved);\n");
+    fprintf(gen->source, "        if (result.is_error)\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            epc_direct_result_cleanup(&result);\n");
+    if (delimiter != NULL)
+    {
+        fprintf(gen->source, "            epc_direct_node_free(node);\n");
+        fprintf(gen->source, "            return direct_fail(state, current, \"Unexpected trailing delimiter\", %s, current, DIRECT_FOUND_SIZE - 1);\n", expected);
+    }
+    else
+    {
+        fprintf(gen->source, "            break;\n");
+    }
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        if (!epc_direct_node_add_child(node, result.data.success))\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            epc_direct_result_cleanup(&result);\n");
+    fprintf(gen->source, "            epc_direct_node_free(node);\n");
+    fprintf(gen->source, "            return direct_out_of_memory(ctx, current, %s);\n", name);
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        current += result.data.success->len;\n");
+    fprintf(gen->source, "        if (current == loop_start)\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            epc_direct_node_free(node);\n");
+    fprintf(gen->source, "            return direct_fail(state, current, \"Infinite recursion detected\", \"Progress\", \"No progress\", SIZE_MAX);\n");
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "    }\n\n");
+    fprintf(gen->source, "    node->len = (size_t)(current - input);\n");
+    fprintf(gen->source, "    return direct_success(node);\n");
+    direct_function_end(gen);
+
+done:
+    free(item);
+    free(delimiter);
+    free(guard);
+    free(expected);
+    return fn;
+}
+
+/*
+ * As with epc_chainl1() and epc_chainr1(), a failing operator ends the chain,
+ * so operators are parsed outside of the enclosing alternative. The errors of
+ * a chain that matches aren't reported.
+ */
+static char *
+direct_emit_chain(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, char const * action, char const * function_name)
+{
+    bool const left_associative = node->type == GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1;
+    gdl_ast_node_t * op_node = node->data.chain_combinator_call.op_expr;
+    char * item = direct_emit_expression(gen, node->data.chain_combinator_call.item_expr, NULL, NULL, NULL);
+    char * op = direct_emit_expression(gen, op_node, NULL, NULL, NULL);
+    char * guard = op != NULL ? direct_guard_condition(gen, op_node, "(unsigned char)current[0]") : NULL;
+    char * fn = NULL;
+
+    if (item == NULL || op == NULL)
+    {
+        goto done;
+    }
+
+    fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, true);
+    fprintf(gen->source, "    direct_saved_t saved = direct_save(state, ctx);\n");
+    fprintf(gen->source, "    epc_parse_result_t result = %s(state, ctx, input, cut);\n", item);
+    fprintf(gen->source, "    if (result.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        direct_discard(&saved);\n");
+    fprintf(gen->source, "        return result;\n");
+    fprintf(gen->source, "    }\n");
+    if (!left_associative)
+    {
+        // The items and operators, in turn, until they are combined from the right.
+        fprintf(gen->source, "    epc_cpt_node_t * parts = direct_node(\"chainr1\", %s, %s, input);\n", name, action);
+        fprintf(gen->source, "    if (parts == NULL || !epc_direct_node_add_child(parts, result.data.success))\n");
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        epc_direct_node_free(parts);\n");
+        fprintf(gen->source, "        epc_direct_result_cleanup(&result);\n");
+        fprintf(gen->source, "        direct_discard(&saved);\n");
+        fprintf(gen->source, "        return direct_out_of_memory(ctx, input, %s);\n", name);
+        fprintf(gen->source, "    }\n");
+    }
+    fprintf(gen->source, "\n    const char * current = input + result.data.success->len;\n");
+    fprintf(gen->source, "    for (;;)\n");
+    fprintf(gen->source, "    {\n");
+    if (guard != NULL)
+    {
+        fprintf(gen->source, "        if (!(%s))\n", guard);
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            break;\n");
+        fprintf(gen->source, "        }\n");
+    }
+    fprintf(gen->source, "        direct_saved_t op_saved = direct_save(state, ctx);\n");
+    fprintf(gen->source, "        epc_parse_result_t op = %s(state, ctx, current, NULL);\n", op);
+    fprintf(gen->source, "        if (op.is_error)\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            direct_restore(state, ctx, &op_saved);\n");
+    fprintf(gen->source, "            epc_direct_result_cleanup(&op);\n");
+    fprintf(gen->source, "            break;\n");
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        direct_discard(&op_saved);\n");
+    fprintf(gen->source, "        current += op.data.success->len;\n\n");
+    fprintf(gen->source, "        epc_parse_result_t right = %s(state, ctx, current, cut);\n", item);
+    fprintf(gen->source, "        if (right.is_error)\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            epc_direct_result_cleanup(&op);\n");
+    fprintf(gen->source, "            %s\n", left_associative ? "epc_direct_result_cleanup(&result);" : "epc_direct_node_free(parts);");
+    fprintf(gen->source, "            direct_discard(&saved);\n");
+    fprintf(gen->source, "            return right;\n");
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        current += right.data.success->len;\n\n");
+    if (left_associative)
+    {
+        fprintf(gen->source, "        epc_cpt_node_t * node = direct_node(\"chainl1_combined\", %s, %s, result.data.success->content);\n", name, action);
+        fprintf(gen->source, "        if (node == NULL || (node->children = calloc(3, sizeof(*node->children))) == NULL)\n");
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            epc_direct_node_free(node);\n");
+        fprintf(gen->source, "            epc_direct_result_cleanup(&op);\n");
+        fprintf(gen->source, "            epc_direct_result_cleanup(&right);\n");
+        fprintf(gen->source, "            epc_direct_result_cleanup(&result);\n");
+        fprintf(gen->source, "            direct_discard(&saved);\n");
+        fprintf(gen->source, "            return direct_out_of_memory(ctx, input, %s);\n", name);
+        fprintf(gen->source, "        }\n");
+        fprintf(gen->source, "        node->children[0] = result.data.success;\n");
+        fprintf(gen->source, "        node->children[1] = op.data.success;\n");
+        fprintf(gen->source, "        node->children[2] = right.data.success;\n");
+        fprintf(gen->source, "        node->children_count = 3;\n");
+        fprintf(gen->source, "        node->len = (size_t)(current - node->content);\n");
+        fprintf(gen->source, "        result = direct_success(node);\n");
+        fprintf(gen->source, "    }\n\n");
+    }
+    else
+    {
+        fprintf(gen->source, "        if (!epc_direct_node_add_child(parts, op.data.success))\n");
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            epc_direct_result_cleanup(&op);\n");
+        fprintf(gen->source, "            epc_direct_result_cleanup(&right);\n");
+        fprintf(gen->source, "            epc_direct_node_free(parts);\n");
+        fprintf(gen->source, "            direct_discard(&saved);\n");
+        fprintf(gen->source, "            return direct_out_of_memory(ctx, input, %s);\n", name);
+        fprintf(gen->source, "        }\n");
+        fprintf(gen->source, "        if (!epc_direct_node_add_child(parts, right.data.success))\n");
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            epc_direct_result_cleanup(&right);\n");
+        fprintf(gen->source, "            epc_direct_node_free(parts);\n");
+        fprintf(gen->source, "            direct_discard(&saved);\n");
+        fprintf(gen->source, "            return direct_out_of_memory(ctx, input, %s);\n", name);
+        fprintf(gen->source, "        }\n");
+        fprintf(gen->source, "    }\n\n");
+        // Each item, operator and item at the end is replaced by the node combining them.
+        fprintf(gen->source, "    while (parts->children_count > 1)\n");
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        epc_cpt_node_t * * last = &parts->children[parts->children_count - 3];\n");
+        fprintf(gen->source, "        epc_cpt_node_t * node = direct_node(\"chainr1_combined\", %s, %s, last[0]->content);\n", name, action);
+        fprintf(gen->source, "        if (node == NULL || (node->children = calloc(3, sizeof(*node->children))) == NULL)\n");
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            epc_direct_node_free(node);\n");
+        fprintf(gen->source, "            epc_direct_node_free(parts);\n");
+        fprintf(gen->source, "            direct_discard(&saved);\n");
+        fprintf(gen->source, "            return direct_out_of_memory(ctx, input, %s);\n", name);
+        fprintf(gen->source, "        }\n");
+        fprintf(gen->source, "        node->children[0] = last[0];\n");
+        fprintf(gen->source, "        node->children[1] = last[1];\n");
+        fprintf(gen->source, "        node->children[2] = last[2];\n");
+        fprintf(gen->source, "        node->children_count = 3;\n");
+        fprintf(gen->source, "        node->len = (size_t)(last[2]->content + last[2]->len - last[0]->content);\n");
+        fprintf(gen->source, "        last[0] = node;\n");
+        fprintf(gen->source, "        parts->children_count -= 2;\n");
+        fprintf(gen->source, "    }\n");
+        fprintf(gen->source, "    result = direct_success(parts->children[0]);\n");
+        fprintf(gen->source, "    parts->children_count = 0;\n");
+        fprintf(gen->source, "    epc_direct_node_free(parts);\n");
+    }
+    fprintf(gen->source, "    direct_restore(state, ctx, &saved);\n");
+    fprintf(gen->source, "    return result;\n");
+    direct_function_end(gen);
+
+done:
+    free(item);
+    free(op);
+    free(guard);
+    return fn;
+}
+
+static char *
+direct_emit_optional(direct_generator_t * gen, gdl_ast_node_t * child_node, char const * name, char const * action, char const * function_name)
+{
+    char * child = direct_emit_expression(gen, child_node, NULL, NULL, NULL);
+    if (child == NULL)
+    {
+        return NULL;
+    }
+    char * guard = direct_guard_condition(gen, child_node, "(unsigned char)input[0]");
+
+    char * fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, false);
+    char const * indent = "    ";
+    if (guard != NULL)
+    {
+        fprintf(gen->source, "    if (%s)\n", guard);
+        fprintf(gen->source, "    {\n");
+        indent = "        ";
+    }
+    fprintf(gen->source, "%sdirect_saved_t saved = direct_save(state, ctx);\n", indent);
+    fprintf(gen->source, "%sepc_parse_result_t result = %s(state, ctx, input, NULL);\n\n", indent, child);
+    fprintf(gen->source, "%sif (!result.is_error)\n", indent);
+    fprintf(gen->source, "%s{\n", indent);
+    fprintf(gen->source, "%s    result = direct_wrap(ctx, \"optional\", %s, %s, input, &result);\n", indent, name, action);
+    fprintf(gen->source, "%s    if (!result.is_error)\n", indent);
+    fprintf(gen->source, "%s    {\n", indent);
+    fprintf(gen->source, "%s        direct_restore(state, ctx, &saved);\n", indent);
+    fprintf(gen->source, "%s    }\n", indent);
+    fprintf(gen->source, "%s    direct_discard(&saved);\n", indent);
+    fprintf(gen->source, "%s    return result;\n", indent);
+    fprintf(gen->source, "%s}\n", indent);
+    fprintf(gen->source, "%sepc_direct_result_cleanup(&result);\n", indent);
+    fprintf(gen->source, "%sdirect_discard(&saved);\n", indent);
+    if (guard != NULL)
+    {
+        fprintf(gen->source, "    }\n");
+    }
+    fprintf(gen->source, "    return direct_leaf(ctx, \"optional\", %s, %s, input, 0);\n", name, action);
+    direct_function_end(gen);
+
+    free(child);
+    free(guard);
+    return fn;
+}
+
+static char *
+direct_emit_skip(direct_generator_t * gen, gdl_ast_node_t * child_node, char const * name, char const * action, char const * function_name)
+{
+    char * child = direct_emit_expression(gen, child_node, NULL, NULL, NULL);
+    if (child == NULL)
+    {
+        return NULL;
+    }
+    char * guard = direct_guard_condition(gen, child_node, "(unsigned char)current[0]");
+
+    char * fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, false);
+    fprintf(gen->source, "    const char * current = input;\n");
+    fprintf(gen->source, "    for (;;)\n");
+    fprintf(gen->source, "    {\n");
+    if (guard != NULL)
+    {
+        fprintf(gen->source, "        if (!(%s))\n", guard);
+        fprintf(gen->source, "        {\n");
+        fprintf(gen->source, "            break;\n");
+        fprintf(gen->source, "        }\n");
+    }
+    fprintf(gen->source, "        direct_saved_t saved = direct_save(state, ctx);\n");
+    fprintf(gen->source, "        epc_parse_result_t result = %s(state, ctx, current, NULL);\n", child);
+    fprintf(gen->source, "        if (result.is_error)\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            direct_restore(state, ctx, &saved);\n");
+    fprintf(gen->source, "            epc_direct_result_cleanup(&result);\n");
+    fprintf(gen->source, "            break;\n");
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        size_t len = result.data.success->len;\n");
+    fprintf(gen->source, "        direct_discard(&saved);\n");
+    fprintf(gen->source, "        epc_direct_result_cleanup(&result);\n");
+    fprintf(gen->source, "        if (len == 0)\n");
+    fprintf(gen->source, "        {\n");
+    fprintf(gen->source, "            return direct_fail(state, input, \"Infinite recursion detected\", %s, \"N/A\", SIZE_MAX);\n", name);
+    fprintf(gen->source, "        }\n");
+    fprintf(gen->source, "        current += len;\n");
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    return direct_leaf(ctx, \"skip\", %s, %s, input, (size_t)(current - input));\n", name, action);
+    direct_function_end(gen);
+
+    free(child);
+    free(guard);
+    return fn;
+}
+
+static char *
+direct_emit_predicate(
+    direct_generator_t * gen,
+    gdl_ast_node_t * child_node,
+    bool negated,
+    char const * name,
+    char const * action,
+    char const * function_name)
+{
+    char * child = direct_emit_expression(gen, child_node, NULL, NULL, NULL);
+    if (child == NULL)
+    {
+        return NULL;
+    }
+
+    char * fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, false);
+    fprintf(gen->source, "    direct_saved_t saved = direct_save(state, ctx);\n");
+    fprintf(gen->source, "    epc_parse_result_t result = %s(state, ctx, input, NULL);\n", child);
+    fprintf(gen->source, "    direct_restore(state, ctx, &saved);\n\n");
+    if (!negated)
+    {
+        fprintf(gen->source, "    if (result.is_error)\n");
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        return result;\n");
+        fprintf(gen->source, "    }\n");
+        fprintf(gen->source, "    epc_direct_result_cleanup(&result);\n");
+        fprintf(gen->source, "    return direct_leaf(ctx, \"lookahead\", %s, %s, input, 0);\n", name, action);
+    }
+    else
+    {
+        char * expected = direct_expected_literal(gen, child_node, NULL, 0);
+        fprintf(gen->source, "    if (result.is_error)\n");
+        fprintf(gen->source, "    {\n");
+        fprintf(gen->source, "        epc_direct_result_cleanup(&result);\n");
+        fprintf(gen->source, "        return direct_leaf(ctx, \"not\", %s, %s, input, 0);\n", name, action);
+        fprintf(gen->source, "    }\n\n");
+        fprintf(gen->source, "    char const * found = result.data.success->content;\n");
+        fprintf(gen->source, "    epc_direct_result_cleanup(&result);\n");
+        fprintf(gen->source, "    return direct_fail(state, input, \"Parser unexpectedly matched\", \"not \" %s, found, DIRECT_FOUND_SIZE - 1);\n", expected);
+        free(expected);
+    }
+    direct_function_end(gen);
+
+    free(child);
+    return fn;
+}
+
+static char *
+direct_emit_lexeme(direct_generator_t * gen, gdl_ast_node_t * child_node, char const * name, char const * action, char const * function_name)
+{
+    char * child = direct_emit_expression(gen, child_node, NULL, NULL, NULL);
+    if (child == NULL)
+    {
+        return NULL;
+    }
+
+    char * fn = direct_new_function_name(gen, function_name);
+    direct_function_begin(gen, fn, true, true);
+    fprintf(gen->source, "    direct_saved_t saved = direct_save(state, ctx);\n");
+    fprintf(gen->source, "    size_t leading = direct_consume_whitespace(input);\n");
+    fprintf(gen->source, "    epc_parse_result_t result = %s(state, ctx, input + leading, cut);\n", child);
+    fprintf(gen->source, "    if (result.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        direct_discard(&saved);\n");
+    fprintf(gen->source, "        return result;\n");
+    fprintf(gen->source, "    }\n\n");
+    fprintf(gen->source, "    size_t item_len = result.data.success->len;\n");
+    fprintf(gen->source, "    size_t trailing = direct_consume_whitespace(input + leading + item_len);\n");
+    fprintf(gen->source, "    result = direct_wrap(ctx, \"lexeme\", %s, %s, input, &result);\n", name, action);
+    fprintf(gen->source, "    if (result.is_error)\n");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        direct_discard(&saved);\n");
+    fprintf(gen->source, "        return result;\n");
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    direct_restore(state, ctx, &saved);\n");
+    fprintf(gen->source, "    result.data.success->content = input;\n");
+    fprintf(gen->source, "    result.data.success->len = leading + item_len + trailing;\n");
+    fprintf(gen->source, "    result.data.success->semantic_start_offset = leading;\n");
+    fprintf(gen->source, "    result.data.success->semantic_end_offset = trailing;\n");
+    fprintf(gen->source, "    return result;\n");
+    direct_function_end(gen);
+
+    free(child);
+    return fn;
+}
+
+static char *
+direct_emit_char_class(direct_generator_t * gen, gdl_ast_node_t * node, char const * name, char const * action, char const * function_name)
+{
+    bool negated = node->type == GDL_AST_NODE_TYPE_COMBINATOR_NONEOF;
+    char const * chars = node->data.none_or_one_of_call.args;
+    char * fn = direct_new_function_name(gen, function_name);
+
+    direct_function_begin(gen, fn, true, false);
+    fprintf(gen->source, "    static char const set[] = \"%s\";\n\n", chars);
+    fprintf(gen->source, "    if (input[0] == '\\0' || (memchr(set, input[0], sizeof(set) - 1) %s NULL))\n", negated ? "!=" : "==");
+    fprintf(gen->source, "    {\n");
+    fprintf(gen->source, "        return direct_mismatch(state, input, \"%s\", \"character %sin set '\" \"%s\" \"'\");\n",
+            negated ? "Character found in forbidden set" : "Character not found in set",
+            negated ? "not " : "",
+            chars);
+    fprintf(gen->source, "    }\n");
+    fprintf(gen->source, "    return direct_leaf(ctx, \"%s\", %s, %s, input, 1);\n", negated ? "none_of" : "one_of", name, action);
+    direct_function_end(gen);
+
+    return fn;
+}
+
+static char *
+direct_emit_expression(
+    direct_generator_t * gen,
+    gdl_ast_node_t * node,
+    char const * name,
+    char const * action,
+    char const * function_name)
+{
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    char * name_literal = direct_name_literal(node, name);
+    char const * action_value = action != NULL ? action : "-1";
+    char * fn = NULL;
+
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_TERMINAL:
+        fn = direct_emit_expression(gen, node->data.terminal.expression, name, action, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
+    {
+        char * pascal_ref_name = to_pascal_case(node->data.identifier_ref.name);
+        char * target = str_printf("parse_%s", pascal_ref_name);
+        if (target != NULL)
+        {
+            fn = direct_forward(gen, target, action, function_name);
+        }
+        free(target);
+        free(pascal_ref_name);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
+    {
+        unsigned char c = (unsigned char)node->data.char_literal.value;
+        char * constant = c_char_constant(c);
+        char * condition = str_printf("input[0] != %s", constant);
+        char * expected = c_string_literal_of_char(c);
+        fn = direct_emit_char_test(gen, function_name, condition, "Unexpected character", expected, "char", name_literal, action_value);
+        free(constant);
+        free(condition);
+        free(expected);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+        fn = direct_emit_string(gen, node, name_literal, action_value, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_CHAR_RANGE:
+    {
+        char * start = c_char_constant((unsigned char)node->data.char_range.start_char);
+        char * end = c_char_constant((unsigned char)node->data.char_range.end_char);
+        char * start_str = c_string_literal_of_char((unsigned char)node->data.char_range.start_char);
+        char * end_str = c_string_literal_of_char((unsigned char)node->data.char_range.end_char);
+        char * condition = str_printf("input[0] == '\\0' || input[0] < %s || input[0] > %s", start, end);
+        char * expected = str_printf("\"character in range [\" %s \"-\" %s \"]\"", start_str, end_str);
+        fn = direct_emit_char_test(gen, function_name, condition, "Unexpected character", expected, "char_range", name_literal, action_value);
+        free(start);
+        free(end);
+        free(start_str);
+        free(end_str);
+        free(condition);
+        free(expected);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
+        if (node->data.none_or_one_of_call.args != NULL)
+        {
+            fn = direct_emit_char_class(gen, node, name_literal, action_value, function_name);
+        }
+        break;
+
+    case GDL_AST_NODE_TYPE_KEYWORD:
+        fn = direct_emit_keyword(gen, node, action, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_FAIL_CALL:
+    {
+        fn = direct_new_function_name(gen, function_name);
+        direct_function_begin(gen, fn, true, false);
+        fprintf(gen->source, "    return direct_fail(state, input, \"%s\", \"%s\", input[0] != '\\0' ? input : \"EOF\", DIRECT_FOUND_SIZE - 1);\n",
+                node->data.string_literal.value, name != NULL ? name : "NULL");
+        direct_function_end(gen);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        if (node->data.sequence.elements.count == 0)
+        {
+            fn = direct_emit_leaf(gen, function_name, "succeed", "\"empty_seq\"", "-1");
+        }
+        else if (node->data.sequence.elements.count == 1)
+        {
+            fn = direct_emit_expression(gen, node->data.sequence.elements.head->item, name, action, function_name);
+        }
+        else
+        {
+            fn = direct_emit_sequence(gen, node, name_literal, action_value, function_name);
+        }
+        break;
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+        if (node->data.alternative.alternatives.count == 0)
+        {
+            fprintf(stderr, "Error: Empty alternative in rule '%s'.\n", gen->rule_name);
+        }
+        else if (node->data.alternative.alternatives.count == 1)
+        {
+            fn = direct_emit_expression(gen, node->data.alternative.alternatives.head->item, name, action, function_name);
+        }
+        else if (alternative_is_keyword_set(node))
+        {
+            fn = direct_emit_keyword_set(gen, node, name_literal, action_value, function_name);
+        }
+        else
+        {
+            fn = direct_emit_alternative(gen, node, name_literal, action_value, function_name);
+        }
+        break;
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+    {
+        char operator_char = node->data.repetition_expr.repetition->data.repetition_op.operator_char;
+        gdl_ast_node_t * child_node = node->data.repetition_expr.expression;
+        if (operator_char == '*')
+        {
+            fn = direct_emit_repetition(gen, node, child_node, false, "many", name_literal, action_value, function_name);
+        }
+        else if (operator_char == '+')
+        {
+            fn = direct_emit_repetition(gen, node, child_node, true, "plus", name_literal, action_value, function_name);
+        }
+        else if (operator_char == '?')
+        {
+            fn = direct_emit_optional(gen, child_node, name_literal, action_value, function_name);
+        }
+        else
+        {
+            fprintf(stderr, "Error: Unknown repetition operator '%c'.\n", operator_char);
+        }
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        fn = direct_emit_optional(gen, node->data.optional.expr, name_literal, action_value, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+        fn = direct_emit_skip(gen, node->data.unary_combinator_call.expr, name_literal, action_value, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+        fn = direct_emit_predicate(
+            gen,
+            node->data.unary_combinator_call.expr,
+            node->type == GDL_AST_NODE_TYPE_COMBINATOR_NOT,
+            name_literal,
+            action_value,
+            function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+        fn = direct_emit_lexeme(gen, node->data.unary_combinator_call.expr, name_literal, action_value, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+    {
+        // The child's node is returned as-is, so the passthru's name and action have no effect.
+        char * child = direct_emit_expression(gen, node->data.unary_combinator_call.expr, NULL, NULL, NULL);
+        if (child != NULL)
+        {
+            fn = direct_forward(gen, child, NULL, function_name);
+        }
+        free(child);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+    {
+        char * child = direct_fallback_operand(gen, node->data.count_call.expression);
+        if (child != NULL)
+        {
+            char * parser = str_printf("epc_count_l(list, %s%s%s, %lld, %s)",
+                                       name != NULL ? "\"" : "", name != NULL ? name : "NULL", name != NULL ? "\"" : "",
+                                       node->data.count_call.count_node->data.number_literal.value, child);
+            fn = direct_fallback(gen, parser, action, function_name);
+            free(parser);
+        }
+        free(child);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+        fn = direct_emit_between(gen, node, name_literal, action_value, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        fn = direct_emit_delimited(gen, node, name_literal, action_value, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        fn = direct_emit_chain(gen, node, name_literal, action_value, function_name);
+        break;
+
+    case GDL_AST_NODE_TYPE_TOKEN_DFA:
+    {
+        // As with the other backends, the DFA is named after its rule.
+        char * dfa_name = gdl_token_dfa_object_name(node->data.token_dfa.rule_name);
+        char * rule_name = to_pascal_case(node->data.token_dfa.rule_name);
+        if (dfa_name != NULL && rule_name != NULL)
+        {
+            fn = direct_new_function_name(gen, function_name);
+            direct_function_begin(gen, fn, true, false);
+            fprintf(gen->source, "    return direct_dfa(state, ctx, &%s, \"%s\", %s, input);\n",
+                    dfa_name, name != NULL ? name : rule_name, action_value);
+            direct_function_end(gen);
+        }
+        free(dfa_name);
+        free(rule_name);
+        break;
+    }
+
+    default:
+        fprintf(stderr, "Error: Unsupported AST node type for code generation: %d\n", node->type);
+        break;
+    }
+
+    free(name_literal);
+    if (fn == NULL)
+    {
+        gen->has_error = true;
+    }
+    return fn;
+}
+
+// --- Rules ---
+
+typedef struct
+{
+    direct_generator_t * gen;
+    char const * rule_name;
+} direct_reachability_ctx_t;
+
+static void direct_mark_reachable(direct_generator_t * gen, gdl_rule_analysis_t * rule);
+
+static void
+direct_visit_references(gdl_ast_node_t * node, void * user_data)
+{
+    direct_reachability_ctx_t * reach = user_data;
+
+    if (node == NULL)
+    {
+        return;
+    }
+    if (node->type == GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+    {
+        gdl_rule_analysis_t * rule = gdl_grammar_analysis_find_rule(&reach->gen->analysis, node->data.identifier_ref.name);
+        if (rule == NULL)
+        {
+            fprintf(stderr, "Error: Rule '%s' references undefined rule '%s'.\n", reach->rule_name, node->data.identifier_ref.name);
+            reach->gen->has_error = true;
+            return;
+        }
+        direct_mark_reachable(reach->gen, rule);
+        return;
+    }
+    gdl_expression_for_each_child(node, direct_visit_references, user_data);
+}
+
+static void
+direct_mark_reachable(direct_generator_t * gen, gdl_rule_analysis_t * rule)
+{
+    int index = (int)(rule - gen->analysis.rules);
+
+    if (gen->rule_reachable[index])
+    {
+        return;
+    }
+    gen->rule_reachable[index] = true;
+
+    direct_reachability_ctx_t reach = { .gen = gen, .rule_name = rule->name };
+    direct_visit_references(rule->rule_def->data.rule_def.definition, &reach);
+}
+
+/*
+ * In the default backend a rule defined as just a reference to an earlier
+ * rule is the same parser as that rule, so a semantic action given to it
+ * applies to the earlier rule instead.
+ */
+static gdl_rule_analysis_t *
+direct_alias_target(direct_generator_t * gen, gdl_rule_analysis_t * rule)
+{
+    for (int hops = 0; hops < gen->analysis.count; hops++)
+    {
+        gdl_ast_node_t * definition = unwrap_expression(rule->rule_def->data.rule_def.definition);
+        if (definition == NULL || definition->type != GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+        {
+            break;
+        }
+        gdl_rule_analysis_t * target = gdl_grammar_analysis_find_rule(&gen->analysis, definition->data.identifier_ref.name);
+        if (target == NULL || target >= rule)
+        {
+            break;
+        }
+        rule = target;
+    }
+    return rule;
+}
+
+static void
+direct_assign_rule_actions(direct_generator_t * gen)
+{
+    for (int i = 0; i < gen->analysis.count; i++)
+    {
+        gdl_ast_node_t * semantic_action = gen->analysis.rules[i].rule_def->data.rule_def.semantic_action;
+        if (semantic_action != NULL && semantic_action->data.semantic_action.action_name != NULL)
+        {
+            gdl_rule_analysis_t * target = direct_alias_target(gen, &gen->analysis.rules[i]);
+            gen->rule_actions[target - gen->analysis.rules] = semantic_action->data.semantic_action.action_name;
+        }
+    }
+}
+
+static bool
+direct_generate_rule(direct_generator_t * gen, gdl_rule_analysis_t * rule)
+{
+    gdl_ast_node_t * rule_def = rule->rule_def;
+    char const * action_name = gen->rule_actions[rule - gen->analysis.rules];
+    char * action = action_name != NULL ? to_upper_case(action_name) : NULL;
+
+    gen->rule_name = to_pascal_case(rule->name);
+    gen->function_count = 0;
+    char * function_name = str_printf("parse_%s", gen->rule_name);
+    gen->rule_function = function_name;
+
+    fprintf(gen->source, "// --- Rule: %s ---\n\n", rule->name);
+    char * fn = direct_emit_expression(gen, rule_def->data.rule_def.definition, gen->rule_name, action, function_name);
+    bool success = fn != NULL && !gen->has_error;
+
+    free(fn);
+    gen->rule_function = NULL;
+    free(function_name);
+    free(gen->rule_name);
+    gen->rule_name = NULL;
+    free(action);
+
+    return success;
+}
+
+// Code every generated parser might need. Only the helpers a parser uses are written out.
+typedef struct
+{
+    char const * name; // NULL if always needed.
+    char const * text;
+} direct_helper_t;
+
+static direct_helper_t const direct_helpers[] = {
+    {
+        NULL,
+        "/*\n"
+        " * A failure to match. Making an epc_parser_error_t for each one would cost\n"
+        " * allocations, and a scan of the input for the line and column, every time\n"
+        " * the parse backtracks, so only what it takes to make one is kept, and the\n"
+        " * error is made when the parse returns.\n"
+        " */\n"
+        "typedef struct direct_failure_t\n"
+        "{\n"
+        "    const char * input; // NULL if nothing has failed.\n"
+        "    char const * message;\n"
+        "    char const * expected;\n"
+        "    char const * found;\n"
+        "    size_t found_len; // How much of found to report, or SIZE_MAX for all of it.\n"
+        "} direct_failure_t;\n"
+        "\n"
+        "typedef struct direct_grammar_t direct_grammar_t;\n"
+        "\n"
+        "// The state of a call of the generated parser.\n"
+        "typedef struct direct_state_t\n"
+        "{\n"
+        "    direct_grammar_t * grammar;\n"
+        "    direct_failure_t last;     // The failure of the latest error result that has no error object.\n"
+        "    direct_failure_t furthest; // Kept as the context's furthest error is by the library's parsers.\n"
+        "} direct_state_t;\n"
+        "\n"
+        "// What a function that backtracks restores if the failures it backtracks over shouldn't be reported.\n"
+        "typedef struct direct_saved_t\n"
+        "{\n"
+        "    direct_failure_t furthest;\n"
+        "    epc_parser_error_t * error; // The context's furthest error, left by parsers run with epc_direct_parse().\n"
+        "} direct_saved_t;\n"
+        "\n"
+        "/*\n"
+        " * The functions below build the same CPT nodes as the equivalent easy_pc\n"
+        " * combinators. 'cut' is the innermost alternative being tried, for ~ to commit to.\n"
+        " */\n"
+        "typedef struct direct_cut_t\n"
+        "{\n"
+        "    bool committed;\n"
+        "    direct_saved_t saved;\n"
+        "} direct_cut_t;\n",
+    },
+    {
+        NULL,
+        "#define DIRECT_FOUND_SIZE 21\n",
+    },
+    {
+        "direct_set_action",
+        "static void\n"
+        "direct_set_action(epc_cpt_node_t * node, int action)\n"
+        "{\n"
+        "    if (action >= 0)\n"
+        "    {\n"
+        "        node->ast_config.assigned = true;\n"
+        "        node->ast_config.action = action;\n"
+        "    }\n"
+        "}\n",
+    },
+    {
+        "direct_node",
+        "static epc_cpt_node_t *\n"
+        "direct_node(char const * tag, char const * name, int action, const char * input)\n"
+        "{\n"
+        "    epc_cpt_node_t * node = epc_direct_node_alloc(tag, name, input);\n"
+        "    if (node != NULL)\n"
+        "    {\n"
+        "        direct_set_action(node, action);\n"
+        "    }\n"
+        "    return node;\n"
+        "}\n",
+    },
+    {
+        "direct_success",
+        "static epc_parse_result_t\n"
+        "direct_success(epc_cpt_node_t * node)\n"
+        "{\n"
+        "    epc_parse_result_t result = { .is_error = false, .data.success = node };\n"
+        "    return result;\n"
+        "}\n",
+    },
+    {
+        "direct_out_of_memory",
+        "static epc_parse_result_t\n"
+        "direct_out_of_memory(epc_parser_ctx_t * ctx, const char * input, char const * name)\n"
+        "{\n"
+        "    return epc_direct_error(ctx, input, \"Memory allocation error\", name, \"N/A\");\n"
+        "}\n",
+    },
+    {
+        "direct_leaf",
+        "static epc_parse_result_t\n"
+        "direct_leaf(epc_parser_ctx_t * ctx, char const * tag, char const * name, int action, const char * input, size_t len)\n"
+        "{\n"
+        "    epc_cpt_node_t * node = direct_node(tag, name, action, input);\n"
+        "    if (node == NULL)\n"
+        "    {\n"
+        "        return direct_out_of_memory(ctx, input, name);\n"
+        "    }\n"
+        "    node->len = len;\n"
+        "    return direct_success(node);\n"
+        "}\n",
+    },
+    {
+        "direct_wrap",
+        "// Takes ownership of the successful child result and wraps it in a new node with the same content.\n"
+        "static epc_parse_result_t\n"
+        "direct_wrap(epc_parser_ctx_t * ctx, char const * tag, char const * name, int action, const char * input, epc_parse_result_t * child)\n"
+        "{\n"
+        "    epc_cpt_node_t * node = direct_node(tag, name, action, input);\n"
+        "    if (node == NULL || !epc_direct_node_add_child(node, child->data.success))\n"
+        "    {\n"
+        "        epc_direct_node_free(node);\n"
+        "        epc_direct_result_cleanup(child);\n"
+        "        return direct_out_of_memory(ctx, input, name);\n"
+        "    }\n"
+        "    node->content = child->data.success->content;\n"
+        "    node->len = child->data.success->len;\n"
+        "    return direct_success(node);\n"
+        "}\n",
+    },
+    {
+        "direct_fail",
+        "// Returns an error result with no error object, for a failure direct_finish() makes one for.\n"
+        "static epc_parse_result_t\n"
+        "direct_fail(direct_state_t * state, const char * input, char const * message, char const * expected, char const * found, size_t found_len)\n"
+        "{\n"
+        "    state->last = (direct_failure_t){ input, message, expected, found, found_len };\n"
+        "    if (state->furthest.input == NULL || input >= state->furthest.input)\n"
+        "    {\n"
+        "        state->furthest = state->last;\n"
+        "    }\n"
+        "    epc_parse_result_t result = { .is_error = true, .data.error = NULL };\n"
+        "    return result;\n"
+        "}\n",
+    },
+    {
+        "direct_save",
+        "static direct_saved_t\n"
+        "direct_save(direct_state_t * state, epc_parser_ctx_t * ctx)\n"
+        "{\n"
+        "    direct_saved_t saved = { .furthest = state->furthest, .error = epc_direct_furthest_error_save(ctx) };\n"
+        "    return saved;\n"
+        "}\n",
+    },
+    {
+        "direct_restore",
+        "static void\n"
+        "direct_restore(direct_state_t * state, epc_parser_ctx_t * ctx, direct_saved_t * saved)\n"
+        "{\n"
+        "    state->furthest = saved->furthest;\n"
+        "    epc_direct_furthest_error_restore(ctx, &saved->error);\n"
+        "}\n",
+    },
+    {
+        "direct_discard",
+        "static void\n"
+        "direct_discard(direct_saved_t * saved)\n"
+        "{\n"
+        "    epc_direct_furthest_error_discard(saved->error);\n"
+        "    saved->error = NULL;\n"
+        "}\n",
+    },
+    {
+        "direct_alternative_success",
+        "static epc_parse_result_t\n"
+        "direct_alternative_success(\n"
+        "    direct_state_t * state, epc_parser_ctx_t * ctx, char const * name, int action, const char * input, direct_cut_t * scope,\n"
+        "    epc_parse_result_t * child, int index)\n"
+        "{\n"
+        "    epc_parse_result_t result = direct_wrap(ctx, \"or\", name, action, input, child);\n"
+        "    if (result.is_error)\n"
+        "    {\n"
+        "        direct_discard(&scope->saved);\n"
+        "        return result;\n"
+        "    }\n"
+        "    result.data.success->alternative_index = index;\n"
+        "    if (!scope->committed)\n"
+        "    {\n"
+        "        direct_restore(state, ctx, &scope->saved);\n"
+        "    }\n"
+        "    return result;\n"
+        "}\n",
+    },
+    {
+        "direct_mismatch",
+        "static epc_parse_result_t\n"
+        "direct_mismatch(direct_state_t * state, const char * input, char const * message, char const * expected)\n"
+        "{\n"
+        "    if (input[0] == '\\0')\n"
+        "    {\n"
+        "        return direct_fail(state, input, \"Unexpected end of input\", expected, \"EOF\", SIZE_MAX);\n"
+        "    }\n"
+        "    return direct_fail(state, input, message, expected, input, 1);\n"
+        "}\n",
+    },
+    {
+        "direct_string_mismatch",
+        "static epc_parse_result_t\n"
+        "direct_string_mismatch(direct_state_t * state, const char * input, char const * expected, size_t expected_len)\n"
+        "{\n"
+        "    if (input[0] == '\\0')\n"
+        "    {\n"
+        "        return direct_fail(state, input, \"Unexpected end of input\", expected, \"EOF\", SIZE_MAX);\n"
+        "    }\n"
+        "    size_t available = 1;\n"
+        "    while (available < expected_len && input[available] != '\\0')\n"
+        "    {\n"
+        "        available++;\n"
+        "    }\n"
+        "    char const * message = available < expected_len ? \"Unexpected end of input\" : \"Unexpected string\";\n"
+        "    return direct_fail(state, input, message, expected, input, DIRECT_FOUND_SIZE - 1);\n"
+        "}\n",
+    },
+    {
+        "direct_dfa",
+        "// Runs a token DFA, as epc_dfa() does.\n"
+        "static epc_parse_result_t\n"
+        "direct_dfa(direct_state_t * state, epc_parser_ctx_t * ctx, epc_dfa_t const * dfa, char const * name, int action, const char * input)\n"
+        "{\n"
+        "    unsigned state = (unsigned)dfa->start;\n"
+        "    bool matched = dfa->accepting[state] != 0;\n"
+        "    size_t matched_len = 0;\n"
+        "\n"
+        "    for (size_t i = 0; input[i] != '\\0'; i++)\n"
+        "    {\n"
+        "        state = dfa->transitions[state * (unsigned)dfa->class_count + dfa->classes[(unsigned char)input[i]]];\n"
+        "        if (state == 0)\n"
+        "        {\n"
+        "            break;\n"
+        "        }\n"
+        "        if (dfa->accepting[state])\n"
+        "        {\n"
+        "            matched = true;\n"
+        "            matched_len = i + 1;\n"
+        "        }\n"
+        "    }\n"
+        "    if (matched)\n"
+        "    {\n"
+        "        return direct_leaf(ctx, \"dfa\", name, action, input, matched_len);\n"
+        "    }\n"
+        "    if (input[0] == '\\0')\n"
+        "    {\n"
+        "        return direct_fail(state, input, \"Unexpected end of input\", name, \"EOF\", SIZE_MAX);\n"
+        "    }\n"
+        "    return direct_fail(state, input, \"Unexpected input\", name, input, DIRECT_FOUND_SIZE - 1);\n"
+        "}\n",
+    },
+    {
+        "direct_consume_whitespace",
+        "// Skips whitespace and // comments, as lexeme() does.\n"
+        "static size_t\n"
+        "direct_consume_whitespace(const char * input)\n"
+        "{\n"
+        "    size_t len = 0;\n"
+        "    bool consumed_something;\n"
+        "\n"
+        "    do\n"
+        "    {\n"
+        "        consumed_something = false;\n"
+        "        while (input[len] != '\\0' && isspace((unsigned char)input[len]))\n"
+        "        {\n"
+        "            len++;\n"
+        "            consumed_something = true;\n"
+        "        }\n"
+        "        if (input[len] == '/' && input[len + 1] == '/')\n"
+        "        {\n"
+        "            len += 2;\n"
+        "            while (input[len] != '\\0' && input[len] != '\\n')\n"
+        "            {\n"
+        "                len++;\n"
+        "            }\n"
+        "            if (input[len] == '\\n')\n"
+        "            {\n"
+        "                len++;\n"
+        "            }\n"
+        "            consumed_something = true;\n"
+        "        }\n"
+        "    } while (consumed_something);\n"
+        "\n"
+        "    return len;\n"
+        "}\n",
+    },
+    {
+        "direct_error",
+        "static epc_parse_result_t\n"
+        "direct_error(epc_parser_ctx_t * ctx, direct_failure_t const * failure)\n"
+        "{\n"
+        "    char found[DIRECT_FOUND_SIZE];\n"
+        "    char const * reported = failure->found;\n"
+        "    if (failure->found_len != SIZE_MAX)\n"
+        "    {\n"
+        "        snprintf(found, sizeof(found), \"%.*s\", (int)failure->found_len, failure->found);\n"
+        "        reported = found;\n"
+        "    }\n"
+        "    return epc_direct_error(ctx, failure->input, failure->message, failure->expected, reported);\n"
+        "}\n",
+    },
+    {
+        "direct_finish",
+        "// Makes the errors for the failures of the generated functions, once the parse returns.\n"
+        "static epc_parse_result_t\n"
+        "direct_finish(direct_state_t * state, epc_parser_ctx_t * ctx, epc_parse_result_t result)\n"
+        "{\n"
+        "    if (state->furthest.input != NULL)\n"
+        "    {\n"
+        "        // Recorded as the furthest error, if it is.\n"
+        "        epc_parse_result_t furthest = direct_error(ctx, &state->furthest);\n"
+        "        epc_direct_result_cleanup(&furthest);\n"
+        "    }\n"
+        "    if (result.is_error && result.data.error == NULL)\n"
+        "    {\n"
+        "        // Backtracking may have dropped the failure from the furthest errors, so it isn't recorded again.\n"
+        "        epc_parser_error_t * saved = epc_direct_furthest_error_save(ctx);\n"
+        "        result = direct_error(ctx, &state->last);\n"
+        "        epc_direct_furthest_error_restore(ctx, &saved);\n"
+        "    }\n"
+        "    return result;\n"
+        "}\n",
+    },
+};
+
+static void
+direct_write_helpers(FILE * source, char const * body)
+{
+    size_t const count = sizeof(direct_helpers) / sizeof(direct_helpers[0]);
+    bool needed[sizeof(direct_helpers) / sizeof(direct_helpers[0])] = { false };
+
+    // Helpers only call those defined before them, so work backwards from the generated code.
+    for (size_t i = count; i-- > 0;)
+    {
+        if (direct_helpers[i].name == NULL)
+        {
+            needed[i] = true;
+            continue;
+        }
+        char call[64];
+        snprintf(call, sizeof(call), "%s(", direct_helpers[i].name);
+        needed[i] = strstr(body, call) != NULL;
+        for (size_t j = i + 1; j < count && !needed[i]; j++)
+        {
+            needed[i] = needed[j] && strstr(direct_helpers[j].text, call) != NULL;
+        }
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        if (needed[i])
+        {
+            fprintf(source, "%s\n", direct_helpers[i].text);
+        }
+    }
+}
+
+static void
+direct_free_entries(direct_entry_t * entry)
+{
+    while (entry != NULL)
+    {
+        direct_entry_t * next = entry->next;
+        free(entry->function_name);
+        free(entry);
+        entry = next;
+    }
+}
+
+bool
+gdl_generate_direct_c_code(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir)
+{
+    if (ast_root == NULL || ast_root->type != GDL_AST_NODE_TYPE_PROGRAM || base_name == NULL || output_dir == NULL)
+    {
+        fprintf(stderr, "Error: Invalid arguments or AST root type to gdl_generate_direct_c_code.\n");
+        return false;
+    }
+
+    fprintf(stdout, "Generating direct C code for '%s' in '%s'...\n", base_name, output_dir);
+
+    direct_generator_t gen = { .base_name = base_name };
+    bool success = false;
+    bool * token_used = NULL;
+
+    // Token rules are matched by a DFA, so their definitions aren't generated as functions.
+    if (!gdl_token_dfa_build(ast_root, &gen.token_dfa))
+    {
+        gdl_token_dfa_free(&gen.token_dfa);
+        return false;
+    }
+    if (!gdl_grammar_analyze(ast_root, &gen.analysis))
+    {
+        gdl_token_dfa_free(&gen.token_dfa);
+        return false;
+    }
+    if (gen.analysis.count == 0)
+    {
+        fprintf(stderr, "Error: The grammar has no rules.\n");
+        gdl_grammar_analysis_free(&gen.analysis);
+        gdl_token_dfa_free(&gen.token_dfa);
+        return false;
+    }
+    gen.rule_reachable = calloc(gen.analysis.count, sizeof(*gen.rule_reachable));
+    gen.rule_actions = calloc(gen.analysis.count, sizeof(*gen.rule_actions));
+    gen.fallbacks = open_memstream(&gen.fallbacks_text, &gen.fallbacks_size);
+    token_used = calloc(gen.token_dfa.token_count > 0 ? gen.token_dfa.token_count : 1, sizeof(*token_used));
+    if (gen.rule_reachable == NULL || gen.rule_actions == NULL || gen.fallbacks == NULL || token_used == NULL)
+    {
+        perror("Failed to allocate direct code generator");
+        goto done;
+    }
+    direct_assign_rule_actions(&gen);
+
+    // As with the default backend, the last rule is the one the parser starts with.
+    gdl_rule_analysis_t * start_rule = &gen.analysis.rules[gen.analysis.count - 1];
+    direct_mark_reachable(&gen, start_rule);
+    if (gen.has_error)
+    {
+        goto done;
+    }
+    for (int i = 0; i < gen.analysis.count; i++)
+    {
+        if (gen.rule_reachable[i] && gdl_rule_is_left_recursive(&gen.analysis, &gen.analysis.rules[i]))
+        {
+            fprintf(stderr,
+                    "Error: Rule '%s' is left-recursive, which the direct backend doesn't support.\n",
+                    gen.analysis.rules[i].name);
+            goto done;
+        }
+    }
+
+    if (!gdl_generate_semantic_actions_header(ast_root, base_name, output_dir)
+        || !gdl_generate_parser_header(base_name, output_dir))
+    {
+        goto done;
+    }
+
+    // The rule functions are generated first, as the number of fallback parsers is needed before them.
+    char * body_text = NULL;
+    size_t body_size = 0;
+    gen.source = open_memstream(&body_text, &body_size);
+    if (gen.source == NULL)
+    {
+        perror("Failed to allocate direct code generator");
+        goto done;
+    }
+    for (int i = 0; i < gen.analysis.count; i++)
+    {
+        if (gen.rule_reachable[i] && !direct_generate_rule(&gen, &gen.analysis.rules[i]))
+        {
+            fprintf(stderr, "Error: Failed to generate rule '%s'.\n", gen.analysis.rules[i].name);
+            fclose(gen.source);
+            gen.source = NULL;
+            free(body_text);
+            goto done;
+        }
+    }
+    char * start_rule_name = to_pascal_case(start_rule->name);
+    char * start_function = str_printf("parse_%s", start_rule_name);
+    char * start_entry = direct_entry_name(&gen, start_function);
+    free(start_function);
+    fclose(gen.source);
+    gen.source = NULL;
+    fflush(gen.fallbacks);
+
+    char source_filename[512];
+    snprintf(source_filename, sizeof(source_filename), "%s.c", base_name);
+    gdl_output_file_t output;
+    if (!gdl_output_file_open(&output, output_dir, source_filename))
+    {
+        free(start_rule_name);
+        free(start_entry);
+        free(body_text);
+        goto done;
+    }
+    FILE * source = output.stream;
+
+    fprintf(source, "// Generated source for %s (direct backend)\n", base_name);
+    fprintf(source, "#include \"%s.h\"\n", base_name);
+    fprintf(source, "#include \"%s_actions.h\"\n", base_name);
+    fprintf(source, "#include <easy_pc/easy_pc.h>\n");
+    fprintf(source, "#include <easy_pc/easy_pc_direct.h>\n");
+    fprintf(source, "#include <ctype.h>\n");
+    fprintf(source, "#include <stdbool.h>\n");
+    fprintf(source, "#include <stddef.h>\n");
+    fprintf(source, "#include <stdint.h>\n");
+    fprintf(source, "#include <stdio.h>\n");
+    fprintf(source, "#include <stdlib.h>\n");
+    fprintf(source, "#include <string.h>\n\n");
+    direct_write_helpers(source, body_text);
+
+    // Only the DFAs of the tokens that are generated are referenced.
+    for (int t = 0; t < gen.token_dfa.token_count; t++)
+    {
+        gdl_rule_analysis_t * rule = gdl_grammar_analysis_find_rule(&gen.analysis, gen.token_dfa.tokens[t].rule->data.rule_def.name);
+        token_used[t] = rule != NULL && gen.rule_reachable[rule - gen.analysis.rules];
+    }
+    gdl_token_dfa_write_tables(source, &gen.token_dfa, token_used);
+
+    // Parsers the generated code hands over to the library.
+    fprintf(source, "struct direct_grammar_t\n");
+    fprintf(source, "{\n");
+    fprintf(source, "    epc_parser_t * fallback[%d];\n", gen.fallback_count > 0 ? gen.fallback_count : 1);
+    fprintf(source, "};\n\n");
+
+    // The rules can be mutually recursive.
+    for (int i = 0; i < gen.analysis.count; i++)
+    {
+        if (gen.rule_reachable[i])
+        {
+            char * pascal_rule_name = to_pascal_case(gen.analysis.rules[i].name);
+            fprintf(source,
+                    "static epc_parse_result_t parse_%s(direct_state_t * state, epc_parser_ctx_t * ctx, const char * input, direct_cut_t * cut);\n",
+                    pascal_rule_name);
+            free(pascal_rule_name);
+        }
+    }
+    fprintf(source, "\n");
+    fwrite(body_text, 1, body_size, source);
+    free(body_text);
+
+    fprintf(source, "epc_parser_t * create_%s_parser(epc_parser_list * list)\n", base_name);
+    fprintf(source, "{\n");
+    fprintf(source, "    if (list == NULL)\n");
+    fprintf(source, "    {\n");
+    fprintf(source, "        fprintf(stderr, \"Error: Parser list is NULL in create_%s_parser.\\n\");\n", base_name);
+    fprintf(source, "        return NULL;\n");
+    fprintf(source, "    }\n\n");
+    fprintf(source, "    direct_grammar_t * g = calloc(1, sizeof(*g));\n");
+    fprintf(source, "    if (g == NULL)\n");
+    fprintf(source, "    {\n");
+    fprintf(source, "        return NULL;\n");
+    fprintf(source, "    }\n\n");
+    fprintf(source, "    // The top parser owns g.\n");
+    fprintf(source, "    epc_parser_t * parser = epc_direct_l(list, \"%s\", %s, g, free);\n", start_rule_name, start_entry);
+    fprintf(source, "    if (parser == NULL)\n");
+    fprintf(source, "    {\n");
+    fprintf(source, "        return NULL;\n");
+    fprintf(source, "    }\n");
+    if (gen.fallback_count > 0)
+    {
+        fprintf(source, "\n%s", gen.fallbacks_text);
+    }
+    fprintf(source, "\n    return parser;\n");
+    fprintf(source, "}\n");
+    free(start_rule_name);
+    free(start_entry);
+
+    success = gdl_output_file_close(&output, true);
+
+done:
+    if (gen.source != NULL)
+    {
+        fclose(gen.source);
+    }
+    if (gen.fallbacks != NULL)
+    {
+        fclose(gen.fallbacks);
+    }
+    free(gen.fallbacks_text);
+    free(gen.rule_reachable);
+    free(gen.rule_actions);
+    direct_free_entries(gen.entries);
+    free(token_used);
+    gdl_grammar_analysis_free(&gen.analysis);
+    gdl_token_dfa_free(&gen.token_dfa);
+
+    return success;
+}
@@ -0,0 +1,2172 @@
+// Generated source for gdl_generated (static backend)
+#include "gdl_generated.h"
+#include "gdl_generated_actions.h"
+#include <easy_pc/easy_pc.h>
+#include "easy_pc_parser_layout.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+static const epc_parser_t Identifiercontchar;
+static const epc_parser_t Identifier;
+static const epc_parser_t Stringliteral;
+static const epc_parser_t Charliteral;
+static const epc_parser_t Rawchar;
+static const epc_parser_t Numberliteral;
+static const epc_parser_t Terminalnoargkeyword;
+static const epc_parser_t Terminalwithargkeyword;
+static const epc_parser_t Combinatorkeyword;
+static const epc_parser_t Charrange;
+static const epc_parser_t Repetitionoperator;
+static const epc_parser_t Semanticaction;
+static const epc_parser_t Optionalsemanticaction;
+static const epc_parser_t Failcall;
+static const epc_parser_t Cut;
+static const epc_parser_t Terminal;
+static const epc_parser_t Noneofcall;
+static const epc_parser_t Countargs;
+static const epc_parser_t Countcall;
+static const epc_parser_t Betweenargs;
+static const epc_parser_t Betweencall;
+static const epc_parser_t Delimitedargs;
+static const epc_parser_t Delimitedcall;
+static const epc_parser_t Lookaheadcall;
+static const epc_parser_t Notcall;
+static const epc_parser_t Oneofcall;
+static const epc_parser_t Lexemecall;
+static const epc_parser_t Chainargs;
+static const epc_parser_t Chainl1call;
+static const epc_parser_t Chainr1call;
+static const epc_parser_t Skipcall;
+static const epc_parser_t Passthrucall;
+static const epc_parser_t Combinatorcall;
+static const epc_parser_t Parenthesizedexpression;
+static const epc_parser_t Primaryexpression;
+static const epc_parser_t Optionalrepetition;
+static const epc_parser_t Expressionfactor;
+static const epc_parser_t Expressionterm;
+static const epc_parser_t Alternativepart;
+static const epc_parser_t Manyalternatives;
+static const epc_parser_t Definitionexpression;
+static const epc_parser_t Tokenkeywordraw;
+static const epc_parser_t Ruledefinition;
+static const epc_parser_t Manyruledefinitions;
+static const epc_parser_t Program;
+
+// --- Rule: IdentifierContChar ---
+
+static const epc_parser_t Identifiercontchar_1 = {
+    .parse_fn = epc_alpha_parse_fn,
+    .name = "alpha",
+    .expected_value = "alpha",
+};
+
+static const epc_parser_t Identifiercontchar_2 = {
+    .parse_fn = epc_digit_parse_fn,
+    .name = "digit",
+    .expected_value = "digit",
+};
+
+static const epc_parser_t Identifiercontchar_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "_" },
+    .name = "char_parser",
+    .expected_value = "_",
+};
+
+static epc_parser_t * const Identifiercontchar_children[] = {
+    (epc_parser_t *)&Identifiercontchar_1,
+    (epc_parser_t *)&Identifiercontchar_2,
+    (epc_parser_t *)&Identifiercontchar_3,
+};
+
+static const epc_first_set_t Identifiercontchar_first[] = {
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x07, 0xfe, 0xff, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+};
+
+static const epc_parser_list_data_t Identifiercontchar_list = { (epc_parser_t * *)Identifiercontchar_children, 3, Identifiercontchar_first };
+
+static const epc_parser_t Identifiercontchar = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Identifiercontchar_list },
+    .name = "Identifiercontchar",
+};
+
+// --- Rule: Identifier ---
+
+static const epc_parser_t Identifier_1 = {
+    .parse_fn = epc_alpha_parse_fn,
+    .name = "alpha",
+    .expected_value = "alpha",
+};
+
+static const epc_parser_t Identifier_2 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "_" },
+    .name = "char_parser",
+    .expected_value = "_",
+};
+
+static epc_parser_t * const Identifier_3_children[] = {
+    (epc_parser_t *)&Identifier_1,
+    (epc_parser_t *)&Identifier_2,
+};
+
+static const epc_first_set_t Identifier_3_first[] = {
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x07, 0xfe, 0xff, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+};
+
+static const epc_parser_list_data_t Identifier_3_list = { (epc_parser_t * *)Identifier_3_children, 2, Identifier_3_first };
+
+static const epc_parser_t Identifier_3 = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Identifier_3_list },
+    .name = "or_parser",
+};
+
+static const epc_parser_t Identifier_4 = {
+    .parse_fn = epc_many_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Identifiercontchar },
+    .name = "many_parser",
+};
+
+static epc_parser_t * const Identifier_5_children[] = {
+    (epc_parser_t *)&Identifier_3,
+    (epc_parser_t *)&Identifier_4,
+};
+
+static const epc_parser_list_data_t Identifier_5_list = { (epc_parser_t * *)Identifier_5_children, 2, NULL };
+
+static const epc_parser_t Identifier_5 = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Identifier_5_list },
+    .name = "and_parser",
+};
+
+static const epc_parser_t Identifier = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Identifier_5, .consume_comments = true } },
+    .name = "Identifier",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_IDENTIFIER_REF },
+};
+
+// --- Rule: StringLiteral ---
+
+static const epc_parser_t Stringliteral_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\"" },
+    .name = "char_parser",
+    .expected_value = "\"",
+};
+
+static const epc_parser_t Stringliteral_2 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\\\"" },
+    .name = "string_parser",
+    .expected_value = "\\\"",
+};
+
+static const epc_parser_t Stringliteral_3 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\\\\" },
+    .name = "string_parser",
+    .expected_value = "\\\\",
+};
+
+static const epc_parser_t Stringliteral_4 = {
+    .parse_fn = epc_none_of_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\"\\" },
+    .name = "none_of",
+};
+
+static epc_parser_t * const Stringliteral_5_children[] = {
+    (epc_parser_t *)&Stringliteral_2,
+    (epc_parser_t *)&Stringliteral_3,
+    (epc_parser_t *)&Stringliteral_4,
+};
+
+static const epc_parser_list_data_t Stringliteral_5_list = { (epc_parser_t * *)Stringliteral_5_children, 3, NULL };
+
+static const epc_parser_t Stringliteral_5 = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Stringliteral_5_list },
+    .name = "or_parser",
+};
+
+static const epc_parser_t Stringliteral_6 = {
+    .parse_fn = epc_many_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Stringliteral_5 },
+    .name = "many_parser",
+};
+
+static const epc_parser_t Stringliteral_7 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\"" },
+    .name = "char_parser",
+    .expected_value = "\"",
+};
+
+static epc_parser_t * const Stringliteral_8_children[] = {
+    (epc_parser_t *)&Stringliteral_1,
+    (epc_parser_t *)&Stringliteral_6,
+    (epc_parser_t *)&Stringliteral_7,
+};
+
+static const epc_parser_list_data_t Stringliteral_8_list = { (epc_parser_t * *)Stringliteral_8_children, 3, NULL };
+
+static const epc_parser_t Stringliteral_8 = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Stringliteral_8_list },
+    .name = "and_parser",
+};
+
+static const epc_parser_t Stringliteral = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Stringliteral_8, .consume_comments = true } },
+    .name = "Stringliteral",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_STRING_LITERAL },
+};
+
+// --- Rule: CharLiteral ---
+
+static const epc_parser_t Charliteral_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "'" },
+    .name = "string_parser",
+    .expected_value = "'",
+};
+
+static const epc_parser_t Charliteral_2 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\\'" },
+    .name = "string_parser",
+    .expected_value = "\\'",
+};
+
+static const epc_parser_t Charliteral_3 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\\\\" },
+    .name = "string_parser",
+    .expected_value = "\\\\",
+};
+
+static const epc_parser_t Charliteral_4 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\\n" },
+    .name = "string_parser",
+    .expected_value = "\\n",
+};
+
+static const epc_parser_t Charliteral_5 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\\t" },
+    .name = "string_parser",
+    .expected_value = "\\t",
+};
+
+static const epc_parser_t Charliteral_6 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\\r" },
+    .name = "string_parser",
+    .expected_value = "\\r",
+};
+
+static const epc_parser_t Charliteral_7 = {
+    .parse_fn = epc_none_of_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "'\\" },
+    .name = "none_of",
+};
+
+static epc_parser_t * const Charliteral_8_children[] = {
+    (epc_parser_t *)&Charliteral_2,
+    (epc_parser_t *)&Charliteral_3,
+    (epc_parser_t *)&Charliteral_4,
+    (epc_parser_t *)&Charliteral_5,
+    (epc_parser_t *)&Charliteral_6,
+    (epc_parser_t *)&Charliteral_7,
+};
+
+static const epc_parser_list_data_t Charliteral_8_list = { (epc_parser_t * *)Charliteral_8_children, 6, NULL };
+
+static const epc_parser_t Charliteral_8 = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Charliteral_8_list },
+    .name = "or_parser",
+};
+
+static const epc_parser_t Charliteral_9 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "'" },
+    .name = "string_parser",
+    .expected_value = "'",
+};
+
+static epc_parser_t * const Charliteral_10_children[] = {
+    (epc_parser_t *)&Charliteral_1,
+    (epc_parser_t *)&Charliteral_8,
+    (epc_parser_t *)&Charliteral_9,
+};
+
+static const epc_parser_list_data_t Charliteral_10_list = { (epc_parser_t * *)Charliteral_10_children, 3, NULL };
+
+static const epc_parser_t Charliteral_10 = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Charliteral_10_list },
+    .name = "and_parser",
+};
+
+static const epc_parser_t Charliteral = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Charliteral_10, .consume_comments = true } },
+    .name = "Charliteral",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_CHAR_LITERAL },
+};
+
+// --- Rule: RawChar ---
+
+static const epc_parser_t Rawchar_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "\\" },
+    .name = "string_parser",
+    .expected_value = "\\",
+};
+
+static const epc_parser_t Rawchar_2 = {
+    .parse_fn = epc_any_char_parse_fn,
+    .name = "any_char",
+};
+
+static epc_parser_t * const Rawchar_3_children[] = {
+    (epc_parser_t *)&Rawchar_1,
+    (epc_parser_t *)&Rawchar_2,
+};
+
+static const epc_parser_list_data_t Rawchar_3_list = { (epc_parser_t * *)Rawchar_3_children, 2, NULL };
+
+static const epc_parser_t Rawchar_3 = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Rawchar_3_list },
+    .name = "and_parser",
+};
+
+static const epc_parser_t Rawchar_4 = {
+    .parse_fn = epc_none_of_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "[]\\;=,()" },
+    .name = "none_of",
+};
+
+static epc_parser_t * const Rawchar_5_children[] = {
+    (epc_parser_t *)&Rawchar_3,
+    (epc_parser_t *)&Rawchar_4,
+};
+
+static const epc_parser_list_data_t Rawchar_5_list = { (epc_parser_t * *)Rawchar_5_children, 2, NULL };
+
+static const epc_parser_t Rawchar_5 = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Rawchar_5_list },
+    .name = "or_parser",
+};
+
+static const epc_parser_t Rawchar = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Rawchar_5, .consume_comments = true } },
+    .name = "Rawchar",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_RAW_CHAR_LITERAL },
+};
+
+// --- Rule: NumberLiteral ---
+
+static const epc_parser_t Numberliteral_1 = {
+    .parse_fn = epc_digit_parse_fn,
+    .name = "digit",
+    .expected_value = "digit",
+};
+
+static const epc_parser_t Numberliteral_2 = {
+    .parse_fn = epc_plus_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Numberliteral_1 },
+    .name = "plus_parser",
+};
+
+static const epc_parser_t Numberliteral = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Numberliteral_2, .consume_comments = true } },
+    .name = "Numberliteral",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_NUMBER_LITERAL },
+};
+
+// --- Rule: TerminalNoArgKeyword ---
+
+static const epc_parser_t Terminalnoargkeyword_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "char" },
+    .name = "string_parser",
+    .expected_value = "char",
+};
+
+static const epc_parser_t Terminalnoargkeyword_2 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "digit" },
+    .name = "string_parser",
+    .expected_value = "digit",
+};
+
+static const epc_parser_t Terminalnoargkeyword_3 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "alphanum" },
+    .name = "string_parser",
+    .expected_value = "alphanum",
+};
+
+static const epc_parser_t Terminalnoargkeyword_4 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "alpha" },
+    .name = "string_parser",
+    .expected_value = "alpha",
+};
+
+static const epc_parser_t Terminalnoargkeyword_5 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "int" },
+    .name = "string_parser",
+    .expected_value = "int",
+};
+
+static const epc_parser_t Terminalnoargkeyword_6 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "double" },
+    .name = "string_parser",
+    .expected_value = "double",
+};
+
+static const epc_parser_t Terminalnoargkeyword_7 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "space" },
+    .name = "string_parser",
+    .expected_value = "space",
+};
+
+static const epc_parser_t Terminalnoargkeyword_8 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "any_char" },
+    .name = "string_parser",
+    .expected_value = "any_char",
+};
+
+static const epc_parser_t Terminalnoargkeyword_9 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "succeed" },
+    .name = "string_parser",
+    .expected_value = "succeed",
+};
+
+static const epc_parser_t Terminalnoargkeyword_10 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "hex_digit" },
+    .name = "string_parser",
+    .expected_value = "hex_digit",
+};
+
+static const epc_parser_t Terminalnoargkeyword_11 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "eoi" },
+    .name = "string_parser",
+    .expected_value = "eoi",
+};
+
+static epc_parser_t * const Terminalnoargkeyword_children[] = {
+    (epc_parser_t *)&Terminalnoargkeyword_1,
+    (epc_parser_t *)&Terminalnoargkeyword_2,
+    (epc_parser_t *)&Terminalnoargkeyword_3,
+    (epc_parser_t *)&Terminalnoargkeyword_4,
+    (epc_parser_t *)&Terminalnoargkeyword_5,
+    (epc_parser_t *)&Terminalnoargkeyword_6,
+    (epc_parser_t *)&Terminalnoargkeyword_7,
+    (epc_parser_t *)&Terminalnoargkeyword_8,
+    (epc_parser_t *)&Terminalnoargkeyword_9,
+    (epc_parser_t *)&Terminalnoargkeyword_10,
+    (epc_parser_t *)&Terminalnoargkeyword_11,
+};
+
+static const epc_first_set_t Terminalnoargkeyword_first[] = {
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+};
+
+static const epc_parser_list_data_t Terminalnoargkeyword_list = { (epc_parser_t * *)Terminalnoargkeyword_children, 11, Terminalnoargkeyword_first };
+
+static const epc_parser_t Terminalnoargkeyword = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Terminalnoargkeyword_list },
+    .name = "Terminalnoargkeyword",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_KEYWORD },
+};
+
+// --- Rule: TerminalWithArgKeyword ---
+
+static const epc_parser_t Terminalwithargkeyword = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "fail" },
+    .name = "Terminalwithargkeyword",
+    .expected_value = "fail",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_KEYWORD },
+};
+
+// --- Rule: CombinatorKeyword ---
+
+static const epc_parser_t Combinatorkeyword_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "string" },
+    .name = "string_parser",
+    .expected_value = "string",
+};
+
+static const epc_parser_t Combinatorkeyword_2 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "char_range" },
+    .name = "string_parser",
+    .expected_value = "char_range",
+};
+
+static const epc_parser_t Combinatorkeyword_3 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "noneof" },
+    .name = "string_parser",
+    .expected_value = "noneof",
+};
+
+static const epc_parser_t Combinatorkeyword_4 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "many" },
+    .name = "string_parser",
+    .expected_value = "many",
+};
+
+static const epc_parser_t Combinatorkeyword_5 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "count" },
+    .name = "string_parser",
+    .expected_value = "count",
+};
+
+static const epc_parser_t Combinatorkeyword_6 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "between" },
+    .name = "string_parser",
+    .expected_value = "between",
+};
+
+static const epc_parser_t Combinatorkeyword_7 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "delimited" },
+    .name = "string_parser",
+    .expected_value = "delimited",
+};
+
+static const epc_parser_t Combinatorkeyword_8 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "optional" },
+    .name = "string_parser",
+    .expected_value = "optional",
+};
+
+static const epc_parser_t Combinatorkeyword_9 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "lookahead" },
+    .name = "string_parser",
+    .expected_value = "lookahead",
+};
+
+static const epc_parser_t Combinatorkeyword_10 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "not" },
+    .name = "string_parser",
+    .expected_value = "not",
+};
+
+static const epc_parser_t Combinatorkeyword_11 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "oneof" },
+    .name = "string_parser",
+    .expected_value = "oneof",
+};
+
+static const epc_parser_t Combinatorkeyword_12 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "lexeme" },
+    .name = "string_parser",
+    .expected_value = "lexeme",
+};
+
+static const epc_parser_t Combinatorkeyword_13 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "chainl1" },
+    .name = "string_parser",
+    .expected_value = "chainl1",
+};
+
+static const epc_parser_t Combinatorkeyword_14 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "chainr1" },
+    .name = "string_parser",
+    .expected_value = "chainr1",
+};
+
+static const epc_parser_t Combinatorkeyword_15 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "skip" },
+    .name = "string_parser",
+    .expected_value = "skip",
+};
+
+static const epc_parser_t Combinatorkeyword_16 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "passthru" },
+    .name = "string_parser",
+    .expected_value = "passthru",
+};
+
+static epc_parser_t * const Combinatorkeyword_children[] = {
+    (epc_parser_t *)&Combinatorkeyword_1,
+    (epc_parser_t *)&Combinatorkeyword_2,
+    (epc_parser_t *)&Combinatorkeyword_3,
+    (epc_parser_t *)&Combinatorkeyword_4,
+    (epc_parser_t *)&Combinatorkeyword_5,
+    (epc_parser_t *)&Combinatorkeyword_6,
+    (epc_parser_t *)&Combinatorkeyword_7,
+    (epc_parser_t *)&Combinatorkeyword_8,
+    (epc_parser_t *)&Combinatorkeyword_9,
+    (epc_parser_t *)&Combinatorkeyword_10,
+    (epc_parser_t *)&Combinatorkeyword_11,
+    (epc_parser_t *)&Combinatorkeyword_12,
+    (epc_parser_t *)&Combinatorkeyword_13,
+    (epc_parser_t *)&Combinatorkeyword_14,
+    (epc_parser_t *)&Combinatorkeyword_15,
+    (epc_parser_t *)&Combinatorkeyword_16,
+};
+
+static const epc_first_set_t Combinatorkeyword_first[] = {
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+};
+
+static const epc_parser_list_data_t Combinatorkeyword_list = { (epc_parser_t * *)Combinatorkeyword_children, 16, Combinatorkeyword_first };
+
+static const epc_parser_t Combinatorkeyword = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Combinatorkeyword_list },
+    .name = "Combinatorkeyword",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_KEYWORD },
+};
+
+// --- Rule: CharRange ---
+
+static const epc_parser_t Charrange_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "[" },
+    .name = "char_parser",
+    .expected_value = "[",
+};
+
+static const epc_parser_t Charrange_2 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "-" },
+    .name = "char_parser",
+    .expected_value = "-",
+};
+
+static const epc_parser_t Charrange_3 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Charrange_2, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Charrange_4 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "]" },
+    .name = "char_parser",
+    .expected_value = "]",
+};
+
+static epc_parser_t * const Charrange_5_children[] = {
+    (epc_parser_t *)&Charrange_1,
+    (epc_parser_t *)&Rawchar,
+    (epc_parser_t *)&Charrange_3,
+    (epc_parser_t *)&Rawchar,
+    (epc_parser_t *)&Charrange_4,
+};
+
+static const epc_parser_list_data_t Charrange_5_list = { (epc_parser_t * *)Charrange_5_children, 5, NULL };
+
+static const epc_parser_t Charrange_5 = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Charrange_5_list },
+    .name = "and_parser",
+};
+
+static const epc_parser_t Charrange = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Charrange_5, .consume_comments = true } },
+    .name = "Charrange",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_CHAR_RANGE },
+};
+
+// --- Rule: RepetitionOperator ---
+
+static const epc_parser_t Repetitionoperator_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "*" },
+    .name = "char_parser",
+    .expected_value = "*",
+};
+
+static const epc_parser_t Repetitionoperator_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Repetitionoperator_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Repetitionoperator_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "+" },
+    .name = "char_parser",
+    .expected_value = "+",
+};
+
+static const epc_parser_t Repetitionoperator_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Repetitionoperator_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Repetitionoperator_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "?" },
+    .name = "char_parser",
+    .expected_value = "?",
+};
+
+static const epc_parser_t Repetitionoperator_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Repetitionoperator_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Repetitionoperator_7_children[] = {
+    (epc_parser_t *)&Repetitionoperator_2,
+    (epc_parser_t *)&Repetitionoperator_4,
+    (epc_parser_t *)&Repetitionoperator_6,
+};
+
+static const epc_first_set_t Repetitionoperator_7_first[] = {
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+};
+
+static const epc_parser_list_data_t Repetitionoperator_7_list = { (epc_parser_t * *)Repetitionoperator_7_children, 3, Repetitionoperator_7_first };
+
+static const epc_parser_t Repetitionoperator_7 = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Repetitionoperator_7_list },
+    .name = "or_parser",
+};
+
+static const epc_parser_t Repetitionoperator = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Repetitionoperator_7, .consume_comments = true } },
+    .name = "Repetitionoperator",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_REPETITION_OPERATOR },
+};
+
+// --- Rule: SemanticAction ---
+
+static const epc_parser_t Semanticaction_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "@" },
+    .name = "char_parser",
+    .expected_value = "@",
+};
+
+static const epc_parser_t Semanticaction_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Semanticaction_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Semanticaction_children[] = {
+    (epc_parser_t *)&Semanticaction_2,
+    (epc_parser_t *)&Identifier,
+};
+
+static const epc_parser_list_data_t Semanticaction_list = { (epc_parser_t * *)Semanticaction_children, 2, NULL };
+
+static const epc_parser_t Semanticaction = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Semanticaction_list },
+    .name = "Semanticaction",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_SEMANTIC_ACTION },
+};
+
+// --- Rule: OptionalSemanticAction ---
+
+static const epc_parser_t Optionalsemanticaction = {
+    .parse_fn = epc_optional_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Semanticaction },
+    .name = "Optionalsemanticaction",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_OPTIONAL_SEMANTIC_ACTION },
+};
+
+// --- Rule: FailCall ---
+
+static const epc_parser_t Failcall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "fail" },
+    .name = "string_parser",
+    .expected_value = "fail",
+};
+
+static const epc_parser_t Failcall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Failcall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Failcall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Failcall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Failcall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Failcall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Failcall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Failcall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Failcall_children[] = {
+    (epc_parser_t *)&Failcall_2,
+    (epc_parser_t *)&Failcall_4,
+    (epc_parser_t *)&Stringliteral,
+    (epc_parser_t *)&Failcall_6,
+};
+
+static const epc_parser_list_data_t Failcall_list = { (epc_parser_t * *)Failcall_children, 4, NULL };
+
+static const epc_parser_t Failcall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Failcall_list },
+    .name = "Failcall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_FAIL_CALL },
+};
+
+// --- Rule: Cut ---
+
+static const epc_parser_t Cut_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "~" },
+    .name = "char_parser",
+    .expected_value = "~",
+};
+
+static const epc_parser_t Cut = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Cut_1, .consume_comments = true } },
+    .name = "Cut",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_KEYWORD },
+};
+
+// --- Rule: Terminal ---
+
+static const epc_parser_t Terminal_1 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Terminalnoargkeyword, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Terminal_2_children[] = {
+    (epc_parser_t *)&Terminalnoargkeyword,
+    (epc_parser_t *)&Terminalwithargkeyword,
+    (epc_parser_t *)&Combinatorkeyword,
+};
+
+static const epc_first_set_t Terminal_2_first[] = {
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3a, 0x03, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0xf0, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+};
+
+static const epc_parser_list_data_t Terminal_2_list = { (epc_parser_t * *)Terminal_2_children, 3, Terminal_2_first };
+
+static const epc_parser_t Terminal_2 = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Terminal_2_list },
+    .name = "or_parser",
+};
+
+static const epc_parser_t Terminal_3 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Terminal_2, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Terminal_4 = {
+    .parse_fn = epc_not_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Terminal_3 },
+    .name = "not_parser",
+};
+
+static epc_parser_t * const Terminal_5_children[] = {
+    (epc_parser_t *)&Terminal_4,
+    (epc_parser_t *)&Identifier,
+};
+
+static const epc_parser_list_data_t Terminal_5_list = { (epc_parser_t * *)Terminal_5_children, 2, NULL };
+
+static const epc_parser_t Terminal_5 = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Terminal_5_list },
+    .name = "and_parser",
+};
+
+static const epc_parser_t Terminal_6 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "double" },
+    .name = "string_parser",
+    .expected_value = "double",
+};
+
+static const epc_parser_t Terminal_7 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Terminal_6, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Terminal_children[] = {
+    (epc_parser_t *)&Stringliteral,
+    (epc_parser_t *)&Charliteral,
+    (epc_parser_t *)&Terminal_1,
+    (epc_parser_t *)&Failcall,
+    (epc_parser_t *)&Cut,
+    (epc_parser_t *)&Terminal_5,
+    (epc_parser_t *)&Terminal_7,
+};
+
+static const epc_first_set_t Terminal_first[] = {
+    { { 0x00, 0x3e, 0x00, 0x00, 0x05, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x81, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3a, 0x03, 0x08, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x87, 0xfe, 0xff, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+};
+
+static const epc_parser_list_data_t Terminal_list = { (epc_parser_t * *)Terminal_children, 7, Terminal_first };
+
+static const epc_parser_t Terminal = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Terminal_list },
+    .name = "Terminal",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_TERMINAL },
+};
+
+// --- Rule: NoneofCall ---
+
+static const epc_parser_t Noneofcall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "noneof" },
+    .name = "string_parser",
+    .expected_value = "noneof",
+};
+
+static const epc_parser_t Noneofcall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Noneofcall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Noneofcall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Noneofcall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Noneofcall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Noneofcall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Noneofcall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Noneofcall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Noneofcall_children[] = {
+    (epc_parser_t *)&Noneofcall_2,
+    (epc_parser_t *)&Noneofcall_4,
+    (epc_parser_t *)&Stringliteral,
+    (epc_parser_t *)&Noneofcall_6,
+};
+
+static const epc_parser_list_data_t Noneofcall_list = { (epc_parser_t * *)Noneofcall_children, 4, NULL };
+
+static const epc_parser_t Noneofcall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Noneofcall_list },
+    .name = "Noneofcall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_NONEOF_CALL },
+};
+
+// --- Rule: CountArgs ---
+
+static const epc_parser_t Countargs_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "," },
+    .name = "char_parser",
+    .expected_value = ",",
+};
+
+static const epc_parser_t Countargs_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Countargs_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Countargs_children[] = {
+    (epc_parser_t *)&Numberliteral,
+    (epc_parser_t *)&Countargs_2,
+    (epc_parser_t *)&Definitionexpression,
+};
+
+static const epc_parser_list_data_t Countargs_list = { (epc_parser_t * *)Countargs_children, 3, NULL };
+
+static const epc_parser_t Countargs = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Countargs_list },
+    .name = "Countargs",
+};
+
+// --- Rule: CountCall ---
+
+static const epc_parser_t Countcall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "count" },
+    .name = "string_parser",
+    .expected_value = "count",
+};
+
+static const epc_parser_t Countcall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Countcall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Countcall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Countcall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Countcall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Countcall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Countcall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Countcall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Countcall_children[] = {
+    (epc_parser_t *)&Countcall_2,
+    (epc_parser_t *)&Countcall_4,
+    (epc_parser_t *)&Countargs,
+    (epc_parser_t *)&Countcall_6,
+};
+
+static const epc_parser_list_data_t Countcall_list = { (epc_parser_t * *)Countcall_children, 4, NULL };
+
+static const epc_parser_t Countcall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Countcall_list },
+    .name = "Countcall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_COUNT_CALL },
+};
+
+// --- Rule: BetweenArgs ---
+
+static const epc_parser_t Betweenargs_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "," },
+    .name = "char_parser",
+    .expected_value = ",",
+};
+
+static const epc_parser_t Betweenargs_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Betweenargs_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Betweenargs_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "," },
+    .name = "char_parser",
+    .expected_value = ",",
+};
+
+static const epc_parser_t Betweenargs_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Betweenargs_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Betweenargs_children[] = {
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Betweenargs_2,
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Betweenargs_4,
+    (epc_parser_t *)&Definitionexpression,
+};
+
+static const epc_parser_list_data_t Betweenargs_list = { (epc_parser_t * *)Betweenargs_children, 5, NULL };
+
+static const epc_parser_t Betweenargs = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Betweenargs_list },
+    .name = "Betweenargs",
+};
+
+// --- Rule: BetweenCall ---
+
+static const epc_parser_t Betweencall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "between" },
+    .name = "string_parser",
+    .expected_value = "between",
+};
+
+static const epc_parser_t Betweencall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Betweencall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Betweencall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Betweencall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Betweencall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Betweencall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Betweencall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Betweencall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Betweencall_children[] = {
+    (epc_parser_t *)&Betweencall_2,
+    (epc_parser_t *)&Betweencall_4,
+    (epc_parser_t *)&Betweenargs,
+    (epc_parser_t *)&Betweencall_6,
+};
+
+static const epc_parser_list_data_t Betweencall_list = { (epc_parser_t * *)Betweencall_children, 4, NULL };
+
+static const epc_parser_t Betweencall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Betweencall_list },
+    .name = "Betweencall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_BETWEEN_CALL },
+};
+
+// --- Rule: DelimitedArgs ---
+
+static const epc_parser_t Delimitedargs_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "," },
+    .name = "char_parser",
+    .expected_value = ",",
+};
+
+static const epc_parser_t Delimitedargs_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Delimitedargs_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Delimitedargs_children[] = {
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Delimitedargs_2,
+    (epc_parser_t *)&Definitionexpression,
+};
+
+static const epc_parser_list_data_t Delimitedargs_list = { (epc_parser_t * *)Delimitedargs_children, 3, NULL };
+
+static const epc_parser_t Delimitedargs = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Delimitedargs_list },
+    .name = "Delimitedargs",
+};
+
+// --- Rule: DelimitedCall ---
+
+static const epc_parser_t Delimitedcall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "delimited" },
+    .name = "string_parser",
+    .expected_value = "delimited",
+};
+
+static const epc_parser_t Delimitedcall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Delimitedcall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Delimitedcall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Delimitedcall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Delimitedcall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Delimitedcall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Delimitedcall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Delimitedcall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Delimitedcall_children[] = {
+    (epc_parser_t *)&Delimitedcall_2,
+    (epc_parser_t *)&Delimitedcall_4,
+    (epc_parser_t *)&Delimitedargs,
+    (epc_parser_t *)&Delimitedcall_6,
+};
+
+static const epc_parser_list_data_t Delimitedcall_list = { (epc_parser_t * *)Delimitedcall_children, 4, NULL };
+
+static const epc_parser_t Delimitedcall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Delimitedcall_list },
+    .name = "Delimitedcall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_DELIMITED_CALL },
+};
+
+// --- Rule: LookaheadCall ---
+
+static const epc_parser_t Lookaheadcall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "lookahead" },
+    .name = "string_parser",
+    .expected_value = "lookahead",
+};
+
+static const epc_parser_t Lookaheadcall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Lookaheadcall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Lookaheadcall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Lookaheadcall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Lookaheadcall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Lookaheadcall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Lookaheadcall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Lookaheadcall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Lookaheadcall_children[] = {
+    (epc_parser_t *)&Lookaheadcall_2,
+    (epc_parser_t *)&Lookaheadcall_4,
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Lookaheadcall_6,
+};
+
+static const epc_parser_list_data_t Lookaheadcall_list = { (epc_parser_t * *)Lookaheadcall_children, 4, NULL };
+
+static const epc_parser_t Lookaheadcall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Lookaheadcall_list },
+    .name = "Lookaheadcall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_LOOKAHEAD_CALL },
+};
+
+// --- Rule: NotCall ---
+
+static const epc_parser_t Notcall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "not" },
+    .name = "string_parser",
+    .expected_value = "not",
+};
+
+static const epc_parser_t Notcall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Notcall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Notcall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Notcall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Notcall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Notcall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Notcall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Notcall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Notcall_children[] = {
+    (epc_parser_t *)&Notcall_2,
+    (epc_parser_t *)&Notcall_4,
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Notcall_6,
+};
+
+static const epc_parser_list_data_t Notcall_list = { (epc_parser_t * *)Notcall_children, 4, NULL };
+
+static const epc_parser_t Notcall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Notcall_list },
+    .name = "Notcall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_NOT_CALL },
+};
+
+// --- Rule: OneofCall ---
+
+static const epc_parser_t Oneofcall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "oneof" },
+    .name = "string_parser",
+    .expected_value = "oneof",
+};
+
+static const epc_parser_t Oneofcall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Oneofcall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Oneofcall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Oneofcall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Oneofcall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Oneofcall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Oneofcall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Oneofcall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Oneofcall_children[] = {
+    (epc_parser_t *)&Oneofcall_2,
+    (epc_parser_t *)&Oneofcall_4,
+    (epc_parser_t *)&Stringliteral,
+    (epc_parser_t *)&Oneofcall_6,
+};
+
+static const epc_parser_list_data_t Oneofcall_list = { (epc_parser_t * *)Oneofcall_children, 4, NULL };
+
+static const epc_parser_t Oneofcall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Oneofcall_list },
+    .name = "Oneofcall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_ONEOF_CALL },
+};
+
+// --- Rule: LexemeCall ---
+
+static const epc_parser_t Lexemecall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "lexeme" },
+    .name = "string_parser",
+    .expected_value = "lexeme",
+};
+
+static const epc_parser_t Lexemecall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Lexemecall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Lexemecall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Lexemecall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Lexemecall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Lexemecall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Lexemecall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Lexemecall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Lexemecall_children[] = {
+    (epc_parser_t *)&Lexemecall_2,
+    (epc_parser_t *)&Lexemecall_4,
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Lexemecall_6,
+};
+
+static const epc_parser_list_data_t Lexemecall_list = { (epc_parser_t * *)Lexemecall_children, 4, NULL };
+
+static const epc_parser_t Lexemecall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Lexemecall_list },
+    .name = "Lexemecall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_LEXEME_CALL },
+};
+
+// --- Rule: ChainArgs ---
+
+static const epc_parser_t Chainargs_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "," },
+    .name = "char_parser",
+    .expected_value = ",",
+};
+
+static const epc_parser_t Chainargs_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Chainargs_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Chainargs_children[] = {
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Chainargs_2,
+    (epc_parser_t *)&Definitionexpression,
+};
+
+static const epc_parser_list_data_t Chainargs_list = { (epc_parser_t * *)Chainargs_children, 3, NULL };
+
+static const epc_parser_t Chainargs = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Chainargs_list },
+    .name = "Chainargs",
+};
+
+// --- Rule: ChainL1Call ---
+
+static const epc_parser_t Chainl1call_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "chainl1" },
+    .name = "string_parser",
+    .expected_value = "chainl1",
+};
+
+static const epc_parser_t Chainl1call_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Chainl1call_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Chainl1call_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Chainl1call_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Chainl1call_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Chainl1call_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Chainl1call_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Chainl1call_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Chainl1call_children[] = {
+    (epc_parser_t *)&Chainl1call_2,
+    (epc_parser_t *)&Chainl1call_4,
+    (epc_parser_t *)&Chainargs,
+    (epc_parser_t *)&Chainl1call_6,
+};
+
+static const epc_parser_list_data_t Chainl1call_list = { (epc_parser_t * *)Chainl1call_children, 4, NULL };
+
+static const epc_parser_t Chainl1call = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Chainl1call_list },
+    .name = "Chainl1call",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_CHAINL1_CALL },
+};
+
+// --- Rule: ChainR1Call ---
+
+static const epc_parser_t Chainr1call_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "chainr1" },
+    .name = "string_parser",
+    .expected_value = "chainr1",
+};
+
+static const epc_parser_t Chainr1call_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Chainr1call_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Chainr1call_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Chainr1call_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Chainr1call_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Chainr1call_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Chainr1call_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Chainr1call_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Chainr1call_children[] = {
+    (epc_parser_t *)&Chainr1call_2,
+    (epc_parser_t *)&Chainr1call_4,
+    (epc_parser_t *)&Chainargs,
+    (epc_parser_t *)&Chainr1call_6,
+};
+
+static const epc_parser_list_data_t Chainr1call_list = { (epc_parser_t * *)Chainr1call_children, 4, NULL };
+
+static const epc_parser_t Chainr1call = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Chainr1call_list },
+    .name = "Chainr1call",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_CHAINR1_CALL },
+};
+
+// --- Rule: SkipCall ---
+
+static const epc_parser_t Skipcall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "skip" },
+    .name = "string_parser",
+    .expected_value = "skip",
+};
+
+static const epc_parser_t Skipcall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Skipcall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Skipcall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Skipcall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Skipcall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Skipcall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Skipcall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Skipcall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Skipcall_children[] = {
+    (epc_parser_t *)&Skipcall_2,
+    (epc_parser_t *)&Skipcall_4,
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Skipcall_6,
+};
+
+static const epc_parser_list_data_t Skipcall_list = { (epc_parser_t * *)Skipcall_children, 4, NULL };
+
+static const epc_parser_t Skipcall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Skipcall_list },
+    .name = "Skipcall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_SKIP_CALL },
+};
+
+// --- Rule: PassthruCall ---
+
+static const epc_parser_t Passthrucall_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "passthru" },
+    .name = "string_parser",
+    .expected_value = "passthru",
+};
+
+static const epc_parser_t Passthrucall_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Passthrucall_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Passthrucall_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Passthrucall_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Passthrucall_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Passthrucall_5 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Passthrucall_6 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Passthrucall_5, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Passthrucall_children[] = {
+    (epc_parser_t *)&Passthrucall_2,
+    (epc_parser_t *)&Passthrucall_4,
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Passthrucall_6,
+};
+
+static const epc_parser_list_data_t Passthrucall_list = { (epc_parser_t * *)Passthrucall_children, 4, NULL };
+
+static const epc_parser_t Passthrucall = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Passthrucall_list },
+    .name = "Passthrucall",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_PASSTHRU_CALL },
+};
+
+// --- Rule: CombinatorCall ---
+
+static epc_parser_t * const Combinatorcall_children[] = {
+    (epc_parser_t *)&Noneofcall,
+    (epc_parser_t *)&Countcall,
+    (epc_parser_t *)&Betweencall,
+    (epc_parser_t *)&Delimitedcall,
+    (epc_parser_t *)&Lookaheadcall,
+    (epc_parser_t *)&Notcall,
+    (epc_parser_t *)&Failcall,
+    (epc_parser_t *)&Oneofcall,
+    (epc_parser_t *)&Lexemecall,
+    (epc_parser_t *)&Chainl1call,
+    (epc_parser_t *)&Chainr1call,
+    (epc_parser_t *)&Skipcall,
+    (epc_parser_t *)&Passthrucall,
+};
+
+static const epc_first_set_t Combinatorcall_first[] = {
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+};
+
+static const epc_parser_list_data_t Combinatorcall_list = { (epc_parser_t * *)Combinatorcall_children, 13, Combinatorcall_first };
+
+static const epc_parser_t Combinatorcall = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Combinatorcall_list },
+    .name = "Combinatorcall",
+};
+
+// --- Rule: ParenthesizedExpression ---
+
+static const epc_parser_t Parenthesizedexpression_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "(" },
+    .name = "char_parser",
+    .expected_value = "(",
+};
+
+static const epc_parser_t Parenthesizedexpression_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Parenthesizedexpression_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Parenthesizedexpression_3 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ")" },
+    .name = "char_parser",
+    .expected_value = ")",
+};
+
+static const epc_parser_t Parenthesizedexpression_4 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Parenthesizedexpression_3, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Parenthesizedexpression_children[] = {
+    (epc_parser_t *)&Parenthesizedexpression_2,
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Parenthesizedexpression_4,
+};
+
+static const epc_parser_list_data_t Parenthesizedexpression_list = { (epc_parser_t * *)Parenthesizedexpression_children, 3, NULL };
+
+static const epc_parser_t Parenthesizedexpression = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Parenthesizedexpression_list },
+    .name = "Parenthesizedexpression",
+};
+
+// --- Rule: PrimaryExpression ---
+
+static epc_parser_t * const Primaryexpression_children[] = {
+    (epc_parser_t *)&Combinatorcall,
+    (epc_parser_t *)&Terminal,
+    (epc_parser_t *)&Charrange,
+    (epc_parser_t *)&Parenthesizedexpression,
+    (epc_parser_t *)&Numberliteral,
+};
+
+static const epc_first_set_t Primaryexpression_first[] = {
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5c, 0xd0, 0x09, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x85, 0x80, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x87, 0xfe, 0xff, 0xff, 0x47, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+};
+
+static const epc_parser_list_data_t Primaryexpression_list = { (epc_parser_t * *)Primaryexpression_children, 5, Primaryexpression_first };
+
+static const epc_parser_t Primaryexpression = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Primaryexpression_list },
+    .name = "Primaryexpression",
+};
+
+// --- Rule: OptionalRepetition ---
+
+static const epc_parser_t Optionalrepetition = {
+    .parse_fn = epc_optional_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Repetitionoperator },
+    .name = "Optionalrepetition",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_OPTIONAL },
+};
+
+// --- Rule: ExpressionFactor ---
+
+static epc_parser_t * const Expressionfactor_children[] = {
+    (epc_parser_t *)&Primaryexpression,
+    (epc_parser_t *)&Optionalrepetition,
+};
+
+static const epc_parser_list_data_t Expressionfactor_list = { (epc_parser_t * *)Expressionfactor_children, 2, NULL };
+
+static const epc_parser_t Expressionfactor = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Expressionfactor_list },
+    .name = "Expressionfactor",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_EXPRESSION_FACTOR },
+};
+
+// --- Rule: ExpressionTerm ---
+
+static const epc_parser_t Expressionterm = {
+    .parse_fn = epc_plus_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Expressionfactor },
+    .name = "Expressionterm",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_SEQUENCE },
+};
+
+// --- Rule: AlternativePart ---
+
+static const epc_parser_t Alternativepart_1 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "|" },
+    .name = "char_parser",
+    .expected_value = "|",
+};
+
+static const epc_parser_t Alternativepart_2 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Alternativepart_1, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Alternativepart_children[] = {
+    (epc_parser_t *)&Alternativepart_2,
+    (epc_parser_t *)&Expressionterm,
+};
+
+static const epc_parser_list_data_t Alternativepart_list = { (epc_parser_t * *)Alternativepart_children, 2, NULL };
+
+static const epc_parser_t Alternativepart = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Alternativepart_list },
+    .name = "Alternativepart",
+};
+
+// --- Rule: ManyAlternatives ---
+
+static const epc_parser_t Manyalternatives = {
+    .parse_fn = epc_many_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Alternativepart },
+    .name = "Manyalternatives",
+};
+
+// --- Rule: DefinitionExpression ---
+
+static epc_parser_t * const Definitionexpression_children[] = {
+    (epc_parser_t *)&Expressionterm,
+    (epc_parser_t *)&Manyalternatives,
+};
+
+static const epc_parser_list_data_t Definitionexpression_list = { (epc_parser_t * *)Definitionexpression_children, 2, NULL };
+
+static const epc_parser_t Definitionexpression = {
+    .parse_fn = epc_rule_parse_fn,
+    .rule_parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Definitionexpression_list },
+    .name = "Definitionexpression",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_ALTERNATIVE },
+};
+
+// --- Rule: TokenKeywordRaw ---
+
+static const epc_parser_t Tokenkeywordraw_1 = {
+    .parse_fn = epc_string_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "token" },
+    .name = "string_parser",
+    .expected_value = "token",
+};
+
+static const epc_parser_t Tokenkeywordraw_2 = {
+    .parse_fn = epc_not_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Identifiercontchar },
+    .name = "not_parser",
+};
+
+static epc_parser_t * const Tokenkeywordraw_children[] = {
+    (epc_parser_t *)&Tokenkeywordraw_1,
+    (epc_parser_t *)&Tokenkeywordraw_2,
+};
+
+static const epc_parser_list_data_t Tokenkeywordraw_list = { (epc_parser_t * *)Tokenkeywordraw_children, 2, NULL };
+
+static const epc_parser_t Tokenkeywordraw = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Tokenkeywordraw_list },
+    .name = "Tokenkeywordraw",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_KEYWORD },
+};
+
+// --- Rule: RuleDefinition ---
+
+static const epc_parser_t Ruledefinition_1 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Tokenkeywordraw, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Ruledefinition_2_children[] = {
+    (epc_parser_t *)&Ruledefinition_1,
+    (epc_parser_t *)&Identifier,
+};
+
+static const epc_parser_list_data_t Ruledefinition_2_list = { (epc_parser_t * *)Ruledefinition_2_children, 2, NULL };
+
+static const epc_parser_t Ruledefinition_2 = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Ruledefinition_2_list },
+    .name = "and_parser",
+};
+
+static epc_parser_t * const Ruledefinition_3_children[] = {
+    (epc_parser_t *)&Ruledefinition_2,
+    (epc_parser_t *)&Identifier,
+};
+
+static const epc_first_set_t Ruledefinition_3_first[] = {
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+    { { 0x00, 0x3e, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0xfe, 0xff, 0xff, 0x87, 0xfe, 0xff, 0xff, 0x07, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } },
+};
+
+static const epc_parser_list_data_t Ruledefinition_3_list = { (epc_parser_t * *)Ruledefinition_3_children, 2, Ruledefinition_3_first };
+
+static const epc_parser_t Ruledefinition_3 = {
+    .parse_fn = epc_or_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Ruledefinition_3_list },
+    .name = "or_parser",
+};
+
+static const epc_parser_t Ruledefinition_4 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = "=" },
+    .name = "char_parser",
+    .expected_value = "=",
+};
+
+static const epc_parser_t Ruledefinition_5 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Ruledefinition_4, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static const epc_parser_t Ruledefinition_6 = {
+    .parse_fn = epc_char_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_STRING, .string = ";" },
+    .name = "char_parser",
+    .expected_value = ";",
+};
+
+static const epc_parser_t Ruledefinition_7 = {
+    .parse_fn = epc_lexeme_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&Ruledefinition_6, .consume_comments = true } },
+    .name = "lexeme_parser",
+};
+
+static epc_parser_t * const Ruledefinition_children[] = {
+    (epc_parser_t *)&Ruledefinition_3,
+    (epc_parser_t *)&Ruledefinition_5,
+    (epc_parser_t *)&Definitionexpression,
+    (epc_parser_t *)&Optionalsemanticaction,
+    (epc_parser_t *)&Ruledefinition_7,
+};
+
+static const epc_parser_list_data_t Ruledefinition_list = { (epc_parser_t * *)Ruledefinition_children, 5, NULL };
+
+static const epc_parser_t Ruledefinition = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Ruledefinition_list },
+    .name = "Ruledefinition",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_RULE_DEFINITION },
+};
+
+// --- Rule: ManyRuleDefinitions ---
+
+static const epc_parser_t Manyruledefinitions = {
+    .parse_fn = epc_plus_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&Ruledefinition },
+    .name = "Manyruledefinitions",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_SEQUENCE },
+};
+
+// --- Rule: Program ---
+
+static const epc_parser_t Program_1 = {
+    .parse_fn = epc_eoi_parse_fn,
+    .name = "eoi",
+};
+
+static epc_parser_t * const Program_children[] = {
+    (epc_parser_t *)&Manyruledefinitions,
+    (epc_parser_t *)&Program_1,
+};
+
+static const epc_parser_list_data_t Program_list = { (epc_parser_t * *)Program_children, 2, NULL };
+
+static const epc_parser_t Program = {
+    .parse_fn = epc_and_parse_fn,
+    .data = { .data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&Program_list },
+    .name = "Program",
+    .ast_config = { .assigned = true, .action = GDL_AST_ACTION_CREATE_PROGRAM },
+};
+
+// The parsers are static, so the list isn't used and the parser must not be freed.
+epc_parser_t * create_gdl_generated_parser(epc_parser_list * list)
+{
+    (void)list;
+    return (epc_parser_t *)&Program;
+}
@@ -0,0 +1,7 @@
+// Generated header for gdl_generated
+#pragma once
+
+#include <easy_pc/easy_pc.h>
+#include "gdl_generated_actions.h"
+
+epc_parser_t * create_gdl_generated_parser(epc_parser_list * list);
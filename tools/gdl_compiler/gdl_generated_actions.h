@@ -0,0 +1,36 @@
+// Generated semantic actions header for gdl_generated
+#pragma once
+
+typedef enum {
+    GDL_AST_ACTION_CREATE_IDENTIFIER_REF,
+    GDL_AST_ACTION_CREATE_STRING_LITERAL,
+    GDL_AST_ACTION_CREATE_CHAR_LITERAL,
+    GDL_AST_ACTION_CREATE_RAW_CHAR_LITERAL,
+    GDL_AST_ACTION_CREATE_NUMBER_LITERAL,
+    GDL_AST_ACTION_CREATE_KEYWORD,
+    GDL_AST_ACTION_CREATE_CHAR_RANGE,
+    GDL_AST_ACTION_CREATE_REPETITION_OPERATOR,
+    GDL_AST_ACTION_CREATE_SEMANTIC_ACTION,
+    GDL_AST_ACTION_CREATE_OPTIONAL_SEMANTIC_ACTION,
+    GDL_AST_ACTION_CREATE_FAIL_CALL,
+    GDL_AST_ACTION_CREATE_TERMINAL,
+    GDL_AST_ACTION_CREATE_NONEOF_CALL,
+    GDL_AST_ACTION_CREATE_COUNT_CALL,
+    GDL_AST_ACTION_CREATE_BETWEEN_CALL,
+    GDL_AST_ACTION_CREATE_DELIMITED_CALL,
+    GDL_AST_ACTION_CREATE_LOOKAHEAD_CALL,
+    GDL_AST_ACTION_CREATE_NOT_CALL,
+    GDL_AST_ACTION_CREATE_ONEOF_CALL,
+    GDL_AST_ACTION_CREATE_LEXEME_CALL,
+    GDL_AST_ACTION_CREATE_CHAINL1_CALL,
+    GDL_AST_ACTION_CREATE_CHAINR1_CALL,
+    GDL_AST_ACTION_CREATE_SKIP_CALL,
+    GDL_AST_ACTION_CREATE_PASSTHRU_CALL,
+    GDL_AST_ACTION_CREATE_OPTIONAL,
+    GDL_AST_ACTION_CREATE_EXPRESSION_FACTOR,
+    GDL_AST_ACTION_CREATE_SEQUENCE,
+    GDL_AST_ACTION_CREATE_ALTERNATIVE,
+    GDL_AST_ACTION_CREATE_RULE_DEFINITION,
+    GDL_AST_ACTION_CREATE_PROGRAM,
+    GDL_GENERATED_AST_ACTION_COUNT__,
+} gdl_generated_semantic_action_t;
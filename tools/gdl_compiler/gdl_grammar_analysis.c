@@ -0,0 +1,1079 @@
+#include "gdl_grammar_analysis.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Character sets ---
+
+void
+gdl_char_set_clear(gdl_char_set_t * set)
+{
+    memset(set->bits, 0, sizeof(set->bits));
+}
+
+void
+gdl_char_set_fill(gdl_char_set_t * set)
+{
+    memset(set->bits, 0xff, sizeof(set->bits));
+}
+
+void
+gdl_char_set_add(gdl_char_set_t * set, unsigned char c)
+{
+    set->bits[c / 8] |= (unsigned char)(1u << (c % 8));
+}
+
+void
+gdl_char_set_add_range(gdl_char_set_t * set, unsigned char first, unsigned char last)
+{
+    for (int c = first; c <= last; c++)
+    {
+        gdl_char_set_add(set, (unsigned char)c);
+    }
+}
+
+bool
+gdl_char_set_contains(gdl_char_set_t const * set, unsigned char c)
+{
+    return (set->bits[c / 8] & (1u << (c % 8))) != 0;
+}
+
+bool
+gdl_char_set_union(gdl_char_set_t * dst, gdl_char_set_t const * src)
+{
+    bool changed = false;
+
+    for (size_t i = 0; i < sizeof(dst->bits); i++)
+    {
+        unsigned char merged = dst->bits[i] | src->bits[i];
+        if (merged != dst->bits[i])
+        {
+            dst->bits[i] = merged;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+bool
+gdl_char_set_intersects(gdl_char_set_t const * a, gdl_char_set_t const * b)
+{
+    for (size_t i = 0; i < sizeof(a->bits); i++)
+    {
+        if ((a->bits[i] & b->bits[i]) != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+gdl_char_set_is_full(gdl_char_set_t const * set)
+{
+    for (size_t i = 0; i < sizeof(set->bits); i++)
+    {
+        if (set->bits[i] != 0xff)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+gdl_char_set_count(gdl_char_set_t const * set)
+{
+    int count = 0;
+
+    for (int c = 0; c < 256; c++)
+    {
+        count += gdl_char_set_contains(set, (unsigned char)c);
+    }
+    return count;
+}
+
+// --- AST traversal ---
+
+void
+gdl_expression_for_each_child_slot(
+    gdl_ast_node_t * node, void (*visit)(gdl_ast_node_t * * slot, void * user_data), void * user_data)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_TERMINAL:
+        visit(&node->data.terminal.expression, user_data);
+        break;
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        for (gdl_ast_list_node_t * e = node->data.sequence.elements.head; e != NULL; e = e->next)
+        {
+            visit(&e->item, user_data);
+        }
+        break;
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+        for (gdl_ast_list_node_t * a = node->data.alternative.alternatives.head; a != NULL; a = a->next)
+        {
+            visit(&a->item, user_data);
+        }
+        break;
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+        visit(&node->data.repetition_expr.expression, user_data);
+        break;
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        visit(&node->data.optional.expr, user_data);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        visit(&node->data.unary_combinator_call.expr, user_data);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+        visit(&node->data.count_call.expression, user_data);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+        visit(&node->data.between_call.open_expr, user_data);
+        visit(&node->data.between_call.content_expr, user_data);
+        visit(&node->data.between_call.close_expr, user_data);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        visit(&node->data.delimited_call.item_expr, user_data);
+        if (node->data.delimited_call.delimiter_expr != NULL)
+        {
+            visit(&node->data.delimited_call.delimiter_expr, user_data);
+        }
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        visit(&node->data.chain_combinator_call.item_expr, user_data);
+        visit(&node->data.chain_combinator_call.op_expr, user_data);
+        break;
+
+    default:
+        // Leaf expressions.
+        break;
+    }
+}
+
+typedef struct
+{
+    void (*visit)(gdl_ast_node_t * child, void * user_data);
+    void * user_data;
+} child_visit_ctx_t;
+
+static void
+visit_child_in_slot(gdl_ast_node_t * * slot, void * user_data)
+{
+    child_visit_ctx_t * ctx = user_data;
+
+    ctx->visit(*slot, ctx->user_data);
+}
+
+void
+gdl_expression_for_each_child(
+    gdl_ast_node_t * node, void (*visit)(gdl_ast_node_t * child, void * user_data), void * user_data)
+{
+    child_visit_ctx_t ctx = { .visit = visit, .user_data = user_data };
+
+    gdl_expression_for_each_child_slot(node, visit_child_in_slot, &ctx);
+}
+
+// --- Nullable and FIRST ---
+
+gdl_rule_analysis_t *
+gdl_grammar_analysis_find_rule(gdl_grammar_analysis_t const * analysis, char const * name)
+{
+    for (int i = 0; i < analysis->count; i++)
+    {
+        if (strcmp(analysis->rules[i].name, name) == 0)
+        {
+            return &analysis->rules[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Bytes above 0x7f are included for the character class keywords, as whether
+ * they are classified as letters or spaces depends on the locale the
+ * generated parser runs in.
+ */
+static bool
+keyword_first(char const * keyword_name, gdl_char_set_t * first)
+{
+    if (strcmp(keyword_name, "eoi") == 0)
+    {
+        gdl_char_set_add(first, '\0');
+    }
+    else if (strcmp(keyword_name, "digit") == 0)
+    {
+        gdl_char_set_add_range(first, '0', '9');
+    }
+    else if (strcmp(keyword_name, "hex_digit") == 0)
+    {
+        gdl_char_set_add_range(first, '0', '9');
+        gdl_char_set_add_range(first, 'a', 'f');
+        gdl_char_set_add_range(first, 'A', 'F');
+    }
+    else if (strcmp(keyword_name, "alpha") == 0 || strcmp(keyword_name, "alphanum") == 0)
+    {
+        bool with_digits = strcmp(keyword_name, "alphanum") == 0;
+        for (int c = 1; c < 0x80; c++)
+        {
+            if (isalpha(c) || (with_digits && isdigit(c)))
+            {
+                gdl_char_set_add(first, (unsigned char)c);
+            }
+        }
+        gdl_char_set_add_range(first, 0x80, 0xff);
+    }
+    else if (strcmp(keyword_name, "space") == 0)
+    {
+        for (int c = 1; c < 0x80; c++)
+        {
+            if (isspace(c))
+            {
+                gdl_char_set_add(first, (unsigned char)c);
+            }
+        }
+        gdl_char_set_add_range(first, 0x80, 0xff);
+    }
+    else if (strcmp(keyword_name, "any_char") == 0)
+    {
+        gdl_char_set_add_range(first, 1, 0xff);
+    }
+    else if (strcmp(keyword_name, "succeed") == 0 || strcmp(keyword_name, "~") == 0)
+    {
+        return true;
+    }
+    else
+    {
+        // int, double and anything unknown.
+        gdl_char_set_fill(first);
+        return strcmp(keyword_name, "int") != 0 && strcmp(keyword_name, "double") != 0;
+    }
+    return false;
+}
+
+static bool
+char_class_first(char const * chars, bool negated, gdl_char_set_t * first)
+{
+    if (chars == NULL || strchr(chars, '\\') != NULL)
+    {
+        // The escape sequences are only interpreted by the C compiler.
+        gdl_char_set_fill(first);
+        return false;
+    }
+
+    gdl_char_set_t set;
+    gdl_char_set_clear(&set);
+    for (char const * c = chars; *c != '\0'; c++)
+    {
+        gdl_char_set_add(&set, (unsigned char)*c);
+    }
+    for (int c = 1; c < 256; c++)
+    {
+        if (gdl_char_set_contains(&set, (unsigned char)c) != negated)
+        {
+            gdl_char_set_add(first, (unsigned char)c);
+        }
+    }
+    return false;
+}
+
+// The bytes lexeme() skips before and after its expression: whitespace and comments.
+static void
+lexeme_whitespace(gdl_char_set_t * set)
+{
+    for (int c = 1; c < 0x80; c++)
+    {
+        if (isspace(c))
+        {
+            gdl_char_set_add(set, (unsigned char)c);
+        }
+    }
+    gdl_char_set_add_range(set, 0x80, 0xff);
+    gdl_char_set_add(set, '/');
+}
+
+bool
+gdl_expression_first(gdl_grammar_analysis_t const * analysis, gdl_ast_node_t * expression, gdl_char_set_t * first)
+{
+    if (expression == NULL)
+    {
+        return true;
+    }
+
+    switch (expression->type)
+    {
+    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
+        gdl_char_set_add(first, (unsigned char)expression->data.char_literal.value);
+        return false;
+
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+    {
+        char const * value = expression->data.string_literal.value;
+        if (value == NULL || value[0] == '\0')
+        {
+            return true;
+        }
+        if (value[0] == '\\')
+        {
+            gdl_char_set_fill(first);
+        }
+        else
+        {
+            gdl_char_set_add(first, (unsigned char)value[0]);
+        }
+        return false;
+    }
+
+    case GDL_AST_NODE_TYPE_CHAR_RANGE:
+        if ((unsigned char)expression->data.char_range.start_char <= (unsigned char)expression->data.char_range.end_char)
+        {
+            gdl_char_set_add_range(first,
+                                   (unsigned char)expression->data.char_range.start_char,
+                                   (unsigned char)expression->data.char_range.end_char);
+        }
+        return false;
+
+    case GDL_AST_NODE_TYPE_KEYWORD:
+        return keyword_first(expression->data.keyword.name, first);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
+        return char_class_first(expression->data.none_or_one_of_call.args, false, first);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
+        return char_class_first(expression->data.none_or_one_of_call.args, true, first);
+
+    case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
+    {
+        gdl_rule_analysis_t const * rule = gdl_grammar_analysis_find_rule(analysis, expression->data.identifier_ref.name);
+        if (rule == NULL)
+        {
+            gdl_char_set_fill(first);
+            return true;
+        }
+        gdl_char_set_union(first, &rule->first);
+        return rule->nullable;
+    }
+
+    case GDL_AST_NODE_TYPE_TERMINAL:
+        return gdl_expression_first(analysis, expression->data.terminal.expression, first);
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        for (gdl_ast_list_node_t * e = expression->data.sequence.elements.head; e != NULL; e = e->next)
+        {
+            if (!gdl_expression_first(analysis, e->item, first))
+            {
+                return false;
+            }
+        }
+        return true;
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+    {
+        bool nullable = false;
+        for (gdl_ast_list_node_t * a = expression->data.alternative.alternatives.head; a != NULL; a = a->next)
+        {
+            nullable |= gdl_expression_first(analysis, a->item, first);
+        }
+        return nullable;
+    }
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+    {
+        bool nullable = gdl_expression_first(analysis, expression->data.repetition_expr.expression, first);
+        return nullable || expression->data.repetition_expr.repetition->data.repetition_op.operator_char != '+';
+    }
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        gdl_expression_first(analysis, expression->data.optional.expr, first);
+        return true;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+        gdl_expression_first(analysis, expression->data.unary_combinator_call.expr, first);
+        return true;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+        // These never consume input, so whatever follows them determines FIRST.
+        return true;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        return gdl_expression_first(analysis, expression->data.unary_combinator_call.expr, first);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+        lexeme_whitespace(first);
+        return gdl_expression_first(analysis, expression->data.unary_combinator_call.expr, first);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+        return gdl_expression_first(analysis, expression->data.between_call.open_expr, first)
+               && gdl_expression_first(analysis, expression->data.between_call.content_expr, first)
+               && gdl_expression_first(analysis, expression->data.between_call.close_expr, first);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        return gdl_expression_first(analysis, expression->data.delimited_call.item_expr, first);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        return gdl_expression_first(analysis, expression->data.chain_combinator_call.item_expr, first);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+    {
+        bool nullable = gdl_expression_first(analysis, expression->data.count_call.expression, first);
+        gdl_ast_node_t * count_node = expression->data.count_call.count_node;
+        return nullable || (count_node != NULL && count_node->data.number_literal.value <= 0);
+    }
+
+    case GDL_AST_NODE_TYPE_TOKEN_DFA:
+        // The DFA matches the same language as the expression it replaced.
+        return gdl_expression_first(analysis, expression->data.token_dfa.expression, first);
+
+    case GDL_AST_NODE_TYPE_FAIL_CALL:
+    default:
+        // Nothing useful is known, so allow anything.
+        gdl_char_set_fill(first);
+        return expression->type != GDL_AST_NODE_TYPE_FAIL_CALL;
+    }
+}
+
+// --- FOLLOW ---
+
+typedef struct follow_walk_t follow_walk_t;
+
+struct follow_walk_t
+{
+    gdl_grammar_analysis_t const * analysis;
+    // Called for each expression, with the bytes that can come after it.
+    void (*visit)(follow_walk_t * walk, gdl_ast_node_t * expression, gdl_char_set_t const * follow);
+    void * user_data;
+};
+
+// Sets result to the bytes the expression can start with, plus follow if it is nullable.
+static void
+first_then(
+    gdl_grammar_analysis_t const * analysis,
+    gdl_ast_node_t * expression,
+    gdl_char_set_t const * follow,
+    gdl_char_set_t * result)
+{
+    gdl_char_set_clear(result);
+    if (gdl_expression_first(analysis, expression, result))
+    {
+        gdl_char_set_union(result, follow);
+    }
+}
+
+// Sets result to what can follow a repeated expression: another repetition, or follow.
+static void
+repeat_follow(
+    gdl_grammar_analysis_t const * analysis,
+    gdl_ast_node_t * expression,
+    gdl_char_set_t const * follow,
+    gdl_char_set_t * result)
+{
+    gdl_char_set_clear(result);
+    gdl_expression_first(analysis, expression, result);
+    gdl_char_set_union(result, follow);
+}
+
+static void walk_follow(follow_walk_t * walk, gdl_ast_node_t * expression, gdl_char_set_t const * follow);
+
+// Walks the elements from e on, setting start to the bytes they can start with.
+static void
+walk_follow_elements(
+    follow_walk_t * walk, gdl_ast_list_node_t * e, gdl_char_set_t const * follow, gdl_char_set_t * start)
+{
+    if (e == NULL)
+    {
+        *start = *follow;
+        return;
+    }
+
+    gdl_char_set_t after;
+    walk_follow_elements(walk, e->next, follow, &after);
+    walk_follow(walk, e->item, &after);
+    first_then(walk->analysis, e->item, &after, start);
+}
+
+// Walks an item repeated with a separator between each, as in delimited() and chainl1().
+static void
+walk_follow_separated(
+    follow_walk_t * walk, gdl_ast_node_t * item, gdl_ast_node_t * separator, gdl_char_set_t const * follow)
+{
+    gdl_char_set_t item_start;
+    first_then(walk->analysis, item, follow, &item_start);
+
+    gdl_char_set_t after_item = *follow;
+    if (separator != NULL)
+    {
+        gdl_char_set_t separator_start;
+        first_then(walk->analysis, separator, &item_start, &separator_start);
+        gdl_char_set_union(&after_item, &separator_start);
+        walk_follow(walk, separator, &item_start);
+    }
+    walk_follow(walk, item, &after_item);
+}
+
+static void
+walk_follow(follow_walk_t * walk, gdl_ast_node_t * expression, gdl_char_set_t const * follow)
+{
+    if (expression == NULL)
+    {
+        return;
+    }
+    walk->visit(walk, expression, follow);
+
+    gdl_char_set_t inner_follow;
+
+    switch (expression->type)
+    {
+    case GDL_AST_NODE_TYPE_TERMINAL:
+        walk_follow(walk, expression->data.terminal.expression, follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+    {
+        gdl_char_set_t start;
+        walk_follow_elements(walk, expression->data.sequence.elements.head, follow, &start);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+        for (gdl_ast_list_node_t * a = expression->data.alternative.alternatives.head; a != NULL; a = a->next)
+        {
+            walk_follow(walk, a->item, follow);
+        }
+        break;
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+        if (expression->data.repetition_expr.repetition->data.repetition_op.operator_char == '?')
+        {
+            walk_follow(walk, expression->data.repetition_expr.expression, follow);
+            break;
+        }
+        // Each match may be followed by another.
+        repeat_follow(walk->analysis, expression->data.repetition_expr.expression, follow, &inner_follow);
+        walk_follow(walk, expression->data.repetition_expr.expression, &inner_follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+        repeat_follow(walk->analysis, expression->data.count_call.expression, follow, &inner_follow);
+        walk_follow(walk, expression->data.count_call.expression, &inner_follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+        repeat_follow(walk->analysis, expression->data.unary_combinator_call.expr, follow, &inner_follow);
+        walk_follow(walk, expression->data.unary_combinator_call.expr, &inner_follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        walk_follow(walk, expression->data.optional.expr, follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        walk_follow(walk, expression->data.unary_combinator_call.expr, follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+        inner_follow = *follow;
+        lexeme_whitespace(&inner_follow);
+        walk_follow(walk, expression->data.unary_combinator_call.expr, &inner_follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+        // What follows the expression isn't consumed, so could be anything.
+        gdl_char_set_fill(&inner_follow);
+        walk_follow(walk, expression->data.unary_combinator_call.expr, &inner_follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+    {
+        gdl_char_set_t after_open;
+        gdl_char_set_t after_content;
+        first_then(walk->analysis, expression->data.between_call.close_expr, follow, &after_content);
+        first_then(walk->analysis, expression->data.between_call.content_expr, &after_content, &after_open);
+        walk_follow(walk, expression->data.between_call.open_expr, &after_open);
+        walk_follow(walk, expression->data.between_call.content_expr, &after_content);
+        walk_follow(walk, expression->data.between_call.close_expr, follow);
+        break;
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        walk_follow_separated(walk, expression->data.delimited_call.item_expr, expression->data.delimited_call.delimiter_expr, follow);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        walk_follow_separated(walk, expression->data.chain_combinator_call.item_expr, expression->data.chain_combinator_call.op_expr, follow);
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void
+follow_visit(follow_walk_t * walk, gdl_ast_node_t * expression, gdl_char_set_t const * follow)
+{
+    bool * changed = walk->user_data;
+
+    if (expression->type == GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+    {
+        gdl_rule_analysis_t * rule = gdl_grammar_analysis_find_rule(walk->analysis, expression->data.identifier_ref.name);
+        if (rule != NULL && gdl_char_set_union(&rule->follow, follow))
+        {
+            *changed = true;
+        }
+    }
+}
+
+static void
+grammar_compute_follow(gdl_grammar_analysis_t * analysis)
+{
+    if (analysis->count == 0)
+    {
+        return;
+    }
+    gdl_char_set_add(&analysis->rules[analysis->count - 1].follow, '\0');
+
+    bool changed = true;
+    follow_walk_t walk = { .analysis = analysis, .visit = follow_visit, .user_data = &changed };
+    while (changed)
+    {
+        changed = false;
+        for (int i = 0; i < analysis->count; i++)
+        {
+            gdl_rule_analysis_t * rule = &analysis->rules[i];
+            gdl_char_set_t follow = rule->follow;
+            walk_follow(&walk, rule->rule_def->data.rule_def.definition, &follow);
+        }
+    }
+}
+
+void
+gdl_expression_predict(gdl_grammar_analysis_t const * analysis, gdl_ast_node_t * expression, gdl_char_set_t * predict)
+{
+    gdl_char_set_clear(predict);
+    if (gdl_expression_first(analysis, expression, predict))
+    {
+        gdl_char_set_fill(predict);
+    }
+}
+
+bool
+gdl_grammar_analyze(gdl_ast_node_t * program, gdl_grammar_analysis_t * analysis)
+{
+    analysis->rules = NULL;
+    analysis->count = 0;
+
+    if (program == NULL || program->type != GDL_AST_NODE_TYPE_PROGRAM)
+    {
+        fprintf(stderr, "Error: Invalid arguments to gdl_grammar_analyze.\n");
+        return false;
+    }
+
+    analysis->rules = calloc(program->data.program.rules.count > 0 ? program->data.program.rules.count : 1,
+                             sizeof(*analysis->rules));
+    if (analysis->rules == NULL)
+    {
+        perror("Failed to allocate grammar analysis");
+        return false;
+    }
+
+    for (gdl_ast_list_node_t * r = program->data.program.rules.head; r != NULL; r = r->next)
+    {
+        gdl_ast_node_t * rule_def = r->item;
+        if (rule_def->type == GDL_AST_NODE_TYPE_RULE_DEFINITION)
+        {
+            gdl_rule_analysis_t * rule = &analysis->rules[analysis->count++];
+            rule->name = rule_def->data.rule_def.name;
+            rule->rule_def = rule_def;
+            gdl_char_set_clear(&rule->first);
+            gdl_char_set_clear(&rule->follow);
+        }
+    }
+
+    // Both properties only ever grow, so iterate until nothing changes.
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (int i = 0; i < analysis->count; i++)
+        {
+            gdl_rule_analysis_t * rule = &analysis->rules[i];
+            gdl_char_set_t first;
+            gdl_char_set_clear(&first);
+
+            bool nullable = gdl_expression_first(analysis, rule->rule_def->data.rule_def.definition, &first);
+            if (nullable && !rule->nullable)
+            {
+                rule->nullable = true;
+                changed = true;
+            }
+            if (gdl_char_set_union(&rule->first, &first))
+            {
+                changed = true;
+            }
+        }
+    }
+
+    grammar_compute_follow(analysis);
+
+    return true;
+}
+
+void
+gdl_grammar_analysis_free(gdl_grammar_analysis_t * analysis)
+{
+    free(analysis->rules);
+    analysis->rules = NULL;
+    analysis->count = 0;
+}
+
+// --- Left recursion ---
+
+static bool
+expression_is_nullable(gdl_grammar_analysis_t const * analysis, gdl_ast_node_t * expression)
+{
+    gdl_char_set_t scratch;
+    gdl_char_set_clear(&scratch);
+    return gdl_expression_first(analysis, expression, &scratch);
+}
+
+// Returns true if target can be reached from expression without consuming input.
+static bool
+leftmost_reaches(
+    gdl_grammar_analysis_t const * analysis,
+    gdl_ast_node_t * expression,
+    gdl_rule_analysis_t const * target,
+    bool * visited)
+{
+    if (expression == NULL)
+    {
+        return false;
+    }
+
+    switch (expression->type)
+    {
+    case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
+    {
+        gdl_rule_analysis_t const * rule = gdl_grammar_analysis_find_rule(analysis, expression->data.identifier_ref.name);
+        if (rule == NULL)
+        {
+            return false;
+        }
+        if (rule == target)
+        {
+            return true;
+        }
+        int index = (int)(rule - analysis->rules);
+        if (visited[index])
+        {
+            return false;
+        }
+        visited[index] = true;
+        return leftmost_reaches(analysis, rule->rule_def->data.rule_def.definition, target, visited);
+    }
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        for (gdl_ast_list_node_t * e = expression->data.sequence.elements.head; e != NULL; e = e->next)
+        {
+            if (leftmost_reaches(analysis, e->item, target, visited))
+            {
+                return true;
+            }
+            if (!expression_is_nullable(analysis, e->item))
+            {
+                break;
+            }
+        }
+        return false;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+    {
+        gdl_ast_node_t * parts[] = {
+            expression->data.between_call.open_expr,
+            expression->data.between_call.content_expr,
+            expression->data.between_call.close_expr,
+        };
+        for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++)
+        {
+            if (leftmost_reaches(analysis, parts[i], target, visited))
+            {
+                return true;
+            }
+            if (!expression_is_nullable(analysis, parts[i]))
+            {
+                break;
+            }
+        }
+        return false;
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        return leftmost_reaches(analysis, expression->data.delimited_call.item_expr, target, visited);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        return leftmost_reaches(analysis, expression->data.chain_combinator_call.item_expr, target, visited);
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+        for (gdl_ast_list_node_t * a = expression->data.alternative.alternatives.head; a != NULL; a = a->next)
+        {
+            if (leftmost_reaches(analysis, a->item, target, visited))
+            {
+                return true;
+            }
+        }
+        return false;
+
+    case GDL_AST_NODE_TYPE_TERMINAL:
+        return leftmost_reaches(analysis, expression->data.terminal.expression, target, visited);
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+        return leftmost_reaches(analysis, expression->data.repetition_expr.expression, target, visited);
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        return leftmost_reaches(analysis, expression->data.optional.expr, target, visited);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+        return leftmost_reaches(analysis, expression->data.count_call.expression, target, visited);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        return leftmost_reaches(analysis, expression->data.unary_combinator_call.expr, target, visited);
+
+    default:
+        return false;
+    }
+}
+
+bool
+gdl_rule_is_left_recursive(gdl_grammar_analysis_t const * analysis, gdl_rule_analysis_t const * rule)
+{
+    bool * visited = calloc(analysis->count > 0 ? analysis->count : 1, sizeof(*visited));
+    if (visited == NULL)
+    {
+        return false;
+    }
+
+    bool left_recursive = leftmost_reaches(analysis, rule->rule_def->data.rule_def.definition, rule, visited);
+
+    free(visited);
+    return left_recursive;
+}
+
+// --- Report ---
+
+static void
+write_char(FILE * out, unsigned char c)
+{
+    if (c == '\0')
+    {
+        fprintf(out, "<eoi>");
+    }
+    else if (c == '\'' || c == '\\')
+    {
+        fprintf(out, "'\\%c'", c);
+    }
+    else if (isprint(c))
+    {
+        fprintf(out, "'%c'", c);
+    }
+    else
+    {
+        fprintf(out, "'\\x%02x'", c);
+    }
+}
+
+// Writes the set as a list of bytes and ranges, e.g. <eoi> '+' '0'-'9'.
+static void
+write_char_set(FILE * out, gdl_char_set_t const * set)
+{
+    int const max_ranges = 12;
+    int ranges = 0;
+
+    if (gdl_char_set_is_full(set))
+    {
+        fprintf(out, "anything");
+        return;
+    }
+    if (gdl_char_set_count(set) == 0)
+    {
+        fprintf(out, "nothing");
+        return;
+    }
+    for (int c = 0; c < 256; c++)
+    {
+        if (!gdl_char_set_contains(set, (unsigned char)c))
+        {
+            continue;
+        }
+        int last = c;
+        while (last + 1 < 256 && gdl_char_set_contains(set, (unsigned char)(last + 1)))
+        {
+            last++;
+        }
+        if (ranges++ == max_ranges)
+        {
+            fprintf(out, " ...");
+            return;
+        }
+        fprintf(out, ranges > 1 ? " " : "");
+        write_char(out, (unsigned char)c);
+        if (last > c)
+        {
+            fprintf(out, "-");
+            write_char(out, (unsigned char)last);
+        }
+        c = last;
+    }
+}
+
+typedef struct
+{
+    FILE * out;
+    gdl_grammar_report_stats_t * stats;
+    int alternation; // Of the current rule.
+} report_ctx_t;
+
+static void
+report_alternation(follow_walk_t * walk, report_ctx_t * ctx, gdl_ast_node_t * alternation, gdl_char_set_t const * follow)
+{
+    int count = alternation->data.alternative.alternatives.count;
+    gdl_char_set_t * predict = calloc(count, sizeof(*predict));
+    if (predict == NULL)
+    {
+        perror("Failed to allocate grammar report");
+        return;
+    }
+
+    // In LL(1) terms, a nullable alternative is chosen by what follows the alternation.
+    int i = 0;
+    for (gdl_ast_list_node_t * a = alternation->data.alternative.alternatives.head; a != NULL; a = a->next, i++)
+    {
+        first_then(walk->analysis, a->item, follow, &predict[i]);
+    }
+
+    ctx->stats->alternations++;
+    ctx->alternation++;
+    fprintf(ctx->out, "    alternation %d (%d alternatives): ", ctx->alternation, count);
+    for (i = 0; i < count; i++)
+    {
+        for (int j = i + 1; j < count; j++)
+        {
+            if (gdl_char_set_intersects(&predict[i], &predict[j]))
+            {
+                gdl_char_set_t common;
+                gdl_char_set_clear(&common);
+                for (int c = 0; c < 256; c++)
+                {
+                    if (gdl_char_set_contains(&predict[i], (unsigned char)c)
+                        && gdl_char_set_contains(&predict[j], (unsigned char)c))
+                    {
+                        gdl_char_set_add(&common, (unsigned char)c);
+                    }
+                }
+                fprintf(ctx->out, "may backtrack, alternatives %d and %d can both start with ", i + 1, j + 1);
+                write_char_set(ctx->out, &common);
+                fprintf(ctx->out, "\n");
+                free(predict);
+                return;
+            }
+        }
+    }
+    ctx->stats->ll1_alternations++;
+    fprintf(ctx->out, "LL(1)\n");
+    free(predict);
+}
+
+static void
+report_visit(follow_walk_t * walk, gdl_ast_node_t * expression, gdl_char_set_t const * follow)
+{
+    report_ctx_t * ctx = walk->user_data;
+    gdl_ast_node_t * repeated = NULL;
+    char const * repetition = NULL;
+
+    if (expression->type == GDL_AST_NODE_TYPE_ALTERNATIVE && expression->data.alternative.alternatives.count >= 2)
+    {
+        report_alternation(walk, ctx, expression, follow);
+    }
+    else if (expression->type == GDL_AST_NODE_TYPE_REPETITION_EXPRESSION
+             && expression->data.repetition_expr.repetition->data.repetition_op.operator_char != '?')
+    {
+        repeated = expression->data.repetition_expr.expression;
+        repetition = expression->data.repetition_expr.repetition->data.repetition_op.operator_char == '+' ? "'+'" : "'*'";
+    }
+    else if (expression->type == GDL_AST_NODE_TYPE_COMBINATOR_SKIP)
+    {
+        repeated = expression->data.unary_combinator_call.expr;
+        repetition = "skip()";
+    }
+
+    if (repeated != NULL && expression_is_nullable(walk->analysis, repeated))
+    {
+        ctx->stats->nullable_repetitions++;
+        fprintf(ctx->out,
+                "    warning: %s repeats an expression that can match empty input, "
+                "which fails with \"Infinite recursion detected\" when it does\n",
+                repetition);
+    }
+}
+
+void
+gdl_grammar_write_report(gdl_grammar_analysis_t const * analysis, FILE * out, gdl_grammar_report_stats_t * stats)
+{
+    report_ctx_t ctx = { .out = out, .stats = stats };
+    follow_walk_t walk = { .analysis = analysis, .visit = report_visit, .user_data = &ctx };
+
+    *stats = (gdl_grammar_report_stats_t){ 0 };
+
+    for (int i = 0; i < analysis->count; i++)
+    {
+        gdl_rule_analysis_t const * rule = &analysis->rules[i];
+
+        fprintf(out, "%s:%s%s\n",
+                rule->name,
+                rule->nullable ? " nullable" : "",
+                gdl_rule_is_left_recursive(analysis, rule) ? " left-recursive" : "");
+        fprintf(out, "    FIRST:  ");
+        write_char_set(out, &rule->first);
+        fprintf(out, "\n    FOLLOW: ");
+        write_char_set(out, &rule->follow);
+        fprintf(out, "\n");
+
+        ctx.alternation = 0;
+        gdl_char_set_t follow = rule->follow;
+        walk_follow(&walk, rule->rule_def->data.rule_def.definition, &follow);
+    }
+
+    fprintf(out, "%d alternations: %d LL(1), %d may backtrack. %d repetitions of nullable expressions.\n",
+            stats->alternations,
+            stats->ll1_alternations,
+            stats->alternations - stats->ll1_alternations,
+            stats->nullable_repetitions);
+}
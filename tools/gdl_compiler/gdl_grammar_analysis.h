@@ -0,0 +1,92 @@
+#pragma once
+
+#include "gdl_ast.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/*
+ * A set of input bytes. Byte 0 stands for the end of the input, so a parser
+ * that can only match there (i.e. eoi) has a FIRST set of {0}.
+ */
+typedef struct
+{
+    unsigned char bits[256 / 8];
+} gdl_char_set_t;
+
+// What is known about a rule once the grammar has been analysed.
+typedef struct
+{
+    char const * name;
+    gdl_ast_node_t * rule_def;
+    bool nullable;        // True if the rule can succeed without consuming input.
+    gdl_char_set_t first; // The bytes the rule can start with, if it consumes input.
+    gdl_char_set_t follow; // The bytes that can come after the rule. The start rule is followed by the end of the input.
+} gdl_rule_analysis_t;
+
+typedef struct
+{
+    gdl_rule_analysis_t * rules; // In definition order.
+    int count;
+} gdl_grammar_analysis_t;
+
+void gdl_char_set_clear(gdl_char_set_t * set);
+void gdl_char_set_fill(gdl_char_set_t * set);
+void gdl_char_set_add(gdl_char_set_t * set, unsigned char c);
+void gdl_char_set_add_range(gdl_char_set_t * set, unsigned char first, unsigned char last);
+bool gdl_char_set_contains(gdl_char_set_t const * set, unsigned char c);
+// Adds the members of src to dst, returning true if dst changed.
+bool gdl_char_set_union(gdl_char_set_t * dst, gdl_char_set_t const * src);
+bool gdl_char_set_intersects(gdl_char_set_t const * a, gdl_char_set_t const * b);
+bool gdl_char_set_is_full(gdl_char_set_t const * set);
+int gdl_char_set_count(gdl_char_set_t const * set);
+
+// Calls visit() for each expression directly contained in the given node.
+void gdl_expression_for_each_child(
+    gdl_ast_node_t * node, void (*visit)(gdl_ast_node_t * child, void * user_data), void * user_data);
+
+// Like gdl_expression_for_each_child(), but passes where each child is stored, so it can be replaced.
+void gdl_expression_for_each_child_slot(
+    gdl_ast_node_t * node, void (*visit)(gdl_ast_node_t * * slot, void * user_data), void * user_data);
+
+// Computes nullable, FIRST and FOLLOW for every rule in the program. Returns false on error.
+bool gdl_grammar_analyze(gdl_ast_node_t * program, gdl_grammar_analysis_t * analysis);
+
+void gdl_grammar_analysis_free(gdl_grammar_analysis_t * analysis);
+
+// Returns NULL if there is no rule with the given name.
+gdl_rule_analysis_t * gdl_grammar_analysis_find_rule(gdl_grammar_analysis_t const * analysis, char const * name);
+
+/*
+ * Computes the FIRST set of an expression, returning true if it is nullable.
+ * Expressions whose first byte can't be determined (e.g. string literals
+ * starting with an escape sequence) get a full set, so the result is always
+ * safe to use to rule out a match.
+ */
+bool gdl_expression_first(gdl_grammar_analysis_t const * analysis, gdl_ast_node_t * expression, gdl_char_set_t * first);
+
+// Returns true if the rule can call itself without consuming input.
+bool gdl_rule_is_left_recursive(gdl_grammar_analysis_t const * analysis, gdl_rule_analysis_t const * rule);
+
+/*
+ * Computes the bytes at which the expression can succeed: its FIRST set, or
+ * every byte if it is nullable, as it then matches whatever comes next.
+ * An alternative whose set doesn't include the next byte can't match.
+ */
+void gdl_expression_predict(gdl_grammar_analysis_t const * analysis, gdl_ast_node_t * expression, gdl_char_set_t * predict);
+
+typedef struct
+{
+    int alternations;         // Alternations of two or more alternatives.
+    int ll1_alternations;     // Those where the next byte selects at most one alternative.
+    int nullable_repetitions; // Repetitions of an expression that can match without consuming input.
+} gdl_grammar_report_stats_t;
+
+/*
+ * Writes nullable, FIRST and FOLLOW for each rule to out, and whether each
+ * alternation is LL(1) or may need to backtrack. Repetitions of nullable
+ * expressions, which fail at run time with "Infinite recursion detected"
+ * when they match empty input, are reported as warnings.
+ */
+void gdl_grammar_write_report(
+    gdl_grammar_analysis_t const * analysis, FILE * out, gdl_grammar_report_stats_t * stats);
@@ -0,0 +1,248 @@
+#include "gdl_code_generator.h"
+#include "gdl_compiler_ast_actions.h"
+#include "gdl_generated.h"
+
+#include <easy_pc/easy_pc_gdl.h>
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Runs the GDL text through the compiler's front end and the blob backend,
+ * and epc_grammar_load_blob() builds the parsers from the blob. Going through
+ * the blob costs little, keeps one translation from GDL to parsers, and gives
+ * the cache something to keep that doesn't share parsers between grammars.
+ */
+
+static void
+report_error(char * error_message, size_t error_size, char const * format, ...)
+{
+    if (error_message == NULL || error_size == 0)
+    {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vsnprintf(error_message, error_size, format, args);
+    va_end(args);
+}
+
+static bool
+gdl_text_to_blob(char const * gdl_text, unsigned char * * blob, size_t * size, char * error_message, size_t error_size)
+{
+    bool success = false;
+    epc_parser_list * gdl_parser_list = epc_parser_list_create();
+    epc_parser_t * gdl_grammar_parser = gdl_parser_list != NULL ? create_gdl_generated_parser(gdl_parser_list) : NULL;
+    if (gdl_grammar_parser == NULL)
+    {
+        report_error(error_message, error_size, "Failed to create the GDL parser.");
+        epc_parser_list_free(gdl_parser_list);
+        return false;
+    }
+
+    epc_parse_session_t session = epc_parse_input(gdl_grammar_parser, gdl_text);
+    if (session.result.is_error)
+    {
+        epc_parser_error_t const * error = session.result.data.error;
+        report_error(error_message, error_size, "%s at line %zu, col %zu. Expected %s, found: %s",
+                     error->message, error->line, error->col, error->expected, error->found);
+    }
+    else
+    {
+        epc_ast_hook_registry_t * ast_registry = epc_ast_hook_registry_create(GDL_AST_ACTION_MAX);
+        if (ast_registry == NULL)
+        {
+            report_error(error_message, error_size, "Failed to create the GDL AST hook registry.");
+        }
+        else
+        {
+            gdl_ast_hook_registry_init(ast_registry, NULL);
+            epc_ast_result_t ast_build_result = epc_ast_build(session.result.data.success, ast_registry, NULL);
+            if (ast_build_result.has_error)
+            {
+                report_error(error_message, error_size, "%s", ast_build_result.error_message);
+            }
+            else
+            {
+                success = gdl_build_grammar_blob((gdl_ast_node_t *)ast_build_result.ast_root, blob, size);
+                if (!success)
+                {
+                    report_error(error_message, error_size, "The grammar is invalid.");
+                }
+                gdl_ast_node_free(ast_build_result.ast_root, NULL);
+            }
+            epc_ast_hook_registry_free(ast_registry);
+        }
+    }
+
+    epc_parse_session_destroy(&session);
+    epc_parser_list_free(gdl_parser_list);
+
+    return success;
+}
+
+static epc_grammar_t *
+grammar_from_blob(unsigned char const * blob, size_t size, char * error_message, size_t error_size)
+{
+    epc_grammar_t * grammar = epc_grammar_load_blob(blob, size);
+    if (grammar == NULL)
+    {
+        report_error(error_message, error_size, "Failed to build the parsers for the grammar.");
+    }
+    return grammar;
+}
+
+epc_grammar_t *
+epc_grammar_from_gdl(char const * gdl_text, char * error_message, size_t error_size)
+{
+    if (gdl_text == NULL)
+    {
+        report_error(error_message, error_size, "No grammar.");
+        return NULL;
+    }
+
+    unsigned char * blob;
+    size_t size;
+    if (!gdl_text_to_blob(gdl_text, &blob, &size, error_message, error_size))
+    {
+        return NULL;
+    }
+    epc_grammar_t * grammar = grammar_from_blob(blob, size, error_message, error_size);
+    free(blob);
+
+    return grammar;
+}
+
+typedef struct
+{
+    uint64_t hash;
+    char * gdl_text;
+    unsigned char * blob;
+    size_t size;
+} grammar_cache_entry_t;
+
+struct epc_grammar_cache_t
+{
+    grammar_cache_entry_t * entries;    /* Most recently used first. */
+    int count;
+    int max_entries;
+};
+
+/* FNV-1a. */
+static uint64_t
+gdl_text_hash(char const * gdl_text)
+{
+    uint64_t hash = 0xcbf29ce484222325u;
+    for (unsigned char const * c = (unsigned char const *)gdl_text; *c != '\0'; c++)
+    {
+        hash = (hash ^ *c) * 0x100000001b3u;
+    }
+    return hash;
+}
+
+static void
+grammar_cache_entry_free(grammar_cache_entry_t * entry)
+{
+    free(entry->gdl_text);
+    free(entry->blob);
+}
+
+epc_grammar_cache_t *
+epc_grammar_cache_create(int max_entries)
+{
+    if (max_entries <= 0)
+    {
+        return NULL;
+    }
+    epc_grammar_cache_t * cache = calloc(1, sizeof(*cache));
+    if (cache == NULL)
+    {
+        return NULL;
+    }
+    cache->entries = calloc(max_entries, sizeof(*cache->entries));
+    if (cache->entries == NULL)
+    {
+        free(cache);
+        return NULL;
+    }
+    cache->max_entries = max_entries;
+
+    return cache;
+}
+
+epc_grammar_t *
+epc_grammar_cache_load(epc_grammar_cache_t * cache, char const * gdl_text, char * error_message, size_t error_size)
+{
+    if (cache == NULL || gdl_text == NULL)
+    {
+        report_error(error_message, error_size, cache == NULL ? "No cache." : "No grammar.");
+        return NULL;
+    }
+
+    uint64_t hash = gdl_text_hash(gdl_text);
+    grammar_cache_entry_t entry;
+    int index;
+    for (index = 0; index < cache->count; index++)
+    {
+        // The text is compared too, so a hash collision can't give the wrong grammar.
+        if (cache->entries[index].hash == hash && strcmp(cache->entries[index].gdl_text, gdl_text) == 0)
+        {
+            break;
+        }
+    }
+
+    if (index < cache->count)
+    {
+        entry = cache->entries[index];
+    }
+    else
+    {
+        entry = (grammar_cache_entry_t){ .hash = hash, .gdl_text = strdup(gdl_text) };
+        if (entry.gdl_text == NULL)
+        {
+            report_error(error_message, error_size, "Out of memory.");
+            return NULL;
+        }
+        // Grammars that fail to build aren't cached, so the error is reported every time.
+        if (!gdl_text_to_blob(gdl_text, &entry.blob, &entry.size, error_message, error_size))
+        {
+            free(entry.gdl_text);
+            return NULL;
+        }
+        if (cache->count == cache->max_entries)
+        {
+            grammar_cache_entry_free(&cache->entries[--cache->count]);
+        }
+        index = cache->count++;
+    }
+
+    // Move the entry to the front.
+    memmove(&cache->entries[1], &cache->entries[0], index * sizeof(*cache->entries));
+    cache->entries[0] = entry;
+
+    return grammar_from_blob(entry.blob, entry.size, error_message, error_size);
+}
+
+int
+epc_grammar_cache_count(epc_grammar_cache_t const * cache)
+{
+    return cache != NULL ? cache->count : 0;
+}
+
+void
+epc_grammar_cache_free(epc_grammar_cache_t * cache)
+{
+    if (cache == NULL)
+    {
+        return;
+    }
+    for (int i = 0; i < cache->count; i++)
+    {
+        grammar_cache_entry_free(&cache->entries[i]);
+    }
+    free(cache->entries);
+    free(cache);
+}
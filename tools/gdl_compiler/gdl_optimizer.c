@@ -0,0 +1,851 @@
+#include "gdl_optimizer.h"
+#include "gdl_code_generator_common.h"
+#include "gdl_grammar_analysis.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The passes only change parts of the grammar that have no semantic action,
+ * so the AST built from the CPT is the same: nodes without an action just
+ * hand their children's AST nodes on to their parent.
+ *  - Rules the start rule doesn't use are dropped, unless they have a
+ *    semantic action, which would then be missing from the actions header.
+ *  - References to rules without a semantic action that aren't recursive
+ *    are replaced by a copy of the rule, if the rule is small or only used
+ *    once. Token rules are kept, as they are matched by a DFA.
+ *  - Sequences within sequences, and alternatives within alternatives, are
+ *    merged into the outer one.
+ *  - Adjacent character and string literals in a sequence become one string.
+ *  - Alternatives that each match a single character become a oneof().
+ * The top-level expression of a rule with a semantic action is left alone,
+ * as the action may use its children or the index of the alternative that
+ * matched.
+ */
+
+// Rules no bigger than this are inlined wherever they are used.
+#define MAX_INLINE_SIZE 3
+
+typedef struct
+{
+    gdl_ast_node_t * program;
+    gdl_ast_node_t * * rules;   // The rule definitions, in order.
+    int count;
+    bool * inline_rule;         // Indexed like rules.
+    gdl_optimizer_stats_t * stats;
+    bool has_error;
+} optimizer_t;
+
+// --- Helpers ---
+
+static bool
+rule_has_action(gdl_ast_node_t * rule)
+{
+    gdl_ast_node_t * semantic_action = rule->data.rule_def.semantic_action;
+
+    return semantic_action != NULL && semantic_action->data.semantic_action.action_name != NULL;
+}
+
+static int
+optimizer_find_rule(optimizer_t * opt, char const * name)
+{
+    for (int i = 0; i < opt->count; i++)
+    {
+        if (strcmp(opt->rules[i]->data.rule_def.name, name) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool
+optimizer_load_rules(optimizer_t * opt)
+{
+    gdl_ast_list_t * rules = &opt->program->data.program.rules;
+
+    free(opt->rules);
+    opt->rules = calloc(rules->count > 0 ? rules->count : 1, sizeof(*opt->rules));
+    if (opt->rules == NULL)
+    {
+        perror("Failed to allocate optimizer rules");
+        opt->has_error = true;
+        return false;
+    }
+    opt->count = 0;
+    for (gdl_ast_list_node_t * r = rules->head; r != NULL; r = r->next)
+    {
+        opt->rules[opt->count++] = r->item;
+    }
+    return true;
+}
+
+static bool
+list_append(gdl_ast_list_t * list, gdl_ast_node_t * item)
+{
+    gdl_ast_list_node_t * list_node = calloc(1, sizeof(*list_node));
+    if (list_node == NULL)
+    {
+        return false;
+    }
+    list_node->item = item;
+    if (list->tail == NULL)
+    {
+        list->head = list_node;
+    }
+    else
+    {
+        list->tail->next = list_node;
+    }
+    list->tail = list_node;
+    list->count++;
+    return true;
+}
+
+static gdl_ast_node_t * node_clone(gdl_ast_node_t const * node, bool * ok);
+
+static void
+list_clone(gdl_ast_list_t * dst, gdl_ast_list_t const * src, bool * ok)
+{
+    *dst = (gdl_ast_list_t){ 0 };
+    for (gdl_ast_list_node_t const * e = src->head; e != NULL && *ok; e = e->next)
+    {
+        gdl_ast_node_t * item = node_clone(e->item, ok);
+        if (*ok && !list_append(dst, item))
+        {
+            gdl_ast_node_free(item, NULL);
+            *ok = false;
+        }
+    }
+}
+
+static char const *
+string_clone(char const * str, bool * ok)
+{
+    if (str == NULL)
+    {
+        return NULL;
+    }
+    char * copy = strdup(str);
+    if (copy == NULL)
+    {
+        *ok = false;
+    }
+    return copy;
+}
+
+// Returns a deep copy of the node. *ok is cleared if it couldn't be copied entirely.
+static gdl_ast_node_t *
+node_clone(gdl_ast_node_t const * node, bool * ok)
+{
+    if (node == NULL || !*ok)
+    {
+        return NULL;
+    }
+
+    gdl_ast_node_t * copy = malloc(sizeof(*copy));
+    if (copy == NULL)
+    {
+        *ok = false;
+        return NULL;
+    }
+    *copy = *node;
+
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
+        copy->data.identifier_ref.name = string_clone(node->data.identifier_ref.name, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+    case GDL_AST_NODE_TYPE_FAIL_CALL:
+        copy->data.string_literal.value = string_clone(node->data.string_literal.value, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_KEYWORD:
+        copy->data.keyword.name = string_clone(node->data.keyword.name, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_SEMANTIC_ACTION:
+        copy->data.semantic_action.action_name = string_clone(node->data.semantic_action.action_name, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
+        copy->data.none_or_one_of_call.args = string_clone(node->data.none_or_one_of_call.args, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_TERMINAL:
+        copy->data.terminal.expression = node_clone(node->data.terminal.expression, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+        copy->data.repetition_expr.expression = node_clone(node->data.repetition_expr.expression, ok);
+        copy->data.repetition_expr.repetition = node_clone(node->data.repetition_expr.repetition, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+        copy->data.count_call.count_node = node_clone(node->data.count_call.count_node, ok);
+        copy->data.count_call.expression = node_clone(node->data.count_call.expression, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+        copy->data.between_call.open_expr = node_clone(node->data.between_call.open_expr, ok);
+        copy->data.between_call.content_expr = node_clone(node->data.between_call.content_expr, ok);
+        copy->data.between_call.close_expr = node_clone(node->data.between_call.close_expr, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        copy->data.delimited_call.item_expr = node_clone(node->data.delimited_call.item_expr, ok);
+        copy->data.delimited_call.delimiter_expr = node_clone(node->data.delimited_call.delimiter_expr, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        copy->data.unary_combinator_call.expr = node_clone(node->data.unary_combinator_call.expr, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        copy->data.chain_combinator_call.item_expr = node_clone(node->data.chain_combinator_call.item_expr, ok);
+        copy->data.chain_combinator_call.op_expr = node_clone(node->data.chain_combinator_call.op_expr, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        copy->data.optional.expr = node_clone(node->data.optional.expr, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        list_clone(&copy->data.sequence.elements, &node->data.sequence.elements, ok);
+        break;
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+        list_clone(&copy->data.alternative.alternatives, &node->data.alternative.alternatives, ok);
+        copy->data.alternative.as_keywords = node->data.alternative.as_keywords;
+        break;
+
+    case GDL_AST_NODE_TYPE_ARGUMENT_LIST:
+        list_clone(&copy->data.argument_list, &node->data.argument_list, ok);
+        break;
+
+    default:
+        // Nothing else owns any memory. Programs and rule definitions aren't expressions.
+        break;
+    }
+
+    return copy;
+}
+
+// --- Unused rules ---
+
+typedef struct
+{
+    optimizer_t * opt;
+    bool * used;
+} used_rules_ctx_t;
+
+static void
+mark_used_rules(gdl_ast_node_t * node, void * user_data)
+{
+    used_rules_ctx_t * ctx = user_data;
+
+    if (node == NULL)
+    {
+        return;
+    }
+    if (node->type == GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+    {
+        int index = optimizer_find_rule(ctx->opt, node->data.identifier_ref.name);
+        if (index >= 0 && !ctx->used[index])
+        {
+            ctx->used[index] = true;
+            mark_used_rules(ctx->opt->rules[index]->data.rule_def.definition, ctx);
+        }
+        return;
+    }
+    gdl_expression_for_each_child(node, mark_used_rules, ctx);
+}
+
+// Removes the rules without a semantic action that the start rule doesn't use. Returns the number removed.
+static int
+remove_unused_rules(optimizer_t * opt)
+{
+    if (opt->count == 0)
+    {
+        return 0;
+    }
+
+    bool * used = calloc(opt->count, sizeof(*used));
+    if (used == NULL)
+    {
+        perror("Failed to allocate optimizer rules");
+        opt->has_error = true;
+        return 0;
+    }
+    used_rules_ctx_t ctx = { .opt = opt, .used = used };
+    int start = opt->count - 1;
+    used[start] = true;
+    mark_used_rules(opt->rules[start]->data.rule_def.definition, &ctx);
+
+    gdl_ast_list_t * rules = &opt->program->data.program.rules;
+    gdl_ast_list_node_t * prev = NULL;
+    gdl_ast_list_node_t * r = rules->head;
+    int removed = 0;
+    for (int i = 0; r != NULL; i++)
+    {
+        gdl_ast_list_node_t * next = r->next;
+        if (!used[i] && !rule_has_action(r->item))
+        {
+            if (prev == NULL)
+            {
+                rules->head = next;
+            }
+            else
+            {
+                prev->next = next;
+            }
+            if (rules->tail == r)
+            {
+                rules->tail = prev;
+            }
+            rules->count--;
+            gdl_ast_node_free(r->item, NULL);
+            free(r);
+            removed++;
+        }
+        else
+        {
+            prev = r;
+        }
+        r = next;
+    }
+    free(used);
+
+    optimizer_load_rules(opt);
+    return removed;
+}
+
+// --- Inlining ---
+
+static void
+count_expression_size(gdl_ast_node_t * node, void * user_data)
+{
+    int * size = user_data;
+
+    if (node == NULL)
+    {
+        return;
+    }
+    // The wrappers the code generators skip over don't count.
+    bool is_wrapper = node->type == GDL_AST_NODE_TYPE_TERMINAL
+        || (node->type == GDL_AST_NODE_TYPE_SEQUENCE && node->data.sequence.elements.count == 1)
+        || (node->type == GDL_AST_NODE_TYPE_ALTERNATIVE && node->data.alternative.alternatives.count == 1);
+    if (!is_wrapper)
+    {
+        (*size)++;
+    }
+    gdl_expression_for_each_child(node, count_expression_size, size);
+}
+
+typedef struct
+{
+    optimizer_t * opt;
+    int * reference_count;
+} reference_count_ctx_t;
+
+static void
+count_references(gdl_ast_node_t * node, void * user_data)
+{
+    reference_count_ctx_t * ctx = user_data;
+
+    if (node == NULL)
+    {
+        return;
+    }
+    if (node->type == GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+    {
+        int index = optimizer_find_rule(ctx->opt, node->data.identifier_ref.name);
+        if (index >= 0)
+        {
+            ctx->reference_count[index]++;
+        }
+        return;
+    }
+    gdl_expression_for_each_child(node, count_references, ctx);
+}
+
+static bool
+rule_is_recursive(optimizer_t * opt, int index, bool * used)
+{
+    memset(used, 0, opt->count * sizeof(*used));
+    used_rules_ctx_t ctx = { .opt = opt, .used = used };
+    mark_used_rules(opt->rules[index]->data.rule_def.definition, &ctx);
+
+    return used[index];
+}
+
+static bool
+choose_rules_to_inline(optimizer_t * opt)
+{
+    int * reference_count = calloc(opt->count, sizeof(*reference_count));
+    bool * aliased_with_action = calloc(opt->count, sizeof(*aliased_with_action));
+    bool * reachable = calloc(opt->count, sizeof(*reachable));
+    free(opt->inline_rule);
+    opt->inline_rule = calloc(opt->count, sizeof(*opt->inline_rule));
+    if (reference_count == NULL || aliased_with_action == NULL || reachable == NULL || opt->inline_rule == NULL)
+    {
+        perror("Failed to allocate optimizer rules");
+        opt->has_error = true;
+        free(reference_count);
+        free(aliased_with_action);
+        free(reachable);
+        return false;
+    }
+
+    reference_count_ctx_t ctx = { .opt = opt, .reference_count = reference_count };
+    for (int i = 0; i < opt->count; i++)
+    {
+        gdl_ast_node_t * definition = opt->rules[i]->data.rule_def.definition;
+        count_references(definition, &ctx);
+
+        /*
+         * A rule defined as just a reference to another is the same parser,
+         * so an action given to it applies to the other rule too.
+         */
+        gdl_ast_node_t * alias = unwrap_expression(definition);
+        if (rule_has_action(opt->rules[i]) && alias != NULL && alias->type == GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+        {
+            int target = optimizer_find_rule(opt, alias->data.identifier_ref.name);
+            if (target >= 0)
+            {
+                aliased_with_action[target] = true;
+            }
+        }
+    }
+
+    // The start rule is never inlined, as the parser is created from it.
+    for (int i = 0; i < opt->count - 1; i++)
+    {
+        if (rule_has_action(opt->rules[i]) || opt->rules[i]->data.rule_def.is_token || aliased_with_action[i]
+            || reference_count[i] == 0)
+        {
+            continue;
+        }
+        int size = 0;
+        count_expression_size(opt->rules[i]->data.rule_def.definition, &size);
+        if ((reference_count[i] == 1 || size <= MAX_INLINE_SIZE) && !rule_is_recursive(opt, i, reachable))
+        {
+            opt->inline_rule[i] = true;
+        }
+    }
+
+    free(reference_count);
+    free(aliased_with_action);
+    free(reachable);
+    return true;
+}
+
+static void
+inline_references(gdl_ast_node_t * * slot, void * user_data)
+{
+    optimizer_t * opt = user_data;
+    gdl_ast_node_t * node = *slot;
+
+    if (node == NULL || opt->has_error)
+    {
+        return;
+    }
+    if (node->type != GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+    {
+        gdl_expression_for_each_child_slot(node, inline_references, opt);
+        return;
+    }
+
+    int index = optimizer_find_rule(opt, node->data.identifier_ref.name);
+    if (index < 0 || !opt->inline_rule[index])
+    {
+        return;
+    }
+    bool ok = true;
+    gdl_ast_node_t * copy = node_clone(opt->rules[index]->data.rule_def.definition, &ok);
+    if (!ok)
+    {
+        gdl_ast_node_free(copy, NULL);
+        perror("Failed to inline rule");
+        opt->has_error = true;
+        return;
+    }
+    gdl_ast_node_free(node, NULL);
+    *slot = copy;
+    opt->stats->rules_inlined++;
+
+    // The rule isn't recursive, so this ends.
+    inline_references(slot, opt);
+}
+
+static void
+inline_rules(optimizer_t * opt)
+{
+    if (!choose_rules_to_inline(opt))
+    {
+        return;
+    }
+    for (int i = 0; i < opt->count && !opt->has_error; i++)
+    {
+        if (!opt->inline_rule[i])
+        {
+            inline_references(&opt->rules[i]->data.rule_def.definition, opt);
+        }
+    }
+    // The inlined rules are no longer used.
+    remove_unused_rules(opt);
+}
+
+// --- Flattening and merging ---
+
+static void
+find_cut(gdl_ast_node_t * node, void * user_data)
+{
+    bool * found = user_data;
+
+    if (node != NULL && !*found)
+    {
+        *found = node->type == GDL_AST_NODE_TYPE_KEYWORD && strcmp(node->data.keyword.name, "~") == 0;
+        gdl_expression_for_each_child(node, find_cut, found);
+    }
+}
+
+/*
+ * Replaces each item of the list that is (once unwrapped) a node of the
+ * given type with two or more items by those items.
+ */
+static void
+flatten_list(optimizer_t * opt, gdl_ast_list_t * list, gdl_ast_node_type_t type)
+{
+    gdl_ast_list_node_t * prev = NULL;
+    gdl_ast_list_node_t * e = list->head;
+
+    while (e != NULL)
+    {
+        gdl_ast_list_node_t * next = e->next;
+        gdl_ast_node_t * inner = unwrap_expression(e->item);
+        gdl_ast_list_t * inner_list = NULL;
+        bool has_cut = false;
+
+        if (inner != NULL && inner->type == type)
+        {
+            inner_list = type == GDL_AST_NODE_TYPE_SEQUENCE ? &inner->data.sequence.elements : &inner->data.alternative.alternatives;
+            /* A cut commits to the innermost alternative, so it can't be moved into the outer one. */
+            if (type == GDL_AST_NODE_TYPE_ALTERNATIVE)
+            {
+                find_cut(inner, &has_cut);
+            }
+        }
+        if (inner_list == NULL || inner_list->count < 2 || has_cut)
+        {
+            prev = e;
+            e = next;
+            continue;
+        }
+
+        gdl_ast_list_t items = *inner_list;
+        *inner_list = (gdl_ast_list_t){ 0 };
+        if (prev == NULL)
+        {
+            list->head = items.head;
+        }
+        else
+        {
+            prev->next = items.head;
+        }
+        items.tail->next = next;
+        if (next == NULL)
+        {
+            list->tail = items.tail;
+        }
+        list->count += items.count - 1;
+        gdl_ast_node_free(e->item, NULL);
+        free(e);
+        opt->stats->nodes_flattened++;
+
+        prev = items.tail;
+        e = next;
+    }
+}
+
+// Returns the unescaped text matched by a character or string literal, or NULL if the node isn't one.
+static char *
+literal_text(gdl_ast_node_t * node)
+{
+    node = unwrap_expression(node);
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    if (node->type == GDL_AST_NODE_TYPE_CHAR_LITERAL && node->data.char_literal.value != '\0')
+    {
+        char text[2] = { node->data.char_literal.value, '\0' };
+        return strdup(text);
+    }
+    if (node->type == GDL_AST_NODE_TYPE_STRING_LITERAL && node->data.string_literal.value != NULL)
+    {
+        return c_string_unescape(node->data.string_literal.value);
+    }
+    return NULL;
+}
+
+static gdl_ast_node_t *
+string_literal_alloc(char const * text)
+{
+    gdl_ast_node_t * node = calloc(1, sizeof(*node));
+    if (node == NULL)
+    {
+        return NULL;
+    }
+    node->type = GDL_AST_NODE_TYPE_STRING_LITERAL;
+    node->data.string_literal.value = c_string_escape(text);
+    if (node->data.string_literal.value == NULL)
+    {
+        free(node);
+        return NULL;
+    }
+    return node;
+}
+
+static void
+merge_literals(optimizer_t * opt, gdl_ast_list_t * list)
+{
+    gdl_ast_list_node_t * e = list->head;
+
+    while (e != NULL && !opt->has_error)
+    {
+        char * text = literal_text(e->item);
+        if (text == NULL)
+        {
+            e = e->next;
+            continue;
+        }
+
+        // Append the literals that follow, up to the first thing that isn't one.
+        gdl_ast_list_node_t * end = e->next;
+        int merged = 0;
+        char * next_text;
+        while (end != NULL && (next_text = literal_text(end->item)) != NULL)
+        {
+            char * joined = str_printf("%s%s", text, next_text);
+            free(text);
+            free(next_text);
+            text = joined;
+            if (text == NULL)
+            {
+                opt->has_error = true;
+                return;
+            }
+            end = end->next;
+            merged++;
+        }
+
+        if (merged > 0)
+        {
+            gdl_ast_node_t * string = string_literal_alloc(text);
+            if (string == NULL)
+            {
+                perror("Failed to merge literals");
+                opt->has_error = true;
+                free(text);
+                return;
+            }
+            while (e->next != end)
+            {
+                gdl_ast_list_node_t * removed = e->next;
+                e->next = removed->next;
+                gdl_ast_node_free(removed->item, NULL);
+                free(removed);
+            }
+            if (end == NULL)
+            {
+                list->tail = e;
+            }
+            list->count -= merged;
+            gdl_ast_node_free(e->item, NULL);
+            e->item = string;
+            opt->stats->literals_merged += merged;
+        }
+        free(text);
+        e = end;
+    }
+}
+
+// Adds the characters the alternative matches to set, returning false unless it matches exactly one character.
+static bool
+add_single_char_alternative(gdl_ast_node_t * node, bool set[256], char * chars, size_t * len)
+{
+    node = unwrap_expression(node);
+    if (node == NULL)
+    {
+        return false;
+    }
+
+    char * text;
+    if (node->type == GDL_AST_NODE_TYPE_COMBINATOR_ONEOF && node->data.none_or_one_of_call.args != NULL)
+    {
+        text = c_string_unescape(node->data.none_or_one_of_call.args);
+    }
+    else if (node->type == GDL_AST_NODE_TYPE_CHAR_LITERAL
+             || (node->type == GDL_AST_NODE_TYPE_STRING_LITERAL && node->data.string_literal.value != NULL))
+    {
+        text = literal_text(node);
+        if (text != NULL && strlen(text) != 1)
+        {
+            free(text);
+            text = NULL;
+        }
+    }
+    else
+    {
+        return false;
+    }
+    if (text == NULL || text[0] == '\0')
+    {
+        free(text);
+        return false;
+    }
+
+    for (unsigned char const * c = (unsigned char const *)text; *c != '\0'; c++)
+    {
+        if (!set[*c])
+        {
+            set[*c] = true;
+            chars[(*len)++] = (char)*c;
+        }
+    }
+    free(text);
+    return true;
+}
+
+static void
+make_char_set(optimizer_t * opt, gdl_ast_node_t * * slot)
+{
+    gdl_ast_list_t * alternatives = &(*slot)->data.alternative.alternatives;
+    bool set[256] = { false };
+    char chars[256];
+    size_t len = 0;
+
+    if (alternatives->count < 2)
+    {
+        return;
+    }
+    for (gdl_ast_list_node_t * a = alternatives->head; a != NULL; a = a->next)
+    {
+        if (!add_single_char_alternative(a->item, set, chars, &len))
+        {
+            return;
+        }
+    }
+    chars[len] = '\0';
+
+    gdl_ast_node_t * one_of = calloc(1, sizeof(*one_of));
+    char * args = c_string_escape(chars);
+    if (one_of == NULL || args == NULL)
+    {
+        perror("Failed to create oneof");
+        free(one_of);
+        free(args);
+        opt->has_error = true;
+        return;
+    }
+    one_of->type = GDL_AST_NODE_TYPE_COMBINATOR_ONEOF;
+    one_of->data.none_or_one_of_call.args = args;
+
+    gdl_ast_node_free(*slot, NULL);
+    *slot = one_of;
+    opt->stats->char_sets_created++;
+}
+
+typedef struct
+{
+    optimizer_t * opt;
+    gdl_ast_node_t * keep_children; // The top-level expression of the rule, if it has a semantic action.
+} simplify_ctx_t;
+
+static void
+simplify_expression(gdl_ast_node_t * * slot, void * user_data)
+{
+    simplify_ctx_t * ctx = user_data;
+    gdl_ast_node_t * node = *slot;
+
+    if (node == NULL || ctx->opt->has_error)
+    {
+        return;
+    }
+    gdl_expression_for_each_child_slot(node, simplify_expression, ctx);
+
+    if (unwrap_expression(node) == ctx->keep_children)
+    {
+        return;
+    }
+    if (node->type == GDL_AST_NODE_TYPE_SEQUENCE)
+    {
+        flatten_list(ctx->opt, &node->data.sequence.elements, GDL_AST_NODE_TYPE_SEQUENCE);
+        merge_literals(ctx->opt, &node->data.sequence.elements);
+    }
+    else if (node->type == GDL_AST_NODE_TYPE_ALTERNATIVE)
+    {
+        flatten_list(ctx->opt, &node->data.alternative.alternatives, GDL_AST_NODE_TYPE_ALTERNATIVE);
+        make_char_set(ctx->opt, slot);
+        if ((*slot)->type == GDL_AST_NODE_TYPE_ALTERNATIVE && alternative_can_be_keyword_set(*slot))
+        {
+            (*slot)->data.alternative.as_keywords = true;
+            ctx->opt->stats->keyword_sets_created++;
+        }
+    }
+}
+
+static void
+simplify_rules(optimizer_t * opt)
+{
+    for (int i = 0; i < opt->count && !opt->has_error; i++)
+    {
+        gdl_ast_node_t * rule = opt->rules[i];
+        simplify_ctx_t ctx = {
+            .opt = opt,
+            .keep_children = rule_has_action(rule) ? unwrap_expression(rule->data.rule_def.definition) : NULL,
+        };
+        simplify_expression(&rule->data.rule_def.definition, &ctx);
+    }
+}
+
+bool
+gdl_optimize(gdl_ast_node_t * program, gdl_optimizer_stats_t * stats)
+{
+    if (program == NULL || program->type != GDL_AST_NODE_TYPE_PROGRAM || stats == NULL)
+    {
+        fprintf(stderr, "Error: Invalid arguments or AST root type to gdl_optimize.\n");
+        return false;
+    }
+
+    optimizer_t opt = { .program = program, .stats = stats };
+    *stats = (gdl_optimizer_stats_t){ 0 };
+
+    if (optimizer_load_rules(&opt))
+    {
+        stats->rules_removed = remove_unused_rules(&opt);
+    }
+    if (!opt.has_error)
+    {
+        inline_rules(&opt);
+    }
+    if (!opt.has_error)
+    {
+        simplify_rules(&opt);
+    }
+
+    free(opt.rules);
+    free(opt.inline_rule);
+
+    return !opt.has_error;
+}
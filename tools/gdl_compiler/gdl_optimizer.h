@@ -0,0 +1,26 @@
+#pragma once
+
+#include "gdl_ast.h"
+
+#include <stdbool.h>
+
+// What gdl_optimize() changed.
+typedef struct
+{
+    int rules_removed;      // Rules the start rule doesn't use.
+    int rules_inlined;      // References replaced by a copy of the rule's definition.
+    int nodes_flattened;    // Sequences and alternatives merged into the one containing them.
+    int literals_merged;    // Adjacent character and string literals merged into one string.
+    int char_sets_created;  // Alternatives of single characters replaced by a oneof().
+    int keyword_sets_created; // Alternatives of strings to be matched as one set of keywords.
+} gdl_optimizer_stats_t;
+
+/*
+ * Rewrites the program so the generated parser has fewer parsers to call,
+ * without changing what it matches or the AST its semantic actions build.
+ * Names of the parsers without semantic actions, and so the CPT node names
+ * and some error messages, may change.
+ * Returns false on error, in which case the program may have been partly
+ * optimized but is still valid.
+ */
+bool gdl_optimize(gdl_ast_node_t * program, gdl_optimizer_stats_t * stats);
@@ -240,12 +240,18 @@ epc_parser_t * create_gdl_parser(epc_parser_list * l)
                                epc_and_l(l, "FailCall", 4, p_fail, gdl_lparen, gdl_string_literal, gdl_rparen);
     epc_parser_set_ast_action(fail_call, GDL_AST_ACTION_CREATE_FAIL_CALL);
 
+    /* '~' commits the enclosing alternative (maps to epc_cut_l()). */
+    epc_parser_t * raw_gdl_tilde = epc_char_l(l, "RawTilde", '~');
+    epc_parser_t * gdl_cut = epc_lexeme_l(l, "Cut", raw_gdl_tilde);
+    epc_parser_set_ast_action(gdl_cut, GDL_AST_ACTION_CREATE_KEYWORD);
+
     epc_parser_t * gdl_terminal =
-        epc_or_l(l, "Terminal", 6,
+        epc_or_l(l, "Terminal", 7,
                  gdl_string_literal,
                  gdl_char_literal,
                  terminal_keyword,
                  fail_call,
+                 gdl_cut,
                  gdl_actual_identifier,
                  p_double
                 );
@@ -368,15 +374,25 @@ epc_parser_t * create_gdl_parser(epc_parser_list * l)
     epc_parser_duplicate(gdl_definition_expression, temp_definition_expression);
     epc_parser_duplicate(gdl_expression_arg, gdl_definition_expression);
 
-    // RuleDefinition: identifier '=' definition_expression semantic_action? ';'
+    // RuleDefinition: rule_name '=' definition_expression semantic_action? ';'
     epc_parser_t * raw_gdl_equals_char = epc_char_l(l, "RawEqualsChar", '=');
     epc_parser_t * gdl_equals_char = epc_lexeme_l(l, "EqualsChar", raw_gdl_equals_char);
     epc_parser_t * raw_gdl_semicolon_char = epc_char_l(l, "RawSemicolonChar", ';');
     epc_parser_t * gdl_semicolon_char = epc_lexeme_l(l, "SemicolonChar", raw_gdl_semicolon_char);
 
+    // RuleName: ('token' identifier) | identifier
+    // The 'token' marker is only a keyword when another name follows, so a rule may still be called "token".
+    epc_parser_t * p_token_raw = epc_string_l(l, "token", "token");
+    epc_parser_t * temp_token_keyword_raw =
+        epc_and_l(l, "TokenKeyword_Raw", 2, p_token_raw, epc_not_l(l, "NotIdentifierContChar", gdl_identifier_cont_char));
+    epc_parser_set_ast_action(temp_token_keyword_raw, GDL_AST_ACTION_CREATE_KEYWORD);
+    epc_parser_t * gdl_token_keyword = epc_lexeme_l(l, "TokenKeyword", temp_token_keyword_raw);
+    epc_parser_t * gdl_rule_name =
+        epc_or_l(l, "RuleName", 2, epc_and_l(l, "TokenRuleName", 2, gdl_token_keyword, gdl_identifier), gdl_identifier);
+
     epc_parser_t * gdl_rule_definition =
         epc_and_l(l, "RuleDefinition", 5,
-                  gdl_identifier,
+                  gdl_rule_name,
                   gdl_equals_char,
                   gdl_definition_expression,
                   gdl_optional_semantic_action,
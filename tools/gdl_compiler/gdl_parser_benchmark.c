@@ -0,0 +1,207 @@
+#include "gdl_compiler_ast_actions.h"
+#include "gdl_generated.h"
+#include "gdl_parser.h"
+
+#include <easy_pc/easy_pc.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Compares the hand-written GDL parser (gdl_parser.c) with the one generated
+ * from gdl.gdl, by parsing a large synthetic grammar with each and building
+ * its AST.
+ *
+ * Usage: gdl_parser_benchmark [rule_count] [iterations]
+ */
+
+typedef epc_parser_t * (*create_parser_fn)(epc_parser_list * list);
+
+typedef struct
+{
+    char * text;
+    size_t len;
+    size_t capacity;
+} text_buffer_t;
+
+static void
+text_append(text_buffer_t * buffer, char const * format, ...)
+{
+    for (;;)
+    {
+        va_list args;
+        va_start(args, format);
+        int written = vsnprintf(buffer->text + buffer->len, buffer->capacity - buffer->len, format, args);
+        va_end(args);
+        if (written < 0)
+        {
+            exit(EXIT_FAILURE);
+        }
+        if ((size_t)written < buffer->capacity - buffer->len)
+        {
+            buffer->len += written;
+            return;
+        }
+        buffer->capacity = buffer->capacity * 2 + written;
+        buffer->text = realloc(buffer->text, buffer->capacity);
+        if (buffer->text == NULL)
+        {
+            perror("Failed to allocate the grammar");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+// A grammar of rule_count rules using most of GDL, each referring to earlier rules.
+static char *
+synthetic_grammar(int rule_count, size_t * len)
+{
+    text_buffer_t buffer = { .text = malloc(4096), .capacity = 4096 };
+    if (buffer.text == NULL)
+    {
+        perror("Failed to allocate the grammar");
+        exit(EXIT_FAILURE);
+    }
+
+    text_append(&buffer, "// Synthetic grammar with %d rules\n", rule_count);
+    text_append(&buffer, "R0 = lexeme(\"start\");\n");
+    for (int i = 1; i < rule_count; i++)
+    {
+        int a = i - 1;
+        int b = i / 2;
+        switch (i % 8)
+        {
+        case 0:
+            text_append(&buffer, "R%d = R%d (',' R%d)* @ACTION_%d;\n", i, a, b, i % 50);
+            break;
+        case 1:
+            text_append(&buffer, "R%d = lexeme(\"kw_%d\") | [a-z]+ | R%d;\n", i, i, a);
+            break;
+        case 2:
+            text_append(&buffer, "R%d = between(lexeme('('), R%d, lexeme(')')) | digit+; // bracketed\n", i, a);
+            break;
+        case 3:
+            text_append(&buffer, "R%d = chainl1(R%d, lexeme(oneof(\"+-\"))) @ACTION_%d;\n", i, a, i % 50);
+            break;
+        case 4:
+            text_append(&buffer, "R%d = delimited(R%d, lexeme(';')) | noneof(\"\\\"\\\\\")?;\n", i, b);
+            break;
+        case 5:
+            text_append(&buffer, "R%d = not(R%d) alpha alphanum* | skip(space+) R%d;\n", i, b, a);
+            break;
+        case 6:
+            text_append(&buffer, "R%d = lookahead(R%d) ~ R%d | fail(\"no R%d\");\n", i, a, b, i);
+            break;
+        default:
+            text_append(&buffer, "R%d = (R%d | \"esc\\\\aped\" | '\\n') R%d+ eoi;\n", i, a, b);
+            break;
+        }
+    }
+
+    *len = buffer.len;
+    return buffer.text;
+}
+
+static double
+now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool
+benchmark_parser(
+    char const * name, create_parser_fn create_parser, char const * grammar, size_t len, int rule_count, int iterations)
+{
+    epc_ast_hook_registry_t * ast_registry = epc_ast_hook_registry_create(GDL_AST_ACTION_MAX);
+    if (ast_registry == NULL)
+    {
+        fprintf(stderr, "Error: Failed to create AST hook registry.\n");
+        return false;
+    }
+    gdl_ast_hook_registry_init(ast_registry, NULL);
+
+    double best_create = 0;
+    double best_parse = 0;
+    double best_ast = 0;
+    bool success = true;
+
+    for (int i = 0; i < iterations && success; i++)
+    {
+        double start = now_seconds();
+        epc_parser_list * list = epc_parser_list_create();
+        epc_parser_t * parser = create_parser(list);
+        double created = now_seconds();
+        epc_parse_session_t session = epc_parse_input(parser, grammar);
+        double parsed = now_seconds();
+
+        if (session.result.is_error)
+        {
+            fprintf(stderr, "Error: %s failed to parse the grammar: %s at line %zu, col %zu\n",
+                    name, session.result.data.error->message,
+                    session.result.data.error->line, session.result.data.error->col);
+            success = false;
+        }
+        else
+        {
+            epc_ast_result_t ast = epc_ast_build(session.result.data.success, ast_registry, NULL);
+            double built = now_seconds();
+            if (ast.has_error)
+            {
+                fprintf(stderr, "Error: %s failed to build the AST: %s\n", name, ast.error_message);
+                success = false;
+            }
+            gdl_ast_node_free(ast.ast_root, NULL);
+
+            if (i == 0 || created - start < best_create)
+            {
+                best_create = created - start;
+            }
+            if (i == 0 || parsed - created < best_parse)
+            {
+                best_parse = parsed - created;
+            }
+            if (i == 0 || built - parsed < best_ast)
+            {
+                best_ast = built - parsed;
+            }
+        }
+        epc_parse_session_destroy(&session);
+        epc_parser_list_free(list);
+    }
+
+    if (success)
+    {
+        printf("%-12s create %8.3f ms  parse %8.3f ms (%7.2f MB/s, %9.0f rules/s)  AST %8.3f ms\n",
+               name, best_create * 1e3, best_parse * 1e3, len / best_parse / 1e6, rule_count / best_parse, best_ast * 1e3);
+    }
+    epc_ast_hook_registry_free(ast_registry);
+
+    return success;
+}
+
+int
+main(int argc, char ** argv)
+{
+    int rule_count = argc > 1 ? atoi(argv[1]) : 500;
+    int iterations = argc > 2 ? atoi(argv[2]) : 5;
+    if (rule_count < 1 || iterations < 1)
+    {
+        fprintf(stderr, "Usage: %s [rule_count] [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    size_t len;
+    char * grammar = synthetic_grammar(rule_count, &len);
+    printf("Grammar: %d rules, %zu bytes, best of %d runs\n", rule_count, len, iterations);
+
+    bool success = benchmark_parser("hand-written", create_gdl_parser, grammar, len, rule_count, iterations)
+                   && benchmark_parser("generated", create_gdl_generated_parser, grammar, len, rule_count, iterations);
+    free(grammar);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
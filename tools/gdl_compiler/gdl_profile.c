@@ -0,0 +1,280 @@
+#include "gdl_profile.h"
+#include "gdl_code_generator_common.h"
+#include "gdl_grammar_analysis.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The profile names the epc_or parsers as the generated code does, so the
+ * alternation of a rule is found under the rule's name in PascalCase. The
+ * counts only apply to the grammar as it was when profiled, so an entry is
+ * only used if the rule still has the same number of alternatives.
+ */
+
+static void
+profile_entry_free(gdl_profile_entry_t * entry)
+{
+    free(entry->name);
+    free(entry->tried);
+    free(entry->matched);
+}
+
+// Parses "name count tried0 matched0 tried1 matched1 ...". Returns false if the line isn't in that form.
+static bool
+profile_entry_parse(char * line, gdl_profile_entry_t * entry)
+{
+    *entry = (gdl_profile_entry_t){ 0 };
+
+    char * save;
+    char * name = strtok_r(line, " \t\r\n", &save);
+    char * count = strtok_r(NULL, " \t\r\n", &save);
+    if (name == NULL || count == NULL)
+    {
+        return false;
+    }
+    char * end;
+    long alternatives = strtol(count, &end, 10);
+    if (*end != '\0' || alternatives < 1 || alternatives > 100000)
+    {
+        return false;
+    }
+
+    entry->count = (int)alternatives;
+    entry->name = strdup(name);
+    entry->tried = calloc(entry->count, sizeof(*entry->tried));
+    entry->matched = calloc(entry->count, sizeof(*entry->matched));
+    if (entry->name == NULL || entry->tried == NULL || entry->matched == NULL)
+    {
+        profile_entry_free(entry);
+        return false;
+    }
+    for (int i = 0; i < entry->count * 2; i++)
+    {
+        char * value = strtok_r(NULL, " \t\r\n", &save);
+        unsigned long long n = value != NULL ? strtoull(value, &end, 10) : 0;
+        if (value == NULL || *end != '\0')
+        {
+            profile_entry_free(entry);
+            return false;
+        }
+        if (i % 2 == 0)
+        {
+            entry->tried[i / 2] = n;
+        }
+        else
+        {
+            entry->matched[i / 2] = n;
+        }
+    }
+
+    return true;
+}
+
+bool
+gdl_profile_load(char const * path, gdl_profile_t * profile)
+{
+    *profile = (gdl_profile_t){ 0 };
+
+    FILE * file = fopen(path, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Error: Could not open profile file '%s'.\n", path);
+        return false;
+    }
+
+    bool success = true;
+    int capacity = 0;
+    char * line = NULL;
+    size_t line_size = 0;
+    int line_number = 0;
+    while (success && getline(&line, &line_size, file) != -1)
+    {
+        line_number++;
+        if (line[0] == '#' || strspn(line, " \t\r\n") == strlen(line))
+        {
+            continue;
+        }
+        gdl_profile_entry_t entry;
+        if (!profile_entry_parse(line, &entry))
+        {
+            fprintf(stderr, "Error: Invalid profile entry at %s:%d.\n", path, line_number);
+            success = false;
+            break;
+        }
+        if (profile->count == capacity)
+        {
+            capacity = capacity > 0 ? capacity * 2 : 64;
+            gdl_profile_entry_t * entries = realloc(profile->entries, capacity * sizeof(*entries));
+            if (entries == NULL)
+            {
+                perror("Failed to allocate the profile");
+                profile_entry_free(&entry);
+                success = false;
+                break;
+            }
+            profile->entries = entries;
+        }
+        profile->entries[profile->count++] = entry;
+    }
+    free(line);
+    fclose(file);
+
+    if (!success)
+    {
+        gdl_profile_free(profile);
+    }
+    return success;
+}
+
+void
+gdl_profile_free(gdl_profile_t * profile)
+{
+    for (int i = 0; i < profile->count; i++)
+    {
+        profile_entry_free(&profile->entries[i]);
+    }
+    free(profile->entries);
+    *profile = (gdl_profile_t){ 0 };
+}
+
+static gdl_profile_entry_t const *
+profile_find(gdl_profile_t const * profile, char const * name, int count)
+{
+    for (int i = 0; i < profile->count; i++)
+    {
+        if (profile->entries[i].count == count && strcmp(profile->entries[i].name, name) == 0)
+        {
+            return &profile->entries[i];
+        }
+    }
+    return NULL;
+}
+
+// Returns true if no two alternatives can match at the same input, and none can match empty input.
+static bool
+alternatives_are_disjoint(gdl_grammar_analysis_t const * analysis, gdl_ast_node_t * alternative_node)
+{
+    int count = alternative_node->data.alternative.alternatives.count;
+    gdl_char_set_t * sets = calloc(count, sizeof(*sets));
+    if (sets == NULL)
+    {
+        return false;
+    }
+
+    bool disjoint = true;
+    int i = 0;
+    for (gdl_ast_list_node_t * a = alternative_node->data.alternative.alternatives.head; a != NULL && disjoint;
+         a = a->next, i++)
+    {
+        gdl_char_set_clear(&sets[i]);
+        disjoint = !gdl_expression_first(analysis, a->item, &sets[i]) && !gdl_char_set_is_full(&sets[i]);
+        for (int j = 0; j < i && disjoint; j++)
+        {
+            disjoint = !gdl_char_set_intersects(&sets[i], &sets[j]);
+        }
+    }
+    free(sets);
+
+    return disjoint;
+}
+
+typedef struct
+{
+    gdl_ast_list_node_t * node;
+    unsigned long long matched;
+    int index;
+} ranked_alternative_t;
+
+static int
+compare_ranked_alternatives(void const * a, void const * b)
+{
+    ranked_alternative_t const * ra = a;
+    ranked_alternative_t const * rb = b;
+
+    if (ra->matched != rb->matched)
+    {
+        return ra->matched > rb->matched ? -1 : 1;
+    }
+    return ra->index - rb->index;
+}
+
+// Returns 1 if the alternatives were reordered, 0 if they were already in order, or -1 on error.
+static int
+reorder_alternatives(gdl_ast_node_t * alternative_node, gdl_profile_entry_t const * entry)
+{
+    gdl_ast_list_t * list = &alternative_node->data.alternative.alternatives;
+    ranked_alternative_t * ranked = calloc(list->count, sizeof(*ranked));
+    if (ranked == NULL)
+    {
+        perror("Failed to allocate the alternatives");
+        return -1;
+    }
+
+    int i = 0;
+    for (gdl_ast_list_node_t * a = list->head; a != NULL; a = a->next, i++)
+    {
+        ranked[i] = (ranked_alternative_t){ .node = a, .matched = entry->matched[i], .index = i };
+    }
+    qsort(ranked, list->count, sizeof(*ranked), compare_ranked_alternatives);
+
+    bool changed = false;
+    for (i = 0; i < list->count; i++)
+    {
+        changed |= ranked[i].index != i;
+        ranked[i].node->next = i + 1 < list->count ? ranked[i + 1].node : NULL;
+    }
+    list->head = ranked[0].node;
+    list->tail = ranked[list->count - 1].node;
+    free(ranked);
+
+    return changed ? 1 : 0;
+}
+
+int
+gdl_profile_reorder_alternatives(gdl_ast_node_t * program, gdl_profile_t const * profile)
+{
+    gdl_grammar_analysis_t analysis;
+    if (!gdl_grammar_analyze(program, &analysis))
+    {
+        return -1;
+    }
+
+    int reordered = 0;
+    for (int i = 0; i < analysis.count && reordered >= 0; i++)
+    {
+        gdl_rule_analysis_t const * rule = &analysis.rules[i];
+        gdl_ast_node_t * semantic_action = rule->rule_def->data.rule_def.semantic_action;
+        if (semantic_action != NULL && semantic_action->data.semantic_action.action_name != NULL)
+        {
+            continue;
+        }
+        gdl_ast_node_t * definition = unwrap_expression(rule->rule_def->data.rule_def.definition);
+        if (definition == NULL || definition->type != GDL_AST_NODE_TYPE_ALTERNATIVE
+            || definition->data.alternative.alternatives.count < 2)
+        {
+            continue;
+        }
+
+        char * name = to_pascal_case(rule->name);
+        if (name == NULL)
+        {
+            reordered = -1;
+            break;
+        }
+        gdl_profile_entry_t const * entry = profile_find(profile, name, definition->data.alternative.alternatives.count);
+        free(name);
+
+        // A left recursive rule is grown from its alternatives in order, so its order is kept.
+        if (entry != NULL && alternatives_are_disjoint(&analysis, definition)
+            && !gdl_rule_is_left_recursive(&analysis, rule))
+        {
+            int result = reorder_alternatives(definition, entry);
+            reordered = result < 0 ? -1 : reordered + result;
+        }
+    }
+    gdl_grammar_analysis_free(&analysis);
+
+    return reordered;
+}
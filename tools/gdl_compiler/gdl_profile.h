@@ -0,0 +1,37 @@
+#pragma once
+
+#include "gdl_ast.h"
+
+#include <stdbool.h>
+
+// The counts of one epc_or parser, as written by epc_alternative_profile_write().
+typedef struct
+{
+    char * name;
+    int count;                       // The number of alternatives.
+    unsigned long long * tried;      // Indexed by alternative.
+    unsigned long long * matched;
+} gdl_profile_entry_t;
+
+typedef struct
+{
+    gdl_profile_entry_t * entries;
+    int count;
+} gdl_profile_t;
+
+// Reads a profile written by epc_alternative_profile_write(). Lines starting with '#' are ignored. Returns false on error.
+bool gdl_profile_load(char const * path, gdl_profile_t * profile);
+
+void gdl_profile_free(gdl_profile_t * profile);
+
+/*
+ * Puts the alternatives of each rule in the profile in order of how often
+ * they matched, most often first, so the parser tries the likely ones first.
+ * A rule is only changed if its alternatives can't match the same input (no
+ * two start with the same byte, and none matches empty input), so the
+ * grammar still matches the same input in the same way. Like the optimizer,
+ * this leaves the rules with a semantic action alone, as the action may use
+ * the index of the alternative that matched.
+ * Returns the number of rules changed, or -1 on error.
+ */
+int gdl_profile_reorder_alternatives(gdl_ast_node_t * program, gdl_profile_t const * profile);
@@ -0,0 +1,185 @@
+#include "gdl_code_generator_common.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int
+gdl_rule_objects_rule_index(gdl_rule_objects_t * objects, char const * name)
+{
+    gdl_rule_analysis_t * rule = gdl_grammar_analysis_find_rule(objects->analysis, name);
+    if (rule == NULL)
+    {
+        fprintf(stderr, "Error: Reference to undefined rule '%s'.\n", name);
+        objects->has_error = true;
+        return -1;
+    }
+    return (int)(rule - objects->analysis->rules);
+}
+
+// Returns the rule referenced if the rule is defined as just a reference to another rule, else -1.
+static int
+rule_alias_of(gdl_rule_objects_t * objects, int index)
+{
+    gdl_ast_node_t * definition = unwrap_expression(objects->analysis->rules[index].rule_def->data.rule_def.definition);
+    if (definition == NULL || definition->type != GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+    {
+        return -1;
+    }
+    return gdl_rule_objects_rule_index(objects, definition->data.identifier_ref.name);
+}
+
+/*
+ * In the default backend a rule defined as just a reference to another rule
+ * is the same parser as that rule, so it gets no object of its own.
+ */
+static bool
+resolve_rule_objects(gdl_rule_objects_t * objects)
+{
+    for (int i = 0; i < objects->analysis->count; i++)
+    {
+        int index = i;
+        int hops = 0;
+        int target;
+        while ((target = rule_alias_of(objects, index)) >= 0)
+        {
+            index = target;
+            if (++hops > objects->analysis->count)
+            {
+                fprintf(stderr, "Error: Rule '%s' is defined only in terms of itself.\n", objects->analysis->rules[i].name);
+                return false;
+            }
+        }
+        if (objects->has_error)
+        {
+            return false;
+        }
+        objects->rule_object[i] = index;
+    }
+    return true;
+}
+
+/*
+ * Actions are given out in definition order, as the default backend does.
+ * A rule's own action (or lack of one) replaces any given to its object
+ * through an earlier alias, as epc_parser_duplicate() copies it over.
+ */
+static void
+assign_rule_actions(gdl_rule_objects_t * objects)
+{
+    for (int i = 0; i < objects->analysis->count; i++)
+    {
+        gdl_ast_node_t * semantic_action = objects->analysis->rules[i].rule_def->data.rule_def.semantic_action;
+        char const * action_name = semantic_action != NULL ? semantic_action->data.semantic_action.action_name : NULL;
+
+        if (objects->rule_object[i] == i)
+        {
+            objects->rule_actions[i] = action_name;
+        }
+        else if (action_name != NULL)
+        {
+            objects->rule_actions[objects->rule_object[i]] = action_name;
+        }
+    }
+}
+
+typedef struct
+{
+    gdl_rule_objects_t * objects;
+    int rule_index;
+} reference_ctx_t;
+
+static void
+visit_references(gdl_ast_node_t * node, void * user_data)
+{
+    reference_ctx_t * ref = user_data;
+    gdl_rule_objects_t * objects = ref->objects;
+
+    if (node == NULL)
+    {
+        return;
+    }
+    if (node->type == GDL_AST_NODE_TYPE_IDENTIFIER_REF)
+    {
+        int target = gdl_rule_objects_rule_index(objects, node->data.identifier_ref.name);
+        if (target < 0)
+        {
+            return;
+        }
+        int object = objects->rule_object[target];
+        if (object >= ref->rule_index)
+        {
+            objects->rule_wrapped[object] = true;
+        }
+        if (!objects->rule_reachable[object])
+        {
+            objects->rule_reachable[object] = true;
+            reference_ctx_t object_ref = { .objects = objects, .rule_index = object };
+            visit_references(objects->analysis->rules[object].rule_def->data.rule_def.definition, &object_ref);
+        }
+        return;
+    }
+    gdl_expression_for_each_child(node, visit_references, ref);
+}
+
+bool
+gdl_rule_objects_init(gdl_rule_objects_t * objects, gdl_grammar_analysis_t const * analysis)
+{
+    *objects = (gdl_rule_objects_t){ .analysis = analysis };
+
+    if (analysis->count == 0)
+    {
+        fprintf(stderr, "Error: The grammar has no rules.\n");
+        return false;
+    }
+    objects->rule_object = calloc(analysis->count, sizeof(*objects->rule_object));
+    objects->rule_wrapped = calloc(analysis->count, sizeof(*objects->rule_wrapped));
+    objects->rule_reachable = calloc(analysis->count, sizeof(*objects->rule_reachable));
+    objects->rule_actions = calloc(analysis->count, sizeof(*objects->rule_actions));
+    if (objects->rule_object == NULL || objects->rule_wrapped == NULL
+        || objects->rule_reachable == NULL || objects->rule_actions == NULL)
+    {
+        perror("Failed to allocate rule objects");
+        gdl_rule_objects_free(objects);
+        return false;
+    }
+    if (!resolve_rule_objects(objects))
+    {
+        gdl_rule_objects_free(objects);
+        return false;
+    }
+    assign_rule_actions(objects);
+    for (int i = 0; i < analysis->count; i++)
+    {
+        // Wrapping the rule keeps its cuts from committing its callers' alternatives.
+        if (objects->rule_object[i] == i && expression_has_unscoped_cut(analysis->rules[i].rule_def->data.rule_def.definition))
+        {
+            objects->rule_wrapped[i] = true;
+        }
+    }
+
+    // As with the default backend, the last rule is the one the parser starts with.
+    objects->start_object = objects->rule_object[analysis->count - 1];
+    objects->rule_reachable[objects->start_object] = true;
+    reference_ctx_t ref = { .objects = objects, .rule_index = objects->start_object };
+    visit_references(analysis->rules[objects->start_object].rule_def->data.rule_def.definition, &ref);
+    if (objects->has_error)
+    {
+        gdl_rule_objects_free(objects);
+        return false;
+    }
+
+    return true;
+}
+
+void
+gdl_rule_objects_free(gdl_rule_objects_t * objects)
+{
+    free(objects->rule_object);
+    free(objects->rule_wrapped);
+    free(objects->rule_reachable);
+    free(objects->rule_actions);
+    objects->rule_object = NULL;
+    objects->rule_wrapped = NULL;
+    objects->rule_reachable = NULL;
+    objects->rule_actions = NULL;
+}
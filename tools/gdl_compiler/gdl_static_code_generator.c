@@ -0,0 +1,863 @@
+#include "gdl_code_generator.h"
+#include "gdl_code_generator_common.h"
+#include "gdl_grammar_analysis.h"
+#include "gdl_token_dfa.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The static backend emits the same parser graph as the default backend, but
+ * as statically initialized `const` epc_parser_t objects rather than code
+ * that builds the graph at run time. Each object is given the parse function,
+ * data, name and expected value that the constructor the default backend
+ * calls would have given it, so the CPT and errors are the same. Creating the
+ * parser then just returns the address of the start rule's object.
+ *
+ * Rules referenced from themselves or from an earlier rule are the ones the
+ * default backend completes with epc_parser_duplicate(). Their objects use
+ * epc_rule_parse_fn, or epc_left_recursive_rule_parse_fn if they are
+ * left-recursive, so left recursion is handled the same way.
+ */
+
+typedef struct
+{
+    FILE * source;
+    gdl_grammar_analysis_t analysis;
+    gdl_rule_objects_t objects;
+    int rule_index;                 // The rule being generated.
+    char * rule_name;               // PascalCase name of the rule being generated.
+    int object_count;               // For naming the objects of the rule being generated.
+    gdl_token_dfa_t token_dfa;
+    bool has_error;
+} static_generator_t;
+
+// The fields of an epc_parser_t object, as C initializers.
+typedef struct
+{
+    char const * parse_fn;
+    char const * name;
+    char * data;                // NULL if the parser has no data.
+    char * expected_value;      // NULL if the parser has no expected value.
+} static_parser_t;
+
+static char *
+static_emit_expression(static_generator_t * gen, gdl_ast_node_t * node, char const * expression_name, char const * object_name);
+
+// --- Keyword tries ---
+
+typedef struct
+{
+    int first_child;
+    int next_sibling;
+    int keyword_index;
+    unsigned char c;
+} static_trie_node_t;
+
+typedef struct
+{
+    static_trie_node_t * nodes;
+    int count;
+    int capacity;
+} static_trie_t;
+
+static int
+static_trie_node_add(static_trie_t * trie, unsigned char c)
+{
+    if (trie->count == trie->capacity)
+    {
+        int new_capacity = trie->capacity > 0 ? trie->capacity * 2 : 16;
+        static_trie_node_t * new_nodes = realloc(trie->nodes, new_capacity * sizeof(*new_nodes));
+        if (new_nodes == NULL)
+        {
+            return -1;
+        }
+        trie->nodes = new_nodes;
+        trie->capacity = new_capacity;
+    }
+
+    int index = trie->count++;
+    trie->nodes[index] = (static_trie_node_t){ .first_child = -1, .next_sibling = -1, .keyword_index = -1, .c = c };
+
+    return index;
+}
+
+// Inserts the keyword exactly as keyword_trie_insert() in the library does, so the nodes come out the same.
+static bool
+static_trie_insert(static_trie_t * trie, char const * keyword, int keyword_index)
+{
+    int current = 0;
+
+    for (unsigned char const * k = (unsigned char const *)keyword; *k != '\0'; k++)
+    {
+        int prev = -1;
+        int child = trie->nodes[current].first_child;
+        while (child >= 0 && trie->nodes[child].c < *k)
+        {
+            prev = child;
+            child = trie->nodes[child].next_sibling;
+        }
+        if (child < 0 || trie->nodes[child].c != *k)
+        {
+            int new_child = static_trie_node_add(trie, *k);
+            if (new_child < 0)
+            {
+                return false;
+            }
+            trie->nodes[new_child].next_sibling = child;
+            if (prev < 0)
+            {
+                trie->nodes[current].first_child = new_child;
+            }
+            else
+            {
+                trie->nodes[prev].next_sibling = new_child;
+            }
+            child = new_child;
+        }
+        current = child;
+    }
+
+    if (trie->nodes[current].keyword_index < 0)
+    {
+        trie->nodes[current].keyword_index = keyword_index;
+    }
+
+    return true;
+}
+
+// Writes the epc_keywords_data_t for an alternation of string literals, returning the name of the object.
+static char *
+static_emit_keywords_data(static_generator_t * gen, gdl_ast_node_t * node, char const * object_name)
+{
+    gdl_ast_list_t * alternatives = &node->data.alternative.alternatives;
+    static_trie_t trie = { 0 };
+    bool ok = static_trie_node_add(&trie, '\0') == 0;
+    int index = 0;
+
+    for (gdl_ast_list_node_t * alt = alternatives->head; ok && alt != NULL; alt = alt->next, index++)
+    {
+        char * keyword = c_string_unescape(alternative_string_literal_value(alt->item));
+        ok = keyword != NULL && static_trie_insert(&trie, keyword, index);
+        free(keyword);
+    }
+    if (!ok)
+    {
+        perror("Failed to build keyword trie");
+        free(trie.nodes);
+        gen->has_error = true;
+        return NULL;
+    }
+
+    fprintf(gen->source, "static char * const %s_keywords[] = {\n", object_name);
+    for (gdl_ast_list_node_t * alt = alternatives->head; alt != NULL; alt = alt->next)
+    {
+        fprintf(gen->source, "    \"%s\",\n", alternative_string_literal_value(alt->item));
+    }
+    fprintf(gen->source, "};\n\n");
+
+    fprintf(gen->source, "static const epc_keyword_trie_node_t %s_nodes[] = {\n", object_name);
+    for (int i = 0; i < trie.count; i++)
+    {
+        char * c = c_char_constant(trie.nodes[i].c);
+        fprintf(gen->source, "    { %d, %d, %d, %s },\n",
+                trie.nodes[i].first_child, trie.nodes[i].next_sibling, trie.nodes[i].keyword_index, c);
+        free(c);
+    }
+    fprintf(gen->source, "};\n\n");
+
+    fprintf(gen->source, "static const epc_keywords_data_t %s_data = {\n", object_name);
+    fprintf(gen->source, "    .keywords = (char * *)%s_keywords,\n", object_name);
+    fprintf(gen->source, "    .count = %d,\n", alternatives->count);
+    fprintf(gen->source, "    .nodes = (epc_keyword_trie_node_t *)%s_nodes,\n", object_name);
+    fprintf(gen->source, "    .node_count = %d,\n", trie.count);
+    fprintf(gen->source, "    .node_capacity = %d,\n", trie.count);
+    fprintf(gen->source, "    .expected = \"");
+    for (gdl_ast_list_node_t * alt = alternatives->head; alt != NULL; alt = alt->next)
+    {
+        fprintf(gen->source, "%s%s", alternative_string_literal_value(alt->item), alt->next != NULL ? " or " : "");
+    }
+    fprintf(gen->source, "\",\n");
+    fprintf(gen->source, "};\n\n");
+
+    free(trie.nodes);
+
+    return str_printf("%s_data", object_name);
+}
+
+// --- Parser objects ---
+
+static char *
+static_object_name(static_generator_t * gen, char const * object_name)
+{
+    if (object_name != NULL)
+    {
+        return strdup(object_name);
+    }
+    return str_printf("%s_%d", gen->rule_name, ++gen->object_count);
+}
+
+static void
+static_write_parser(static_generator_t * gen, char const * object_name, static_parser_t const * parser)
+{
+    bool is_rule = strcmp(object_name, gen->rule_name) == 0;
+    FILE * source = gen->source;
+
+    fprintf(source, "static const epc_parser_t %s = {\n", object_name);
+    if (is_rule && gen->objects.rule_wrapped[gen->rule_index])
+    {
+        bool left_recursive = gdl_rule_is_left_recursive(&gen->analysis, &gen->analysis.rules[gen->rule_index]);
+        fprintf(source, "    .parse_fn = %s,\n", left_recursive ? "epc_left_recursive_rule_parse_fn" : "epc_rule_parse_fn");
+        fprintf(source, "    .rule_parse_fn = %s,\n", parser->parse_fn);
+    }
+    else
+    {
+        fprintf(source, "    .parse_fn = %s,\n", parser->parse_fn);
+    }
+    if (parser->data != NULL)
+    {
+        fprintf(source, "    .data = { %s },\n", parser->data);
+    }
+    fprintf(source, "    .name = \"%s\",\n", parser->name);
+    if (parser->expected_value != NULL)
+    {
+        fprintf(source, "    .expected_value = %s,\n", parser->expected_value);
+    }
+    if (is_rule && gen->objects.rule_actions[gen->rule_index] != NULL)
+    {
+        char * action = to_upper_case(gen->objects.rule_actions[gen->rule_index]);
+        fprintf(source, "    .ast_config = { .assigned = true, .action = %s },\n", action);
+        free(action);
+    }
+    fprintf(source, "};\n\n");
+}
+
+// Emits a parser with the given fields, taking ownership of its data and expected value.
+static char *
+static_emit_parser(static_generator_t * gen, char const * object_name, static_parser_t parser)
+{
+    char * name = static_object_name(gen, object_name);
+
+    if (name != NULL)
+    {
+        static_write_parser(gen, name, &parser);
+    }
+    else
+    {
+        gen->has_error = true;
+    }
+    free(parser.data);
+    free(parser.expected_value);
+
+    return name;
+}
+
+// Emits a parser with a single child, kept in data.other.
+static char *
+static_emit_unary(
+    static_generator_t * gen,
+    gdl_ast_node_t * child_node,
+    char const * parse_fn,
+    char const * name,
+    char const * object_name)
+{
+    char * child = static_emit_expression(gen, child_node, NULL, NULL);
+    if (child == NULL)
+    {
+        return NULL;
+    }
+    static_parser_t parser = {
+        .parse_fn = parse_fn,
+        .name = name,
+        .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_OTHER, .other = (epc_parser_t *)&%s", child),
+    };
+    free(child);
+
+    return static_emit_parser(gen, object_name, parser);
+}
+
+// Emits a parser with two children, kept in data.delimited.
+static char *
+static_emit_binary(
+    static_generator_t * gen,
+    gdl_ast_node_t * item_node,
+    gdl_ast_node_t * delimiter_node,
+    char const * parse_fn,
+    char const * name,
+    char const * object_name)
+{
+    char * item = static_emit_expression(gen, item_node, NULL, NULL);
+    char * delimiter = item != NULL ? static_emit_expression(gen, delimiter_node, NULL, NULL) : NULL;
+    if (delimiter == NULL)
+    {
+        free(item);
+        return NULL;
+    }
+    static_parser_t parser = {
+        .parse_fn = parse_fn,
+        .name = name,
+        .data = str_printf(
+            ".data_type = EPC_PARSER_DATA_TYPE_DELIMITED, "
+            ".delimited = { .item = (epc_parser_t *)&%s, .delimiter = (epc_parser_t *)&%s }",
+            item, delimiter),
+    };
+    free(item);
+    free(delimiter);
+
+    return static_emit_parser(gen, object_name, parser);
+}
+
+// Emits an epc_and or epc_or, with its children in a epc_parser_list_data_t.
+static char *
+static_emit_list(
+    static_generator_t * gen,
+    gdl_ast_list_t * list,
+    gdl_char_set_t const * first,
+    char const * parse_fn,
+    char const * name,
+    char const * object_name)
+{
+    char * * children = calloc(list->count, sizeof(*children));
+    if (children == NULL)
+    {
+        gen->has_error = true;
+        return NULL;
+    }
+
+    int count = 0;
+    for (gdl_ast_list_node_t * item = list->head; item != NULL; item = item->next)
+    {
+        children[count] = static_emit_expression(gen, item->item, NULL, NULL);
+        if (children[count] == NULL)
+        {
+            break;
+        }
+        count++;
+    }
+
+    char * result = NULL;
+    char * list_name = count == list->count ? static_object_name(gen, object_name) : NULL;
+    if (list_name != NULL)
+    {
+        fprintf(gen->source, "static epc_parser_t * const %s_children[] = {\n", list_name);
+        for (int i = 0; i < count; i++)
+        {
+            fprintf(gen->source, "    (epc_parser_t *)&%s,\n", children[i]);
+        }
+        fprintf(gen->source, "};\n\n");
+        if (first != NULL)
+        {
+            fprintf(gen->source, "static const epc_first_set_t %s_first[] = {\n", list_name);
+            for (int i = 0; i < count; i++)
+            {
+                fprintf(gen->source, "    ");
+                write_first_set_initializer(gen->source, &first[i]);
+                fprintf(gen->source, ",\n");
+            }
+            fprintf(gen->source, "};\n\n");
+            fprintf(gen->source, "static const epc_parser_list_data_t %s_list = { (epc_parser_t * *)%s_children, %d, %s_first };\n\n",
+                    list_name, list_name, count, list_name);
+        }
+        else
+        {
+            fprintf(gen->source, "static const epc_parser_list_data_t %s_list = { (epc_parser_t * *)%s_children, %d, NULL };\n\n",
+                    list_name, list_name, count);
+        }
+
+        static_parser_t parser = {
+            .parse_fn = parse_fn,
+            .name = name,
+            .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_PARSER_LIST, .parser_list = (epc_parser_list_data_t *)&%s_list", list_name),
+        };
+        static_write_parser(gen, list_name, &parser);
+        free(parser.data);
+        result = list_name;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        free(children[i]);
+    }
+    free(children);
+
+    return result;
+}
+
+static char *
+static_emit_keyword(static_generator_t * gen, char const * keyword_name, char const * object_name)
+{
+    // These mirror the epc_xxx() constructor for each keyword, which the default backend names after the keyword.
+    static struct
+    {
+        char const * keyword;
+        char const * parse_fn;
+        char const * name;
+        char const * expected_value;
+    } const keywords[] = {
+        { "eoi", "epc_eoi_parse_fn", "eoi", NULL },
+        { "digit", "epc_digit_parse_fn", "digit", "\"digit\"" },
+        { "alpha", "epc_alpha_parse_fn", "alpha", "\"alpha\"" },
+        { "alphanum", "epc_alphanum_parse_fn", "alphanum", NULL },
+        { "space", "epc_space_parse_fn", "space", "\"whitespace\"" },
+        { "any_char", "epc_any_char_parse_fn", "any_char", NULL },
+        { "succeed", "epc_succeed_parse_fn", "succeed", NULL },
+        { "~", "epc_cut_parse_fn", "cut", NULL },
+        { "hex_digit", "epc_hex_digit_parse_fn", "hex_digit", "\"hex_digit\"" },
+        { "int", "epc_int_parse_fn", "int", NULL },
+        { "double", "epc_double_parse_fn", "double", "\"double\"" },
+    };
+
+    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++)
+    {
+        if (strcmp(keyword_name, keywords[i].keyword) == 0)
+        {
+            static_parser_t parser = {
+                .parse_fn = keywords[i].parse_fn,
+                .name = keywords[i].name,
+                .expected_value = keywords[i].expected_value != NULL ? strdup(keywords[i].expected_value) : NULL,
+            };
+            return static_emit_parser(gen, object_name, parser);
+        }
+    }
+
+    fprintf(stderr, "Error: Unsupported GDL keyword '%s' for code generation.\n", keyword_name);
+    gen->has_error = true;
+    return NULL;
+}
+
+/*
+ * Emits the objects for an expression, children first, and returns the name
+ * of the expression's object. expression_name is the name the default
+ * backend gives the parser, or NULL if it leaves it to the constructor.
+ * object_name is the name of the C object, or NULL to make one up.
+ */
+static char *
+static_emit_expression(static_generator_t * gen, gdl_ast_node_t * node, char const * expression_name, char const * object_name)
+{
+    node = unwrap_expression(node);
+    if (node == NULL)
+    {
+        gen->has_error = true;
+        return NULL;
+    }
+
+#define NAME_OR(default_name) (expression_name != NULL ? expression_name : (default_name))
+
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
+    {
+        int index = gdl_rule_objects_rule_index(&gen->objects, node->data.identifier_ref.name);
+        if (index < 0)
+        {
+            gen->has_error = true;
+            return NULL;
+        }
+        return to_pascal_case(gen->analysis.rules[gen->objects.rule_object[index]].name);
+    }
+
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+    {
+        char const * value = node->data.string_literal.value;
+        static_parser_t parser = {
+            .parse_fn = "epc_string_parse_fn",
+            .name = NAME_OR("string_parser"),
+            .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_STRING, .string = \"%s\"", value),
+            .expected_value = str_printf("\"%s\"", value),
+        };
+        return static_emit_parser(gen, object_name, parser);
+    }
+
+    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
+    {
+        char * literal = c_string_literal_of_char((unsigned char)node->data.char_literal.value);
+        static_parser_t parser = {
+            .parse_fn = "epc_char_parse_fn",
+            .name = NAME_OR("char_parser"),
+            .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_STRING, .string = %s", literal),
+            .expected_value = literal,
+        };
+        return static_emit_parser(gen, object_name, parser);
+    }
+
+    case GDL_AST_NODE_TYPE_CHAR_RANGE:
+    {
+        char * start = c_char_constant((unsigned char)node->data.char_range.start_char);
+        char * end = c_char_constant((unsigned char)node->data.char_range.end_char);
+        static_parser_t parser = {
+            .parse_fn = "epc_char_range_parse_fn",
+            .name = NAME_OR("char_range"),
+            .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_CHAR_RANGE, .range = { %s, %s }", start, end),
+        };
+        free(start);
+        free(end);
+        return static_emit_parser(gen, object_name, parser);
+    }
+
+    case GDL_AST_NODE_TYPE_KEYWORD:
+        return static_emit_keyword(gen, node->data.keyword.name, object_name);
+
+    case GDL_AST_NODE_TYPE_FAIL_CALL:
+    {
+        static_parser_t parser = {
+            .parse_fn = "epc_fail_parse_fn",
+            // The default backend passes the name as a string even when there isn't one.
+            .name = NAME_OR("NULL"),
+            .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_STRING, .string = \"%s\"", node->data.string_literal.value),
+        };
+        return static_emit_parser(gen, object_name, parser);
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
+    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
+    {
+        bool none_of = node->type == GDL_AST_NODE_TYPE_COMBINATOR_NONEOF;
+        if (node->data.none_or_one_of_call.args == NULL)
+        {
+            gen->has_error = true;
+            return NULL;
+        }
+        static_parser_t parser = {
+            .parse_fn = none_of ? "epc_none_of_parse_fn" : "epc_one_of_parse_fn",
+            .name = NAME_OR(none_of ? "none_of" : "one_of_parser"),
+            .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_STRING, .string = \"%s\"", node->data.none_or_one_of_call.args),
+        };
+        return static_emit_parser(gen, object_name, parser);
+    }
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+        if (node->data.sequence.elements.count == 0)
+        {
+            static_parser_t parser = { .parse_fn = "epc_succeed_parse_fn", .name = "empty_seq" };
+            return static_emit_parser(gen, object_name, parser);
+        }
+        return static_emit_list(gen, &node->data.sequence.elements, NULL, "epc_and_parse_fn", NAME_OR("and_parser"), object_name);
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+    {
+        if (node->data.alternative.alternatives.count == 0)
+        {
+            static_parser_t parser = {
+                .parse_fn = "epc_fail_parse_fn",
+                .name = "empty_alt",
+                .data = strdup(".data_type = EPC_PARSER_DATA_TYPE_STRING, .string = \"empty_alt\""),
+            };
+            return static_emit_parser(gen, object_name, parser);
+        }
+        if (alternative_is_keyword_set(node))
+        {
+            char * name = static_object_name(gen, object_name);
+            char * data = name != NULL ? static_emit_keywords_data(gen, node, name) : NULL;
+            if (data == NULL)
+            {
+                free(name);
+                return NULL;
+            }
+            static_parser_t parser = {
+                .parse_fn = "epc_keywords_parse_fn",
+                .name = NAME_OR("keywords_parser"),
+                .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_KEYWORDS, .keywords = (epc_keywords_data_t *)&%s", data),
+            };
+            static_write_parser(gen, name, &parser);
+            free(parser.data);
+            free(data);
+            return name;
+        }
+        gdl_char_set_t * first = alternative_predict_sets(&gen->analysis, node);
+        char * result = static_emit_list(
+            gen, &node->data.alternative.alternatives, first, "epc_or_parse_fn", NAME_OR("or_parser"), object_name);
+        free(first);
+        return result;
+    }
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+    {
+        gdl_ast_node_t * child = node->data.repetition_expr.expression;
+        switch (node->data.repetition_expr.repetition->data.repetition_op.operator_char)
+        {
+        case '*':
+            return static_emit_unary(gen, child, "epc_many_parse_fn", NAME_OR("many_parser"), object_name);
+        case '+':
+            return static_emit_unary(gen, child, "epc_plus_parse_fn", NAME_OR("plus_parser"), object_name);
+        case '?':
+            return static_emit_unary(gen, child, "epc_optional_parse_fn", NAME_OR("optional_parser"), object_name);
+        default:
+            fprintf(stderr, "Error: Unknown repetition operator '%c'.\n",
+                    node->data.repetition_expr.repetition->data.repetition_op.operator_char);
+            gen->has_error = true;
+            return NULL;
+        }
+    }
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        return static_emit_unary(gen, node->data.optional.expr, "epc_optional_parse_fn", NAME_OR("optional_parser"), object_name);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+        return static_emit_unary(gen, node->data.unary_combinator_call.expr, "epc_not_parse_fn", NAME_OR("not_parser"), object_name);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+        return static_emit_unary(
+            gen, node->data.unary_combinator_call.expr, "epc_lookahead_parse_fn", NAME_OR("lookahead_parser"), object_name);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+        return static_emit_unary(gen, node->data.unary_combinator_call.expr, "epc_skip_parse_fn", NAME_OR("skip_parser"), object_name);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        return static_emit_unary(
+            gen, node->data.unary_combinator_call.expr, "epc_passthru_parse_fn", NAME_OR("passthru_parser"), object_name);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+    {
+        char * child = static_emit_expression(gen, node->data.unary_combinator_call.expr, NULL, NULL);
+        if (child == NULL)
+        {
+            return NULL;
+        }
+        static_parser_t parser = {
+            .parse_fn = "epc_lexeme_parse_fn",
+            .name = NAME_OR("lexeme_parser"),
+            .data = str_printf(
+                ".data_type = EPC_PARSER_DATA_TYPE_LEXEME, .lexeme = { .parser = (epc_parser_t *)&%s, .consume_comments = true }",
+                child),
+        };
+        free(child);
+        return static_emit_parser(gen, object_name, parser);
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+    {
+        char * child = static_emit_expression(gen, node->data.count_call.expression, NULL, NULL);
+        if (child == NULL)
+        {
+            return NULL;
+        }
+        static_parser_t parser = {
+            .parse_fn = "epc_count_parse_fn",
+            .name = NAME_OR("count_parser"),
+            .data = str_printf(
+                ".data_type = EPC_PARSER_DATA_TYPE_COUNT, .count = { .count = %lld, .parser = (epc_parser_t *)&%s }",
+                node->data.count_call.count_node->data.number_literal.value, child),
+        };
+        free(child);
+        return static_emit_parser(gen, object_name, parser);
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+    {
+        char * open = static_emit_expression(gen, node->data.between_call.open_expr, NULL, NULL);
+        char * content = open != NULL ? static_emit_expression(gen, node->data.between_call.content_expr, NULL, NULL) : NULL;
+        char * close = content != NULL ? static_emit_expression(gen, node->data.between_call.close_expr, NULL, NULL) : NULL;
+        char * result = NULL;
+        if (close != NULL)
+        {
+            static_parser_t parser = {
+                .parse_fn = "epc_between_parse_fn",
+                .name = NAME_OR("between_parser"),
+                .data = str_printf(
+                    ".data_type = EPC_PARSER_DATA_TYPE_BETWEEN, .between = { "
+                    ".open = (epc_parser_t *)&%s, .parser = (epc_parser_t *)&%s, .close = (epc_parser_t *)&%s }",
+                    open, content, close),
+            };
+            result = static_emit_parser(gen, object_name, parser);
+        }
+        free(open);
+        free(content);
+        free(close);
+        return result;
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        return static_emit_binary(
+            gen,
+            node->data.delimited_call.item_expr,
+            node->data.delimited_call.delimiter_expr,
+            "epc_delimited_parse_fn",
+            NAME_OR("delimited_parser"),
+            object_name);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+        return static_emit_binary(
+            gen,
+            node->data.chain_combinator_call.item_expr,
+            node->data.chain_combinator_call.op_expr,
+            "epc_chainl1_parse_fn",
+            NAME_OR("chainl1_parser"),
+            object_name);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        return static_emit_binary(
+            gen,
+            node->data.chain_combinator_call.item_expr,
+            node->data.chain_combinator_call.op_expr,
+            "epc_chainr1_parse_fn",
+            NAME_OR("chainr1_parser"),
+            object_name);
+
+    case GDL_AST_NODE_TYPE_TOKEN_DFA:
+    {
+        char * dfa_name = gdl_token_dfa_object_name(node->data.token_dfa.rule_name);
+        char * rule_name = to_pascal_case(node->data.token_dfa.rule_name);
+        char * result = NULL;
+        if (dfa_name != NULL && rule_name != NULL)
+        {
+            static_parser_t parser = {
+                .parse_fn = "epc_dfa_parse_fn",
+                .name = NAME_OR(rule_name),
+                .data = str_printf(".data_type = EPC_PARSER_DATA_TYPE_DFA, .dfa = &%s", dfa_name),
+            };
+            result = static_emit_parser(gen, object_name, parser);
+        }
+        else
+        {
+            gen->has_error = true;
+        }
+        free(dfa_name);
+        free(rule_name);
+        return result;
+    }
+
+    default:
+        fprintf(stderr, "Error: Unsupported AST node type for code generation: %d\n", node->type);
+        gen->has_error = true;
+        return NULL;
+    }
+
+#undef NAME_OR
+}
+
+static bool
+static_generate_rule(static_generator_t * gen, int index)
+{
+    gdl_rule_analysis_t * rule = &gen->analysis.rules[index];
+
+    gen->rule_index = index;
+    gen->rule_name = to_pascal_case(rule->name);
+    gen->object_count = 0;
+
+    fprintf(gen->source, "// --- Rule: %s ---\n\n", rule->name);
+    char * object = static_emit_expression(gen, rule->rule_def->data.rule_def.definition, gen->rule_name, gen->rule_name);
+    bool success = object != NULL && !gen->has_error;
+
+    free(object);
+    free(gen->rule_name);
+    gen->rule_name = NULL;
+
+    return success;
+}
+
+bool
+gdl_generate_static_c_code(gdl_ast_node_t * ast_root, const char * base_name, const char * output_dir)
+{
+    if (ast_root == NULL || ast_root->type != GDL_AST_NODE_TYPE_PROGRAM || base_name == NULL || output_dir == NULL)
+    {
+        fprintf(stderr, "Error: Invalid arguments or AST root type to gdl_generate_static_c_code.\n");
+        return false;
+    }
+
+    fprintf(stdout, "Generating static C code for '%s' in '%s'...\n", base_name, output_dir);
+
+    static_generator_t gen = { 0 };
+    bool success = false;
+    bool * token_used = NULL;
+
+    // Token rules are matched by a DFA, so their definitions aren't generated as parsers.
+    if (!gdl_token_dfa_build(ast_root, &gen.token_dfa))
+    {
+        gdl_token_dfa_free(&gen.token_dfa);
+        return false;
+    }
+    if (!gdl_grammar_analyze(ast_root, &gen.analysis))
+    {
+        gdl_token_dfa_free(&gen.token_dfa);
+        return false;
+    }
+    if (!gdl_rule_objects_init(&gen.objects, &gen.analysis))
+    {
+        gdl_grammar_analysis_free(&gen.analysis);
+        gdl_token_dfa_free(&gen.token_dfa);
+        return false;
+    }
+
+    if (!gdl_generate_semantic_actions_header(ast_root, base_name, output_dir)
+        || !gdl_generate_parser_header(base_name, output_dir))
+    {
+        goto done;
+    }
+
+    char source_filename[512];
+    snprintf(source_filename, sizeof(source_filename), "%s.c", base_name);
+    gdl_output_file_t output;
+    if (!gdl_output_file_open(&output, output_dir, source_filename))
+    {
+        goto done;
+    }
+    gen.source = output.stream;
+
+    fprintf(gen.source, "// Generated source for %s (static backend)\n", base_name);
+    fprintf(gen.source, "#include \"%s.h\"\n", base_name);
+    fprintf(gen.source, "#include \"%s_actions.h\"\n", base_name);
+    fprintf(gen.source, "#include <easy_pc/easy_pc.h>\n");
+    fprintf(gen.source, "#include \"easy_pc_parser_layout.h\"\n");
+    fprintf(gen.source, "#include <stdbool.h>\n");
+    fprintf(gen.source, "#include <stddef.h>\n\n");
+
+    // Only the DFAs of the tokens that are generated are referenced.
+    token_used = calloc(gen.token_dfa.token_count > 0 ? gen.token_dfa.token_count : 1, sizeof(*token_used));
+    if (token_used == NULL)
+    {
+        perror("Failed to allocate static code generator");
+        gdl_output_file_close(&output, false);
+        goto done;
+    }
+    for (int t = 0; t < gen.token_dfa.token_count; t++)
+    {
+        int index = gdl_rule_objects_rule_index(&gen.objects, gen.token_dfa.tokens[t].rule->data.rule_def.name);
+        token_used[t] = index >= 0 && gen.objects.rule_reachable[index];
+    }
+    gdl_token_dfa_write_tables(gen.source, &gen.token_dfa, token_used);
+
+    // The rules can be mutually recursive.
+    for (int i = 0; i < gen.analysis.count; i++)
+    {
+        if (gen.objects.rule_reachable[i])
+        {
+            char * name = to_pascal_case(gen.analysis.rules[i].name);
+            fprintf(gen.source, "static const epc_parser_t %s;\n", name);
+            free(name);
+        }
+    }
+    fprintf(gen.source, "\n");
+
+    success = true;
+    for (int i = 0; i < gen.analysis.count && success; i++)
+    {
+        if (gen.objects.rule_reachable[i] && !static_generate_rule(&gen, i))
+        {
+            fprintf(stderr, "Error: Failed to generate rule '%s'.\n", gen.analysis.rules[i].name);
+            success = false;
+        }
+    }
+
+    if (success)
+    {
+        char * start_name = to_pascal_case(gen.analysis.rules[gen.objects.start_object].name);
+        fprintf(gen.source, "// The parsers are static, so the list isn't used and the parser must not be freed.\n");
+        fprintf(gen.source, "epc_parser_t * create_%s_parser(epc_parser_list * list)\n", base_name);
+        fprintf(gen.source, "{\n");
+        fprintf(gen.source, "    (void)list;\n");
+        fprintf(gen.source, "    return (epc_parser_t *)&%s;\n", start_name);
+        fprintf(gen.source, "}\n");
+        free(start_name);
+    }
+
+    success = gdl_output_file_close(&output, success) && success;
+
+done:
+    gdl_rule_objects_free(&gen.objects);
+    free(token_used);
+    gdl_grammar_analysis_free(&gen.analysis);
+    gdl_token_dfa_free(&gen.token_dfa);
+
+    return success;
+}
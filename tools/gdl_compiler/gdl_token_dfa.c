@@ -0,0 +1,1316 @@
+#include "gdl_token_dfa.h"
+#include "gdl_code_generator_common.h"
+#include "gdl_grammar_analysis.h"
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The DFA is built the textbook way: a Thompson NFA for each token, the
+ * subset construction over all of them at once, then Moore's partition
+ * refinement to minimize the result. Input bytes that no token tells apart
+ * share a class, which keeps the transition table small.
+ * The end of the input is never part of a token, so byte 0 is left out of
+ * every transition, and the generated code stops at it.
+ */
+
+// Transitions are written as unsigned shorts.
+#define MAX_DFA_STATES 65535
+
+// --- Interning arrays of ints ---
+
+typedef struct
+{
+    int * keys;        // All the keys, one after another.
+    size_t keys_len;
+    size_t keys_capacity;
+    size_t * offsets;  // Where each key starts in keys, indexed by id.
+    int * lengths;
+    int count;
+    int capacity;
+    int * buckets;     // Key ids, or -1 if the bucket is free.
+    int bucket_count;  // A power of 2.
+} int_array_table_t;
+
+static unsigned
+int_array_hash(int const * key, int len)
+{
+    unsigned hash = 2166136261u;
+
+    for (int i = 0; i < len; i++)
+    {
+        hash = (hash ^ (unsigned)key[i]) * 16777619u;
+    }
+    return hash ^ (unsigned)len;
+}
+
+static bool
+int_array_table_grow_buckets(int_array_table_t * table)
+{
+    int bucket_count = table->bucket_count == 0 ? 64 : table->bucket_count * 2;
+    int * buckets = malloc(bucket_count * sizeof(*buckets));
+    if (buckets == NULL)
+    {
+        return false;
+    }
+    for (int i = 0; i < bucket_count; i++)
+    {
+        buckets[i] = -1;
+    }
+    for (int id = 0; id < table->count; id++)
+    {
+        unsigned mask = (unsigned)bucket_count - 1;
+        unsigned b = int_array_hash(table->keys + table->offsets[id], table->lengths[id]) & mask;
+        while (buckets[b] >= 0)
+        {
+            b = (b + 1) & mask;
+        }
+        buckets[b] = id;
+    }
+    free(table->buckets);
+    table->buckets = buckets;
+    table->bucket_count = bucket_count;
+    return true;
+}
+
+// Returns the id of the key, adding it if it is new, or -1 if out of memory.
+static int
+int_array_table_intern(int_array_table_t * table, int const * key, int len, bool * added)
+{
+    *added = false;
+    if ((table->count + 1) * 2 > table->bucket_count && !int_array_table_grow_buckets(table))
+    {
+        return -1;
+    }
+
+    unsigned mask = (unsigned)table->bucket_count - 1;
+    unsigned b = int_array_hash(key, len) & mask;
+    while (table->buckets[b] >= 0)
+    {
+        int id = table->buckets[b];
+        if (table->lengths[id] == len
+            && (len == 0 || memcmp(table->keys + table->offsets[id], key, len * sizeof(*key)) == 0))
+        {
+            return id;
+        }
+        b = (b + 1) & mask;
+    }
+
+    if (table->count == table->capacity)
+    {
+        int capacity = table->capacity == 0 ? 64 : table->capacity * 2;
+        size_t * offsets = realloc(table->offsets, capacity * sizeof(*offsets));
+        if (offsets == NULL)
+        {
+            return -1;
+        }
+        table->offsets = offsets;
+        int * lengths = realloc(table->lengths, capacity * sizeof(*lengths));
+        if (lengths == NULL)
+        {
+            return -1;
+        }
+        table->lengths = lengths;
+        table->capacity = capacity;
+    }
+    if (table->keys_len + len > table->keys_capacity)
+    {
+        size_t capacity = table->keys_capacity == 0 ? 256 : table->keys_capacity;
+        while (table->keys_len + len > capacity)
+        {
+            capacity *= 2;
+        }
+        int * keys = realloc(table->keys, capacity * sizeof(*keys));
+        if (keys == NULL)
+        {
+            return -1;
+        }
+        table->keys = keys;
+        table->keys_capacity = capacity;
+    }
+
+    if (len > 0)
+    {
+        memcpy(table->keys + table->keys_len, key, len * sizeof(*key));
+    }
+    table->offsets[table->count] = table->keys_len;
+    table->lengths[table->count] = len;
+    table->keys_len += len;
+    table->buckets[b] = table->count;
+    *added = true;
+    return table->count++;
+}
+
+static void
+int_array_table_free(int_array_table_t * table)
+{
+    free(table->keys);
+    free(table->offsets);
+    free(table->lengths);
+    free(table->buckets);
+    memset(table, 0, sizeof(*table));
+}
+
+// --- Thompson NFA ---
+
+typedef struct
+{
+    gdl_char_set_t bytes; // The bytes that lead to next.
+    int next;             // -1 if no byte leads anywhere.
+    int epsilon[2];       // The states reached without consuming input, or -1.
+    bool accepting;
+} nfa_state_t;
+
+typedef struct
+{
+    int start;
+    int end; // Has no transitions until the fragment is used in a bigger one.
+} nfa_fragment_t;
+
+static nfa_fragment_t const nfa_none = { -1, -1 };
+
+typedef struct
+{
+    gdl_ast_node_t * program;
+    nfa_state_t * states;
+    int count;
+    int capacity;
+    char const * token_name;  // The token being built, for error messages.
+    char const * * inlining;  // The rules being inlined into the token, to catch recursion.
+    int inlining_count;
+    bool has_error;
+} nfa_builder_t;
+
+static nfa_fragment_t
+nfa_error(nfa_builder_t * nfa, char const * format, ...)
+{
+    if (!nfa->has_error)
+    {
+        va_list args;
+
+        fprintf(stderr, "Error: Token rule '%s' ", nfa->token_name);
+        va_start(args, format);
+        vfprintf(stderr, format, args);
+        va_end(args);
+        fprintf(stderr, ", so it can't be matched by a DFA.\n");
+    }
+    nfa->has_error = true;
+    return nfa_none;
+}
+
+static int
+nfa_add_state(nfa_builder_t * nfa)
+{
+    if (nfa->has_error)
+    {
+        return -1;
+    }
+    if (nfa->count == nfa->capacity)
+    {
+        int capacity = nfa->capacity == 0 ? 256 : nfa->capacity * 2;
+        nfa_state_t * states = realloc(nfa->states, capacity * sizeof(*states));
+        if (states == NULL)
+        {
+            perror("Failed to allocate NFA states");
+            nfa->has_error = true;
+            return -1;
+        }
+        nfa->states = states;
+        nfa->capacity = capacity;
+    }
+
+    nfa_state_t * state = &nfa->states[nfa->count];
+    memset(state, 0, sizeof(*state));
+    state->next = -1;
+    state->epsilon[0] = -1;
+    state->epsilon[1] = -1;
+    return nfa->count++;
+}
+
+// Each state gets at most two epsilon transitions from the constructions below.
+static void
+nfa_link(nfa_builder_t * nfa, int from, int to)
+{
+    nfa_state_t * state = &nfa->states[from];
+
+    state->epsilon[state->epsilon[0] < 0 ? 0 : 1] = to;
+}
+
+static nfa_fragment_t
+nfa_bytes(nfa_builder_t * nfa, gdl_char_set_t const * bytes)
+{
+    int start = nfa_add_state(nfa);
+    int end = nfa_add_state(nfa);
+    if (end < 0)
+    {
+        return nfa_none;
+    }
+
+    nfa_state_t * state = &nfa->states[start];
+    gdl_char_set_clear(&state->bytes);
+    for (int c = 1; c < 256; c++)
+    {
+        if (gdl_char_set_contains(bytes, (unsigned char)c))
+        {
+            gdl_char_set_add(&state->bytes, (unsigned char)c);
+        }
+    }
+    state->next = end;
+    return (nfa_fragment_t){ start, end };
+}
+
+static nfa_fragment_t
+nfa_byte(nfa_builder_t * nfa, unsigned char c)
+{
+    gdl_char_set_t bytes;
+
+    gdl_char_set_clear(&bytes);
+    gdl_char_set_add(&bytes, c);
+    return nfa_bytes(nfa, &bytes);
+}
+
+static nfa_fragment_t
+nfa_empty(nfa_builder_t * nfa)
+{
+    int start = nfa_add_state(nfa);
+    int end = nfa_add_state(nfa);
+    if (end < 0)
+    {
+        return nfa_none;
+    }
+    nfa_link(nfa, start, end);
+    return (nfa_fragment_t){ start, end };
+}
+
+static nfa_fragment_t
+nfa_concat(nfa_builder_t * nfa, nfa_fragment_t first, nfa_fragment_t second)
+{
+    if (nfa->has_error)
+    {
+        return nfa_none;
+    }
+    nfa_link(nfa, first.end, second.start);
+    return (nfa_fragment_t){ first.start, second.end };
+}
+
+static nfa_fragment_t
+nfa_union(nfa_builder_t * nfa, nfa_fragment_t a, nfa_fragment_t b)
+{
+    int start = nfa_add_state(nfa);
+    int end = nfa_add_state(nfa);
+    if (end < 0)
+    {
+        return nfa_none;
+    }
+    nfa_link(nfa, start, a.start);
+    nfa_link(nfa, start, b.start);
+    nfa_link(nfa, a.end, end);
+    nfa_link(nfa, b.end, end);
+    return (nfa_fragment_t){ start, end };
+}
+
+static nfa_fragment_t
+nfa_optional(nfa_builder_t * nfa, nfa_fragment_t a)
+{
+    int start = nfa_add_state(nfa);
+    int end = nfa_add_state(nfa);
+    if (end < 0)
+    {
+        return nfa_none;
+    }
+    nfa_link(nfa, start, a.start);
+    nfa_link(nfa, start, end);
+    nfa_link(nfa, a.end, end);
+    return (nfa_fragment_t){ start, end };
+}
+
+static nfa_fragment_t
+nfa_star(nfa_builder_t * nfa, nfa_fragment_t a)
+{
+    int start = nfa_add_state(nfa);
+    int end = nfa_add_state(nfa);
+    if (end < 0)
+    {
+        return nfa_none;
+    }
+    nfa_link(nfa, start, a.start);
+    nfa_link(nfa, start, end);
+    nfa_link(nfa, a.end, a.start);
+    nfa_link(nfa, a.end, end);
+    return (nfa_fragment_t){ start, end };
+}
+
+static nfa_fragment_t
+nfa_plus(nfa_builder_t * nfa, nfa_fragment_t a)
+{
+    int end = nfa_add_state(nfa);
+    if (end < 0)
+    {
+        return nfa_none;
+    }
+    nfa_link(nfa, a.end, a.start);
+    nfa_link(nfa, a.end, end);
+    return (nfa_fragment_t){ a.start, end };
+}
+
+static nfa_fragment_t
+nfa_string(nfa_builder_t * nfa, char const * text)
+{
+    nfa_fragment_t fragment = nfa_empty(nfa);
+
+    for (char const * c = text; *c != '\0'; c++)
+    {
+        fragment = nfa_concat(nfa, fragment, nfa_byte(nfa, (unsigned char)*c));
+    }
+    return fragment;
+}
+
+// What lexeme() skips: whitespace, and comments from "//" to the end of the line.
+static nfa_fragment_t
+nfa_lexeme_whitespace(nfa_builder_t * nfa)
+{
+    gdl_char_set_t space;
+    gdl_char_set_t not_newline;
+
+    gdl_char_set_clear(&space);
+    for (char const * c = " \t\n\v\f\r"; *c != '\0'; c++)
+    {
+        gdl_char_set_add(&space, (unsigned char)*c);
+    }
+    gdl_char_set_clear(&not_newline);
+    gdl_char_set_add_range(&not_newline, 1, '\n' - 1);
+    gdl_char_set_add_range(&not_newline, '\n' + 1, 0xff);
+
+    nfa_fragment_t comment = nfa_concat(nfa, nfa_string(nfa, "//"), nfa_star(nfa, nfa_bytes(nfa, &not_newline)));
+    comment = nfa_concat(nfa, comment, nfa_optional(nfa, nfa_byte(nfa, '\n')));
+    return nfa_star(nfa, nfa_union(nfa, nfa_bytes(nfa, &space), comment));
+}
+
+// The character class keywords match as they do in the C locale.
+static nfa_fragment_t
+nfa_keyword(nfa_builder_t * nfa, char const * name)
+{
+    gdl_char_set_t bytes;
+
+    gdl_char_set_clear(&bytes);
+    if (strcmp(name, "digit") == 0)
+    {
+        gdl_char_set_add_range(&bytes, '0', '9');
+    }
+    else if (strcmp(name, "hex_digit") == 0)
+    {
+        gdl_char_set_add_range(&bytes, '0', '9');
+        gdl_char_set_add_range(&bytes, 'a', 'f');
+        gdl_char_set_add_range(&bytes, 'A', 'F');
+    }
+    else if (strcmp(name, "alpha") == 0 || strcmp(name, "alphanum") == 0)
+    {
+        gdl_char_set_add_range(&bytes, 'a', 'z');
+        gdl_char_set_add_range(&bytes, 'A', 'Z');
+        if (strcmp(name, "alphanum") == 0)
+        {
+            gdl_char_set_add_range(&bytes, '0', '9');
+        }
+    }
+    else if (strcmp(name, "space") == 0)
+    {
+        for (char const * c = " \t\n\v\f\r"; *c != '\0'; c++)
+        {
+            gdl_char_set_add(&bytes, (unsigned char)*c);
+        }
+    }
+    else if (strcmp(name, "any_char") == 0)
+    {
+        gdl_char_set_add_range(&bytes, 1, 0xff);
+    }
+    else if (strcmp(name, "succeed") == 0)
+    {
+        return nfa_empty(nfa);
+    }
+    else
+    {
+        // eoi, int, double and '~'.
+        return nfa_error(nfa, "uses '%s'", name);
+    }
+    return nfa_bytes(nfa, &bytes);
+}
+
+static nfa_fragment_t
+nfa_char_class(nfa_builder_t * nfa, char const * args, bool negated)
+{
+    char * chars = c_string_unescape(args != NULL ? args : "");
+    if (chars == NULL)
+    {
+        perror("Failed to allocate character class");
+        nfa->has_error = true;
+        return nfa_none;
+    }
+
+    gdl_char_set_t listed;
+    gdl_char_set_clear(&listed);
+    for (char const * c = chars; *c != '\0'; c++)
+    {
+        gdl_char_set_add(&listed, (unsigned char)*c);
+    }
+    free(chars);
+
+    gdl_char_set_t bytes;
+    gdl_char_set_clear(&bytes);
+    for (int c = 1; c < 256; c++)
+    {
+        if (gdl_char_set_contains(&listed, (unsigned char)c) != negated)
+        {
+            gdl_char_set_add(&bytes, (unsigned char)c);
+        }
+    }
+    return nfa_bytes(nfa, &bytes);
+}
+
+static gdl_ast_node_t *
+program_find_rule(gdl_ast_node_t * program, char const * name)
+{
+    for (gdl_ast_list_node_t * r = program->data.program.rules.head; r != NULL; r = r->next)
+    {
+        if (strcmp(r->item->data.rule_def.name, name) == 0)
+        {
+            return r->item;
+        }
+    }
+    return NULL;
+}
+
+static nfa_fragment_t nfa_expression(nfa_builder_t * nfa, gdl_ast_node_t * node);
+
+static nfa_fragment_t
+nfa_rule_reference(nfa_builder_t * nfa, char const * name)
+{
+    gdl_ast_node_t * rule = program_find_rule(nfa->program, name);
+    if (rule == NULL)
+    {
+        return nfa_error(nfa, "uses undefined rule '%s'", name);
+    }
+    for (int i = 0; i < nfa->inlining_count; i++)
+    {
+        if (strcmp(nfa->inlining[i], name) == 0)
+        {
+            return nfa_error(nfa, "is recursive through rule '%s'", name);
+        }
+    }
+    if (rule->data.rule_def.semantic_action != NULL
+        && rule->data.rule_def.semantic_action->data.semantic_action.action_name != NULL)
+    {
+        return nfa_error(nfa, "uses rule '%s', which has a semantic action", name);
+    }
+
+    // The array has room for every rule, and none can be in it twice.
+    nfa->inlining[nfa->inlining_count++] = name;
+    nfa_fragment_t fragment = nfa_expression(nfa, rule->data.rule_def.definition);
+    nfa->inlining_count--;
+    return fragment;
+}
+
+// item (separator item)*, as delimited(), chainl1() and chainr1() match.
+static nfa_fragment_t
+nfa_separated(nfa_builder_t * nfa, gdl_ast_node_t * item, gdl_ast_node_t * separator)
+{
+    nfa_fragment_t first = nfa_expression(nfa, item);
+    nfa_fragment_t rest = nfa_expression(nfa, item);
+    if (separator != NULL)
+    {
+        rest = nfa_concat(nfa, nfa_expression(nfa, separator), rest);
+    }
+    return nfa_concat(nfa, first, nfa_star(nfa, rest));
+}
+
+static nfa_fragment_t
+nfa_expression(nfa_builder_t * nfa, gdl_ast_node_t * node)
+{
+    if (nfa->has_error)
+    {
+        return nfa_none;
+    }
+    if (node == NULL)
+    {
+        return nfa_empty(nfa);
+    }
+
+    switch (node->type)
+    {
+    case GDL_AST_NODE_TYPE_CHAR_LITERAL:
+        return nfa_byte(nfa, (unsigned char)node->data.char_literal.value);
+
+    case GDL_AST_NODE_TYPE_RAW_CHAR_LITERAL:
+        return nfa_byte(nfa, (unsigned char)node->data.raw_char_literal.value);
+
+    case GDL_AST_NODE_TYPE_STRING_LITERAL:
+    {
+        char * text = c_string_unescape(node->data.string_literal.value != NULL ? node->data.string_literal.value : "");
+        if (text == NULL)
+        {
+            perror("Failed to allocate string literal");
+            nfa->has_error = true;
+            return nfa_none;
+        }
+        nfa_fragment_t fragment = nfa_string(nfa, text);
+        free(text);
+        return fragment;
+    }
+
+    case GDL_AST_NODE_TYPE_CHAR_RANGE:
+    {
+        gdl_char_set_t bytes;
+        unsigned char first = (unsigned char)node->data.char_range.start_char;
+        unsigned char last = (unsigned char)node->data.char_range.end_char;
+
+        gdl_char_set_clear(&bytes);
+        if (first <= last)
+        {
+            gdl_char_set_add_range(&bytes, first, last);
+        }
+        return nfa_bytes(nfa, &bytes);
+    }
+
+    case GDL_AST_NODE_TYPE_KEYWORD:
+        return nfa_keyword(nfa, node->data.keyword.name);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_ONEOF:
+        return nfa_char_class(nfa, node->data.none_or_one_of_call.args, false);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_NONEOF:
+        return nfa_char_class(nfa, node->data.none_or_one_of_call.args, true);
+
+    case GDL_AST_NODE_TYPE_IDENTIFIER_REF:
+        return nfa_rule_reference(nfa, node->data.identifier_ref.name);
+
+    case GDL_AST_NODE_TYPE_TERMINAL:
+        return nfa_expression(nfa, node->data.terminal.expression);
+
+    case GDL_AST_NODE_TYPE_SEQUENCE:
+    {
+        nfa_fragment_t fragment = nfa_empty(nfa);
+        for (gdl_ast_list_node_t * e = node->data.sequence.elements.head; e != NULL; e = e->next)
+        {
+            fragment = nfa_concat(nfa, fragment, nfa_expression(nfa, e->item));
+        }
+        return fragment;
+    }
+
+    case GDL_AST_NODE_TYPE_ALTERNATIVE:
+    {
+        gdl_ast_list_node_t * a = node->data.alternative.alternatives.head;
+        if (a == NULL)
+        {
+            return nfa_empty(nfa);
+        }
+        nfa_fragment_t fragment = nfa_expression(nfa, a->item);
+        for (a = a->next; a != NULL; a = a->next)
+        {
+            fragment = nfa_union(nfa, fragment, nfa_expression(nfa, a->item));
+        }
+        return fragment;
+    }
+
+    case GDL_AST_NODE_TYPE_REPETITION_EXPRESSION:
+    {
+        nfa_fragment_t fragment = nfa_expression(nfa, node->data.repetition_expr.expression);
+        switch (node->data.repetition_expr.repetition->data.repetition_op.operator_char)
+        {
+        case '*':
+            return nfa_star(nfa, fragment);
+        case '+':
+            return nfa_plus(nfa, fragment);
+        default:
+            return nfa_optional(nfa, fragment);
+        }
+    }
+
+    case GDL_AST_NODE_TYPE_OPTIONAL_EXPRESSION:
+        return nfa_optional(nfa, nfa_expression(nfa, node->data.optional.expr));
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_PASSTHRU:
+        return nfa_expression(nfa, node->data.unary_combinator_call.expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_SKIP:
+        return nfa_star(nfa, nfa_expression(nfa, node->data.unary_combinator_call.expr));
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+    {
+        nfa_fragment_t fragment = nfa_lexeme_whitespace(nfa);
+        fragment = nfa_concat(nfa, fragment, nfa_expression(nfa, node->data.unary_combinator_call.expr));
+        return nfa_concat(nfa, fragment, nfa_lexeme_whitespace(nfa));
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_COUNT:
+    {
+        gdl_ast_node_t * count_node = node->data.count_call.count_node;
+        long long count = count_node != NULL ? count_node->data.number_literal.value : 0;
+        nfa_fragment_t fragment = nfa_empty(nfa);
+        for (long long i = 0; i < count && !nfa->has_error; i++)
+        {
+            fragment = nfa_concat(nfa, fragment, nfa_expression(nfa, node->data.count_call.expression));
+        }
+        return fragment;
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_BETWEEN:
+    {
+        nfa_fragment_t fragment = nfa_expression(nfa, node->data.between_call.open_expr);
+        fragment = nfa_concat(nfa, fragment, nfa_expression(nfa, node->data.between_call.content_expr));
+        return nfa_concat(nfa, fragment, nfa_expression(nfa, node->data.between_call.close_expr));
+    }
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_DELIMITED:
+        return nfa_separated(nfa, node->data.delimited_call.item_expr, node->data.delimited_call.delimiter_expr);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINL1:
+    case GDL_AST_NODE_TYPE_COMBINATOR_CHAINR1:
+        return nfa_separated(nfa, node->data.chain_combinator_call.item_expr, node->data.chain_combinator_call.op_expr);
+
+    case GDL_AST_NODE_TYPE_TOKEN_DFA:
+        return nfa_expression(nfa, node->data.token_dfa.expression);
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_LOOKAHEAD:
+        return nfa_error(nfa, "uses lookahead()");
+
+    case GDL_AST_NODE_TYPE_COMBINATOR_NOT:
+        return nfa_error(nfa, "uses not()");
+
+    case GDL_AST_NODE_TYPE_FAIL_CALL:
+        return nfa_error(nfa, "uses fail()");
+
+    default:
+        return nfa_error(nfa, "uses an unexpected expression (type %d)", node->type);
+    }
+}
+
+// --- Subset construction ---
+
+static int
+compare_ints(void const * a, void const * b)
+{
+    int x = *(int const *)a;
+    int y = *(int const *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * Adds the states reachable from the first count members without consuming
+ * input, using mark (an entry per NFA state) to see which are already in.
+ * Returns the new count, with the members sorted.
+ */
+static int
+nfa_closure(nfa_builder_t const * nfa, int * members, int count, unsigned * mark, unsigned stamp)
+{
+    int kept = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (mark[members[i]] != stamp)
+        {
+            mark[members[i]] = stamp;
+            members[kept++] = members[i];
+        }
+    }
+    count = kept;
+    for (int i = 0; i < count; i++)
+    {
+        nfa_state_t const * state = &nfa->states[members[i]];
+        for (int e = 0; e < 2; e++)
+        {
+            int target = state->epsilon[e];
+            if (target >= 0 && mark[target] != stamp)
+            {
+                mark[target] = stamp;
+                members[count++] = target;
+            }
+        }
+    }
+    qsort(members, count, sizeof(*members), compare_ints);
+    return count;
+}
+
+// Splits the byte classes so the bytes in the set don't share one with bytes that aren't.
+static int
+refine_classes(unsigned char classes[256], int class_count, gdl_char_set_t const * set)
+{
+    int split[256][2];
+
+    for (int i = 0; i < class_count; i++)
+    {
+        split[i][0] = -1;
+        split[i][1] = -1;
+    }
+    int new_count = 0;
+    for (int c = 0; c < 256; c++)
+    {
+        int in_set = gdl_char_set_contains(set, (unsigned char)c) ? 1 : 0;
+        int * target = &split[classes[c]][in_set];
+        if (*target < 0)
+        {
+            *target = new_count++;
+        }
+        classes[c] = (unsigned char)*target;
+    }
+    return new_count;
+}
+
+typedef struct
+{
+    int state_count;
+    int class_count;
+    unsigned char classes[256];
+    int * transitions;
+    unsigned char * accepting;
+    int * starts; // Indexed by token.
+} dfa_build_t;
+
+static bool
+dfa_from_nfa(nfa_builder_t const * nfa, int const * nfa_starts, int token_count, dfa_build_t * dfa)
+{
+    bool ok = false;
+    int_array_table_t subsets = { 0 };
+    int * members = malloc((nfa->count + 1) * sizeof(*members));
+    int * scratch = malloc((nfa->count + 1) * sizeof(*scratch));
+    unsigned * mark = calloc(nfa->count + 1, sizeof(*mark));
+    unsigned stamp = 0;
+    int rows_capacity = 0;
+    int representative[256];
+    bool added;
+
+    dfa->starts = calloc(token_count > 0 ? token_count : 1, sizeof(*dfa->starts));
+    if (members == NULL || scratch == NULL || mark == NULL || dfa->starts == NULL)
+    {
+        perror("Failed to allocate DFA");
+        goto done;
+    }
+
+    memset(dfa->classes, 0, sizeof(dfa->classes));
+    dfa->class_count = 1;
+    for (int s = 0; s < nfa->count; s++)
+    {
+        if (nfa->states[s].next >= 0)
+        {
+            dfa->class_count = refine_classes(dfa->classes, dfa->class_count, &nfa->states[s].bytes);
+        }
+    }
+    for (int c = 255; c >= 0; c--)
+    {
+        representative[dfa->classes[c]] = c;
+    }
+
+    // The empty subset is the dead state, so is state 0.
+    if (int_array_table_intern(&subsets, NULL, 0, &added) != 0)
+    {
+        perror("Failed to allocate DFA");
+        goto done;
+    }
+    for (int t = 0; t < token_count; t++)
+    {
+        members[0] = nfa_starts[t];
+        int count = nfa_closure(nfa, members, 1, mark, ++stamp);
+        dfa->starts[t] = int_array_table_intern(&subsets, members, count, &added);
+        if (dfa->starts[t] < 0)
+        {
+            perror("Failed to allocate DFA");
+            goto done;
+        }
+    }
+
+    for (int id = 0; id < subsets.count; id++)
+    {
+        if (id == rows_capacity)
+        {
+            rows_capacity = rows_capacity == 0 ? 64 : rows_capacity * 2;
+            int * transitions = realloc(dfa->transitions, (size_t)rows_capacity * dfa->class_count * sizeof(*transitions));
+            unsigned char * accepting = realloc(dfa->accepting, rows_capacity * sizeof(*accepting));
+            if (transitions != NULL)
+            {
+                dfa->transitions = transitions;
+            }
+            if (accepting != NULL)
+            {
+                dfa->accepting = accepting;
+            }
+            if (transitions == NULL || accepting == NULL)
+            {
+                perror("Failed to allocate DFA");
+                goto done;
+            }
+        }
+
+        // Interning may move the keys, so work on a copy of the subset.
+        int subset_count = subsets.lengths[id];
+        if (subset_count > 0)
+        {
+            memcpy(scratch, subsets.keys + subsets.offsets[id], subset_count * sizeof(*scratch));
+        }
+
+        dfa->accepting[id] = 0;
+        for (int i = 0; i < subset_count; i++)
+        {
+            if (nfa->states[scratch[i]].accepting)
+            {
+                dfa->accepting[id] = 1;
+            }
+        }
+
+        for (int c = 0; c < dfa->class_count; c++)
+        {
+            int count = 0;
+            for (int i = 0; i < subset_count; i++)
+            {
+                nfa_state_t const * state = &nfa->states[scratch[i]];
+                if (state->next >= 0 && gdl_char_set_contains(&state->bytes, (unsigned char)representative[c]))
+                {
+                    members[count++] = state->next;
+                }
+            }
+            count = nfa_closure(nfa, members, count, mark, ++stamp);
+            int target = int_array_table_intern(&subsets, members, count, &added);
+            if (target < 0)
+            {
+                perror("Failed to allocate DFA");
+                goto done;
+            }
+            if (target >= MAX_DFA_STATES)
+            {
+                fprintf(stderr, "Error: The token rules need a DFA with more than %d states.\n", MAX_DFA_STATES);
+                goto done;
+            }
+            dfa->transitions[(size_t)id * dfa->class_count + c] = target;
+        }
+    }
+    dfa->state_count = subsets.count;
+    ok = true;
+
+done:
+    int_array_table_free(&subsets);
+    free(members);
+    free(scratch);
+    free(mark);
+    return ok;
+}
+
+// --- Minimization ---
+
+/*
+ * Merges the states that no input can tell apart, leaving the dead state as
+ * state 0, then merges the byte classes that lead to the same states.
+ */
+static bool
+dfa_minimize(dfa_build_t * dfa, int token_count)
+{
+    bool ok = false;
+    int const state_count = dfa->state_count;
+    int const class_count = dfa->class_count;
+    int * block = malloc(state_count * sizeof(*block));
+    int * next_block = malloc(state_count * sizeof(*next_block));
+    int * signature = malloc((class_count + 1) * sizeof(*signature));
+    int * renumber = NULL;
+    int * transitions = NULL;
+    unsigned char * accepting = NULL;
+    int * column = NULL;
+    int_array_table_t table = { 0 };
+    bool added;
+
+    if (block == NULL || next_block == NULL || signature == NULL)
+    {
+        goto out_of_memory;
+    }
+
+    // Moore's algorithm: split the blocks by where their states' transitions go until nothing changes.
+    int block_count = 0;
+    for (int s = 0; s < state_count; s++)
+    {
+        block[s] = dfa->accepting[s];
+    }
+    bool has_accepting = false;
+    bool has_rejecting = false;
+    for (int s = 0; s < state_count; s++)
+    {
+        has_accepting |= dfa->accepting[s] != 0;
+        has_rejecting |= dfa->accepting[s] == 0;
+    }
+    block_count = has_accepting + has_rejecting;
+
+    for (;;)
+    {
+        int_array_table_free(&table);
+        for (int s = 0; s < state_count; s++)
+        {
+            signature[0] = block[s];
+            for (int c = 0; c < class_count; c++)
+            {
+                signature[c + 1] = block[dfa->transitions[(size_t)s * class_count + c]];
+            }
+            next_block[s] = int_array_table_intern(&table, signature, class_count + 1, &added);
+            if (next_block[s] < 0)
+            {
+                goto out_of_memory;
+            }
+        }
+        int * swap = block;
+        block = next_block;
+        next_block = swap;
+        if (table.count == block_count)
+        {
+            break;
+        }
+        block_count = table.count;
+    }
+
+    // Number the blocks in the order their first states appear, so the dead state stays as 0.
+    renumber = malloc(block_count * sizeof(*renumber));
+    transitions = malloc((size_t)block_count * class_count * sizeof(*transitions));
+    accepting = malloc(block_count * sizeof(*accepting));
+    if (renumber == NULL || transitions == NULL || accepting == NULL)
+    {
+        goto out_of_memory;
+    }
+    for (int b = 0; b < block_count; b++)
+    {
+        renumber[b] = -1;
+    }
+    int new_count = 0;
+    for (int s = 0; s < state_count; s++)
+    {
+        if (renumber[block[s]] < 0)
+        {
+            renumber[block[s]] = new_count++;
+        }
+    }
+    for (int s = 0; s < state_count; s++)
+    {
+        int state = renumber[block[s]];
+        accepting[state] = dfa->accepting[s];
+        for (int c = 0; c < class_count; c++)
+        {
+            transitions[(size_t)state * class_count + c] = renumber[block[dfa->transitions[(size_t)s * class_count + c]]];
+        }
+    }
+    for (int t = 0; t < token_count; t++)
+    {
+        dfa->starts[t] = renumber[block[dfa->starts[t]]];
+    }
+
+    // Byte classes with the same column of transitions behave the same.
+    column = malloc(block_count * sizeof(*column));
+    if (column == NULL)
+    {
+        goto out_of_memory;
+    }
+    int_array_table_free(&table);
+    int class_map[256];
+    for (int c = 0; c < class_count; c++)
+    {
+        for (int s = 0; s < block_count; s++)
+        {
+            column[s] = transitions[(size_t)s * class_count + c];
+        }
+        class_map[c] = int_array_table_intern(&table, column, block_count, &added);
+        if (class_map[c] < 0)
+        {
+            goto out_of_memory;
+        }
+    }
+    int const merged_class_count = table.count;
+    for (int s = 0; s < block_count; s++)
+    {
+        for (int c = 0; c < class_count; c++)
+        {
+            dfa->transitions[(size_t)s * merged_class_count + class_map[c]] = transitions[(size_t)s * class_count + c];
+        }
+    }
+    for (int b = 0; b < 256; b++)
+    {
+        dfa->classes[b] = (unsigned char)class_map[dfa->classes[b]];
+    }
+    memcpy(dfa->accepting, accepting, block_count * sizeof(*accepting));
+    dfa->state_count = block_count;
+    dfa->class_count = merged_class_count;
+    ok = true;
+    goto done;
+
+out_of_memory:
+    perror("Failed to minimize DFA");
+
+done:
+    int_array_table_free(&table);
+    free(block);
+    free(next_block);
+    free(signature);
+    free(renumber);
+    free(transitions);
+    free(accepting);
+    free(column);
+    return ok;
+}
+
+// --- Building the token DFA ---
+
+// Skips the wrappers around a token rule's expression, including the lexeme()s, which stay as they are.
+static gdl_ast_node_t * *
+token_core_slot(gdl_ast_node_t * * slot)
+{
+    for (;;)
+    {
+        gdl_ast_node_t * node = *slot;
+        if (node == NULL)
+        {
+            return slot;
+        }
+        switch (node->type)
+        {
+        case GDL_AST_NODE_TYPE_TERMINAL:
+            slot = &node->data.terminal.expression;
+            break;
+
+        case GDL_AST_NODE_TYPE_SEQUENCE:
+            if (node->data.sequence.elements.count != 1)
+            {
+                return slot;
+            }
+            slot = &node->data.sequence.elements.head->item;
+            break;
+
+        case GDL_AST_NODE_TYPE_ALTERNATIVE:
+            if (node->data.alternative.alternatives.count != 1)
+            {
+                return slot;
+            }
+            slot = &node->data.alternative.alternatives.head->item;
+            break;
+
+        case GDL_AST_NODE_TYPE_COMBINATOR_LEXEME:
+            slot = &node->data.unary_combinator_call.expr;
+            break;
+
+        default:
+            return slot;
+        }
+    }
+}
+
+bool
+gdl_token_dfa_build(gdl_ast_node_t * program, gdl_token_dfa_t * dfa)
+{
+    memset(dfa, 0, sizeof(*dfa));
+    if (program == NULL || program->type != GDL_AST_NODE_TYPE_PROGRAM)
+    {
+        return false;
+    }
+
+    int rule_count = program->data.program.rules.count;
+    for (gdl_ast_list_node_t * r = program->data.program.rules.head; r != NULL; r = r->next)
+    {
+        dfa->token_count += r->item->data.rule_def.is_token;
+    }
+    if (dfa->token_count == 0)
+    {
+        return true;
+    }
+
+    bool ok = false;
+    nfa_builder_t nfa = { .program = program };
+    dfa_build_t build = { 0 };
+    int * nfa_starts = calloc(dfa->token_count, sizeof(*nfa_starts));
+    nfa.inlining = calloc(rule_count + 1, sizeof(*nfa.inlining));
+    dfa->tokens = calloc(dfa->token_count, sizeof(*dfa->tokens));
+    if (nfa_starts == NULL || nfa.inlining == NULL || dfa->tokens == NULL)
+    {
+        perror("Failed to allocate token DFA");
+        dfa->token_count = 0;
+        goto done;
+    }
+
+    int t = 0;
+    for (gdl_ast_list_node_t * r = program->data.program.rules.head; r != NULL; r = r->next)
+    {
+        gdl_ast_node_t * rule = r->item;
+        if (!rule->data.rule_def.is_token)
+        {
+            continue;
+        }
+
+        gdl_token_dfa_token_t * token = &dfa->tokens[t];
+        token->rule = rule;
+        token->slot = token_core_slot(&rule->data.rule_def.definition);
+
+        nfa.token_name = rule->data.rule_def.name;
+        nfa.inlining[0] = rule->data.rule_def.name;
+        nfa.inlining_count = 1;
+        nfa_fragment_t fragment = nfa_expression(&nfa, *token->slot);
+        if (nfa.has_error)
+        {
+            goto done;
+        }
+        nfa.states[fragment.end].accepting = true;
+        nfa_starts[t++] = fragment.start;
+    }
+
+    if (!dfa_from_nfa(&nfa, nfa_starts, dfa->token_count, &build) || !dfa_minimize(&build, dfa->token_count))
+    {
+        goto done;
+    }
+
+    dfa->state_count = build.state_count;
+    dfa->class_count = build.class_count;
+    memcpy(dfa->classes, build.classes, sizeof(dfa->classes));
+    dfa->transitions = malloc((size_t)build.state_count * build.class_count * sizeof(*dfa->transitions));
+    dfa->accepting = malloc(build.state_count * sizeof(*dfa->accepting));
+    if (dfa->transitions == NULL || dfa->accepting == NULL)
+    {
+        perror("Failed to allocate token DFA");
+        goto done;
+    }
+    for (size_t i = 0; i < (size_t)build.state_count * build.class_count; i++)
+    {
+        dfa->transitions[i] = (unsigned short)build.transitions[i];
+    }
+    memcpy(dfa->accepting, build.accepting, build.state_count * sizeof(*dfa->accepting));
+    fprintf(stdout, "Token DFA: %d states and %d byte classes for %d token rules.\n",
+            dfa->state_count, dfa->class_count, dfa->token_count);
+
+    // Only now that nothing can fail is the grammar changed.
+    for (t = 0; t < dfa->token_count; t++)
+    {
+        gdl_token_dfa_token_t * token = &dfa->tokens[t];
+        gdl_ast_node_t * node = calloc(1, sizeof(*node));
+        if (node == NULL)
+        {
+            perror("Failed to allocate token DFA node");
+            goto done;
+        }
+        node->type = GDL_AST_NODE_TYPE_TOKEN_DFA;
+        node->data.token_dfa.expression = *token->slot;
+        node->data.token_dfa.rule_name = token->rule->data.rule_def.name;
+        node->data.token_dfa.start = build.starts[t];
+        token->start = build.starts[t];
+        *token->slot = node;
+    }
+    ok = true;
+
+done:
+    free(nfa_starts);
+    free(nfa.inlining);
+    free(nfa.states);
+    free(build.transitions);
+    free(build.accepting);
+    free(build.starts);
+    return ok;
+}
+
+void
+gdl_token_dfa_free(gdl_token_dfa_t * dfa)
+{
+    for (int t = 0; t < dfa->token_count; t++)
+    {
+        gdl_ast_node_t * * slot = dfa->tokens[t].slot;
+        if (slot != NULL && *slot != NULL && (*slot)->type == GDL_AST_NODE_TYPE_TOKEN_DFA)
+        {
+            gdl_ast_node_t * node = *slot;
+            *slot = node->data.token_dfa.expression;
+            free(node);
+        }
+    }
+    free(dfa->tokens);
+    free(dfa->transitions);
+    free(dfa->accepting);
+    memset(dfa, 0, sizeof(*dfa));
+}
+
+// --- Code generation ---
+
+char *
+gdl_token_dfa_object_name(char const * rule_name)
+{
+    char * pascal_name = to_pascal_case(rule_name);
+    if (pascal_name == NULL)
+    {
+        return NULL;
+    }
+    char * object_name = str_printf("token_dfa_%s", pascal_name);
+    free(pascal_name);
+    return object_name;
+}
+
+// Writes the values as the body of an array initializer, 16 to a line.
+static void
+write_table_entries(FILE * out, int count, int (*entry)(gdl_token_dfa_t const * dfa, int index), gdl_token_dfa_t const * dfa, int first)
+{
+    for (int i = 0; i < count; i++)
+    {
+        fprintf(out, "%s%d,%s", i % 16 == 0 ? "    " : " ", entry(dfa, first + i), i % 16 == 15 || i == count - 1 ? "\n" : "");
+    }
+}
+
+static int
+class_entry(gdl_token_dfa_t const * dfa, int index)
+{
+    return dfa->classes[index];
+}
+
+static int
+transition_entry(gdl_token_dfa_t const * dfa, int index)
+{
+    return dfa->transitions[index];
+}
+
+static int
+accepting_entry(gdl_token_dfa_t const * dfa, int index)
+{
+    return dfa->accepting[index];
+}
+
+void
+gdl_token_dfa_write_tables(FILE * out, gdl_token_dfa_t const * dfa, bool const * token_used)
+{
+    bool any_used = false;
+    for (int t = 0; t < dfa->token_count; t++)
+    {
+        any_used |= token_used == NULL || token_used[t];
+    }
+    if (!any_used)
+    {
+        return;
+    }
+
+    fprintf(out, "// The DFA matching the token rules: %d states, %d byte classes. State 0 is the dead state.\n",
+            dfa->state_count, dfa->class_count);
+    fprintf(out, "static const unsigned char token_dfa_classes[256] = {\n");
+    write_table_entries(out, 256, class_entry, dfa, 0);
+    fprintf(out, "};\n");
+    fprintf(out, "static const unsigned short token_dfa_transitions[] = {\n");
+    for (int state = 0; state < dfa->state_count; state++)
+    {
+        // A row of transitions for each state.
+        write_table_entries(out, dfa->class_count, transition_entry, dfa, state * dfa->class_count);
+    }
+    fprintf(out, "};\n");
+    fprintf(out, "static const unsigned char token_dfa_accepting[] = {\n");
+    write_table_entries(out, dfa->state_count, accepting_entry, dfa, 0);
+    fprintf(out, "};\n");
+
+    for (int t = 0; t < dfa->token_count; t++)
+    {
+        if (token_used != NULL && !token_used[t])
+        {
+            continue;
+        }
+        char * object_name = gdl_token_dfa_object_name(dfa->tokens[t].rule->data.rule_def.name);
+        fprintf(out,
+                "static const epc_dfa_t %s = {\n"
+                "    .classes = token_dfa_classes,\n"
+                "    .transitions = token_dfa_transitions,\n"
+                "    .accepting = token_dfa_accepting,\n"
+                "    .class_count = %d,\n"
+                "    .start = %d,\n"
+                "};\n",
+                object_name != NULL ? object_name : "token_dfa",
+                dfa->class_count, dfa->tokens[t].start);
+        free(object_name);
+    }
+    fprintf(out, "\n");
+}
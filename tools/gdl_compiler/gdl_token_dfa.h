@@ -0,0 +1,64 @@
+#pragma once
+
+#include "gdl_ast.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/*
+ * Rules declared with the 'token' keyword match a regular language, so rather
+ * than generating a parser for each part of their definitions, the backends
+ * match them with a DFA. All the token rules of a grammar share one minimized
+ * automaton, each token having its own start state, which the generated code
+ * runs with epc_dfa().
+ *
+ * A token matches the longest input its definition can match, where the
+ * combinators would stop at the first alternative that matches, and
+ * repetitions would never give back input. The character class keywords
+ * (alpha, space etc.) match as they do in the C locale.
+ */
+
+// One token rule.
+typedef struct
+{
+    gdl_ast_node_t * rule;            // The rule definition.
+    gdl_ast_node_t * * slot;          // Where the rule's DFA node is, within its definition.
+    int start;                        // The token's start state.
+} gdl_token_dfa_token_t;
+
+typedef struct
+{
+    gdl_token_dfa_token_t * tokens;   // In definition order.
+    int token_count;
+    int state_count;                  // State 0 is the dead state.
+    int class_count;
+    unsigned char classes[256];       // The class of each input byte.
+    unsigned short * transitions;     // state_count rows of class_count entries.
+    unsigned char * accepting;        // 1 for each accepting state.
+} gdl_token_dfa_t;
+
+/*
+ * Builds the DFA for the token rules of the program, and puts a
+ * GDL_AST_NODE_TYPE_TOKEN_DFA node in place of the part of each token rule
+ * that the DFA matches: everything inside any lexeme() wrapping the whole
+ * definition, which is kept so whitespace is still skipped around the token.
+ * A program without token rules is left alone.
+ * Returns false, having reported why, if a token rule isn't regular (e.g. it
+ * is recursive or uses lookahead()) or uses a rule with a semantic action.
+ * Call gdl_token_dfa_free() afterwards in either case.
+ */
+bool gdl_token_dfa_build(gdl_ast_node_t * program, gdl_token_dfa_t * dfa);
+
+// Puts the token rule definitions back as they were and frees the DFA.
+void gdl_token_dfa_free(gdl_token_dfa_t * dfa);
+
+/*
+ * Writes the tables of the DFA, and an epc_dfa_t named token_dfa_<Rule> for
+ * each token, as static data. token_used, indexed like dfa->tokens, limits
+ * the epc_dfa_t objects to the tokens the generated code uses; pass NULL for
+ * all of them. Does nothing if there are no tokens.
+ */
+void gdl_token_dfa_write_tables(FILE * out, gdl_token_dfa_t const * dfa, bool const * token_used);
+
+// Returns the newly allocated name of the epc_dfa_t written for a token rule.
+char * gdl_token_dfa_object_name(char const * rule_name);
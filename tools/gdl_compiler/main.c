@@ -1,6 +1,9 @@
-#include "gdl_parser.h"
+#include "gdl_generated.h"
 #include "gdl_compiler_ast_actions.h"
 #include "gdl_code_generator.h"
+#include "gdl_grammar_analysis.h"
+#include "gdl_optimizer.h"
+#include "gdl_profile.h"
 
 #include <easy_pc/easy_pc.h>
 
@@ -51,6 +54,12 @@ main(int argc, char ** argv)
     int exit_code = EXIT_SUCCESS;
     const char * gdl_filepath = NULL;
     const char * output_dir = "."; // Default output directory
+    const char * backend = "combinators";
+    const char * name = NULL;           // Defaults to the name of the GDL file
+    const char * profile_path = NULL;
+    int shards = 1;
+    bool optimize = false;
+    bool analyze = false;
 
     // Parse command line arguments
     for (int i = 1; i < argc; ++i)
@@ -78,20 +87,112 @@ main(int argc, char ** argv)
                 }
             }
         }
+        else if (strncmp(argv[i], "--backend", strlen("--backend")) == 0)
+        {
+            const char * value_start = strchr(argv[i], '=');
+            if (value_start)
+            {
+                backend = value_start + 1;
+            }
+            else if (i + 1 < argc)
+            {
+                backend = argv[++i];
+            }
+            else
+            {
+                fprintf(stderr, "Error: --backend requires an argument.\n");
+                return EXIT_FAILURE;
+            }
+            if (strcmp(backend, "combinators") != 0 && strcmp(backend, "direct") != 0 && strcmp(backend, "static") != 0
+                && strcmp(backend, "blob") != 0)
+            {
+                fprintf(stderr, "Error: Unknown backend '%s'. Expected 'combinators', 'direct', 'static' or 'blob'.\n", backend);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strncmp(argv[i], "--name", strlen("--name")) == 0)
+        {
+            const char * value_start = strchr(argv[i], '=');
+            if (value_start)
+            {
+                name = value_start + 1;
+            }
+            else if (i + 1 < argc)
+            {
+                name = argv[++i];
+            }
+            else
+            {
+                fprintf(stderr, "Error: --name requires an argument.\n");
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strncmp(argv[i], "--shards", strlen("--shards")) == 0)
+        {
+            const char * value_start = strchr(argv[i], '=');
+            const char * value = NULL;
+            if (value_start)
+            {
+                value = value_start + 1;
+            }
+            else if (i + 1 < argc)
+            {
+                value = argv[++i];
+            }
+            char * end = NULL;
+            long count = value != NULL ? strtol(value, &end, 10) : 0;
+            if (value == NULL || *end != '\0' || count < 1 || count > 1000)
+            {
+                fprintf(stderr, "Error: --shards requires a number from 1 to 1000.\n");
+                return EXIT_FAILURE;
+            }
+            shards = (int)count;
+        }
+        else if (strncmp(argv[i], "--profile", strlen("--profile")) == 0)
+        {
+            const char * value_start = strchr(argv[i], '=');
+            if (value_start)
+            {
+                profile_path = value_start + 1;
+            }
+            else if (i + 1 < argc)
+            {
+                profile_path = argv[++i];
+            }
+            else
+            {
+                fprintf(stderr, "Error: --profile requires an argument.\n");
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strcmp(argv[i], "--optimize") == 0)
+        {
+            optimize = true;
+        }
+        else if (strcmp(argv[i], "--analyze") == 0)
+        {
+            analyze = true;
+        }
         else if (gdl_filepath == NULL)
         {
             gdl_filepath = argv[i];
         }
         else
         {
-            fprintf(stderr, "Usage: %s <gdl_file> [--output-dir <directory>]\n", argv[0]);
+            fprintf(stderr, "Usage: %s <gdl_file> [--output-dir <directory>] [--backend combinators|direct|static|blob] [--name <base_name>] [--shards <count>] [--optimize] [--profile <file>] [--analyze]\n", argv[0]);
             return EXIT_FAILURE;
         }
     }
 
     if (gdl_filepath == NULL)
     {
-        fprintf(stderr, "Usage: %s <gdl_file> [--output-dir <directory>]\n", argv[0]);
+        fprintf(stderr, "Usage: %s <gdl_file> [--output-dir <directory>] [--backend combinators|direct|static|blob] [--name <base_name>] [--shards <count>] [--optimize] [--profile <file>] [--analyze]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (shards > 1 && strcmp(backend, "combinators") != 0)
+    {
+        fprintf(stderr, "Error: --shards is only supported by the combinators backend.\n");
         return EXIT_FAILURE;
     }
 
@@ -111,7 +212,7 @@ main(int argc, char ** argv)
     }
 
     // 1. Create the GDL parser
-    epc_parser_t * gdl_grammar_parser = create_gdl_parser(gdl_parser_list);
+    epc_parser_t * gdl_grammar_parser = create_gdl_generated_parser(gdl_parser_list);
     if (!gdl_grammar_parser)
     {
         fprintf(stderr, "Failed to create GDL grammar parser.\n.");
@@ -176,21 +277,92 @@ main(int argc, char ** argv)
                     gdl_filename = (char *)gdl_filepath;
                 }
                 char base_name[256];
-                strncpy(base_name, gdl_filename, sizeof(base_name) - 1);
+                strncpy(base_name, name != NULL ? name : gdl_filename, sizeof(base_name) - 1);
                 base_name[sizeof(base_name) - 1] = '\0';
 
-                char * dot = strrchr(base_name, '.');
+                char * dot = name == NULL ? strrchr(base_name, '.') : NULL;
                 if (dot)
                 {
                     *dot = '\0';
                 }
 
-                if (!gdl_generate_c_code((gdl_ast_node_t *)ast_build_result.ast_root, base_name, output_dir))
+                gdl_ast_node_t * ast_root = (gdl_ast_node_t *)ast_build_result.ast_root;
+                bool generated = true;
+                if (optimize)
+                {
+                    gdl_optimizer_stats_t stats;
+                    if (!gdl_optimize(ast_root, &stats))
+                    {
+                        fprintf(stderr, "GDL optimization failed.\n");
+                        generated = false;
+                    }
+                    else
+                    {
+                        printf("Optimized: %d unused rules removed, %d references inlined, %d nodes flattened, "
+                               "%d literals merged, %d character sets created, %d keyword sets created.\n",
+                               stats.rules_removed, stats.rules_inlined, stats.nodes_flattened,
+                               stats.literals_merged, stats.char_sets_created, stats.keyword_sets_created);
+                    }
+                }
+                if (generated && profile_path != NULL)
+                {
+                    gdl_profile_t profile;
+                    int reordered = -1;
+                    if (gdl_profile_load(profile_path, &profile))
+                    {
+                        reordered = gdl_profile_reorder_alternatives(ast_root, &profile);
+                        gdl_profile_free(&profile);
+                    }
+                    if (reordered < 0)
+                    {
+                        fprintf(stderr, "Applying the profile failed.\n");
+                        generated = false;
+                    }
+                    else
+                    {
+                        printf("Profile: alternatives of %d rules reordered.\n", reordered);
+                    }
+                }
+                if (generated && analyze)
+                {
+                    // Report on the grammar instead of generating code for it.
+                    gdl_grammar_analysis_t analysis;
+                    gdl_grammar_report_stats_t stats;
+                    generated = gdl_grammar_analyze(ast_root, &analysis);
+                    if (generated)
+                    {
+                        gdl_grammar_write_report(&analysis, stdout, &stats);
+                        gdl_grammar_analysis_free(&analysis);
+                    }
+                }
+                else if (generated)
+                {
+                    if (strcmp(backend, "direct") == 0)
+                    {
+                        generated = gdl_generate_direct_c_code(ast_root, base_name, output_dir);
+                    }
+                    else if (strcmp(backend, "static") == 0)
+                    {
+                        generated = gdl_generate_static_c_code(ast_root, base_name, output_dir);
+                    }
+                    else if (strcmp(backend, "blob") == 0)
+                    {
+                        generated = gdl_generate_grammar_blob(ast_root, base_name, output_dir);
+                    }
+                    else
+                    {
+                        generated = gdl_generate_sharded_c_code(ast_root, base_name, output_dir, shards);
+                    }
+                    if (!generated)
+                    {
+                        fprintf(stderr, "C code generation failed.\n");
+                    }
+                }
+                if (!generated)
                 {
-                    fprintf(stderr, "C code generation failed.\n");
                     exit_code = EXIT_FAILURE;
                 }
-                else
+                else if (!analyze)
                 {
                     printf("C code generation completed successfully.\n");
                 }